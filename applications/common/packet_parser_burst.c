@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string.h>
+
+#include <rte_ether.h>
+#include <rte_gtp.h>
+#include <rte_ip.h>
+#include <rte_ip_frag.h>
+#include <rte_mbuf.h>
+#include <rte_prefetch.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vect.h>
+#include <rte_vxlan.h>
+
+#include <doca_flow_net.h>
+#include <doca_bitfield.h>
+
+#include "packet_parser_burst.h"
+
+#define PARSER_BURST_PREFETCH_MBUF 8	 /* Distance in packets of the mbuf prefetch */
+#define PARSER_BURST_PREFETCH_DATA 4	 /* Distance in packets of the headers prefetch */
+#define PARSER_BURST_MAX_VLANS 2	 /* Maximal number of VLAN tags parsed by the fast path */
+#define PARSER_BURST_WINDOW_LEN 16	 /* Length of the classified headers window */
+#define PARSER_BURST_GTPU_INFO 0x30	 /* GTP-U version 1, protocol type GTP and no optional fields */
+#define PARSER_BURST_GTPU_INFO_MASK 0xf7 /* GTP-U header info bits other than the reserved one */
+#define PARSER_BURST_VXLAN_FLAG_I 0x08	 /* VXLAN valid VNI flag */
+
+/*
+ * Header signatures classify the 16 bytes window that starts at the ethertype field preceding the network header.
+ * A window matches a signature if it is equal to the signature value in every bit set in the signature mask.
+ */
+struct parser_burst_sig {
+	uint8_t mask[PARSER_BURST_WINDOW_LEN] __rte_aligned(16);  /* Bits to compare */
+	uint8_t value[PARSER_BURST_WINDOW_LEN] __rte_aligned(16); /* Expected value of the compared bits */
+	uint32_t ptype;						  /* PARSER_PTYPE_* flags of the matching headers */
+	uint8_t l3_len;						  /* Network header length */
+	uint8_t l4_proto;					  /* Transport protocol, 0 for fragments */
+};
+
+/*
+ * IPv4 without options that is not a fragment: version and IHL at byte 2, flags and fragment offset at bytes 8-9 and
+ * protocol at byte 11. The ethertype is compared only if et_mask is set.
+ */
+#define PARSER_BURST_SIG_IPV4(et_mask, proto, l4_ptype) \
+	{ \
+		.mask = {et_mask, et_mask, 0xff, 0, 0, 0, 0, 0, 0x3f, 0xff, 0, 0xff}, \
+		.value = {0x08 & (et_mask), 0x00, 0x45, 0, 0, 0, 0, 0, 0, 0, 0, proto}, \
+		.ptype = PARSER_PTYPE_IPV4 | (l4_ptype), .l3_len = sizeof(struct rte_ipv4_hdr), .l4_proto = proto, \
+	}
+
+/*
+ * IPv6 without extension headers: version at byte 2 and next header at byte 8. The ethertype is compared only if
+ * et_mask is set.
+ */
+#define PARSER_BURST_SIG_IPV6(et_mask, proto, l4_ptype) \
+	{ \
+		.mask = {et_mask, et_mask, 0xf0, 0, 0, 0, 0, 0, 0xff}, \
+		.value = {0x86 & (et_mask), 0xdd & (et_mask), 0x60, 0, 0, 0, 0, 0, proto}, \
+		.ptype = PARSER_PTYPE_IPV6 | (l4_ptype), .l3_len = sizeof(struct rte_ipv6_hdr), .l4_proto = proto, \
+	}
+
+/*
+ * IPv4 without options, whether it is a fragment is checked once matched. The ethertype is compared only if et_mask is
+ * set.
+ */
+#define PARSER_BURST_SIG_IPV4_FRAG(et_mask) \
+	{ \
+		.mask = {et_mask, et_mask, 0xff}, .value = {0x08 & (et_mask), 0x00, 0x45}, \
+		.ptype = PARSER_PTYPE_IPV4 | PARSER_PTYPE_FRAG, .l3_len = sizeof(struct rte_ipv4_hdr), \
+	}
+
+/*
+ * IPv6 with a single fragment extension header, whose next header is checked once matched. The ethertype is compared
+ * only if et_mask is set.
+ */
+#define PARSER_BURST_SIG_IPV6_FRAG(et_mask) \
+	{ \
+		.mask = {et_mask, et_mask, 0xf0, 0, 0, 0, 0, 0, 0xff}, \
+		.value = {0x86 & (et_mask), 0xdd & (et_mask), 0x60, 0, 0, 0, 0, 0, IPPROTO_FRAGMENT}, \
+		.ptype = PARSER_PTYPE_IPV6 | PARSER_PTYPE_FRAG, \
+		.l3_len = sizeof(struct rte_ipv6_hdr) + sizeof(struct rte_ipv6_fragment_ext), \
+	}
+
+/* Signatures of a network header that follows an Ethernet header, most common first */
+static const struct parser_burst_sig parser_burst_eth_sigs[] = {
+	PARSER_BURST_SIG_IPV4(0xff, DOCA_FLOW_PROTO_UDP, PARSER_PTYPE_UDP),
+	PARSER_BURST_SIG_IPV4(0xff, DOCA_FLOW_PROTO_TCP, PARSER_PTYPE_TCP),
+	PARSER_BURST_SIG_IPV6(0xff, DOCA_FLOW_PROTO_UDP, PARSER_PTYPE_UDP),
+	PARSER_BURST_SIG_IPV6(0xff, DOCA_FLOW_PROTO_TCP, PARSER_PTYPE_TCP),
+	PARSER_BURST_SIG_IPV4_FRAG(0xff),
+	PARSER_BURST_SIG_IPV6_FRAG(0xff),
+};
+
+/* Signatures of a network header that directly follows a tunnel header */
+static const struct parser_burst_sig parser_burst_ip_sigs[] = {
+	PARSER_BURST_SIG_IPV4(0, DOCA_FLOW_PROTO_UDP, PARSER_PTYPE_UDP),
+	PARSER_BURST_SIG_IPV4(0, DOCA_FLOW_PROTO_TCP, PARSER_PTYPE_TCP),
+	PARSER_BURST_SIG_IPV6(0, DOCA_FLOW_PROTO_UDP, PARSER_PTYPE_UDP),
+	PARSER_BURST_SIG_IPV6(0, DOCA_FLOW_PROTO_TCP, PARSER_PTYPE_TCP),
+	PARSER_BURST_SIG_IPV4_FRAG(0),
+	PARSER_BURST_SIG_IPV6_FRAG(0),
+};
+
+#define PARSER_BURST_NB_SIGS RTE_DIM(parser_burst_eth_sigs)
+
+/* Connection headers found by the fast path */
+struct parser_burst_conn {
+	uint32_t ptype;	 /* PARSER_PTYPE_* flags of the headers */
+	uint16_t l3_off; /* Network header offset */
+	uint16_t l4_off; /* Transport header offset */
+	uint16_t end;	 /* Offset of the end of the transport header */
+};
+
+/*
+ * Match a headers window against a signature table
+ *
+ * @window [in]: pointer to the window, PARSER_BURST_WINDOW_LEN bytes long
+ * @sigs [in]: signature table of PARSER_BURST_NB_SIGS entries
+ * @return: the matching signature or NULL if there is none
+ */
+static inline const struct parser_burst_sig *parser_burst_classify(const uint8_t *window,
+								    const struct parser_burst_sig *sigs)
+{
+	uint32_t i;
+#if defined(RTE_ARCH_X86)
+	__m128i win = _mm_loadu_si128((const __m128i *)window);
+	__m128i eq;
+
+	for (i = 0; i < PARSER_BURST_NB_SIGS; i++) {
+		eq = _mm_cmpeq_epi8(_mm_and_si128(win, _mm_load_si128((const __m128i *)sigs[i].mask)),
+				    _mm_load_si128((const __m128i *)sigs[i].value));
+		if (_mm_movemask_epi8(eq) == 0xffff)
+			return &sigs[i];
+	}
+#elif defined(RTE_ARCH_ARM64)
+	uint8x16_t win = vld1q_u8(window);
+	uint8x16_t eq;
+
+	for (i = 0; i < PARSER_BURST_NB_SIGS; i++) {
+		eq = vceqq_u8(vandq_u8(win, vld1q_u8(sigs[i].mask)), vld1q_u8(sigs[i].value));
+		if (vminvq_u8(eq) == UINT8_MAX)
+			return &sigs[i];
+	}
+#else
+	uint64_t win[2], mask[2], value[2];
+
+	memcpy(win, window, sizeof(win));
+	for (i = 0; i < PARSER_BURST_NB_SIGS; i++) {
+		memcpy(mask, sigs[i].mask, sizeof(mask));
+		memcpy(value, sigs[i].value, sizeof(value));
+		if ((win[0] & mask[0]) == value[0] && (win[1] & mask[1]) == value[1])
+			return &sigs[i];
+	}
+#endif
+	return NULL;
+}
+
+/*
+ * Fast path parsing of the connection headers of a packet, which are either Ethernet, up to PARSER_BURST_MAX_VLANS
+ * VLAN tags, IP and TCP/UDP or, if there is no link-layer header, IP and TCP/UDP
+ *
+ * @data [in]: pointer to the start of the packet data
+ * @len [in]: length of the packet data
+ * @off [in]: offset of the connection headers
+ * @has_link [in]: true if the connection headers start with an Ethernet header
+ * @conn [out]: the connection headers, the PARSER_PTYPE_FRAG flag is set and end is the transport header offset if
+ * the IP header is a fragment
+ * @return: true if the fast path could parse the headers and false otherwise
+ */
+static inline bool parser_burst_conn_fast_parse(const uint8_t *data,
+						uint16_t len,
+						uint16_t off,
+						bool has_link,
+						struct parser_burst_conn *conn)
+{
+	const struct parser_burst_sig *sigs = parser_burst_ip_sigs;
+	const struct parser_burst_sig *sig;
+	const struct rte_ether_hdr *eth;
+	uint32_t ptype = 0;
+	uint32_t l3_off = off;
+	uint32_t l4_off, l4_len;
+	rte_be16_t ether_type;
+	uint8_t next_proto;
+	int nb_vlans;
+
+	if (has_link) {
+		eth = (const struct rte_ether_hdr *)(data + off);
+		l3_off += sizeof(*eth);
+		if (l3_off + sizeof(struct rte_vlan_hdr) * PARSER_BURST_MAX_VLANS > len)
+			return false;
+		ether_type = eth->ether_type;
+		for (nb_vlans = 0; nb_vlans < PARSER_BURST_MAX_VLANS; nb_vlans++) {
+			if (ether_type != RTE_BE16(RTE_ETHER_TYPE_VLAN) && ether_type != RTE_BE16(RTE_ETHER_TYPE_QINQ))
+				break;
+			ether_type = ((const struct rte_vlan_hdr *)(data + l3_off))->eth_proto;
+			l3_off += sizeof(struct rte_vlan_hdr);
+			ptype = PARSER_PTYPE_VLAN;
+		}
+		sigs = parser_burst_eth_sigs;
+	}
+
+	/* The window starts at the ethertype, or at the last bytes of the tunnel header */
+	if (l3_off - 2 + PARSER_BURST_WINDOW_LEN > len)
+		return false;
+	sig = parser_burst_classify(data + l3_off - 2, sigs);
+	if (sig == NULL)
+		return false;
+
+	l4_off = l3_off + sig->l3_len;
+	if (l4_off > len)
+		return false;
+	if (unlikely(sig->ptype & PARSER_PTYPE_FRAG)) {
+		/* Same as the per-packet functions, the transport header of a fragment is left for the reassembly */
+		if (sig->ptype & PARSER_PTYPE_IPV4) {
+			if (!rte_ipv4_frag_pkt_is_fragmented((const struct rte_ipv4_hdr *)(data + l3_off)))
+				return false;
+		} else {
+			next_proto = ((const struct rte_ipv6_fragment_ext *)(data + l4_off) - 1)->next_header;
+			if (next_proto != DOCA_FLOW_PROTO_TCP && next_proto != DOCA_FLOW_PROTO_UDP)
+				return false;
+		}
+		l4_len = 0;
+	} else if (sig->l4_proto == DOCA_FLOW_PROTO_TCP) {
+		if (l4_off + sizeof(struct rte_tcp_hdr) > len)
+			return false;
+		l4_len = rte_tcp_hdr_len((const struct rte_tcp_hdr *)(data + l4_off));
+		if (l4_len < sizeof(struct rte_tcp_hdr))
+			return false;
+	} else {
+		l4_len = sizeof(struct rte_udp_hdr);
+	}
+	if (l4_off + l4_len > len)
+		return false;
+
+	conn->ptype = ptype | sig->ptype;
+	conn->l3_off = l3_off;
+	conn->l4_off = l4_off;
+	conn->end = l4_off + l4_len;
+	return true;
+}
+
+/*
+ * Slow path parsing of the connection headers of a packet with the per-packet functions. Ethernet and up to
+ * PARSER_BURST_MAX_VLANS VLAN tags are skipped here since link_parse() supports no VLAN tag, a packet with more tags
+ * is rejected same as by the fast path.
+ *
+ * @data [in]: pointer to the start of the packet data
+ * @len [in]: length of the packet data
+ * @off [in]: offset of the connection headers
+ * @has_link [in]: true if the connection headers start with an Ethernet header
+ * @conn [out]: the connection headers, end is the offset of the end of the last parsed header
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the IP header is a fragment and DOCA_ERROR otherwise
+ */
+static doca_error_t parser_burst_conn_slow_parse(uint8_t *data,
+						 uint16_t len,
+						 uint16_t off,
+						 bool has_link,
+						 struct parser_burst_conn *conn)
+{
+	struct conn_parser_ctx ctx;
+	uint32_t ptype = 0;
+	uint32_t l3_off = off;
+	rte_be16_t ether_type;
+	doca_error_t ret;
+	int nb_vlans;
+
+	memset(&ctx, 0, sizeof(ctx));
+	if (has_link) {
+		l3_off += sizeof(struct rte_ether_hdr);
+		if (l3_off > len)
+			return DOCA_ERROR_INVALID_VALUE;
+		ether_type = ((const struct rte_ether_hdr *)(data + off))->ether_type;
+		for (nb_vlans = 0; nb_vlans < PARSER_BURST_MAX_VLANS; nb_vlans++) {
+			if (ether_type != RTE_BE16(RTE_ETHER_TYPE_VLAN) && ether_type != RTE_BE16(RTE_ETHER_TYPE_QINQ))
+				break;
+			if (l3_off + sizeof(struct rte_vlan_hdr) > len)
+				return DOCA_ERROR_INVALID_VALUE;
+			ether_type = ((const struct rte_vlan_hdr *)(data + l3_off))->eth_proto;
+			l3_off += sizeof(struct rte_vlan_hdr);
+			ptype = PARSER_PTYPE_VLAN;
+		}
+		if (ether_type != RTE_BE16(RTE_ETHER_TYPE_IPV4) && ether_type != RTE_BE16(RTE_ETHER_TYPE_IPV6))
+			return DOCA_ERROR_INVALID_VALUE;
+		ctx.link_ctx.next_proto = rte_be_to_cpu_16(ether_type);
+	}
+
+	ret = conn_parse(data + l3_off, data + len, &ctx);
+	if (ret != DOCA_SUCCESS && ret != DOCA_ERROR_AGAIN)
+		return ret;
+
+	conn->ptype = ptype;
+	conn->l3_off = l3_off;
+	conn->l4_off = conn->l3_off + ctx.network_ctx.len;
+	conn->end = conn->l4_off + ctx.transport_ctx.len;
+	conn->ptype |= ctx.network_ctx.ip_version == DOCA_FLOW_PROTO_IPV4 ? PARSER_PTYPE_IPV4 : PARSER_PTYPE_IPV6;
+	if (ctx.network_ctx.frag)
+		conn->ptype |= PARSER_PTYPE_FRAG;
+	else
+		conn->ptype |= ctx.transport_ctx.proto == DOCA_FLOW_PROTO_TCP ? PARSER_PTYPE_TCP : PARSER_PTYPE_UDP;
+	return ret;
+}
+
+/*
+ * Store the outer connection headers of a packet in the burst result
+ *
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ * @conn [in]: outer connection headers
+ */
+static inline void parser_burst_outer_set(struct parser_burst *res, uint16_t i, const struct parser_burst_conn *conn)
+{
+	res->ptype[i] |= conn->ptype;
+	res->l3_off[i] = conn->l3_off;
+	res->l4_off[i] = conn->l4_off;
+	res->hdrs_len[i] = conn->end;
+}
+
+/*
+ * Store the inner connection headers of a tunneled packet in the burst result
+ *
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ * @conn [in]: inner connection headers
+ */
+static inline void parser_burst_inner_set(struct parser_burst *res, uint16_t i, const struct parser_burst_conn *conn)
+{
+	res->ptype[i] |= PARSER_PTYPE_INNER(conn->ptype);
+	res->inner_l3_off[i] = conn->l3_off;
+	res->inner_l4_off[i] = conn->l4_off;
+	res->hdrs_len[i] = conn->end;
+}
+
+/*
+ * Parse the VXLAN tunnel and the inner headers of a packet whose outer headers were parsed by the fast path. A packet
+ * without a valid VXLAN header is left as a plain UDP packet.
+ *
+ * @data [in]: pointer to the start of the packet data
+ * @len [in]: length of the packet data
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ */
+static void parser_burst_vxlan_parse(uint8_t *data, uint16_t len, struct parser_burst *res, uint16_t i)
+{
+	uint16_t tun_off = res->hdrs_len[i];
+	uint16_t inner_off = tun_off + sizeof(struct rte_vxlan_hdr);
+	struct parser_burst_conn conn;
+
+	if (inner_off > len || !(data[tun_off] & PARSER_BURST_VXLAN_FLAG_I))
+		return;
+
+	res->ptype[i] |= PARSER_PTYPE_VXLAN;
+	res->pkt_type[i] = PARSER_PKT_TYPE_TUNNELED;
+	res->tun_off[i] = tun_off;
+	res->inner_l2_off[i] = inner_off;
+
+	if (likely(parser_burst_conn_fast_parse(data, len, inner_off, true, &conn))) {
+		parser_burst_inner_set(res, i, &conn);
+		if (conn.ptype & PARSER_PTYPE_FRAG)
+			res->status[i] = DOCA_ERROR_AGAIN;
+		return;
+	}
+
+	res->ptype[i] |= PARSER_PTYPE_SLOW_PATH;
+	res->status[i] = parser_burst_conn_slow_parse(data, len, inner_off, true, &conn);
+	if (res->status[i] != DOCA_SUCCESS && res->status[i] != DOCA_ERROR_AGAIN)
+		return;
+
+	parser_burst_inner_set(res, i, &conn);
+}
+
+/*
+ * Parse the GTP-U tunnel and the inner headers of a packet whose outer headers were parsed by the fast path
+ *
+ * @data [in]: pointer to the start of the packet data
+ * @len [in]: length of the packet data
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ */
+static void parser_burst_gtpu_parse(uint8_t *data, uint16_t len, struct parser_burst *res, uint16_t i)
+{
+	uint16_t tun_off = res->hdrs_len[i];
+	uint16_t inner_off = tun_off + sizeof(struct rte_gtp_hdr);
+	struct gtp_parser_ctx gtp_ctx = {0};
+	struct parser_burst_conn conn;
+
+	res->ptype[i] |= PARSER_PTYPE_GTPU;
+	res->pkt_type[i] = PARSER_PKT_TYPE_TUNNELED;
+	res->tun_off[i] = tun_off;
+
+	if (likely(inner_off <= len &&
+		   (((struct rte_gtp_hdr *)(data + tun_off))->gtp_hdr_info & PARSER_BURST_GTPU_INFO_MASK) ==
+			   PARSER_BURST_GTPU_INFO &&
+		   parser_burst_conn_fast_parse(data, len, inner_off, false, &conn))) {
+		res->inner_l2_off[i] = inner_off;
+		parser_burst_inner_set(res, i, &conn);
+		if (conn.ptype & PARSER_PTYPE_FRAG)
+			res->status[i] = DOCA_ERROR_AGAIN;
+		return;
+	}
+
+	res->ptype[i] |= PARSER_PTYPE_SLOW_PATH;
+	res->status[i] = gtpu_parse(data + tun_off, data + len, &gtp_ctx);
+	if (res->status[i] != DOCA_SUCCESS)
+		return;
+	inner_off = tun_off + gtp_ctx.len;
+	res->inner_l2_off[i] = inner_off;
+
+	res->status[i] = parser_burst_conn_slow_parse(data, len, inner_off, false, &conn);
+	if (res->status[i] != DOCA_SUCCESS && res->status[i] != DOCA_ERROR_AGAIN)
+		return;
+
+	parser_burst_inner_set(res, i, &conn);
+}
+
+/*
+ * Parse a single packet of the burst
+ *
+ * @pkt [in]: packet to parse
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ */
+static inline void parser_burst_pkt_parse(struct rte_mbuf *pkt, struct parser_burst *res, uint16_t i)
+{
+	uint8_t *data = rte_pktmbuf_mtod(pkt, uint8_t *);
+	uint16_t len = rte_pktmbuf_data_len(pkt);
+	struct parser_burst_conn conn;
+	struct rte_udp_hdr *udp_hdr;
+
+	res->status[i] = DOCA_SUCCESS;
+	res->ptype[i] = 0;
+	res->pkt_type[i] = PARSER_PKT_TYPE_PLAIN;
+	res->l3_off[i] = 0;
+	res->l4_off[i] = 0;
+	res->tun_off[i] = 0;
+	res->inner_l2_off[i] = 0;
+	res->inner_l3_off[i] = 0;
+	res->inner_l4_off[i] = 0;
+	res->hdrs_len[i] = 0;
+
+	if (unlikely(!parser_burst_conn_fast_parse(data, len, 0, true, &conn))) {
+		res->ptype[i] = PARSER_PTYPE_SLOW_PATH;
+		res->status[i] = parser_burst_conn_slow_parse(data, len, 0, true, &conn);
+		if (res->status[i] != DOCA_SUCCESS && res->status[i] != DOCA_ERROR_AGAIN) {
+			res->pkt_type[i] = PARSER_PKT_TYPE_UNKNOWN;
+			return;
+		}
+	}
+	parser_burst_outer_set(res, i, &conn);
+	if (conn.ptype & PARSER_PTYPE_FRAG) {
+		/* Tunnels can't be told apart before the reassembly, same as unknown_parse() */
+		res->status[i] = DOCA_ERROR_AGAIN;
+		return;
+	}
+
+	if (!(conn.ptype & PARSER_PTYPE_UDP))
+		return;
+	udp_hdr = (struct rte_udp_hdr *)(data + conn.l4_off);
+	if (udp_hdr->dst_port == DOCA_HTOBE16(DOCA_FLOW_GTPU_DEFAULT_PORT))
+		parser_burst_gtpu_parse(data, len, res, i);
+	else if (udp_hdr->dst_port == DOCA_HTOBE16(DOCA_FLOW_VXLAN_DEFAULT_PORT))
+		parser_burst_vxlan_parse(data, len, res, i);
+}
+
+/*
+ * Prefetch the headers of a packet, including the second cache line of the long tunneled headers
+ *
+ * @pkt [in]: packet to prefetch
+ */
+static inline void parser_burst_pkt_prefetch(struct rte_mbuf *pkt)
+{
+	uint8_t *data = rte_pktmbuf_mtod(pkt, uint8_t *);
+
+	rte_prefetch0(data);
+	if (rte_pktmbuf_data_len(pkt) > RTE_CACHE_LINE_SIZE)
+		rte_prefetch0(data + RTE_CACHE_LINE_SIZE);
+}
+
+uint16_t parser_burst_parse(struct rte_mbuf **pkts, uint16_t nb_pkts, struct parser_burst *res)
+{
+	uint16_t nb_parsed = 0;
+	uint16_t i;
+
+	nb_pkts = RTE_MIN(nb_pkts, (uint16_t)PARSER_BURST_MAX_SIZE);
+	res->nb_pkts = nb_pkts;
+	res->nb_slow_path = 0;
+
+	for (i = 0; i < RTE_MIN(nb_pkts, (uint16_t)PARSER_BURST_PREFETCH_MBUF); i++)
+		rte_prefetch0(pkts[i]);
+	for (i = 0; i < RTE_MIN(nb_pkts, (uint16_t)PARSER_BURST_PREFETCH_DATA); i++)
+		parser_burst_pkt_prefetch(pkts[i]);
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (i + PARSER_BURST_PREFETCH_MBUF < nb_pkts)
+			rte_prefetch0(pkts[i + PARSER_BURST_PREFETCH_MBUF]);
+		if (i + PARSER_BURST_PREFETCH_DATA < nb_pkts)
+			parser_burst_pkt_prefetch(pkts[i + PARSER_BURST_PREFETCH_DATA]);
+
+		parser_burst_pkt_parse(pkts[i], res, i);
+		if (res->status[i] == DOCA_SUCCESS)
+			nb_parsed++;
+		if (res->ptype[i] & PARSER_PTYPE_SLOW_PATH)
+			res->nb_slow_path++;
+	}
+
+	return nb_parsed;
+}
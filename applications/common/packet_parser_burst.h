@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PACKET_PARSER_BURST_H_
+#define PACKET_PARSER_BURST_H_
+
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#include "packet_parser.h"
+
+struct rte_mbuf;
+
+#define PARSER_BURST_MAX_SIZE 64 /* Maximal number of packets parsed in a single burst */
+
+/* Protocol stack flags of a parsed packet, the flags of the inner headers are the outer ones shifted by 8 bits */
+#define PARSER_PTYPE_INNER(outer) ((outer) << 8)
+#define PARSER_PTYPE_VLAN (1U << 0)				      /* Outer Ethernet has one or two VLAN tags */
+#define PARSER_PTYPE_IPV4 (1U << 1)				      /* Outer IPv4 */
+#define PARSER_PTYPE_IPV6 (1U << 2)				      /* Outer IPv6 */
+#define PARSER_PTYPE_FRAG (1U << 3)				      /* Outer IP fragment */
+#define PARSER_PTYPE_TCP (1U << 4)				      /* Outer TCP */
+#define PARSER_PTYPE_UDP (1U << 5)				      /* Outer UDP */
+#define PARSER_PTYPE_VXLAN (1U << 6)				      /* VXLAN tunnel */
+#define PARSER_PTYPE_GTPU (1U << 7)				      /* GTP-U tunnel */
+#define PARSER_PTYPE_INNER_VLAN PARSER_PTYPE_INNER(PARSER_PTYPE_VLAN) /* Inner Ethernet has VLAN tags */
+#define PARSER_PTYPE_INNER_IPV4 PARSER_PTYPE_INNER(PARSER_PTYPE_IPV4) /* Inner IPv4 */
+#define PARSER_PTYPE_INNER_IPV6 PARSER_PTYPE_INNER(PARSER_PTYPE_IPV6) /* Inner IPv6 */
+#define PARSER_PTYPE_INNER_FRAG PARSER_PTYPE_INNER(PARSER_PTYPE_FRAG) /* Inner IP fragment */
+#define PARSER_PTYPE_INNER_TCP PARSER_PTYPE_INNER(PARSER_PTYPE_TCP)   /* Inner TCP */
+#define PARSER_PTYPE_INNER_UDP PARSER_PTYPE_INNER(PARSER_PTYPE_UDP)   /* Inner UDP */
+#define PARSER_PTYPE_SLOW_PATH (1U << 31)			      /* Parsed by the per-packet functions */
+#define PARSER_PTYPE_TUNNEL (PARSER_PTYPE_VXLAN | PARSER_PTYPE_GTPU)  /* Any tunnel */
+
+/*
+ * Burst parsing result, kept as a struct of arrays indexed by the packet position in the burst.
+ * Offsets are in bytes from the start of the packet data. For a plain packet the tunnel and inner offsets are 0, for a
+ * VXLAN packet inner_l2_off is the offset of the inner Ethernet header and for a GTP-U packet it equals inner_l3_off.
+ * The offsets of the layers following an IP fragment are not valid.
+ */
+struct parser_burst {
+	uint16_t nb_pkts;				      /* Number of packets in the burst */
+	uint16_t nb_slow_path;				      /* Packets handed to the per-packet functions */
+	doca_error_t status[PARSER_BURST_MAX_SIZE];	      /* Per-packet parsing status, see unknown_parse() */
+	uint32_t ptype[PARSER_BURST_MAX_SIZE];		      /* PARSER_PTYPE_* flags */
+	enum parser_pkt_type pkt_type[PARSER_BURST_MAX_SIZE]; /* Tunneled or plain */
+	uint16_t l3_off[PARSER_BURST_MAX_SIZE];		      /* Outer network header */
+	uint16_t l4_off[PARSER_BURST_MAX_SIZE];		      /* Outer transport header */
+	uint16_t tun_off[PARSER_BURST_MAX_SIZE];	      /* Tunnel header */
+	uint16_t inner_l2_off[PARSER_BURST_MAX_SIZE];	      /* Inner Ethernet header */
+	uint16_t inner_l3_off[PARSER_BURST_MAX_SIZE];	      /* Inner network header */
+	uint16_t inner_l4_off[PARSER_BURST_MAX_SIZE];	      /* Inner transport header */
+	uint16_t hdrs_len[PARSER_BURST_MAX_SIZE];	      /* Total length of the parsed headers */
+};
+
+/*
+ * Parse a burst of packets.
+ * The common Ethernet/VLAN/IPv4/IPv6/TCP/UDP stacks, optionally encapsulated in VXLAN or GTP-U, are parsed by a fast
+ * path that classifies the headers with vector compares. Any other packet (IPv4 options, IPv6 extension headers other
+ * than a single fragment header, GTP-U extension headers) is handed to the per-packet functions from the first header
+ * the fast path could not handle, after the Ethernet header and its VLAN tags which are skipped by the burst API. Same
+ * as unknown_parse(), a packet whose outer IP header is a fragment is reported as plain with status DOCA_ERROR_AGAIN,
+ * while a tunneled packet whose inner IP header is a fragment is reported as tunneled with the same status. VLAN tags
+ * and VXLAN are only recognized by the burst API, and more than two tags are not supported. Only the first segment of
+ * the packets is parsed.
+ * No application uses this API yet, it is only exercised by the ip_frag parser benchmark (ip_frag/parser_bench).
+ *
+ * @pkts [in]: packets to parse
+ * @nb_pkts [in]: number of packets, up to PARSER_BURST_MAX_SIZE
+ * @res [out]: parsing result
+ * @return: number of packets parsed successfully
+ */
+uint16_t parser_burst_parse(struct rte_mbuf **pkts, uint16_t nb_pkts, struct parser_burst *res);
+
+#endif /* PACKET_PARSER_BURST_H_ */
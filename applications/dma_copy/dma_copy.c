@@ -52,6 +52,9 @@ int main(int argc, char **argv)
 #ifdef DOCA_ARCH_DPU
 	dma_cfg.mode = DMA_COPY_MODE_DPU;
 #endif
+	dma_cfg.chunk_size = DEFAULT_CHUNK_SIZE_KB * 1024;
+	dma_cfg.ring_size = DEFAULT_RING_SIZE;
+	dma_cfg.stream_fd = -1;
 
 	/* Register a logger backend */
 	result = doca_log_backend_create_standard();
@@ -84,6 +87,14 @@ int main(int argc, char **argv)
 		goto destroy_argp;
 	}
 
+	/* Mock mode runs the streaming pipeline locally, without a device or a comch */
+	if (dma_cfg.mock_dma) {
+		result = mock_start_dma_copy(&dma_cfg);
+		if (result == DOCA_SUCCESS)
+			exit_status = EXIT_SUCCESS;
+		goto destroy_argp;
+	}
+
 	result = comch_utils_init(SERVER_NAME,
 				  dma_cfg.cc_dev_pci_addr,
 				  dma_cfg.cc_dev_rep_pci_addr,
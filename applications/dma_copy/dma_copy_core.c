@@ -28,6 +28,7 @@
 #include <time.h>
 #include <netinet/in.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/epoll.h>
 #include <unistd.h>
 
@@ -123,10 +124,30 @@ static doca_error_t validate_file_size(const char *file_path, uint64_t *file_siz
 static doca_error_t args_validation_callback(void *config)
 {
 	struct dma_copy_cfg *cfg = (struct dma_copy_cfg *)config;
+	doca_error_t result;
 
 	if (access(cfg->file_path, F_OK | R_OK) == 0) {
 		cfg->is_file_found_locally = true;
-		return validate_file_size(cfg->file_path, &cfg->file_size);
+		result = validate_file_size(cfg->file_path, &cfg->file_size);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	if (cfg->mock_dma) {
+		if (!cfg->is_file_found_locally) {
+			DOCA_LOG_ERR("Mock DMA mode requires an existing file to copy");
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		if (cfg->chunk_size == 0) {
+			DOCA_LOG_ERR("Mock DMA mode requires a positive chunk size");
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		return DOCA_SUCCESS;
+	}
+
+	if (cfg->cc_dev_pci_addr[0] == '\0') {
+		DOCA_LOG_ERR("Comch DOCA device PCI address is mandatory");
+		return DOCA_ERROR_INVALID_VALUE;
 	}
 
 	return DOCA_SUCCESS;
@@ -203,6 +224,142 @@ static doca_error_t rep_pci_addr_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle chunk size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunk_size_callback(void *param, void *config)
+{
+	struct dma_copy_cfg *cfg = (struct dma_copy_cfg *)config;
+	int chunk_size_kb = *(int *)param;
+
+	if (chunk_size_kb < 0 || chunk_size_kb > MAX_CHUNK_SIZE_KB) {
+		DOCA_LOG_ERR("Chunk size must be between 0 and %d KB", MAX_CHUNK_SIZE_KB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->chunk_size = (uint32_t)chunk_size_kb * 1024;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle ring size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ring_size_callback(void *param, void *config)
+{
+	struct dma_copy_cfg *cfg = (struct dma_copy_cfg *)config;
+	int ring_size = *(int *)param;
+
+	if (ring_size < 1 || ring_size > DMA_STREAM_MAX_RING) {
+		DOCA_LOG_ERR("Ring size must be between 1 and %d", DMA_STREAM_MAX_RING);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->ring_size = ring_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle mock DMA parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mock_dma_callback(void *param, void *config)
+{
+	struct dma_copy_cfg *cfg = (struct dma_copy_cfg *)config;
+
+	cfg->mock_dma = *(bool *)param;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Read a chunk of a file
+ *
+ * @fd [in]: file descriptor
+ * @buffer [out]: buffer to read the chunk into
+ * @len [in]: chunk length
+ * @offset [in]: chunk offset in the file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t read_file_chunk(int fd, char *buffer, uint32_t len, uint64_t offset)
+{
+	ssize_t nb_read;
+	uint32_t done = 0;
+
+	while (done < len) {
+		nb_read = pread(fd, buffer + done, len - done, offset + done);
+		if (nb_read < 0 && errno == EINTR)
+			continue;
+		if (nb_read <= 0) {
+			DOCA_LOG_ERR("Failed to read %u bytes at offset %" PRIu64 " of the file", len, offset);
+			return DOCA_ERROR_IO_FAILED;
+		}
+		done += nb_read;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Write a chunk of a file
+ *
+ * @fd [in]: file descriptor
+ * @buffer [in]: buffer holding the chunk
+ * @len [in]: chunk length
+ * @offset [in]: chunk offset in the file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t write_file_chunk(int fd, const char *buffer, uint32_t len, uint64_t offset)
+{
+	ssize_t nb_written;
+	uint32_t done = 0;
+
+	while (done < len) {
+		nb_written = pwrite(fd, buffer + done, len - done, offset + done);
+		if (nb_written < 0 && errno == EINTR)
+			continue;
+		if (nb_written <= 0) {
+			DOCA_LOG_ERR("Failed to write %u bytes at offset %" PRIu64 " of the file", len, offset);
+			return DOCA_ERROR_IO_FAILED;
+		}
+		done += nb_written;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Open the file of a streamed copy
+ *
+ * @cfg [in/out]: Application configuration, the file descriptor is saved in stream_fd
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t open_stream_file(struct dma_copy_cfg *cfg)
+{
+	if (cfg->is_file_found_locally)
+		cfg->stream_fd = open(cfg->file_path, O_RDONLY);
+	else
+		cfg->stream_fd = open(cfg->file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (cfg->stream_fd < 0) {
+		DOCA_LOG_ERR("Failed to open %s: %s", cfg->file_path, strerror(errno));
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Save remote buffer information into a file
  *
@@ -421,6 +578,7 @@ doca_error_t register_dma_copy_params(void)
 {
 	doca_error_t result;
 	struct doca_argp_param *file_path_param, *dev_pci_addr_param, *rep_pci_addr_param;
+	struct doca_argp_param *chunk_size_param, *ring_size_param, *mock_dma_param;
 
 	/* Create and register string to dma copy param */
 	result = doca_argp_param_create(&file_path_param);
@@ -449,10 +607,10 @@ doca_error_t register_dma_copy_params(void)
 	}
 	doca_argp_param_set_short_name(dev_pci_addr_param, "p");
 	doca_argp_param_set_long_name(dev_pci_addr_param, "pci-addr");
-	doca_argp_param_set_description(dev_pci_addr_param, "DOCA Comch device PCI address");
+	doca_argp_param_set_description(dev_pci_addr_param,
+					"DOCA Comch device PCI address (not needed with --mock-dma)");
 	doca_argp_param_set_callback(dev_pci_addr_param, dev_pci_addr_callback);
 	doca_argp_param_set_type(dev_pci_addr_param, DOCA_ARGP_TYPE_STRING);
-	doca_argp_param_set_mandatory(dev_pci_addr_param);
 	result = doca_argp_register_param(dev_pci_addr_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
@@ -477,6 +635,60 @@ doca_error_t register_dma_copy_params(void)
 		return result;
 	}
 
+	/* Create and register chunk size param */
+	result = doca_argp_param_create(&chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(chunk_size_param, "c");
+	doca_argp_param_set_long_name(chunk_size_param, "chunk-size");
+	doca_argp_param_set_description(
+		chunk_size_param,
+		"Chunk size in KB of the streamed copy, 0 for a single DMA task (default 1024, Host only)");
+	doca_argp_param_set_callback(chunk_size_param, chunk_size_callback);
+	doca_argp_param_set_type(chunk_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register ring size param */
+	result = doca_argp_param_create(&ring_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(ring_size_param, "ring-size");
+	doca_argp_param_set_description(ring_size_param,
+					"Number of chunks in flight of the streamed copy (default 16, Host only)");
+	doca_argp_param_set_callback(ring_size_param, ring_size_callback);
+	doca_argp_param_set_type(ring_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(ring_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register mock DMA param */
+	result = doca_argp_param_create(&mock_dma_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(mock_dma_param, "mock-dma");
+	doca_argp_param_set_description(
+		mock_dma_param,
+		"Copy the file locally to <file>.copy with memcpy instead of DMA, no device needed");
+	doca_argp_param_set_callback(mock_dma_param, mock_dma_callback);
+	doca_argp_param_set_type(mock_dma_param, DOCA_ARGP_TYPE_BOOLEAN);
+	result = doca_argp_register_param(mock_dma_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	/* Register validation callback */
 	result = doca_argp_register_validation_callback(args_validation_callback);
 	if (result != DOCA_SUCCESS) {
@@ -587,8 +799,8 @@ static doca_error_t allocate_dma_copy_resources(struct dma_copy_resources *resou
 {
 	struct program_core_objects *state = NULL;
 	doca_error_t result, tmp_result;
-	/* Two buffers for source and destination */
-	uint32_t max_bufs = 2;
+	/* Source and destination buffers for every DMA task */
+	uint32_t max_bufs = 2 * NUM_DMA_TASKS;
 
 	resources->state = malloc(sizeof(*(resources->state)));
 	if (resources->state == NULL) {
@@ -673,6 +885,125 @@ static void send_status_msg(struct doca_comch_connection *comch_connection, bool
 	}
 }
 
+/*
+ * Helper function to send a message across the comch, progressing the connection while the send queue is full.
+ * Must not be called from a comch callback.
+ *
+ * @comch_connection [in]: comch connection to send the message across
+ * @msg [in]: message to send
+ * @len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_msg_with_retry(struct doca_comch_connection *comch_connection, const void *msg, uint32_t len)
+{
+	struct timespec ts = {
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	doca_error_t result;
+
+	result = comch_utils_send(comch_connection, msg, len);
+	while (result == DOCA_ERROR_AGAIN) {
+		nanosleep(&ts, &ts);
+		result = comch_utils_progress_connection(comch_connection);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = comch_utils_send(comch_connection, msg, len);
+	}
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to send message: %s", doca_error_get_descr(result));
+
+	return result;
+}
+
+/*
+ * Helper function to send a chunk message across the comch
+ *
+ * @comch_connection [in]: comch connection to send the message across
+ * @slot [in]: host ring slot holding the chunk
+ * @offset [in]: chunk offset in the file
+ * @len [in]: chunk length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_chunk_msg(struct doca_comch_connection *comch_connection,
+				   uint32_t slot,
+				   uint64_t offset,
+				   uint32_t len)
+{
+	struct comch_msg_dma_chunk chunk_msg = {.type = COMCH_MSG_CHUNK};
+
+	chunk_msg.slot = htonl(slot);
+	chunk_msg.len = htonl(len);
+	chunk_msg.offset = htonq(offset);
+
+	return send_msg_with_retry(comch_connection, &chunk_msg, sizeof(struct comch_msg_dma_chunk));
+}
+
+/*
+ * Helper function to send a chunk acknowledgment message across the comch
+ *
+ * @comch_connection [in]: comch connection to send the message across
+ * @slot [in]: host ring slot that may be reused
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_chunk_ack_msg(struct doca_comch_connection *comch_connection, uint32_t slot)
+{
+	struct comch_msg_dma_chunk_ack ack_msg = {.type = COMCH_MSG_CHUNK_ACK};
+
+	ack_msg.slot = htonl(slot);
+
+	return send_msg_with_retry(comch_connection, &ack_msg, sizeof(struct comch_msg_dma_chunk_ack));
+}
+
+/*
+ * Process a chunk message, marking the host ring slot as holding the chunk
+ *
+ * @cfg [in]: dma copy configuration information
+ * @chunk_msg [in]: the chunk message received
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t process_chunk_msg(struct dma_copy_cfg *cfg, struct comch_msg_dma_chunk *chunk_msg)
+{
+	uint32_t slot = ntohl(chunk_msg->slot);
+	uint32_t len = ntohl(chunk_msg->len);
+	uint64_t offset = ntohq(chunk_msg->offset);
+
+	if (cfg->chunk_size == 0 || slot >= cfg->ring_size || len > cfg->chunk_size || offset > cfg->file_size ||
+	    len > cfg->file_size - offset || cfg->slots[slot].ready) {
+		DOCA_LOG_ERR("Received an invalid chunk message. Slot: %u, offset: %" PRIu64 ", length: %u",
+			     slot,
+			     offset,
+			     len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->slots[slot].offset = offset;
+	cfg->slots[slot].len = len;
+	cfg->slots[slot].ready = true;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Process a chunk acknowledgment message, releasing the host ring slot
+ *
+ * @cfg [in]: dma copy configuration information
+ * @ack_msg [in]: the chunk acknowledgment message received
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t process_chunk_ack_msg(struct dma_copy_cfg *cfg, struct comch_msg_dma_chunk_ack *ack_msg)
+{
+	uint32_t slot = ntohl(ack_msg->slot);
+
+	if (cfg->chunk_size == 0 || slot >= cfg->ring_size || !cfg->slots[slot].busy) {
+		DOCA_LOG_ERR("Received an invalid chunk acknowledgment message. Slot: %u", slot);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->slots[slot].busy = false;
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Process and respond to a DMA direction negotiation message on the host
  *
@@ -690,11 +1021,45 @@ static doca_error_t host_process_dma_direction_and_size(struct dma_copy_cfg *cfg
 	size_t exp_msg_len;
 	const void *export_desc;
 	size_t export_desc_len;
+	uint32_t chunk_size, ring_size;
 	doca_error_t result;
 
-	if (!cfg->is_file_found_locally) {
+	if (!cfg->is_file_found_locally)
 		cfg->file_size = ntohq(dir_msg->file_size);
 
+	/* The DPU may only lower the proposed chunk size, the buffers of a single DMA task were set up already */
+	chunk_size = ntohl(dir_msg->chunk_size);
+	ring_size = ntohl(dir_msg->ring_size);
+	if ((chunk_size == 0) != (cfg->chunk_size == 0) || chunk_size > cfg->chunk_size ||
+	    (chunk_size != 0 && (ring_size == 0 || ring_size > DMA_STREAM_MAX_RING))) {
+		DOCA_LOG_ERR("DPU answered with invalid streaming parameters. Chunk size: %u, ring size: %u",
+			     chunk_size,
+			     ring_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->chunk_size = chunk_size;
+	cfg->ring_size = ring_size;
+
+	if (cfg->chunk_size != 0) {
+		DOCA_LOG_INFO("Streaming the file in chunks of %u bytes over %u slots",
+			      cfg->chunk_size,
+			      cfg->ring_size);
+		cfg->nb_chunks = (cfg->file_size + cfg->chunk_size - 1) / cfg->chunk_size;
+
+		result = open_stream_file(cfg);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		/* Only the ring is exported, the DPU copies the chunks in and out of its slots */
+		result = memory_alloc_and_populate(cfg->file_mmap,
+						   (size_t)cfg->ring_size * cfg->chunk_size,
+						   DOCA_ACCESS_FLAG_PCI_READ_WRITE,
+						   &cfg->file_buffer);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate ring buffer: %s", doca_error_get_descr(result));
+			return DOCA_ERROR_NO_MEMORY;
+		}
+	} else if (!cfg->is_file_found_locally) {
 		/* Allocate a buffer to receive the file data */
 		result = memory_alloc_and_populate(cfg->file_mmap,
 						   cfg->file_size,
@@ -765,6 +1130,9 @@ void host_recv_event_cb(struct doca_comch_event_msg_recv *event,
 	 * It should receive the same format message back from the DPU containing file size if file in on DPU.
 	 * The host will allocate space to receive the file or use preallocated memory if the file is on the host.
 	 * The file location data is exported to the DPU.
+	 * When streaming, the exported memory is a ring of chunk slots. For a host file, the host reads chunks
+	 * into free slots and the DPU acknowledges each chunk it copied. For a DPU file, the DPU signals each
+	 * chunk it copied into a slot, and the host acknowledges it once written to the file.
 	 * When DMA has completed, a status message should be received.
 	 */
 
@@ -805,6 +1173,42 @@ void host_recv_event_cb(struct doca_comch_event_msg_recv *event,
 		else
 			cfg->comch_state = COMCH_COMPLETE;
 
+		break;
+	case COMCH_MSG_CHUNK:
+		if (msg_len != sizeof(struct comch_msg_dma_chunk) || cfg->is_file_found_locally) {
+			DOCA_LOG_ERR("Unexpected chunk message. Length: %u, expected: %lu",
+				     msg_len,
+				     sizeof(struct comch_msg_dma_chunk));
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
+		result = process_chunk_msg(cfg, (struct comch_msg_dma_chunk *)recv_buffer);
+		if (result != DOCA_SUCCESS) {
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
+		break;
+	case COMCH_MSG_CHUNK_ACK:
+		if (msg_len != sizeof(struct comch_msg_dma_chunk_ack) || !cfg->is_file_found_locally) {
+			DOCA_LOG_ERR("Unexpected chunk acknowledgment message. Length: %u, expected: %lu",
+				     msg_len,
+				     sizeof(struct comch_msg_dma_chunk_ack));
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
+		result = process_chunk_ack_msg(cfg, (struct comch_msg_dma_chunk_ack *)recv_buffer);
+		if (result != DOCA_SUCCESS) {
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
 		break;
 	default:
 		DOCA_LOG_ERR("Received bad message type. Type: %u", comch_msg->type);
@@ -833,10 +1237,68 @@ static doca_error_t send_file_direction_request(struct dma_copy_cfg *dma_cfg, st
 		DOCA_LOG_INFO("File was not found locally, it will be DMA copied from the DPU");
 		dir_msg.file_in_host = false;
 	}
+	dir_msg.chunk_size = htonl(dma_cfg->chunk_size);
+	dir_msg.ring_size = htonl(dma_cfg->ring_size);
 
 	return comch_utils_send(comch_util_get_connection(comch_cfg), &dir_msg, sizeof(struct comch_msg_dma_direction));
 }
 
+/*
+ * Progress the host side of a streamed copy: read the next chunks into the free ring slots, or write the chunks the
+ * DPU copied into the ring to the file, in file order.
+ *
+ * @cfg [in]: dma copy configuration information
+ * @comch_connection [in]: comch connection to signal the DPU across
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t host_stream_progress(struct dma_copy_cfg *cfg, struct doca_comch_connection *comch_connection)
+{
+	struct dma_copy_slot_state *slot;
+	uint32_t slot_idx, len;
+	uint64_t offset;
+	char *slot_addr;
+	doca_error_t result;
+
+	while (cfg->next_chunk < cfg->nb_chunks) {
+		slot_idx = cfg->next_chunk % cfg->ring_size;
+		slot = &cfg->slots[slot_idx];
+		slot_addr = cfg->file_buffer + (size_t)slot_idx * cfg->chunk_size;
+
+		if (cfg->is_file_found_locally) {
+			/* The DPU acknowledges a chunk once it copied it out of the slot */
+			if (slot->busy)
+				break;
+			offset = cfg->next_chunk * cfg->chunk_size;
+			len = MIN(cfg->chunk_size, cfg->file_size - offset);
+			result = read_file_chunk(cfg->stream_fd, slot_addr, len, offset);
+			if (result != DOCA_SUCCESS)
+				return result;
+			slot->busy = true;
+			result = send_chunk_msg(comch_connection, slot_idx, offset, len);
+		} else {
+			if (!slot->ready)
+				break;
+			offset = cfg->next_chunk * cfg->chunk_size;
+			if (slot->offset != offset) {
+				DOCA_LOG_ERR("Received chunk at offset %" PRIu64 " instead of %" PRIu64,
+					     slot->offset,
+					     offset);
+				return DOCA_ERROR_BAD_STATE;
+			}
+			result = write_file_chunk(cfg->stream_fd, slot_addr, slot->len, slot->offset);
+			if (result != DOCA_SUCCESS)
+				return result;
+			slot->ready = false;
+			result = send_chunk_ack_msg(comch_connection, slot_idx);
+		}
+		if (result != DOCA_SUCCESS)
+			return result;
+		cfg->next_chunk++;
+	}
+
+	return DOCA_SUCCESS;
+}
+
 doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg *comch_cfg)
 {
 	doca_error_t result, tmp_result;
@@ -872,8 +1334,9 @@ doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg
 	/*
 	 * If the file is local, allocate a DMA buffer and populate it now.
 	 * If file is remote, the buffer can be allocated in the callback when the size if known.
+	 * A streamed copy allocates its ring in the callback, once the DPU agreed on the chunk size.
 	 */
-	if (dma_cfg->is_file_found_locally == true) {
+	if (dma_cfg->is_file_found_locally == true && dma_cfg->chunk_size == 0) {
 		result = memory_alloc_and_populate(dma_cfg->file_mmap,
 						   dma_cfg->file_size,
 						   DOCA_ACCESS_FLAG_PCI_READ_ONLY,
@@ -901,6 +1364,14 @@ doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg
 			DOCA_LOG_ERR("Comch connection unexpectedly dropped: %s", doca_error_get_descr(result));
 			goto free_buffer;
 		}
+
+		if (dma_cfg->stream_fd != -1 && dma_cfg->comch_state == COMCH_NEGOTIATING) {
+			result = host_stream_progress(dma_cfg, comch_util_get_connection(comch_cfg));
+			if (result != DOCA_SUCCESS) {
+				send_status_msg(comch_util_get_connection(comch_cfg), STATUS_FAILURE);
+				goto free_buffer;
+			}
+		}
 	}
 
 	if (dma_cfg->comch_state == COMCH_ERROR) {
@@ -911,7 +1382,15 @@ doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg
 
 	DOCA_LOG_INFO("Final status message was successfully received");
 
-	if (!dma_cfg->is_file_found_locally) {
+	if (dma_cfg->chunk_size != 0) {
+		/* The DPU reports success only once every chunk was acknowledged */
+		if (dma_cfg->next_chunk != dma_cfg->nb_chunks) {
+			DOCA_LOG_ERR("Copy completed after %" PRIu64 " of %" PRIu64 " chunks",
+				     dma_cfg->next_chunk,
+				     dma_cfg->nb_chunks);
+			result = DOCA_ERROR_BAD_STATE;
+		}
+	} else if (!dma_cfg->is_file_found_locally) {
 		/*  File was copied successfully into the buffer, save it into file */
 		DOCA_LOG_INFO("Writing DMA buffer into a file on %s", dma_cfg->file_path);
 		result = save_buffer_into_a_file(dma_cfg, dma_cfg->file_buffer);
@@ -919,6 +1398,8 @@ doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg
 
 free_buffer:
 	free(dma_cfg->file_buffer);
+	if (dma_cfg->stream_fd != -1)
+		close(dma_cfg->stream_fd);
 destroy_mmap:
 	tmp_result = doca_mmap_destroy(dma_cfg->file_mmap);
 	if (tmp_result != DOCA_SUCCESS) {
@@ -962,8 +1443,25 @@ static doca_error_t dpu_process_dma_direction_and_size(struct dma_copy_cfg *cfg,
 		cfg->file_size = ntohq(dir_msg->file_size);
 	}
 
-	/* Verify file size against the HW limitation */
-	if (cfg->file_size > cfg->max_dma_buf_size) {
+	cfg->chunk_size = ntohl(dir_msg->chunk_size);
+	cfg->ring_size = ntohl(dir_msg->ring_size);
+	if (cfg->chunk_size != 0) {
+		/* A streamed copy is bounded by the HW limitation per chunk only */
+		if (cfg->ring_size == 0 || cfg->ring_size > DMA_STREAM_MAX_RING) {
+			DOCA_LOG_ERR("Ring size must be between 1 and %d, received %u",
+				     DMA_STREAM_MAX_RING,
+				     cfg->ring_size);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		if (cfg->chunk_size > cfg->max_dma_buf_size) {
+			DOCA_LOG_INFO("Chunk size of %u bytes lowered to the DMA device maximum of %" PRIu64 " bytes",
+				      cfg->chunk_size,
+				      cfg->max_dma_buf_size);
+			cfg->chunk_size = cfg->max_dma_buf_size;
+		}
+		cfg->nb_chunks = (cfg->file_size + cfg->chunk_size - 1) / cfg->chunk_size;
+	} else if (cfg->file_size > cfg->max_dma_buf_size) {
+		/* Verify file size against the HW limitation */
 		DOCA_LOG_ERR("DMA device maximum allowed file size in bytes is %" PRIu64
 			     ", received file size is %" PRIu64 " bytes",
 			     cfg->max_dma_buf_size,
@@ -980,6 +1478,8 @@ static doca_error_t dpu_process_dma_direction_and_size(struct dma_copy_cfg *cfg,
 		DOCA_LOG_INFO("File was not found locally, it will be DMA copied from the Host");
 		resp_dir_msg.file_in_host = true;
 	}
+	resp_dir_msg.chunk_size = htonl(cfg->chunk_size);
+	resp_dir_msg.ring_size = htonl(cfg->ring_size);
 
 	result = comch_utils_send(comch_connection, &resp_dir_msg, sizeof(struct comch_msg_dma_direction));
 	if (result != DOCA_SUCCESS) {
@@ -1048,6 +1548,7 @@ void dpu_recv_event_cb(struct doca_comch_event_msg_recv *event,
 	 * This should be responded to as an ack or containing the file information if file is local to the DPU.
 	 * The host will respond will memory information the DPU can read from or write to.
 	 * At this stage the DMA can be triggered.
+	 * When streaming, chunk and chunk acknowledgment messages then hand the host ring slots back and forth.
 	 */
 
 	switch (comch_msg->type) {
@@ -1104,6 +1605,40 @@ void dpu_recv_event_cb(struct doca_comch_event_msg_recv *event,
 		if (status->is_success == STATUS_FAILURE)
 			cfg->comch_state = COMCH_ERROR;
 
+		break;
+	case COMCH_MSG_CHUNK:
+		if (msg_len != sizeof(struct comch_msg_dma_chunk) || cfg->is_file_found_locally) {
+			DOCA_LOG_ERR("Unexpected chunk message. Length: %u, expected: %lu",
+				     msg_len,
+				     sizeof(struct comch_msg_dma_chunk));
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
+		result = process_chunk_msg(cfg, (struct comch_msg_dma_chunk *)recv_buffer);
+		if (result != DOCA_SUCCESS) {
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+		break;
+	case COMCH_MSG_CHUNK_ACK:
+		if (msg_len != sizeof(struct comch_msg_dma_chunk_ack) || !cfg->is_file_found_locally) {
+			DOCA_LOG_ERR("Unexpected chunk acknowledgment message. Length: %u, expected: %lu",
+				     msg_len,
+				     sizeof(struct comch_msg_dma_chunk_ack));
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
+
+		result = process_chunk_ack_msg(cfg, (struct comch_msg_dma_chunk_ack *)recv_buffer);
+		if (result != DOCA_SUCCESS) {
+			send_status_msg(comch_connection, STATUS_FAILURE);
+			cfg->comch_state = COMCH_ERROR;
+			return;
+		}
 		break;
 	default:
 		DOCA_LOG_ERR("Received bad message type. Type: %u", comch_msg->type);
@@ -1113,6 +1648,225 @@ void dpu_recv_event_cb(struct doca_comch_event_msg_recv *event,
 	}
 }
 
+/* Context of the stage callbacks of a streamed copy on the DPU */
+struct dpu_stream_ctx {
+	struct dma_copy_cfg *cfg;			/* Application configuration */
+	struct doca_comch_connection *comch_connection;	/* Comch connection to the host */
+	char *local_ring;				/* Local ring address */
+};
+
+/*
+ * Fill stage of a streamed copy on the DPU.
+ * For a host file the chunk is ready once the host signaled it, for a DPU file it is read into the local slot.
+ *
+ * @user_data [in]: DPU stream context
+ * @slot [in]: ring slot of the chunk
+ * @offset [in]: chunk offset in the file
+ * @len [in]: chunk length
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the slot is not ready and DOCA_ERROR otherwise
+ */
+static doca_error_t dpu_stream_fill(void *user_data, uint32_t slot, uint64_t offset, uint32_t len)
+{
+	struct dpu_stream_ctx *ctx = (struct dpu_stream_ctx *)user_data;
+	struct dma_copy_cfg *cfg = ctx->cfg;
+	struct dma_copy_slot_state *slot_state = &cfg->slots[slot];
+	doca_error_t result;
+
+	if (!cfg->is_file_found_locally) {
+		if (!slot_state->ready)
+			return DOCA_ERROR_AGAIN;
+		if (slot_state->offset != offset || slot_state->len != len) {
+			DOCA_LOG_ERR("Host signaled chunk at offset %" PRIu64 " instead of %" PRIu64,
+				     slot_state->offset,
+				     offset);
+			return DOCA_ERROR_BAD_STATE;
+		}
+		slot_state->ready = false;
+		return DOCA_SUCCESS;
+	}
+
+	/* The host slot is overwritten only once the host wrote its previous chunk */
+	if (slot_state->busy)
+		return DOCA_ERROR_AGAIN;
+
+	result = read_file_chunk(cfg->stream_fd, ctx->local_ring + (size_t)slot * cfg->chunk_size, len, offset);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	slot_state->busy = true;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Drain stage of a streamed copy on the DPU.
+ * For a host file the local slot is written to the file and the host slot released, for a DPU file the host is
+ * signaled that the chunk is in its slot.
+ *
+ * @user_data [in]: DPU stream context
+ * @slot [in]: ring slot of the chunk
+ * @offset [in]: chunk offset in the file
+ * @len [in]: chunk length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dpu_stream_drain(void *user_data, uint32_t slot, uint64_t offset, uint32_t len)
+{
+	struct dpu_stream_ctx *ctx = (struct dpu_stream_ctx *)user_data;
+	struct dma_copy_cfg *cfg = ctx->cfg;
+	doca_error_t result;
+
+	if (cfg->is_file_found_locally)
+		return send_chunk_msg(ctx->comch_connection, slot, offset, len);
+
+	result = write_file_chunk(cfg->stream_fd, ctx->local_ring + (size_t)slot * cfg->chunk_size, len, offset);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	return send_chunk_ack_msg(ctx->comch_connection, slot);
+}
+
+/*
+ * Progress the comch connection of a streamed copy on the DPU
+ *
+ * @user_data [in]: DPU stream context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dpu_stream_progress(void *user_data)
+{
+	struct dpu_stream_ctx *ctx = (struct dpu_stream_ctx *)user_data;
+	doca_error_t result;
+
+	result = comch_utils_progress_connection(ctx->comch_connection);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Comch connection unexpectedly dropped: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	if (ctx->cfg->comch_state == COMCH_ERROR) {
+		DOCA_LOG_ERR("Failure was detected in dma copy");
+		return DOCA_ERROR_BAD_STATE;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * DPU side streamed copy: move the file through a ring of chunk slots on each side, keeping up to a ring of DMA
+ * tasks in flight while the file is read or written.
+ *
+ * @cfg [in]: Application configuration
+ * @comch_cfg [in]: Doca comch initialized objects
+ * @resources [in]: DMA copy resources, with a started DMA context
+ * @num_remaining_tasks [in]: Tasks counter in the user data of the DMA context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dpu_stream_dma_copy(struct dma_copy_cfg *cfg,
+					struct comch_cfg *comch_cfg,
+					struct dma_copy_resources *resources,
+					size_t *num_remaining_tasks)
+{
+	struct program_core_objects *state = resources->state;
+	struct doca_comch_connection *comch_connection = comch_util_get_connection(comch_cfg);
+	/* Local slots are read by the DMA when the file is local, and written otherwise */
+	uint32_t access_flags = cfg->is_file_found_locally ? DOCA_ACCESS_FLAG_LOCAL_READ_ONLY :
+							     DOCA_ACCESS_FLAG_LOCAL_READ_WRITE;
+	struct dpu_stream_ctx ctx = {.cfg = cfg, .comch_connection = comch_connection};
+	struct dma_stream_ops ops = {
+		.fill = dpu_stream_fill,
+		.drain = dpu_stream_drain,
+		.progress = dpu_stream_progress,
+		.user_data = &ctx,
+	};
+	struct doca_mmap *remote_mmap = NULL;
+	struct dma_stream *stream = NULL;
+	char *remote_ring = (char *)cfg->host_addr;
+	uint32_t i;
+	doca_error_t result, tmp_result;
+	struct timespec ts = {
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+
+	result = open_stream_file(cfg);
+	if (result != DOCA_SUCCESS)
+		goto send_status;
+
+	result = memory_alloc_and_populate(state->src_mmap,
+					   (size_t)cfg->ring_size * cfg->chunk_size,
+					   access_flags,
+					   &ctx.local_ring);
+	if (result != DOCA_SUCCESS)
+		goto close_file;
+
+	/* Create a local DOCA mmap from export descriptor */
+	result = doca_mmap_create_from_export(NULL,
+					      (const void *)cfg->exported_mmap,
+					      cfg->exported_mmap_len,
+					      state->dev,
+					      &remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create memory map from export: %s", doca_error_get_descr(result));
+		goto free_ring;
+	}
+
+	result = dma_stream_create(cfg->file_size, cfg->chunk_size, cfg->ring_size, &ops, &stream);
+	if (result != DOCA_SUCCESS)
+		goto destroy_remote_mmap;
+
+	*num_remaining_tasks = 0;
+	if (cfg->is_file_found_locally)
+		result = dma_stream_attach_dma(stream,
+					       state,
+					       resources->dma_ctx,
+					       num_remaining_tasks,
+					       state->src_mmap,
+					       ctx.local_ring,
+					       remote_mmap,
+					       remote_ring);
+	else
+		result = dma_stream_attach_dma(stream,
+					       state,
+					       resources->dma_ctx,
+					       num_remaining_tasks,
+					       remote_mmap,
+					       remote_ring,
+					       state->src_mmap,
+					       ctx.local_ring);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	result = dma_stream_run(stream);
+	if (result != DOCA_SUCCESS)
+		goto destroy_stream;
+
+	/* The copy is complete once the host wrote every chunk it was signaled */
+	for (i = 0; i < cfg->ring_size; i++) {
+		while (cfg->slots[i].busy) {
+			result = dpu_stream_progress(&ctx);
+			if (result != DOCA_SUCCESS)
+				goto destroy_stream;
+			nanosleep(&ts, &ts);
+		}
+	}
+
+	dma_stream_log_stats(stream);
+
+destroy_stream:
+	dma_stream_destroy(stream);
+destroy_remote_mmap:
+	tmp_result = doca_mmap_destroy(remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote DOCA mmap: %s", doca_error_get_descr(tmp_result));
+	}
+free_ring:
+	free(ctx.local_ring);
+close_file:
+	close(cfg->stream_fd);
+	cfg->stream_fd = -1;
+send_status:
+	send_status_msg(comch_connection, result == DOCA_SUCCESS ? STATUS_SUCCESS : STATUS_FAILURE);
+	return result;
+}
+
 doca_error_t dpu_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg *comch_cfg)
 {
 	struct dma_copy_resources resources = {0};
@@ -1169,6 +1923,11 @@ doca_error_t dpu_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg *
 		goto stop_dma;
 	}
 
+	if (dma_cfg->chunk_size != 0) {
+		result = dpu_stream_dma_copy(dma_cfg, comch_cfg, &resources, &num_remaining_tasks);
+		goto stop_dma;
+	}
+
 	/* Configure buffer to send/recv file on */
 	result = memory_alloc_and_populate(state->src_mmap, dma_cfg->file_size, access_flags, &dma_cfg->file_buffer);
 	if (result != DOCA_SUCCESS)
@@ -1270,3 +2029,101 @@ destroy_dma_resources:
 	}
 	return result;
 }
+
+/* Context of the stage callbacks of a mock streamed copy */
+struct mock_stream_ctx {
+	int in_fd;	     /* Source file descriptor */
+	int out_fd;	     /* Destination file descriptor */
+	uint32_t chunk_size; /* Slot size */
+	char *src_ring;	     /* Source ring address */
+	char *dst_ring;	     /* Destination ring address */
+};
+
+/*
+ * Fill stage of a mock streamed copy, reads the chunk into its source slot
+ *
+ * @user_data [in]: mock stream context
+ * @slot [in]: ring slot of the chunk
+ * @offset [in]: chunk offset in the file
+ * @len [in]: chunk length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mock_stream_fill(void *user_data, uint32_t slot, uint64_t offset, uint32_t len)
+{
+	struct mock_stream_ctx *ctx = (struct mock_stream_ctx *)user_data;
+
+	return read_file_chunk(ctx->in_fd, ctx->src_ring + (size_t)slot * ctx->chunk_size, len, offset);
+}
+
+/*
+ * Drain stage of a mock streamed copy, writes the destination slot to the copy
+ *
+ * @user_data [in]: mock stream context
+ * @slot [in]: ring slot of the chunk
+ * @offset [in]: chunk offset in the file
+ * @len [in]: chunk length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mock_stream_drain(void *user_data, uint32_t slot, uint64_t offset, uint32_t len)
+{
+	struct mock_stream_ctx *ctx = (struct mock_stream_ctx *)user_data;
+
+	return write_file_chunk(ctx->out_fd, ctx->dst_ring + (size_t)slot * ctx->chunk_size, len, offset);
+}
+
+doca_error_t mock_start_dma_copy(struct dma_copy_cfg *dma_cfg)
+{
+	char copy_path[MAX_ARG_SIZE + sizeof(".copy")];
+	size_t ring_len = (size_t)dma_cfg->ring_size * dma_cfg->chunk_size;
+	struct mock_stream_ctx ctx = {.chunk_size = dma_cfg->chunk_size, .in_fd = -1, .out_fd = -1};
+	struct dma_stream_ops ops = {
+		.fill = mock_stream_fill,
+		.drain = mock_stream_drain,
+		.user_data = &ctx,
+	};
+	struct dma_stream *stream = NULL;
+	doca_error_t result;
+
+	snprintf(copy_path, sizeof(copy_path), "%s.copy", dma_cfg->file_path);
+	DOCA_LOG_INFO("Mock DMA: streaming %s to %s in chunks of %u bytes over %u slots",
+		      dma_cfg->file_path,
+		      copy_path,
+		      dma_cfg->chunk_size,
+		      dma_cfg->ring_size);
+
+	ctx.in_fd = open(dma_cfg->file_path, O_RDONLY);
+	ctx.out_fd = open(copy_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (ctx.in_fd < 0 || ctx.out_fd < 0) {
+		DOCA_LOG_ERR("Failed to open the mock DMA files: %s", strerror(errno));
+		result = DOCA_ERROR_IO_FAILED;
+		goto close_files;
+	}
+
+	ctx.src_ring = malloc(ring_len);
+	ctx.dst_ring = malloc(ring_len);
+	if (ctx.src_ring == NULL || ctx.dst_ring == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the mock DMA rings");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_rings;
+	}
+
+	result = dma_stream_create(dma_cfg->file_size, dma_cfg->chunk_size, dma_cfg->ring_size, &ops, &stream);
+	if (result != DOCA_SUCCESS)
+		goto free_rings;
+	dma_stream_attach_mock(stream, ctx.src_ring, ctx.dst_ring);
+
+	result = dma_stream_run(stream);
+	if (result == DOCA_SUCCESS)
+		dma_stream_log_stats(stream);
+
+	dma_stream_destroy(stream);
+free_rings:
+	free(ctx.dst_ring);
+	free(ctx.src_ring);
+close_files:
+	if (ctx.out_fd >= 0)
+		close(ctx.out_fd);
+	if (ctx.in_fd >= 0)
+		close(ctx.in_fd);
+	return result;
+}
@@ -35,10 +35,14 @@
 #include <doca_pe.h>
 
 #include "comch_utils.h"
+#include "dma_copy_stream.h"
 
-#define MAX_ARG_SIZE 128	      /* PCI address and file path maximum length */
-#define SERVER_NAME "dma copy server" /* Comm Channel service name */
-#define NUM_DMA_TASKS (1)	      /* DMA tasks number */
+#define MAX_ARG_SIZE 128		    /* PCI address and file path maximum length */
+#define SERVER_NAME "dma copy server"	    /* Comm Channel service name */
+#define NUM_DMA_TASKS (DMA_STREAM_MAX_RING) /* DMA tasks number, one per ring slot when streaming */
+#define DEFAULT_CHUNK_SIZE_KB 1024	    /* Default chunk size of the streamed copy */
+#define DEFAULT_RING_SIZE 16		    /* Default number of ring slots of the streamed copy */
+#define MAX_CHUNK_SIZE_KB (256 * 1024)	    /* Maximal chunk size of the streamed copy */
 
 enum dma_copy_mode {
 	DMA_COPY_MODE_HOST, /* Run endpoint in Host */
@@ -49,12 +53,21 @@ enum comch_msg_type {
 	COMCH_MSG_DIRECTION = 1,	 /* Message type to negotiate file direction */
 	COMCH_MSG_EXPORT_DESCRIPTOR = 2, /* Message type to export dma descriptor information */
 	COMCH_MSG_STATUS = 3,		 /* Generic success/fail message type */
+	COMCH_MSG_CHUNK = 4,		 /* Message type to signal a chunk is ready in a host ring slot */
+	COMCH_MSG_CHUNK_ACK = 5,	 /* Message type to release a host ring slot */
 };
 
+/*
+ * The direction message carries the streaming parameters. The host proposes them, and the DPU answers with the
+ * values both sides use (the chunk size is capped by the DMA device). A chunk size of 0 copies the file with a single
+ * DMA task.
+ */
 struct comch_msg_dma_direction {
 	enum comch_msg_type type; /* COMCH_MSG_DIRECTION */
 	bool file_in_host;	  /* Indicate where the source file is located */
 	uint64_t file_size;	  /* File size in bytes */
+	uint32_t chunk_size;	  /* Chunk size in bytes of a streamed copy, 0 for a single DMA task */
+	uint32_t ring_size;	  /* Number of slots of the ring of a streamed copy */
 };
 
 struct comch_msg_dma_export_discriptor {
@@ -69,12 +82,26 @@ struct comch_msg_dma_status {
 	bool is_success;	  /* Indicate success or failure for last message sent */
 };
 
+struct comch_msg_dma_chunk {
+	enum comch_msg_type type; /* COMCH_MSG_CHUNK */
+	uint32_t slot;		  /* Host ring slot holding the chunk */
+	uint32_t len;		  /* Chunk length */
+	uint64_t offset;	  /* Chunk offset in the file */
+};
+
+struct comch_msg_dma_chunk_ack {
+	enum comch_msg_type type; /* COMCH_MSG_CHUNK_ACK */
+	uint32_t slot;		  /* Host ring slot that may be reused */
+};
+
 struct comch_msg {
 	enum comch_msg_type type; /* Indicator of message type */
 	union {
 		struct comch_msg_dma_direction dir_msg;		/* COMCH_MSG_DIRECTION type*/
 		struct comch_msg_dma_export_discriptor exp_msg; /* COMCH_MSG_EXPORT_DESCRIPTOR type */
 		struct comch_msg_dma_status status_msg;		/* COMCH_MSG_STATUS type */
+		struct comch_msg_dma_chunk chunk_msg;		/* COMCH_MSG_CHUNK type */
+		struct comch_msg_dma_chunk_ack ack_msg;		/* COMCH_MSG_CHUNK_ACK type */
 	};
 };
 
@@ -84,6 +111,14 @@ enum dma_comch_state {
 	COMCH_ERROR,	   /* An error was detected DMA metadata negotiation */
 };
 
+/* State of a host ring slot, as seen by each side of a streamed copy */
+struct dma_copy_slot_state {
+	bool busy;	 /* Host slot holds a chunk that was not acknowledged yet */
+	bool ready;	 /* A chunk message was received for the slot and not consumed yet */
+	uint64_t offset; /* Offset of the chunk in the slot */
+	uint32_t len;	 /* Length of the chunk in the slot */
+};
+
 struct dma_copy_cfg {
 	enum dma_copy_mode mode;      /* Node running mode {host, dpu} */
 	char file_path[MAX_ARG_SIZE]; /* File path to copy from (host) or path the save DMA result (dpu) */
@@ -95,6 +130,15 @@ struct dma_copy_cfg {
 	struct doca_mmap *file_mmap;				  /* Mmap associated with the file buffer */
 	struct doca_dev *dev;					  /* Doca device used for DMA */
 	uint64_t max_dma_buf_size;				  /* Max size DMA supported */
+	bool mock_dma;						  /* Stream the file locally with a memcpy engine */
+
+	/* Streamed copy */
+	uint32_t chunk_size;				       /* Chunk size in bytes, 0 for a single DMA task */
+	uint32_t ring_size;				       /* Number of ring slots */
+	int stream_fd;					       /* File descriptor of the streamed file */
+	uint64_t nb_chunks;				       /* Number of chunks of the file */
+	uint64_t next_chunk;				       /* Next chunk the host fills or writes */
+	struct dma_copy_slot_state slots[DMA_STREAM_MAX_RING]; /* Host ring slots */
 
 	/* DPU side only field */
 	uint8_t *exported_mmap;	  /* Exported mmap sent from host to DPU */
@@ -143,6 +187,15 @@ doca_error_t host_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg
  */
 doca_error_t dpu_start_dma_copy(struct dma_copy_cfg *dma_cfg, struct comch_cfg *comch_cfg);
 
+/*
+ * Stream the file to <file>.copy through the chunk pipeline, with a memcpy engine instead of a DMA device.
+ * Used to measure the pipeline without a device.
+ *
+ * @dma_cfg [in]: App configuration structure
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t mock_start_dma_copy(struct dma_copy_cfg *dma_cfg);
+
 /*
  * Callback event for client messages
  *
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_log.h>
+#include <doca_pe.h>
+
+#include "utils.h"
+
+#include "dma_copy_stream.h"
+
+#define STREAM_SLEEP_IN_NANOS (1 * 1000) /* Sleep when a pass over the pipeline made no progress */
+
+DOCA_LOG_REGISTER(DMA_COPY_STREAM);
+
+/* A ring slot */
+struct dma_stream_slot {
+	doca_error_t status;		   /* Copy status, DOCA_ERROR_IN_PROGRESS while the copy is in flight */
+	struct doca_buf *src_buf;	   /* DOCA buffer over the source slot, DMA engine only */
+	struct doca_buf *dst_buf;	   /* DOCA buffer over the destination slot, DMA engine only */
+	struct doca_dma_task_memcpy *task; /* Task in flight, DMA engine only */
+};
+
+struct dma_stream {
+	struct dma_stream_ops ops;			   /* Stage callbacks */
+	uint64_t file_size;				   /* Number of bytes to copy */
+	uint32_t chunk_size;				   /* Chunk size */
+	uint32_t ring_size;				   /* Number of ring slots */
+	uint64_t nb_chunks;				   /* Number of chunks of the file */
+	uint64_t next_fill;				   /* Next chunk to fill */
+	uint64_t next_drain;				   /* Next chunk to drain, chunks up to next_fill own a slot */
+	char *src_ring;					   /* Source ring */
+	char *dst_ring;					   /* Destination ring */
+	struct dma_stream_slot slots[DMA_STREAM_MAX_RING]; /* Ring slots */
+
+	/* DMA engine, dma_ctx is NULL for the memcpy engine */
+	struct program_core_objects *state; /* Core objects of the DMA context */
+	struct doca_dma *dma_ctx;	    /* DMA context */
+	size_t *nb_inflight;		    /* Number of tasks in flight, decremented by the task callbacks */
+
+	/* Statistics */
+	uint64_t fill_ns;  /* Time spent in the fill stage */
+	uint64_t copy_ns;  /* Time spent copying, memcpy engine only */
+	uint64_t drain_ns; /* Time spent in the drain stage */
+	uint64_t total_ns; /* Duration of the run */
+};
+
+/*
+ * Get the current time in nanoseconds
+ *
+ * @return: monotonic time in nanoseconds
+ */
+static uint64_t stream_get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/*
+ * Get the length of a chunk
+ *
+ * @stream [in]: stream
+ * @chunk [in]: chunk index
+ * @return: chunk length
+ */
+static uint32_t stream_chunk_len(struct dma_stream *stream, uint64_t chunk)
+{
+	uint64_t offset = chunk * stream->chunk_size;
+
+	return MIN(stream->chunk_size, stream->file_size - offset);
+}
+
+doca_error_t dma_stream_create(uint64_t file_size,
+			       uint32_t chunk_size,
+			       uint32_t ring_size,
+			       const struct dma_stream_ops *ops,
+			       struct dma_stream **stream)
+{
+	struct dma_stream *new_stream;
+
+	if (chunk_size == 0 || ring_size == 0 || ring_size > DMA_STREAM_MAX_RING || ops->fill == NULL ||
+	    ops->drain == NULL) {
+		DOCA_LOG_ERR("Invalid stream configuration");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_stream = calloc(1, sizeof(*new_stream));
+	if (new_stream == NULL) {
+		DOCA_LOG_ERR("Failed to allocate stream");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	new_stream->ops = *ops;
+	new_stream->file_size = file_size;
+	new_stream->chunk_size = chunk_size;
+	new_stream->ring_size = ring_size;
+	new_stream->nb_chunks = (file_size + chunk_size - 1) / chunk_size;
+
+	*stream = new_stream;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t dma_stream_attach_dma(struct dma_stream *stream,
+				   struct program_core_objects *state,
+				   struct doca_dma *dma_ctx,
+				   size_t *nb_inflight,
+				   struct doca_mmap *src_mmap,
+				   char *src_ring,
+				   struct doca_mmap *dst_mmap,
+				   char *dst_ring)
+{
+	struct dma_stream_slot *slot;
+	size_t slot_offset;
+	uint32_t i;
+	doca_error_t result;
+
+	stream->state = state;
+	stream->dma_ctx = dma_ctx;
+	stream->nb_inflight = nb_inflight;
+	stream->src_ring = src_ring;
+	stream->dst_ring = dst_ring;
+
+	for (i = 0; i < stream->ring_size; i++) {
+		slot = &stream->slots[i];
+		slot_offset = (size_t)i * stream->chunk_size;
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    src_mmap,
+							    src_ring + slot_offset,
+							    stream->chunk_size,
+							    &slot->src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer of source slot %u: %s",
+				     i,
+				     doca_error_get_descr(result));
+			return result;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    dst_mmap,
+							    dst_ring + slot_offset,
+							    stream->chunk_size,
+							    &slot->dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer of destination slot %u: %s",
+				     i,
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+void dma_stream_attach_mock(struct dma_stream *stream, char *src_ring, char *dst_ring)
+{
+	stream->src_ring = src_ring;
+	stream->dst_ring = dst_ring;
+}
+
+/*
+ * Start the copy of a slot
+ *
+ * @stream [in]: stream
+ * @slot_idx [in]: slot to copy
+ * @len [in]: length of the chunk in the slot
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t stream_submit(struct dma_stream *stream, uint32_t slot_idx, uint32_t len)
+{
+	struct dma_stream_slot *slot = &stream->slots[slot_idx];
+	union doca_data task_user_data = {.ptr = &slot->status};
+	doca_error_t result;
+
+	slot->status = DOCA_ERROR_IN_PROGRESS;
+
+	/* The memcpy engine copies the slot when polled */
+	if (stream->dma_ctx == NULL)
+		return DOCA_SUCCESS;
+
+	result = doca_buf_set_data(slot->src_buf, stream->src_ring + (size_t)slot_idx * stream->chunk_size, len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set data for DOCA buffer: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_buf_reset_data_len(slot->dst_buf);
+
+	result = doca_dma_task_memcpy_alloc_init(stream->dma_ctx,
+						 slot->src_buf,
+						 slot->dst_buf,
+						 task_user_data,
+						 &slot->task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	(*stream->nb_inflight)++;
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(slot->task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
+		(*stream->nb_inflight)--;
+		doca_task_free(doca_dma_task_memcpy_as_task(slot->task));
+		slot->task = NULL;
+	}
+	return result;
+}
+
+/*
+ * Poll the copy engine, completing the copies of the chunks in the pipeline
+ *
+ * @stream [in]: stream
+ * @return: true if a copy completed
+ */
+static bool stream_poll(struct dma_stream *stream)
+{
+	struct dma_stream_slot *slot;
+	uint64_t chunk, start;
+	uint32_t slot_idx;
+	size_t slot_offset;
+	bool progressed = false;
+
+	if (stream->dma_ctx != NULL && *stream->nb_inflight > 0)
+		progressed = doca_pe_progress(stream->state->pe) != 0;
+
+	for (chunk = stream->next_drain; chunk < stream->next_fill; chunk++) {
+		slot_idx = chunk % stream->ring_size;
+		slot = &stream->slots[slot_idx];
+		if (slot->status != DOCA_ERROR_IN_PROGRESS) {
+			if (slot->task != NULL) {
+				doca_task_free(doca_dma_task_memcpy_as_task(slot->task));
+				slot->task = NULL;
+			}
+			continue;
+		}
+
+		if (stream->dma_ctx == NULL) {
+			slot_offset = (size_t)slot_idx * stream->chunk_size;
+			start = stream_get_time_ns();
+			memcpy(stream->dst_ring + slot_offset,
+			       stream->src_ring + slot_offset,
+			       stream_chunk_len(stream, chunk));
+			stream->copy_ns += stream_get_time_ns() - start;
+			slot->status = DOCA_SUCCESS;
+			progressed = true;
+		}
+	}
+	return progressed;
+}
+
+doca_error_t dma_stream_run(struct dma_stream *stream)
+{
+	struct timespec ts = {
+		.tv_nsec = STREAM_SLEEP_IN_NANOS,
+	};
+	struct dma_stream_slot *slot;
+	uint64_t run_start, start, offset;
+	uint32_t slot_idx, len;
+	bool progressed;
+	doca_error_t result = DOCA_SUCCESS;
+
+	run_start = stream_get_time_ns();
+	while (stream->next_drain < stream->nb_chunks) {
+		progressed = false;
+
+		/* Fill the next chunks while their slots are free, and start their copies */
+		while (stream->next_fill < stream->nb_chunks &&
+		       stream->next_fill - stream->next_drain < stream->ring_size) {
+			slot_idx = stream->next_fill % stream->ring_size;
+			offset = stream->next_fill * stream->chunk_size;
+			len = stream_chunk_len(stream, stream->next_fill);
+
+			start = stream_get_time_ns();
+			result = stream->ops.fill(stream->ops.user_data, slot_idx, offset, len);
+			stream->fill_ns += stream_get_time_ns() - start;
+			if (result == DOCA_ERROR_AGAIN)
+				break;
+			if (result != DOCA_SUCCESS)
+				goto out;
+
+			result = stream_submit(stream, slot_idx, len);
+			if (result != DOCA_SUCCESS)
+				goto out;
+			stream->next_fill++;
+			progressed = true;
+		}
+
+		if (stream_poll(stream))
+			progressed = true;
+
+		/* Drain the copied chunks in file order */
+		while (stream->next_drain < stream->next_fill) {
+			slot_idx = stream->next_drain % stream->ring_size;
+			slot = &stream->slots[slot_idx];
+			if (slot->status == DOCA_ERROR_IN_PROGRESS || slot->task != NULL)
+				break;
+			if (slot->status != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("DMA copy of chunk %lu failed: %s",
+					     stream->next_drain,
+					     doca_error_get_descr(slot->status));
+				result = slot->status;
+				goto out;
+			}
+
+			start = stream_get_time_ns();
+			result = stream->ops.drain(stream->ops.user_data,
+						   slot_idx,
+						   stream->next_drain * stream->chunk_size,
+						   stream_chunk_len(stream, stream->next_drain));
+			stream->drain_ns += stream_get_time_ns() - start;
+			if (result == DOCA_ERROR_AGAIN)
+				break;
+			if (result != DOCA_SUCCESS)
+				goto out;
+			stream->next_drain++;
+			progressed = true;
+		}
+
+		if (stream->ops.progress != NULL) {
+			result = stream->ops.progress(stream->ops.user_data);
+			if (result != DOCA_SUCCESS)
+				goto out;
+		}
+
+		if (!progressed)
+			nanosleep(&ts, &ts);
+	}
+	result = DOCA_SUCCESS;
+
+out:
+	stream->total_ns = stream_get_time_ns() - run_start;
+	return result;
+}
+
+void dma_stream_log_stats(struct dma_stream *stream)
+{
+	uint64_t nb_bytes = 0;
+
+	if (stream->next_drain == stream->nb_chunks)
+		nb_bytes = stream->file_size;
+	else if (stream->next_drain > 0)
+		nb_bytes = stream->next_drain * stream->chunk_size;
+
+	DOCA_LOG_INFO("Streamed %lu bytes in %lu chunks of %u bytes over %u slots in %.3f ms: %.2f GB/s",
+		      nb_bytes,
+		      stream->next_drain,
+		      stream->chunk_size,
+		      stream->ring_size,
+		      (double)stream->total_ns / 1e6,
+		      stream->total_ns == 0 ? 0.0 : (double)nb_bytes / (double)stream->total_ns);
+	DOCA_LOG_INFO("Stage busy time: fill %.3f ms, copy %s%.3f ms, drain %.3f ms",
+		      (double)stream->fill_ns / 1e6,
+		      stream->dma_ctx == NULL ? "(memcpy) " : "(DMA, not measured) ",
+		      (double)stream->copy_ns / 1e6,
+		      (double)stream->drain_ns / 1e6);
+}
+
+void dma_stream_destroy(struct dma_stream *stream)
+{
+	struct timespec ts = {
+		.tv_nsec = STREAM_SLEEP_IN_NANOS,
+	};
+	struct dma_stream_slot *slot;
+	uint32_t i;
+
+	/* Tasks of a failed run may still be in flight, they must complete before their buffers are released */
+	if (stream->dma_ctx != NULL) {
+		while (*stream->nb_inflight > 0) {
+			if (doca_pe_progress(stream->state->pe) == 0)
+				nanosleep(&ts, &ts);
+		}
+	}
+
+	for (i = 0; i < stream->ring_size; i++) {
+		slot = &stream->slots[i];
+		if (slot->task != NULL)
+			doca_task_free(doca_dma_task_memcpy_as_task(slot->task));
+		if (slot->src_buf != NULL)
+			doca_buf_dec_refcount(slot->src_buf, NULL);
+		if (slot->dst_buf != NULL)
+			doca_buf_dec_refcount(slot->dst_buf, NULL);
+	}
+	free(stream);
+}
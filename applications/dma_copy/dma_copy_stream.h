@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef DMA_COPY_STREAM_H_
+#define DMA_COPY_STREAM_H_
+
+#include <stdint.h>
+
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+
+#include <samples/common.h>
+
+#define DMA_STREAM_MAX_RING 64 /* Maximal number of ring slots, and of DMA tasks in flight */
+
+/*
+ * Streamed copy:
+ *	The file is moved in chunks of chunk_size bytes (the last chunk may be shorter). Chunk c travels through slot
+ *	c % ring_size of a source ring and of a destination ring, so up to ring_size chunks are in the pipeline:
+ *	fill - the chunk is placed in its source slot (read from the file, or signaled by the peer)
+ *	copy - a DMA task copies the source slot to the destination slot
+ *	drain - the destination slot is consumed (written to the file, or signaled to the peer)
+ *	Chunks are drained in file order, and a slot is refilled only after its previous chunk was drained.
+ */
+
+/* Stage callbacks of a stream, an op may return DOCA_ERROR_AGAIN when the slot is not ready yet */
+struct dma_stream_ops {
+	/* Fill the source slot with the chunk at offset */
+	doca_error_t (*fill)(void *user_data, uint32_t slot, uint64_t offset, uint32_t len);
+	/* Consume the destination slot holding the chunk at offset */
+	doca_error_t (*drain)(void *user_data, uint32_t slot, uint64_t offset, uint32_t len);
+	/* Progress the control path, may be NULL */
+	doca_error_t (*progress)(void *user_data);
+	void *user_data; /* Passed to all callbacks */
+};
+
+/* Opaque streamed copy */
+struct dma_stream;
+
+/*
+ * Create a streamed copy, an engine must be attached before running it
+ *
+ * @file_size [in]: number of bytes to copy
+ * @chunk_size [in]: chunk size
+ * @ring_size [in]: number of ring slots, up to DMA_STREAM_MAX_RING
+ * @ops [in]: stage callbacks
+ * @stream [out]: the created stream
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_stream_create(uint64_t file_size,
+			       uint32_t chunk_size,
+			       uint32_t ring_size,
+			       const struct dma_stream_ops *ops,
+			       struct dma_stream **stream);
+
+/*
+ * Copy the slots with DOCA DMA memcpy tasks.
+ * The DMA context must be started, with its user data pointing at nb_inflight that the task callbacks decrement,
+ * and with room for ring_size tasks.
+ *
+ * @stream [in]: stream
+ * @state [in]: core objects of the DMA context
+ * @dma_ctx [in]: DMA context
+ * @nb_inflight [in]: counter of tasks in flight, decremented by the task callbacks
+ * @src_mmap [in]: memory map of the source ring
+ * @src_ring [in]: source ring address, ring_size slots of chunk_size bytes
+ * @dst_mmap [in]: memory map of the destination ring
+ * @dst_ring [in]: destination ring address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_stream_attach_dma(struct dma_stream *stream,
+				   struct program_core_objects *state,
+				   struct doca_dma *dma_ctx,
+				   size_t *nb_inflight,
+				   struct doca_mmap *src_mmap,
+				   char *src_ring,
+				   struct doca_mmap *dst_mmap,
+				   char *dst_ring);
+
+/*
+ * Copy the slots with memcpy, emulating a DMA engine without a device
+ *
+ * @stream [in]: stream
+ * @src_ring [in]: source ring address, ring_size slots of chunk_size bytes
+ * @dst_ring [in]: destination ring address
+ */
+void dma_stream_attach_mock(struct dma_stream *stream, char *src_ring, char *dst_ring);
+
+/*
+ * Run the stream until all chunks are drained
+ *
+ * @stream [in]: stream
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_stream_run(struct dma_stream *stream);
+
+/*
+ * Log the throughput and stage times of a stream
+ *
+ * @stream [in]: stream
+ */
+void dma_stream_log_stats(struct dma_stream *stream);
+
+/*
+ * Destroy a stream, waiting for DMA tasks still in flight
+ *
+ * @stream [in]: stream to destroy
+ */
+void dma_stream_destroy(struct dma_stream *stream);
+
+#endif /* DMA_COPY_STREAM_H_ */
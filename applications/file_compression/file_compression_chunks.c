@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <zlib.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "file_compression_chunks.h"
+#include "file_compression_core.h"
+
+#define ENGINE_SLEEP_IN_NANOS (1 * 1000) /* Sleep between PE polls that found no completion */
+
+DOCA_LOG_REGISTER(FILE_COMPRESSION::Chunks);
+
+struct chunk_engine {
+	struct compress_resources *resources; /* DOCA compress resources, NULL for a SW engine */
+	uint32_t window;		      /* Number of slots */
+	uint32_t max_compressed_len;	      /* Size of the compressed side buffer of a slot */
+	uint8_t *src_region;		      /* Source buffers of all slots */
+	uint8_t *dst_region;		      /* Destination buffers of all slots */
+	size_t src_region_len;		      /* Length of src_region */
+	size_t dst_region_len;		      /* Length of dst_region */
+	struct chunk_slot *slots;	      /* Window slots */
+	uint32_t first_busy;		      /* First slot of the submitted batch */
+	uint32_t nb_busy;		      /* Number of slots in the submitted batch, 0 if none */
+	/* SW engine thread pool */
+	pthread_t *threads;	  /* Worker threads */
+	uint32_t nb_threads;	  /* Number of started worker threads */
+	pthread_mutex_t lock;	  /* Protects the job counters below */
+	pthread_cond_t work_cond; /* Signaled when jobs are posted or on stop */
+	pthread_cond_t done_cond; /* Signaled when the last posted job is done */
+	uint32_t nb_jobs;	  /* Number of posted jobs */
+	uint32_t next_job;	  /* Next job to pick */
+	uint32_t nb_done_jobs;	  /* Number of completed jobs */
+	bool stop;		  /* Set to stop the worker threads */
+};
+
+/*
+ * Deflate a single slot with zlib
+ *
+ * @strm [in]: initialized raw deflate stream, owned by the calling thread
+ * @slot [in/out]: slot to compress
+ * @max_compressed_len [in]: size of the slot destination buffer
+ */
+static void sw_compress_slot(z_stream *strm, struct chunk_slot *slot, uint32_t max_compressed_len)
+{
+	int err;
+
+	calculate_checksum_sw((char *)slot->src, slot->src_len, &slot->checksum);
+
+	err = deflateReset(strm);
+	if (err != Z_OK) {
+		slot->status = DOCA_ERROR_BAD_STATE;
+		return;
+	}
+	strm->next_in = slot->src;
+	strm->avail_in = slot->src_len;
+	strm->next_out = slot->dst;
+	strm->avail_out = max_compressed_len;
+	err = deflate(strm, Z_FINISH);
+	if (err != Z_STREAM_END) {
+		DOCA_LOG_ERR("Failed to compress chunk, zlib error %d", err);
+		slot->status = DOCA_ERROR_BAD_STATE;
+		return;
+	}
+	slot->dst_len = strm->total_out;
+	slot->status = DOCA_SUCCESS;
+}
+
+/*
+ * SW engine worker thread - picks slots posted by chunk_engine_submit() and deflates them
+ *
+ * @arg [in]: the chunk engine
+ * @return: NULL
+ */
+static void *sw_worker(void *arg)
+{
+	struct chunk_engine *engine = (struct chunk_engine *)arg;
+	z_stream strm;
+	struct chunk_slot *slot;
+	int err;
+
+	memset(&strm, 0, sizeof(strm));
+	err = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+
+	pthread_mutex_lock(&engine->lock);
+	while (true) {
+		while (!engine->stop && engine->next_job == engine->nb_jobs)
+			pthread_cond_wait(&engine->work_cond, &engine->lock);
+		if (engine->stop)
+			break;
+		slot = &engine->slots[engine->first_busy + engine->next_job++];
+		pthread_mutex_unlock(&engine->lock);
+
+		if (err != Z_OK)
+			slot->status = DOCA_ERROR_BAD_STATE;
+		else
+			sw_compress_slot(&strm, slot, engine->max_compressed_len);
+
+		pthread_mutex_lock(&engine->lock);
+		if (++engine->nb_done_jobs == engine->nb_jobs)
+			pthread_cond_signal(&engine->done_cond);
+	}
+	pthread_mutex_unlock(&engine->lock);
+
+	if (err == Z_OK)
+		deflateEnd(&strm);
+	return NULL;
+}
+
+/*
+ * Stop and join the SW engine worker threads
+ *
+ * @engine [in]: chunk engine
+ */
+static void sw_engine_stop(struct chunk_engine *engine)
+{
+	uint32_t i;
+
+	pthread_mutex_lock(&engine->lock);
+	engine->stop = true;
+	pthread_cond_broadcast(&engine->work_cond);
+	pthread_mutex_unlock(&engine->lock);
+
+	for (i = 0; i < engine->nb_threads; i++)
+		pthread_join(engine->threads[i], NULL);
+	engine->nb_threads = 0;
+}
+
+/*
+ * Start the SW engine worker threads
+ *
+ * @engine [in]: chunk engine
+ * @nb_threads [in]: number of threads to start
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t sw_engine_start(struct chunk_engine *engine, uint32_t nb_threads)
+{
+	engine->threads = calloc(nb_threads, sizeof(*engine->threads));
+	if (engine->threads == NULL) {
+		DOCA_LOG_ERR("Failed to allocate worker threads");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (engine->nb_threads = 0; engine->nb_threads < nb_threads; engine->nb_threads++) {
+		if (pthread_create(&engine->threads[engine->nb_threads], NULL, sw_worker, engine) != 0) {
+			DOCA_LOG_ERR("Failed to start compress worker thread");
+			sw_engine_stop(engine);
+			return DOCA_ERROR_BAD_STATE;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Post the submitted batch of slots to the SW engine worker threads
+ *
+ * @engine [in]: chunk engine
+ */
+static void sw_engine_submit(struct chunk_engine *engine)
+{
+	pthread_mutex_lock(&engine->lock);
+	engine->nb_done_jobs = 0;
+	engine->next_job = 0;
+	engine->nb_jobs = engine->nb_busy;
+	pthread_cond_broadcast(&engine->work_cond);
+	pthread_mutex_unlock(&engine->lock);
+}
+
+/*
+ * Wait for the SW engine worker threads to complete the submitted batch
+ *
+ * @engine [in]: chunk engine
+ */
+static void sw_engine_wait(struct chunk_engine *engine)
+{
+	pthread_mutex_lock(&engine->lock);
+	while (engine->nb_done_jobs != engine->nb_jobs)
+		pthread_cond_wait(&engine->done_cond, &engine->lock);
+	engine->nb_jobs = 0;
+	engine->next_job = 0;
+	pthread_mutex_unlock(&engine->lock);
+}
+
+/*
+ * Complete a HW task of a slot
+ *
+ * @task [in]: the completed task
+ * @slot [in]: the task slot
+ * @resources [in]: DOCA compress resources
+ * @crc_cs [in]: CRC checksum reported by the task
+ * @adler_cs [in]: Adler checksum reported by the task
+ */
+static void hw_complete_slot(struct doca_task *task,
+			     struct chunk_slot *slot,
+			     struct compress_resources *resources,
+			     uint32_t crc_cs,
+			     uint32_t adler_cs)
+{
+	size_t dst_len = 0;
+
+	slot->status = doca_task_get_status(task);
+	if (slot->status == DOCA_SUCCESS) {
+		doca_buf_get_data_len(slot->dst_buf, &dst_len);
+		slot->dst_len = dst_len;
+		slot->checksum = ((uint64_t)adler_cs << 32) | crc_cs;
+	}
+	doca_task_free(task);
+	--resources->num_remaining_tasks;
+}
+
+/*
+ * Compress task completion callback, for both success and error
+ *
+ * @compress_task [in]: the completed task
+ * @task_user_data [in]: the task slot
+ * @ctx_user_data [in]: DOCA compress resources
+ */
+static void hw_compress_done_callback(struct doca_compress_task_compress_deflate *compress_task,
+				      union doca_data task_user_data,
+				      union doca_data ctx_user_data)
+{
+	hw_complete_slot(doca_compress_task_compress_deflate_as_task(compress_task),
+			 (struct chunk_slot *)task_user_data.ptr,
+			 (struct compress_resources *)ctx_user_data.ptr,
+			 doca_compress_task_compress_deflate_get_crc_cs(compress_task),
+			 doca_compress_task_compress_deflate_get_adler_cs(compress_task));
+}
+
+/*
+ * Decompress task completion callback, for both success and error
+ *
+ * @decompress_task [in]: the completed task
+ * @task_user_data [in]: the task slot
+ * @ctx_user_data [in]: DOCA compress resources
+ */
+static void hw_decompress_done_callback(struct doca_compress_task_decompress_deflate *decompress_task,
+					union doca_data task_user_data,
+					union doca_data ctx_user_data)
+{
+	hw_complete_slot(doca_compress_task_decompress_deflate_as_task(decompress_task),
+			 (struct chunk_slot *)task_user_data.ptr,
+			 (struct compress_resources *)ctx_user_data.ptr,
+			 doca_compress_task_decompress_deflate_get_crc_cs(decompress_task),
+			 doca_compress_task_decompress_deflate_get_adler_cs(decompress_task));
+}
+
+/*
+ * Submit a HW task for a slot
+ *
+ * @engine [in]: chunk engine
+ * @slot [in]: slot to process
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hw_submit_slot(struct chunk_engine *engine, struct chunk_slot *slot)
+{
+	struct compress_resources *resources = engine->resources;
+	struct doca_compress_task_compress_deflate *compress_task;
+	struct doca_compress_task_decompress_deflate *decompress_task;
+	union doca_data task_user_data = {.ptr = slot};
+	struct doca_task *task;
+	doca_error_t result;
+
+	result = doca_buf_set_data(slot->src_buf, slot->src, slot->src_len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	doca_buf_reset_data_len(slot->dst_buf);
+
+	if (resources->mode == COMPRESS_MODE_COMPRESS_DEFLATE) {
+		result = doca_compress_task_compress_deflate_alloc_init(resources->compress,
+									slot->src_buf,
+									slot->dst_buf,
+									task_user_data,
+									&compress_task);
+		if (result != DOCA_SUCCESS)
+			return result;
+		task = doca_compress_task_compress_deflate_as_task(compress_task);
+	} else {
+		result = doca_compress_task_decompress_deflate_alloc_init(resources->compress,
+									  slot->src_buf,
+									  slot->dst_buf,
+									  task_user_data,
+									  &decompress_task);
+		if (result != DOCA_SUCCESS)
+			return result;
+		task = doca_compress_task_decompress_deflate_as_task(decompress_task);
+	}
+
+	result = doca_task_submit(task);
+	if (result != DOCA_SUCCESS) {
+		doca_task_free(task);
+		return result;
+	}
+	resources->num_remaining_tasks++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Submit a HW task for every slot of the submitted batch
+ *
+ * @engine [in]: chunk engine
+ */
+static void hw_engine_submit(struct chunk_engine *engine)
+{
+	struct chunk_slot *slot;
+	uint32_t i;
+
+	for (i = engine->first_busy; i < engine->first_busy + engine->nb_busy; i++) {
+		slot = &engine->slots[i];
+		slot->status = hw_submit_slot(engine, slot);
+		if (slot->status != DOCA_SUCCESS)
+			DOCA_LOG_ERR("Failed to submit chunk task: %s", doca_error_get_descr(slot->status));
+	}
+}
+
+/*
+ * Progress the PE until all the HW tasks of the submitted batch complete
+ *
+ * @engine [in]: chunk engine
+ */
+static void hw_engine_wait(struct chunk_engine *engine)
+{
+	struct compress_resources *resources = engine->resources;
+	struct timespec ts = {
+		.tv_nsec = ENGINE_SLEEP_IN_NANOS,
+	};
+
+	while (resources->num_remaining_tasks > 0) {
+		if (doca_pe_progress(resources->state->pe) == 0)
+			nanosleep(&ts, &ts);
+	}
+}
+
+/*
+ * Prepare the HW engine - register the slot buffers with the device, configure the task pool to the window size
+ * and start the DOCA compress context
+ *
+ * @engine [in]: chunk engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hw_engine_start(struct chunk_engine *engine)
+{
+	struct compress_resources *resources = engine->resources;
+	struct program_core_objects *state = resources->state;
+	struct chunk_slot *slot;
+	uint32_t i;
+	doca_error_t result;
+
+	if (resources->mode == COMPRESS_MODE_COMPRESS_DEFLATE)
+		result = doca_compress_task_compress_deflate_set_conf(resources->compress,
+								      hw_compress_done_callback,
+								      hw_compress_done_callback,
+								      engine->window);
+	else
+		result = doca_compress_task_decompress_deflate_set_conf(resources->compress,
+									hw_decompress_done_callback,
+									hw_decompress_done_callback,
+									engine->window);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set configurations for compress task: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_set_memrange(state->src_mmap, engine->src_region, engine->src_region_len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->src_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start source memory map: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_mmap_set_memrange(state->dst_mmap, engine->dst_region, engine->dst_region_len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start destination memory map: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < engine->window; i++) {
+		slot = &engine->slots[i];
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    state->src_mmap,
+							    slot->src,
+							    engine->src_region_len / engine->window,
+							    &slot->src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing source buffer: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    state->dst_mmap,
+							    slot->dst,
+							    engine->dst_region_len / engine->window,
+							    &slot->dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing destination buffer: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+	return result;
+}
+
+doca_error_t chunk_engine_create(struct compress_resources *resources,
+				 uint32_t chunk_size,
+				 uint32_t window,
+				 uint32_t nb_threads,
+				 struct chunk_engine **engine)
+{
+	struct chunk_engine *new_engine;
+	size_t src_slot_len, dst_slot_len;
+	bool compress = (resources == NULL || resources->mode == COMPRESS_MODE_COMPRESS_DEFLATE);
+	uint32_t i;
+	doca_error_t result;
+
+	if (chunk_size == 0 || window == 0 || (resources == NULL && nb_threads == 0)) {
+		DOCA_LOG_ERR("Invalid chunk engine configuration");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_engine = calloc(1, sizeof(*new_engine));
+	if (new_engine == NULL) {
+		DOCA_LOG_ERR("Failed to allocate chunk engine");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_engine->resources = resources;
+	new_engine->window = window;
+	new_engine->max_compressed_len = compressBound(chunk_size);
+	pthread_mutex_init(&new_engine->lock, NULL);
+	pthread_cond_init(&new_engine->work_cond, NULL);
+	pthread_cond_init(&new_engine->done_cond, NULL);
+
+	src_slot_len = compress ? chunk_size : new_engine->max_compressed_len;
+	dst_slot_len = compress ? new_engine->max_compressed_len : chunk_size;
+	new_engine->src_region_len = src_slot_len * window;
+	new_engine->dst_region_len = dst_slot_len * window;
+	new_engine->src_region = calloc(1, new_engine->src_region_len);
+	new_engine->dst_region = calloc(1, new_engine->dst_region_len);
+	new_engine->slots = calloc(window, sizeof(*new_engine->slots));
+	if (new_engine->src_region == NULL || new_engine->dst_region == NULL || new_engine->slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate chunk engine window of %u chunks", window);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_engine;
+	}
+	for (i = 0; i < window; i++) {
+		new_engine->slots[i].src = new_engine->src_region + i * src_slot_len;
+		new_engine->slots[i].dst = new_engine->dst_region + i * dst_slot_len;
+	}
+
+	if (resources == NULL)
+		result = sw_engine_start(new_engine, nb_threads);
+	else
+		result = hw_engine_start(new_engine);
+	if (result != DOCA_SUCCESS)
+		goto destroy_engine;
+
+	*engine = new_engine;
+	return DOCA_SUCCESS;
+
+destroy_engine:
+	chunk_engine_destroy(new_engine);
+	return result;
+}
+
+struct chunk_slot *chunk_engine_get_slot(struct chunk_engine *engine, uint32_t idx)
+{
+	return &engine->slots[idx];
+}
+
+uint32_t chunk_engine_get_max_compressed_len(struct chunk_engine *engine)
+{
+	return engine->max_compressed_len;
+}
+
+doca_error_t chunk_engine_submit(struct chunk_engine *engine, uint32_t first_slot, uint32_t nb_slots)
+{
+	uint32_t i;
+
+	if (engine->nb_busy != 0 || nb_slots == 0 || first_slot + nb_slots > engine->window)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	for (i = first_slot; i < first_slot + nb_slots; i++) {
+		engine->slots[i].dst_len = 0;
+		engine->slots[i].status = DOCA_ERROR_IN_PROGRESS;
+	}
+	engine->first_busy = first_slot;
+	engine->nb_busy = nb_slots;
+
+	if (engine->resources == NULL)
+		sw_engine_submit(engine);
+	else
+		hw_engine_submit(engine);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t chunk_engine_wait(struct chunk_engine *engine)
+{
+	uint32_t i;
+
+	if (engine->nb_busy == 0)
+		return DOCA_SUCCESS;
+
+	if (engine->resources == NULL)
+		sw_engine_wait(engine);
+	else
+		hw_engine_wait(engine);
+
+	for (i = engine->first_busy; i < engine->first_busy + engine->nb_busy; i++) {
+		if (engine->slots[i].status != DOCA_SUCCESS) {
+			engine->nb_busy = 0;
+			return engine->slots[i].status;
+		}
+	}
+	engine->nb_busy = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t chunk_engine_run(struct chunk_engine *engine, uint32_t nb_slots)
+{
+	doca_error_t result;
+
+	result = chunk_engine_submit(engine, 0, nb_slots);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return chunk_engine_wait(engine);
+}
+
+void chunk_engine_destroy(struct chunk_engine *engine)
+{
+	uint32_t i;
+
+	/* A batch still in flight uses the window buffers */
+	(void)chunk_engine_wait(engine);
+
+	if (engine->resources == NULL) {
+		sw_engine_stop(engine);
+	} else {
+		for (i = 0; engine->slots != NULL && i < engine->window; i++) {
+			if (engine->slots[i].src_buf != NULL)
+				doca_buf_dec_refcount(engine->slots[i].src_buf, NULL);
+			if (engine->slots[i].dst_buf != NULL)
+				doca_buf_dec_refcount(engine->slots[i].dst_buf, NULL);
+		}
+		/* The window memory is freed below, so it must not stay registered with the device */
+		(void)doca_mmap_stop(engine->resources->state->src_mmap);
+		(void)doca_mmap_stop(engine->resources->state->dst_mmap);
+	}
+
+	pthread_cond_destroy(&engine->done_cond);
+	pthread_cond_destroy(&engine->work_cond);
+	pthread_mutex_destroy(&engine->lock);
+	free(engine->threads);
+	free(engine->slots);
+	free(engine->dst_region);
+	free(engine->src_region);
+	free(engine);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef FILE_COMPRESSION_CHUNKS_H_
+#define FILE_COMPRESSION_CHUNKS_H_
+
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#include <samples/doca_compress/compress_common.h>
+
+/*
+ * Chunked container format:
+ *	file info message (chunk_size != 0, nb_chunks, file_size)
+ *	[chunk header | chunk_header.compressed_len bytes of raw deflate data] * nb_chunks
+ * Every chunk is an independent deflate stream of up to chunk_size bytes of the original file, so chunks can be
+ * compressed and decompressed in parallel. The chunks are carried as a byte stream across comch messages.
+ */
+struct chunk_header {
+	uint32_t index;		 /* Index of the chunk in the file */
+	uint32_t original_len;	 /* Length of the chunk before compression */
+	uint32_t compressed_len; /* Length of the deflate data following the header */
+	uint32_t reserved;	 /* Reserved, must be zero */
+	uint64_t checksum;	 /* Checksum of the original chunk data - adler32 << 32 | crc32 */
+} __attribute__((packed));
+
+/* Chunk compress engine - compresses or decompresses a window of chunks concurrently */
+struct chunk_engine;
+
+/* A chunk slot in the engine window */
+struct chunk_slot {
+	uint8_t *src;		  /* Source buffer of the slot */
+	uint8_t *dst;		  /* Destination buffer of the slot */
+	uint32_t src_len;	  /* Length of the data in src, set by the caller */
+	uint32_t dst_len;	  /* Length of the data in dst, set by the engine */
+	uint64_t checksum;	  /* Checksum of the original (uncompressed) data, set by the engine */
+	doca_error_t status;	  /* Status of the last operation on the slot */
+	struct doca_buf *src_buf; /* DOCA buffer over src, HW engine only */
+	struct doca_buf *dst_buf; /* DOCA buffer over dst, HW engine only */
+};
+
+/*
+ * Create a chunk engine.
+ * A SW engine deflates chunks on a pool of threads. A HW engine keeps up to window DOCA compress tasks in flight,
+ * and takes ownership of the (not yet started) DOCA compress context of resources.
+ *
+ * @resources [in]: DOCA compress resources, NULL for a SW engine
+ * @chunk_size [in]: maximal length of an uncompressed chunk
+ * @window [in]: number of chunks processed concurrently
+ * @nb_threads [in]: number of SW threads, ignored by a HW engine
+ * @engine [out]: the created engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t chunk_engine_create(struct compress_resources *resources,
+				 uint32_t chunk_size,
+				 uint32_t window,
+				 uint32_t nb_threads,
+				 struct chunk_engine **engine);
+
+/*
+ * Get a slot of the engine window
+ *
+ * @engine [in]: chunk engine
+ * @idx [in]: slot index, smaller than the engine window
+ * @return: the slot
+ */
+struct chunk_slot *chunk_engine_get_slot(struct chunk_engine *engine, uint32_t idx);
+
+/*
+ * Get the maximal length of the compressed data of a chunk - the size of the compressed side buffer of a slot
+ *
+ * @engine [in]: chunk engine
+ * @return: maximal compressed chunk length
+ */
+uint32_t chunk_engine_get_max_compressed_len(struct chunk_engine *engine);
+
+/*
+ * Start processing a batch of consecutive slots of the window concurrently, without waiting for completion.
+ * Only a single batch may be in flight, so the caller can fill or drain other slots of the window while the batch
+ * is processed.
+ *
+ * @engine [in]: chunk engine
+ * @first_slot [in]: first slot of the batch
+ * @nb_slots [in]: number of slots in the batch
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t chunk_engine_submit(struct chunk_engine *engine, uint32_t first_slot, uint32_t nb_slots);
+
+/*
+ * Wait for the batch submitted with chunk_engine_submit() to complete. The per slot result is reported in the slot
+ * status.
+ *
+ * @engine [in]: chunk engine
+ * @return: DOCA_SUCCESS if all slots of the batch were processed successfully and DOCA_ERROR otherwise
+ */
+doca_error_t chunk_engine_wait(struct chunk_engine *engine);
+
+/*
+ * Process the first nb_slots slots of the window concurrently, and wait for all of them to complete.
+ * The per slot result is reported in the slot status.
+ *
+ * @engine [in]: chunk engine
+ * @nb_slots [in]: number of slots to process
+ * @return: DOCA_SUCCESS if all slots were processed successfully and DOCA_ERROR otherwise
+ */
+doca_error_t chunk_engine_run(struct chunk_engine *engine, uint32_t nb_slots);
+
+/*
+ * Destroy a chunk engine
+ *
+ * @engine [in]: chunk engine to destroy
+ */
+void chunk_engine_destroy(struct chunk_engine *engine);
+
+#endif /* FILE_COMPRESSION_CHUNKS_H_ */
@@ -28,7 +28,6 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
-#include <time.h>
 #include <unistd.h>
 #include <zlib.h>
 
@@ -42,15 +41,22 @@
 
 #define MAX_MSG 512			   /* Maximum number of messages in CC queue */
 #define SW_MAX_FILE_SIZE 128 * 1024 * 1024 /* 128 MB */
-#define SLEEP_IN_NANOS (10 * 1000)	   /* Sample the task every 10 microseconds */
 #define DECOMPRESS_RATIO 1032		   /* Maximal decompress ratio size */
 #define DEFAULT_TIMEOUT 10		   /* default timeout for receiving messages */
+#define DEFAULT_CHUNK_WINDOW 8		   /* default number of chunks processed concurrently */
+#define MAX_CHUNK_SIZE_KB (1024 * 1024)	   /* 1 GB */
+#define MAX_CHUNK_WINDOW 256		   /* maximal number of chunks processed concurrently */
+#define DEFAULT_SEND_WINDOW 64		   /* default number of data messages in flight */
 
 DOCA_LOG_REGISTER(FILE_COMPRESSION::Core);
 
 struct file_info_message {
-	uint64_t checksum; /* Checksum of file to be transferred */
-	uint32_t num_segs; /* Number of comch segments to transfer file across */
+	uint64_t checksum;   /* Checksum of file to be transferred, unused in chunked mode */
+	uint64_t file_size;  /* Length of the original file */
+	uint32_t num_segs;   /* Number of comch segments to transfer file across, unused in chunked mode */
+	uint32_t chunk_size; /* Chunk size in chunked mode, 0 if the file is sent as a single deflate stream */
+	uint32_t nb_chunks;  /* Number of chunks in chunked mode */
+	uint32_t window;     /* Number of data messages the client sends before waiting for credits */
 };
 
 /*
@@ -79,18 +85,20 @@ static doca_error_t get_compress_max_buf_size(struct compress_resources *resourc
 }
 
 /*
- * Allocate DOCA compress needed resources with 2 buffers
+ * Allocate DOCA compress needed resources with 2 buffers, or 2 buffers per chunk slot of the chunked mode engine.
+ * The client engine holds two windows of chunks - one is compressed while the other is read or sent.
  *
- * @mode [in]: Running mode
+ * @compress_cfg [in]: application config struct
  * @resources [out]: DOCA compress resources pointer
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t get_compress_resources(enum file_compression_mode mode, struct compress_resources *resources)
+static doca_error_t get_compress_resources(struct file_compression_config *compress_cfg,
+					   struct compress_resources *resources)
 {
-	uint32_t max_bufs = 2;
+	uint32_t max_bufs = (compress_cfg->mode == CLIENT ? 4 : 2) * compress_cfg->chunk_window;
 	doca_error_t result;
 
-	if (mode == CLIENT)
+	if (compress_cfg->mode == CLIENT)
 		resources->mode = COMPRESS_MODE_COMPRESS_DEFLATE;
 	else
 		resources->mode = COMPRESS_MODE_DECOMPRESS_DEFLATE;
@@ -122,7 +130,7 @@ static doca_error_t init_compress_resources(struct file_compression_config *comp
 	*method = COMPRESS_DEFLATE_HW;
 
 	/* Allocate compress resources */
-	result = get_compress_resources(compress_cfg->mode, resources);
+	result = get_compress_resources(compress_cfg, resources);
 	if (result != DOCA_SUCCESS) {
 		if (resources->mode == COMPRESS_MODE_COMPRESS_DEFLATE) {
 			DOCA_LOG_INFO("Failed to find device for compress task, running SW compress with zlib");
@@ -355,15 +363,7 @@ static doca_error_t compress_file_sw(char *file_data,
 	return DOCA_SUCCESS;
 }
 
-/*
- * Calculate file checksum with zlib, where the lower 32 bits contain the CRC checksum result
- * and the upper 32 bits contain the Adler checksum result.
- *
- * @file_data [in]: file data to the source buffer
- * @file_size [in]: file size
- * @output_chksum [out]: the calculated checksum
- */
-static void calculate_checksum_sw(char *file_data, size_t file_size, uint64_t *output_chksum)
+void calculate_checksum_sw(char *file_data, size_t file_size, uint64_t *output_chksum)
 {
 	uint32_t crc;
 	uint32_t adler;
@@ -433,65 +433,68 @@ static doca_error_t compress_file(char *file_data,
 					output_chksum);
 }
 
+/*
+ * Send a message on comch
+ *
+ * @transport [in]: comch configuration object
+ * @msg [in]: message to send
+ * @len [in]: message length
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_AGAIN if the send queue is full and DOCA_ERROR otherwise
+ */
+static doca_error_t comch_transport_send(void *transport, const void *msg, uint32_t len)
+{
+	return comch_utils_send(comch_util_get_connection((struct comch_cfg *)transport), msg, len);
+}
+
+/*
+ * Progress the comch connection, completing sent messages and delivering received ones
+ *
+ * @transport [in]: comch configuration object
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t comch_transport_progress(void *transport)
+{
+	return comch_utils_progress_connection(comch_util_get_connection((struct comch_cfg *)transport));
+}
+
 /*
  * Send the input file with comch to the server in segments of max_comch_msg length
  *
  * @compress_cfg [in]: compression configuration information
- * @comch_cfg [in]: comch configuration object for sending file across
  * @file_data [in]: file data to the source buffer
  * @file_size [in]: file size
  * @checksum [in]: checksum of the file
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 static doca_error_t send_file(struct file_compression_config *compress_cfg,
-			      struct comch_cfg *comch_cfg,
 			      char *file_data,
 			      size_t file_size,
 			      uint64_t checksum)
 {
+	struct transfer_sender *sender = &compress_cfg->sender;
 	struct file_info_message file_meta = {};
-	uint32_t max_comch_msg;
+	uint32_t max_comch_msg = sender->max_len;
 	uint32_t total_msgs;
 	size_t msg_len;
 	uint32_t i;
 	doca_error_t result;
-	struct timespec ts = {
-		.tv_nsec = SLEEP_IN_NANOS,
-	};
-
-	max_comch_msg = comch_utils_get_max_buffer_size(comch_cfg);
-	if (max_comch_msg == 0) {
-		DOCA_LOG_ERR("Comch max buffer size is zero");
-		return DOCA_ERROR_INVALID_VALUE;
-	}
 
 	/* Send to the server the number of messages needed for receiving the file and its checksum */
 	total_msgs = (file_size + max_comch_msg - 1) / max_comch_msg;
 	file_meta.num_segs = htonl(total_msgs);
 	file_meta.checksum = htonq(checksum);
+	file_meta.window = htonl(compress_cfg->send_window);
 
-	result = comch_utils_send(comch_util_get_connection(comch_cfg), &file_meta, sizeof(struct file_info_message));
+	result = transfer_sender_send(sender, &file_meta, sizeof(struct file_info_message));
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to send file info message: %s", doca_error_get_descr(result));
 		return result;
 	}
 
-	/* Send file to the server */
+	/* Send file to the server, up to a window of segments is in flight */
 	for (i = 0; i < total_msgs; i++) {
-		/* Stop sending if the server is done receiving */
-		if (compress_cfg->state == TRANSFER_COMPLETE)
-			return DOCA_ERROR_IO_FAILED;
-
 		msg_len = MIN(file_size, max_comch_msg);
-		result = comch_utils_send(comch_util_get_connection(comch_cfg), file_data, msg_len);
-		while (result == DOCA_ERROR_AGAIN) {
-			nanosleep(&ts, &ts);
-			result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
-			if (result != DOCA_SUCCESS)
-				break;
-			result = comch_utils_send(comch_util_get_connection(comch_cfg), file_data, msg_len);
-		}
-
+		result = transfer_sender_send(sender, file_data, msg_len);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("File data was not sent: %s", doca_error_get_descr(result));
 			return result;
@@ -502,19 +505,295 @@ static doca_error_t send_file(struct file_compression_config *compress_cfg,
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Read a chunk of the input file
+ *
+ * @fd [in]: input file
+ * @buf [out]: buffer to read to
+ * @len [in]: number of bytes to read
+ * @offset [in]: file offset to read from
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t read_chunk(int fd, uint8_t *buf, size_t len, uint64_t offset)
+{
+	ssize_t nb_read;
+
+	while (len > 0) {
+		nb_read = pread(fd, buf, len, offset);
+		if (nb_read < 0 && errno == EINTR)
+			continue;
+		if (nb_read <= 0) {
+			DOCA_LOG_ERR("Failed to read file at offset %" PRIu64 ": %s",
+				     offset,
+				     nb_read < 0 ? strerror(errno) : "unexpected end of file");
+			return DOCA_ERROR_IO_FAILED;
+		}
+		buf += nb_read;
+		len -= nb_read;
+		offset += nb_read;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Write a decompressed chunk to the output file
+ *
+ * @fd [in]: output file
+ * @buf [in]: buffer to write
+ * @len [in]: number of bytes to write
+ * @offset [in]: file offset to write at
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t write_chunk(int fd, const uint8_t *buf, size_t len, uint64_t offset)
+{
+	ssize_t nb_written;
+
+	while (len > 0) {
+		nb_written = pwrite(fd, buf, len, offset);
+		if (nb_written < 0 && errno == EINTR)
+			continue;
+		if (nb_written < 0) {
+			DOCA_LOG_ERR("Failed to write file at offset %" PRIu64 ": %s", offset, strerror(errno));
+			return DOCA_ERROR_IO_FAILED;
+		}
+		buf += nb_written;
+		len -= nb_written;
+		offset += nb_written;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Read a window of chunks of the input file into consecutive engine slots
+ *
+ * @fd [in]: input file
+ * @file_size [in]: input file size
+ * @chunk_size [in]: chunk size
+ * @first_chunk [in]: index of the first chunk of the window
+ * @nb_chunks [in]: number of chunks in the window
+ * @engine [in]: chunk engine
+ * @first_slot [in]: engine slot of the first chunk
+ * @stats [in/out]: read stage counters
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t read_window(int fd,
+				uint64_t file_size,
+				uint64_t chunk_size,
+				uint64_t first_chunk,
+				uint32_t nb_chunks,
+				struct chunk_engine *engine,
+				uint32_t first_slot,
+				struct transfer_stage_stats *stats)
+{
+	struct chunk_slot *slot;
+	uint64_t offset, start_ns;
+	uint32_t i;
+	doca_error_t result;
+
+	for (i = 0; i < nb_chunks; i++) {
+		start_ns = transfer_get_time_ns();
+		slot = chunk_engine_get_slot(engine, first_slot + i);
+		offset = (first_chunk + i) * chunk_size;
+		slot->src_len = MIN(chunk_size, file_size - offset);
+		result = read_chunk(fd, slot->src, slot->src_len, offset);
+		if (result != DOCA_SUCCESS)
+			return result;
+		transfer_stage_account(stats, slot->src_len, start_ns);
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stream a window of compressed chunks to the server, each chunk preceded by its header
+ *
+ * @sender [in]: transfer sender
+ * @engine [in]: chunk engine
+ * @first_slot [in]: engine slot of the first chunk
+ * @first_chunk [in]: index of the first chunk of the window
+ * @nb_chunks [in]: number of chunks in the window
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_window(struct transfer_sender *sender,
+				struct chunk_engine *engine,
+				uint32_t first_slot,
+				uint64_t first_chunk,
+				uint32_t nb_chunks)
+{
+	struct chunk_header header = {};
+	struct chunk_slot *slot;
+	uint32_t i;
+	doca_error_t result;
+
+	for (i = 0; i < nb_chunks; i++) {
+		slot = chunk_engine_get_slot(engine, first_slot + i);
+		header.index = htonl(first_chunk + i);
+		header.original_len = htonl(slot->src_len);
+		header.compressed_len = htonl(slot->dst_len);
+		header.checksum = htonq(slot->checksum);
+		result = transfer_sender_write(sender, &header, sizeof(header));
+		if (result == DOCA_SUCCESS)
+			result = transfer_sender_write(sender, slot->dst, slot->dst_len);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Compress and send the input file in chunked mode. The engine holds two windows of chunks, and the stages of the
+ * pipeline overlap - the next window is read while the current one is compressed, and the current window is sent
+ * while the next one is compressed.
+ *
+ * @compress_cfg [in]: compression configuration information
+ * @resources [in]: DOCA compress resources
+ * @fd [in]: input file
+ * @file_size [in]: input file size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_file_chunked(struct file_compression_config *compress_cfg,
+				      struct compress_resources *resources,
+				      int fd,
+				      uint64_t file_size)
+{
+	struct transfer_sender *sender = &compress_cfg->sender;
+	struct transfer_stage_stats read_stats = {};
+	struct transfer_stage_stats compress_stats = {};
+	struct file_info_message file_meta = {};
+	struct chunk_engine *engine;
+	uint64_t chunk_size = compress_cfg->chunk_size;
+	uint64_t nb_chunks = (file_size + chunk_size - 1) / chunk_size;
+	uint32_t window = compress_cfg->chunk_window;
+	uint64_t first_chunk, next_chunk, compress_start_ns;
+	uint32_t nb_window_chunks, nb_next_chunks, bank = 0;
+	doca_error_t result;
+
+	if (nb_chunks > UINT32_MAX) {
+		DOCA_LOG_ERR("File of %" PRIu64 " bytes has too many chunks of %" PRIu64 " bytes",
+			     file_size,
+			     chunk_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (compress_cfg->compress_method == COMPRESS_DEFLATE_HW &&
+	    compressBound(chunk_size) > compress_cfg->max_compress_file_len) {
+		DOCA_LOG_ERR("Chunk size %" PRIu64 " is too large for DOCA compress maximum buffer size of %" PRIu64,
+			     chunk_size,
+			     compress_cfg->max_compress_file_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = chunk_engine_create(compress_cfg->compress_method == COMPRESS_DEFLATE_HW ? resources : NULL,
+				     chunk_size,
+				     2 * window,
+				     compress_cfg->nb_sw_threads,
+				     &engine);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create chunk engine: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Send to the server the chunk layout of the file */
+	file_meta.file_size = htonq(file_size);
+	file_meta.chunk_size = htonl(chunk_size);
+	file_meta.nb_chunks = htonl(nb_chunks);
+	file_meta.window = htonl(compress_cfg->send_window);
+	result = transfer_sender_send(sender, &file_meta, sizeof(file_meta));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to send file info message: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	nb_window_chunks = MIN(nb_chunks, window);
+	result = read_window(fd, file_size, chunk_size, 0, nb_window_chunks, engine, 0, &read_stats);
+	if (result != DOCA_SUCCESS)
+		goto destroy_engine;
+	compress_start_ns = transfer_get_time_ns();
+	result = chunk_engine_submit(engine, 0, nb_window_chunks);
+	if (result != DOCA_SUCCESS)
+		goto compress_failed;
+
+	for (first_chunk = 0; first_chunk < nb_chunks; first_chunk = next_chunk) {
+		next_chunk = first_chunk + nb_window_chunks;
+		nb_next_chunks = MIN(nb_chunks - next_chunk, window);
+
+		/* Read the next window while the current one is compressed */
+		if (nb_next_chunks > 0) {
+			result = read_window(fd,
+					     file_size,
+					     chunk_size,
+					     next_chunk,
+					     nb_next_chunks,
+					     engine,
+					     (bank ^ 1) * window,
+					     &read_stats);
+			if (result != DOCA_SUCCESS)
+				goto destroy_engine;
+		}
+
+		result = chunk_engine_wait(engine);
+		if (result != DOCA_SUCCESS)
+			goto compress_failed;
+		transfer_stage_account(&compress_stats,
+				       MIN(nb_window_chunks * chunk_size, file_size - first_chunk * chunk_size),
+				       compress_start_ns);
+
+		/* Compress the next window while the current one is sent */
+		if (nb_next_chunks > 0) {
+			compress_start_ns = transfer_get_time_ns();
+			result = chunk_engine_submit(engine, (bank ^ 1) * window, nb_next_chunks);
+			if (result != DOCA_SUCCESS)
+				goto compress_failed;
+		}
+
+		result = send_window(sender, engine, bank * window, first_chunk, nb_window_chunks);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("File data was not sent: %s", doca_error_get_descr(result));
+			goto destroy_engine;
+		}
+		bank ^= 1;
+		nb_window_chunks = nb_next_chunks;
+	}
+
+	result = transfer_sender_flush(sender);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("File data was not sent: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+	DOCA_LOG_INFO("Sent %" PRIu64 " bytes in %" PRIu64 " chunks, %" PRIu64 " bytes on the wire",
+		      file_size,
+		      nb_chunks,
+		      sender->stats.nb_bytes);
+	transfer_stage_log("Read", &read_stats);
+	transfer_stage_log("Compress", &compress_stats);
+	goto destroy_engine;
+
+compress_failed:
+	DOCA_LOG_ERR("Failed to compress chunks: %s", doca_error_get_descr(result));
+destroy_engine:
+	chunk_engine_destroy(engine);
+	return result;
+}
+
 void client_recv_event_cb(struct doca_comch_event_msg_recv *event,
 			  uint8_t *recv_buffer,
 			  uint32_t msg_len,
 			  struct doca_comch_connection *comch_connection)
 {
 	struct file_compression_config *cfg = comch_utils_get_user_data(comch_connection);
+	const char *status;
 
-	/* A message is only expected from the server when it has read the compressed file successfully */
 	(void)event;
 
+	/* The server returns credits during the transfer, and a finish message once it has read the file */
+	if (transfer_sender_recv_ctrl(&cfg->sender, recv_buffer, msg_len, &status) != DOCA_SUCCESS) {
+		cfg->sender.peer_done = true;
+		cfg->state = TRANSFER_ERROR;
+		return;
+	}
+	if (status == NULL)
+		return;
+
 	/* Print the completion message sent from the server */
-	recv_buffer[msg_len] = '\0';
-	DOCA_LOG_INFO("Received message: %s", recv_buffer);
+	DOCA_LOG_INFO("Received message: %s", status);
 	cfg->state = TRANSFER_COMPLETE;
 }
 
@@ -522,16 +801,19 @@ doca_error_t file_compression_client(struct comch_cfg *comch_cfg,
 				     struct file_compression_config *compress_cfg,
 				     struct compress_resources *resources)
 {
+	struct transfer_ops ops = {
+		.send = comch_transport_send,
+		.progress = comch_transport_progress,
+		.transport = comch_cfg,
+	};
+	struct transfer_stage_stats compress_stats = {};
 	char *file_data;
 	struct stat statbuf;
 	int fd;
 	uint8_t *compressed_file;
 	size_t compressed_file_len;
-	uint64_t checksum;
+	uint64_t checksum, start_ns;
 	doca_error_t result;
-	struct timespec ts = {
-		.tv_nsec = SLEEP_IN_NANOS,
-	};
 
 	fd = open(compress_cfg->file_path, O_RDWR);
 	if (fd < 0) {
@@ -545,22 +827,43 @@ doca_error_t file_compression_client(struct comch_cfg *comch_cfg,
 		return DOCA_ERROR_IO_FAILED;
 	}
 
+	result = transfer_sender_init(&compress_cfg->sender,
+				      &ops,
+				      compress_cfg->send_window,
+				      comch_utils_get_max_buffer_size(comch_cfg));
+	if (result != DOCA_SUCCESS) {
+		close(fd);
+		return result;
+	}
+
+	if (compress_cfg->chunk_size != 0 && statbuf.st_size != 0) {
+		/* Chunked mode streams the file, so its size is not limited by the compress buffer size */
+		result = send_file_chunked(compress_cfg, resources, fd, statbuf.st_size);
+		close(fd);
+		if (result != DOCA_SUCCESS)
+			goto destroy_sender;
+		goto wait_for_server;
+	}
+
 	if (statbuf.st_size == 0 || (uint64_t)statbuf.st_size > compress_cfg->max_compress_file_len) {
 		DOCA_LOG_ERR("Invalid file size. Should be greater then zero and smaller than %" PRIu64 " bytes",
 			     compress_cfg->max_compress_file_len);
 		close(fd);
-		return DOCA_ERROR_INVALID_VALUE;
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto destroy_sender;
 	}
 
 	file_data = mmap(NULL, statbuf.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
 	if (file_data == MAP_FAILED) {
 		DOCA_LOG_ERR("Unable to map file content: %s", strerror(errno));
 		close(fd);
-		return DOCA_ERROR_NO_MEMORY;
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_sender;
 	}
 
 	DOCA_LOG_TRC("File size: %ld", statbuf.st_size);
 	/* Send compress task */
+	start_ns = transfer_get_time_ns();
 	result = compress_file(file_data,
 			       statbuf.st_size,
 			       compress_cfg->max_compress_file_len,
@@ -572,55 +875,255 @@ doca_error_t file_compression_client(struct comch_cfg *comch_cfg,
 	if (result != DOCA_SUCCESS) {
 		close(fd);
 		free(compressed_file);
-		return result;
+		goto destroy_sender;
 	}
 	close(fd);
+	transfer_stage_account(&compress_stats, statbuf.st_size, start_ns);
 	DOCA_LOG_TRC("Compressed file size: %ld", compressed_file_len);
 
 	/* Send the file content to the server */
-	result = send_file(compress_cfg, comch_cfg, (char *)compressed_file, compressed_file_len, checksum);
-	if (result != DOCA_SUCCESS) {
-		free(compressed_file);
-		return result;
-	}
+	result = send_file(compress_cfg, (char *)compressed_file, compressed_file_len, checksum);
 	free(compressed_file);
+	if (result != DOCA_SUCCESS)
+		goto destroy_sender;
+	transfer_stage_log("Compress", &compress_stats);
+
+wait_for_server:
+	transfer_stage_log("Send", &compress_cfg->sender.stats);
+	DOCA_LOG_INFO("Sending waited for credits %" PRIu64 " times", compress_cfg->sender.nb_stalls);
 
 	/* Wait for a signal that the transfer has complete */
-	while (compress_cfg->state != TRANSFER_COMPLETE) {
-		nanosleep(&ts, &ts);
+	while (compress_cfg->state != TRANSFER_COMPLETE && compress_cfg->state != TRANSFER_ERROR) {
 		result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Comch connection unexpectedly dropped: %s", doca_error_get_descr(result));
-			return result;
+			goto destroy_sender;
 		}
 	}
+	if (compress_cfg->state == TRANSFER_ERROR) {
+		DOCA_LOG_ERR("Invalid message received from the server");
+		result = DOCA_ERROR_BAD_STATE;
+	}
 
+destroy_sender:
+	transfer_sender_destroy(&compress_cfg->sender);
 	return result;
 }
 
-void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
-			  uint8_t *recv_buffer,
-			  uint32_t msg_len,
-			  struct doca_comch_connection *comch_connection)
+/*
+ * Start receiving a file in chunked mode - create the decompress engine and the output file
+ *
+ * @cfg [in]: application config struct
+ * @file_info [in]: file info message received from the client
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunked_receive_start(struct file_compression_config *cfg, struct file_info_message *file_info)
 {
-	struct file_compression_config *cfg = comch_utils_get_user_data(comch_connection);
-	struct server_runtime_data *server_data;
+	struct server_runtime_data *server_data = &cfg->server_data;
+	uint64_t file_size = ntohq(file_info->file_size);
+	uint32_t chunk_size = ntohl(file_info->chunk_size);
+	uint32_t nb_chunks = ntohl(file_info->nb_chunks);
+	doca_error_t result;
 
-	(void)event;
+	if (compressBound(chunk_size) > cfg->max_compress_file_len) {
+		DOCA_LOG_ERR("Chunk size %u is too large for DOCA compress maximum buffer size of %" PRIu64,
+			     chunk_size,
+			     cfg->max_compress_file_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (nb_chunks == 0 || (file_size + chunk_size - 1) / chunk_size != nb_chunks) {
+		DOCA_LOG_ERR("Invalid chunk layout - file size %" PRIu64 ", chunk size %u, %u chunks",
+			     file_size,
+			     chunk_size,
+			     nb_chunks);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
 
-	if (cfg == NULL) {
-		DOCA_LOG_ERR("Cannot get configuration information");
-		return;
+	server_data->window_headers = calloc(cfg->chunk_window, sizeof(*server_data->window_headers));
+	if (server_data->window_headers == NULL) {
+		DOCA_LOG_ERR("Failed to allocate chunk headers");
+		return DOCA_ERROR_NO_MEMORY;
 	}
 
-	/* Ignore any events occurring after transfer is complete */
-	if (cfg->state == TRANSFER_COMPLETE || cfg->state == TRANSFER_ERROR)
-		return;
+	result = chunk_engine_create(server_data->resources,
+				     chunk_size,
+				     cfg->chunk_window,
+				     0,
+				     &server_data->chunk_engine);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create chunk engine: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	server_data->output_fd = open(cfg->file_path, O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IRGRP);
+	if (server_data->output_fd < 0) {
+		DOCA_LOG_ERR("Failed to open %s", cfg->file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	server_data->chunk_size = chunk_size;
+	server_data->file_size = file_size;
+	server_data->expected_file_chunks = nb_chunks;
+	DOCA_LOG_INFO("Receiving file of %" PRIu64 " bytes in %u chunks", file_size, nb_chunks);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Decompress the chunks of the window concurrently, verify them and write them to the output file
+ *
+ * @cfg [in]: application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunked_receive_flush(struct file_compression_config *cfg)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
+	struct chunk_header *header;
+	struct chunk_slot *slot;
+	uint64_t start_ns, nb_bytes = 0;
+	uint32_t i;
+	doca_error_t result;
+
+	start_ns = transfer_get_time_ns();
+	result = chunk_engine_run(server_data->chunk_engine, server_data->nb_window_chunks);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to decompress chunks: %s", doca_error_get_descr(result));
+		return result;
+	}
+	for (i = 0; i < server_data->nb_window_chunks; i++)
+		nb_bytes += chunk_engine_get_slot(server_data->chunk_engine, i)->dst_len;
+	transfer_stage_account(&server_data->decompress_stats, nb_bytes, start_ns);
+
+	for (i = 0; i < server_data->nb_window_chunks; i++) {
+		slot = chunk_engine_get_slot(server_data->chunk_engine, i);
+		header = &server_data->window_headers[i];
+		if (slot->dst_len != ntohl(header->original_len) || slot->checksum != ntohq(header->checksum)) {
+			DOCA_LOG_ERR("ERROR: chunk %u is corrupted. length %u checksum 0x%lx, expected %u 0x%lx",
+				     ntohl(header->index),
+				     slot->dst_len,
+				     slot->checksum,
+				     ntohl(header->original_len),
+				     ntohq(header->checksum));
+			return DOCA_ERROR_BAD_STATE;
+		}
+		start_ns = transfer_get_time_ns();
+		result = write_chunk(server_data->output_fd,
+				     slot->dst,
+				     slot->dst_len,
+				     (uint64_t)ntohl(header->index) * server_data->chunk_size);
+		if (result != DOCA_SUCCESS)
+			return result;
+		transfer_stage_account(&server_data->write_stats, slot->dst_len, start_ns);
+	}
+	server_data->nb_window_chunks = 0;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse a comch message of a chunked file - the chunks are a byte stream split across messages, complete chunks
+ * are collected in the engine window which is flushed when full and at the last chunk
+ *
+ * @cfg [in]: application config struct
+ * @data [in]: message data
+ * @len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunked_receive_data(struct file_compression_config *cfg, const uint8_t *data, uint32_t len)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
+	struct chunk_header *header = &server_data->header;
+	struct chunk_slot *slot;
+	uint32_t index, original_len, expected_len, copy_len, max_compressed_len;
+	doca_error_t result;
 
-	server_data = &cfg->server_data;
+	while (len > 0) {
+		if (server_data->received_file_chunks == server_data->expected_file_chunks) {
+			DOCA_LOG_ERR("Received %u bytes after the last chunk", len);
+			return DOCA_ERROR_BAD_STATE;
+		}
+		slot = chunk_engine_get_slot(server_data->chunk_engine, server_data->nb_window_chunks);
+
+		if (server_data->header_len < sizeof(*header)) {
+			copy_len = MIN(len, sizeof(*header) - server_data->header_len);
+			memcpy((uint8_t *)header + server_data->header_len, data, copy_len);
+			server_data->header_len += copy_len;
+			data += copy_len;
+			len -= copy_len;
+			if (server_data->header_len < sizeof(*header))
+				break;
+
+			index = ntohl(header->index);
+			original_len = ntohl(header->original_len);
+			expected_len = MIN(server_data->chunk_size,
+					   server_data->file_size - (uint64_t)index * server_data->chunk_size);
+			slot->src_len = ntohl(header->compressed_len);
+			max_compressed_len = chunk_engine_get_max_compressed_len(server_data->chunk_engine);
+			if (index != server_data->received_file_chunks || original_len != expected_len ||
+			    slot->src_len == 0 || slot->src_len > max_compressed_len) {
+				DOCA_LOG_ERR("Invalid header of chunk %u - length %u, compressed length %u",
+					     index,
+					     original_len,
+					     slot->src_len);
+				return DOCA_ERROR_BAD_STATE;
+			}
+			server_data->window_headers[server_data->nb_window_chunks] = *header;
+			server_data->data_len = 0;
+			continue;
+		}
+
+		copy_len = MIN(len, slot->src_len - server_data->data_len);
+		memcpy(slot->src + server_data->data_len, data, copy_len);
+		server_data->data_len += copy_len;
+		data += copy_len;
+		len -= copy_len;
+		if (server_data->data_len < slot->src_len)
+			break;
+
+		/* The chunk is complete */
+		server_data->header_len = 0;
+		server_data->nb_window_chunks++;
+		server_data->received_file_chunks++;
+		if (server_data->nb_window_chunks == cfg->chunk_window ||
+		    server_data->received_file_chunks == server_data->expected_file_chunks) {
+			result = chunked_receive_flush(cfg);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release the chunked mode receive resources
+ *
+ * @server_data [in]: server runtime data
+ */
+static void chunked_receive_cleanup(struct server_runtime_data *server_data)
+{
+	if (server_data->output_fd >= 0) {
+		close(server_data->output_fd);
+		server_data->output_fd = -1;
+	}
+	if (server_data->chunk_engine != NULL) {
+		chunk_engine_destroy(server_data->chunk_engine);
+		server_data->chunk_engine = NULL;
+	}
+	free(server_data->window_headers);
+	server_data->window_headers = NULL;
+}
+
+/*
+ * Handle a message received from the client, updating the transfer state
+ *
+ * @cfg [in]: application config struct
+ * @recv_buffer [in]: message data
+ * @msg_len [in]: message length
+ */
+static void server_handle_msg(struct file_compression_config *cfg, uint8_t *recv_buffer, uint32_t msg_len)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
 
 	/* First received message should contain file metadata */
-	if (server_data->expected_file_chunks == 0) {
+	if (cfg->state == TRANSFER_IDLE) {
 		struct file_info_message *file_info = (struct file_info_message *)recv_buffer;
 
 		if (msg_len != sizeof(struct file_info_message)) {
@@ -630,10 +1133,38 @@ void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
 			cfg->state = TRANSFER_ERROR;
 			return;
 		}
+		if (ntohl(file_info->window) == 0 || ntohl(file_info->window) > TRANSFER_MAX_WINDOW) {
+			DOCA_LOG_ERR("Invalid client window of %u messages", ntohl(file_info->window));
+			cfg->state = TRANSFER_ERROR;
+			return;
+		}
+
+		/* Credits are returned in batches sized to the window of the client */
+		transfer_receiver_set_window(&server_data->receiver, ntohl(file_info->window));
+		cfg->state = TRANSFER_IN_PROGRESS;
+		if (file_info->chunk_size != 0) {
+			if (chunked_receive_start(cfg, file_info) != DOCA_SUCCESS)
+				cfg->state = TRANSFER_ERROR;
+			return;
+		}
 
+		/* The whole compressed file is received before it is decompressed */
+		server_data->compressed_file = calloc(1, cfg->max_compress_file_len);
+		if (server_data->compressed_file == NULL) {
+			DOCA_LOG_ERR("Failed to allocate file memory");
+			cfg->state = TRANSFER_ERROR;
+			return;
+		}
 		server_data->expected_file_chunks = ntohl(file_info->num_segs);
 		server_data->expected_checksum = ntohq(file_info->checksum);
-		cfg->state = TRANSFER_IN_PROGRESS;
+		return;
+	}
+
+	if (server_data->chunk_size != 0) {
+		if (chunked_receive_data(cfg, recv_buffer, msg_len) != DOCA_SUCCESS)
+			cfg->state = TRANSFER_ERROR;
+		else if (server_data->received_file_chunks == server_data->expected_file_chunks)
+			cfg->state = TRANSFER_COMPLETE;
 		return;
 	}
 
@@ -653,39 +1184,75 @@ void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
 		cfg->state = TRANSFER_COMPLETE;
 }
 
+void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
+			  uint8_t *recv_buffer,
+			  uint32_t msg_len,
+			  struct doca_comch_connection *comch_connection)
+{
+	struct file_compression_config *cfg = comch_utils_get_user_data(comch_connection);
+	uint64_t start_ns = transfer_get_time_ns();
+
+	(void)event;
+
+	if (cfg == NULL) {
+		DOCA_LOG_ERR("Cannot get configuration information");
+		return;
+	}
+
+	/* Ignore any events occurring after transfer is complete */
+	if (cfg->state == TRANSFER_COMPLETE || cfg->state == TRANSFER_ERROR)
+		return;
+
+	cfg->server_data.nb_received_msgs++;
+	server_handle_msg(cfg, recv_buffer, msg_len);
+
+	/* The credit of the message is returned by the main loop, sending is not allowed from the callback */
+	transfer_receiver_consume(&cfg->server_data.receiver, msg_len, start_ns);
+}
+
 doca_error_t file_compression_server(struct comch_cfg *comch_cfg,
 				     struct file_compression_config *compress_cfg,
 				     struct compress_resources *resources)
 {
+	struct transfer_ops ops = {
+		.send = comch_transport_send,
+		.progress = comch_transport_progress,
+		.transport = comch_cfg,
+	};
 	struct server_runtime_data *server_data;
 	int fd;
 	char finish_msg[] = "Server was done receiving messages";
 	uint8_t *resp_head;
 	uint64_t checksum;
 	size_t data_len;
-	int counter = 0;
-	int num_of_iterations = (compress_cfg->timeout * 1000 * 1000) / (SLEEP_IN_NANOS / 1000);
-	struct timespec ts = {
-		.tv_nsec = SLEEP_IN_NANOS,
-	};
+	uint64_t nb_received_msgs, now_ns, last_msg_ns = 0;
+	uint64_t timeout_ns = (uint64_t)compress_cfg->timeout * 1000 * 1000 * 1000;
 	doca_error_t result;
 
 	server_data = (struct server_runtime_data *)&compress_cfg->server_data;
+	server_data->resources = resources;
+	transfer_receiver_init(&server_data->receiver, &ops, compress_cfg->send_window);
 
-	/* Wait on comch to complete client to server transactions */
+	/* Wait on comch to complete client to server transactions, the connection is progressed without sleeping */
 	while (compress_cfg->state != TRANSFER_COMPLETE && compress_cfg->state != TRANSFER_ERROR) {
-		nanosleep(&ts, &ts);
+		nb_received_msgs = server_data->nb_received_msgs;
 		result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
+		if (result == DOCA_SUCCESS)
+			result = transfer_receiver_return_credits(&server_data->receiver);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Comch connection unexpectedly dropped: %s", doca_error_get_descr(result));
+			chunked_receive_cleanup(server_data);
 			return result;
 		}
 
 		if (compress_cfg->state == TRANSFER_IDLE)
 			continue;
 
-		counter++;
-		if (counter == num_of_iterations) {
+		/* The timeout counts the time without any message from the client */
+		now_ns = transfer_get_time_ns();
+		if (server_data->nb_received_msgs != nb_received_msgs)
+			last_msg_ns = now_ns;
+		else if (now_ns - last_msg_ns > timeout_ns) {
 			DOCA_LOG_ERR("Message was not received at the given timeout");
 			result = DOCA_ERROR_BAD_STATE;
 			goto finish_msg;
@@ -698,6 +1265,16 @@ doca_error_t file_compression_server(struct comch_cfg *comch_cfg,
 		goto finish_msg;
 	}
 
+	/* In chunked mode the chunks were already decompressed, verified and written as they arrived */
+	if (server_data->chunk_size != 0) {
+		DOCA_LOG_INFO("SUCCESS: file was received and decompressed successfully");
+		transfer_stage_log("Receive", &server_data->receiver.stats);
+		transfer_stage_log("Decompress", &server_data->decompress_stats);
+		transfer_stage_log("Write", &server_data->write_stats);
+		goto finish_msg;
+	}
+
+	transfer_stage_log("Receive", &server_data->receiver.stats);
 	result = compress_file(server_data->compressed_file,
 			       server_data->received_file_length,
 			       compress_cfg->max_compress_file_len,
@@ -741,7 +1318,8 @@ doca_error_t file_compression_server(struct comch_cfg *comch_cfg,
 	close(fd);
 
 finish_msg:
-	if (comch_utils_send(comch_util_get_connection(comch_cfg), finish_msg, sizeof(finish_msg)) != DOCA_SUCCESS)
+	chunked_receive_cleanup(server_data);
+	if (transfer_receiver_finish(&server_data->receiver, finish_msg) != DOCA_SUCCESS)
 		DOCA_LOG_ERR("Failed to send finish message: %s", doca_error_get_descr(result));
 
 	return result;
@@ -755,6 +1333,16 @@ doca_error_t file_compression_init(struct file_compression_config *compress_cfg,
 	if (compress_cfg->timeout == 0)
 		compress_cfg->timeout = DEFAULT_TIMEOUT;
 
+	/* set chunked mode defaults */
+	if (compress_cfg->chunk_window == 0)
+		compress_cfg->chunk_window = DEFAULT_CHUNK_WINDOW;
+	if (compress_cfg->nb_sw_threads == 0)
+		compress_cfg->nb_sw_threads =
+			MAX(1, MIN((uint32_t)sysconf(_SC_NPROCESSORS_ONLN), compress_cfg->chunk_window));
+	compress_cfg->server_data.output_fd = -1;
+	if (compress_cfg->send_window == 0)
+		compress_cfg->send_window = DEFAULT_SEND_WINDOW;
+
 	result = init_compress_resources(compress_cfg,
 					 resources,
 					 &compress_cfg->compress_method,
@@ -762,16 +1350,7 @@ doca_error_t file_compression_init(struct file_compression_config *compress_cfg,
 	if (result != DOCA_SUCCESS)
 		return result;
 
-	/* Server should preallocate memory to receive a file */
-	if (compress_cfg->mode == SERVER) {
-		compress_cfg->server_data.compressed_file = calloc(1, compress_cfg->max_compress_file_len);
-		if (compress_cfg->server_data.compressed_file == NULL) {
-			DOCA_LOG_ERR("Failed to allocate file memory");
-			(void)destroy_compress_resources(resources);
-			return DOCA_ERROR_NO_MEMORY;
-		}
-	}
-
+	/* Server allocates the memory to receive a file once it knows whether the file is chunked */
 	return DOCA_SUCCESS;
 }
 
@@ -877,6 +1456,86 @@ static doca_error_t timeout_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle chunk size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunk_size_callback(void *param, void *config)
+{
+	struct file_compression_config *compress_cfg = (struct file_compression_config *)config;
+	int *chunk_size_kb = (int *)param;
+
+	if (*chunk_size_kb < 0 || *chunk_size_kb > MAX_CHUNK_SIZE_KB) {
+		DOCA_LOG_ERR("Chunk size must be between 0 and %d KB", MAX_CHUNK_SIZE_KB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	compress_cfg->chunk_size = *chunk_size_kb * 1024;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle chunk window parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t chunk_window_callback(void *param, void *config)
+{
+	struct file_compression_config *compress_cfg = (struct file_compression_config *)config;
+	int *chunk_window = (int *)param;
+
+	if (*chunk_window <= 0 || *chunk_window > MAX_CHUNK_WINDOW) {
+		DOCA_LOG_ERR("Chunk window must be between 1 and %d", MAX_CHUNK_WINDOW);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	compress_cfg->chunk_window = *chunk_window;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle SW threads parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t sw_threads_callback(void *param, void *config)
+{
+	struct file_compression_config *compress_cfg = (struct file_compression_config *)config;
+	int *nb_threads = (int *)param;
+
+	if (*nb_threads <= 0) {
+		DOCA_LOG_ERR("Number of SW threads must be positive value");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	compress_cfg->nb_sw_threads = *nb_threads;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle send window parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_window_callback(void *param, void *config)
+{
+	struct file_compression_config *compress_cfg = (struct file_compression_config *)config;
+	int *send_window = (int *)param;
+
+	if (*send_window <= 0 || *send_window > TRANSFER_MAX_WINDOW) {
+		DOCA_LOG_ERR("Send window must be between 1 and %d", TRANSFER_MAX_WINDOW);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	compress_cfg->send_window = *send_window;
+	return DOCA_SUCCESS;
+}
+
 /*
  * ARGP validation Callback - check if the running mode is valid and that the input file exists in client mode
  *
@@ -902,6 +1561,7 @@ doca_error_t register_file_compression_params(void)
 	doca_error_t result;
 
 	struct doca_argp_param *dev_pci_addr_param, *rep_pci_addr_param, *file_param, *timeout_param;
+	struct doca_argp_param *chunk_size_param, *chunk_window_param, *sw_threads_param, *send_window_param;
 
 	/* Create and register pci param */
 	result = doca_argp_param_create(&dev_pci_addr_param);
@@ -974,6 +1634,79 @@ doca_error_t register_file_compression_params(void)
 		return result;
 	}
 
+	/* Create and register chunk size param */
+	result = doca_argp_param_create(&chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(chunk_size_param, "c");
+	doca_argp_param_set_long_name(chunk_size_param, "chunk-size");
+	doca_argp_param_set_description(
+		chunk_size_param,
+		"Client only - compress and send the file in independent chunks of this size in KB, default is 0 (single stream)");
+	doca_argp_param_set_callback(chunk_size_param, chunk_size_callback);
+	doca_argp_param_set_type(chunk_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(chunk_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register chunk window param */
+	result = doca_argp_param_create(&chunk_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(chunk_window_param, "w");
+	doca_argp_param_set_long_name(chunk_window_param, "chunk-window");
+	doca_argp_param_set_description(chunk_window_param,
+					"Number of chunks compressed / decompressed concurrently, default is 8");
+	doca_argp_param_set_callback(chunk_window_param, chunk_window_callback);
+	doca_argp_param_set_type(chunk_window_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(chunk_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register SW threads param */
+	result = doca_argp_param_create(&sw_threads_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(sw_threads_param, "sw-threads");
+	doca_argp_param_set_description(
+		sw_threads_param,
+		"Number of threads compressing chunks when running without a compress device, default is min(cores, chunk window)");
+	doca_argp_param_set_callback(sw_threads_param, sw_threads_callback);
+	doca_argp_param_set_type(sw_threads_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(sw_threads_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register send window param */
+	result = doca_argp_param_create(&send_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(send_window_param, "send-window");
+	doca_argp_param_set_description(
+		send_window_param,
+		"Client only - number of data messages in flight before waiting for the server to return credits, default is 64");
+	doca_argp_param_set_callback(send_window_param, send_window_callback);
+	doca_argp_param_set_type(send_window_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(send_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	/* Register version callback for DOCA SDK & RUNTIME */
 	result = doca_argp_register_version_callback(sdk_version_callback);
 	if (result != DOCA_SUCCESS) {
@@ -32,6 +32,8 @@
 #include <doca_compress.h>
 
 #include "comch_utils.h"
+#include "file_compression_chunks.h"
+#include "file_compression_transfer.h"
 
 #include <samples/common.h>
 #include <samples/doca_compress/compress_common.h>
@@ -58,11 +60,27 @@ enum transfer_state {
 };
 
 struct server_runtime_data {
-	uint64_t expected_checksum;    /* Expected checksum of transferred file */
-	uint32_t expected_file_chunks; /* Number of chunks file should be sent in */
-	uint32_t received_file_chunks; /* Current number of chunks received */
-	uint32_t received_file_length; /* Current length of file data received */
-	char *compressed_file;	       /* File received on server */
+	uint64_t expected_checksum;	      /* Expected checksum of transferred file */
+	uint32_t expected_file_chunks;	      /* Number of chunks file should be sent in */
+	uint32_t received_file_chunks;	      /* Current number of chunks received */
+	uint32_t received_file_length;	      /* Current length of file data received */
+	char *compressed_file;		      /* File received on server */
+	uint64_t nb_received_msgs;	      /* Number of messages received, used to detect inactivity */
+	struct compress_resources *resources; /* DOCA compress resources to decompress chunks with */
+	/* Chunked mode - see file_compression_chunks.h */
+	uint32_t chunk_size;		     /* Chunk size, 0 if the file is sent as a single deflate stream */
+	uint64_t file_size;		     /* Length of the decompressed file */
+	struct chunk_engine *chunk_engine;   /* Engine decompressing a window of chunks concurrently */
+	struct chunk_header *window_headers; /* Headers of the chunks in the engine window */
+	uint32_t nb_window_chunks;	     /* Number of complete chunks in the engine window */
+	struct chunk_header header;	     /* Header of the chunk being received */
+	uint32_t header_len;		     /* Number of bytes of header received */
+	uint32_t data_len;		     /* Number of data bytes of the chunk being received */
+	int output_fd;			     /* File the decompressed chunks are written to */
+	/* Transfer protocol - see file_compression_transfer.h */
+	struct transfer_receiver receiver;	      /* Returns credits of consumed messages, receive stage counters */
+	struct transfer_stage_stats decompress_stats; /* Decompress stage counters */
+	struct transfer_stage_stats write_stats;      /* Write stage counters */
 };
 
 /* File compression configuration struct */
@@ -74,10 +92,25 @@ struct file_compression_config {
 	int timeout;						  /* Application timeout in seconds */
 	enum file_compression_compress_method compress_method;	  /* Whether to run compress with HW or SW */
 	uint64_t max_compress_file_len;				  /* Max supported length of compress file */
+	uint32_t chunk_size;					  /* Chunked mode chunk size, 0 to disable */
+	uint32_t chunk_window;					  /* Number of chunks processed concurrently */
+	uint32_t nb_sw_threads;					  /* Number of SW compression threads */
+	uint32_t send_window;					  /* Number of data messages in flight */
+	struct transfer_sender sender;		/* Data sender of the client, the server returns credits to it */
 	struct server_runtime_data server_data; /* Data populated on server side during file transmission */
 	enum transfer_state state;		/* Indicator of completion of a file transfer */
 };
 
+/*
+ * Calculate file checksum with zlib, where the lower 32 bits contain the CRC checksum result
+ * and the upper 32 bits contain the Adler checksum result.
+ *
+ * @file_data [in]: file data to the source buffer
+ * @file_size [in]: file size
+ * @output_chksum [out]: the calculated checksum
+ */
+void calculate_checksum_sw(char *file_data, size_t file_size, uint64_t *output_chksum);
+
 /*
  * Initialize application resources
  *
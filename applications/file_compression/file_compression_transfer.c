@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <arpa/inet.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_log.h>
+
+#include "file_compression_transfer.h"
+
+DOCA_LOG_REGISTER(FILE_COMPRESSION::Transfer);
+
+uint64_t transfer_get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void transfer_stage_account(struct transfer_stage_stats *stats, uint64_t nb_bytes, uint64_t start_ns)
+{
+	stats->nb_bytes += nb_bytes;
+	stats->nb_ops++;
+	stats->busy_ns += transfer_get_time_ns() - start_ns;
+}
+
+void transfer_stage_log(const char *name, const struct transfer_stage_stats *stats)
+{
+	/* Bytes per nanosecond * 1000 is MB per second */
+	double throughput = stats->busy_ns == 0 ? 0 : (double)stats->nb_bytes * 1000 / stats->busy_ns;
+
+	DOCA_LOG_INFO("%s: %" PRIu64 " bytes in %" PRIu64 " operations, %.3f ms, %.2f MB/s",
+		      name,
+		      stats->nb_bytes,
+		      stats->nb_ops,
+		      (double)stats->busy_ns / 1000000,
+		      throughput);
+}
+
+doca_error_t transfer_sender_init(struct transfer_sender *sender,
+				  const struct transfer_ops *ops,
+				  uint32_t window,
+				  uint32_t max_len)
+{
+	if (window == 0 || max_len == 0) {
+		DOCA_LOG_ERR("Invalid transfer window %u or maximal message length %u", window, max_len);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	memset(sender, 0, sizeof(*sender));
+	sender->buf = malloc(max_len);
+	if (sender->buf == NULL) {
+		DOCA_LOG_ERR("Failed to allocate transfer message buffer");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	sender->ops = *ops;
+	sender->credits = window;
+	sender->max_len = max_len;
+	return DOCA_SUCCESS;
+}
+
+void transfer_sender_destroy(struct transfer_sender *sender)
+{
+	free(sender->buf);
+	sender->buf = NULL;
+}
+
+doca_error_t transfer_sender_send(struct transfer_sender *sender, const void *msg, uint32_t len)
+{
+	uint64_t start_ns = transfer_get_time_ns();
+	doca_error_t result;
+
+	/* Completions and credits are collected by progressing the transport, there is nothing to sleep on */
+	if (sender->credits == 0)
+		sender->nb_stalls++;
+	while (sender->credits == 0 && !sender->peer_done) {
+		result = sender->ops.progress(sender->ops.transport);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	if (sender->peer_done)
+		return DOCA_ERROR_IO_FAILED;
+
+	result = sender->ops.send(sender->ops.transport, msg, len);
+	while (result == DOCA_ERROR_AGAIN) {
+		result = sender->ops.progress(sender->ops.transport);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = sender->ops.send(sender->ops.transport, msg, len);
+	}
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	sender->credits--;
+	transfer_stage_account(&sender->stats, len, start_ns);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t transfer_sender_write(struct transfer_sender *sender, const void *data, uint64_t len)
+{
+	const uint8_t *src = data;
+	uint32_t copy_len;
+	doca_error_t result;
+
+	while (len > 0) {
+		copy_len = sender->max_len - sender->len;
+		if (copy_len > len)
+			copy_len = len;
+		memcpy(sender->buf + sender->len, src, copy_len);
+		sender->len += copy_len;
+		src += copy_len;
+		len -= copy_len;
+
+		if (sender->len == sender->max_len) {
+			result = transfer_sender_flush(sender);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+doca_error_t transfer_sender_flush(struct transfer_sender *sender)
+{
+	doca_error_t result;
+
+	if (sender->len == 0)
+		return DOCA_SUCCESS;
+	result = transfer_sender_send(sender, sender->buf, sender->len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	sender->len = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t transfer_sender_recv_ctrl(struct transfer_sender *sender,
+				       const uint8_t *msg,
+				       uint32_t len,
+				       const char **status)
+{
+	struct transfer_ctrl_msg ctrl;
+
+	*status = NULL;
+	if (len < sizeof(ctrl)) {
+		DOCA_LOG_ERR("Control message of %u bytes is too short", len);
+		return DOCA_ERROR_BAD_STATE;
+	}
+	memcpy(&ctrl, msg, sizeof(ctrl));
+
+	switch (ntohl(ctrl.type)) {
+	case TRANSFER_CTRL_CREDIT:
+		sender->credits += ntohl(ctrl.credits);
+		return DOCA_SUCCESS;
+	case TRANSFER_CTRL_FINISH:
+		if (len == sizeof(ctrl) || msg[len - 1] != '\0') {
+			DOCA_LOG_ERR("Finish message has no status text");
+			return DOCA_ERROR_BAD_STATE;
+		}
+		sender->peer_done = true;
+		*status = (const char *)msg + sizeof(ctrl);
+		return DOCA_SUCCESS;
+	default:
+		DOCA_LOG_ERR("Unknown control message type %u", ntohl(ctrl.type));
+		return DOCA_ERROR_BAD_STATE;
+	}
+}
+
+void transfer_receiver_init(struct transfer_receiver *receiver, const struct transfer_ops *ops, uint32_t window)
+{
+	memset(receiver, 0, sizeof(*receiver));
+	receiver->ops = *ops;
+	transfer_receiver_set_window(receiver, window);
+}
+
+void transfer_receiver_set_window(struct transfer_receiver *receiver, uint32_t window)
+{
+	receiver->credit_batch = window > 1 ? window / 2 : 1;
+}
+
+void transfer_receiver_consume(struct transfer_receiver *receiver, uint32_t len, uint64_t start_ns)
+{
+	receiver->nb_consumed++;
+	transfer_stage_account(&receiver->stats, len, start_ns);
+}
+
+doca_error_t transfer_receiver_return_credits(struct transfer_receiver *receiver)
+{
+	struct transfer_ctrl_msg ctrl;
+	doca_error_t result;
+
+	if (receiver->nb_consumed < receiver->credit_batch)
+		return DOCA_SUCCESS;
+
+	ctrl.type = htonl(TRANSFER_CTRL_CREDIT);
+	ctrl.credits = htonl(receiver->nb_consumed);
+	result = receiver->ops.send(receiver->ops.transport, &ctrl, sizeof(ctrl));
+	if (result == DOCA_ERROR_AGAIN)
+		return DOCA_SUCCESS;
+	if (result != DOCA_SUCCESS)
+		return result;
+	receiver->nb_consumed = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t transfer_receiver_finish(struct transfer_receiver *receiver, const char *status)
+{
+	struct transfer_ctrl_msg ctrl = {
+		.type = htonl(TRANSFER_CTRL_FINISH),
+	};
+	uint32_t len = sizeof(ctrl) + strlen(status) + 1;
+	uint8_t *msg;
+	doca_error_t result;
+
+	msg = malloc(len);
+	if (msg == NULL) {
+		DOCA_LOG_ERR("Failed to allocate finish message");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memcpy(msg, &ctrl, sizeof(ctrl));
+	memcpy(msg + sizeof(ctrl), status, len - sizeof(ctrl));
+
+	result = receiver->ops.send(receiver->ops.transport, msg, len);
+	while (result == DOCA_ERROR_AGAIN) {
+		result = receiver->ops.progress(receiver->ops.transport);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = receiver->ops.send(receiver->ops.transport, msg, len);
+	}
+	free(msg);
+	return result;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef FILE_COMPRESSION_TRANSFER_H_
+#define FILE_COMPRESSION_TRANSFER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+/*
+ * Credit based transfer protocol:
+ *	The client may have up to window data messages that the server has not consumed yet. The server returns
+ *	credits for the messages it consumed, in batches of half the window, so the client keeps sending while the
+ *	server processes earlier messages. When the transfer is over the server sends a finish message with a
+ *	status text.
+ * The protocol is written against struct transfer_ops, so it can run over comch or over any loopback transport.
+ */
+#define TRANSFER_MAX_WINDOW 512 /* Maximal number of data messages in flight */
+
+/* Type of the control messages sent by the server to the client */
+enum transfer_ctrl_type {
+	TRANSFER_CTRL_CREDIT = 1, /* Returns credits of consumed data messages */
+	TRANSFER_CTRL_FINISH = 2, /* Transfer is over, followed by a null terminated status text */
+};
+
+/* Control message header, in network byte order */
+struct transfer_ctrl_msg {
+	uint32_t type;	  /* Message type, see enum transfer_ctrl_type */
+	uint32_t credits; /* Number of returned credits, TRANSFER_CTRL_CREDIT only */
+} __attribute__((packed));
+
+/* Message transport the protocol runs over */
+struct transfer_ops {
+	doca_error_t (*send)(void *transport, const void *msg, uint32_t len); /* Send, AGAIN on a full queue */
+	doca_error_t (*progress)(void *transport);			      /* Deliver completions and messages */
+	void *transport;						      /* Passed to the callbacks */
+};
+
+/* Throughput counters of a pipeline stage */
+struct transfer_stage_stats {
+	uint64_t nb_bytes; /* Number of bytes processed by the stage */
+	uint64_t nb_ops;   /* Number of operations of the stage */
+	uint64_t busy_ns;  /* Time spent in the stage */
+};
+
+/* Sending side of the protocol - packs a byte stream into messages and sends them as credits allow */
+struct transfer_sender {
+	struct transfer_ops ops;	   /* Transport */
+	uint32_t credits;		   /* Number of data messages that can be sent without waiting */
+	bool peer_done;			   /* The receiver finished the transfer, no more credits will be returned */
+	uint8_t *buf;			   /* Stream message being built */
+	uint32_t len;			   /* Length of the data in buf */
+	uint32_t max_len;		   /* Maximal message length */
+	uint64_t nb_stalls;		   /* Number of times sending waited for credits */
+	struct transfer_stage_stats stats; /* Send stage counters */
+};
+
+/* Receiving side of the protocol - returns credits for consumed messages */
+struct transfer_receiver {
+	struct transfer_ops ops;	   /* Transport */
+	uint32_t credit_batch;		   /* Number of consumed messages to return credits for at once */
+	uint32_t nb_consumed;		   /* Number of consumed messages whose credits were not returned yet */
+	struct transfer_stage_stats stats; /* Receive stage counters */
+};
+
+/*
+ * Get a monotonic timestamp for the stage counters
+ *
+ * @return: time in nanoseconds
+ */
+uint64_t transfer_get_time_ns(void);
+
+/*
+ * Account an operation of a pipeline stage
+ *
+ * @stats [in]: stage counters
+ * @nb_bytes [in]: number of bytes processed by the operation
+ * @start_ns [in]: timestamp taken with transfer_get_time_ns() when the operation started
+ */
+void transfer_stage_account(struct transfer_stage_stats *stats, uint64_t nb_bytes, uint64_t start_ns);
+
+/*
+ * Log the throughput of a pipeline stage
+ *
+ * @name [in]: stage name
+ * @stats [in]: stage counters
+ */
+void transfer_stage_log(const char *name, const struct transfer_stage_stats *stats);
+
+/*
+ * Initialize a sender
+ *
+ * @sender [in]: sender to initialize
+ * @ops [in]: transport
+ * @window [in]: number of data messages the receiver accepts before returning credits
+ * @max_len [in]: maximal message length of the transport
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_sender_init(struct transfer_sender *sender,
+				  const struct transfer_ops *ops,
+				  uint32_t window,
+				  uint32_t max_len);
+
+/*
+ * Release the resources of a sender
+ *
+ * @sender [in]: sender to destroy
+ */
+void transfer_sender_destroy(struct transfer_sender *sender);
+
+/*
+ * Send a single message, progressing the transport while no credit is available or the send queue is full
+ *
+ * @sender [in]: sender
+ * @msg [in]: message to send
+ * @len [in]: message length, up to the maximal message length
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_IO_FAILED if the receiver finished and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_sender_send(struct transfer_sender *sender, const void *msg, uint32_t len);
+
+/*
+ * Append data to the sender stream, sending every message that fills up
+ *
+ * @sender [in]: sender
+ * @data [in]: data to append
+ * @len [in]: data length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_sender_write(struct transfer_sender *sender, const void *data, uint64_t len);
+
+/*
+ * Send the partially built message of the sender stream
+ *
+ * @sender [in]: sender
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_sender_flush(struct transfer_sender *sender);
+
+/*
+ * Handle a control message received by the sender - credits are added to the sender, a finish message stops it
+ *
+ * @sender [in]: sender
+ * @msg [in]: received message
+ * @len [in]: message length
+ * @status [out]: status text of a finish message, NULL for other messages
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_BAD_STATE for a malformed message
+ */
+doca_error_t transfer_sender_recv_ctrl(struct transfer_sender *sender,
+				       const uint8_t *msg,
+				       uint32_t len,
+				       const char **status);
+
+/*
+ * Initialize a receiver
+ *
+ * @receiver [in]: receiver to initialize
+ * @ops [in]: transport
+ * @window [in]: window of the sender
+ */
+void transfer_receiver_init(struct transfer_receiver *receiver, const struct transfer_ops *ops, uint32_t window);
+
+/*
+ * Set the window of the sender, once it is announced by the sender
+ *
+ * @receiver [in]: receiver
+ * @window [in]: window of the sender
+ */
+void transfer_receiver_set_window(struct transfer_receiver *receiver, uint32_t window);
+
+/*
+ * Account a data message consumed by the receiver
+ *
+ * @receiver [in]: receiver
+ * @len [in]: message length
+ * @start_ns [in]: timestamp taken with transfer_get_time_ns() when handling of the message started
+ */
+void transfer_receiver_consume(struct transfer_receiver *receiver, uint32_t len, uint64_t start_ns);
+
+/*
+ * Return the credits of the consumed messages once a batch accumulated. Must not be called from a receive
+ * callback of the transport. A full send queue leaves the credits pending for the next call.
+ *
+ * @receiver [in]: receiver
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_receiver_return_credits(struct transfer_receiver *receiver);
+
+/*
+ * Send the finish message, progressing the transport while the send queue is full
+ *
+ * @receiver [in]: receiver
+ * @status [in]: status text sent to the sender
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t transfer_receiver_finish(struct transfer_receiver *receiver, const char *status);
+
+#endif /* FILE_COMPRESSION_TRANSFER_H_ */
@@ -24,8 +24,10 @@
  */
 
 #include <arpa/inet.h>
+#include <endian.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <time.h>
@@ -44,6 +46,9 @@
 #define DEFAULT_TIMEOUT (10)			  /* default timeout for receiving messages */
 #define SHA_ALGORITHM (DOCA_SHA_ALGORITHM_SHA256) /* doca_sha_algorithm for the sample */
 #define LOG_NUM_SHA_TASKS (0)			  /* Log of SHA tasks number */
+#define DEFAULT_HASH_WINDOW (16)		  /* default number of leaves hashed concurrently */
+#define MAX_HASH_WINDOW (256)			  /* maximal number of leaves hashed concurrently */
+#define MAX_LEAF_SIZE_KB (64 * 1024)		  /* maximal Merkle leaf size in KB */
 
 DOCA_LOG_REGISTER(FILE_INTEGRITY::Core);
 
@@ -78,6 +83,76 @@ static void unmap_cb(void *addr, size_t len, void *opaque)
 		munmap(addr, len);
 }
 
+/*
+ * Get the current time in nanoseconds
+ *
+ * @return: monotonic time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/*
+ * Log the hashing throughput of a Merkle transfer
+ *
+ * @mode [in]: leaf hash mode
+ * @nb_bytes [in]: number of bytes hashed
+ * @hash_ns [in]: time spent hashing
+ */
+static void log_hash_rate(enum leaf_hash_mode mode, uint64_t nb_bytes, uint64_t hash_ns)
+{
+	DOCA_LOG_INFO("Hashed %lu bytes of leaves in %s mode in %.3f ms: %.2f GB/s",
+		      nb_bytes,
+		      leaf_hash_mode_name(mode),
+		      (double)hash_ns / 1e6,
+		      hash_ns == 0 ? 0.0 : (double)nb_bytes / (double)hash_ns);
+}
+
+/*
+ * Log a Merkle root in hex format
+ *
+ * @root [in]: Merkle root
+ */
+static void log_merkle_root(const uint8_t *root)
+{
+	char root_output[(MERKLE_HASH_LEN * 2) + 1];
+	int i;
+
+	for (i = 0; i < MERKLE_HASH_LEN; i++)
+		snprintf(root_output + (2 * i), 3, "%02x", root[i]);
+	DOCA_LOG_INFO("Merkle root is: %s", root_output);
+}
+
+/*
+ * Send a message over comch, progressing the connection while the send queue is full
+ *
+ * @comch_cfg [in]: comch configuration object
+ * @msg [in]: message to send
+ * @len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_msg(struct comch_cfg *comch_cfg, const void *msg, uint32_t len)
+{
+	struct timespec ts = {
+		.tv_nsec = SLEEP_IN_NANOS,
+	};
+	doca_error_t result;
+
+	result = comch_utils_send(comch_util_get_connection(comch_cfg), msg, len);
+	while (result == DOCA_ERROR_AGAIN) {
+		nanosleep(&ts, &ts);
+		result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
+		if (result != DOCA_SUCCESS)
+			break;
+		result = comch_utils_send(comch_util_get_connection(comch_cfg), msg, len);
+	}
+	return result;
+}
+
 /*
  * Populate destination doca buffer for SHA tasks
  *
@@ -292,9 +367,6 @@ static doca_error_t send_file(struct comch_cfg *comch_cfg,
 	size_t msg_len;
 	uint32_t i, partial_block_size;
 	doca_error_t result;
-	struct timespec ts = {
-		.tv_nsec = SLEEP_IN_NANOS,
-	};
 
 	meta_msg_len = sizeof(struct file_integrity_metadata_msg) + sha_len;
 	meta_msg = (struct file_integrity_metadata_msg *)malloc(meta_msg_len);
@@ -346,15 +418,7 @@ static doca_error_t send_file(struct comch_cfg *comch_cfg,
 		if (app_cfg->state == TRANSFER_COMPLETE)
 			break;
 
-		result = comch_utils_send(comch_util_get_connection(comch_cfg), file_data, msg_len);
-		while (result == DOCA_ERROR_AGAIN) {
-			nanosleep(&ts, &ts);
-			result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
-			if (result != DOCA_SUCCESS)
-				break;
-			result = comch_utils_send(comch_util_get_connection(comch_cfg), file_data, msg_len);
-		}
-
+		result = send_msg(comch_cfg, file_data, msg_len);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("File data was not sent: %s", doca_error_get_descr(result));
 			return result;
@@ -365,6 +429,229 @@ static doca_error_t send_file(struct comch_cfg *comch_cfg,
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Get the number of SW threads of a leaf hasher
+ *
+ * @app_cfg [in]: app configuration
+ * @return: number of threads
+ */
+static uint32_t get_nb_hash_threads(struct file_integrity_config *app_cfg)
+{
+	return MAX(1, MIN((uint32_t)sysconf(_SC_NPROCESSORS_ONLN), app_cfg->hash_window));
+}
+
+/*
+ * Hash the leaves of the input file and compute its Merkle root
+ *
+ * @app_cfg [in]: app configuration
+ * @state [in]: application core object struct
+ * @sha_ctx [in]: context of SHA library, NULL in SW mode
+ * @fd [in]: file descriptor of the input file
+ * @file_size [in]: file size
+ * @nb_leaves [in]: number of leaves of the file
+ * @leaf_hashes [out]: hashes of all leaves
+ * @root [out]: Merkle root of the file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hash_file_leaves(struct file_integrity_config *app_cfg,
+				     struct program_core_objects *state,
+				     struct doca_sha *sha_ctx,
+				     int fd,
+				     uint64_t file_size,
+				     uint32_t nb_leaves,
+				     uint8_t *leaf_hashes,
+				     uint8_t *root)
+{
+	struct leaf_hasher *hasher;
+	struct leaf_slot *slot;
+	uint64_t offset, start, hash_ns = 0;
+	uint32_t leaf, nb_slots, i;
+	doca_error_t result;
+
+	result = leaf_hasher_create(app_cfg->hash_mode,
+				    state,
+				    sha_ctx,
+				    app_cfg->leaf_size,
+				    app_cfg->hash_window,
+				    get_nb_hash_threads(app_cfg),
+				    &hasher);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create leaf hasher: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (leaf = 0; leaf < nb_leaves; leaf += nb_slots) {
+		nb_slots = MIN(app_cfg->hash_window, nb_leaves - leaf);
+		for (i = 0; i < nb_slots; i++) {
+			slot = leaf_hasher_get_slot(hasher, i);
+			offset = (uint64_t)(leaf + i) * app_cfg->leaf_size;
+			slot->len = MIN(app_cfg->leaf_size, file_size - offset);
+			if (pread(fd, slot->data, slot->len, offset) != (ssize_t)slot->len) {
+				DOCA_LOG_ERR("Failed to read leaf %u of %s", leaf + i, app_cfg->file_path);
+				result = DOCA_ERROR_IO_FAILED;
+				goto destroy_hasher;
+			}
+		}
+
+		start = get_time_ns();
+		result = leaf_hasher_run(hasher, nb_slots);
+		hash_ns += get_time_ns() - start;
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to hash leaves: %s", doca_error_get_descr(result));
+			goto destroy_hasher;
+		}
+
+		for (i = 0; i < nb_slots; i++)
+			memcpy(leaf_hashes + (size_t)(leaf + i) * MERKLE_HASH_LEN,
+			       leaf_hasher_get_slot(hasher, i)->hash,
+			       MERKLE_HASH_LEN);
+	}
+	log_hash_rate(app_cfg->hash_mode, file_size, hash_ns);
+
+	result = merkle_compute_root(leaf_hashes, nb_leaves, root);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to compute Merkle root: %s", doca_error_get_descr(result));
+		goto destroy_hasher;
+	}
+	log_merkle_root(root);
+
+destroy_hasher:
+	leaf_hasher_destroy(hasher);
+	return result;
+}
+
+/*
+ * Send the input file over comch in Merkle tree mode - the Merkle metadata, the leaf hashes and then the file data
+ *
+ * @comch_cfg [in]: comch configuration object to send file across
+ * @app_cfg [in]: app configuration
+ * @fd [in]: file descriptor of the input file
+ * @file_size [in]: file size
+ * @nb_leaves [in]: number of leaves of the file
+ * @leaf_hashes [in]: hashes of all leaves
+ * @root [in]: Merkle root of the file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_file_merkle(struct comch_cfg *comch_cfg,
+				     struct file_integrity_config *app_cfg,
+				     int fd,
+				     uint64_t file_size,
+				     uint32_t nb_leaves,
+				     const uint8_t *leaf_hashes,
+				     const uint8_t *root)
+{
+	struct file_integrity_merkle_msg merkle_msg = {0};
+	uint64_t hashes_len = (uint64_t)nb_leaves * MERKLE_HASH_LEN;
+	uint64_t offset;
+	uint32_t max_comch_msg, msg_len;
+	char *file_data;
+	doca_error_t result;
+
+	max_comch_msg = comch_utils_get_max_buffer_size(comch_cfg);
+	if (max_comch_msg < sizeof(merkle_msg)) {
+		DOCA_LOG_ERR("Comch message size too small for Merkle metadata. Comch size: %u, metadata size: %lu",
+			     max_comch_msg,
+			     sizeof(merkle_msg));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	merkle_msg.leaf_size = htonl(app_cfg->leaf_size);
+	merkle_msg.file_size = htobe64(file_size);
+	merkle_msg.nb_leaves = htonl(nb_leaves);
+	memcpy(merkle_msg.root, root, MERKLE_HASH_LEN);
+
+	result = send_msg(comch_cfg, &merkle_msg, sizeof(merkle_msg));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to send Merkle metadata message: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (offset = 0; offset < hashes_len; offset += msg_len) {
+		msg_len = MIN(max_comch_msg, hashes_len - offset);
+		result = send_msg(comch_cfg, leaf_hashes + offset, msg_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Leaf hashes were not sent: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	file_data = malloc(max_comch_msg);
+	if (file_data == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for file data message");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (offset = 0; offset < file_size; offset += msg_len) {
+		/* Verify that the other side has not signalled it is done */
+		if (app_cfg->state == TRANSFER_COMPLETE)
+			break;
+
+		msg_len = MIN(max_comch_msg, file_size - offset);
+		if (pread(fd, file_data, msg_len, offset) != (ssize_t)msg_len) {
+			DOCA_LOG_ERR("Failed to read %s", app_cfg->file_path);
+			result = DOCA_ERROR_IO_FAILED;
+			break;
+		}
+
+		result = send_msg(comch_cfg, file_data, msg_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("File data was not sent: %s", doca_error_get_descr(result));
+			break;
+		}
+	}
+
+	free(file_data);
+	return result;
+}
+
+/*
+ * Run client logic in Merkle tree mode
+ *
+ * @comch_cfg [in]: comch configuration object
+ * @app_cfg [in]: app configuration
+ * @state [in]: application core object struct
+ * @sha_ctx [in]: context of SHA library, NULL in SW mode
+ * @fd [in]: file descriptor of the input file
+ * @file_size [in]: file size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t file_integrity_client_merkle(struct comch_cfg *comch_cfg,
+						 struct file_integrity_config *app_cfg,
+						 struct program_core_objects *state,
+						 struct doca_sha *sha_ctx,
+						 int fd,
+						 uint64_t file_size)
+{
+	uint8_t root[MERKLE_HASH_LEN];
+	uint8_t *leaf_hashes;
+	uint64_t nb_leaves;
+	doca_error_t result;
+
+	if (file_size == 0) {
+		DOCA_LOG_ERR("Invalid file size. Should be greater then zero");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	nb_leaves = 1 + ((file_size - 1) / app_cfg->leaf_size);
+	if (nb_leaves > UINT32_MAX) {
+		DOCA_LOG_ERR("File has too many leaves of %u bytes", app_cfg->leaf_size);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	leaf_hashes = malloc(nb_leaves * MERKLE_HASH_LEN);
+	if (leaf_hashes == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %lu leaf hashes", nb_leaves);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = hash_file_leaves(app_cfg, state, sha_ctx, fd, file_size, nb_leaves, leaf_hashes, root);
+	if (result == DOCA_SUCCESS)
+		result = send_file_merkle(comch_cfg, app_cfg, fd, file_size, nb_leaves, leaf_hashes, root);
+
+	free(leaf_hashes);
+	return result;
+}
+
 void client_recv_event_cb(struct doca_comch_event_msg_recv *event,
 			  uint8_t *recv_buffer,
 			  uint32_t msg_len,
@@ -411,6 +698,14 @@ doca_error_t file_integrity_client(struct comch_cfg *comch_cfg,
 		return DOCA_ERROR_IO_FAILED;
 	}
 
+	if (app_cfg->leaf_size != 0) {
+		result = file_integrity_client_merkle(comch_cfg, app_cfg, state, sha_ctx, fd, MAX(statbuf.st_size, 0));
+		close(fd);
+		if (result != DOCA_SUCCESS)
+			return result;
+		goto wait_finish;
+	}
+
 	/* Get the partial block size */
 	result = doca_sha_cap_get_partial_hash_block_size(doca_dev_as_devinfo(state->dev),
 							  SHA_ALGORITHM,
@@ -492,6 +787,7 @@ doca_error_t file_integrity_client(struct comch_cfg *comch_cfg,
 	doca_buf_dec_refcount(dst_doca_buf, NULL);
 	close(fd);
 
+wait_finish:
 	/* Receive finish message when file was completely read by the server */
 	while (app_cfg->state != TRANSFER_COMPLETE) {
 		nanosleep(&ts, &ts);
@@ -505,6 +801,399 @@ doca_error_t file_integrity_client(struct comch_cfg *comch_cfg,
 	return result;
 }
 
+/*
+ * Initiate SHA specific data in the app config
+ *
+ * This data can be accessed by comch callbacks to send data directly to the SHA engine.
+ *
+ * @sha_ctx [in]: doca context to use for SHA offload
+ * @state [in]: core objects configured for SHA offload
+ * @server_data [in]: app global information that can be shared in callbacks
+ * @dst_doca_buf [in]: preallocated buffer to receive SHA output
+ * @max_comch_msg [in]: maximum size message across comch
+ * @fd [in]: file descriptor to write data to
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t init_async_sha_recv_data(struct doca_sha *sha_ctx,
+					     struct program_core_objects *state,
+					     struct server_runtime_data *server_data,
+					     struct doca_buf *dst_doca_buf,
+					     uint32_t max_comch_msg,
+					     int fd)
+{
+	union doca_data task_user_data = {0};
+	union doca_data ctx_user_data = {0};
+	uint32_t received_sha_msg_size;
+	doca_error_t result;
+
+	/* Get size of SHA output */
+	result = doca_sha_cap_get_min_dst_buf_size(doca_dev_as_devinfo(state->dev),
+						   SHA_ALGORITHM,
+						   &received_sha_msg_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get minimum destination buffer size for DOCA SHA: %s",
+			     doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Allocate a buffer to copy the expect SHA to */
+	server_data->expected_sha = calloc(1, received_sha_msg_size);
+	if (server_data->expected_sha == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for received sha");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	/* Allocate buffer to register for SHA and handle incoming messages */
+	server_data->sha_src_data = calloc(1, max_comch_msg);
+	if (server_data->sha_src_data == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for SHA data buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_expected_sha;
+	}
+
+	/* Include the allocated data buffer in the source mmap */
+	result = doca_mmap_set_memrange(state->src_mmap, server_data->sha_src_data, max_comch_msg);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to set memory range of source memory map: %s", doca_error_get_descr(result));
+		goto free_sha_src_buf;
+	}
+
+	result = doca_mmap_start(state->src_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start source memory map: %s", doca_error_get_descr(result));
+		goto free_sha_src_buf;
+	}
+
+	/* Get a doca_buf associated with the data buffer for sending to the SHA engine */
+	result = doca_buf_inventory_buf_get_by_data(state->buf_inv,
+						    state->src_mmap,
+						    server_data->sha_src_data,
+						    max_comch_msg,
+						    &server_data->sha_src_buf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing source buffer: %s",
+			     doca_error_get_descr(result));
+		goto stop_mmap;
+	}
+
+	/* Set the user data of the context to the number of active tasks variable - task completion decrements
+	 * this */
+	server_data->active_sha_tasks = 0;
+	ctx_user_data.ptr = &server_data->active_sha_tasks;
+	result = doca_ctx_set_user_data(state->ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DOCA context user data: %s", doca_error_get_descr(result));
+		goto free_doca_buf;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DOCA context: %s", doca_error_get_descr(result));
+		goto free_doca_buf;
+	}
+
+	/* Allocate a single task for a full SHA offload */
+	result = doca_sha_task_hash_alloc_init(sha_ctx,
+					       SHA_ALGORITHM,
+					       server_data->sha_src_buf,
+					       dst_doca_buf,
+					       task_user_data,
+					       &server_data->sha_hash_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate SHA hash task: %s", doca_error_get_descr(result));
+		goto stop_ctx;
+	}
+
+	/* Allocate a single task for use in partial SHA */
+	result = doca_sha_task_partial_hash_alloc_init(sha_ctx,
+						       SHA_ALGORITHM,
+						       server_data->sha_src_buf,
+						       dst_doca_buf,
+						       task_user_data,
+						       &server_data->sha_partial_hash_task);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate SHA partial hash task: %s", doca_error_get_descr(result));
+		goto free_sha_task;
+	}
+
+	server_data->sha_state = state;
+	server_data->fd = fd;
+
+	return DOCA_SUCCESS;
+
+free_sha_task:
+	doca_task_free(doca_sha_task_hash_as_task(server_data->sha_hash_task));
+stop_ctx:
+	doca_ctx_stop(state->ctx);
+free_doca_buf:
+	doca_buf_dec_refcount(server_data->sha_src_buf, NULL);
+stop_mmap:
+	doca_mmap_stop(state->src_mmap);
+free_sha_src_buf:
+	free(server_data->sha_src_data);
+free_expected_sha:
+	free(server_data->expected_sha);
+
+	return result;
+}
+
+/*
+ * Undo the allocations made in init_async_sha_recv_data()
+ *
+ * @server_data [in]: app global information that can be shared in callbacks
+ */
+static void uninit_async_sha_recv_data(struct server_runtime_data *server_data)
+{
+	/* Note, the SHA context will be stopped in file_integrity_cleanup() */
+	doca_task_free(doca_sha_task_partial_hash_as_task(server_data->sha_partial_hash_task));
+	doca_task_free(doca_sha_task_hash_as_task(server_data->sha_hash_task));
+	doca_buf_dec_refcount(server_data->sha_src_buf, NULL);
+	doca_mmap_stop(server_data->sha_state->src_mmap);
+	free(server_data->sha_src_data);
+	server_data->sha_src_data = NULL;
+	free(server_data->expected_sha);
+	server_data->expected_sha = NULL;
+
+	server_data->sha_state = NULL;
+	server_data->fd = 0;
+}
+
+/*
+ * Set up the server for a file sent in Merkle tree mode
+ *
+ * @cfg [in]: app configuration
+ * @merkle_msg [in]: Merkle metadata message
+ * @msg_len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t server_init_merkle(struct file_integrity_config *cfg,
+				       const struct file_integrity_merkle_msg *merkle_msg,
+				       uint32_t msg_len)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
+	doca_error_t result;
+
+	if (msg_len < sizeof(struct file_integrity_merkle_msg)) {
+		DOCA_LOG_ERR("Unexpected Merkle metadata message received. Size %u, expected size %lu",
+			     msg_len,
+			     sizeof(struct file_integrity_merkle_msg));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	server_data->leaf_size = ntohl(merkle_msg->leaf_size);
+	server_data->file_size = be64toh(merkle_msg->file_size);
+	server_data->nb_leaves = ntohl(merkle_msg->nb_leaves);
+	if (server_data->leaf_size == 0 || server_data->leaf_size > MAX_LEAF_SIZE_KB * 1024 ||
+	    server_data->file_size == 0 ||
+	    server_data->nb_leaves != 1 + ((server_data->file_size - 1) / server_data->leaf_size)) {
+		DOCA_LOG_ERR("Invalid Merkle metadata: leaf size %u, file size %lu, %u leaves",
+			     server_data->leaf_size,
+			     server_data->file_size,
+			     server_data->nb_leaves);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	memcpy(server_data->root, merkle_msg->root, MERKLE_HASH_LEN);
+
+	server_data->leaf_hashes = malloc((size_t)server_data->nb_leaves * MERKLE_HASH_LEN);
+	if (server_data->leaf_hashes == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u leaf hashes", server_data->nb_leaves);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = leaf_hasher_create(cfg->hash_mode,
+				    server_data->sha_state,
+				    server_data->sha_ctx,
+				    server_data->leaf_size,
+				    cfg->hash_window,
+				    get_nb_hash_threads(cfg),
+				    &server_data->hasher);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create leaf hasher: %s", doca_error_get_descr(result));
+		free(server_data->leaf_hashes);
+		server_data->leaf_hashes = NULL;
+		return result;
+	}
+
+	DOCA_LOG_INFO("Receiving %lu bytes in %u leaves of %u bytes, hashing leaves in %s mode",
+		      server_data->file_size,
+		      server_data->nb_leaves,
+		      server_data->leaf_size,
+		      leaf_hash_mode_name(cfg->hash_mode));
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Set up the server for the transfer described by the first message of the client
+ *
+ * @cfg [in]: app configuration
+ * @recv_buffer [in]: array of bytes containing the metadata message
+ * @msg_len [in]: number of bytes in the recv_buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t server_handle_metadata(struct file_integrity_config *cfg, uint8_t *recv_buffer, uint32_t msg_len)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
+	struct file_integrity_metadata_msg *file_meta = (struct file_integrity_metadata_msg *)recv_buffer;
+	doca_error_t result;
+
+	if (msg_len < sizeof(struct file_integrity_metadata_msg)) {
+		DOCA_LOG_ERR("Unexpected file metadata message received. Size %u, min expected size %lu",
+			     msg_len,
+			     sizeof(struct file_integrity_metadata_msg));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	/* A file is never sent in zero chunks, so this marks a Merkle metadata message */
+	if (ntohl(file_meta->total_file_chunks) == 0)
+		return server_init_merkle(cfg, (struct file_integrity_merkle_msg *)recv_buffer, msg_len);
+
+	if (server_data->sha_ctx == NULL) {
+		DOCA_LOG_ERR("Receiving a file with a single SHA requires a DOCA device with SHA capabilities");
+		return DOCA_ERROR_NOT_SUPPORTED;
+	}
+
+	result = populate_dst_buf(server_data->sha_state, &server_data->dst_doca_buf);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = init_async_sha_recv_data(server_data->sha_ctx,
+					  server_data->sha_state,
+					  server_data,
+					  server_data->dst_doca_buf,
+					  server_data->max_comch_msg,
+					  server_data->fd);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init async data: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	server_data->expected_sha_len = msg_len - (sizeof(struct file_integrity_metadata_msg));
+	memcpy(server_data->expected_sha, file_meta->sha_data, server_data->expected_sha_len);
+	server_data->expected_file_chunks = ntohl(file_meta->total_file_chunks);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Hash the leaves assembled in the hasher window, compare them with the leaf hashes sent by the client and write
+ * them to the file
+ *
+ * @server_data [in]: server runtime data
+ * @nb_slots [in]: number of leaves in the window
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t server_verify_leaves(struct server_runtime_data *server_data, uint32_t nb_slots)
+{
+	struct leaf_slot *slot;
+	uint64_t start;
+	uint32_t i, leaf;
+	doca_error_t result;
+
+	start = get_time_ns();
+	result = leaf_hasher_run(server_data->hasher, nb_slots);
+	server_data->hash_ns += get_time_ns() - start;
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to hash leaves: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < nb_slots; i++) {
+		slot = leaf_hasher_get_slot(server_data->hasher, i);
+		leaf = server_data->nb_verified_leaves + i;
+		if (memcmp(slot->hash, server_data->leaf_hashes + (size_t)leaf * MERKLE_HASH_LEN, MERKLE_HASH_LEN) !=
+		    0) {
+			DOCA_LOG_ERR("ERROR: SHA of leaf %u is not identical, file was compromised", leaf);
+			return DOCA_ERROR_BAD_STATE;
+		}
+
+		if ((size_t)write(server_data->fd, slot->data, slot->len) != slot->len) {
+			DOCA_LOG_ERR("Failed to write leaf %u into the input file", leaf);
+			return DOCA_ERROR_IO_FAILED;
+		}
+	}
+
+	server_data->nb_verified_leaves += nb_slots;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Handle a message of a file sent in Merkle tree mode.
+ * The leaf hashes are checked against the Merkle root once all of them are received. The file data that follows is
+ * assembled into leaves in the hasher window, and every full window is verified as it arrives.
+ *
+ * @cfg [in]: app configuration
+ * @data [in]: message data
+ * @len [in]: message length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t server_handle_merkle_data(struct file_integrity_config *cfg, uint8_t *data, uint32_t len)
+{
+	struct server_runtime_data *server_data = &cfg->server_data;
+	uint64_t hashes_len = (uint64_t)server_data->nb_leaves * MERKLE_HASH_LEN;
+	uint8_t root[MERKLE_HASH_LEN];
+	struct leaf_slot *slot;
+	uint64_t window_offset;
+	uint32_t copy_len, slot_idx, leaf, leaf_offset, leaf_len;
+	doca_error_t result;
+
+	/* The leaf hashes precede the file data */
+	if (server_data->received_hash_len < hashes_len) {
+		copy_len = MIN(len, hashes_len - server_data->received_hash_len);
+		memcpy(server_data->leaf_hashes + server_data->received_hash_len, data, copy_len);
+		server_data->received_hash_len += copy_len;
+		data += copy_len;
+		len -= copy_len;
+
+		if (server_data->received_hash_len == hashes_len) {
+			result = merkle_compute_root(server_data->leaf_hashes, server_data->nb_leaves, root);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to compute Merkle root: %s", doca_error_get_descr(result));
+				return result;
+			}
+			log_merkle_root(root);
+			if (memcmp(root, server_data->root, MERKLE_HASH_LEN) != 0) {
+				DOCA_LOG_ERR("ERROR: leaf hashes do not match the Merkle root, file was compromised");
+				return DOCA_ERROR_BAD_STATE;
+			}
+		}
+	}
+
+	while (len > 0) {
+		if (server_data->received_data_len + len > server_data->file_size) {
+			DOCA_LOG_ERR("Received more file data than the expected %lu bytes", server_data->file_size);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+
+		/* Leaves are assembled in the hasher window, which is flushed when full or at the last leaf */
+		window_offset = server_data->received_data_len -
+				(uint64_t)server_data->nb_verified_leaves * server_data->leaf_size;
+		slot_idx = window_offset / server_data->leaf_size;
+		leaf_offset = window_offset % server_data->leaf_size;
+		leaf = server_data->nb_verified_leaves + slot_idx;
+		leaf_len = MIN(server_data->leaf_size,
+			       server_data->file_size - (uint64_t)leaf * server_data->leaf_size);
+
+		slot = leaf_hasher_get_slot(server_data->hasher, slot_idx);
+		copy_len = MIN(len, leaf_len - leaf_offset);
+		memcpy(slot->data + leaf_offset, data, copy_len);
+		server_data->received_data_len += copy_len;
+		data += copy_len;
+		len -= copy_len;
+
+		if (leaf_offset + copy_len < leaf_len)
+			continue;
+
+		slot->len = leaf_len;
+		if (slot_idx + 1 == cfg->hash_window || leaf + 1 == server_data->nb_leaves) {
+			result = server_verify_leaves(server_data, slot_idx + 1);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
 void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
 			  uint8_t *recv_buffer,
 			  uint32_t msg_len,
@@ -530,25 +1219,22 @@ void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
 	if (cfg->state == TRANSFER_COMPLETE || cfg->state == TRANSFER_ERROR)
 		return;
 
-	server_data = &cfg->server_data;
-
-	/* First received message should contain file metadata */
-	if (server_data->expected_file_chunks == 0) {
-		struct file_integrity_metadata_msg *file_meta = (struct file_integrity_metadata_msg *)recv_buffer;
-
-		if (msg_len < sizeof(struct file_integrity_metadata_msg)) {
-			DOCA_LOG_ERR("Unexpected file metadata message received. Size %u, min expected size %lu",
-				     msg_len,
-				     sizeof(struct file_integrity_metadata_msg));
-			cfg->state = TRANSFER_ERROR;
-			return;
-		}
+	server_data = &cfg->server_data;
+	server_data->nb_received_msgs++;
 
-		server_data->expected_file_chunks = ntohl(file_meta->total_file_chunks);
-		server_data->expected_sha_len = msg_len - (sizeof(struct file_integrity_metadata_msg));
-		memcpy(server_data->expected_sha, file_meta->sha_data, server_data->expected_sha_len);
+	/* First received message should contain file metadata */
+	if (cfg->state == TRANSFER_IDLE) {
+		result = server_handle_metadata(cfg, recv_buffer, msg_len);
+		cfg->state = (result == DOCA_SUCCESS) ? TRANSFER_IN_PROGRESS : TRANSFER_ERROR;
+		return;
+	}
 
-		cfg->state = TRANSFER_IN_PROGRESS;
+	if (server_data->hasher != NULL) {
+		result = server_handle_merkle_data(cfg, recv_buffer, msg_len);
+		if (result != DOCA_SUCCESS)
+			cfg->state = TRANSFER_ERROR;
+		else if (server_data->nb_verified_leaves == server_data->nb_leaves)
+			cfg->state = TRANSFER_COMPLETE;
 		return;
 	}
 
@@ -639,170 +1325,13 @@ void server_recv_event_cb(struct doca_comch_event_msg_recv *event,
 		cfg->state = TRANSFER_COMPLETE;
 }
 
-/*
- * Initiate SHA specific data in the app config
- *
- * This data can be accessed by comch callbacks to send data directly to the SHA engine.
- *
- * @sha_ctx [in]: doca context to use for SHA offload
- * @state [in]: core objects configured for SHA offload
- * @server_data [in]: app global information that can be shared in callbacks
- * @dst_doca_buf [in]: preallocated buffer to receive SHA output
- * @max_comch_msg [in]: maximum size message across comch
- * @fd [in]: file descriptor to write data to
- * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
- */
-static doca_error_t init_async_sha_recv_data(struct doca_sha *sha_ctx,
-					     struct program_core_objects *state,
-					     struct server_runtime_data *server_data,
-					     struct doca_buf *dst_doca_buf,
-					     uint32_t max_comch_msg,
-					     int fd)
-{
-	union doca_data task_user_data = {0};
-	union doca_data ctx_user_data = {0};
-	uint32_t received_sha_msg_size;
-	doca_error_t result;
-
-	/* Get size of SHA output */
-	result = doca_sha_cap_get_min_dst_buf_size(doca_dev_as_devinfo(state->dev),
-						   SHA_ALGORITHM,
-						   &received_sha_msg_size);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to get minimum destination buffer size for DOCA SHA: %s",
-			     doca_error_get_descr(result));
-		return result;
-	}
-
-	/* Allocate a buffer to copy the expect SHA to */
-	server_data->expected_sha = calloc(1, received_sha_msg_size);
-	if (server_data->expected_sha == NULL) {
-		DOCA_LOG_ERR("Failed to allocate memory for received sha");
-		return DOCA_ERROR_NO_MEMORY;
-	}
-
-	/* Allocate buffer to register for SHA and handle incoming messages */
-	server_data->sha_src_data = calloc(1, max_comch_msg);
-	if (server_data->sha_src_data == NULL) {
-		DOCA_LOG_ERR("Failed to allocate memory for SHA data buffer");
-		result = DOCA_ERROR_NO_MEMORY;
-		goto free_expected_sha;
-	}
-
-	/* Include the allocated data buffer in the source mmap */
-	result = doca_mmap_set_memrange(state->src_mmap, server_data->sha_src_data, max_comch_msg);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to set memory range of source memory map: %s", doca_error_get_descr(result));
-		goto free_sha_src_buf;
-	}
-
-	result = doca_mmap_start(state->src_mmap);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to start source memory map: %s", doca_error_get_descr(result));
-		goto free_sha_src_buf;
-	}
-
-	/* Get a doca_buf associated with the data buffer for sending to the SHA engine */
-	result = doca_buf_inventory_buf_get_by_data(state->buf_inv,
-						    state->src_mmap,
-						    server_data->sha_src_data,
-						    max_comch_msg,
-						    &server_data->sha_src_buf);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Unable to acquire DOCA buffer representing source buffer: %s",
-			     doca_error_get_descr(result));
-		goto stop_mmap;
-	}
-
-	/* Set the user data of the context to the number of active tasks variable - task completion decrements
-	 * this */
-	server_data->active_sha_tasks = 0;
-	ctx_user_data.ptr = &server_data->active_sha_tasks;
-	result = doca_ctx_set_user_data(state->ctx, ctx_user_data);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to set DOCA context user data: %s", doca_error_get_descr(result));
-		goto free_doca_buf;
-	}
-
-	result = doca_ctx_start(state->ctx);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to start DOCA context: %s", doca_error_get_descr(result));
-		goto free_doca_buf;
-	}
-
-	/* Allocate a single task for a full SHA offload */
-	result = doca_sha_task_hash_alloc_init(sha_ctx,
-					       SHA_ALGORITHM,
-					       server_data->sha_src_buf,
-					       dst_doca_buf,
-					       task_user_data,
-					       &server_data->sha_hash_task);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate SHA hash task: %s", doca_error_get_descr(result));
-		goto stop_ctx;
-	}
-
-	/* Allocate a single task for use in partial SHA */
-	result = doca_sha_task_partial_hash_alloc_init(sha_ctx,
-						       SHA_ALGORITHM,
-						       server_data->sha_src_buf,
-						       dst_doca_buf,
-						       task_user_data,
-						       &server_data->sha_partial_hash_task);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to allocate SHA partial hash task: %s", doca_error_get_descr(result));
-		goto free_sha_task;
-	}
-
-	server_data->sha_state = state;
-	server_data->fd = fd;
-
-	return DOCA_SUCCESS;
-
-free_sha_task:
-	doca_task_free(doca_sha_task_hash_as_task(server_data->sha_hash_task));
-stop_ctx:
-	doca_ctx_stop(state->ctx);
-free_doca_buf:
-	doca_buf_dec_refcount(server_data->sha_src_buf, NULL);
-stop_mmap:
-	doca_mmap_stop(state->src_mmap);
-free_sha_src_buf:
-	free(server_data->sha_src_data);
-free_expected_sha:
-	free(server_data->expected_sha);
-
-	return result;
-}
-
-/*
- * Undo the allocations made in init_async_sha_recv_data()
- *
- * @server_data [in]: app global information that can be shared in callbacks
- */
-static void uninit_async_sha_recv_data(struct server_runtime_data *server_data)
-{
-	/* Note, the SHA context will be stopped in file_integrity_cleanup() */
-	doca_task_free(doca_sha_task_partial_hash_as_task(server_data->sha_partial_hash_task));
-	doca_task_free(doca_sha_task_hash_as_task(server_data->sha_hash_task));
-	doca_buf_dec_refcount(server_data->sha_src_buf, NULL);
-	doca_mmap_stop(server_data->sha_state->src_mmap);
-	free(server_data->sha_src_data);
-	server_data->sha_src_data = NULL;
-	free(server_data->expected_sha);
-	server_data->expected_sha = NULL;
-
-	server_data->sha_state = NULL;
-	server_data->fd = 0;
-}
-
 doca_error_t file_integrity_server(struct comch_cfg *comch_cfg,
 				   struct file_integrity_config *app_cfg,
 				   struct program_core_objects *state,
 				   struct doca_sha *sha_ctx)
 {
-	struct doca_buf *dst_doca_buf = NULL;
-	uint32_t i, max_comch_msg;
+	struct server_runtime_data *server_data = &app_cfg->server_data;
+	uint32_t i, nb_received_msgs = 0;
 	size_t hash_length;
 	char *sha_output;
 	int fd;
@@ -815,23 +1344,18 @@ doca_error_t file_integrity_server(struct comch_cfg *comch_cfg,
 	};
 	doca_error_t result;
 
-	result = populate_dst_buf(state, &dst_doca_buf);
-	if (result != DOCA_SUCCESS)
-		goto finish_msg;
-
 	fd = open(app_cfg->file_path, O_CREAT | O_WRONLY, S_IRUSR | S_IRGRP);
 	if (fd < 0) {
 		DOCA_LOG_ERR("Failed to open %s", app_cfg->file_path);
 		result = DOCA_ERROR_IO_FAILED;
-		goto free_dst_buf;
+		goto finish_msg;
 	}
 
-	max_comch_msg = comch_utils_get_max_buffer_size(comch_cfg);
-	result = init_async_sha_recv_data(sha_ctx, state, &app_cfg->server_data, dst_doca_buf, max_comch_msg, fd);
-	if (result != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to init async data: %s", doca_error_get_descr(result));
-		goto close_fd;
-	}
+	/* The SHA resources are set up once the first message tells which mode the client uses */
+	server_data->sha_state = state;
+	server_data->sha_ctx = sha_ctx;
+	server_data->fd = fd;
+	server_data->max_comch_msg = comch_utils_get_max_buffer_size(comch_cfg);
 
 	/* Wait on comch to complete client to server transactions */
 	while (app_cfg->state != TRANSFER_COMPLETE && app_cfg->state != TRANSFER_ERROR) {
@@ -839,43 +1363,58 @@ doca_error_t file_integrity_server(struct comch_cfg *comch_cfg,
 		result = comch_utils_progress_connection(comch_util_get_connection(comch_cfg));
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Comch connection unexpectedly dropped: %s", doca_error_get_descr(result));
-			goto uninit_async;
+			goto cleanup;
 		}
 
 		if (app_cfg->state == TRANSFER_IDLE)
 			continue;
 
+		/* The timeout is measured from the last received message */
+		if (server_data->nb_received_msgs != nb_received_msgs) {
+			nb_received_msgs = server_data->nb_received_msgs;
+			counter = 0;
+			continue;
+		}
+
 		counter++;
 		if (counter == num_of_iterations) {
 			DOCA_LOG_ERR("Message was not received at the given timeout");
 			result = DOCA_ERROR_BAD_STATE;
-			goto uninit_async;
+			goto cleanup;
 		}
 	}
 
 	if (app_cfg->state == TRANSFER_ERROR) {
 		DOCA_LOG_ERR("Error detected during comch exchange");
 		result = DOCA_ERROR_BAD_STATE;
-		goto uninit_async;
+		goto cleanup;
+	}
+
+	if (server_data->hasher != NULL) {
+		log_hash_rate(app_cfg->hash_mode, server_data->file_size, server_data->hash_ns);
+		DOCA_LOG_INFO("SUCCESS: all %u leaves are identical to the received Merkle tree",
+			      server_data->nb_leaves);
+		result = DOCA_SUCCESS;
+		goto cleanup;
 	}
 
 	/* compare received SHA with calculated SHA */
-	result = doca_buf_get_data_len(dst_doca_buf, &hash_length);
+	result = doca_buf_get_data_len(server_data->dst_doca_buf, &hash_length);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to get the data length of DOCA buffer: %s", doca_error_get_descr(result));
-		goto uninit_async;
+		goto cleanup;
 	}
 
 	if (hash_length == 0) {
 		DOCA_LOG_ERR("Error in calculating SHA - output length is 0");
 		result = DOCA_ERROR_INVALID_VALUE;
-		goto uninit_async;
+		goto cleanup;
 	}
 
-	result = doca_buf_get_data(dst_doca_buf, (void **)&file_sha);
+	result = doca_buf_get_data(server_data->dst_doca_buf, (void **)&file_sha);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to get the data of DOCA buffer: %s", doca_error_get_descr(result));
-		goto uninit_async;
+		goto cleanup;
 	}
 
 	/* Engine outputs hex format. For char format output, we need double the length */
@@ -883,7 +1422,7 @@ doca_error_t file_integrity_server(struct comch_cfg *comch_cfg,
 	if (sha_output == NULL) {
 		DOCA_LOG_ERR("Failed to allocate memory to display SHA");
 		result = DOCA_ERROR_NO_MEMORY;
-		goto uninit_async;
+		goto cleanup;
 	}
 
 	for (i = 0; i < hash_length; i++)
@@ -900,12 +1439,24 @@ doca_error_t file_integrity_server(struct comch_cfg *comch_cfg,
 			DOCA_LOG_ERR("Failed to remove %s", app_cfg->file_path);
 	}
 
-uninit_async:
-	uninit_async_sha_recv_data(&app_cfg->server_data);
-close_fd:
+cleanup:
+	if (server_data->hasher != NULL) {
+		leaf_hasher_destroy(server_data->hasher);
+		server_data->hasher = NULL;
+		free(server_data->leaf_hashes);
+		server_data->leaf_hashes = NULL;
+		/* Leaves are written as they are verified, so a failed transfer leaves a partial file behind */
+		if (result != DOCA_SUCCESS && remove(app_cfg->file_path) < 0)
+			DOCA_LOG_ERR("Failed to remove %s", app_cfg->file_path);
+	}
+	/* The async SHA data is only set up once a single SHA metadata message is handled */
+	if (server_data->expected_file_chunks != 0)
+		uninit_async_sha_recv_data(server_data);
+	if (server_data->dst_doca_buf != NULL) {
+		doca_buf_dec_refcount(server_data->dst_doca_buf, NULL);
+		server_data->dst_doca_buf = NULL;
+	}
 	close(fd);
-free_dst_buf:
-	doca_buf_dec_refcount(dst_doca_buf, NULL);
 finish_msg:
 	if (comch_utils_send(comch_util_get_connection(comch_cfg), finish_msg, sizeof(finish_msg)) != DOCA_SUCCESS)
 		DOCA_LOG_ERR("Failed to send finish message: %s", doca_error_get_descr(result));
@@ -1014,19 +1565,40 @@ doca_error_t file_integrity_init(struct file_integrity_config *app_cfg,
 				 struct program_core_objects *state,
 				 struct doca_sha **sha_ctx)
 {
-	uint32_t max_bufs = 2; /* The app will use 2 doca buffers */
+	uint32_t max_bufs;
+	bool merkle_capable;
 	doca_error_t result;
 
 	/* set default timeout */
 	if (app_cfg->timeout == 0)
 		app_cfg->timeout = DEFAULT_TIMEOUT;
 
+	/* set Merkle mode defaults */
+	if (app_cfg->hash_window == 0)
+		app_cfg->hash_window = DEFAULT_HASH_WINDOW;
+	/* The source and destination buffers of every leaf hashed concurrently */
+	max_bufs = 2 * app_cfg->hash_window;
+
+	/* Merkle transfers, which the server always accepts, can be hashed without a device */
+	merkle_capable = (app_cfg->mode == SERVER || app_cfg->leaf_size != 0);
+	if (merkle_capable && app_cfg->hash_mode == LEAF_HASH_SW) {
+		DOCA_LOG_INFO("Leaves are hashed in SW, no DOCA SHA device is used");
+		return DOCA_SUCCESS;
+	}
+
 	/* Open device for partial SHA tasks */
 	result = open_doca_device_with_capabilities(&sha_partial_hash_is_supported, &state->dev);
 	if (result != DOCA_SUCCESS) {
+		if (merkle_capable && app_cfg->hash_mode == LEAF_HASH_AUTO) {
+			DOCA_LOG_WARN("No DOCA device with SHA capabilities, leaves are hashed in SW");
+			app_cfg->hash_mode = LEAF_HASH_SW;
+			return DOCA_SUCCESS;
+		}
 		DOCA_LOG_ERR("Failed to init DOCA device with SHA capabilities: %s", doca_error_get_descr(result));
 		return result;
 	}
+	if (app_cfg->hash_mode == LEAF_HASH_AUTO)
+		app_cfg->hash_mode = LEAF_HASH_HW;
 
 	result = doca_sha_create(state->dev, sha_ctx);
 	if (result != DOCA_SUCCESS) {
@@ -1055,7 +1627,7 @@ doca_error_t file_integrity_init(struct file_integrity_config *app_cfg,
 		result = doca_sha_task_hash_set_conf(*sha_ctx,
 						     sha_hash_completed_callback,
 						     sha_hash_error_callback,
-						     LOG_NUM_SHA_TASKS);
+						     app_cfg->hash_window);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to set configuration for SHA hash task: %s", doca_error_get_descr(result));
 			goto destroy_sha;
@@ -1065,7 +1637,7 @@ doca_error_t file_integrity_init(struct file_integrity_config *app_cfg,
 		result = doca_sha_task_hash_set_conf(*sha_ctx,
 						     sha_hash_completed_callback,
 						     sha_hash_error_callback,
-						     LOG_NUM_SHA_TASKS);
+						     app_cfg->hash_window);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to set configuration for SHA hash task: %s", doca_error_get_descr(result));
 			goto destroy_sha;
@@ -1202,6 +1774,71 @@ static doca_error_t timeout_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle leaf size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t leaf_size_callback(void *param, void *config)
+{
+	struct file_integrity_config *app_cfg = (struct file_integrity_config *)config;
+	int *leaf_size_kb = (int *)param;
+
+	if (*leaf_size_kb < 0 || *leaf_size_kb > MAX_LEAF_SIZE_KB) {
+		DOCA_LOG_ERR("Leaf size must be between 0 and %d KB", MAX_LEAF_SIZE_KB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	app_cfg->leaf_size = *leaf_size_kb * 1024;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle hash window parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hash_window_callback(void *param, void *config)
+{
+	struct file_integrity_config *app_cfg = (struct file_integrity_config *)config;
+	int *hash_window = (int *)param;
+
+	if (*hash_window <= 0 || *hash_window > MAX_HASH_WINDOW) {
+		DOCA_LOG_ERR("Hash window must be between 1 and %d", MAX_HASH_WINDOW);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	app_cfg->hash_window = *hash_window;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle hash mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hash_mode_callback(void *param, void *config)
+{
+	struct file_integrity_config *app_cfg = (struct file_integrity_config *)config;
+	char *hash_mode = (char *)param;
+
+	if (strcasecmp(hash_mode, "hw") == 0)
+		app_cfg->hash_mode = LEAF_HASH_HW;
+	else if (strcasecmp(hash_mode, "sw") == 0)
+		app_cfg->hash_mode = LEAF_HASH_SW;
+	else if (strcasecmp(hash_mode, "mixed") == 0)
+		app_cfg->hash_mode = LEAF_HASH_MIXED;
+	else {
+		DOCA_LOG_ERR("Illegal hash mode = [%s], expected hw, sw or mixed", hash_mode);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
 /*
  * ARGP validation Callback - check if the running mode is valid and that the input file exists in client mode
  *
@@ -1227,6 +1864,7 @@ doca_error_t register_file_integrity_params(void)
 	doca_error_t result;
 
 	struct doca_argp_param *dev_pci_addr_param, *rep_pci_addr_param, *file_param, *timeout_param;
+	struct doca_argp_param *leaf_size_param, *hash_window_param, *hash_mode_param;
 
 	/* Create and register DOCA Comch device PCI address */
 	result = doca_argp_param_create(&dev_pci_addr_param);
@@ -1299,6 +1937,59 @@ doca_error_t register_file_integrity_params(void)
 		return result;
 	}
 
+	/* Create and register leaf size param */
+	result = doca_argp_param_create(&leaf_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(leaf_size_param, "leaf-size");
+	doca_argp_param_set_description(
+		leaf_size_param,
+		"Client only - send the file as a Merkle tree with leaves of this size in KB, default is 0 (single file SHA)");
+	doca_argp_param_set_callback(leaf_size_param, leaf_size_callback);
+	doca_argp_param_set_type(leaf_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(leaf_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register hash window param */
+	result = doca_argp_param_create(&hash_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(hash_window_param, "hash-window");
+	doca_argp_param_set_description(hash_window_param,
+					"Number of Merkle leaves hashed concurrently, default is 16");
+	doca_argp_param_set_callback(hash_window_param, hash_window_callback);
+	doca_argp_param_set_type(hash_window_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(hash_window_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register hash mode param */
+	result = doca_argp_param_create(&hash_mode_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(hash_mode_param, "hash-mode");
+	doca_argp_param_set_description(
+		hash_mode_param,
+		"Engine hashing Merkle leaves: hw, sw or mixed, default is hw when a SHA device is present and sw otherwise");
+	doca_argp_param_set_callback(hash_mode_param, hash_mode_callback);
+	doca_argp_param_set_type(hash_mode_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(hash_mode_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	/* Register version callback for DOCA SDK & RUNTIME */
 	result = doca_argp_register_version_callback(sdk_version_callback);
 	if (result != DOCA_SUCCESS) {
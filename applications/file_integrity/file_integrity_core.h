@@ -32,6 +32,7 @@
 #include <doca_sha.h>
 
 #include "comch_utils.h"
+#include "file_integrity_merkle.h"
 
 #include <samples/common.h>
 
@@ -68,6 +69,22 @@ struct server_runtime_data {
 	struct program_core_objects *sha_state;			  /* Core state of SHA context */
 	size_t active_sha_tasks;				  /* Variable indicating number of active tasks */
 	int fd;							  /* File descriptor for writing data to */
+	struct doca_sha *sha_ctx;				  /* SHA context, NULL when running without a device */
+	struct doca_buf *dst_doca_buf;				  /* Doca_buf receiving the SHA output */
+	uint32_t max_comch_msg;					  /* Maximum size of a comch message */
+	uint32_t nb_received_msgs;				  /* Number of messages received, for the timeout */
+
+	/* Merkle tree data */
+	struct leaf_hasher *hasher;    /* Leaf hasher, NULL in single SHA mode */
+	uint32_t leaf_size;	       /* Size of a leaf */
+	uint32_t nb_leaves;	       /* Number of leaves of the file */
+	uint64_t file_size;	       /* Expected file size */
+	uint8_t root[MERKLE_HASH_LEN]; /* Expected Merkle root */
+	uint8_t *leaf_hashes;	       /* Leaf hashes received from the client */
+	uint64_t received_hash_len;    /* Length of leaf hashes received */
+	uint64_t received_data_len;    /* Length of file data received */
+	uint32_t nb_verified_leaves;   /* Number of leaves verified and written to the file */
+	uint64_t hash_ns;	       /* Time spent hashing leaves */
 };
 
 struct file_integrity_metadata_msg {
@@ -75,6 +92,15 @@ struct file_integrity_metadata_msg {
 	uint8_t sha_data[];	    /* Expected SHA of transferred file */
 };
 
+/* Metadata of a file sent in Merkle tree mode, fields are in network byte order */
+struct file_integrity_merkle_msg {
+	uint32_t total_file_chunks;    /* Always 0, distinguishes the message from file_integrity_metadata_msg */
+	uint32_t leaf_size;	       /* Size of a leaf */
+	uint64_t file_size;	       /* Size of the file */
+	uint32_t nb_leaves;	       /* Number of leaves, and of leaf hashes following this message */
+	uint8_t root[MERKLE_HASH_LEN]; /* Merkle root of the file */
+} __attribute__((packed));
+
 /* File integrity configuration struct */
 struct file_integrity_config {
 	enum file_integrity_mode mode;				  /* Mode of operation */
@@ -82,6 +108,9 @@ struct file_integrity_config {
 	char cc_dev_pci_addr[DOCA_DEVINFO_PCI_ADDR_SIZE];	  /* Comm Channel DOCA device PCI address */
 	char cc_dev_rep_pci_addr[DOCA_DEVINFO_REP_PCI_ADDR_SIZE]; /* Comm Channel DOCA device representor PCI address */
 	int timeout;						  /* Application timeout in seconds */
+	uint32_t leaf_size;					  /* Merkle leaf size, 0 for a single SHA (client) */
+	uint32_t hash_window;					  /* Number of leaves hashed concurrently */
+	enum leaf_hash_mode hash_mode;				  /* Engine hashing the leaves */
 	struct server_runtime_data server_data; /* Data populated on server side during file transmission */
 	enum transfer_state state;		/* Indicator of completion of a file transfer */
 };
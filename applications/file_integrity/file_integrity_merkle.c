@@ -0,0 +1,560 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <openssl/evp.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "file_integrity_merkle.h"
+
+#define HASHER_SLEEP_IN_NANOS (1 * 1000) /* Sleep between PE polls that found no completion */
+
+DOCA_LOG_REGISTER(FILE_INTEGRITY::Merkle);
+
+struct leaf_hasher {
+	enum leaf_hash_mode mode;	    /* Leaf hash mode */
+	struct program_core_objects *state; /* Core objects of the SHA context, NULL in SW mode */
+	struct doca_sha *sha_ctx;	    /* SHA context, NULL in SW mode */
+	uint32_t window;		    /* Number of slots */
+	uint32_t leaf_size;		    /* Size of the data buffer of a slot */
+	uint32_t dst_len;		    /* Size of the digest buffer of a slot, HW only */
+	uint8_t *src_region;		    /* Data buffers of all slots */
+	uint8_t *dst_region;		    /* Digest buffers of all slots, HW only */
+	struct leaf_slot *slots;	    /* Window slots */
+	size_t nb_hw_inflight;		    /* Number of SHA tasks in flight, decremented by the task callbacks */
+
+	/* SW thread pool */
+	pthread_t *threads;	  /* Worker threads */
+	uint32_t nb_threads;	  /* Number of started worker threads */
+	pthread_mutex_t lock;	  /* Protects the job counters below */
+	pthread_cond_t work_cond; /* Signaled when jobs are posted or on stop */
+	pthread_cond_t done_cond; /* Signaled when the last posted job is done */
+	uint32_t nb_jobs;	  /* Number of posted jobs */
+	uint32_t next_job;	  /* Next job to pick, by a worker thread or by the HW submit loop */
+	uint32_t nb_done_jobs;	  /* Number of completed jobs */
+	bool stop;		  /* Set to stop the worker threads */
+};
+
+const char *leaf_hash_mode_name(enum leaf_hash_mode mode)
+{
+	switch (mode) {
+	case LEAF_HASH_HW:
+		return "HW";
+	case LEAF_HASH_SW:
+		return "SW";
+	case LEAF_HASH_MIXED:
+		return "mixed";
+	default:
+		return "auto";
+	}
+}
+
+/*
+ * Mark a job as done, waking up the waiter when it is the last one
+ *
+ * @hasher [in]: leaf hasher
+ */
+static void job_done(struct leaf_hasher *hasher)
+{
+	pthread_mutex_lock(&hasher->lock);
+	if (++hasher->nb_done_jobs == hasher->nb_jobs)
+		pthread_cond_signal(&hasher->done_cond);
+	pthread_mutex_unlock(&hasher->lock);
+}
+
+/*
+ * Take the next job of the window
+ *
+ * @hasher [in]: leaf hasher
+ * @job [out]: index of the slot to hash
+ * @return: true if a job was taken and false if all jobs were taken
+ */
+static bool take_job(struct leaf_hasher *hasher, uint32_t *job)
+{
+	bool taken;
+
+	pthread_mutex_lock(&hasher->lock);
+	taken = hasher->next_job < hasher->nb_jobs;
+	if (taken)
+		*job = hasher->next_job++;
+	pthread_mutex_unlock(&hasher->lock);
+	return taken;
+}
+
+/*
+ * SW worker thread - picks slots posted by leaf_hasher_run() and hashes them with the host SHA256, which uses the
+ * SHA extensions of the CPU when available
+ *
+ * @arg [in]: the leaf hasher
+ * @return: NULL
+ */
+static void *sw_worker(void *arg)
+{
+	struct leaf_hasher *hasher = (struct leaf_hasher *)arg;
+	struct leaf_slot *slot;
+
+	pthread_mutex_lock(&hasher->lock);
+	while (true) {
+		while (!hasher->stop && hasher->next_job == hasher->nb_jobs)
+			pthread_cond_wait(&hasher->work_cond, &hasher->lock);
+		if (hasher->stop)
+			break;
+		slot = &hasher->slots[hasher->next_job++];
+		pthread_mutex_unlock(&hasher->lock);
+
+		if (EVP_Digest(slot->data, slot->len, slot->hash, NULL, EVP_sha256(), NULL) == 1)
+			slot->status = DOCA_SUCCESS;
+		else
+			slot->status = DOCA_ERROR_BAD_STATE;
+
+		pthread_mutex_lock(&hasher->lock);
+		if (++hasher->nb_done_jobs == hasher->nb_jobs)
+			pthread_cond_signal(&hasher->done_cond);
+	}
+	pthread_mutex_unlock(&hasher->lock);
+	return NULL;
+}
+
+/*
+ * Stop and join the SW worker threads
+ *
+ * @hasher [in]: leaf hasher
+ */
+static void sw_stop(struct leaf_hasher *hasher)
+{
+	uint32_t i;
+
+	pthread_mutex_lock(&hasher->lock);
+	hasher->stop = true;
+	pthread_cond_broadcast(&hasher->work_cond);
+	pthread_mutex_unlock(&hasher->lock);
+
+	for (i = 0; i < hasher->nb_threads; i++)
+		pthread_join(hasher->threads[i], NULL);
+	hasher->nb_threads = 0;
+}
+
+/*
+ * Start the SW worker threads
+ *
+ * @hasher [in]: leaf hasher
+ * @nb_threads [in]: number of threads to start
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t sw_start(struct leaf_hasher *hasher, uint32_t nb_threads)
+{
+	hasher->threads = calloc(nb_threads, sizeof(*hasher->threads));
+	if (hasher->threads == NULL) {
+		DOCA_LOG_ERR("Failed to allocate worker threads");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (hasher->nb_threads = 0; hasher->nb_threads < nb_threads; hasher->nb_threads++) {
+		if (pthread_create(&hasher->threads[hasher->nb_threads], NULL, sw_worker, hasher) != 0) {
+			DOCA_LOG_ERR("Failed to start hash worker thread");
+			sw_stop(hasher);
+			return DOCA_ERROR_BAD_STATE;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Submit a SHA hash task for a slot
+ *
+ * @hasher [in]: leaf hasher
+ * @slot [in]: slot to hash
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hw_submit_slot(struct leaf_hasher *hasher, struct leaf_slot *slot)
+{
+	/* The task callbacks report the task result through the task user data */
+	union doca_data task_user_data = {.ptr = &slot->status};
+	doca_error_t result;
+
+	result = doca_buf_set_data(slot->src_buf, slot->data, slot->len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	doca_buf_reset_data_len(slot->dst_buf);
+
+	result = doca_sha_task_hash_alloc_init(hasher->sha_ctx,
+					       DOCA_SHA_ALGORITHM_SHA256,
+					       slot->src_buf,
+					       slot->dst_buf,
+					       task_user_data,
+					       &slot->task);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	hasher->nb_hw_inflight++;
+	result = doca_task_submit(doca_sha_task_hash_as_task(slot->task));
+	if (result != DOCA_SUCCESS) {
+		hasher->nb_hw_inflight--;
+		doca_task_free(doca_sha_task_hash_as_task(slot->task));
+		slot->task = NULL;
+	}
+	return result;
+}
+
+/*
+ * Collect the SHA tasks completed since the last call
+ *
+ * @hasher [in]: leaf hasher
+ */
+static void hw_collect(struct leaf_hasher *hasher)
+{
+	struct leaf_slot *slot;
+	uint8_t *digest;
+	size_t digest_len = 0;
+	uint32_t i;
+
+	for (i = 0; i < hasher->window; i++) {
+		slot = &hasher->slots[i];
+		if (slot->task == NULL || slot->status == DOCA_ERROR_IN_PROGRESS)
+			continue;
+
+		if (slot->status == DOCA_SUCCESS) {
+			doca_buf_get_data(slot->dst_buf, (void **)&digest);
+			doca_buf_get_data_len(slot->dst_buf, &digest_len);
+			if (digest_len < MERKLE_HASH_LEN)
+				slot->status = DOCA_ERROR_BAD_STATE;
+			else
+				memcpy(slot->hash, digest, MERKLE_HASH_LEN);
+		} else
+			DOCA_LOG_ERR("SHA hash task failed: %s", doca_error_get_descr(slot->status));
+		doca_task_free(doca_sha_task_hash_as_task(slot->task));
+		slot->task = NULL;
+		job_done(hasher);
+	}
+}
+
+/*
+ * Hash slots of the posted jobs with SHA tasks - take jobs while there are free tasks and progress the PE until all
+ * submitted tasks complete. In mixed mode the SW threads take jobs of the same window concurrently.
+ *
+ * @hasher [in]: leaf hasher
+ */
+static void hw_run(struct leaf_hasher *hasher)
+{
+	struct timespec ts = {
+		.tv_nsec = HASHER_SLEEP_IN_NANOS,
+	};
+	struct leaf_slot *slot;
+	bool jobs_left = true;
+	uint32_t job;
+
+	while (jobs_left || hasher->nb_hw_inflight > 0) {
+		while (jobs_left && hasher->nb_hw_inflight < hasher->window) {
+			jobs_left = take_job(hasher, &job);
+			if (!jobs_left)
+				break;
+			slot = &hasher->slots[job];
+			slot->status = hw_submit_slot(hasher, slot);
+			if (slot->status != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to submit SHA hash task: %s", doca_error_get_descr(slot->status));
+				job_done(hasher);
+			}
+		}
+
+		if (doca_pe_progress(hasher->state->pe) == 0)
+			nanosleep(&ts, &ts);
+		hw_collect(hasher);
+	}
+}
+
+/*
+ * Prepare the HW part of the hasher - register the slot buffers with the device and start the SHA context
+ *
+ * @hasher [in]: leaf hasher
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t hw_start(struct leaf_hasher *hasher)
+{
+	struct program_core_objects *state = hasher->state;
+	union doca_data ctx_user_data = {.ptr = &hasher->nb_hw_inflight};
+	struct leaf_slot *slot;
+	uint32_t i;
+	doca_error_t result;
+
+	result = doca_mmap_set_memrange(state->src_mmap,
+					hasher->src_region,
+					(size_t)hasher->leaf_size * hasher->window);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->src_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start source memory map: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_mmap_set_memrange(state->dst_mmap, hasher->dst_region, (size_t)hasher->dst_len * hasher->window);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start destination memory map: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < hasher->window; i++) {
+		slot = &hasher->slots[i];
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    state->src_mmap,
+							    slot->data,
+							    hasher->leaf_size,
+							    &slot->src_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing source buffer: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv,
+							    state->dst_mmap,
+							    hasher->dst_region + (size_t)i * hasher->dst_len,
+							    hasher->dst_len,
+							    &slot->dst_buf);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing destination buffer: %s",
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	/* The task callbacks decrement the in flight counter through the context user data */
+	result = doca_ctx_set_user_data(state->ctx, ctx_user_data);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set DOCA context user data: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to start DOCA context: %s", doca_error_get_descr(result));
+	return result;
+}
+
+doca_error_t leaf_hasher_create(enum leaf_hash_mode mode,
+				struct program_core_objects *state,
+				struct doca_sha *sha_ctx,
+				uint32_t leaf_size,
+				uint32_t window,
+				uint32_t nb_threads,
+				struct leaf_hasher **hasher)
+{
+	struct leaf_hasher *new_hasher;
+	bool use_hw = (mode == LEAF_HASH_HW || mode == LEAF_HASH_MIXED);
+	bool use_sw = (mode == LEAF_HASH_SW || mode == LEAF_HASH_MIXED);
+	uint64_t max_src_len;
+	uint32_t i;
+	doca_error_t result;
+
+	if (leaf_size == 0 || window == 0 || (use_sw && nb_threads == 0) || (use_hw && sha_ctx == NULL) ||
+	    (!use_hw && !use_sw)) {
+		DOCA_LOG_ERR("Invalid leaf hasher configuration");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_hasher = calloc(1, sizeof(*new_hasher));
+	if (new_hasher == NULL) {
+		DOCA_LOG_ERR("Failed to allocate leaf hasher");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_hasher->mode = mode;
+	new_hasher->window = window;
+	new_hasher->leaf_size = leaf_size;
+	pthread_mutex_init(&new_hasher->lock, NULL);
+	pthread_cond_init(&new_hasher->work_cond, NULL);
+	pthread_cond_init(&new_hasher->done_cond, NULL);
+
+	new_hasher->src_region = calloc(window, leaf_size);
+	new_hasher->slots = calloc(window, sizeof(*new_hasher->slots));
+	if (new_hasher->src_region == NULL || new_hasher->slots == NULL) {
+		DOCA_LOG_ERR("Failed to allocate leaf hasher window of %u leaves", window);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_hasher;
+	}
+	for (i = 0; i < window; i++)
+		new_hasher->slots[i].data = new_hasher->src_region + (size_t)i * leaf_size;
+
+	if (use_hw) {
+		new_hasher->state = state;
+		new_hasher->sha_ctx = sha_ctx;
+		result = doca_sha_cap_get_max_src_buf_size(doca_dev_as_devinfo(state->dev), &max_src_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to get maximum source buffer size for DOCA SHA: %s",
+				     doca_error_get_descr(result));
+			goto destroy_hasher;
+		}
+		if (leaf_size > max_src_len) {
+			DOCA_LOG_ERR("Leaf size %u is larger than the maximal DOCA SHA source of %lu",
+				     leaf_size,
+				     max_src_len);
+			result = DOCA_ERROR_INVALID_VALUE;
+			goto destroy_hasher;
+		}
+		result = doca_sha_cap_get_min_dst_buf_size(doca_dev_as_devinfo(state->dev),
+							   DOCA_SHA_ALGORITHM_SHA256,
+							   &new_hasher->dst_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to get minimum destination buffer size for DOCA SHA: %s",
+				     doca_error_get_descr(result));
+			goto destroy_hasher;
+		}
+		new_hasher->dst_region = calloc(window, new_hasher->dst_len);
+		if (new_hasher->dst_region == NULL) {
+			DOCA_LOG_ERR("Failed to allocate leaf hasher digest buffers");
+			result = DOCA_ERROR_NO_MEMORY;
+			goto destroy_hasher;
+		}
+		result = hw_start(new_hasher);
+		if (result != DOCA_SUCCESS)
+			goto destroy_hasher;
+	}
+
+	if (use_sw) {
+		result = sw_start(new_hasher, nb_threads);
+		if (result != DOCA_SUCCESS)
+			goto destroy_hasher;
+	}
+
+	*hasher = new_hasher;
+	return DOCA_SUCCESS;
+
+destroy_hasher:
+	leaf_hasher_destroy(new_hasher);
+	return result;
+}
+
+struct leaf_slot *leaf_hasher_get_slot(struct leaf_hasher *hasher, uint32_t idx)
+{
+	return &hasher->slots[idx];
+}
+
+doca_error_t leaf_hasher_run(struct leaf_hasher *hasher, uint32_t nb_slots)
+{
+	uint32_t i;
+
+	if (nb_slots == 0 || nb_slots > hasher->window)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	for (i = 0; i < nb_slots; i++)
+		hasher->slots[i].status = DOCA_ERROR_IN_PROGRESS;
+
+	pthread_mutex_lock(&hasher->lock);
+	hasher->nb_done_jobs = 0;
+	hasher->next_job = 0;
+	hasher->nb_jobs = nb_slots;
+	pthread_cond_broadcast(&hasher->work_cond);
+	pthread_mutex_unlock(&hasher->lock);
+
+	if (hasher->sha_ctx != NULL)
+		hw_run(hasher);
+
+	pthread_mutex_lock(&hasher->lock);
+	while (hasher->nb_done_jobs != hasher->nb_jobs)
+		pthread_cond_wait(&hasher->done_cond, &hasher->lock);
+	hasher->nb_jobs = 0;
+	hasher->next_job = 0;
+	pthread_mutex_unlock(&hasher->lock);
+
+	for (i = 0; i < nb_slots; i++) {
+		if (hasher->slots[i].status != DOCA_SUCCESS)
+			return hasher->slots[i].status;
+	}
+	return DOCA_SUCCESS;
+}
+
+void leaf_hasher_destroy(struct leaf_hasher *hasher)
+{
+	uint32_t i;
+
+	sw_stop(hasher);
+
+	if (hasher->sha_ctx != NULL) {
+		for (i = 0; hasher->slots != NULL && i < hasher->window; i++) {
+			if (hasher->slots[i].src_buf != NULL)
+				doca_buf_dec_refcount(hasher->slots[i].src_buf, NULL);
+			if (hasher->slots[i].dst_buf != NULL)
+				doca_buf_dec_refcount(hasher->slots[i].dst_buf, NULL);
+		}
+		/* The window memory is freed below, so it must not stay registered with the device */
+		(void)doca_mmap_stop(hasher->state->src_mmap);
+		(void)doca_mmap_stop(hasher->state->dst_mmap);
+	}
+
+	pthread_cond_destroy(&hasher->done_cond);
+	pthread_cond_destroy(&hasher->work_cond);
+	pthread_mutex_destroy(&hasher->lock);
+	free(hasher->threads);
+	free(hasher->slots);
+	free(hasher->dst_region);
+	free(hasher->src_region);
+	free(hasher);
+}
+
+doca_error_t merkle_compute_root(const uint8_t *leaf_hashes, uint32_t nb_leaves, uint8_t root[MERKLE_HASH_LEN])
+{
+	uint8_t node[1 + 2 * MERKLE_HASH_LEN];
+	uint8_t *level, *parent;
+	uint32_t nb_nodes, i;
+
+	if (nb_leaves == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	level = malloc((size_t)nb_leaves * MERKLE_HASH_LEN);
+	if (level == NULL) {
+		DOCA_LOG_ERR("Failed to allocate Merkle tree level");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memcpy(level, leaf_hashes, (size_t)nb_leaves * MERKLE_HASH_LEN);
+
+	/* Every level is built in place over the previous one, a parent index is never above its children */
+	node[0] = MERKLE_NODE_PREFIX;
+	for (nb_nodes = nb_leaves; nb_nodes > 1; nb_nodes = (nb_nodes + 1) / 2) {
+		for (i = 0; i + 1 < nb_nodes; i += 2) {
+			memcpy(node + 1, level + (size_t)i * MERKLE_HASH_LEN, 2 * MERKLE_HASH_LEN);
+			parent = level + (size_t)(i / 2) * MERKLE_HASH_LEN;
+			if (EVP_Digest(node, sizeof(node), parent, NULL, EVP_sha256(), NULL) != 1) {
+				free(level);
+				return DOCA_ERROR_BAD_STATE;
+			}
+		}
+		if (nb_nodes % 2 == 1)
+			memmove(level + (size_t)(nb_nodes / 2) * MERKLE_HASH_LEN,
+				level + (size_t)(nb_nodes - 1) * MERKLE_HASH_LEN,
+				MERKLE_HASH_LEN);
+	}
+
+	memcpy(root, level, MERKLE_HASH_LEN);
+	free(level);
+	return DOCA_SUCCESS;
+}
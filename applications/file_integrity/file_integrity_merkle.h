@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef FILE_INTEGRITY_MERKLE_H_
+#define FILE_INTEGRITY_MERKLE_H_
+
+#include <stdint.h>
+
+#include <doca_error.h>
+#include <doca_sha.h>
+
+#include <samples/common.h>
+
+/*
+ * Merkle tree mode:
+ *	The file is split to leaves of leaf_size bytes (the last leaf may be shorter). A leaf hash is the SHA256 of
+ *	the leaf data, so leaves can be hashed by DOCA SHA tasks as is. An interior node is the SHA256 of 0x01 followed
+ *	by its two children, and a node without a sibling is promoted to the next level unchanged. Interior nodes are
+ *	combined on the host.
+ * Transfer:
+ *	merkle metadata message (root, leaf size, file size)
+ *	leaf hashes - nb_leaves * MERKLE_HASH_LEN bytes
+ *	file data
+ * The leaf hashes and the file data are byte streams carried across comch messages. The server checks the leaf
+ * hashes against the root once they are received, and then verifies every window of leaves as it arrives.
+ */
+#define MERKLE_HASH_LEN 32	 /* Length of a SHA256 digest */
+#define MERKLE_NODE_PREFIX 0x01 /* Prefix of the data of an interior node hash */
+
+/* Which engine hashes the leaves */
+enum leaf_hash_mode {
+	LEAF_HASH_AUTO = 0, /* HW if a SHA device is present, otherwise SW */
+	LEAF_HASH_HW,	    /* DOCA SHA tasks */
+	LEAF_HASH_SW,	    /* Host SHA256 on a pool of threads */
+	LEAF_HASH_MIXED,    /* DOCA SHA tasks and host threads take leaves from the same window */
+};
+
+/* Leaf hasher - hashes a window of leaves concurrently */
+struct leaf_hasher;
+
+/* A leaf slot in the hasher window */
+struct leaf_slot {
+	uint8_t *data;			 /* Leaf data buffer */
+	uint32_t len;			 /* Length of the data, set by the caller */
+	uint8_t hash[MERKLE_HASH_LEN];	 /* Leaf hash, set by the hasher */
+	doca_error_t status;		 /* Status of the last hash of the slot */
+	struct doca_buf *src_buf;	 /* DOCA buffer over data, HW only */
+	struct doca_buf *dst_buf;	 /* DOCA buffer receiving the digest, HW only */
+	struct doca_sha_task_hash *task; /* Task in flight, HW only */
+};
+
+/*
+ * Get the name of a leaf hash mode
+ *
+ * @mode [in]: leaf hash mode
+ * @return: mode name
+ */
+const char *leaf_hash_mode_name(enum leaf_hash_mode mode);
+
+/*
+ * Create a leaf hasher.
+ * A hasher using DOCA SHA registers its window with the memory maps of state and starts the SHA context, whose hash
+ * task pool must hold at least window tasks.
+ *
+ * @mode [in]: leaf hash mode, HW, SW or MIXED
+ * @state [in]: core objects of the SHA context, unused in SW mode
+ * @sha_ctx [in]: SHA context, unused in SW mode
+ * @leaf_size [in]: maximal leaf length
+ * @window [in]: number of leaves hashed concurrently
+ * @nb_threads [in]: number of SW threads, unused in HW mode
+ * @hasher [out]: the created hasher
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t leaf_hasher_create(enum leaf_hash_mode mode,
+				struct program_core_objects *state,
+				struct doca_sha *sha_ctx,
+				uint32_t leaf_size,
+				uint32_t window,
+				uint32_t nb_threads,
+				struct leaf_hasher **hasher);
+
+/*
+ * Get a slot of the hasher window
+ *
+ * @hasher [in]: leaf hasher
+ * @idx [in]: slot index, smaller than the hasher window
+ * @return: the slot
+ */
+struct leaf_slot *leaf_hasher_get_slot(struct leaf_hasher *hasher, uint32_t idx);
+
+/*
+ * Hash the first nb_slots slots of the window concurrently, and wait for all of them to complete
+ *
+ * @hasher [in]: leaf hasher
+ * @nb_slots [in]: number of slots to hash
+ * @return: DOCA_SUCCESS if all slots were hashed successfully and DOCA_ERROR otherwise
+ */
+doca_error_t leaf_hasher_run(struct leaf_hasher *hasher, uint32_t nb_slots);
+
+/*
+ * Destroy a leaf hasher
+ *
+ * @hasher [in]: leaf hasher to destroy
+ */
+void leaf_hasher_destroy(struct leaf_hasher *hasher);
+
+/*
+ * Compute the Merkle tree root of a list of leaf hashes
+ *
+ * @leaf_hashes [in]: nb_leaves hashes of MERKLE_HASH_LEN bytes
+ * @nb_leaves [in]: number of leaves, must be positive
+ * @root [out]: the root hash
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t merkle_compute_root(const uint8_t *leaf_hashes, uint32_t nb_leaves, uint8_t root[MERKLE_HASH_LEN]);
+
+#endif /* FILE_INTEGRITY_MERKLE_H_ */
@@ -167,6 +167,46 @@ static doca_error_t ip_frag_mbuf_hw_cksum_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Callback to handle RX burst size
+ *
+ * @param [in]: burst size integer.
+ * @config [in]: Ip_frag config.
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ip_frag_burst_size_callback(void *param, void *config)
+{
+	const uint32_t burst_size = *(const uint32_t *)param;
+	struct ip_frag_config *cfg = config;
+
+	if (burst_size == 0 || burst_size > IP_FRAG_MAX_BURST_SIZE) {
+		DOCA_LOG_ERR("Invalid burst size: %u, expected value in range [1, %u]",
+			     burst_size,
+			     IP_FRAG_MAX_BURST_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	cfg->burst_size = burst_size;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Callback to handle DOCA Flow steering disabling
+ *
+ * @param [in]: flow disable boolean.
+ * @config [in]: Ip_frag config.
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ip_frag_flow_disable_callback(void *param, void *config)
+{
+	const bool flow_disable = *(const bool *)param;
+	struct ip_frag_config *cfg = config;
+
+	cfg->flow_disable = flow_disable;
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Handle application parameters registration
  *
@@ -179,6 +219,8 @@ static doca_error_t ip_frag_register_params(void)
 	struct doca_argp_param *frag_tbl_timeout_param;
 	struct doca_argp_param *frag_tbl_size_param;
 	struct doca_argp_param *mbuf_chain_param;
+	struct doca_argp_param *burst_size_param;
+	struct doca_argp_param *flow_disable_param;
 	doca_error_t result;
 
 	/* Create and register ip_frag application mode */
@@ -268,8 +310,10 @@ static doca_error_t ip_frag_register_params(void)
 	}
 	doca_argp_param_set_short_name(mbuf_chain_param, "c");
 	doca_argp_param_set_long_name(mbuf_chain_param, "mbuf-chain");
-	doca_argp_param_set_description(mbuf_chain_param,
-					"Enable mbuf chaining (required for IPv6 fragmentation support)");
+	doca_argp_param_set_description(
+		mbuf_chain_param,
+		"Enable mbuf chaining: keep reassembled packets chained and fragment packets without copying the payload"
+		" into the fragments");
 	doca_argp_param_set_callback(mbuf_chain_param, ip_frag_mbuf_chain_callback);
 	doca_argp_param_set_type(mbuf_chain_param, DOCA_ARGP_TYPE_BOOLEAN);
 	result = doca_argp_register_param(mbuf_chain_param);
@@ -295,6 +339,43 @@ static doca_error_t ip_frag_register_params(void)
 		return result;
 	}
 
+	/* Create and register ip_frag RX burst size */
+	result = doca_argp_param_create(&burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(burst_size_param, "b");
+	doca_argp_param_set_long_name(burst_size_param, "burst-size");
+	doca_argp_param_set_description(burst_size_param, "Maximum number of packets received in a single RX burst");
+	doca_argp_param_set_callback(burst_size_param, ip_frag_burst_size_callback);
+	doca_argp_param_set_type(burst_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register ip_frag DOCA Flow steering toggle */
+	result = doca_argp_param_create(&flow_disable_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(flow_disable_param, "f");
+	doca_argp_param_set_long_name(flow_disable_param, "flow-disable");
+	doca_argp_param_set_description(
+		flow_disable_param,
+		"Disable DOCA Flow steering, required for ports that DOCA Flow can't drive (e.g. net_pcap vdevs for offline testing)."
+		" Combine with --cksum-accel-disable for ports without checksum offloads");
+	doca_argp_param_set_callback(flow_disable_param, ip_frag_flow_disable_callback);
+	doca_argp_param_set_type(flow_disable_param, DOCA_ARGP_TYPE_BOOLEAN);
+	result = doca_argp_register_param(flow_disable_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	return DOCA_SUCCESS;
 }
 
@@ -314,14 +395,37 @@ static doca_error_t ip_frag_dpdk_config_num_ports(struct application_dpdk_config
 /*
  * Set DPDK port tx offload flags
  *
- * @cfg [in]: application config
+ * @cfg [in/out]: application config
  * @dpdk_cfg [out]: application DPDK configuration values
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 static doca_error_t ip_frag_dpdk_config_tx_offloads(struct ip_frag_config *cfg,
 						    struct application_dpdk_config *dpdk_config)
 {
-	if (cfg->mbuf_chain)
+	struct rte_eth_dev_info dev_info;
+	uint16_t port_id;
+	int ret;
+
+	/* Reassembled chains can be sent without flattening only if every egress port can transmit them */
+	cfg->tx_multi_seg = true;
+	RTE_ETH_FOREACH_DEV(port_id)
+	{
+		ret = rte_eth_dev_info_get(port_id, &dev_info);
+		if (ret) {
+			DOCA_LOG_ERR("Failed to get device info of port %u with code: %d", port_id, ret);
+			return DOCA_ERROR_DRIVER;
+		}
+
+		if (!(dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MULTI_SEGS))
+			cfg->tx_multi_seg = false;
+	}
+
+	if (cfg->mbuf_chain && !cfg->tx_multi_seg) {
+		DOCA_LOG_ERR("Mbuf chaining requires multi-segment TX support on all ports");
+		return DOCA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (cfg->tx_multi_seg)
 		dpdk_config->port_config.tx_offloads |= RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
 	if (cfg->hw_cksum)
 		dpdk_config->port_config.tx_offloads |= RTE_ETH_TX_OFFLOAD_IPV4_CKSUM | RTE_ETH_TX_OFFLOAD_UDP_CKSUM;
@@ -376,6 +480,8 @@ int main(int argc, char **argv)
 		.hw_cksum = true,
 		.frag_tbl_timeout = IP_FRAG_TBL_TIMEOUT_MS,
 		.frag_tbl_size = IP_FRAG_TBL_SIZE,
+		.burst_size = IP_FRAG_DEFAULT_BURST_SIZE,
+		.flow_disable = false,
 	};
 	struct doca_log_backend *sdk_log;
 	int exit_status = EXIT_FAILURE;
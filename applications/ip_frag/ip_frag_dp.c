@@ -37,15 +37,21 @@
 #include <rte_ip_frag.h>
 #include <rte_cycles.h>
 #include <rte_mempool.h>
+#include <rte_random.h>
 
+#include <netinet/in.h>
 #include <stdbool.h>
 
-#define IP_FRAG_MAX_PKT_BURST 32
-#define IP_FRAG_BURST_PREFETCH (IP_FRAG_MAX_PKT_BURST / 8)
+#define IP_FRAG_PREFETCH_OFFSET 4
+#define IP_FRAG_TX_BUFFER_FACTOR 4
 #define IP_FRAG_FLUSH_THRESHOLD 16
+#define IP_FRAG_DEATH_ROW_PREFETCH 4
 
 #define IP_FRAG_TBL_BUCKET_SIZE 4
 
+/* Header mbufs only carry the L2/L3 headers of the fragments, payload is attached from indirect mbufs */
+#define IP_FRAG_HDR_MBUF_DATA_SIZE (RTE_PKTMBUF_HEADROOM + 128)
+
 DOCA_LOG_REGISTER(IP_FRAG::DP);
 
 struct ip_frag_sw_counters {
@@ -57,15 +63,58 @@ struct ip_frag_sw_counters {
 	uint64_t err;		/* Errors */
 };
 
+enum ip_frag_stage {
+	IP_FRAG_STAGE_RX,	  /* Burst reception */
+	IP_FRAG_STAGE_CLASSIFY,	  /* Burst parsing and classification */
+	IP_FRAG_STAGE_WHOLE,	  /* Whole packets fixup and buffering */
+	IP_FRAG_STAGE_REASSEMBLE, /* Fragments reassembly */
+	IP_FRAG_STAGE_FRAGMENT,	  /* Fragmentation of packets exceeding the MTU */
+	IP_FRAG_STAGE_TX,	  /* TX buffers flush */
+	IP_FRAG_STAGE_NUM,
+};
+
+static const char *const ip_frag_stage_names[IP_FRAG_STAGE_NUM] = {
+	[IP_FRAG_STAGE_RX] = "rx",
+	[IP_FRAG_STAGE_CLASSIFY] = "classify",
+	[IP_FRAG_STAGE_WHOLE] = "whole",
+	[IP_FRAG_STAGE_REASSEMBLE] = "reassemble",
+	[IP_FRAG_STAGE_FRAGMENT] = "fragment",
+	[IP_FRAG_STAGE_TX] = "tx",
+};
+
+struct ip_frag_stage_counters {
+	uint64_t cycles; /* TSC cycles spent in the stage */
+	uint64_t pkts;	 /* Packets handled by the stage */
+};
+
+enum ip_frag_vec {
+	IP_FRAG_VEC_FRAG,     /* Fragments that need reassembly */
+	IP_FRAG_VEC_WHOLE,    /* Whole packets that can be sent as is */
+	IP_FRAG_VEC_FRAGMENT, /* Packets exceeding the MTU that need fragmentation */
+	IP_FRAG_VEC_NUM,
+};
+
+struct ip_frag_burst {
+	struct rte_mbuf *pkts[IP_FRAG_MAX_BURST_SIZE];		  /* Received packets */
+	enum parser_pkt_type pkt_types[IP_FRAG_MAX_BURST_SIZE];	  /* Inferred packet types */
+	struct tun_parser_ctx parse_ctxs[IP_FRAG_MAX_BURST_SIZE]; /* Packet parser contexts */
+	uint16_t vecs[IP_FRAG_VEC_NUM][IP_FRAG_MAX_BURST_SIZE];	  /* Indices of packets in each class */
+	uint16_t vec_cnt[IP_FRAG_VEC_NUM];			  /* Number of packets in each class */
+};
+
 struct ip_frag_wt_data {
-	const struct ip_frag_config *cfg;			  /* Application config */
-	uint16_t queue_id;					  /* Queue id */
-	struct ip_frag_sw_counters sw_counters[IP_FRAG_PORT_NUM]; /* SW counters */
-	struct rte_eth_dev_tx_buffer *tx_buffer;		  /* TX buffer */
-	uint64_t tx_buffer_err;					  /* TX buffer error counter */
-	struct rte_ip_frag_tbl *frag_tbl;			  /* Fragmentation table */
-	struct rte_mempool *indirect_pool;			  /* Indirect memory pool */
-	struct rte_ip_frag_death_row death_row;			  /* Fragmentation table expired fragments death row */
+	const struct ip_frag_config *cfg;				 /* Application config */
+	uint16_t queue_id;						 /* Queue id */
+	struct ip_frag_sw_counters sw_counters[IP_FRAG_PORT_NUM];	 /* SW counters */
+	struct ip_frag_stage_counters stage_counters[IP_FRAG_STAGE_NUM]; /* Per-stage counters */
+	struct rte_eth_dev_tx_buffer *tx_buffers[IP_FRAG_PORT_NUM];	 /* Per-port TX buffers */
+	uint64_t tx_buffer_err;						 /* TX buffer error counter */
+	struct ip_frag_burst *burst;					 /* Burst classification state */
+	struct rte_ip_frag_tbl *frag_tbl;				 /* Fragmentation table */
+	struct rte_mempool *indirect_pool;				 /* Indirect memory pool */
+	struct rte_mempool *hdr_pool;					 /* Fragment header memory pool */
+	uint32_t ipv6_frag_id;						 /* Next IPv6 fragment identification */
+	struct rte_ip_frag_death_row death_row;				 /* Expired fragments death row */
 } __rte_aligned(RTE_CACHE_LINE_SIZE);
 
 bool force_stop = false;
@@ -401,7 +450,6 @@ static struct rte_mbuf *ip_frag_pkt_reassemble_push_inner(struct ip_frag_wt_data
  * Set necessary mbuf fields and push the packet to the frag table.
  *
  * @wt_data [in]: worker thread data
- * @rx_port_id [in]: receive port id
  * @pkt_type [in]: incoming packet type
  * @pkt [in]: packet
  * @parse_ctx [in]: pointer to the parser context
@@ -410,7 +458,6 @@ static struct rte_mbuf *ip_frag_pkt_reassemble_push_inner(struct ip_frag_wt_data
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 static doca_error_t ip_frag_pkt_reassemble_push(struct ip_frag_wt_data *wt_data,
-						uint16_t rx_port_id,
 						enum parser_pkt_type pkt_type,
 						struct rte_mbuf *pkt,
 						struct tun_parser_ctx *parse_ctx,
@@ -418,7 +465,6 @@ static doca_error_t ip_frag_pkt_reassemble_push(struct ip_frag_wt_data *wt_data,
 						struct rte_mbuf **whole_pkt)
 {
 	struct rte_mbuf *res;
-	doca_error_t ret;
 
 	assert(pkt_type == PARSER_PKT_TYPE_TUNNELED || pkt_type == PARSER_PKT_TYPE_PLAIN);
 
@@ -432,15 +478,12 @@ static doca_error_t ip_frag_pkt_reassemble_push(struct ip_frag_wt_data *wt_data,
 	if (!res)
 		return DOCA_ERROR_AGAIN;
 
-	if (!wt_data->cfg->mbuf_chain && !rte_pktmbuf_is_contiguous(res)) {
-		ret = ip_frag_pkt_flatten(res);
-		if (ret != DOCA_SUCCESS) {
-			ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
-			return ret;
-		}
-	}
-
+	/* The caller owns the reassembled packet from now on, including on flatten failure. Chains are only flattened
+	 * when the ports can't transmit them as is. */
 	*whole_pkt = res;
+	if (!wt_data->cfg->mbuf_chain && !wt_data->cfg->tx_multi_seg && !rte_pktmbuf_is_contiguous(res))
+		return ip_frag_pkt_flatten(res);
+
 	return DOCA_SUCCESS;
 }
 
@@ -478,18 +521,12 @@ static void ip_frag_pkt_reassemble(struct ip_frag_wt_data *wt_data,
 		case DOCA_SUCCESS:
 			wt_data->sw_counters[rx_port_id].whole++;
 			ip_frag_pkt_fixup(wt_data, inferred_pkt_type, pkt, &parse_ctx);
-			rte_eth_tx_buffer(tx_port_id, wt_data->queue_id, wt_data->tx_buffer, pkt);
+			rte_eth_tx_buffer(tx_port_id, wt_data->queue_id, wt_data->tx_buffers[tx_port_id], pkt);
 			break;
 
 		case DOCA_ERROR_AGAIN:
 			wt_data->sw_counters[rx_port_id].frags_rx++;
-			ret = ip_frag_pkt_reassemble_push(wt_data,
-							  rx_port_id,
-							  inferred_pkt_type,
-							  pkt,
-							  &parse_ctx,
-							  rx_ts,
-							  &pkt);
+			ret = ip_frag_pkt_reassemble_push(wt_data, inferred_pkt_type, pkt, &parse_ctx, rx_ts, &pkt);
 			if (ret == DOCA_SUCCESS) {
 				reparse = true;
 			} else if (ret != DOCA_ERROR_AGAIN) {
@@ -507,40 +544,232 @@ static void ip_frag_pkt_reassemble(struct ip_frag_wt_data *wt_data,
 }
 
 /*
- * Reassemble the packet burst buffering any resulting packets.
+ * Account the cycles spent in a pipeline stage since the given timestamp.
+ *
+ * @wt_data [in]: worker thread data
+ * @stage [in]: pipeline stage
+ * @start_tsc [in]: stage start timestamp
+ * @pkts_cnt [in]: number of packets handled by the stage
+ * @return: current timestamp, i.e. the start timestamp of the next stage
+ */
+static inline uint64_t ip_frag_stage_account(struct ip_frag_wt_data *wt_data,
+					     enum ip_frag_stage stage,
+					     uint64_t start_tsc,
+					     uint32_t pkts_cnt)
+{
+	uint64_t now = rte_rdtsc();
+
+	wt_data->stage_counters[stage].cycles += now - start_tsc;
+	wt_data->stage_counters[stage].pkts += pkts_cnt;
+	return now;
+}
+
+/*
+ * Append a packet of the current burst to a classification vector.
+ *
+ * @burst [in]: burst classification state
+ * @vec [in]: classification vector
+ * @idx [in]: packet index in the burst
+ */
+static inline void ip_frag_burst_vec_push(struct ip_frag_burst *burst, enum ip_frag_vec vec, uint16_t idx)
+{
+	burst->vecs[vec][burst->vec_cnt[vec]++] = idx;
+}
+
+/*
+ * Prefetch the headers of a packet in a classification vector, if it exists.
+ *
+ * @burst [in]: burst classification state
+ * @vec [in]: classification vector
+ * @i [in]: packet position in the vector
+ */
+static inline void ip_frag_burst_vec_prefetch(struct ip_frag_burst *burst, enum ip_frag_vec vec, uint16_t i)
+{
+	if (i < burst->vec_cnt[vec])
+		rte_prefetch0(rte_pktmbuf_mtod(burst->pkts[burst->vecs[vec][i]], void *));
+}
+
+/*
+ * Parse a packet received on a reassembly port and classify it as either whole or a fragment.
  *
  * @wt_data [in]: worker thread data
  * @rx_port_id [in]: receive port id
- * @tx_port_id [in]: send port id
  * @pkt_type [in]: incoming packet type
- * @pkts [in]: packet burst
+ * @idx [in]: packet index in the burst
+ */
+static void ip_frag_pkt_classify_reassemble(struct ip_frag_wt_data *wt_data,
+					    uint16_t rx_port_id,
+					    enum parser_pkt_type pkt_type,
+					    uint16_t idx)
+{
+	struct ip_frag_burst *burst = wt_data->burst;
+	struct tun_parser_ctx *parse_ctx = &burst->parse_ctxs[idx];
+	doca_error_t ret;
+
+	burst->pkt_types[idx] = pkt_type;
+	memset(parse_ctx, 0, sizeof(*parse_ctx));
+
+	ret = ip_frag_pkt_parse(&burst->pkt_types[idx], burst->pkts[idx], parse_ctx);
+	switch (ret) {
+	case DOCA_SUCCESS:
+		wt_data->sw_counters[rx_port_id].whole++;
+		ip_frag_burst_vec_push(burst, IP_FRAG_VEC_WHOLE, idx);
+		break;
+	case DOCA_ERROR_AGAIN:
+		wt_data->sw_counters[rx_port_id].frags_rx++;
+		ip_frag_burst_vec_push(burst, IP_FRAG_VEC_FRAG, idx);
+		break;
+	default:
+		ip_frag_pkt_err_drop(wt_data, rx_port_id, burst->pkts[idx]);
+		DOCA_LOG_DBG("Failed to parse packet status %u", ret);
+		break;
+	}
+}
+
+/*
+ * Parse a packet received on a fragmentation port and classify it as either fitting the MTU or requiring
+ * fragmentation.
+ *
+ * @wt_data [in]: worker thread data
+ * @rx_port_id [in]: receive port id
+ * @idx [in]: packet index in the burst
+ */
+static void ip_frag_pkt_classify_fragment(struct ip_frag_wt_data *wt_data, uint16_t rx_port_id, uint16_t idx)
+{
+	struct ip_frag_burst *burst = wt_data->burst;
+	struct conn_parser_ctx *parse_ctx = &burst->parse_ctxs[idx].inner;
+	struct rte_mbuf *pkt = burst->pkts[idx];
+	doca_error_t ret;
+
+	memset(parse_ctx, 0, sizeof(*parse_ctx));
+	/* We only fragment the outer header and don't care about parsing encapsulation, so always treat the packet as
+	 * non-encapsulated. */
+	ret = plain_parse(rte_pktmbuf_mtod(pkt, uint8_t *),
+			  rte_pktmbuf_mtod(pkt, uint8_t *) + rte_pktmbuf_data_len(pkt),
+			  parse_ctx);
+	if (ret != DOCA_SUCCESS) {
+		ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
+		DOCA_LOG_DBG("Failed to parse packet status %u", ret);
+		return;
+	}
+
+	if (rte_pktmbuf_pkt_len(pkt) <= wt_data->cfg->mtu) {
+		wt_data->sw_counters[rx_port_id].mtu_fits_rx++;
+		ip_frag_burst_vec_push(burst, IP_FRAG_VEC_WHOLE, idx);
+	} else {
+		wt_data->sw_counters[rx_port_id].mtu_exceed_rx++;
+		ip_frag_burst_vec_push(burst, IP_FRAG_VEC_FRAGMENT, idx);
+	}
+}
+
+/*
+ * Parse the whole received burst and sort it into classification vectors.
+ *
+ * @wt_data [in]: worker thread data
+ * @rx_port_id [in]: receive port id
+ * @pkt_type [in]: incoming packet type, ignored for fragmentation ports
+ * @reassemble [in]: true if the burst was received on a reassembly port
  * @pkts_cnt [in]: number of packets in the burst
- * @rx_ts [in]: burst reception timestamp
  */
-static void ip_frag_pkts_reassemble(struct ip_frag_wt_data *wt_data,
-				    uint16_t rx_port_id,
-				    uint16_t tx_port_id,
-				    enum parser_pkt_type pkt_type,
-				    struct rte_mbuf *pkts[],
-				    int pkts_cnt,
-				    uint64_t rx_ts)
+static void ip_frag_burst_classify(struct ip_frag_wt_data *wt_data,
+				   uint16_t rx_port_id,
+				   enum parser_pkt_type pkt_type,
+				   bool reassemble,
+				   uint16_t pkts_cnt)
+{
+	struct ip_frag_burst *burst = wt_data->burst;
+	uint16_t i;
+
+	memset(burst->vec_cnt, 0, sizeof(burst->vec_cnt));
+
+	for (i = 0; i < IP_FRAG_PREFETCH_OFFSET && i < pkts_cnt; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(burst->pkts[i], void *));
+
+	for (i = 0; i < pkts_cnt; i++) {
+		if (i + IP_FRAG_PREFETCH_OFFSET < pkts_cnt)
+			rte_prefetch0(rte_pktmbuf_mtod(burst->pkts[i + IP_FRAG_PREFETCH_OFFSET], void *));
+
+		if (reassemble)
+			ip_frag_pkt_classify_reassemble(wt_data, rx_port_id, pkt_type, i);
+		else
+			ip_frag_pkt_classify_fragment(wt_data, rx_port_id, i);
+	}
+}
+
+/*
+ * Buffer the whole packets vector of the current burst for transmission.
+ *
+ * @wt_data [in]: worker thread data
+ * @tx_port_id [in]: outgoing packet port id
+ * @fixup [in]: fixup the packet headers, only required for packets received on a reassembly port
+ */
+static void ip_frag_burst_whole_send(struct ip_frag_wt_data *wt_data, uint16_t tx_port_id, bool fixup)
 {
-	int i; /* prefetch calculation can yield negative values */
+	struct rte_eth_dev_tx_buffer *tx_buffer = wt_data->tx_buffers[tx_port_id];
+	struct ip_frag_burst *burst = wt_data->burst;
+	uint16_t idx;
+	uint16_t i;
+
+	for (i = 0; i < IP_FRAG_PREFETCH_OFFSET; i++)
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_WHOLE, i);
 
-	for (i = 0; i < IP_FRAG_BURST_PREFETCH && i < pkts_cnt; i++)
-		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+	for (i = 0; i < burst->vec_cnt[IP_FRAG_VEC_WHOLE]; i++) {
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_WHOLE, i + IP_FRAG_PREFETCH_OFFSET);
 
-	for (i = 0; i < (pkts_cnt - IP_FRAG_BURST_PREFETCH); i++) {
-		rte_prefetch0(rte_pktmbuf_mtod(pkts[i + IP_FRAG_BURST_PREFETCH], void *));
-		ip_frag_pkt_reassemble(wt_data, rx_port_id, tx_port_id, pkt_type, pkts[i], rx_ts);
+		idx = burst->vecs[IP_FRAG_VEC_WHOLE][i];
+		if (fixup)
+			ip_frag_pkt_fixup(wt_data, burst->pkt_types[idx], burst->pkts[idx], &burst->parse_ctxs[idx]);
+		rte_eth_tx_buffer(tx_port_id, wt_data->queue_id, tx_buffer, burst->pkts[idx]);
 	}
+}
+
+/*
+ * Push the fragments vector of the current burst to the frag table, buffering any fully reassembled packets.
+ *
+ * @wt_data [in]: worker thread data
+ * @rx_port_id [in]: receive port id
+ * @tx_port_id [in]: outgoing packet port id
+ * @pkt_type [in]: incoming packet type
+ * @rx_ts [in]: burst reception timestamp
+ */
+static void ip_frag_burst_reassemble(struct ip_frag_wt_data *wt_data,
+				     uint16_t rx_port_id,
+				     uint16_t tx_port_id,
+				     enum parser_pkt_type pkt_type,
+				     uint64_t rx_ts)
+{
+	struct ip_frag_burst *burst = wt_data->burst;
+	struct rte_mbuf *pkt;
+	doca_error_t ret;
+	uint16_t idx;
+	uint16_t i;
+
+	for (i = 0; i < IP_FRAG_PREFETCH_OFFSET; i++)
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_FRAG, i);
 
-	for (; i < pkts_cnt; i++)
-		ip_frag_pkt_reassemble(wt_data, rx_port_id, tx_port_id, pkt_type, pkts[i], rx_ts);
+	for (i = 0; i < burst->vec_cnt[IP_FRAG_VEC_FRAG]; i++) {
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_FRAG, i + IP_FRAG_PREFETCH_OFFSET);
+
+		idx = burst->vecs[IP_FRAG_VEC_FRAG][i];
+		pkt = burst->pkts[idx];
+		ret = ip_frag_pkt_reassemble_push(wt_data,
+						  burst->pkt_types[idx],
+						  pkt,
+						  &burst->parse_ctxs[idx],
+						  rx_ts,
+						  &pkt);
+		if (ret == DOCA_SUCCESS) {
+			/* Reassembled packet may still carry fragmented inner header, run it through the full path */
+			ip_frag_pkt_reassemble(wt_data, rx_port_id, tx_port_id, pkt_type, pkt, rx_ts);
+		} else if (ret != DOCA_ERROR_AGAIN) {
+			DOCA_LOG_ERR("Unexpected packet fragmentation");
+			ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
+		}
+	}
 }
 
 /*
- * Receive a burst of packets on rx port, reassemble any fragments and send resulting packets on the tx port.
+ * Receive a burst of packets on rx port, reassemble any fragments and buffer resulting packets for the tx port.
  *
  * @wt_data [in]: worker thread data
  * @rx_port_id [in]: receive port id
@@ -552,100 +781,191 @@ static void ip_frag_wt_reassemble(struct ip_frag_wt_data *wt_data,
 				  uint16_t tx_port_id,
 				  enum parser_pkt_type pkt_type)
 {
-	struct rte_mbuf *pkts[IP_FRAG_MAX_PKT_BURST];
+	struct ip_frag_burst *burst = wt_data->burst;
+	uint64_t tsc = rte_rdtsc();
+	uint64_t rx_ts;
 	uint16_t pkts_cnt;
 
-	pkts_cnt = rte_eth_rx_burst(rx_port_id, wt_data->queue_id, pkts, IP_FRAG_MAX_PKT_BURST);
+	pkts_cnt = rte_eth_rx_burst(rx_port_id, wt_data->queue_id, burst->pkts, wt_data->cfg->burst_size);
 	if (likely(pkts_cnt)) {
-		ip_frag_pkts_reassemble(wt_data, rx_port_id, tx_port_id, pkt_type, pkts, pkts_cnt, rte_rdtsc());
-		rte_eth_tx_buffer_flush(tx_port_id, wt_data->queue_id, wt_data->tx_buffer);
+		rx_ts = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_RX, tsc, pkts_cnt);
+
+		ip_frag_burst_classify(wt_data, rx_port_id, pkt_type, true, pkts_cnt);
+		tsc = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_CLASSIFY, rx_ts, pkts_cnt);
+
+		ip_frag_burst_whole_send(wt_data, tx_port_id, true);
+		tsc = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_WHOLE, tsc, burst->vec_cnt[IP_FRAG_VEC_WHOLE]);
+
+		ip_frag_burst_reassemble(wt_data, rx_port_id, tx_port_id, pkt_type, rx_ts);
+		ip_frag_stage_account(wt_data, IP_FRAG_STAGE_REASSEMBLE, tsc, burst->vec_cnt[IP_FRAG_VEC_FRAG]);
 	} else {
-		rte_ip_frag_table_del_expired_entries(wt_data->frag_tbl, &wt_data->death_row, rte_rdtsc());
+		rte_ip_frag_table_del_expired_entries(wt_data->frag_tbl, &wt_data->death_row, tsc);
 	}
-	rte_ip_frag_free_death_row(&wt_data->death_row, IP_FRAG_BURST_PREFETCH);
+	rte_ip_frag_free_death_row(&wt_data->death_row, IP_FRAG_DEATH_ROW_PREFETCH);
 }
 
+/*
+ * Fragment a single-segment IPv6 packet copying the payload into newly allocated mbufs. This is the IPv6
+ * counterpart of rte_ipv4_fragment_copy_nonseg_packet() and, same as rte_ipv6_fragment_packet(), only treats the fixed
+ * IPv6 header as the unfragmentable part of the packet.
+ *
+ * @pkt_in [in]: packet starting at the IPv6 header
+ * @pkts_out [out]: array to store the resulting fragments at
+ * @pkts_out_max [in]: size of the pkts_out array
+ * @mtu [in]: maximum size of the resulting fragments, including the IPv6 header
+ * @pool [in]: mempool to allocate the fragments from
+ * @frag_id [in]: fragment identification of the resulting fragments
+ * @return: number of resulting fragments on success and negative errno otherwise
+ */
+static int32_t ip_frag_ipv6_fragment_copy_nonseg_packet(struct rte_mbuf *pkt_in,
+							struct rte_mbuf **pkts_out,
+							uint16_t pkts_out_max,
+							uint16_t mtu,
+							struct rte_mempool *pool,
+							uint32_t frag_id)
+{
+	const uint16_t frag_hdr_len = sizeof(struct rte_ipv6_hdr) + sizeof(struct rte_ipv6_fragment_ext);
+	const struct rte_ipv6_hdr *in_hdr = rte_pktmbuf_mtod(pkt_in, const struct rte_ipv6_hdr *);
+	const uint8_t *payload = (const uint8_t *)(in_hdr + 1);
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	struct rte_ipv6_hdr *out_hdr;
+	struct rte_mbuf *out_pkt;
+	uint32_t payload_len;
+	uint16_t frag_size;
+	int32_t num_frags = 0;
+	uint32_t offset;
+	uint16_t len;
+
+	if (unlikely(mtu < frag_hdr_len + RTE_IPV6_EHDR_FO_ALIGN || !rte_pktmbuf_is_contiguous(pkt_in)))
+		return -EINVAL;
+
+	payload_len = rte_be_to_cpu_16(in_hdr->payload_len);
+	if (unlikely(sizeof(*in_hdr) + payload_len > rte_pktmbuf_data_len(pkt_in)))
+		return -EINVAL;
+
+	/* All fragments but the last one must carry a multiple of 8 bytes of payload */
+	frag_size = RTE_ALIGN_FLOOR(mtu - frag_hdr_len, RTE_IPV6_EHDR_FO_ALIGN);
+	if (unlikely((payload_len + frag_size - 1) / frag_size > pkts_out_max))
+		return -EINVAL;
+
+	for (offset = 0; offset < payload_len; offset += len) {
+		len = RTE_MIN(frag_size, payload_len - offset);
+
+		out_pkt = rte_pktmbuf_alloc(pool);
+		if (unlikely(!out_pkt))
+			goto err_free;
+
+		out_hdr = (struct rte_ipv6_hdr *)rte_pktmbuf_append(out_pkt, frag_hdr_len + len);
+		if (unlikely(!out_hdr)) {
+			rte_pktmbuf_free(out_pkt);
+			goto err_free;
+		}
+
+		memcpy(out_hdr, in_hdr, sizeof(*out_hdr));
+		out_hdr->proto = IPPROTO_FRAGMENT;
+		out_hdr->payload_len = rte_cpu_to_be_16(sizeof(*frag_hdr) + len);
+
+		frag_hdr = (struct rte_ipv6_fragment_ext *)(out_hdr + 1);
+		frag_hdr->next_header = in_hdr->proto;
+		frag_hdr->reserved = 0;
+		frag_hdr->frag_data = rte_cpu_to_be_16(RTE_IPV6_SET_FRAG_DATA(offset, offset + len < payload_len));
+		frag_hdr->id = rte_cpu_to_be_32(frag_id);
+
+		memcpy(frag_hdr + 1, payload + offset, len);
+		pkts_out[num_frags++] = out_pkt;
+	}
+
+	return num_frags;
+
+err_free:
+	rte_pktmbuf_free_bulk(pkts_out, num_frags);
+	return -ENOMEM;
+}
+
+/*
+ * Fragment the packet according to the configured mode. With mbuf chaining each fragment gets its headers written to
+ * a small header mbuf with the payload attached as an indirect mbuf, otherwise the payload is copied into the
+ * fragments.
+ *
+ * @wt_data [in]: worker thread data
+ * @parse_ctx [in]: pointer to the packet parser context
+ * @pkt_in [in]: packet starting at the IP header
+ * @pkts_out [out]: array to store the resulting fragments at
+ * @pkts_out_max [in]: size of the pkts_out array
+ * @mtu [in]: maximum size of the resulting fragments, including the IP header
+ * @return: number of resulting fragments on success and negative errno otherwise
+ */
 static int32_t ip_frag_mbuf_fragment(struct ip_frag_wt_data *wt_data,
 				     struct conn_parser_ctx *parse_ctx,
 				     struct rte_mbuf *pkt_in,
 				     struct rte_mbuf **pkts_out,
 				     uint16_t pkts_out_max,
-				     uint16_t mtu,
-				     struct rte_mempool *direct_pool,
-				     struct rte_mempool *indirect_pool)
+				     uint16_t mtu)
 {
 	if (parse_ctx->network_ctx.ip_version == DOCA_FLOW_PROTO_IPV4)
-		return wt_data->cfg->mbuf_chain ?
-			       rte_ipv4_fragment_packet(pkt_in, pkts_out, pkts_out_max, mtu, direct_pool, indirect_pool) :
-			       rte_ipv4_fragment_copy_nonseg_packet(pkt_in, pkts_out, pkts_out_max, mtu, direct_pool);
+		return wt_data->cfg->mbuf_chain ? rte_ipv4_fragment_packet(pkt_in,
+									   pkts_out,
+									   pkts_out_max,
+									   mtu,
+									   wt_data->hdr_pool,
+									   wt_data->indirect_pool) :
+						  rte_ipv4_fragment_copy_nonseg_packet(pkt_in,
+										       pkts_out,
+										       pkts_out_max,
+										       mtu,
+										       pkt_in->pool);
 	else
 		return wt_data->cfg->mbuf_chain ? rte_ipv6_fragment_packet(pkt_in,
 									   pkts_out,
 									   pkts_out_max,
 									   mtu,
-									   direct_pool,
-									   indirect_pool) :
-						  -EOPNOTSUPP;
+									   wt_data->hdr_pool,
+									   wt_data->indirect_pool) :
+						  ip_frag_ipv6_fragment_copy_nonseg_packet(pkt_in,
+											   pkts_out,
+											   pkts_out_max,
+											   mtu,
+											   pkt_in->pool,
+											   wt_data->ipv6_frag_id++);
 }
 
 /*
- * Fragment the packet, if necessary, and buffer resulting packets.
+ * Fragment a packet exceeding the MTU and buffer resulting packets.
  *
  * @wt_data [in]: worker thread data
  * @rx_port_id [in]: receive port id
  * @tx_port_id [in]: outgoing packet port id
  * @pkt [in]: packet
+ * @parse_ctx [in]: pointer to the packet parser context
  */
 static void ip_frag_pkt_fragment(struct ip_frag_wt_data *wt_data,
 				 uint16_t rx_port_id,
 				 uint16_t tx_port_id,
-				 struct rte_mbuf *pkt)
+				 struct rte_mbuf *pkt,
+				 struct conn_parser_ctx *parse_ctx)
 {
-	struct rte_eth_dev_tx_buffer *tx_buffer = wt_data->tx_buffer;
+	struct rte_eth_dev_tx_buffer *tx_buffer = wt_data->tx_buffers[tx_port_id];
 	uint8_t eth_hdr_copy[RTE_PKTMBUF_HEADROOM];
-	struct conn_parser_ctx parse_ctx;
 	size_t eth_hdr_len;
 	void *eth_hdr_new;
-	doca_error_t ret;
 	int num_frags;
 	int i;
 
-	memset(&parse_ctx, 0, sizeof(parse_ctx));
-	/* We only fragment the outer header and don't care about parsing encapsulation, so always treat the packet as
-	 * non-encapsulated. */
-	ret = plain_parse(rte_pktmbuf_mtod(pkt, uint8_t *),
-			  rte_pktmbuf_mtod(pkt, uint8_t *) + rte_pktmbuf_data_len(pkt),
-			  &parse_ctx);
-	if (ret != DOCA_SUCCESS) {
-		ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
-		DOCA_LOG_DBG("Failed to parse packet status %u", ret);
-		return;
-	}
-
-	if (rte_pktmbuf_pkt_len(pkt) <= wt_data->cfg->mtu) {
-		wt_data->sw_counters[rx_port_id].mtu_fits_rx++;
-		rte_eth_tx_buffer(tx_port_id, wt_data->queue_id, tx_buffer, pkt);
-		return;
-	}
-
-	wt_data->sw_counters[rx_port_id].mtu_exceed_rx++;
-	eth_hdr_len = parse_ctx.link_ctx.len;
+	eth_hdr_len = parse_ctx->link_ctx.len;
 	if (sizeof(eth_hdr_copy) < eth_hdr_len) {
 		ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
 		DOCA_LOG_ERR("Ethernet header size %lu too big", eth_hdr_len);
 		return;
 	}
-	memcpy(eth_hdr_copy, parse_ctx.link_ctx.eth, eth_hdr_len);
+	memcpy(eth_hdr_copy, parse_ctx->link_ctx.eth, eth_hdr_len);
 	rte_pktmbuf_adj(pkt, eth_hdr_len);
 
 	num_frags = ip_frag_mbuf_fragment(wt_data,
-					  &parse_ctx,
+					  parse_ctx,
 					  pkt,
 					  &tx_buffer->pkts[tx_buffer->length],
 					  tx_buffer->size - tx_buffer->length,
-					  wt_data->cfg->mtu - eth_hdr_len,
-					  pkt->pool,
-					  wt_data->indirect_pool);
+					  wt_data->cfg->mtu - eth_hdr_len);
 	if (num_frags < 0) {
 		ip_frag_pkt_err_drop(wt_data, rx_port_id, pkt);
 		DOCA_LOG_ERR("RTE fragmentation failed with code: %d", -num_frags);
@@ -655,7 +975,7 @@ static void ip_frag_pkt_fragment(struct ip_frag_wt_data *wt_data,
 
 	for (i = tx_buffer->length; i < tx_buffer->length + num_frags; i++) {
 		pkt = tx_buffer->pkts[i];
-		if (parse_ctx.network_ctx.ip_version == DOCA_FLOW_PROTO_IPV4)
+		if (parse_ctx->network_ctx.ip_version == DOCA_FLOW_PROTO_IPV4)
 			ip_frag_ipv4_cksum_handle(wt_data,
 						  pkt,
 						  eth_hdr_len,
@@ -672,43 +992,36 @@ static void ip_frag_pkt_fragment(struct ip_frag_wt_data *wt_data,
 }
 
 /*
- * Fragment the packet burst buffering any resulting packets. Flush the tx buffer when it gets path threshold packets.
- * Flush the tx buffer when it gets path threshold packets.
+ * Fragment the over-MTU vector of the current burst buffering any resulting packets. The tx buffer is only flushed
+ * early when it runs below the threshold of free slots, otherwise it is left for the end of loop iteration flush.
  *
  * @wt_data [in]: worker thread data
  * @rx_port_id [in]: receive port id
  * @tx_port_id [in]: outgoing packet port id
- * @pkts [in]: packet burst
- * @pkts_cnt [in]: number of packets in the burst
  */
-static void ip_frag_pkts_fragment(struct ip_frag_wt_data *wt_data,
-				  uint16_t rx_port_id,
-				  uint16_t tx_port_id,
-				  struct rte_mbuf *pkts[],
-				  int pkts_cnt)
+static void ip_frag_burst_fragment(struct ip_frag_wt_data *wt_data, uint16_t rx_port_id, uint16_t tx_port_id)
 {
-	struct rte_eth_dev_tx_buffer *tx_buffer = wt_data->tx_buffer;
-	int i; /* prefetch calculation can yield negative values */
+	struct rte_eth_dev_tx_buffer *tx_buffer = wt_data->tx_buffers[tx_port_id];
+	struct ip_frag_burst *burst = wt_data->burst;
+	uint16_t idx;
+	uint16_t i;
 
-	for (i = 0; i < IP_FRAG_BURST_PREFETCH && i < pkts_cnt; i++)
-		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+	for (i = 0; i < IP_FRAG_PREFETCH_OFFSET; i++)
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_FRAGMENT, i);
 
-	for (i = 0; i < (pkts_cnt - IP_FRAG_BURST_PREFETCH); i++) {
-		rte_prefetch0(rte_pktmbuf_mtod(pkts[i + IP_FRAG_BURST_PREFETCH], void *));
-		ip_frag_pkt_fragment(wt_data, rx_port_id, tx_port_id, pkts[i]);
-		if (tx_buffer->size - tx_buffer->length < IP_FRAG_FLUSH_THRESHOLD)
-			rte_eth_tx_buffer_flush(tx_port_id, wt_data->queue_id, tx_buffer);
-	}
+	for (i = 0; i < burst->vec_cnt[IP_FRAG_VEC_FRAGMENT]; i++) {
+		ip_frag_burst_vec_prefetch(burst, IP_FRAG_VEC_FRAGMENT, i + IP_FRAG_PREFETCH_OFFSET);
 
-	for (; i < pkts_cnt; i++) {
-		ip_frag_pkt_fragment(wt_data, rx_port_id, tx_port_id, pkts[i]);
 		if (tx_buffer->size - tx_buffer->length < IP_FRAG_FLUSH_THRESHOLD)
 			rte_eth_tx_buffer_flush(tx_port_id, wt_data->queue_id, tx_buffer);
+
+		idx = burst->vecs[IP_FRAG_VEC_FRAGMENT][i];
+		ip_frag_pkt_fragment(wt_data, rx_port_id, tx_port_id, burst->pkts[idx], &burst->parse_ctxs[idx].inner);
 	}
 }
 
 /*
- * Receive a burst of packets on rx port, fragment any larger than MTU, and send resulting packets on the tx port.
+ * Receive a burst of packets on rx port, fragment any larger than MTU, and buffer resulting packets for the tx port.
  *
  * @wt_data [in]: worker thread data
  * @rx_port_id [in]: receive port id
@@ -716,12 +1029,48 @@ static void ip_frag_pkts_fragment(struct ip_frag_wt_data *wt_data,
  */
 static void ip_frag_wt_fragment(struct ip_frag_wt_data *wt_data, uint16_t rx_port_id, uint16_t tx_port_id)
 {
-	struct rte_mbuf *pkts[IP_FRAG_MAX_PKT_BURST];
+	struct ip_frag_burst *burst = wt_data->burst;
+	uint64_t tsc = rte_rdtsc();
 	uint16_t pkts_cnt;
 
-	pkts_cnt = rte_eth_rx_burst(rx_port_id, wt_data->queue_id, pkts, IP_FRAG_MAX_PKT_BURST);
-	ip_frag_pkts_fragment(wt_data, rx_port_id, tx_port_id, pkts, pkts_cnt);
-	rte_eth_tx_buffer_flush(tx_port_id, wt_data->queue_id, wt_data->tx_buffer);
+	pkts_cnt = rte_eth_rx_burst(rx_port_id, wt_data->queue_id, burst->pkts, wt_data->cfg->burst_size);
+	if (!pkts_cnt)
+		return;
+	tsc = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_RX, tsc, pkts_cnt);
+
+	ip_frag_burst_classify(wt_data, rx_port_id, PARSER_PKT_TYPE_PLAIN, false, pkts_cnt);
+	tsc = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_CLASSIFY, tsc, pkts_cnt);
+
+	ip_frag_burst_whole_send(wt_data, tx_port_id, false);
+	tsc = ip_frag_stage_account(wt_data, IP_FRAG_STAGE_WHOLE, tsc, burst->vec_cnt[IP_FRAG_VEC_WHOLE]);
+
+	ip_frag_burst_fragment(wt_data, rx_port_id, tx_port_id);
+	ip_frag_stage_account(wt_data, IP_FRAG_STAGE_FRAGMENT, tsc, burst->vec_cnt[IP_FRAG_VEC_FRAGMENT]);
+}
+
+/*
+ * Flush the tx buffers of all ports, once per worker loop iteration.
+ *
+ * @wt_data [in]: worker thread data
+ */
+static void ip_frag_wt_flush(struct ip_frag_wt_data *wt_data)
+{
+	struct rte_eth_dev_tx_buffer *tx_buffer;
+	uint64_t tsc = rte_rdtsc();
+	uint32_t pkts_cnt = 0;
+	uint16_t port_id;
+
+	for (port_id = 0; port_id < IP_FRAG_PORT_NUM; port_id++) {
+		tx_buffer = wt_data->tx_buffers[port_id];
+		if (!tx_buffer || !tx_buffer->length)
+			continue;
+
+		pkts_cnt += tx_buffer->length;
+		rte_eth_tx_buffer_flush(port_id, wt_data->queue_id, tx_buffer);
+	}
+
+	if (pkts_cnt)
+		ip_frag_stage_account(wt_data, IP_FRAG_STAGE_TX, tsc, pkts_cnt);
 }
 
 /*
@@ -760,6 +1109,8 @@ static int ip_frag_wt_thread_main(void *param)
 			DOCA_LOG_ERR("Unsupported application mode: %u", wt_data->cfg->mode);
 			return EINVAL;
 		};
+
+		ip_frag_wt_flush(wt_data);
 	}
 
 	return 0;
@@ -800,13 +1151,18 @@ static doca_error_t ip_frag_mbuf_flags_init(struct ip_frag_config *cfg)
 }
 
 /*
- * Initialize indirect fragmentation mempools
+ * Initialize per-socket fragmentation mempools
  *
+ * @name [in]: mempool name prefix
  * @nb_queues [in]: number of device queues
- * @indirect_pools [out]: Per-socket array of indirect fragmentation mempools
+ * @data_room_size [in]: mbuf data room size
+ * @pools [out]: Per-socket array of mempools
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t ip_frag_indirect_pool_init(uint16_t nb_queues, struct rte_mempool *indirect_pools[])
+static doca_error_t ip_frag_socket_pools_init(const char *name,
+					      uint16_t nb_queues,
+					      uint16_t data_room_size,
+					      struct rte_mempool *pools[])
 {
 	char mempool_name[RTE_MEMPOOL_NAMESIZE];
 	unsigned socket;
@@ -816,20 +1172,20 @@ static doca_error_t ip_frag_indirect_pool_init(uint16_t nb_queues, struct rte_me
 	{
 		socket = rte_lcore_to_socket_id(lcore);
 
-		if (!indirect_pools[socket]) {
-			snprintf(mempool_name, sizeof(mempool_name), "Indirect mempool %u", socket);
-			indirect_pools[socket] = rte_pktmbuf_pool_create(mempool_name,
-									 NUM_MBUFS * nb_queues,
-									 MBUF_CACHE_SIZE,
-									 0,
-									 0,
-									 socket);
-			if (!indirect_pools[socket]) {
-				DOCA_LOG_ERR("Failed to allocate indirect mempool for socket %u", socket);
+		if (!pools[socket]) {
+			snprintf(mempool_name, sizeof(mempool_name), "%s mempool %u", name, socket);
+			pools[socket] = rte_pktmbuf_pool_create(mempool_name,
+								NUM_MBUFS * nb_queues,
+								MBUF_CACHE_SIZE,
+								0,
+								data_room_size,
+								socket);
+			if (!pools[socket]) {
+				DOCA_LOG_ERR("Failed to allocate %s mempool for socket %u", name, socket);
 				return DOCA_ERROR_NO_MEMORY;
 			}
 
-			DOCA_LOG_DBG("Indirect mempool for socket %u initialized", socket);
+			DOCA_LOG_DBG("%s mempool for socket %u initialized", name, socket);
 		}
 	}
 
@@ -845,6 +1201,7 @@ static void ip_frag_wt_data_cleanup(struct ip_frag_wt_data *wt_data_arr)
 {
 	struct ip_frag_wt_data *wt_data;
 	unsigned lcore;
+	int port_id;
 
 	RTE_LCORE_FOREACH_WORKER(lcore)
 	{
@@ -852,7 +1209,9 @@ static void ip_frag_wt_data_cleanup(struct ip_frag_wt_data *wt_data_arr)
 
 		if (wt_data->frag_tbl)
 			rte_ip_frag_table_destroy(wt_data->frag_tbl);
-		rte_free(wt_data->tx_buffer);
+		for (port_id = 0; port_id < IP_FRAG_PORT_NUM; port_id++)
+			rte_free(wt_data->tx_buffers[port_id]);
+		rte_free(wt_data->burst);
 	}
 
 	rte_free(wt_data_arr);
@@ -862,17 +1221,24 @@ static void ip_frag_wt_data_cleanup(struct ip_frag_wt_data *wt_data_arr)
  * Allocate and initialize ip_frag worker thread data
  *
  * @cfg [in]: application config
+ * @nb_ports [in]: number of ports
  * @indirect_pools [in]: Per-socket array of indirect fragmentation mempools
+ * @hdr_pools [in]: Per-socket array of fragment header mempools
  * @wt_data_arr_out [out]: worker thread data array
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
 static doca_error_t ip_frag_wt_data_init(const struct ip_frag_config *cfg,
+					 uint16_t nb_ports,
 					 struct rte_mempool *indirect_pools[],
+					 struct rte_mempool *hdr_pools[],
 					 struct ip_frag_wt_data **wt_data_arr_out)
 {
+	/* Leave enough room to buffer a whole burst of fragmented packets until the end of loop iteration flush */
+	const uint16_t tx_buffer_size = cfg->burst_size * IP_FRAG_TX_BUFFER_FACTOR;
 	struct ip_frag_wt_data *wt_data_arr;
 	struct ip_frag_wt_data *wt_data;
 	uint16_t queue_id = 0;
+	uint16_t port_id;
 	doca_error_t ret;
 	unsigned lcore;
 
@@ -887,21 +1253,35 @@ static doca_error_t ip_frag_wt_data_init(const struct ip_frag_config *cfg,
 		wt_data = &wt_data_arr[lcore];
 		wt_data->cfg = cfg;
 		wt_data->indirect_pool = indirect_pools[rte_lcore_to_socket_id(lcore)];
+		wt_data->hdr_pool = hdr_pools[rte_lcore_to_socket_id(lcore)];
+		wt_data->ipv6_frag_id = (uint32_t)rte_rand();
 		wt_data->queue_id = queue_id++;
 
-		wt_data->tx_buffer = rte_zmalloc_socket("TX buffer",
-							RTE_ETH_TX_BUFFER_SIZE(IP_FRAG_MAX_PKT_BURST),
-							RTE_CACHE_LINE_SIZE,
-							rte_lcore_to_socket_id(lcore));
-		if (!wt_data->tx_buffer) {
-			DOCA_LOG_ERR("Failed to allocate worker thread tx buffer");
+		wt_data->burst = rte_zmalloc_socket("Burst",
+						    sizeof(*wt_data->burst),
+						    RTE_CACHE_LINE_SIZE,
+						    rte_lcore_to_socket_id(lcore));
+		if (!wt_data->burst) {
+			DOCA_LOG_ERR("Failed to allocate worker thread burst state");
 			ret = DOCA_ERROR_NO_MEMORY;
 			goto cleanup;
 		}
-		rte_eth_tx_buffer_init(wt_data->tx_buffer, IP_FRAG_MAX_PKT_BURST);
-		rte_eth_tx_buffer_set_err_callback(wt_data->tx_buffer,
-						   rte_eth_tx_buffer_count_callback,
-						   &wt_data->tx_buffer_err);
+
+		for (port_id = 0; port_id < nb_ports; port_id++) {
+			wt_data->tx_buffers[port_id] = rte_zmalloc_socket("TX buffer",
+									  RTE_ETH_TX_BUFFER_SIZE(tx_buffer_size),
+									  RTE_CACHE_LINE_SIZE,
+									  rte_lcore_to_socket_id(lcore));
+			if (!wt_data->tx_buffers[port_id]) {
+				DOCA_LOG_ERR("Failed to allocate worker thread tx buffer");
+				ret = DOCA_ERROR_NO_MEMORY;
+				goto cleanup;
+			}
+			rte_eth_tx_buffer_init(wt_data->tx_buffers[port_id], tx_buffer_size);
+			rte_eth_tx_buffer_set_err_callback(wt_data->tx_buffers[port_id],
+							   rte_eth_tx_buffer_count_callback,
+							   &wt_data->tx_buffer_err);
+		}
 
 		wt_data->frag_tbl =
 			rte_ip_frag_table_create(cfg->frag_tbl_size,
@@ -1024,6 +1404,48 @@ static void ip_frag_tx_buffer_error_print(struct ip_frag_wt_data *wt_data_arr)
 	DOCA_LOG_INFO("TOTAL tx_buffer    err=%lu", sum);
 }
 
+/*
+ * Print per-stage cycle counters of each worker
+ *
+ * @wt_data_arr [in]: worker thread data array
+ */
+static void ip_frag_stage_counters_print(struct ip_frag_wt_data *wt_data_arr)
+{
+	struct ip_frag_stage_counters sum[IP_FRAG_STAGE_NUM] = {0};
+	struct ip_frag_stage_counters *counters;
+	struct ip_frag_wt_data *wt_data;
+	unsigned lcore;
+	int stage;
+
+	DOCA_LOG_INFO("//////////////////// STAGE CYCLES ////////////////////");
+
+	RTE_LCORE_FOREACH(lcore)
+	{
+		wt_data = &wt_data_arr[lcore];
+
+		for (stage = 0; stage < IP_FRAG_STAGE_NUM; stage++) {
+			counters = &wt_data->stage_counters[stage];
+
+			DOCA_LOG_INFO("Core stage %3u %-10s cycles=%-14lu pkts=%-10lu cycles/pkt=%-8lu",
+				      lcore,
+				      ip_frag_stage_names[stage],
+				      counters->cycles,
+				      counters->pkts,
+				      counters->pkts ? counters->cycles / counters->pkts : 0);
+
+			sum[stage].cycles += counters->cycles;
+			sum[stage].pkts += counters->pkts;
+		}
+	}
+
+	for (stage = 0; stage < IP_FRAG_STAGE_NUM; stage++)
+		DOCA_LOG_INFO("TOTAL stage    %-10s cycles=%-14lu pkts=%-10lu cycles/pkt=%-8lu",
+			      ip_frag_stage_names[stage],
+			      sum[stage].cycles,
+			      sum[stage].pkts,
+			      sum[stage].pkts ? sum[stage].cycles / sum[stage].pkts : 0);
+}
+
 /*
  * Print SW debug counters of each worker
  *
@@ -1061,6 +1483,8 @@ static void ip_frag_debug_counters_print(struct ip_frag_ctx *ctx, struct ip_frag
 	DOCA_LOG_INFO("");
 	ip_frag_sw_counters_print(ctx, wt_data_arr);
 	DOCA_LOG_INFO("");
+	ip_frag_stage_counters_print(wt_data_arr);
+	DOCA_LOG_INFO("");
 }
 
 /*
@@ -1243,6 +1667,7 @@ static doca_error_t ip_frag_rss_pipes_create(struct ip_frag_ctx *ctx)
 doca_error_t ip_frag(struct ip_frag_config *cfg, struct application_dpdk_config *dpdk_cfg)
 {
 	struct rte_mempool *indirect_pools[RTE_MAX_NUMA_NODES] = {NULL};
+	struct rte_mempool *hdr_pools[RTE_MAX_NUMA_NODES] = {NULL};
 	uint32_t nr_shared_resources[SHARED_RESOURCE_NUM_VALUES] = {0};
 	struct ip_frag_ctx ctx = {
 		.num_ports = dpdk_cfg->port_config.nb_ports,
@@ -1253,34 +1678,49 @@ doca_error_t ip_frag(struct ip_frag_config *cfg, struct application_dpdk_config
 	struct flow_resources resource = {0};
 	doca_error_t ret;
 
-	ret = init_doca_flow(ctx.num_queues, "vnf,hws", &resource, nr_shared_resources);
-	if (ret != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to init DOCA Flow: %s", doca_error_get_descr(ret));
-		return ret;
+	if (cfg->flow_disable) {
+		/* Ports DOCA Flow can't drive (e.g. net_pcap vdevs) are left unsteered, all traffic lands on queue 0 */
+		if (ctx.num_queues > 1)
+			DOCA_LOG_WARN("DOCA Flow steering disabled, only the first of %u queues will receive packets",
+				      ctx.num_queues);
+	} else {
+		ret = init_doca_flow(ctx.num_queues, "vnf,hws", &resource, nr_shared_resources);
+		if (ret != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to init DOCA Flow: %s", doca_error_get_descr(ret));
+			return ret;
+		}
 	}
 
 	ret = ip_frag_mbuf_flags_init(cfg);
 	if (ret != DOCA_SUCCESS)
 		goto cleanup_doca_flow;
 
-	ret = ip_frag_indirect_pool_init(ctx.num_queues, indirect_pools);
+	ret = ip_frag_socket_pools_init("Indirect", ctx.num_queues, 0, indirect_pools);
 	if (ret != DOCA_SUCCESS)
 		goto cleanup_doca_flow;
 
-	ret = ip_frag_wt_data_init(cfg, indirect_pools, &wt_data_arr);
+	if (cfg->mbuf_chain) {
+		ret = ip_frag_socket_pools_init("Header", ctx.num_queues, IP_FRAG_HDR_MBUF_DATA_SIZE, hdr_pools);
+		if (ret != DOCA_SUCCESS)
+			goto cleanup_doca_flow;
+	}
+
+	ret = ip_frag_wt_data_init(cfg, ctx.num_ports, indirect_pools, hdr_pools, &wt_data_arr);
 	if (ret != DOCA_SUCCESS)
 		goto cleanup_doca_flow;
 
-	ret = init_doca_flow_ports(ctx.num_ports, ctx.ports, false, ctx.dev_arr, actions_mem_size);
-	if (ret != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to init DOCA ports: %s", doca_error_get_descr(ret));
-		goto cleanup_wt_data;
-	}
+	if (!cfg->flow_disable) {
+		ret = init_doca_flow_ports(ctx.num_ports, ctx.ports, false, ctx.dev_arr, actions_mem_size);
+		if (ret != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to init DOCA ports: %s", doca_error_get_descr(ret));
+			goto cleanup_wt_data;
+		}
 
-	ret = ip_frag_rss_pipes_create(&ctx);
-	if (ret != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to pipes: %s", doca_error_get_descr(ret));
-		goto cleanup_ports;
+		ret = ip_frag_rss_pipes_create(&ctx);
+		if (ret != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to pipes: %s", doca_error_get_descr(ret));
+			goto cleanup_ports;
+		}
 	}
 
 	DOCA_LOG_INFO("Initialization finished, starting data path");
@@ -1292,12 +1732,15 @@ doca_error_t ip_frag(struct ip_frag_config *cfg, struct application_dpdk_config
 
 	ip_frag_debug_counters_print(&ctx, wt_data_arr);
 cleanup_ports:
-	ret = stop_doca_flow_ports(ctx.num_ports, ctx.ports);
-	if (ret != DOCA_SUCCESS)
-		DOCA_LOG_ERR("Failed to stop doca flow ports: %s", doca_error_get_descr(ret));
+	if (!cfg->flow_disable) {
+		ret = stop_doca_flow_ports(ctx.num_ports, ctx.ports);
+		if (ret != DOCA_SUCCESS)
+			DOCA_LOG_ERR("Failed to stop doca flow ports: %s", doca_error_get_descr(ret));
+	}
 cleanup_wt_data:
 	ip_frag_wt_data_cleanup(wt_data_arr);
 cleanup_doca_flow:
-	doca_flow_destroy();
+	if (!cfg->flow_disable)
+		doca_flow_destroy();
 	return ret;
 }
@@ -34,6 +34,9 @@
 
 #define UNUSED(x) ((void)(x))
 
+#define IP_FRAG_MAX_BURST_SIZE 256
+#define IP_FRAG_DEFAULT_BURST_SIZE 32
+
 enum ip_frag_mode {
 	IP_FRAG_MODE_BIDIR,
 	IP_FRAG_MODE_MULTIPORT,
@@ -59,9 +62,12 @@ struct ip_frag_config {
 	uint64_t mbuf_flag_inner_modified; /* RTE mbuf inner fragmentation flag mask */
 	uint16_t mtu;			   /* MTU */
 	bool mbuf_chain;		   /* Use chained mbuf optimization */
+	bool tx_multi_seg;		   /* All ports support multi-segment TX */
 	bool hw_cksum;			   /* Use hardware checksum optimization */
 	uint32_t frag_tbl_timeout;	   /* Fragmentation table timeout in ms */
 	uint32_t frag_tbl_size;		   /* Fragmentation table size */
+	uint16_t burst_size;		   /* RX burst size */
+	bool flow_disable;		   /* Skip DOCA Flow steering, e.g. for net_pcap vdevs */
 };
 
 struct ip_frag_pipe_cfg {
@@ -0,0 +1,664 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_mbuf.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <packet_parser_burst.h>
+
+DOCA_LOG_REGISTER(IP_FRAG_PARSER_BENCH);
+
+#define BENCH_DEFAULT_ITERATIONS 1000		    /* Default number of passes over the packets */
+#define BENCH_DEFAULT_BURST_SIZE 32		    /* Default number of packets per parsed burst */
+#define BENCH_MAX_PATH_LEN 1024			    /* Maximal length of the pcap file path */
+#define BENCH_MAX_MIXES 64			    /* Maximal number of distinct protocol mixes reported */
+#define BENCH_MAX_MIX_NAME_LEN 96		    /* Maximal length of a protocol mix name */
+#define BENCH_MAX_PKT_LEN RTE_MBUF_DEFAULT_DATAROOM /* Packets are truncated to a single default mbuf */
+
+#define PCAP_MAGIC_US 0xa1b2c3d4 /* pcap file with microsecond timestamps */
+#define PCAP_MAGIC_NS 0xa1b23c4d /* pcap file with nanosecond timestamps */
+#define PCAP_LINKTYPE_ETHERNET 1 /* Ethernet link type */
+
+/* pcap file header */
+struct pcap_file_hdr {
+	uint32_t magic;		/* File format and byte order magic */
+	uint16_t version_major;	/* Major version */
+	uint16_t version_minor;	/* Minor version */
+	int32_t thiszone;	/* Time zone correction */
+	uint32_t sigfigs;	/* Timestamps accuracy */
+	uint32_t snaplen;	/* Maximal captured length */
+	uint32_t linktype;	/* Link-layer header type */
+};
+
+/* pcap record header */
+struct pcap_rec_hdr {
+	uint32_t ts_sec;  /* Timestamp seconds */
+	uint32_t ts_frac; /* Timestamp microseconds or nanoseconds */
+	uint32_t caplen;  /* Captured length */
+	uint32_t len;	  /* Original length */
+};
+
+struct bench_config {
+	char pcap_path[BENCH_MAX_PATH_LEN]; /* pcap file to parse */
+	uint32_t iterations;		    /* Number of passes over the packets */
+	uint16_t burst_size;		    /* Number of packets per parsed burst */
+};
+
+/* Packets loaded from the pcap file */
+struct bench_pkts {
+	uint8_t *arena;		/* Memory holding the mbufs and their data */
+	struct rte_mbuf **pkts;	/* Packets in file order */
+	uint32_t *pkt_mix;	/* Protocol mix of each packet */
+	uint32_t nb_pkts;	/* Number of packets */
+};
+
+/* Packets sharing the same protocol stack */
+struct bench_mix {
+	char name[BENCH_MAX_MIX_NAME_LEN]; /* Protocol stack description */
+	bool parsed;			   /* False if the parsers reject the packets */
+	struct rte_mbuf **pkts;		   /* Packets of the mix */
+	uint32_t nb_pkts;		   /* Number of packets of the mix */
+};
+
+/* Timing of a packets set */
+struct bench_result {
+	uint64_t burst_cycles;	/* TSC cycles spent in parser_burst_parse() */
+	uint64_t single_cycles;	/* TSC cycles spent in per-packet unknown_parse() */
+	uint64_t nb_slow_path;	/* Packets that took the slow path of the burst API */
+	uint64_t nb_pkts;	/* Packets parsed by each API */
+};
+
+/*
+ * ARGP Callback - Handle pcap file parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t pcap_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	const char *path = (const char *)param;
+
+	if (strnlen(path, BENCH_MAX_PATH_LEN) == BENCH_MAX_PATH_LEN) {
+		DOCA_LOG_ERR("pcap file path is too long, max %d", BENCH_MAX_PATH_LEN - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->pcap_path, path);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle iterations parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t iterations_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int iterations = *(int *)param;
+
+	if (iterations <= 0) {
+		DOCA_LOG_ERR("Number of iterations must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->iterations = iterations;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle burst size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t burst_size_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int burst_size = *(int *)param;
+
+	if (burst_size <= 0 || burst_size > PARSER_BURST_MAX_SIZE) {
+		DOCA_LOG_ERR("Burst size must be between 1 and %d", PARSER_BURST_MAX_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->burst_size = burst_size;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *pcap_param, *iterations_param, *burst_size_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&pcap_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(pcap_param, "f");
+	doca_argp_param_set_long_name(pcap_param, "pcap");
+	doca_argp_param_set_arguments(pcap_param, "<path>");
+	doca_argp_param_set_description(pcap_param, "pcap file of Ethernet packets to parse");
+	doca_argp_param_set_callback(pcap_param, pcap_callback);
+	doca_argp_param_set_type(pcap_param, DOCA_ARGP_TYPE_STRING);
+	doca_argp_param_set_mandatory(pcap_param);
+	result = doca_argp_register_param(pcap_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(iterations_param, "i");
+	doca_argp_param_set_long_name(iterations_param, "iterations");
+	doca_argp_param_set_description(iterations_param, "Number of passes over the packets");
+	doca_argp_param_set_callback(iterations_param, iterations_callback);
+	doca_argp_param_set_type(iterations_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(burst_size_param, "b");
+	doca_argp_param_set_long_name(burst_size_param, "burst-size");
+	doca_argp_param_set_description(burst_size_param, "Number of packets per parsed burst");
+	doca_argp_param_set_callback(burst_size_param, burst_size_callback);
+	doca_argp_param_set_type(burst_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Get the length of the memory holding a packet mbuf and its data, laid out as in a pktmbuf pool
+ *
+ * @caplen [in]: packet length
+ * @return: the length, a multiple of the cache line size
+ */
+static size_t bench_pkt_elt_size(uint32_t caplen)
+{
+	return RTE_ALIGN_CEIL(sizeof(struct rte_mbuf) + RTE_PKTMBUF_HEADROOM + caplen, RTE_CACHE_LINE_SIZE);
+}
+
+/*
+ * Read the packets of a pcap file into mbufs.
+ * The mbufs do not belong to a mempool, so the benchmark runs without the EAL, but their layout follows the one of a
+ * pktmbuf pool.
+ *
+ * @path [in]: pcap file path
+ * @pkts [out]: the loaded packets
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pcap_load(const char *path, struct bench_pkts *pkts)
+{
+	struct pcap_file_hdr file_hdr;
+	struct pcap_rec_hdr rec_hdr;
+	struct rte_mbuf *pkt;
+	uint32_t nb_truncated = 0;
+	uint32_t caplen, i;
+	size_t arena_len = 0;
+	size_t offset = 0;
+	doca_error_t result;
+	bool swapped;
+	FILE *file;
+
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		DOCA_LOG_ERR("Failed to open pcap file %s", path);
+		return DOCA_ERROR_NOT_FOUND;
+	}
+
+	if (fread(&file_hdr, sizeof(file_hdr), 1, file) != 1) {
+		DOCA_LOG_ERR("Failed to read the pcap file header");
+		result = DOCA_ERROR_IO_FAILED;
+		goto close_file;
+	}
+	if (file_hdr.magic == PCAP_MAGIC_US || file_hdr.magic == PCAP_MAGIC_NS) {
+		swapped = false;
+	} else if (file_hdr.magic == rte_bswap32(PCAP_MAGIC_US) || file_hdr.magic == rte_bswap32(PCAP_MAGIC_NS)) {
+		swapped = true;
+		file_hdr.linktype = rte_bswap32(file_hdr.linktype);
+	} else {
+		DOCA_LOG_ERR("%s is not a pcap file, pcapng files are not supported", path);
+		result = DOCA_ERROR_NOT_SUPPORTED;
+		goto close_file;
+	}
+	if (file_hdr.linktype != PCAP_LINKTYPE_ETHERNET) {
+		DOCA_LOG_ERR("Unsupported pcap link type %u, only Ethernet is supported", file_hdr.linktype);
+		result = DOCA_ERROR_NOT_SUPPORTED;
+		goto close_file;
+	}
+
+	/* First pass sizes the arena, the second one fills it */
+	while (fread(&rec_hdr, sizeof(rec_hdr), 1, file) == 1) {
+		caplen = swapped ? rte_bswap32(rec_hdr.caplen) : rec_hdr.caplen;
+		if (fseek(file, caplen, SEEK_CUR) != 0)
+			break;
+		arena_len += bench_pkt_elt_size(RTE_MIN(caplen, (uint32_t)BENCH_MAX_PKT_LEN));
+		pkts->nb_pkts++;
+	}
+	if (pkts->nb_pkts == 0) {
+		DOCA_LOG_ERR("No packets in pcap file %s", path);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto close_file;
+	}
+
+	pkts->arena = aligned_alloc(RTE_CACHE_LINE_SIZE, arena_len);
+	pkts->pkts = calloc(pkts->nb_pkts, sizeof(*pkts->pkts));
+	if (pkts->arena == NULL || pkts->pkts == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u packets", pkts->nb_pkts);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_pkts;
+	}
+
+	fseek(file, sizeof(file_hdr), SEEK_SET);
+	for (i = 0; i < pkts->nb_pkts; i++) {
+		if (fread(&rec_hdr, sizeof(rec_hdr), 1, file) != 1) {
+			DOCA_LOG_ERR("Failed to read pcap record %u", i);
+			result = DOCA_ERROR_IO_FAILED;
+			goto free_pkts;
+		}
+		caplen = swapped ? rte_bswap32(rec_hdr.caplen) : rec_hdr.caplen;
+
+		pkt = (struct rte_mbuf *)(pkts->arena + offset);
+		memset(pkt, 0, sizeof(*pkt));
+		pkt->buf_addr = (uint8_t *)pkt + sizeof(*pkt);
+		pkt->buf_len = RTE_PKTMBUF_HEADROOM + RTE_MIN(caplen, (uint32_t)BENCH_MAX_PKT_LEN);
+		pkt->data_off = RTE_PKTMBUF_HEADROOM;
+		pkt->data_len = RTE_MIN(caplen, (uint32_t)BENCH_MAX_PKT_LEN);
+		pkt->pkt_len = pkt->data_len;
+		pkt->nb_segs = 1;
+		if (fread(rte_pktmbuf_mtod(pkt, void *), 1, pkt->data_len, file) != pkt->data_len ||
+		    fseek(file, caplen - pkt->data_len, SEEK_CUR) != 0) {
+			DOCA_LOG_ERR("Failed to read pcap record %u", i);
+			result = DOCA_ERROR_IO_FAILED;
+			goto free_pkts;
+		}
+		if (caplen > BENCH_MAX_PKT_LEN)
+			nb_truncated++;
+
+		pkts->pkts[i] = pkt;
+		offset += bench_pkt_elt_size(pkt->data_len);
+	}
+	fclose(file);
+
+	if (nb_truncated)
+		DOCA_LOG_WARN("%u packets were truncated to %u bytes", nb_truncated, BENCH_MAX_PKT_LEN);
+	return DOCA_SUCCESS;
+
+free_pkts:
+	free(pkts->pkts);
+	free(pkts->arena);
+close_file:
+	fclose(file);
+	return result;
+}
+
+/*
+ * Append the name of a connection headers stack to a protocol mix name
+ *
+ * @name [in/out]: protocol mix name
+ * @ptype [in]: PARSER_PTYPE_* flags of the headers, as outer flags
+ * @has_link [in]: true if the headers start with an Ethernet header
+ */
+static void bench_mix_name_append(char *name, uint32_t ptype, bool has_link)
+{
+	size_t len = strlen(name);
+
+	snprintf(name + len,
+		 BENCH_MAX_MIX_NAME_LEN - len,
+		 "%s%s%s%s%s%s%s",
+		 len ? "/" : "",
+		 has_link ? "eth/" : "",
+		 ptype & PARSER_PTYPE_VLAN ? "vlan/" : "",
+		 ptype & PARSER_PTYPE_IPV4 ? "ipv4" : (ptype & PARSER_PTYPE_IPV6 ? "ipv6" : "?"),
+		 ptype & PARSER_PTYPE_FRAG ? "/frag" : "",
+		 ptype & PARSER_PTYPE_TCP ? "/tcp" : "",
+		 ptype & PARSER_PTYPE_UDP ? "/udp" : "");
+}
+
+/*
+ * Get the name of the protocol mix of a parsed packet
+ *
+ * @res [in]: burst result
+ * @i [in]: packet index in the burst
+ * @name [out]: protocol mix name
+ * @return: true if the parsers accept the packet and false otherwise
+ */
+static bool bench_mix_name_get(const struct parser_burst *res, uint16_t i, char *name)
+{
+	uint32_t ptype = res->ptype[i];
+
+	name[0] = '\0';
+	if (res->status[i] != DOCA_SUCCESS && res->status[i] != DOCA_ERROR_AGAIN) {
+		snprintf(name, BENCH_MAX_MIX_NAME_LEN, "unparsed (%s)", doca_error_get_name(res->status[i]));
+		return false;
+	}
+
+	bench_mix_name_append(name, ptype, true);
+	if (ptype & PARSER_PTYPE_VXLAN) {
+		strcat(name, "/vxlan");
+		bench_mix_name_append(name, ptype >> 8, true);
+	} else if (ptype & PARSER_PTYPE_GTPU) {
+		strcat(name, "/gtpu");
+		bench_mix_name_append(name, ptype >> 8, false);
+	}
+	return true;
+}
+
+/*
+ * Split the packets to protocol mixes. Packets of mixes beyond the first BENCH_MAX_MIXES - 1 ones are gathered in an
+ * "other" mix, which is not timed.
+ *
+ * @pkts [in/out]: the loaded packets, their protocol mix is set
+ * @mixes [out]: the protocol mixes, BENCH_MAX_MIXES entries
+ * @nb_mixes [out]: number of protocol mixes
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_mixes_build(struct bench_pkts *pkts, struct bench_mix *mixes, uint32_t *nb_mixes)
+{
+	char name[BENCH_MAX_MIX_NAME_LEN];
+	struct parser_burst res;
+	uint32_t i, m;
+	uint16_t j, n;
+	bool parsed;
+
+	pkts->pkt_mix = calloc(pkts->nb_pkts, sizeof(*pkts->pkt_mix));
+	if (pkts->pkt_mix == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for the protocol mixes");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	*nb_mixes = 0;
+	for (i = 0; i < pkts->nb_pkts; i += n) {
+		n = RTE_MIN(pkts->nb_pkts - i, (uint32_t)PARSER_BURST_MAX_SIZE);
+		parser_burst_parse(&pkts->pkts[i], n, &res);
+		for (j = 0; j < n; j++) {
+			parsed = bench_mix_name_get(&res, j, name);
+			for (m = 0; m < *nb_mixes; m++)
+				if (strcmp(mixes[m].name, name) == 0)
+					break;
+			if (m == *nb_mixes && m == BENCH_MAX_MIXES - 1) {
+				strcpy(mixes[m].name, "other");
+				mixes[m].parsed = false;
+				(*nb_mixes)++;
+			} else if (m == *nb_mixes && m < BENCH_MAX_MIXES) {
+				strcpy(mixes[m].name, name);
+				mixes[m].parsed = parsed;
+				(*nb_mixes)++;
+			} else if (m == BENCH_MAX_MIXES) {
+				m = BENCH_MAX_MIXES - 1;
+			}
+			mixes[m].nb_pkts++;
+			pkts->pkt_mix[i + j] = m;
+		}
+	}
+
+	for (m = 0; m < *nb_mixes; m++) {
+		mixes[m].pkts = calloc(mixes[m].nb_pkts, sizeof(*mixes[m].pkts));
+		if (mixes[m].pkts == NULL) {
+			DOCA_LOG_ERR("Failed to allocate memory for the protocol mixes");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		mixes[m].nb_pkts = 0;
+	}
+	for (i = 0; i < pkts->nb_pkts; i++) {
+		m = pkts->pkt_mix[i];
+		mixes[m].pkts[mixes[m].nb_pkts++] = pkts->pkts[i];
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Time the burst API and the per-packet unknown_parse() over a packets set
+ *
+ * @pkts [in]: packets to parse
+ * @nb_pkts [in]: number of packets
+ * @conf [in]: benchmark configuration
+ * @result [out]: timing of the packets set
+ */
+static void bench_run(struct rte_mbuf **pkts,
+		      uint32_t nb_pkts,
+		      const struct bench_config *conf,
+		      struct bench_result *result)
+{
+	enum parser_pkt_type pkt_type;
+	struct parser_burst res;
+	struct tun_parser_ctx ctx;
+	uint64_t start;
+	uint32_t it, i;
+	uint16_t j, n;
+	uint8_t *data;
+
+	memset(result, 0, sizeof(*result));
+
+	/* Each API makes its own passes, so neither finds the headers already cached by the other */
+	for (it = 0; it < conf->iterations; it++) {
+		for (i = 0; i < nb_pkts; i += n) {
+			n = RTE_MIN(nb_pkts - i, (uint32_t)conf->burst_size);
+			start = rte_rdtsc();
+			parser_burst_parse(&pkts[i], n, &res);
+			result->burst_cycles += rte_rdtsc() - start;
+			result->nb_slow_path += res.nb_slow_path;
+		}
+	}
+
+	/* Same as the applications, the context is reset before parsing */
+	for (it = 0; it < conf->iterations; it++) {
+		for (i = 0; i < nb_pkts; i += n) {
+			n = RTE_MIN(nb_pkts - i, (uint32_t)conf->burst_size);
+			start = rte_rdtsc();
+			for (j = 0; j < n; j++) {
+				memset(&ctx, 0, sizeof(ctx));
+				pkt_type = PARSER_PKT_TYPE_UNKNOWN;
+				data = rte_pktmbuf_mtod(pkts[i + j], uint8_t *);
+				unknown_parse(data, data + rte_pktmbuf_data_len(pkts[i + j]), &ctx, &pkt_type);
+			}
+			result->single_cycles += rte_rdtsc() - start;
+		}
+	}
+	result->nb_pkts = (uint64_t)nb_pkts * conf->iterations;
+}
+
+/*
+ * Log the timing of a packets set
+ *
+ * @name [in]: name of the packets set
+ * @nb_pkts [in]: number of packets in the set
+ * @result [in]: timing of the packets set
+ */
+static void bench_result_log(const char *name, uint32_t nb_pkts, const struct bench_result *result)
+{
+	double burst = (double)result->burst_cycles / result->nb_pkts;
+	double single = (double)result->single_cycles / result->nb_pkts;
+
+	DOCA_LOG_INFO("%-48s %10u %14.1f %14.1f %8.2fx %9.1f%%",
+		      name,
+		      nb_pkts,
+		      burst,
+		      single,
+		      single / burst,
+		      100.0 * result->nb_slow_path / result->nb_pkts);
+}
+
+/*
+ * Run the benchmark
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf)
+{
+	struct bench_mix mixes[BENCH_MAX_MIXES] = {0};
+	struct bench_pkts pkts = {0};
+	struct bench_result result;
+	struct rte_mbuf **parsed_pkts;
+	uint32_t nb_parsed = 0;
+	uint32_t nb_mixes = 0;
+	doca_error_t ret;
+	uint32_t m, i;
+
+	ret = bench_pcap_load(conf->pcap_path, &pkts);
+	if (ret != DOCA_SUCCESS)
+		return ret;
+
+	ret = bench_mixes_build(&pkts, mixes, &nb_mixes);
+	if (ret != DOCA_SUCCESS)
+		goto free_mixes;
+
+	/* The whole trace in file order, without the packets the parsers reject and log about */
+	parsed_pkts = calloc(pkts.nb_pkts, sizeof(*parsed_pkts));
+	if (parsed_pkts == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for the parsed packets");
+		ret = DOCA_ERROR_NO_MEMORY;
+		goto free_mixes;
+	}
+	for (i = 0; i < pkts.nb_pkts; i++)
+		if (mixes[pkts.pkt_mix[i]].parsed)
+			parsed_pkts[nb_parsed++] = pkts.pkts[i];
+
+	DOCA_LOG_INFO("Parsing %u packets of %s, %u iterations of bursts of %u packets",
+		      pkts.nb_pkts,
+		      conf->pcap_path,
+		      conf->iterations,
+		      conf->burst_size);
+	DOCA_LOG_INFO("%-48s %10s %14s %14s %9s %10s",
+		      "Protocol mix",
+		      "Packets",
+		      "Burst cyc/pkt",
+		      "Single cyc/pkt",
+		      "Speedup",
+		      "Slow path");
+	for (m = 0; m < nb_mixes; m++) {
+		if (!mixes[m].parsed) {
+			DOCA_LOG_INFO("%-48s %10u %14s %14s", mixes[m].name, mixes[m].nb_pkts, "-", "-");
+			continue;
+		}
+		bench_run(mixes[m].pkts, mixes[m].nb_pkts, conf, &result);
+		bench_result_log(mixes[m].name, mixes[m].nb_pkts, &result);
+	}
+	if (nb_parsed) {
+		bench_run(parsed_pkts, nb_parsed, conf, &result);
+		bench_result_log("all (file order)", nb_parsed, &result);
+	}
+
+	free(parsed_pkts);
+free_mixes:
+	for (m = 0; m < BENCH_MAX_MIXES; m++)
+		free(mixes[m].pkts);
+	free(pkts.pkt_mix);
+	free(pkts.pkts);
+	free(pkts.arena);
+	return ret;
+}
+
+/*
+ * Packet parser benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.iterations = BENCH_DEFAULT_ITERATIONS;
+	conf.burst_size = BENCH_DEFAULT_BURST_SIZE;
+
+	/* Parse cmdline/json arguments */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	result = bench_main(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include "antireplay.h"
+
+doca_error_t antireplay_init(struct antireplay_state *state, uint32_t window_size, uint64_t sn_initial)
+{
+	state->window_size = window_size;
+	state->end_win_sn = sn_initial + window_size - 1;
+	state->nb_sn_pending = 0;
+	/* Twice the window, so sliding only ever clears words which are out of the window */
+	state->bitmap = (uint64_t *)calloc(2 * window_size / 64, sizeof(uint64_t));
+	if (state->bitmap == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	return DOCA_SUCCESS;
+}
+
+void antireplay_destroy(struct antireplay_state *state)
+{
+	free(state->bitmap);
+	state->bitmap = NULL;
+}
+
+bool esn_infer_sn(uint32_t sn_low, const struct antireplay_state *state, uint64_t *sn)
+{
+	uint32_t end_low = (uint32_t)state->end_win_sn;
+	uint32_t end_high = (uint32_t)(state->end_win_sn >> 32);
+	uint32_t beg_win_low = end_low - state->window_size + 1; /* wraps around if the window spans 2^32 */
+
+	if (end_low >= state->window_size - 1) {
+		/* The window lies within a single 2^32 block - a smaller sn belongs to the next block */
+		if (sn_low < beg_win_low)
+			end_high++;
+	} else if (sn_low >= beg_win_low) {
+		/* The window spans two 2^32 blocks and sn is in its lower part */
+		if (end_high == 0)
+			return false;
+		end_high--;
+	}
+	*sn = ((uint64_t)end_high << 32) | sn_low;
+	return true;
+}
+
+/*
+ * (1) If sn is larger than window - slide the window so that sn is the last packet in the window,
+ * clearing whole bitmap words on the way, and update bitmap.
+ * (2) Else, if sn is left (smaller) from window - drop.
+ * (3) Else, sn is in the window - check if it was already received (drop) or not (update bitmap).
+ *
+ * The bitmap is a ring of 2 * window_size bits, indexed by the sn itself, so sliding never shifts
+ * bits and costs one store per 64 sequence numbers advanced.
+ */
+void anti_replay(uint64_t sn, struct antireplay_state *state, bool *drop)
+{
+	uint64_t *bitmap = state->bitmap;
+	uint64_t word_mask = (2 * state->window_size / 64) - 1;
+	uint64_t end_word, nb_words, i;
+
+	*drop = true;
+
+	/* (1) sn is larger than end of window - move window */
+	if (sn > state->end_win_sn) {
+		end_word = state->end_win_sn >> 6;
+		nb_words = (sn >> 6) - end_word;
+		if (nb_words > word_mask)
+			nb_words = word_mask + 1;
+		for (i = 1; i <= nb_words; i++)
+			bitmap[(end_word + i) & word_mask] = 0;
+		state->end_win_sn = sn;
+	} else if (state->end_win_sn - sn >= state->window_size) {
+		/* (2) sn is smaller than beginning of the window */
+		return;	/* drop */
+	} else if (bitmap[(sn >> 6) & word_mask] & (((uint64_t)1) << (sn & 63))) {
+		/* (3) sn is in the window and already received */
+		return;	/* drop */
+	}
+
+	bitmap[(sn >> 6) & word_mask] |= (((uint64_t)1) << (sn & 63));
+	*drop = false;
+}
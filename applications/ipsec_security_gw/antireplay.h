@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef ANTIREPLAY_H_
+#define ANTIREPLAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* struct to hold antireplay state */
+struct antireplay_state {
+	uint32_t window_size;	/* antireplay window size, a power of 2 which is at least 64 */
+	uint32_t nb_sn_pending; /* window advances not yet reported to HW */
+	uint64_t end_win_sn;	/* end of window sequence number, 64 bits when ESN is enabled */
+	uint64_t *bitmap;	/* ring of 2 * window_size bits, bit (sn % (2 * window_size)) marks sn as received */
+};
+
+/*
+ * Set the anti replay state so that the first window ends window_size - 1 after the initial sequence number,
+ * and allocate its bitmap
+ *
+ * @state [out]: the anti replay state
+ * @window_size [in]: the window size, a power of 2 which is at least 64
+ * @sn_initial [in]: the initial sequence number
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t antireplay_init(struct antireplay_state *state, uint32_t window_size, uint64_t sn_initial);
+
+/*
+ * Free the bitmap of an anti replay state
+ *
+ * @state [in]: the anti replay state
+ */
+void antireplay_destroy(struct antireplay_state *state);
+
+/*
+ * Infer the high-order 32 bits of an extended sequence number from the anti replay window
+ * (RFC 4303, appendix A2.2)
+ *
+ * @sn_low [in]: the low-order 32 bits of the sequence number, as received in the ESP header
+ * @state [in]: the anti replay state
+ * @sn [out]: the 64 bits sequence number
+ * @return: false if the sequence number precedes the beginning of the sequence number space
+ */
+bool esn_infer_sn(uint32_t sn_low, const struct antireplay_state *state, uint64_t *sn);
+
+/*
+ * Perform anti replay check on a packet and update the state accordingly (RFC 6479)
+ *
+ * @sn [in]: the sequence number to check, 64 bits when ESN is enabled
+ * @state [in/out]: the anti replay state
+ * @drop [out]: true if the packet should be dropped
+ */
+void anti_replay(uint64_t sn, struct antireplay_state *state, bool *drop);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ANTIREPLAY_H_ */
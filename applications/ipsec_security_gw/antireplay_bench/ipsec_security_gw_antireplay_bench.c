@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "antireplay.h"
+
+DOCA_LOG_REGISTER(IPSEC_SECURITY_GW::ANTIREPLAY_BENCH);
+
+#define BENCH_DEFAULT_PACKETS (1 << 22)	/* Default number of packets per pass */
+#define BENCH_REORDER_DEPTH 32		/* Packets of each group delivered in reverse order by the reordered pattern */
+#define BENCH_ESN_WRAP_SN (1ULL << 32)	/* Sequence number the ESN pattern crosses in the middle of the pass */
+#define BENCH_MAX_TEST_STEPS 16		/* Maximal number of packets of a test case */
+
+static const uint32_t bench_window_sizes[] = {64, 1024, 4096}; /* Window sizes of the benchmark passes */
+
+/* Benchmark configuration */
+struct bench_config {
+	uint32_t packets; /* Number of packets per pass */
+};
+
+/* A packet of a test case and the expected verdict */
+struct test_step {
+	uint32_t sn; /* Sequence number, as received in the ESP header */
+	bool drop;   /* Expected verdict */
+};
+
+/* Test case - a sequence of packets checked against a fresh anti replay state */
+struct test_case {
+	const char *name;			      /* Test case name */
+	uint32_t window_size;			      /* Window size */
+	uint64_t sn_initial;			      /* Initial sequence number */
+	bool esn_en;				      /* If extended sn is enabled */
+	uint64_t end_win_sn;			      /* Expected end of window after the last packet */
+	struct test_step steps[BENCH_MAX_TEST_STEPS]; /* Packets, in arrival order */
+	uint32_t nb_steps;			      /* Number of packets */
+};
+
+static const struct test_case test_cases[] = {
+	{"in order", 64, 1, false, 200, {{1, false}, {2, false}, {64, false}, {65, false}, {200, false}}, 5},
+	{"reordered",
+	 64,
+	 1,
+	 false,
+	 71,
+	 {{10, false}, {5, false}, {70, false}, {8, false}, {6, true}, {7, false}, {69, false}, {71, false}},
+	 8},
+	{"duplicate",
+	 64,
+	 1,
+	 false,
+	 100,
+	 {{5, false}, {5, true}, {100, false}, {100, true}, {5, true}, {99, false}, {99, true}},
+	 7},
+	{"ring wrap",
+	 64,
+	 1,
+	 false,
+	 1130,
+	 {{1, false}, {1000, false}, {937, false}, {1000, true}, {1130, false}, {1067, false}, {1066, true}},
+	 7},
+	{"large window",
+	 4096,
+	 1,
+	 false,
+	 10000,
+	 {{4096, false}, {1, false}, {1, true}, {10000, false}, {5905, false}, {5904, true}, {5905, true}},
+	 7},
+	{"ESN wrap",
+	 64,
+	 BENCH_ESN_WRAP_SN - 64,
+	 true,
+	 BENCH_ESN_WRAP_SN + 5,
+	 {{0xfffffff0, false},
+	  {5, false},
+	  {0xfffffff1, false},
+	  {0xfffffff0, true},
+	  {5, true},
+	  {0xffffffc6, false}},
+	 6},
+};
+
+/* Sequence numbers pattern of a benchmark pass */
+enum bench_pattern {
+	BENCH_PATTERN_IN_ORDER,	 /* Consecutive sequence numbers */
+	BENCH_PATTERN_REORDERED, /* Groups of BENCH_REORDER_DEPTH sequence numbers, each in reverse order */
+	BENCH_PATTERN_DUPLICATE, /* Consecutive sequence numbers, each received twice */
+	BENCH_PATTERN_ESN_WRAP,	 /* Consecutive sequence numbers with ESN, crossing BENCH_ESN_WRAP_SN */
+	BENCH_PATTERN_NUM,
+};
+
+static const char *const bench_pattern_names[BENCH_PATTERN_NUM] = {"in order", "reordered", "duplicate", "ESN wrap"};
+
+/*
+ * ARGP Callback - Handle number of packets parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t packets_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int packets = *(int *)param;
+
+	if (packets < 2 * BENCH_REORDER_DEPTH) {
+		DOCA_LOG_ERR("Number of packets must be at least %d", 2 * BENCH_REORDER_DEPTH);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->packets = packets;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *packets_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&packets_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(packets_param, "p");
+	doca_argp_param_set_long_name(packets_param, "packets");
+	doca_argp_param_set_description(packets_param, "Number of packets per pass");
+	doca_argp_param_set_callback(packets_param, packets_callback);
+	doca_argp_param_set_type(packets_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(packets_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Check a packet the way the decrypt path does - infer the ESN high-order bits, then check the window
+ *
+ * @sn [in]: sequence number, as received in the ESP header
+ * @esn_en [in]: if extended sn is enabled
+ * @state [in/out]: the anti replay state
+ * @return: true if the packet should be dropped
+ */
+static inline bool antireplay_check(uint32_t sn, bool esn_en, struct antireplay_state *state)
+{
+	uint64_t full_sn = sn;
+	bool drop;
+
+	if (esn_en && !esn_infer_sn(sn, state, &full_sn))
+		return true;
+	anti_replay(full_sn, state, &drop);
+	return drop;
+}
+
+/*
+ * Run the test cases
+ *
+ * @return: DOCA_SUCCESS if all the packets got the expected verdict and DOCA_ERROR otherwise
+ */
+static doca_error_t run_tests(void)
+{
+	const struct test_case *test;
+	struct antireplay_state state;
+	uint32_t i, j, nb_failed = 0;
+	doca_error_t result;
+	bool drop;
+
+	for (i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++) {
+		test = &test_cases[i];
+		result = antireplay_init(&state, test->window_size, test->sn_initial);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate anti-replay window of size %u", test->window_size);
+			return result;
+		}
+		for (j = 0; j < test->nb_steps; j++) {
+			drop = antireplay_check(test->steps[j].sn, test->esn_en, &state);
+			if (drop != test->steps[j].drop) {
+				DOCA_LOG_ERR("Test %s: packet %u with sn %#x was %s",
+					     test->name,
+					     j,
+					     test->steps[j].sn,
+					     drop ? "dropped" : "accepted");
+				nb_failed++;
+			}
+		}
+		if (state.end_win_sn != test->end_win_sn) {
+			DOCA_LOG_ERR("Test %s: end of window is %#" PRIx64 " instead of %#" PRIx64,
+				     test->name,
+				     state.end_win_sn,
+				     test->end_win_sn);
+			nb_failed++;
+		}
+		antireplay_destroy(&state);
+	}
+	if (nb_failed != 0)
+		return DOCA_ERROR_UNEXPECTED;
+	DOCA_LOG_INFO("%lu test cases passed", sizeof(test_cases) / sizeof(test_cases[0]));
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Fill the sequence numbers of a benchmark pass
+ *
+ * @pattern [in]: sequence numbers pattern
+ * @nb_packets [in]: number of packets
+ * @sn_initial [in]: initial sequence number of the pass
+ * @sns [out]: sequence numbers, as received in the ESP header
+ * @nb_drops [out]: number of packets the pattern expects to be dropped
+ */
+static void bench_fill(enum bench_pattern pattern,
+		       uint32_t nb_packets,
+		       uint64_t sn_initial,
+		       uint32_t *sns,
+		       uint32_t *nb_drops)
+{
+	uint32_t i, group;
+
+	*nb_drops = 0;
+	for (i = 0; i < nb_packets; i++) {
+		switch (pattern) {
+		case BENCH_PATTERN_REORDERED:
+			group = i - i % BENCH_REORDER_DEPTH;
+			if (group + BENCH_REORDER_DEPTH <= nb_packets)
+				sns[i] = sn_initial + group + BENCH_REORDER_DEPTH - 1 - i % BENCH_REORDER_DEPTH;
+			else
+				sns[i] = sn_initial + i;
+			break;
+		case BENCH_PATTERN_DUPLICATE:
+			sns[i] = sn_initial + i / 2;
+			*nb_drops += i % 2;
+			break;
+		default:
+			sns[i] = (uint32_t)(sn_initial + i);
+			break;
+		}
+	}
+}
+
+/*
+ * Run a benchmark pass
+ *
+ * @window_size [in]: window size
+ * @pattern [in]: sequence numbers pattern
+ * @nb_packets [in]: number of packets
+ * @sns [in]: sequence numbers buffer of nb_packets entries
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pass(uint32_t window_size, enum bench_pattern pattern, uint32_t nb_packets, uint32_t *sns)
+{
+	bool esn_en = pattern == BENCH_PATTERN_ESN_WRAP;
+	uint64_t sn_initial = esn_en ? BENCH_ESN_WRAP_SN - nb_packets / 2 : 1;
+	struct antireplay_state state;
+	struct timespec start, end;
+	uint32_t i, nb_drops, nb_expected_drops;
+	doca_error_t result;
+	double ns;
+
+	bench_fill(pattern, nb_packets, sn_initial, sns, &nb_expected_drops);
+	result = antireplay_init(&state, window_size, sn_initial);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate anti-replay window of size %u", window_size);
+		return result;
+	}
+
+	nb_drops = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < nb_packets; i++)
+		nb_drops += antireplay_check(sns[i], esn_en, &state);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	antireplay_destroy(&state);
+
+	ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+	DOCA_LOG_INFO("%8u %12s %10.2f %10.1f %10u",
+		      window_size,
+		      bench_pattern_names[pattern],
+		      ns / nb_packets,
+		      nb_packets * 1e3 / ns,
+		      nb_drops);
+	if (nb_drops != nb_expected_drops) {
+		DOCA_LOG_ERR("%u packets dropped instead of %u", nb_drops, nb_expected_drops);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the test cases, then the benchmark passes of all the window sizes and patterns
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf)
+{
+	uint32_t *sns;
+	uint32_t i;
+	enum bench_pattern pattern;
+	doca_error_t result;
+
+	result = run_tests();
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	sns = (uint32_t *)calloc(conf->packets, sizeof(*sns));
+	if (sns == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u packets", conf->packets);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	DOCA_LOG_INFO("%u packets per pass", conf->packets);
+	DOCA_LOG_INFO("%8s %12s %10s %10s %10s", "Window", "Pattern", "ns/pkt", "Mpps", "Drops");
+	for (i = 0; i < sizeof(bench_window_sizes) / sizeof(bench_window_sizes[0]); i++) {
+		for (pattern = 0; pattern < BENCH_PATTERN_NUM; pattern++) {
+			result = bench_pass(bench_window_sizes[i], pattern, conf->packets, sns);
+			if (result != DOCA_SUCCESS)
+				goto free_sns;
+		}
+	}
+
+free_sns:
+	free(sns);
+	return result;
+}
+
+/*
+ * Anti replay test and benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.packets = BENCH_DEFAULT_PACKETS;
+
+	/* Parse cmdline/json arguments, no DPDK is needed */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	result = bench_main(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -244,6 +244,49 @@ static doca_error_t create_lifetime_threshold(struct json_object *cur_rule, uint
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Parse json object for the SW anti-replay window size of a decryption rule
+ *
+ * @cur_rule [in]: json object of the current rule to parse
+ * @app_cfg [in]: application configuration struct
+ * @esn_en [in]: true if the rule uses extended sequence numbers
+ * @window_size [out]: the parsed window size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t create_antireplay_window(struct json_object *cur_rule,
+					     struct ipsec_security_gw_config *app_cfg,
+					     bool esn_en,
+					     uint32_t *window_size)
+{
+	struct json_object *json_window_size;
+	int64_t window;
+
+	*window_size = SW_WINDOW_SIZE;
+	if (!json_object_object_get_ex(cur_rule, "antireplay-window-size", &json_window_size)) {
+		DOCA_LOG_DBG("Missing antireplay-window-size, default is %d", SW_WINDOW_SIZE);
+		return DOCA_SUCCESS;
+	}
+	if (json_object_get_type(json_window_size) != json_type_int) {
+		DOCA_LOG_ERR("Expecting a int value for \"antireplay-window-size\"");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	window = json_object_get_int64(json_window_size);
+	if (window < SW_WINDOW_SIZE || window > SW_MAX_WINDOW_SIZE || (window & (window - 1)) != 0) {
+		DOCA_LOG_ERR("\"antireplay-window-size\" should be a power of 2 between %d and %d",
+			     SW_WINDOW_SIZE,
+			     SW_MAX_WINDOW_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (!app_cfg->sw_antireplay)
+		DOCA_LOG_WARN("\"antireplay-window-size\" is ignored, SW anti-replay is disabled");
+	else if (!esn_en && (UINT32_MAX - (uint32_t)app_cfg->sn_initial < window)) {
+		DOCA_LOG_ERR("SN initial value is too close to the maximum value for the anti-replay window");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	*window_size = (uint32_t)window;
+	return DOCA_SUCCESS;
+}
+
 /*
  * Parse json object for esn
  *
@@ -607,6 +650,13 @@ static doca_error_t parse_json_decrypt_rules(struct json_object *json_rules, str
 		result = create_esn_en(cur_rule, &app_cfg->app_rules.decrypt_rules[i].sa_attrs.esn_en);
 		if (result != DOCA_SUCCESS)
 			return result;
+
+		result = create_antireplay_window(cur_rule,
+						  app_cfg,
+						  app_cfg->app_rules.decrypt_rules[i].sa_attrs.esn_en,
+						  &app_cfg->app_rules.decrypt_rules[i].antireplay_state.window_size);
+		if (result != DOCA_SUCCESS)
+			return result;
 	}
 	return DOCA_SUCCESS;
 }
@@ -798,6 +848,37 @@ static doca_error_t parse_antireplay(struct json_object *json_config, struct ips
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Parse json object for the SW anti-replay HW SN update granularity
+ *
+ * @json_config [in]: json config object
+ * @app_cfg [out]: application configuration struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_antireplay_sn_batch(struct json_object *json_config,
+					      struct ipsec_security_gw_config *app_cfg)
+{
+	struct json_object *sn_batch_config;
+	int64_t sn_batch;
+
+	if (!json_object_object_get_ex(json_config, "sw-antireplay-sn-update-batch", &sn_batch_config)) {
+		DOCA_LOG_DBG("Missing \"sw-antireplay-sn-update-batch\" parameter, using %u as default",
+			     app_cfg->sw_antireplay_sn_batch);
+		return DOCA_SUCCESS;
+	}
+	if (json_object_get_type(sn_batch_config) != json_type_int) {
+		DOCA_LOG_ERR("Expecting a int value for \"sw-antireplay-sn-update-batch\"");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	sn_batch = json_object_get_int64(sn_batch_config);
+	if (sn_batch < 1 || sn_batch > UINT32_MAX) {
+		DOCA_LOG_ERR("\"sw-antireplay-sn-update-batch\" should get a positive 32 bits value");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	app_cfg->sw_antireplay_sn_batch = (uint32_t)sn_batch;
+	return DOCA_SUCCESS;
+}
+
 /*
  * Parse json object for SW SN increment
  *
@@ -1079,6 +1160,10 @@ static doca_error_t parse_json_config(struct json_object *json_config, struct ip
 	if (result != DOCA_SUCCESS)
 		return result;
 
+	result = parse_antireplay_sn_batch(json_config, app_cfg);
+	if (result != DOCA_SUCCESS)
+		return result;
+
 	result = parse_sn_initial(json_config, app_cfg);
 	if (result != DOCA_SUCCESS)
 		return result;
@@ -1339,6 +1424,7 @@ doca_error_t ipsec_security_gw_parse_config(struct ipsec_security_gw_config *app
 		result = DOCA_ERROR_NO_MEMORY;
 		goto encrypt_release;
 	}
+	app_cfg->app_rules.nb_decrypt_rules_alloc = nb_decrypt_alloc;
 
 	/* parse the rules and insert to the allocated arrays */
 	if (!app_cfg->socket_ctx.socket_conf) {
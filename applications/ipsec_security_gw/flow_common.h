@@ -28,6 +28,9 @@
 
 #include <arpa/inet.h>
 
+#include <rte_mbuf.h>
+#include <rte_prefetch.h>
+
 #include <doca_flow.h>
 
 #include "ipsec_ctx.h"
@@ -41,6 +44,7 @@ extern "C" {
 #define UNSECURED_IDX (1)	    /* Index for unsecured network port in ports array */
 #define DEFAULT_TIMEOUT_US (10000)  /* default timeout for processing entries */
 #define DEF_EXPECTED_ENTRIES (1024) /* default expected entries in the pipe */
+#define SW_PREFETCH_OFFSET (3)	    /* how many packets ahead the SW path prefetches packet data */
 #define SET_L4_PORT(layer, port, value) \
 	do { \
 		if (match.layer.l4_type_ext == DOCA_FLOW_L4_TYPE_EXT_TCP) \
@@ -218,6 +222,19 @@ void create_hairpin_pipe_fwd(struct ipsec_security_gw_config *app_cfg,
  */
 void remove_ethernet_padding(struct rte_mbuf **m);
 
+/*
+ * Prefetch the cache lines the SW encap/decap path touches - the headers at the beginning of the packet
+ * and, for single segment packets, the ESP trailer at its end
+ *
+ * @m [in]: the mbuf to prefetch
+ */
+static inline void prefetch_packet_headers(struct rte_mbuf *m)
+{
+	rte_prefetch0(rte_pktmbuf_mtod(m, void *));
+	if (m->next == NULL && m->data_len > RTE_CACHE_LINE_SIZE)
+		rte_prefetch0(rte_pktmbuf_mtod_offset(m, char *, m->data_len - 1));
+}
+
 /*
  * Convert icv length value to the correct enum doca_flow_crypto_icv_len
  *
@@ -1852,68 +1852,27 @@ static void get_esp_sn(struct rte_mbuf *m, enum ipsec_security_gw_mode mode, uin
 }
 
 /*
- * Perform anti replay check on a packet and update the state accordingly
- * (1) If sn is left (smaller) from window - drop.
- * (2) Else, if sn is in the window - check if it was already received (drop) or not (update bitmap).
- * (3) Else, if sn is larger than window - slide the window so that sn is the last packet in the window and
- * update bitmap.
+ * Check a secured packet before decap - the HW syndrome and the SW anti replay window
  *
- * @sn [in]: the sequence number to check
- * @state [in/out]: the anti replay state
- * @drop [out]: true if the packet should be dropped
- *
- * @NOTE: Only supports 64 window size and regular sn (not ESN)
+ * @packet [in]: packet to check
+ * @bad_syndrome_check [in]: true if need to check bad syndrome in packet meta
+ * @ctx [in]: core context struct
+ * @return: DOCA_SUCCESS if the packet should be decapped and DOCA_ERROR otherwise
  */
-static void anti_replay(uint32_t sn, struct antireplay_state *state, bool *drop)
-{
-	uint32_t diff, beg_win_sn;
-	uint32_t window_size = state->window_size;
-	uint32_t *end_win_sn = &state->end_win_sn;
-	uint64_t *bitmap = &state->bitmap;
-
-	beg_win_sn = *end_win_sn + 1 - window_size; /* the first sn in the window */
-	*drop = true;
-
-	/* (1) Check if sn is smaller than beginning of the window */
-	if (sn < beg_win_sn)
-		return; /* drop */
-	/* (2) Check if sn is in the window */
-	if (sn <= *end_win_sn) {
-		diff = sn - beg_win_sn;
-		/* Check if sn is already received */
-		if (*bitmap & (((uint64_t)1) << diff))
-			return; /* drop */
-		else {
-			*bitmap |= (((uint64_t)1) << diff);
-			*drop = false;
-		}
-		/* (3) sn is larger than end of window */
-	} else { /* move window and set last bit */
-		diff = sn - *end_win_sn;
-		if (diff >= window_size) {
-			*bitmap = (((uint64_t)1) << (window_size - 1));
-			*drop = false;
-		} else {
-			*bitmap = (*bitmap >> diff);
-			*bitmap |= (((uint64_t)1) << (window_size - 1));
-			*drop = false;
-		}
-		*end_win_sn = sn;
-	}
-}
-
-doca_error_t handle_secured_packets_received(struct rte_mbuf **packet,
-					     bool bad_syndrome_check,
-					     struct ipsec_security_gw_core_ctx *ctx)
+static doca_error_t check_secured_packet(struct rte_mbuf *packet,
+					 bool bad_syndrome_check,
+					 struct ipsec_security_gw_core_ctx *ctx)
 {
 	uint32_t pkt_meta;
 	uint32_t rule_idx;
 	uint32_t sn;
+	uint64_t full_sn, prev_end_win_sn;
+	struct antireplay_state *state;
 	union security_gateway_pkt_meta meta;
 	doca_error_t result;
 	bool drop;
 
-	pkt_meta = *RTE_FLOW_DYNF_METADATA(*packet);
+	pkt_meta = *RTE_FLOW_DYNF_METADATA(packet);
 	meta = (union security_gateway_pkt_meta)pkt_meta;
 	rule_idx = meta.rule_id;
 	if (bad_syndrome_check) {
@@ -1922,22 +1881,73 @@ doca_error_t handle_secured_packets_received(struct rte_mbuf **packet,
 	}
 	if (ctx->config->sw_antireplay) {
 		/* Validate anti replay according to the entry's state */
-		get_esp_sn(*packet, ctx->config->mode, &sn);
-		result = doca_flow_crypto_ipsec_update_sn(ctx->config->app_rules.nb_encrypt_rules + rule_idx, sn);
-		if (result != DOCA_SUCCESS)
-			return result;
 		/* No synchronization needed, same rule is processed by the same core */
-		anti_replay(sn, &(ctx->decrypt_rules[rule_idx].antireplay_state), &drop);
+		state = &ctx->decrypt_rules[rule_idx].antireplay_state;
+		get_esp_sn(packet, ctx->config->mode, &sn);
+		full_sn = sn;
+		drop = ctx->decrypt_rules[rule_idx].sa_attrs.esn_en && !esn_infer_sn(sn, state, &full_sn);
+		prev_end_win_sn = state->end_win_sn;
+		if (!drop)
+			anti_replay(full_sn, state, &drop);
 		if (drop) {
 			DOCA_LOG_WARN("Anti Replay mechanism dropped packet- sn: %u, rule index: %d", sn, rule_idx);
 			return DOCA_ERROR_BAD_STATE;
 		}
+		/*
+		 * Report the end of the window to HW every sw_antireplay_sn_batch advances, and immediately
+		 * when the ESN high-order bits change so HW decrypts the next packets with the right ones.
+		 */
+		if (state->end_win_sn != prev_end_win_sn &&
+		    (++state->nb_sn_pending >= ctx->config->sw_antireplay_sn_batch ||
+		     (state->end_win_sn >> 32) != (prev_end_win_sn >> 32))) {
+			state->nb_sn_pending = 0;
+			result = doca_flow_crypto_ipsec_update_sn(ctx->config->app_rules.nb_encrypt_rules + rule_idx,
+								  state->end_win_sn);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
 	}
+	return DOCA_SUCCESS;
+}
 
-	if (ctx->config->mode == IPSEC_SECURITY_GW_TRANSPORT)
-		return decap_packet_transport(packet, ctx, false);
-	else if (ctx->config->mode == IPSEC_SECURITY_GW_UDP_TRANSPORT)
-		return decap_packet_transport(packet, ctx, true);
-	else
-		return decap_packet_tunnel(packet, ctx);
+void handle_secured_packets_burst(struct rte_mbuf **packets,
+				  uint16_t nb_packets,
+				  bool bad_syndrome_check,
+				  struct ipsec_security_gw_core_ctx *ctx,
+				  uint16_t *nb_processed_packets,
+				  struct rte_mbuf **processed_packets,
+				  uint16_t *nb_unprocessed_packets,
+				  struct rte_mbuf **unprocessed_packets)
+{
+	enum ipsec_security_gw_mode mode = ctx->config->mode;
+	uint16_t current_packet, nb_checked_packets = 0;
+	doca_error_t result;
+
+	for (current_packet = 0; current_packet < RTE_MIN(nb_packets, SW_PREFETCH_OFFSET); current_packet++)
+		prefetch_packet_headers(packets[current_packet]);
+
+	/* Stage 1: syndrome and anti replay checks, which only read the ESP header. Passed packets are compacted */
+	for (current_packet = 0; current_packet < nb_packets; current_packet++) {
+		if (current_packet + SW_PREFETCH_OFFSET < nb_packets)
+			prefetch_packet_headers(packets[current_packet + SW_PREFETCH_OFFSET]);
+
+		if (check_secured_packet(packets[current_packet], bad_syndrome_check, ctx) != DOCA_SUCCESS)
+			unprocessed_packets[(*nb_unprocessed_packets)++] = packets[current_packet];
+		else
+			packets[nb_checked_packets++] = packets[current_packet];
+	}
+
+	/* Stage 2: strip the ESP trailer and rewrite the headers, the packets data is already in cache */
+	for (current_packet = 0; current_packet < nb_checked_packets; current_packet++) {
+		if (mode == IPSEC_SECURITY_GW_TRANSPORT)
+			result = decap_packet_transport(&packets[current_packet], ctx, false);
+		else if (mode == IPSEC_SECURITY_GW_UDP_TRANSPORT)
+			result = decap_packet_transport(&packets[current_packet], ctx, true);
+		else
+			result = decap_packet_tunnel(&packets[current_packet], ctx);
+		if (result != DOCA_SUCCESS)
+			unprocessed_packets[(*nb_unprocessed_packets)++] = packets[current_packet];
+		else
+			processed_packets[(*nb_processed_packets)++] = packets[current_packet];
+	}
 }
@@ -73,16 +73,26 @@ doca_error_t ipsec_security_gw_insert_decrypt_rules(struct ipsec_security_gw_por
 						    struct ipsec_security_gw_config *app_cfg);
 
 /*
- * Handling the new received packets - decap packet and send them to tx queues of second port
+ * Handling a burst of new received packets - check the syndrome and anti replay window of all the packets,
+ * then decap the ones that passed. Packets are appended to the processed or unprocessed arrays.
  *
- * @packet [in]: packet to process
+ * @packets [in]: array of packets to decap, used as scratch space by the function
+ * @nb_packets [in]: size of packets array
  * @bad_syndrome_check [in]: true if need to check bad syndrome in packet meta
  * @ctx [in]: core context struct
- * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ * @nb_processed_packets [in/out]: number of packets in processed_packets
+ * @processed_packets [out]: array of packets ready to be sent
+ * @nb_unprocessed_packets [in/out]: number of packets in unprocessed_packets
+ * @unprocessed_packets [out]: array of packets to drop
  */
-doca_error_t handle_secured_packets_received(struct rte_mbuf **packet,
-					     bool bad_syndrome_check,
-					     struct ipsec_security_gw_core_ctx *ctx);
+void handle_secured_packets_burst(struct rte_mbuf **packets,
+				  uint16_t nb_packets,
+				  bool bad_syndrome_check,
+				  struct ipsec_security_gw_core_ctx *ctx,
+				  uint16_t *nb_processed_packets,
+				  struct rte_mbuf **processed_packets,
+				  uint16_t *nb_unprocessed_packets,
+				  struct rte_mbuf **unprocessed_packets);
 
 /*
  * Bind decrypt IDs to the secure port
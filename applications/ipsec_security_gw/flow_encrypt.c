@@ -2406,22 +2406,89 @@ static doca_error_t prepare_packet_transport(struct rte_mbuf **m,
 	return DOCA_SUCCESS;
 }
 
-doca_error_t handle_unsecured_packets_received(struct rte_mbuf **packet, struct ipsec_security_gw_core_ctx *ctx)
+/*
+ * Report the SN of an encrypt rule to HW, once for the whole run of packets of that rule in the burst.
+ * On failure the run's packets are moved from the processed to the unprocessed array.
+ *
+ * @ctx [in]: core context struct
+ * @rule_idx [in]: the index of the rule the run belongs to
+ * @run_start [in]: index of the first packet of the run in the processed array
+ * @nb_processed_packets [in/out]: number of processed packets
+ * @processed_packets [in/out]: array of processed packets
+ * @nb_unprocessed_packets [in/out]: number of unprocessed packets
+ * @unprocessed_packets [in/out]: array of unprocessed packets
+ */
+static void flush_encrypt_sn(struct ipsec_security_gw_core_ctx *ctx,
+			     uint32_t rule_idx,
+			     uint16_t run_start,
+			     uint16_t *nb_processed_packets,
+			     struct rte_mbuf **processed_packets,
+			     uint16_t *nb_unprocessed_packets,
+			     struct rte_mbuf **unprocessed_packets)
 {
+	uint16_t i;
+
+	if (run_start == *nb_processed_packets)
+		return;
+	if (doca_flow_crypto_ipsec_update_sn(rule_idx, ctx->encrypt_rules[rule_idx].current_sn) == DOCA_SUCCESS)
+		return;
+	for (i = run_start; i < *nb_processed_packets; i++)
+		unprocessed_packets[(*nb_unprocessed_packets)++] = processed_packets[i];
+	*nb_processed_packets = run_start;
+}
+
+void handle_unsecured_packets_burst(struct rte_mbuf **packets,
+				    uint16_t nb_packets,
+				    struct ipsec_security_gw_core_ctx *ctx,
+				    uint16_t *nb_processed_packets,
+				    struct rte_mbuf **processed_packets,
+				    uint16_t *nb_unprocessed_packets,
+				    struct rte_mbuf **unprocessed_packets)
+{
+	enum ipsec_security_gw_mode mode = ctx->config->mode;
 	uint32_t pkt_meta;
-	uint32_t rule_idx;
+	uint32_t rule_idx, run_rule_idx = 0;
+	uint16_t current_packet, run_start = *nb_processed_packets;
 	doca_error_t result;
 
-	pkt_meta = *RTE_FLOW_DYNF_METADATA(*packet);
-	rule_idx = ((union security_gateway_pkt_meta)pkt_meta).rule_id;
+	for (current_packet = 0; current_packet < RTE_MIN(nb_packets, SW_PREFETCH_OFFSET); current_packet++)
+		prefetch_packet_headers(packets[current_packet]);
+
+	for (current_packet = 0; current_packet < nb_packets; current_packet++) {
+		if (current_packet + SW_PREFETCH_OFFSET < nb_packets)
+			prefetch_packet_headers(packets[current_packet + SW_PREFETCH_OFFSET]);
+
+		pkt_meta = *RTE_FLOW_DYNF_METADATA(packets[current_packet]);
+		rule_idx = ((union security_gateway_pkt_meta)pkt_meta).rule_id;
+		/* SN is reported to HW once per run of consecutive packets of the same rule */
+		if (rule_idx != run_rule_idx) {
+			flush_encrypt_sn(ctx,
+					 run_rule_idx,
+					 run_start,
+					 nb_processed_packets,
+					 processed_packets,
+					 nb_unprocessed_packets,
+					 unprocessed_packets);
+			run_rule_idx = rule_idx;
+			run_start = *nb_processed_packets;
+		}
 
-	if (ctx->config->mode == IPSEC_SECURITY_GW_TRANSPORT)
-		result = prepare_packet_transport(packet, ctx, rule_idx, false);
-	else if (ctx->config->mode == IPSEC_SECURITY_GW_UDP_TRANSPORT)
-		result = prepare_packet_transport(packet, ctx, rule_idx, true);
-	else
-		result = prepare_packet_tunnel(packet, ctx, rule_idx);
-	if (result != DOCA_SUCCESS)
-		return result;
-	return doca_flow_crypto_ipsec_update_sn(rule_idx, ctx->encrypt_rules[rule_idx].current_sn);
+		if (mode == IPSEC_SECURITY_GW_TRANSPORT)
+			result = prepare_packet_transport(&packets[current_packet], ctx, rule_idx, false);
+		else if (mode == IPSEC_SECURITY_GW_UDP_TRANSPORT)
+			result = prepare_packet_transport(&packets[current_packet], ctx, rule_idx, true);
+		else
+			result = prepare_packet_tunnel(&packets[current_packet], ctx, rule_idx);
+		if (result != DOCA_SUCCESS)
+			unprocessed_packets[(*nb_unprocessed_packets)++] = packets[current_packet];
+		else
+			processed_packets[(*nb_processed_packets)++] = packets[current_packet];
+	}
+	flush_encrypt_sn(ctx,
+			 run_rule_idx,
+			 run_start,
+			 nb_processed_packets,
+			 processed_packets,
+			 nb_unprocessed_packets,
+			 unprocessed_packets);
 }
@@ -89,13 +89,24 @@ doca_error_t ipsec_security_gw_create_encrypt_egress(struct ipsec_security_gw_po
 						     struct ipsec_security_gw_config *app_cfg);
 
 /*
- * Handling the new received packet - print packet source IP and send them to tx queues of second port
+ * Handling a burst of new received packets - encap each packet and report the rules SN to HW once per run of
+ * packets of the same rule. Packets are appended to the processed or unprocessed arrays.
  *
- * @packet [in]: packet to parse
+ * @packets [in]: array of packets to encap
+ * @nb_packets [in]: size of packets array
  * @ctx [in]: core context struct
- * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ * @nb_processed_packets [in/out]: number of packets in processed_packets
+ * @processed_packets [out]: array of packets ready to be sent
+ * @nb_unprocessed_packets [in/out]: number of packets in unprocessed_packets
+ * @unprocessed_packets [out]: array of packets to drop
  */
-doca_error_t handle_unsecured_packets_received(struct rte_mbuf **packet, struct ipsec_security_gw_core_ctx *ctx);
+void handle_unsecured_packets_burst(struct rte_mbuf **packets,
+				    uint16_t nb_packets,
+				    struct ipsec_security_gw_core_ctx *ctx,
+				    uint16_t *nb_processed_packets,
+				    struct rte_mbuf **processed_packets,
+				    uint16_t *nb_unprocessed_packets,
+				    struct rte_mbuf **unprocessed_packets);
 
 /*
  * Bind encrypt IDs to the secure port
@@ -31,6 +31,8 @@
 
 #include <dpdk_utils.h>
 
+#include "antireplay.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -41,7 +43,8 @@ extern "C" {
 #define DYN_RESERVED_RULES (1024)	    /* Reserved rules for dynamic rules */
 #define MAX_KEY_LEN (32)		    /* Maximal GCM key size is 256bit==32B */
 #define NUM_OF_SYNDROMES (4)		    /* Number of bad syndromes */
-#define SW_WINDOW_SIZE 64		    /* The size of the replay window when anti replay is done by SW */
+#define SW_WINDOW_SIZE 64		    /* The default size of the replay window when anti replay is done by SW */
+#define SW_MAX_WINDOW_SIZE 4096		    /* The maximal size of the replay window when anti replay is done by SW */
 #define HW_WINDOW_SIZE 128		    /* The size of the replay window when anti replay is done by HW*/
 #define MAX_NAME_LEN (20)		    /* Max pipe and entry name length */
 #define MAX_ACTIONS_MEM_SIZE (8388608 * 64) /* 2^23 * size of max_entry */
@@ -62,13 +65,6 @@ struct bad_syndrome_entry {
 	uint32_t previous_stats;	    /* last query stats */
 };
 
-/* struct to hold antireplay state */
-struct antireplay_state {
-	uint32_t window_size; /* antireplay window size */
-	uint32_t end_win_sn;  /* end of window sequence number */
-	uint64_t bitmap;      /* antireplay bitmap - LSB is with lowest sequence number */
-};
-
 /* entry information struct */
 struct security_gateway_entry_info {
 	char name[MAX_NAME_LEN + 1];	    /* entry name */
@@ -170,6 +166,7 @@ struct ipsec_security_gw_rules {
 	struct decrypt_rule *decrypt_rules; /* Decryption rules array */
 	int nb_encrypt_rules;		    /* Number of encryption rules in array */
 	int nb_decrypt_rules;		    /* Number of decryption rules in array */
+	int nb_decrypt_rules_alloc;	    /* Number of decryption rules allocated in array */
 	int nb_rules;			    /* Total number of rules, will be used to indicate
 					     * which crypto index is the next one.
 					     */
@@ -238,6 +235,7 @@ struct ipsec_security_gw_socket_ctx {
 struct ipsec_security_gw_config {
 	bool sw_sn_inc_enable;				  /* true for doing sn increment in software */
 	bool sw_antireplay;				  /* true for doing anti-replay in software */
+	uint32_t sw_antireplay_sn_batch;		  /* number of window advances between HW SN updates */
 	bool debug_mode;				  /* run in debug mode */
 	bool vxlan_encap;				  /* True for vxlan encap / decap */
 	bool marker_encap;				  /* insert/remove non-ESP marker header */
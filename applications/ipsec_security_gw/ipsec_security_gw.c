@@ -25,7 +25,9 @@
 #include <signal.h>
 #include <fcntl.h>
 
+#include <rte_cycles.h>
 #include <rte_ethdev.h>
+#include <rte_malloc.h>
 
 #include <doca_argp.h>
 #include <doca_flow_tune_server.h>
@@ -48,6 +50,7 @@ DOCA_LOG_REGISTER(IPSEC_SECURITY_GW);
 #define DEFAULT_NB_CORES 4	  /* Default number of running cores */
 #define PACKET_BURST 32		  /* The number of packets in the rx queue */
 #define NB_TX_BURST_TRIES 5	  /* Number of tries for sending batch of packets */
+#define TX_DRAIN_US 100		  /* Max time in microseconds a packet waits in a TX buffer */
 #define MIN_ENTRIES_PER_CORE 1024 /* Minimum number of entries per core */
 #define MAC_ADDRESS_SIZE 6	  /* Size of mac address */
 
@@ -62,6 +65,13 @@ struct multi_thread_insertion_ctx {
 	int decrypt_rule_offset;		    /* Offset for decryption rules */
 };
 
+/* Per port buffered TX state of a worker core */
+struct ipsec_security_gw_tx_buffer {
+	struct rte_eth_dev_tx_buffer *buffer; /* DPDK TX buffer */
+	uint16_t port_id;		      /* TX port ID */
+	uint16_t queue_id;		      /* TX queue ID */
+};
+
 static bool force_quit; /* Set when signal is received */
 static char *syndrome_list[NUM_OF_SYNDROMES] = {"Authentication failed",
 						"Trailer length exceeded ESP payload",
@@ -244,14 +254,16 @@ static inline bool is_fwd_syndrome_rss(struct ipsec_security_gw_config *app_cfg)
 }
 
 /*
- * Handling the new received packet, send to process encap or decap based on src port
+ * Handling the new received packets - classify the burst to packets to encap and packets to decap based on src
+ * port (or on the packet meta in switch mode), and process each sub burst
  *
  * @port_id [in]: port ID
  * @nb_packets [in]: size of mbufs array
- * @packets [in]: array of packets
+ * @packets [in]: array of packets, reordered by the function
  * @ctx [in]: core context struct
  * @nb_processed_packets [out]: number of processed packets
  * @processed_packets [out]: array of processed packets
+ * @nb_unprocessed_packets [out]: number of unprocessed packets
  * @unprocessed_packets [out]: array of unprocessed packets
  */
 static void handle_packets_received(uint16_t port_id,
@@ -260,44 +272,132 @@ static void handle_packets_received(uint16_t port_id,
 				    struct ipsec_security_gw_core_ctx *ctx,
 				    uint16_t *nb_processed_packets,
 				    struct rte_mbuf **processed_packets,
+				    uint16_t *nb_unprocessed_packets,
 				    struct rte_mbuf **unprocessed_packets)
 {
-	uint32_t current_packet;
+	struct rte_mbuf *switch_packets[PACKET_BURST];
+	struct rte_mbuf **encrypt_packets = packets, **decrypt_packets = packets;
+	uint16_t nb_encrypt_packets = 0, nb_decrypt_packets = 0;
+	uint16_t current_packet;
 	uint32_t pkt_meta;
-	bool encrypt;
-	int unprocessed_packets_idx = 0;
-	doca_error_t result;
 
 	*nb_processed_packets = 0;
+	*nb_unprocessed_packets = 0;
 
-	for (current_packet = 0; current_packet < nb_packets; current_packet++) {
-		if (ctx->config->flow_mode == IPSEC_SECURITY_GW_SWITCH) {
+	if (ctx->config->flow_mode == IPSEC_SECURITY_GW_SWITCH) {
+		/* encrypt packets are compacted at the beginning of the RX array, decrypt ones are moved aside */
+		decrypt_packets = switch_packets;
+		for (current_packet = 0; current_packet < nb_packets; current_packet++) {
 			pkt_meta = *RTE_FLOW_DYNF_METADATA(packets[current_packet]);
-			encrypt = ((union security_gateway_pkt_meta)pkt_meta).encrypt;
-			if (encrypt)
-				port_id = ctx->ports[UNSECURED_IDX]->port_id;
+			if (((union security_gateway_pkt_meta)pkt_meta).encrypt)
+				encrypt_packets[nb_encrypt_packets++] = packets[current_packet];
 			else
-				port_id = ctx->ports[SECURED_IDX]->port_id;
+				decrypt_packets[nb_decrypt_packets++] = packets[current_packet];
 		}
-		if (port_id == (ctx->ports[UNSECURED_IDX])->port_id)
-			result = handle_unsecured_packets_received(&packets[current_packet], ctx);
-		else
-			result = handle_secured_packets_received(&packets[current_packet],
-								 is_fwd_syndrome_rss(ctx->config),
-								 ctx);
-		if (result != DOCA_SUCCESS)
-			goto add_dropped;
-
-		processed_packets[(*nb_processed_packets)++] = packets[current_packet];
-		continue;
-
-add_dropped:
-		unprocessed_packets[unprocessed_packets_idx++] = packets[current_packet];
+	} else if (port_id == (ctx->ports[UNSECURED_IDX])->port_id) {
+		nb_encrypt_packets = nb_packets;
+	} else {
+		nb_decrypt_packets = nb_packets;
+	}
+
+	if (nb_encrypt_packets > 0)
+		handle_unsecured_packets_burst(encrypt_packets,
+					       nb_encrypt_packets,
+					       ctx,
+					       nb_processed_packets,
+					       processed_packets,
+					       nb_unprocessed_packets,
+					       unprocessed_packets);
+	if (nb_decrypt_packets > 0)
+		handle_secured_packets_burst(decrypt_packets,
+					     nb_decrypt_packets,
+					     is_fwd_syndrome_rss(ctx->config),
+					     ctx,
+					     nb_processed_packets,
+					     processed_packets,
+					     nb_unprocessed_packets,
+					     unprocessed_packets);
+}
+
+/*
+ * TX buffer error callback - retry sending the packets DPDK failed to send, and drop the rest
+ *
+ * @unsent [in]: array of packets that were not sent
+ * @count [in]: size of unsent array
+ * @userdata [in]: the TX port buffer struct
+ */
+static void tx_buffer_unsent_callback(struct rte_mbuf **unsent, uint16_t count, void *userdata)
+{
+	struct ipsec_security_gw_tx_buffer *tx = (struct ipsec_security_gw_tx_buffer *)userdata;
+	int num_of_tries = NB_TX_BURST_TRIES - 1; /* the buffer flush already tried once */
+	uint16_t nb_pkts = 0;
+
+	while (nb_pkts < count && num_of_tries > 0) {
+		nb_pkts += rte_eth_tx_burst(tx->port_id, tx->queue_id, unsent + nb_pkts, count - nb_pkts);
+		num_of_tries--;
+	}
+	if (nb_pkts < count) {
+		DOCA_LOG_WARN("%d packets were dropped during the transmission to the next port", count - nb_pkts);
+		rte_pktmbuf_free_bulk(unsent + nb_pkts, count - nb_pkts);
+	}
+}
+
+/*
+ * Allocate and initialize the TX buffers of a worker core, one per port
+ *
+ * @nb_ports [in]: number of ports
+ * @queue_id [in]: the core TX queue ID
+ * @tx_buffers [out]: array of nb_ports TX buffers to initialize
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t init_tx_buffers(uint16_t nb_ports,
+				    uint16_t queue_id,
+				    struct ipsec_security_gw_tx_buffer *tx_buffers)
+{
+	uint16_t port_id;
+
+	for (port_id = 0; port_id < nb_ports; port_id++) {
+		tx_buffers[port_id].port_id = port_id;
+		tx_buffers[port_id].queue_id = queue_id;
+		tx_buffers[port_id].buffer =
+			rte_zmalloc_socket(NULL, RTE_ETH_TX_BUFFER_SIZE(PACKET_BURST), 0, rte_socket_id());
+		if (tx_buffers[port_id].buffer == NULL) {
+			DOCA_LOG_ERR("Failed to allocate TX buffer for port %u", port_id);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		if (rte_eth_tx_buffer_init(tx_buffers[port_id].buffer, PACKET_BURST) != 0 ||
+		    rte_eth_tx_buffer_set_err_callback(tx_buffers[port_id].buffer,
+						       tx_buffer_unsent_callback,
+						       &tx_buffers[port_id]) != 0) {
+			DOCA_LOG_ERR("Failed to initialize TX buffer for port %u", port_id);
+			return DOCA_ERROR_DRIVER;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Flush the TX buffers of a worker core
+ *
+ * @nb_ports [in]: number of ports
+ * @tx_buffers [in]: array of nb_ports TX buffers
+ */
+static void flush_tx_buffers(uint16_t nb_ports, struct ipsec_security_gw_tx_buffer *tx_buffers)
+{
+	uint16_t port_id;
+
+	for (port_id = 0; port_id < nb_ports; port_id++) {
+		if (tx_buffers[port_id].buffer != NULL)
+			rte_eth_tx_buffer_flush(tx_buffers[port_id].port_id,
+						tx_buffers[port_id].queue_id,
+						tx_buffers[port_id].buffer);
 	}
 }
 
 /*
- * Receive the income packets from the RX queue process them, and send it to the TX queue in the second port
+ * Receive the income packets from the RX queue process them, and send it to the TX queue in the second port.
+ * Processed packets are accumulated in a TX buffer per port, which is sent when full and flushed every
+ * TX_DRAIN_US, so small RX bursts from several ports do not turn into small TX bursts.
  *
  * @args [in]: generic pointer to core context struct
  */
@@ -306,18 +406,36 @@ static void process_queue_packets(void *args)
 	uint16_t port_id;
 	uint16_t nb_packets_received;
 	uint16_t nb_processed_packets = 0;
-	uint16_t nb_packets_to_drop;
+	uint16_t nb_packets_to_drop = 0;
 	struct rte_mbuf *packets[PACKET_BURST];
 	struct rte_mbuf *processed_packets[PACKET_BURST] = {0};
 	struct rte_mbuf *packets_to_drop[PACKET_BURST] = {0};
-	int nb_pkts;
-	int num_of_tries = NB_TX_BURST_TRIES;
+	struct ipsec_security_gw_tx_buffer *tx_buffers;
 	struct ipsec_security_gw_core_ctx *ctx = (struct ipsec_security_gw_core_ctx *)args;
 	uint16_t nb_ports = ctx->config->dpdk_config->port_config.nb_ports;
+	uint64_t drain_tsc = (rte_get_tsc_hz() + US_PER_S - 1) / US_PER_S * TX_DRAIN_US;
+	uint64_t prev_tsc = rte_rdtsc(), cur_tsc;
 	uint16_t tx_port;
+	int i;
+
+	tx_buffers = (struct ipsec_security_gw_tx_buffer *)calloc(nb_ports, sizeof(*tx_buffers));
+	if (tx_buffers == NULL) {
+		DOCA_LOG_ERR("Failed to allocate TX buffers on core %u", rte_lcore_id());
+		force_quit = true;
+		goto free_ctx;
+	}
+	if (init_tx_buffers(nb_ports, ctx->queue_id, tx_buffers) != DOCA_SUCCESS) {
+		force_quit = true;
+		goto free_tx_buffers;
+	}
 
 	DOCA_LOG_DBG("Core %u is receiving packets", rte_lcore_id());
 	while (!force_quit) {
+		cur_tsc = rte_rdtsc();
+		if (cur_tsc - prev_tsc > drain_tsc) {
+			flush_tx_buffers(nb_ports, tx_buffers);
+			prev_tsc = cur_tsc;
+		}
 		for (port_id = 0; port_id < nb_ports; port_id++) {
 			nb_packets_received = rte_eth_rx_burst(port_id, ctx->queue_id, packets, PACKET_BURST);
 			if (nb_packets_received) {
@@ -331,25 +449,18 @@ static void process_queue_packets(void *args)
 							ctx,
 							&nb_processed_packets,
 							processed_packets,
+							&nb_packets_to_drop,
 							packets_to_drop);
-				nb_pkts = 0;
 				if (ctx->config->flow_mode == IPSEC_SECURITY_GW_VNF) {
 					tx_port = port_id ^ 1;
 				} else {
 					tx_port = port_id;
 				}
-				do {
-					nb_pkts += rte_eth_tx_burst(tx_port,
-								    ctx->queue_id,
-								    processed_packets + nb_pkts,
-								    nb_processed_packets - nb_pkts);
-					num_of_tries--;
-				} while (nb_processed_packets > nb_pkts && num_of_tries > 0);
-				if (nb_processed_packets > nb_pkts)
-					DOCA_LOG_WARN(
-						"%d packets were dropped during the transmission to the next port",
-						(nb_processed_packets - nb_pkts));
-				nb_packets_to_drop = nb_packets_received - nb_processed_packets;
+				for (i = 0; i < nb_processed_packets; i++)
+					rte_eth_tx_buffer(tx_port,
+							  ctx->queue_id,
+							  tx_buffers[tx_port].buffer,
+							  processed_packets[i]);
 				if (nb_packets_to_drop > 0) {
 					DOCA_LOG_WARN("%d packets were dropped during the processing",
 						      nb_packets_to_drop);
@@ -358,6 +469,13 @@ static void process_queue_packets(void *args)
 			}
 		}
 	}
+	flush_tx_buffers(nb_ports, tx_buffers);
+
+free_tx_buffers:
+	for (port_id = 0; port_id < nb_ports; port_id++)
+		rte_free(tx_buffers[port_id].buffer);
+	free(tx_buffers);
+free_ctx:
 	free(ctx);
 }
 
@@ -594,24 +712,46 @@ static void sw_handling_sn_inc(struct ipsec_security_gw_config *app_cfg,
 }
 
 /*
- * Handle SW anti-replay - set the anti-replay state for each rule
+ * Handle SW anti-replay - set the anti-replay state for each rule and allocate its window bitmap.
+ * Rules without a configured window size get SW_WINDOW_SIZE.
  *
  * @app_cfg [in]: application configuration struct
  * @decrypt_rules [in]: decryption rules
  * @decrypt_array_size [in]: size of the decryption rules array
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static void sw_handling_antireplay(struct ipsec_security_gw_config *app_cfg,
-				   struct decrypt_rule *decrypt_rules,
-				   int decrypt_array_size)
+static doca_error_t sw_handling_antireplay(struct ipsec_security_gw_config *app_cfg,
+					   struct decrypt_rule *decrypt_rules,
+					   int decrypt_array_size)
 {
 	int entry_idx;
+	struct antireplay_state *state;
+	doca_error_t result;
 
 	for (entry_idx = 0; entry_idx < decrypt_array_size; entry_idx++) {
-		decrypt_rules[entry_idx].antireplay_state.window_size = SW_WINDOW_SIZE;
-		decrypt_rules[entry_idx].antireplay_state.end_win_sn =
-			(uint32_t)(app_cfg->sn_initial) + SW_WINDOW_SIZE - 1;
-		decrypt_rules[entry_idx].antireplay_state.bitmap = 0;
+		state = &decrypt_rules[entry_idx].antireplay_state;
+		if (state->window_size == 0)
+			state->window_size = SW_WINDOW_SIZE;
+		result = antireplay_init(state, state->window_size, app_cfg->sn_initial);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate anti-replay window of size %u", state->window_size);
+			return result;
+		}
 	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Free the SW anti-replay window bitmaps of all the allocated decryption rules
+ *
+ * @app_cfg [in]: application configuration struct
+ */
+static void sw_free_antireplay(struct ipsec_security_gw_config *app_cfg)
+{
+	int entry_idx;
+
+	for (entry_idx = 0; entry_idx < app_cfg->app_rules.nb_decrypt_rules_alloc; entry_idx++)
+		antireplay_destroy(&app_cfg->app_rules.decrypt_rules[entry_idx].antireplay_state);
 }
 
 /*
@@ -642,7 +782,9 @@ static doca_error_t ipsec_security_gw_wait_for_traffic(struct ipsec_security_gw_
 		}
 		if (app_cfg->sw_antireplay) {
 			/* Create and allocate an anti-replay state for each entry */
-			sw_handling_antireplay(app_cfg, app_cfg->app_rules.decrypt_rules, decrypt_array_size);
+			result = sw_handling_antireplay(app_cfg, app_cfg->app_rules.decrypt_rules, decrypt_array_size);
+			if (result != DOCA_SUCCESS)
+				goto exit_failure;
 		}
 		result = ipsec_security_gw_process_packets(app_cfg, ports);
 		if (result != DOCA_SUCCESS) {
@@ -737,11 +879,18 @@ static doca_error_t ipsec_security_gw_wait_for_traffic(struct ipsec_security_gw_
 					result = DOCA_ERROR_NO_MEMORY;
 					goto exit_failure;
 				}
+				memset(app_cfg->app_rules.decrypt_rules + app_cfg->app_rules.nb_decrypt_rules,
+				       0,
+				       DYN_RESERVED_RULES * sizeof(struct decrypt_rule));
+				app_cfg->app_rules.nb_decrypt_rules_alloc =
+					app_cfg->app_rules.nb_decrypt_rules + DYN_RESERVED_RULES;
 				if (app_cfg->sw_antireplay) {
-					sw_handling_antireplay(app_cfg,
-							       app_cfg->app_rules.decrypt_rules +
-								       app_cfg->app_rules.nb_decrypt_rules,
-							       DYN_RESERVED_RULES);
+					result = sw_handling_antireplay(app_cfg,
+									app_cfg->app_rules.decrypt_rules +
+										app_cfg->app_rules.nb_decrypt_rules,
+									DYN_RESERVED_RULES);
+					if (result != DOCA_SUCCESS)
+						goto exit_failure;
 				}
 			}
 			/* Get the next empty decryption rule for ingress traffic */
@@ -1056,6 +1205,7 @@ int main(int argc, char **argv)
 
 	app_cfg.dpdk_config = &dpdk_config;
 	app_cfg.nb_cores = DEFAULT_NB_CORES;
+	app_cfg.sw_antireplay_sn_batch = 1;
 
 	/* Register a logger backend */
 	result = doca_log_backend_create_standard();
@@ -1262,8 +1412,10 @@ device_cleanup:
 config_destroy:
 	if (app_cfg.app_rules.encrypt_rules)
 		free(app_cfg.app_rules.encrypt_rules);
-	if (app_cfg.app_rules.decrypt_rules)
+	if (app_cfg.app_rules.decrypt_rules) {
+		sw_free_antireplay(&app_cfg);
 		free(app_cfg.app_rules.decrypt_rules);
+	}
 dpdk_destroy:
 	dpdk_fini();
 	/* ARGP cleanup */
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_net.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <dpdk_utils.h>
+
+#include "flow_common.h"
+#include "flow_decrypt.h"
+#include "flow_encrypt.h"
+
+DOCA_LOG_REGISTER(IPSEC_SECURITY_GW::SW_PATH_BENCH);
+
+#define BENCH_BURST 32		     /* Packets per burst, as the application RX burst */
+#define BENCH_MAX_PKTS 2048	     /* Maximal number of packets loaded from the pcap port */
+#define BENCH_DEFAULT_ITERATIONS 512 /* Default number of passes over the loaded packets */
+#define BENCH_RX_EMPTY_POLLS 16	     /* Empty RX polls after which the pcap file is considered done */
+#define BENCH_NB_RULES 2	     /* One SA for the IPv4 packets and one for the IPv6 packets */
+#define BENCH_SN_INITIAL 1	     /* Initial sequence number of the SAs */
+#define BENCH_WINDOW_SIZE 64	     /* SW anti replay window size */
+
+/* Benchmark configuration */
+struct bench_config {
+	uint32_t iterations; /* Number of passes over the loaded packets */
+	uint32_t sn_batch;   /* Number of window advances between HW SN updates */
+};
+
+/* Timing of a mode */
+struct bench_result {
+	uint64_t encap_cycles; /* TSC cycles spent in the encap bursts */
+	uint64_t decap_cycles; /* TSC cycles spent in the decap bursts */
+	uint64_t nb_pkts;      /* Number of packets encapped and decapped */
+};
+
+static uint64_t bench_nb_sn_updates; /* SN reports to HW of the current mode */
+
+static const char *const bench_mode_names[] = {"tunnel", "transport", "udp transport"};
+
+/*
+ * DOCA Flow can not be started on net_pcap ports, so the link replaces the SN reports of the SW path with this
+ * function, which only counts them
+ *
+ * @shared_res_id [in]: crypto shared resource ID
+ * @sequence_number [in]: sequence number to report
+ * @return: DOCA_SUCCESS
+ */
+doca_error_t __wrap_doca_flow_crypto_ipsec_update_sn(uint32_t shared_res_id, uint64_t sequence_number);
+
+doca_error_t __wrap_doca_flow_crypto_ipsec_update_sn(uint32_t shared_res_id, uint64_t sequence_number)
+{
+	(void)shared_res_id;
+	(void)sequence_number;
+	bench_nb_sn_updates++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of iterations parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t iterations_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int iterations = *(int *)param;
+
+	if (iterations <= 0) {
+		DOCA_LOG_ERR("Number of iterations must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->iterations = iterations;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle SN batch parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t sn_batch_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int sn_batch = *(int *)param;
+
+	if (sn_batch <= 0) {
+		DOCA_LOG_ERR("SN batch must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->sn_batch = sn_batch;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *iterations_param, *sn_batch_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(iterations_param, "i");
+	doca_argp_param_set_long_name(iterations_param, "iterations");
+	doca_argp_param_set_description(iterations_param, "Number of passes over the packets of the pcap file");
+	doca_argp_param_set_callback(iterations_param, iterations_callback);
+	doca_argp_param_set_type(iterations_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&sn_batch_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(sn_batch_param, "b");
+	doca_argp_param_set_long_name(sn_batch_param, "sn-batch");
+	doca_argp_param_set_description(sn_batch_param, "Anti replay window advances between HW SN updates");
+	doca_argp_param_set_callback(sn_batch_param, sn_batch_callback);
+	doca_argp_param_set_type(sn_batch_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(sn_batch_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Set the packet type and packet meta of a packet, as HW and the DOCA Flow pipes do before the SW path.
+ * A clear packet gets the rule of its IP version, an encapped one keeps the rule it was encapped with.
+ *
+ * @m [in]: the packet
+ * @encrypt [in]: true for a packet on the encrypt path and false for the decrypt path
+ * @return: false if the packet is not an untagged IP packet
+ */
+static bool bench_pkt_classify(struct rte_mbuf *m, bool encrypt)
+{
+	union security_gateway_pkt_meta meta = {0};
+
+	m->packet_type = rte_net_get_ptype(m, NULL, RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK);
+	if ((m->packet_type & RTE_PTYPE_L2_MASK) != RTE_PTYPE_L2_ETHER ||
+	    (!RTE_ETH_IS_IPV4_HDR(m->packet_type) && !RTE_ETH_IS_IPV6_HDR(m->packet_type)))
+		return false;
+
+	if (encrypt)
+		meta.rule_id = RTE_ETH_IS_IPV6_HDR(m->packet_type) ? 1 : 0;
+	else
+		meta.u32 = *RTE_FLOW_DYNF_METADATA(m);
+	meta.encrypt = encrypt;
+	meta.decrypt = !encrypt;
+	*RTE_FLOW_DYNF_METADATA(m) = meta.u32;
+	return true;
+}
+
+/*
+ * Receive the packets of the pcap file, keeping the untagged IP ones
+ *
+ * @pkts [out]: array of BENCH_MAX_PKTS packets
+ * @nb_pkts [out]: number of packets kept
+ */
+static void bench_pcap_load(struct rte_mbuf **pkts, uint32_t *nb_pkts)
+{
+	struct rte_mbuf *burst[BENCH_BURST];
+	uint32_t nb_empty_polls = 0, nb_skipped = 0;
+	uint16_t nb_rx, i;
+
+	*nb_pkts = 0;
+	while (*nb_pkts < BENCH_MAX_PKTS && nb_empty_polls < BENCH_RX_EMPTY_POLLS) {
+		nb_rx = rte_eth_rx_burst(0, 0, burst, RTE_MIN(BENCH_BURST, BENCH_MAX_PKTS - *nb_pkts));
+		nb_empty_polls = nb_rx == 0 ? nb_empty_polls + 1 : 0;
+		for (i = 0; i < nb_rx; i++) {
+			if (burst[i]->nb_segs == 1 && bench_pkt_classify(burst[i], true)) {
+				/* The encap strips the Ethernet padding, decapped packets are compared without it */
+				remove_ethernet_padding(&burst[i]);
+				pkts[(*nb_pkts)++] = burst[i];
+			} else {
+				rte_pktmbuf_free(burst[i]);
+				nb_skipped++;
+			}
+		}
+	}
+	DOCA_LOG_INFO("Loaded %u packets, skipped %u packets which are not untagged IP", *nb_pkts, nb_skipped);
+}
+
+/*
+ * Set the rules and ports of a mode, with a fresh SN and anti replay window
+ *
+ * @conf [in]: benchmark configuration
+ * @mode [in]: application mode
+ * @app_cfg [out]: application configuration struct
+ * @encrypt_rules [out]: array of BENCH_NB_RULES encryption rules
+ * @decrypt_rules [out]: array of BENCH_NB_RULES decryption rules
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_rules_init(const struct bench_config *conf,
+				     enum ipsec_security_gw_mode mode,
+				     struct ipsec_security_gw_config *app_cfg,
+				     struct encrypt_rule *encrypt_rules,
+				     struct decrypt_rule *decrypt_rules)
+{
+	uint32_t rule_idx;
+	doca_error_t result;
+
+	app_cfg->mode = mode;
+	app_cfg->flow_mode = IPSEC_SECURITY_GW_VNF;
+	app_cfg->sw_sn_inc_enable = true;
+	app_cfg->sw_antireplay = true;
+	app_cfg->sw_antireplay_sn_batch = conf->sn_batch;
+	app_cfg->sn_initial = BENCH_SN_INITIAL;
+	app_cfg->icv_length = DOCA_FLOW_CRYPTO_ICV_LENGTH_16;
+	app_cfg->app_rules.encrypt_rules = encrypt_rules;
+	app_cfg->app_rules.decrypt_rules = decrypt_rules;
+	app_cfg->app_rules.nb_encrypt_rules = BENCH_NB_RULES;
+	app_cfg->app_rules.nb_decrypt_rules = BENCH_NB_RULES;
+
+	for (rule_idx = 0; rule_idx < BENCH_NB_RULES; rule_idx++) {
+		memset(&encrypt_rules[rule_idx], 0, sizeof(encrypt_rules[rule_idx]));
+		encrypt_rules[rule_idx].l3_type = rule_idx == 0 ? DOCA_FLOW_L3_TYPE_IP4 : DOCA_FLOW_L3_TYPE_IP6;
+		encrypt_rules[rule_idx].encap_l3_type = DOCA_FLOW_L3_TYPE_IP4;
+		encrypt_rules[rule_idx].encap_dst_ip4 = RTE_BE32(RTE_IPV4(1, 1, 1, 1));
+		encrypt_rules[rule_idx].esp_spi = rule_idx + 1;
+		encrypt_rules[rule_idx].current_sn = BENCH_SN_INITIAL;
+
+		decrypt_rules[rule_idx].inner_l3_type = encrypt_rules[rule_idx].l3_type;
+		decrypt_rules[rule_idx].esp_spi = encrypt_rules[rule_idx].esp_spi;
+		decrypt_rules[rule_idx].sa_attrs.esn_en = false;
+		antireplay_destroy(&decrypt_rules[rule_idx].antireplay_state);
+		result = antireplay_init(&decrypt_rules[rule_idx].antireplay_state,
+					 BENCH_WINDOW_SIZE,
+					 BENCH_SN_INITIAL);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate anti-replay window of size %u", BENCH_WINDOW_SIZE);
+			return result;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the encap then the decap SW path over copies of the loaded packets, burst by burst, and check that the
+ * decapped packets are the size of the original ones
+ *
+ * @pkts [in]: loaded packets
+ * @nb_pkts [in]: number of loaded packets
+ * @ctx [in]: core context struct
+ * @pool [in]: mempool of the copies
+ * @result [in/out]: timing of the mode
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pass(struct rte_mbuf **pkts,
+			       uint32_t nb_pkts,
+			       struct ipsec_security_gw_core_ctx *ctx,
+			       struct rte_mempool *pool,
+			       struct bench_result *result)
+{
+	struct rte_mbuf *burst[BENCH_BURST], *processed[BENCH_BURST], *unprocessed[BENCH_BURST];
+	uint16_t nb_burst, nb_encapped, nb_processed, nb_unprocessed, i;
+	uint32_t first;
+	uint64_t start;
+
+	for (first = 0; first < nb_pkts; first += nb_burst) {
+		nb_burst = RTE_MIN(BENCH_BURST, nb_pkts - first);
+		for (i = 0; i < nb_burst; i++) {
+			burst[i] = rte_pktmbuf_copy(pkts[first + i], pool, 0, UINT32_MAX);
+			if (burst[i] == NULL) {
+				DOCA_LOG_ERR("Failed to copy packet %u", first + i);
+				rte_pktmbuf_free_bulk(burst, i);
+				return DOCA_ERROR_NO_MEMORY;
+			}
+		}
+
+		nb_processed = 0;
+		nb_unprocessed = 0;
+		start = rte_rdtsc();
+		handle_unsecured_packets_burst(burst,
+					       nb_burst,
+					       ctx,
+					       &nb_processed,
+					       processed,
+					       &nb_unprocessed,
+					       unprocessed);
+		result->encap_cycles += rte_rdtsc() - start;
+		if (nb_unprocessed != 0)
+			goto unprocessed;
+
+		/* HW decrypts and classifies the packets in between */
+		nb_encapped = nb_processed;
+		for (i = 0; i < nb_encapped; i++) {
+			burst[i] = processed[i];
+			bench_pkt_classify(burst[i], false);
+		}
+
+		nb_processed = 0;
+		start = rte_rdtsc();
+		handle_secured_packets_burst(burst,
+					     nb_encapped,
+					     false,
+					     ctx,
+					     &nb_processed,
+					     processed,
+					     &nb_unprocessed,
+					     unprocessed);
+		result->decap_cycles += rte_rdtsc() - start;
+		if (nb_unprocessed != 0)
+			goto unprocessed;
+
+		for (i = 0; i < nb_processed; i++) {
+			if (processed[i]->pkt_len != pkts[first + i]->pkt_len) {
+				DOCA_LOG_ERR("Packet %u is %u bytes after encap and decap instead of %u",
+					     first + i,
+					     processed[i]->pkt_len,
+					     pkts[first + i]->pkt_len);
+				rte_pktmbuf_free_bulk(processed, nb_processed);
+				return DOCA_ERROR_UNEXPECTED;
+			}
+		}
+		rte_pktmbuf_free_bulk(processed, nb_processed);
+		result->nb_pkts += nb_processed;
+	}
+	return DOCA_SUCCESS;
+
+unprocessed:
+	DOCA_LOG_ERR("%u packets of the burst at packet %u were not processed", nb_unprocessed, first);
+	rte_pktmbuf_free_bulk(processed, nb_processed);
+	rte_pktmbuf_free_bulk(unprocessed, nb_unprocessed);
+	return DOCA_ERROR_UNEXPECTED;
+}
+
+/*
+ * Run the benchmark passes of every mode
+ *
+ * @conf [in]: benchmark configuration
+ * @dpdk_config [in]: DPDK configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf, struct application_dpdk_config *dpdk_config)
+{
+	struct rte_mbuf *pkts[BENCH_MAX_PKTS];
+	struct ipsec_security_gw_config app_cfg = {0};
+	struct encrypt_rule encrypt_rules[BENCH_NB_RULES];
+	struct decrypt_rule decrypt_rules[BENCH_NB_RULES] = {0};
+	struct ipsec_security_gw_ports_map secured_port = {
+		.eth_header.src_mac = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01},
+	};
+	struct ipsec_security_gw_ports_map unsecured_port = {
+		.eth_header.src_mac = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02},
+	};
+	struct ipsec_security_gw_ports_map *ports[] = {
+		[SECURED_IDX] = &secured_port,
+		[UNSECURED_IDX] = &unsecured_port,
+	};
+	struct ipsec_security_gw_core_ctx ctx = {
+		.config = &app_cfg,
+		.encrypt_rules = encrypt_rules,
+		.decrypt_rules = decrypt_rules,
+		.nb_encrypt_rules = &app_cfg.app_rules.nb_encrypt_rules,
+		.ports = ports,
+	};
+	struct bench_result result;
+	enum ipsec_security_gw_mode mode;
+	doca_error_t ret = DOCA_SUCCESS;
+	uint32_t nb_pkts, iteration, rule_idx;
+	double tsc_ns = 1e9 / rte_get_tsc_hz();
+
+	app_cfg.dpdk_config = dpdk_config;
+	bench_pcap_load(pkts, &nb_pkts);
+	if (nb_pkts == 0) {
+		DOCA_LOG_ERR("No untagged IP packet in the pcap file");
+		return DOCA_ERROR_NOT_FOUND;
+	}
+
+	DOCA_LOG_INFO("%u passes, HW SN update every %u window advances", conf->iterations, conf->sn_batch);
+	DOCA_LOG_INFO("%14s %10s %10s %10s %10s %12s",
+		      "Mode",
+		      "Encap ns",
+		      "Encap Mpps",
+		      "Decap ns",
+		      "Decap Mpps",
+		      "SN updates");
+	for (mode = IPSEC_SECURITY_GW_TUNNEL; mode <= IPSEC_SECURITY_GW_UDP_TRANSPORT; mode++) {
+		ret = bench_rules_init(conf, mode, &app_cfg, encrypt_rules, decrypt_rules);
+		if (ret != DOCA_SUCCESS)
+			break;
+		memset(&result, 0, sizeof(result));
+		bench_nb_sn_updates = 0;
+		for (iteration = 0; iteration < conf->iterations && ret == DOCA_SUCCESS; iteration++)
+			ret = bench_pass(pkts, nb_pkts, &ctx, dpdk_config->mbuf_pool, &result);
+		if (ret != DOCA_SUCCESS)
+			break;
+		DOCA_LOG_INFO("%14s %10.1f %10.2f %10.1f %10.2f %12lu",
+			      bench_mode_names[mode],
+			      result.encap_cycles * tsc_ns / result.nb_pkts,
+			      result.nb_pkts * 1e3 / (result.encap_cycles * tsc_ns),
+			      result.decap_cycles * tsc_ns / result.nb_pkts,
+			      result.nb_pkts * 1e3 / (result.decap_cycles * tsc_ns),
+			      bench_nb_sn_updates);
+	}
+
+	for (rule_idx = 0; rule_idx < BENCH_NB_RULES; rule_idx++)
+		antireplay_destroy(&decrypt_rules[rule_idx].antireplay_state);
+	rte_pktmbuf_free_bulk(pkts, nb_pkts);
+	return ret;
+}
+
+/*
+ * SW path benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	struct application_dpdk_config dpdk_config = {
+		.port_config.nb_ports = 1,
+		.port_config.nb_queues = 1,
+		.port_config.enable_mbuf_metadata = true,
+	};
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.iterations = BENCH_DEFAULT_ITERATIONS;
+	conf.sn_batch = 1;
+
+	/* Parse cmdline/json arguments */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	doca_argp_set_dpdk_program(dpdk_init);
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	/* A single queue on the net_pcap port, which also registers the packet meta dynamic field */
+	result = dpdk_queues_and_ports_init(&dpdk_config);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to initialize the ports: %s", doca_error_get_descr(result));
+		goto dpdk_destroy;
+	}
+
+	result = bench_main(&conf, &dpdk_config);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	dpdk_queues_and_ports_fini(&dpdk_config);
+dpdk_destroy:
+	dpdk_fini();
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
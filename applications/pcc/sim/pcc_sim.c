@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "pcc_sim_core.h"
+
+DOCA_LOG_REGISTER(PCC_SIM);
+
+#define DEFAULT_ALGO "rtt_template" /* Default reaction point algorithm */
+#define DEFAULT_NB_FLOWS 16	    /* Default number of incast flows */
+#define DEFAULT_RATE_GBPS 100	    /* Default link and host rates */
+#define DEFAULT_BUFFER_KB 2048	    /* Default switch port buffer */
+#define DEFAULT_ECN_KB 150	    /* Default ECN marking threshold */
+#define DEFAULT_RTT_NS 8000	    /* Default base RTT */
+#define DEFAULT_MTU 4096	    /* Default packet size */
+#define DEFAULT_DURATION_US 10000   /* Default simulated time */
+#define DEFAULT_TX_BURST 4	    /* Default number of packets per TX event */
+#define DEFAULT_CNP_INTERVAL_US 4   /* Default minimal time between CNPs of a flow */
+#define DEFAULT_SAMPLE_US 10	    /* Default time between metric samples */
+#define DEFAULT_FAIRNESS_PCT 90	    /* Default Jain index of a converged incast */
+
+/*
+ * PCC simulator main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct pcc_sim_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	strcpy(conf.algo, DEFAULT_ALGO);
+	conf.nb_flows = DEFAULT_NB_FLOWS;
+	conf.link_rate = DEFAULT_RATE_GBPS;
+	conf.host_rate = DEFAULT_RATE_GBPS;
+	conf.buffer_size = DEFAULT_BUFFER_KB;
+	conf.ecn_threshold = DEFAULT_ECN_KB;
+	conf.base_rtt = DEFAULT_RTT_NS;
+	conf.mtu = DEFAULT_MTU;
+	conf.duration = DEFAULT_DURATION_US;
+	conf.tx_burst = DEFAULT_TX_BURST;
+	conf.cnp_interval = DEFAULT_CNP_INTERVAL_US;
+	conf.sample_interval = DEFAULT_SAMPLE_US;
+	conf.fairness_threshold = DEFAULT_FAIRNESS_PCT;
+
+	/* Parse cmdline/json arguments */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	result = register_pcc_sim_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	result = pcc_sim_run(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Simulation failed: %s", doca_error_get_descr(result));
+
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
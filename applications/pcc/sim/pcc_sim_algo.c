@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host side adapter of the reaction point algorithms.
+ * This file is compiled with the DPA API shim of sim/shim and the algorithm sources of device/rp, and provides the
+ * registration calls the algorithm initialization makes, as done by the DOCA PCC device library on the DPA.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_pcc_dev.h>
+#include <doca_pcc_dev_event.h>
+#include <doca_pcc_dev_algo_access.h>
+
+#include "rtt_template_ctxt.h"
+#include "rtt_template.h"
+#include "telem_template_ctxt.h"
+#include "telem_template.h"
+
+#include "pcc_sim_algo.h"
+
+#define TELEM_AI_PARAM 1	    /* Telemetry template AI parameter */
+#define TELEM_HAI_PARAM 6	    /* Telemetry template HAI parameter, not registered */
+#define TELEM_PORT_BW_G_PARAM 7	    /* Telemetry template PORT_BW_G parameter, not registered */
+#define TELEM_QLEN_CELL_SHIFT 8	    /* Telemetry queue length is reported in cells of 256B */
+#define TELEM_QLEN_MAX_CELLS 0xffff /* Maximal queue length the telemetry can report, in cells */
+
+_Static_assert(sizeof(cc_ctxt_rtt_template_t) <= PCC_SIM_ALGO_CTXT_SIZE, "RTT template context is too large");
+_Static_assert(sizeof(cc_ctxt_telem_template_t) <= PCC_SIM_ALGO_CTXT_SIZE, "Telemetry template context is too large");
+
+/* Port TX utilization, read by the RTT template when TX bytes sampling is enabled */
+uint32_t g_utilized_bw[DOCA_PCC_DEV_MAX_NUM_PORTS];
+
+/* Algorithm initialization, registers the metadata, parameters and counters of the algorithm */
+typedef void (*algo_init_cb)(uint32_t algo_idx);
+
+/* Algorithm handler of a CC event */
+typedef void (*algo_handle_cb)(doca_pcc_dev_event_t *event,
+			       uint32_t *param,
+			       uint32_t *counter,
+			       doca_pcc_dev_algo_ctxt_t *algo_ctxt,
+			       doca_pcc_dev_results_t *results);
+
+/* Algorithm check of new parameter values */
+typedef doca_pcc_dev_error_t (*algo_set_params_cb)(uint32_t param_id_base,
+						   uint32_t param_num,
+						   const uint32_t *new_param_values,
+						   uint32_t *params);
+
+/* Setter of the parameters the algorithm uses but does not register */
+typedef void (*algo_set_defaults_cb)(struct pcc_sim_algo *algo, uint32_t port_bw_gbps);
+
+/* Filler of the RTT response payload */
+typedef void (*algo_fill_rtt_cb)(const struct pcc_sim_probe *probe, struct pcc_sim_event *event);
+
+/* Entry points of a reaction point algorithm */
+struct pcc_sim_algo_ops {
+	const char *name;		   /* Algorithm name */
+	algo_init_cb init;		   /* Registers the algorithm */
+	algo_handle_cb algo;		   /* Handles a CC event */
+	algo_set_params_cb set_params;	   /* Checks new parameter values */
+	algo_set_defaults_cb set_defaults; /* Sets unregistered parameters, optional */
+	algo_fill_rtt_cb fill_rtt;	   /* Fills the RTT response payload */
+};
+
+/* A reaction point algorithm, with the parameters and counters of a single algorithm slot */
+struct pcc_sim_algo {
+	const struct pcc_sim_algo_ops *ops;			       /* Algorithm entry points */
+	char desc[PCC_SIM_MAX_DESC_LEN];			       /* Algorithm description */
+	uint32_t nb_params;					       /* Number of parameters */
+	uint32_t nb_counters;					       /* Number of counters */
+	uint32_t params[PCC_SIM_MAX_PARAMS];			       /* Parameter values */
+	uint32_t counters[PCC_SIM_MAX_COUNTERS];		       /* Counter values */
+	struct pcc_sim_param_info param_info[PCC_SIM_MAX_PARAMS];      /* Parameter descriptions */
+	char counter_desc[PCC_SIM_MAX_COUNTERS][PCC_SIM_MAX_DESC_LEN]; /* Counter descriptions */
+};
+
+/* Algorithm being initialized, receives the registration calls */
+static struct pcc_sim_algo *init_algo;
+
+/*
+ * Copy a description registered by the algorithm
+ *
+ * @dst [out]: destination of PCC_SIM_MAX_DESC_LEN bytes
+ * @size [in]: size of the description, including the terminating null byte
+ * @addr [in]: address of the description
+ */
+static void copy_desc(char *dst, uint32_t size, uint64_t addr)
+{
+	const volatile char *src = (const volatile char *)(uintptr_t)addr;
+	uint32_t i;
+
+	for (i = 0; src != NULL && i < size && i < PCC_SIM_MAX_DESC_LEN - 1 && src[i] != '\0'; i++)
+		dst[i] = src[i];
+	dst[i] = '\0';
+}
+
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_metadata(uint32_t algo_idx,
+						     const struct doca_pcc_dev_algo_meta_data *user_def,
+						     uint32_t param_num,
+						     uint32_t counter_num)
+{
+	(void)algo_idx;
+
+	if (init_algo == NULL || user_def == NULL || param_num > PCC_SIM_MAX_PARAMS ||
+	    counter_num > PCC_SIM_MAX_COUNTERS)
+		return DOCA_PCC_DEV_STATUS_FAIL;
+
+	copy_desc(init_algo->desc, user_def->algo_desc_size, user_def->algo_desc_addr);
+	init_algo->nb_params = param_num;
+	init_algo->nb_counters = counter_num;
+	return DOCA_PCC_DEV_STATUS_OK;
+}
+
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_param(uint32_t algo_idx,
+						  uint32_t param_id,
+						  uint32_t default_value,
+						  uint32_t max_value,
+						  uint32_t min_value,
+						  uint32_t permissions,
+						  uint32_t param_desc_size,
+						  uint64_t param_desc_addr)
+{
+	struct pcc_sim_param_info *info;
+
+	(void)algo_idx;
+	(void)permissions;
+
+	if (init_algo == NULL || param_id >= init_algo->nb_params || min_value > max_value)
+		return DOCA_PCC_DEV_STATUS_FAIL;
+
+	info = &init_algo->param_info[param_id];
+	info->registered = true;
+	info->min = min_value;
+	info->max = max_value;
+	copy_desc(info->desc, param_desc_size, param_desc_addr);
+	init_algo->params[param_id] = default_value;
+	return DOCA_PCC_DEV_STATUS_OK;
+}
+
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_counter(uint32_t algo_idx,
+						    uint32_t counter_id,
+						    uint32_t max_value,
+						    uint32_t permissions,
+						    uint32_t counter_desc_size,
+						    uint64_t counter_desc_addr)
+{
+	(void)algo_idx;
+	(void)max_value;
+	(void)permissions;
+
+	if (init_algo == NULL || counter_id >= init_algo->nb_counters)
+		return DOCA_PCC_DEV_STATUS_FAIL;
+
+	copy_desc(init_algo->counter_desc[counter_id], counter_desc_size, counter_desc_addr);
+	return DOCA_PCC_DEV_STATUS_OK;
+}
+
+/*
+ * Fill the RTT payload of the RTT template.
+ * With the notification point RX rate option the payload carries the send time and the notification point RX bytes
+ * counter, otherwise the algorithm reads the send time from the event.
+ *
+ * @probe [in]: probe measurement
+ * @event [out]: RTT event
+ */
+static void rtt_template_fill_rtt(const struct pcc_sim_probe *probe, struct pcc_sim_event *event)
+{
+#ifdef DOCA_PCC_NP_RX_RATE
+	event->rtt_raw_data[0] = probe->send_ts;
+	event->rtt_raw_data[1] = probe->np_rx_bytes;
+	event->rtt_raw_data[2] = probe->np_rx_ts_us;
+#else
+	(void)probe;
+	(void)event;
+#endif
+}
+
+/*
+ * Fill the RTT payload of the switch telemetry template with the telemetry of the congested switch port
+ *
+ * @probe [in]: probe measurement
+ * @event [out]: RTT event
+ */
+static void telem_template_fill_rtt(const struct pcc_sim_probe *probe, struct pcc_sim_event *event)
+{
+	doca_pcc_dev_switch_telem_extra_t telem_extra = {._value = 0};
+	uint32_t qlen_cells = probe->switch_qlen >> TELEM_QLEN_CELL_SHIFT;
+
+	telem_extra.qlen = qlen_cells > TELEM_QLEN_MAX_CELLS ? TELEM_QLEN_MAX_CELLS : qlen_cells;
+	telem_extra.valid = 1;
+	event->rtt_raw_data[0] = telem_extra._value;
+	event->rtt_raw_data[1] = probe->switch_tx_bytes;
+	event->rtt_raw_data[2] = probe->switch_ts;
+}
+
+/*
+ * Set the parameters the switch telemetry template uses but does not register.
+ * The port bandwidth follows the simulated link, and the high additive increase falls back to the additive increase.
+ *
+ * @algo [in]: algorithm
+ * @port_bw_gbps [in]: port bandwidth
+ */
+static void telem_template_set_defaults(struct pcc_sim_algo *algo, uint32_t port_bw_gbps)
+{
+	struct pcc_sim_param_info *info;
+
+	if (algo->nb_params <= TELEM_PORT_BW_G_PARAM)
+		return;
+
+	info = &algo->param_info[TELEM_HAI_PARAM];
+	if (!info->registered) {
+		info->max = PCC_SIM_MAX_RATE;
+		strcpy(info->desc, "HAI, high additive increase (unregistered)");
+		algo->params[TELEM_HAI_PARAM] = algo->params[TELEM_AI_PARAM];
+	}
+
+	info = &algo->param_info[TELEM_PORT_BW_G_PARAM];
+	if (!info->registered) {
+		info->min = 8;
+		info->max = UINT32_MAX;
+		strcpy(info->desc, "PORT_BW_G, port bandwidth in Gbps (unregistered)");
+		algo->params[TELEM_PORT_BW_G_PARAM] = port_bw_gbps;
+	}
+}
+
+/* Supported algorithms */
+static const struct pcc_sim_algo_ops algo_ops[] = {
+	{
+		.name = "rtt_template",
+		.init = rtt_template_init,
+		.algo = rtt_template_algo,
+		.set_params = rtt_template_set_algo_params,
+		.set_defaults = NULL,
+		.fill_rtt = rtt_template_fill_rtt,
+	},
+	{
+		.name = "switch_telemetry",
+		.init = telem_template_init,
+		.algo = telem_template_algo,
+		.set_params = telem_template_set_algo_params,
+		.set_defaults = telem_template_set_defaults,
+		.fill_rtt = telem_template_fill_rtt,
+	},
+};
+
+int pcc_sim_algo_create(const char *name, uint32_t port_bw_gbps, struct pcc_sim_algo **algo)
+{
+	struct pcc_sim_algo *new_algo;
+	size_t i;
+
+	for (i = 0; i < sizeof(algo_ops) / sizeof(algo_ops[0]); i++) {
+		if (strcmp(algo_ops[i].name, name) == 0)
+			break;
+	}
+	if (i == sizeof(algo_ops) / sizeof(algo_ops[0]))
+		return -ENOENT;
+
+	new_algo = calloc(1, sizeof(*new_algo));
+	if (new_algo == NULL)
+		return -ENOMEM;
+	new_algo->ops = &algo_ops[i];
+
+	init_algo = new_algo;
+	new_algo->ops->init(0);
+	init_algo = NULL;
+
+	if (new_algo->nb_params == 0) {
+		free(new_algo);
+		return -EINVAL;
+	}
+	if (new_algo->ops->set_defaults != NULL)
+		new_algo->ops->set_defaults(new_algo, port_bw_gbps);
+
+	*algo = new_algo;
+	return 0;
+}
+
+const char *pcc_sim_algo_names(void)
+{
+	return "rtt_template switch_telemetry";
+}
+
+const char *pcc_sim_algo_get_desc(const struct pcc_sim_algo *algo)
+{
+	return algo->desc;
+}
+
+uint32_t pcc_sim_algo_get_nb_params(const struct pcc_sim_algo *algo)
+{
+	return algo->nb_params;
+}
+
+void pcc_sim_algo_get_param(const struct pcc_sim_algo *algo,
+			    uint32_t param_id,
+			    uint32_t *value,
+			    const struct pcc_sim_param_info **info)
+{
+	*value = algo->params[param_id];
+	*info = &algo->param_info[param_id];
+}
+
+int pcc_sim_algo_set_param(struct pcc_sim_algo *algo, uint32_t param_id, uint32_t value)
+{
+	const struct pcc_sim_param_info *info;
+
+	if (param_id >= algo->nb_params)
+		return -ERANGE;
+
+	info = &algo->param_info[param_id];
+	if ((info->registered || info->max != 0) && (value < info->min || value > info->max))
+		return -ERANGE;
+
+	if (algo->ops->set_params(param_id, 1, &value, &algo->params[param_id]) != DOCA_PCC_DEV_STATUS_OK)
+		return -EINVAL;
+
+	algo->params[param_id] = value;
+	return 0;
+}
+
+uint32_t pcc_sim_algo_get_nb_counters(const struct pcc_sim_algo *algo)
+{
+	return algo->nb_counters;
+}
+
+void pcc_sim_algo_get_counter(const struct pcc_sim_algo *algo,
+			      uint32_t counter_id,
+			      uint32_t *value,
+			      const char **desc)
+{
+	*value = algo->counters[counter_id];
+	*desc = algo->counter_desc[counter_id];
+}
+
+void pcc_sim_algo_fill_rtt_event(const struct pcc_sim_algo *algo,
+				 const struct pcc_sim_probe *probe,
+				 struct pcc_sim_event *event)
+{
+	event->rtt_req_send_ts = probe->send_ts;
+	event->rtt_req_recv_ts = probe->recv_ts;
+	memset(event->rtt_raw_data, 0, sizeof(event->rtt_raw_data));
+	algo->ops->fill_rtt(probe, event);
+}
+
+void pcc_sim_algo_set_port_util(uint32_t port_num, uint32_t util)
+{
+	if (port_num < DOCA_PCC_DEV_MAX_NUM_PORTS)
+		g_utilized_bw[port_num] = util;
+}
+
+void pcc_sim_algo_handle(struct pcc_sim_algo *algo,
+			 struct pcc_sim_ctxt *ctxt,
+			 struct pcc_sim_event *event,
+			 struct pcc_sim_result *result)
+{
+	algo->ops->algo(event, algo->params, algo->counters, ctxt, result);
+}
+
+void pcc_sim_algo_destroy(struct pcc_sim_algo *algo)
+{
+	free(algo);
+}
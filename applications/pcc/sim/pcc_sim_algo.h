@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCC_SIM_ALGO_H_
+#define PCC_SIM_ALGO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Host side adapter of the reaction point algorithms.
+ * The algorithm sources of device/rp are compiled unchanged against the DPA API shim of sim/shim, whose device types
+ * are the structures below. This header does not depend on the DPA or the DOCA headers, so the network model can be
+ * built with the regular DOCA include paths.
+ */
+
+#define PCC_SIM_ALGO_CTXT_SIZE 64      /* Size of the per flow algorithm context */
+#define PCC_SIM_RTT_RAW_DATA_DW 4      /* Size of the RTT response payload, in double words */
+#define PCC_SIM_MAX_PARAMS 32	       /* Maximal number of algorithm parameters */
+#define PCC_SIM_MAX_COUNTERS 32	       /* Maximal number of algorithm counters */
+#define PCC_SIM_MAX_DESC_LEN 64	       /* Maximal length of a parameter or counter description */
+#define PCC_SIM_MAX_RATE (1 << 20)     /* Line rate, in the 20 bit fixed point format of the algorithm rates */
+#define PCC_SIM_TX_FLAG_RTT_REQ_SENT 1 /* TX event flag - an RTT request was sent with the TX burst */
+
+/* CC event types */
+enum pcc_sim_event_type {
+	PCC_SIM_EVENT_NULL = 0,	     /* No event */
+	PCC_SIM_EVENT_FW = 1,	     /* Firmware event */
+	PCC_SIM_EVENT_ROCE_CNP = 2,  /* CNP received */
+	PCC_SIM_EVENT_ROCE_TX = 3,   /* Burst of packets sent */
+	PCC_SIM_EVENT_ROCE_ACK = 4,  /* ACK received */
+	PCC_SIM_EVENT_ROCE_NACK = 5, /* NACK received */
+	PCC_SIM_EVENT_RTT = 6,	     /* RTT response received */
+};
+
+/* A CC event, as seen by the algorithm */
+struct pcc_sim_event {
+	uint32_t type;					/* Event type, enum pcc_sim_event_type */
+	uint32_t flags;					/* TX events - PCC_SIM_TX_FLAG_* */
+	uint32_t port_num;				/* Port of the flow */
+	uint32_t timestamp;				/* Event time in nanoseconds, wraps around */
+	uint32_t rtt_req_send_ts;			/* RTT events - request send time */
+	uint32_t rtt_req_recv_ts;			/* RTT events - request arrival at the notification point */
+	uint32_t rtt_raw_data[PCC_SIM_RTT_RAW_DATA_DW];	/* RTT events - response payload */
+};
+
+/* What the network measured for an RTT request, the algorithm decides what the response payload carries */
+struct pcc_sim_probe {
+	uint32_t send_ts;	  /* Time at which the request was sent, in nanoseconds */
+	uint32_t recv_ts;	  /* Time at which the request reached the notification point, in nanoseconds */
+	uint32_t switch_qlen;	  /* Switch queue occupancy met by the request, in bytes */
+	uint32_t switch_tx_bytes; /* Switch port TX bytes counter, wraps around */
+	uint32_t switch_ts;	  /* Switch timestamp of the TX bytes counter, in nanoseconds */
+	uint32_t np_rx_bytes;	  /* Notification point RX bytes counter, wraps around */
+	uint32_t np_rx_ts_us;	  /* Notification point timestamp of the RX bytes counter, in microseconds */
+};
+
+/* Result of an algorithm invocation */
+struct pcc_sim_result {
+	uint32_t rate;	  /* New flow rate, PCC_SIM_MAX_RATE is line rate */
+	uint32_t rtt_req; /* Non zero to request a new RTT measurement */
+};
+
+/* Per flow algorithm context, zeroed for a new flow */
+struct pcc_sim_ctxt {
+	uint32_t data[PCC_SIM_ALGO_CTXT_SIZE / sizeof(uint32_t)]; /* Opaque algorithm data */
+};
+
+/* Description of an algorithm parameter */
+struct pcc_sim_param_info {
+	bool registered;		 /* Parameter was registered by the algorithm initialization */
+	uint32_t min;			 /* Minimal value */
+	uint32_t max;			 /* Maximal value */
+	char desc[PCC_SIM_MAX_DESC_LEN]; /* Description */
+};
+
+/* A reaction point algorithm */
+struct pcc_sim_algo;
+
+/*
+ * Create an algorithm by name, run its initialization and set its parameters to their default values
+ *
+ * @name [in]: algorithm name, see pcc_sim_algo_names()
+ * @port_bw_gbps [in]: port bandwidth, for the parameters describing the port
+ * @algo [out]: the created algorithm
+ * @return: 0 on success and a negative errno otherwise
+ */
+int pcc_sim_algo_create(const char *name, uint32_t port_bw_gbps, struct pcc_sim_algo **algo);
+
+/*
+ * Get the names of the supported algorithms
+ *
+ * @return: names separated by spaces
+ */
+const char *pcc_sim_algo_names(void);
+
+/*
+ * Get the description registered by the algorithm
+ *
+ * @algo [in]: algorithm
+ * @return: algorithm description
+ */
+const char *pcc_sim_algo_get_desc(const struct pcc_sim_algo *algo);
+
+/*
+ * Get the number of parameters of the algorithm
+ *
+ * @algo [in]: algorithm
+ * @return: number of parameters
+ */
+uint32_t pcc_sim_algo_get_nb_params(const struct pcc_sim_algo *algo);
+
+/*
+ * Get a parameter of the algorithm
+ *
+ * @algo [in]: algorithm
+ * @param_id [in]: parameter index
+ * @value [out]: current value
+ * @info [out]: parameter description
+ */
+void pcc_sim_algo_get_param(const struct pcc_sim_algo *algo,
+			    uint32_t param_id,
+			    uint32_t *value,
+			    const struct pcc_sim_param_info **info);
+
+/*
+ * Set a parameter of the algorithm, the value is checked against the registered range and by the algorithm
+ *
+ * @algo [in]: algorithm
+ * @param_id [in]: parameter index
+ * @value [in]: new value
+ * @return: 0 on success and a negative errno otherwise
+ */
+int pcc_sim_algo_set_param(struct pcc_sim_algo *algo, uint32_t param_id, uint32_t value);
+
+/*
+ * Get the number of counters of the algorithm
+ *
+ * @algo [in]: algorithm
+ * @return: number of counters
+ */
+uint32_t pcc_sim_algo_get_nb_counters(const struct pcc_sim_algo *algo);
+
+/*
+ * Get a counter of the algorithm
+ *
+ * @algo [in]: algorithm
+ * @counter_id [in]: counter index
+ * @value [out]: counter value
+ * @desc [out]: counter description
+ */
+void pcc_sim_algo_get_counter(const struct pcc_sim_algo *algo,
+			      uint32_t counter_id,
+			      uint32_t *value,
+			      const char **desc);
+
+/*
+ * Fill the RTT fields of an event from a probe measurement, in the layout the algorithm expects
+ *
+ * @algo [in]: algorithm
+ * @probe [in]: probe measurement
+ * @event [out]: RTT event
+ */
+void pcc_sim_algo_fill_rtt_event(const struct pcc_sim_algo *algo,
+				 const struct pcc_sim_probe *probe,
+				 struct pcc_sim_event *event);
+
+/*
+ * Set the TX utilization of a port, as sampled by the device program when TX bytes sampling is enabled
+ *
+ * @port_num [in]: port number
+ * @util [in]: utilization in 16 bit fixed point
+ */
+void pcc_sim_algo_set_port_util(uint32_t port_num, uint32_t util);
+
+/*
+ * Run the algorithm on a single event
+ *
+ * @algo [in]: algorithm
+ * @ctxt [in/out]: flow context
+ * @event [in]: CC event
+ * @result [out]: new rate and RTT request
+ */
+void pcc_sim_algo_handle(struct pcc_sim_algo *algo,
+			 struct pcc_sim_ctxt *ctxt,
+			 struct pcc_sim_event *event,
+			 struct pcc_sim_result *result);
+
+/*
+ * Destroy an algorithm
+ *
+ * @algo [in]: algorithm to destroy
+ */
+void pcc_sim_algo_destroy(struct pcc_sim_algo *algo);
+
+#endif /* PCC_SIM_ALGO_H_ */
@@ -0,0 +1,1454 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "pcc_sim_algo.h"
+#include "pcc_sim_core.h"
+
+DOCA_LOG_REGISTER(PCC_SIM::Core);
+
+#define PS_PER_NS 1000ULL		/* Picoseconds in a nanosecond */
+#define PS_PER_US 1000000ULL		/* Picoseconds in a microsecond */
+#define KB 1024				/* Bytes in a KB */
+#define PROBE_SIZE 64			/* Size of an RTT request, in bytes */
+#define RATE_SHIFT 20			/* Algorithm rates are fractions of the host rate in 20 bit fixed point */
+#define UTIL_SHIFT 16			/* Port utilization is in 16 bit fixed point */
+#define NB_ALGO_EVENT_TYPES 7		/* Number of CC event types, see enum pcc_sim_event_type */
+#define CLOCK_CALIBRATION_ROUNDS 4096	/* Timer reads used to measure the timer overhead */
+#define INITIAL_HEAP_SIZE 1024		/* Initial number of scheduled events */
+#define INITIAL_QUEUE_SIZE 1024		/* Initial number of queued packets */
+#define MAX_RATE_GBPS 3200		/* Maximal link rate */
+#define MAX_BUFFER_SIZE_KB (256 * 1024)	/* Maximal switch port buffer */
+#define MIN_MTU 256			/* Minimal packet size */
+#define MAX_MTU 9216			/* Maximal packet size */
+
+/* Simulator events */
+enum sim_event_type {
+	SIM_EV_FLOW_START, /* A flow arrives */
+	SIM_EV_FLOW_TX,	   /* A sender transmits its next packet */
+	SIM_EV_SWITCH_TX,  /* The switch port completes the transmission of its head packet */
+	SIM_EV_NP_RX,	   /* A packet reaches the receiver */
+	SIM_EV_RP_CNP,	   /* A CNP reaches a sender */
+	SIM_EV_RP_NACK,	   /* A NACK reaches a sender */
+	SIM_EV_RP_RTT,	   /* An RTT response reaches a sender */
+	SIM_EV_SAMPLE,	   /* Metrics sampling */
+	SIM_EV_END,	   /* End of the simulation */
+};
+
+/* A packet in the network */
+struct sim_packet {
+	uint32_t flow;	  /* Flow index */
+	uint32_t size;	  /* Size in bytes */
+	uint32_t send_ts; /* RTT requests - send time in nanoseconds */
+	bool probe;	  /* RTT request */
+	bool ecn;	  /* Marked with ECN by the switch */
+};
+
+/* A scheduled event */
+struct sim_event {
+	uint64_t time;		    /* Event time, in picoseconds */
+	uint64_t seq;		    /* Scheduling order, breaks ties between events of the same time */
+	enum sim_event_type type;   /* Event type */
+	uint32_t flow;		    /* Flow index */
+	uint32_t gen;		    /* SIM_EV_FLOW_TX - flow transmission generation the event belongs to */
+	struct sim_packet pkt;	    /* Packet events - the packet */
+	struct pcc_sim_probe probe; /* RTT request events - the measurement collected so far */
+};
+
+/* A sender and its flow */
+struct sim_flow {
+	struct pcc_sim_ctxt ctxt;  /* Algorithm flow context */
+	uint64_t size;		   /* Flow size in bytes, UINT64_MAX for endless flows */
+	uint64_t remaining;	   /* Bytes left to transmit, dropped bytes are added back */
+	uint64_t delivered;	   /* Bytes delivered to the receiver */
+	uint64_t window_delivered; /* Bytes delivered when the last flow arrived */
+	uint64_t sample_sent;	   /* Bytes transmitted since the last sample */
+	uint64_t start_time;	   /* Arrival time */
+	uint64_t finish_time;	   /* Time at which the last byte was delivered */
+	uint64_t last_tx_time;	   /* Time of the last transmission */
+	uint64_t last_cnp_time;	   /* Time of the last CNP the receiver sent for the flow */
+	uint32_t last_tx_size;	   /* Size of the last transmitted packet */
+	uint32_t rate;		   /* Current rate, a fraction of the host rate */
+	uint32_t gen;		   /* Transmission generation, bumped to cancel a scheduled transmission */
+	uint32_t burst_pkts;	   /* Packets transmitted since the last TX event */
+	bool started;		   /* Flow arrived */
+	bool finished;		   /* Flow was fully delivered */
+	bool tx_scheduled;	   /* A transmission is scheduled */
+	bool probe_sent;	   /* An RTT request was sent since the last TX event */
+	bool nack_pending;	   /* A NACK is on its way to the sender */
+	bool cnp_sent;		   /* The receiver sent a CNP for the flow */
+};
+
+/* Switch port FIFO */
+struct sim_queue {
+	struct sim_packet *pkts; /* Ring of queued packets */
+	uint32_t capacity;	 /* Ring size */
+	uint32_t head;		 /* Index of the head packet */
+	uint32_t count;		 /* Number of queued packets */
+	uint64_t bytes;		 /* Queued bytes */
+};
+
+/* Metrics collected along the run */
+struct sim_stats {
+	uint64_t algo_calls[NB_ALGO_EVENT_TYPES];  /* Algorithm invocations per CC event type */
+	uint64_t algo_ns[NB_ALGO_EVENT_TYPES];	   /* Time spent in the algorithm per CC event type */
+	uint64_t algo_max_ns[NB_ALGO_EVENT_TYPES]; /* Longest invocation per CC event type */
+	uint64_t drops;				   /* Dropped data packets */
+	uint64_t drop_bytes;			   /* Dropped data bytes */
+	uint64_t probes;			   /* RTT requests sent */
+	uint64_t probe_drops;			   /* RTT requests dropped */
+	uint64_t ecn_marks;			   /* Packets marked with ECN */
+	uint64_t cnps;				   /* CNPs sent */
+	uint64_t nacks;				   /* NACKs sent */
+	uint64_t queue_max;			   /* Maximal queue occupancy, in bytes */
+	double queue_integral;			   /* Queue occupancy integrated over time, in bytes * picoseconds */
+	uint64_t queue_last_change;		   /* Time of the last queue occupancy change */
+	uint32_t *queue_samples;		   /* Sampled queue occupancy, in bytes */
+	uint32_t nb_queue_samples;		   /* Number of queue samples */
+	uint64_t converged_since;		   /* Start of the current run of fair samples, UINT64_MAX if unfair */
+	uint64_t window_start;			   /* Arrival of the last flow */
+	uint64_t window_link_bytes;		   /* Switch port TX bytes when the last flow arrived */
+	uint64_t last_sample_link_bytes;	   /* Switch port TX bytes at the last sample */
+	uint64_t nb_sim_events;			   /* Simulator events processed */
+};
+
+/* Simulator state */
+struct sim {
+	const struct pcc_sim_config *conf; /* Configuration */
+	struct pcc_sim_algo *algo;	   /* Reaction point algorithm */
+	struct sim_flow *flows;		   /* Flows */
+	struct sim_event *heap;		   /* Scheduled events, a binary min heap */
+	uint32_t heap_size;		   /* Number of scheduled events */
+	uint32_t heap_capacity;		   /* Size of the heap array */
+	uint64_t seq;			   /* Scheduling order of the next event */
+	struct sim_queue queue;		   /* Switch port FIFO */
+	bool link_busy;			   /* The switch port is transmitting */
+	uint64_t link_bytes;		   /* Switch port TX bytes */
+	uint64_t np_rx_bytes;		   /* Receiver RX bytes */
+	uint64_t now;			   /* Current time, in picoseconds */
+	uint64_t end_time;		   /* End of the simulation */
+	uint64_t buffer_bytes;		   /* Switch port buffer */
+	uint64_t ecn_bytes;		   /* ECN marking threshold, 0 if disabled */
+	uint64_t half_rtt;		   /* Half of the base RTT */
+	uint32_t nb_finished;		   /* Number of finished flows */
+	uint64_t timer_overhead_ns;	   /* Cost of a pair of timer reads */
+	FILE *trace;			   /* CSV trace of the samples, NULL if disabled */
+	struct sim_stats stats;		   /* Metrics */
+};
+
+/* Names of the CC event types, for the report */
+static const char *const algo_event_names[NB_ALGO_EVENT_TYPES] = {
+	[PCC_SIM_EVENT_NULL] = "NULL",
+	[PCC_SIM_EVENT_FW] = "FW",
+	[PCC_SIM_EVENT_ROCE_CNP] = "CNP",
+	[PCC_SIM_EVENT_ROCE_TX] = "TX",
+	[PCC_SIM_EVENT_ROCE_ACK] = "ACK",
+	[PCC_SIM_EVENT_ROCE_NACK] = "NACK",
+	[PCC_SIM_EVENT_RTT] = "RTT",
+};
+
+/*
+ * Check and set an unsigned integer parameter
+ *
+ * @name [in]: parameter name, for the error message
+ * @value [in]: value given by the user
+ * @min [in]: minimal value
+ * @max [in]: maximal value
+ * @field [out]: configuration field
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t set_uint_param(const char *name, int value, uint32_t min, uint32_t max, uint32_t *field)
+{
+	if (value < 0 || (uint32_t)value < min || (uint32_t)value > max) {
+		DOCA_LOG_ERR("%s must be between %u and %u", name, min, max);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	*field = value;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Check and set a string parameter
+ *
+ * @name [in]: parameter name, for the error message
+ * @value [in]: value given by the user
+ * @size [in]: size of the configuration field
+ * @field [out]: configuration field
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t set_string_param(const char *name, const char *value, size_t size, char *field)
+{
+	if (strnlen(value, size) == size) {
+		DOCA_LOG_ERR("%s is too long - MAX=%zu", name, size - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(field, value);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle algorithm parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t algo_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_string_param("Algorithm name", (char *)param, sizeof(conf->algo), conf->algo);
+}
+
+/*
+ * ARGP Callback - Handle algorithm parameters parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t params_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_string_param("Algorithm parameters", (char *)param, sizeof(conf->params), conf->params);
+}
+
+/*
+ * ARGP Callback - Handle trace file parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t trace_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_string_param("Trace file path", (char *)param, sizeof(conf->trace_path), conf->trace_path);
+}
+
+/*
+ * ARGP Callback - Handle number of flows parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t flows_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Number of flows", *(int *)param, 1, PCC_SIM_MAX_FLOWS, &conf->nb_flows);
+}
+
+/*
+ * ARGP Callback - Handle link rate parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t link_rate_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Link rate", *(int *)param, 1, MAX_RATE_GBPS, &conf->link_rate);
+}
+
+/*
+ * ARGP Callback - Handle host rate parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t host_rate_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Host rate", *(int *)param, 1, MAX_RATE_GBPS, &conf->host_rate);
+}
+
+/*
+ * ARGP Callback - Handle buffer size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t buffer_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Buffer size", *(int *)param, 1, MAX_BUFFER_SIZE_KB, &conf->buffer_size);
+}
+
+/*
+ * ARGP Callback - Handle ECN threshold parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ecn_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("ECN threshold", *(int *)param, 0, MAX_BUFFER_SIZE_KB, &conf->ecn_threshold);
+}
+
+/*
+ * ARGP Callback - Handle base RTT parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rtt_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Base RTT", *(int *)param, 2, INT32_MAX, &conf->base_rtt);
+}
+
+/*
+ * ARGP Callback - Handle MTU parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t mtu_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("MTU", *(int *)param, MIN_MTU, MAX_MTU, &conf->mtu);
+}
+
+/*
+ * ARGP Callback - Handle flow arrival interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t arrival_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Arrival interval", *(int *)param, 0, INT32_MAX, &conf->arrival_interval);
+}
+
+/*
+ * ARGP Callback - Handle flow size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t flow_size_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Flow size", *(int *)param, 0, INT32_MAX, &conf->flow_size);
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t duration_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Duration", *(int *)param, 1, INT32_MAX, &conf->duration);
+}
+
+/*
+ * ARGP Callback - Handle TX burst parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t tx_burst_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("TX burst", *(int *)param, 1, UINT16_MAX, &conf->tx_burst);
+}
+
+/*
+ * ARGP Callback - Handle CNP interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t cnp_interval_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("CNP interval", *(int *)param, 0, INT32_MAX, &conf->cnp_interval);
+}
+
+/*
+ * ARGP Callback - Handle sample interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t sample_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Sample interval", *(int *)param, 1, INT32_MAX, &conf->sample_interval);
+}
+
+/*
+ * ARGP Callback - Handle fairness threshold parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t fairness_callback(void *param, void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	return set_uint_param("Fairness threshold", *(int *)param, 1, 100, &conf->fairness_threshold);
+}
+
+/*
+ * ARGP validation Callback - check the model is consistent
+ *
+ * @config [in]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t args_validation_callback(void *config)
+{
+	struct pcc_sim_config *conf = (struct pcc_sim_config *)config;
+
+	if ((uint64_t)conf->buffer_size * KB < conf->mtu) {
+		DOCA_LOG_ERR("The switch buffer must hold at least one packet of %u bytes", conf->mtu);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (conf->ecn_threshold > conf->buffer_size) {
+		DOCA_LOG_ERR("The ECN threshold must not exceed the switch buffer");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if ((uint64_t)conf->arrival_interval * (conf->nb_flows - 1) >= conf->duration) {
+		DOCA_LOG_ERR("All flows must arrive before the end of the simulation");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
+/* Command line parameter */
+struct sim_param {
+	const char *short_name;	  /* Short name, NULL if none */
+	const char *long_name;	  /* Long name */
+	const char *arguments;	  /* Arguments shown in the usage, NULL if none */
+	const char *description;  /* Description */
+	doca_argp_param_cb_t cb;  /* Callback */
+	enum doca_argp_type type; /* Argument type */
+};
+
+/* Command line parameters of the simulator */
+static const struct sim_param sim_params[] = {
+	{"a", "algo", "<name>", "Reaction point algorithm: rtt_template or switch_telemetry", algo_callback,
+	 DOCA_ARGP_TYPE_STRING},
+	{"p", "param", "<id=value,...>", "Algorithm parameters to set, by parameter index", params_callback,
+	 DOCA_ARGP_TYPE_STRING},
+	{"n", "flows", NULL, "Number of incast flows", flows_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "link-rate", NULL, "Bottleneck link rate in Gbps", link_rate_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "host-rate", NULL, "Sender host link rate in Gbps", host_rate_callback, DOCA_ARGP_TYPE_INT},
+	{"b", "buffer", NULL, "Switch port buffer in KB", buffer_callback, DOCA_ARGP_TYPE_INT},
+	{"e", "ecn", NULL, "Switch port ECN marking threshold in KB, 0 to disable", ecn_callback, DOCA_ARGP_TYPE_INT},
+	{"r", "rtt", NULL, "Base round trip time in nanoseconds", rtt_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "mtu", NULL, "Packet size in bytes", mtu_callback, DOCA_ARGP_TYPE_INT},
+	{"i", "arrival", NULL, "Time between flow arrivals in microseconds", arrival_callback, DOCA_ARGP_TYPE_INT},
+	{"s", "flow-size", NULL, "Flow size in KB, 0 for flows lasting the whole run", flow_size_callback,
+	 DOCA_ARGP_TYPE_INT},
+	{"d", "duration", NULL, "Simulated time in microseconds", duration_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "tx-burst", NULL, "Packets per TX event", tx_burst_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "cnp-interval", NULL, "Minimal time between CNPs of a flow in microseconds", cnp_interval_callback,
+	 DOCA_ARGP_TYPE_INT},
+	{NULL, "sample", NULL, "Time between metric samples in microseconds", sample_callback, DOCA_ARGP_TYPE_INT},
+	{NULL, "fairness", NULL, "Jain index of the flow rates a converged incast keeps, in percent", fairness_callback,
+	 DOCA_ARGP_TYPE_INT},
+	{"o", "trace", "<path>", "CSV trace of the sampled queue depth, utilization, fairness and flow rates",
+	 trace_callback, DOCA_ARGP_TYPE_STRING},
+};
+
+doca_error_t register_pcc_sim_params(void)
+{
+	doca_error_t result;
+	struct doca_argp_param *param;
+	size_t i;
+
+	for (i = 0; i < sizeof(sim_params) / sizeof(sim_params[0]); i++) {
+		result = doca_argp_param_create(&param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+			return result;
+		}
+		if (sim_params[i].short_name != NULL)
+			doca_argp_param_set_short_name(param, sim_params[i].short_name);
+		doca_argp_param_set_long_name(param, sim_params[i].long_name);
+		if (sim_params[i].arguments != NULL)
+			doca_argp_param_set_arguments(param, sim_params[i].arguments);
+		doca_argp_param_set_description(param, sim_params[i].description);
+		doca_argp_param_set_callback(param, sim_params[i].cb);
+		doca_argp_param_set_type(param, sim_params[i].type);
+		result = doca_argp_register_param(param);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to register program param %s: %s",
+				     sim_params[i].long_name,
+				     doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	result = doca_argp_register_validation_callback(args_validation_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program validation callback: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Read the monotonic clock
+ *
+ * @return: time in nanoseconds
+ */
+static inline uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Measure the cost of the pair of timer reads that surrounds an algorithm invocation
+ *
+ * @return: average cost in nanoseconds
+ */
+static uint64_t calibrate_timer(void)
+{
+	uint64_t total = 0, start;
+	int i;
+
+	for (i = 0; i < CLOCK_CALIBRATION_ROUNDS; i++) {
+		start = get_time_ns();
+		total += get_time_ns() - start;
+	}
+	return total / CLOCK_CALIBRATION_ROUNDS;
+}
+
+/*
+ * Compare two events by time, and by scheduling order for events of the same time
+ *
+ * @a [in]: first event
+ * @b [in]: second event
+ * @return: true if a comes before b
+ */
+static inline bool event_before(const struct sim_event *a, const struct sim_event *b)
+{
+	return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+
+/*
+ * Schedule an event
+ *
+ * @sim [in]: simulator
+ * @event [in]: event to schedule, its sequence number is set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t schedule_event(struct sim *sim, struct sim_event *event)
+{
+	struct sim_event *heap, tmp;
+	uint32_t idx, parent;
+
+	if (sim->heap_size == sim->heap_capacity) {
+		heap = realloc(sim->heap, 2 * (size_t)sim->heap_capacity * sizeof(*heap));
+		if (heap == NULL) {
+			DOCA_LOG_ERR("Failed to grow the event queue");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		sim->heap = heap;
+		sim->heap_capacity *= 2;
+	}
+
+	event->seq = sim->seq++;
+	idx = sim->heap_size++;
+	sim->heap[idx] = *event;
+	while (idx > 0) {
+		parent = (idx - 1) / 2;
+		if (!event_before(&sim->heap[idx], &sim->heap[parent]))
+			break;
+		tmp = sim->heap[parent];
+		sim->heap[parent] = sim->heap[idx];
+		sim->heap[idx] = tmp;
+		idx = parent;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Remove the earliest event
+ *
+ * @sim [in]: simulator, with at least one scheduled event
+ * @event [out]: the earliest event
+ */
+static void pop_event(struct sim *sim, struct sim_event *event)
+{
+	struct sim_event tmp;
+	uint32_t idx = 0, child;
+
+	*event = sim->heap[0];
+	sim->heap[0] = sim->heap[--sim->heap_size];
+	for (;;) {
+		child = 2 * idx + 1;
+		if (child >= sim->heap_size)
+			break;
+		if (child + 1 < sim->heap_size && event_before(&sim->heap[child + 1], &sim->heap[child]))
+			child++;
+		if (!event_before(&sim->heap[child], &sim->heap[idx]))
+			break;
+		tmp = sim->heap[child];
+		sim->heap[child] = sim->heap[idx];
+		sim->heap[idx] = tmp;
+		idx = child;
+	}
+}
+
+/*
+ * Schedule an event of a flow
+ *
+ * @sim [in]: simulator
+ * @type [in]: event type
+ * @time [in]: event time
+ * @flow [in]: flow index
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t schedule_flow_event(struct sim *sim, enum sim_event_type type, uint64_t time, uint32_t flow)
+{
+	struct sim_event event = {.time = time, .type = type, .flow = flow};
+
+	if (type == SIM_EV_FLOW_TX)
+		event.gen = sim->flows[flow].gen;
+	return schedule_event(sim, &event);
+}
+
+/*
+ * Time a sender takes to transmit a packet at its current rate
+ *
+ * @sim [in]: simulator
+ * @flow [in]: flow
+ * @size [in]: packet size in bytes
+ * @return: time in picoseconds
+ */
+static inline uint64_t tx_interval(const struct sim *sim, const struct sim_flow *flow, uint32_t size)
+{
+	return ((uint64_t)size * 8 * PS_PER_NS << RATE_SHIFT) / ((uint64_t)sim->conf->host_rate * flow->rate);
+}
+
+/*
+ * Schedule the next transmission of a flow, and cancel the one already scheduled
+ *
+ * @sim [in]: simulator
+ * @flow_idx [in]: flow index
+ * @time [in]: transmission time
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t schedule_tx(struct sim *sim, uint32_t flow_idx, uint64_t time)
+{
+	struct sim_flow *flow = &sim->flows[flow_idx];
+
+	flow->gen++;
+	flow->tx_scheduled = true;
+	return schedule_flow_event(sim, SIM_EV_FLOW_TX, time, flow_idx);
+}
+
+/*
+ * Account the queue occupancy up to the current time, before it changes
+ *
+ * @sim [in]: simulator
+ */
+static inline void queue_account(struct sim *sim)
+{
+	sim->stats.queue_integral += (double)sim->queue.bytes * (sim->now - sim->stats.queue_last_change);
+	sim->stats.queue_last_change = sim->now;
+}
+
+/*
+ * Start the transmission of the head packet of the switch port
+ *
+ * @sim [in]: simulator, with a non empty queue
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t switch_start_tx(struct sim *sim)
+{
+	struct sim_event event = {.type = SIM_EV_SWITCH_TX};
+	uint32_t size = sim->queue.pkts[sim->queue.head].size;
+
+	sim->link_busy = true;
+	event.time = sim->now + (uint64_t)size * 8 * PS_PER_NS / sim->conf->link_rate;
+	return schedule_event(sim, &event);
+}
+
+/*
+ * Drop a packet the switch port has no room for
+ *
+ * @sim [in]: simulator
+ * @pkt [in]: dropped packet
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t switch_drop(struct sim *sim, const struct sim_packet *pkt)
+{
+	struct sim_flow *flow = &sim->flows[pkt->flow];
+
+	/* A lost RTT request is recovered by the abort flow of the algorithm */
+	if (pkt->probe) {
+		sim->stats.probe_drops++;
+		return DOCA_SUCCESS;
+	}
+
+	sim->stats.drops++;
+	sim->stats.drop_bytes += pkt->size;
+	flow->remaining += pkt->size;
+	if (flow->nack_pending)
+		return DOCA_SUCCESS;
+
+	/* The receiver notices the gap and reports it a base RTT later */
+	flow->nack_pending = true;
+	sim->stats.nacks++;
+	return schedule_flow_event(sim, SIM_EV_RP_NACK, sim->now + 2 * sim->half_rtt, pkt->flow);
+}
+
+/*
+ * Enqueue a packet at the switch port
+ *
+ * @sim [in]: simulator
+ * @pkt [in]: packet
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t switch_enqueue(struct sim *sim, struct sim_packet *pkt)
+{
+	struct sim_queue *queue = &sim->queue;
+	struct sim_packet *pkts;
+	uint32_t i;
+
+	if (queue->bytes + pkt->size > sim->buffer_bytes)
+		return switch_drop(sim, pkt);
+
+	if (queue->count == queue->capacity) {
+		pkts = malloc(2 * (size_t)queue->capacity * sizeof(*pkts));
+		if (pkts == NULL) {
+			DOCA_LOG_ERR("Failed to grow the switch queue");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		for (i = 0; i < queue->count; i++)
+			pkts[i] = queue->pkts[(queue->head + i) % queue->capacity];
+		free(queue->pkts);
+		queue->pkts = pkts;
+		queue->head = 0;
+		queue->capacity *= 2;
+	}
+
+	if (!pkt->probe && sim->ecn_bytes != 0 && queue->bytes >= sim->ecn_bytes) {
+		pkt->ecn = true;
+		sim->stats.ecn_marks++;
+	}
+
+	queue_account(sim);
+	queue->pkts[(queue->head + queue->count) % queue->capacity] = *pkt;
+	queue->count++;
+	queue->bytes += pkt->size;
+	if (queue->bytes > sim->stats.queue_max)
+		sim->stats.queue_max = queue->bytes;
+
+	if (sim->link_busy)
+		return DOCA_SUCCESS;
+	return switch_start_tx(sim);
+}
+
+/*
+ * Send an RTT request of a flow
+ *
+ * @sim [in]: simulator
+ * @flow_idx [in]: flow index
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t send_probe(struct sim *sim, uint32_t flow_idx)
+{
+	struct sim_packet pkt = {.flow = flow_idx, .size = PROBE_SIZE, .probe = true};
+
+	pkt.send_ts = (uint32_t)(sim->now / PS_PER_NS);
+	sim->flows[flow_idx].probe_sent = true;
+	sim->stats.probes++;
+	return switch_enqueue(sim, &pkt);
+}
+
+/*
+ * Run the algorithm on a CC event of a flow, and apply the result
+ *
+ * @sim [in]: simulator
+ * @flow_idx [in]: flow index
+ * @event [in]: CC event, the type and the type specific fields are set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t algo_event(struct sim *sim, uint32_t flow_idx, struct pcc_sim_event *event)
+{
+	struct sim_flow *flow = &sim->flows[flow_idx];
+	struct sim_stats *stats = &sim->stats;
+	struct pcc_sim_result algo_result = {0};
+	uint64_t start, cost, next;
+	uint32_t rate;
+	doca_error_t result;
+
+	event->port_num = 0;
+	event->timestamp = (uint32_t)(sim->now / PS_PER_NS);
+
+	start = get_time_ns();
+	pcc_sim_algo_handle(sim->algo, &flow->ctxt, event, &algo_result);
+	cost = get_time_ns() - start;
+	cost = cost > sim->timer_overhead_ns ? cost - sim->timer_overhead_ns : 0;
+	stats->algo_calls[event->type]++;
+	stats->algo_ns[event->type] += cost;
+	if (cost > stats->algo_max_ns[event->type])
+		stats->algo_max_ns[event->type] = cost;
+
+	rate = algo_result.rate;
+	if (rate == 0)
+		rate = 1;
+	if (rate > PCC_SIM_MAX_RATE)
+		rate = PCC_SIM_MAX_RATE;
+
+	/* Pace the scheduled transmission at the new rate */
+	if (rate != flow->rate) {
+		flow->rate = rate;
+		if (flow->tx_scheduled) {
+			next = flow->last_tx_time + tx_interval(sim, flow, flow->last_tx_size);
+			result = schedule_tx(sim, flow_idx, next > sim->now ? next : sim->now);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+
+	if (algo_result.rtt_req && !flow->finished)
+		return send_probe(sim, flow_idx);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Handle the arrival of a flow
+ *
+ * @sim [in]: simulator
+ * @flow_idx [in]: flow index
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_flow_start(struct sim *sim, uint32_t flow_idx)
+{
+	struct sim_flow *flow = &sim->flows[flow_idx];
+	struct pcc_sim_event event = {.type = PCC_SIM_EVENT_ROCE_TX};
+	uint32_t i;
+	doca_error_t result;
+
+	flow->started = true;
+	flow->start_time = sim->now;
+	flow->last_tx_time = sim->now;
+	flow->last_tx_size = sim->conf->mtu;
+	flow->size = sim->conf->flow_size ? (uint64_t)sim->conf->flow_size * KB : UINT64_MAX;
+	flow->remaining = flow->size;
+
+	/* Fairness and utilization are measured once all flows are in */
+	if (flow_idx == sim->conf->nb_flows - 1) {
+		sim->stats.window_start = sim->now;
+		sim->stats.window_link_bytes = sim->link_bytes;
+		for (i = 0; i < sim->conf->nb_flows; i++)
+			sim->flows[i].window_delivered = sim->flows[i].delivered;
+	}
+
+	/* The first event of a flow runs the new flow handler of the algorithm */
+	result = algo_event(sim, flow_idx, &event);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return schedule_tx(sim, flow_idx, sim->now);
+}
+
+/*
+ * Handle the transmission of the next packet of a flow
+ *
+ * @sim [in]: simulator
+ * @ev [in]: transmission event
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_flow_tx(struct sim *sim, const struct sim_event *ev)
+{
+	struct sim_flow *flow = &sim->flows[ev->flow];
+	struct sim_packet pkt = {.flow = ev->flow};
+	struct pcc_sim_event event = {.type = PCC_SIM_EVENT_ROCE_TX};
+	doca_error_t result;
+
+	/* The transmission was rescheduled */
+	if (ev->gen != flow->gen || !flow->tx_scheduled)
+		return DOCA_SUCCESS;
+	flow->tx_scheduled = false;
+	if (flow->remaining == 0)
+		return DOCA_SUCCESS;
+
+	pkt.size = flow->remaining < sim->conf->mtu ? flow->remaining : sim->conf->mtu;
+	flow->remaining -= pkt.size;
+	flow->sample_sent += pkt.size;
+	flow->last_tx_time = sim->now;
+	flow->last_tx_size = pkt.size;
+	result = switch_enqueue(sim, &pkt);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	if (++flow->burst_pkts >= sim->conf->tx_burst || flow->remaining == 0) {
+		flow->burst_pkts = 0;
+		if (flow->probe_sent)
+			event.flags = PCC_SIM_TX_FLAG_RTT_REQ_SENT;
+		flow->probe_sent = false;
+		result = algo_event(sim, ev->flow, &event);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	if (flow->remaining == 0 || flow->tx_scheduled)
+		return DOCA_SUCCESS;
+	return schedule_tx(sim, ev->flow, sim->now + tx_interval(sim, flow, pkt.size));
+}
+
+/*
+ * Handle the end of the transmission of the head packet of the switch port
+ *
+ * @sim [in]: simulator
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_switch_tx(struct sim *sim)
+{
+	struct sim_queue *queue = &sim->queue;
+	struct sim_event event = {.type = SIM_EV_NP_RX, .time = sim->now + sim->half_rtt};
+	doca_error_t result;
+
+	queue_account(sim);
+	event.pkt = queue->pkts[queue->head];
+	event.flow = event.pkt.flow;
+	queue->head = (queue->head + 1) % queue->capacity;
+	queue->count--;
+	queue->bytes -= event.pkt.size;
+	sim->link_bytes += event.pkt.size;
+
+	/* The switch stamps its port telemetry on RTT requests */
+	if (event.pkt.probe) {
+		event.probe.send_ts = event.pkt.send_ts;
+		event.probe.switch_qlen = (uint32_t)queue->bytes;
+		event.probe.switch_tx_bytes = (uint32_t)sim->link_bytes;
+		event.probe.switch_ts = (uint32_t)(sim->now / PS_PER_NS);
+	}
+
+	result = schedule_event(sim, &event);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	if (queue->count == 0) {
+		sim->link_busy = false;
+		return DOCA_SUCCESS;
+	}
+	return switch_start_tx(sim);
+}
+
+/*
+ * Handle the arrival of a packet at the receiver
+ *
+ * @sim [in]: simulator
+ * @ev [in]: arrival event
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_np_rx(struct sim *sim, const struct sim_event *ev)
+{
+	struct sim_flow *flow = &sim->flows[ev->flow];
+	struct sim_event event = {.flow = ev->flow, .time = sim->now + sim->half_rtt};
+	uint64_t cnp_interval = (uint64_t)sim->conf->cnp_interval * PS_PER_US;
+
+	sim->np_rx_bytes += ev->pkt.size;
+
+	/* The receiver answers RTT requests at once */
+	if (ev->pkt.probe) {
+		event.type = SIM_EV_RP_RTT;
+		event.probe = ev->probe;
+		event.probe.recv_ts = (uint32_t)(sim->now / PS_PER_NS);
+		event.probe.np_rx_bytes = (uint32_t)sim->np_rx_bytes;
+		event.probe.np_rx_ts_us = (uint32_t)(sim->now / PS_PER_US);
+		return schedule_event(sim, &event);
+	}
+
+	flow->delivered += ev->pkt.size;
+	if (!flow->finished && flow->delivered >= flow->size) {
+		flow->finished = true;
+		flow->finish_time = sim->now;
+		sim->nb_finished++;
+	}
+
+	if (!ev->pkt.ecn || (flow->cnp_sent && sim->now - flow->last_cnp_time < cnp_interval))
+		return DOCA_SUCCESS;
+
+	flow->cnp_sent = true;
+	flow->last_cnp_time = sim->now;
+	sim->stats.cnps++;
+	event.type = SIM_EV_RP_CNP;
+	return schedule_event(sim, &event);
+}
+
+/*
+ * Compute the Jain fairness index of a set of values
+ *
+ * @sum [in]: sum of the values
+ * @sum_sq [in]: sum of the squared values
+ * @n [in]: number of values
+ * @return: fairness index between 1 / n and 1, 1 for an empty set
+ */
+static inline double jain_index(double sum, double sum_sq, uint32_t n)
+{
+	if (n == 0 || sum_sq == 0)
+		return 1;
+	return sum * sum / (n * sum_sq);
+}
+
+/*
+ * Sample the metrics, track the convergence and write a trace line
+ *
+ * @sim [in]: simulator
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_sample(struct sim *sim)
+{
+	const struct pcc_sim_config *conf = sim->conf;
+	struct sim_stats *stats = &sim->stats;
+	uint64_t interval = (uint64_t)conf->sample_interval * PS_PER_US;
+	uint64_t last_arrival = (uint64_t)conf->arrival_interval * (conf->nb_flows - 1) * PS_PER_US;
+	double rate, sum = 0, sum_sq = 0, fairness, util, port_util, sent = 0;
+	uint32_t i, nb_active = 0;
+
+	for (i = 0; i < conf->nb_flows; i++) {
+		if (!sim->flows[i].started || sim->flows[i].finished)
+			continue;
+		rate = (double)sim->flows[i].rate * conf->host_rate / PCC_SIM_MAX_RATE;
+		sum += rate;
+		sum_sq += rate * rate;
+		sent += sim->flows[i].sample_sent;
+		sim->flows[i].sample_sent = 0;
+		nb_active++;
+	}
+	fairness = jain_index(sum, sum_sq, nb_active);
+	util = (double)(sim->link_bytes - stats->last_sample_link_bytes) * 8 * PS_PER_NS / interval / conf->link_rate;
+	stats->last_sample_link_bytes = sim->link_bytes;
+
+	/* TX utilization of the sender ports, sampled by the device program when TX bytes sampling is enabled */
+	port_util = nb_active ? sent * 8 * PS_PER_NS / interval / conf->host_rate / nb_active : 0;
+	pcc_sim_algo_set_port_util(0, port_util >= 1 ? (1 << UTIL_SHIFT) : (uint32_t)(port_util * (1 << UTIL_SHIFT)));
+
+	stats->queue_samples[stats->nb_queue_samples++] = (uint32_t)sim->queue.bytes;
+
+	if (sim->now >= last_arrival && nb_active > 0) {
+		if (fairness * 100 < conf->fairness_threshold)
+			stats->converged_since = UINT64_MAX;
+		else if (stats->converged_since == UINT64_MAX)
+			stats->converged_since = sim->now;
+	}
+
+	if (sim->trace != NULL) {
+		fprintf(sim->trace,
+			"%.1f,%" PRIu64 ",%.3f,%.4f",
+			(double)sim->now / PS_PER_US,
+			sim->queue.bytes,
+			util,
+			fairness);
+		for (i = 0; i < conf->nb_flows; i++)
+			fprintf(sim->trace, ",%.3f", (double)sim->flows[i].rate * conf->host_rate / PCC_SIM_MAX_RATE);
+		fprintf(sim->trace, "\n");
+	}
+
+	if (sim->now + interval >= sim->end_time)
+		return DOCA_SUCCESS;
+	return schedule_flow_event(sim, SIM_EV_SAMPLE, sim->now + interval, 0);
+}
+
+/*
+ * Process a simulator event
+ *
+ * @sim [in]: simulator
+ * @ev [in]: event
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t process_event(struct sim *sim, const struct sim_event *ev)
+{
+	struct pcc_sim_event event = {0};
+	doca_error_t result;
+
+	switch (ev->type) {
+	case SIM_EV_FLOW_START:
+		return handle_flow_start(sim, ev->flow);
+	case SIM_EV_FLOW_TX:
+		return handle_flow_tx(sim, ev);
+	case SIM_EV_SWITCH_TX:
+		return handle_switch_tx(sim);
+	case SIM_EV_NP_RX:
+		return handle_np_rx(sim, ev);
+	case SIM_EV_RP_CNP:
+		event.type = PCC_SIM_EVENT_ROCE_CNP;
+		return algo_event(sim, ev->flow, &event);
+	case SIM_EV_RP_NACK:
+		sim->flows[ev->flow].nack_pending = false;
+		event.type = PCC_SIM_EVENT_ROCE_NACK;
+		result = algo_event(sim, ev->flow, &event);
+		if (result != DOCA_SUCCESS)
+			return result;
+		/* Resume a sender that was done before its lost bytes were reported */
+		if (sim->flows[ev->flow].tx_scheduled || sim->flows[ev->flow].remaining == 0)
+			return DOCA_SUCCESS;
+		return schedule_tx(sim, ev->flow, sim->now);
+	case SIM_EV_RP_RTT:
+		event.type = PCC_SIM_EVENT_RTT;
+		pcc_sim_algo_fill_rtt_event(sim->algo, &ev->probe, &event);
+		return algo_event(sim, ev->flow, &event);
+	case SIM_EV_SAMPLE:
+		return handle_sample(sim);
+	default:
+		return DOCA_SUCCESS;
+	}
+}
+
+/*
+ * Set the algorithm parameters given on the command line
+ *
+ * @algo [in]: algorithm
+ * @params [in]: parameters, "id=value,..."
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t apply_algo_params(struct pcc_sim_algo *algo, const char *params)
+{
+	char buf[PCC_SIM_MAX_PARAMS_STR_LEN];
+	char *token, *saveptr, *end;
+	unsigned long id, value;
+	int ret;
+
+	strcpy(buf, params);
+	for (token = strtok_r(buf, ",", &saveptr); token != NULL; token = strtok_r(NULL, ",", &saveptr)) {
+		errno = 0;
+		id = strtoul(token, &end, 0);
+		if (errno != 0 || end == token || *end != '=') {
+			DOCA_LOG_ERR("Invalid algorithm parameter \"%s\", expected id=value", token);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		token = end + 1;
+		value = strtoul(token, &end, 0);
+		if (errno != 0 || end == token || *end != '\0' || value > UINT32_MAX) {
+			DOCA_LOG_ERR("Invalid value of algorithm parameter %lu", id);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		if (id >= pcc_sim_algo_get_nb_params(algo)) {
+			DOCA_LOG_ERR("Algorithm has no parameter %lu", id);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		ret = pcc_sim_algo_set_param(algo, id, value);
+		if (ret != 0) {
+			DOCA_LOG_ERR("Algorithm rejected value %lu of parameter %lu: %s", value, id, strerror(-ret));
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Compare two queue samples
+ *
+ * @a [in]: first sample
+ * @b [in]: second sample
+ * @return: negative, zero or positive as a is smaller, equal or larger than b
+ */
+static int cmp_queue_samples(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Report the algorithm parameters
+ *
+ * @algo [in]: algorithm
+ */
+static void report_params(const struct pcc_sim_algo *algo)
+{
+	const struct pcc_sim_param_info *info;
+	const char *desc;
+	uint32_t i, value;
+
+	DOCA_LOG_INFO("Algorithm \"%s\" parameters:", pcc_sim_algo_get_desc(algo));
+	for (i = 0; i < pcc_sim_algo_get_nb_params(algo); i++) {
+		pcc_sim_algo_get_param(algo, i, &value, &info);
+		DOCA_LOG_INFO("  [%u] %-48s %u", i, info->desc[0] != '\0' ? info->desc : "(unregistered)", value);
+	}
+	for (i = 0; i < pcc_sim_algo_get_nb_counters(algo); i++) {
+		pcc_sim_algo_get_counter(algo, i, &value, &desc);
+		DOCA_LOG_INFO("  counter [%u] %-40s %u", i, desc, value);
+	}
+}
+
+/*
+ * Report the results of the simulation
+ *
+ * @sim [in]: simulator, at the end of the run
+ * @wall_ns [in]: wall clock time of the run
+ */
+static void report_results(struct sim *sim, uint64_t wall_ns)
+{
+	const struct pcc_sim_config *conf = sim->conf;
+	struct sim_stats *stats = &sim->stats;
+	uint64_t last_arrival = (uint64_t)conf->arrival_interval * (conf->nb_flows - 1) * PS_PER_US;
+	uint64_t window, end, fct, fct_min = UINT64_MAX, fct_max = 0, fct_sum = 0, calls = 0, algo_ns = 0;
+	double tput, sum = 0, sum_sq = 0, util;
+	uint32_t i, nb = 0, p99;
+
+	DOCA_LOG_INFO("Incast of %u flows at %u Gbps into %u Gbps, buffer %u KB, ECN %u KB, base RTT %u ns",
+		      conf->nb_flows,
+		      conf->host_rate,
+		      conf->link_rate,
+		      conf->buffer_size,
+		      conf->ecn_threshold,
+		      conf->base_rtt);
+	DOCA_LOG_INFO("Simulated %.1f us in %.3f s", (double)sim->now / PS_PER_US, (double)wall_ns / 1e9);
+
+	/* Convergence */
+	if (stats->converged_since != UINT64_MAX)
+		DOCA_LOG_INFO("Convergence: %.1f us after the last arrival (Jain index of the rates >= %u%%)",
+			      (double)(stats->converged_since - last_arrival) / PS_PER_US,
+			      conf->fairness_threshold);
+	else
+		DOCA_LOG_INFO("Convergence: not reached (Jain index of the rates >= %u%%)", conf->fairness_threshold);
+
+	/* Queue depth */
+	queue_account(sim);
+	p99 = 0;
+	if (stats->nb_queue_samples > 0) {
+		qsort(stats->queue_samples, stats->nb_queue_samples, sizeof(uint32_t), cmp_queue_samples);
+		p99 = stats->queue_samples[(uint64_t)(stats->nb_queue_samples - 1) * 99 / 100];
+	}
+	DOCA_LOG_INFO("Queue depth: avg %.1f KB, p99 %.1f KB, max %.1f KB",
+		      sim->now ? stats->queue_integral / sim->now / KB : 0,
+		      (double)p99 / KB,
+		      (double)stats->queue_max / KB);
+	DOCA_LOG_INFO("Drops: %" PRIu64 " packets (%" PRIu64 " KB), %" PRIu64 " RTT requests of %" PRIu64,
+		      stats->drops,
+		      stats->drop_bytes / KB,
+		      stats->probe_drops,
+		      stats->probes);
+	DOCA_LOG_INFO("ECN marks: %" PRIu64 ", CNPs: %" PRIu64 ", NACKs: %" PRIu64,
+		      stats->ecn_marks,
+		      stats->cnps,
+		      stats->nacks);
+
+	/* Fairness of the throughputs, once all flows are in */
+	for (i = 0; i < conf->nb_flows; i++) {
+		end = sim->flows[i].finished ? sim->flows[i].finish_time : sim->now;
+		if (end <= stats->window_start)
+			continue;
+		tput = (double)(sim->flows[i].delivered - sim->flows[i].window_delivered) / (end - stats->window_start);
+		sum += tput;
+		sum_sq += tput * tput;
+		nb++;
+	}
+	window = sim->now - stats->window_start;
+	util = 0;
+	if (window != 0)
+		util = (double)(sim->link_bytes - stats->window_link_bytes) * 8 * PS_PER_NS / window / conf->link_rate;
+	DOCA_LOG_INFO("Fairness: Jain index of the throughputs %.4f, link utilization %.1f%%",
+		      jain_index(sum, sum_sq, nb),
+		      util * 100);
+
+	/* Flow completion times */
+	if (conf->flow_size != 0) {
+		nb = 0;
+		for (i = 0; i < conf->nb_flows; i++) {
+			if (!sim->flows[i].finished)
+				continue;
+			fct = sim->flows[i].finish_time - sim->flows[i].start_time;
+			fct_sum += fct;
+			fct_min = fct < fct_min ? fct : fct_min;
+			fct_max = fct > fct_max ? fct : fct_max;
+			nb++;
+		}
+		if (nb > 0)
+			DOCA_LOG_INFO("FCT: %u of %u flows done, min %.1f us, avg %.1f us, max %.1f us",
+				      nb,
+				      conf->nb_flows,
+				      (double)fct_min / PS_PER_US,
+				      (double)fct_sum / nb / PS_PER_US,
+				      (double)fct_max / PS_PER_US);
+		else
+			DOCA_LOG_INFO("FCT: no flow done");
+	}
+
+	/* Algorithm CPU cost */
+	DOCA_LOG_INFO("Algorithm cost per CC event (timer overhead of %" PRIu64 " ns removed):",
+		      sim->timer_overhead_ns);
+	for (i = 0; i < NB_ALGO_EVENT_TYPES; i++) {
+		if (stats->algo_calls[i] == 0)
+			continue;
+		calls += stats->algo_calls[i];
+		algo_ns += stats->algo_ns[i];
+		DOCA_LOG_INFO("  %-5s %12" PRIu64 " events, avg %.1f ns, max %" PRIu64 " ns",
+			      algo_event_names[i],
+			      stats->algo_calls[i],
+			      (double)stats->algo_ns[i] / stats->algo_calls[i],
+			      stats->algo_max_ns[i]);
+	}
+	DOCA_LOG_INFO("  total %12" PRIu64 " events, avg %.1f ns, %" PRIu64 " simulator events at %.2f M/s",
+		      calls,
+		      calls ? (double)algo_ns / calls : 0,
+		      stats->nb_sim_events,
+		      wall_ns ? (double)stats->nb_sim_events * 1e3 / wall_ns : 0);
+
+	report_params(sim->algo);
+}
+
+doca_error_t pcc_sim_run(const struct pcc_sim_config *conf)
+{
+	struct sim sim = {0};
+	struct sim_event ev;
+	uint64_t arrival = (uint64_t)conf->arrival_interval * PS_PER_US;
+	uint64_t wall_start;
+	uint32_t i;
+	doca_error_t result;
+	int ret;
+
+	sim.conf = conf;
+	sim.end_time = (uint64_t)conf->duration * PS_PER_US;
+	sim.buffer_bytes = (uint64_t)conf->buffer_size * KB;
+	sim.ecn_bytes = (uint64_t)conf->ecn_threshold * KB;
+	sim.half_rtt = (uint64_t)conf->base_rtt * PS_PER_NS / 2;
+	sim.stats.converged_since = UINT64_MAX;
+
+	ret = pcc_sim_algo_create(conf->algo, conf->link_rate, &sim.algo);
+	if (ret != 0) {
+		DOCA_LOG_ERR("Failed to create algorithm \"%s\", supported algorithms: %s",
+			     conf->algo,
+			     pcc_sim_algo_names());
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	result = apply_algo_params(sim.algo, conf->params);
+	if (result != DOCA_SUCCESS)
+		goto destroy_algo;
+
+	sim.flows = calloc(conf->nb_flows, sizeof(*sim.flows));
+	sim.heap_capacity = INITIAL_HEAP_SIZE;
+	sim.heap = malloc(sim.heap_capacity * sizeof(*sim.heap));
+	sim.queue.capacity = INITIAL_QUEUE_SIZE;
+	sim.queue.pkts = malloc(sim.queue.capacity * sizeof(*sim.queue.pkts));
+	sim.stats.queue_samples = malloc((conf->duration / conf->sample_interval + 1) * sizeof(uint32_t));
+	if (sim.flows == NULL || sim.heap == NULL || sim.queue.pkts == NULL || sim.stats.queue_samples == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the simulator state");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_state;
+	}
+
+	if (conf->trace_path[0] != '\0') {
+		sim.trace = fopen(conf->trace_path, "w");
+		if (sim.trace == NULL) {
+			DOCA_LOG_ERR("Failed to open trace file %s: %s", conf->trace_path, strerror(errno));
+			result = DOCA_ERROR_IO_FAILED;
+			goto free_state;
+		}
+		fprintf(sim.trace, "time_us,queue_bytes,utilization,fairness");
+		for (i = 0; i < conf->nb_flows; i++)
+			fprintf(sim.trace, ",rate_gbps_%u", i);
+		fprintf(sim.trace, "\n");
+	}
+
+	for (i = 0; i < conf->nb_flows; i++) {
+		result = schedule_flow_event(&sim, SIM_EV_FLOW_START, i * arrival, i);
+		if (result != DOCA_SUCCESS)
+			goto close_trace;
+	}
+	result = schedule_flow_event(&sim, SIM_EV_SAMPLE, (uint64_t)conf->sample_interval * PS_PER_US, 0);
+	if (result != DOCA_SUCCESS)
+		goto close_trace;
+	result = schedule_flow_event(&sim, SIM_EV_END, sim.end_time, 0);
+	if (result != DOCA_SUCCESS)
+		goto close_trace;
+
+	sim.timer_overhead_ns = calibrate_timer();
+	wall_start = get_time_ns();
+	while (sim.heap_size > 0) {
+		pop_event(&sim, &ev);
+		sim.now = ev.time;
+		if (ev.type == SIM_EV_END)
+			break;
+		sim.stats.nb_sim_events++;
+		result = process_event(&sim, &ev);
+		if (result != DOCA_SUCCESS)
+			goto close_trace;
+		/* Finite flows end the run once all of them are delivered */
+		if (conf->flow_size != 0 && sim.nb_finished == conf->nb_flows)
+			break;
+	}
+	report_results(&sim, get_time_ns() - wall_start);
+	result = DOCA_SUCCESS;
+
+close_trace:
+	if (sim.trace != NULL)
+		fclose(sim.trace);
+free_state:
+	free(sim.stats.queue_samples);
+	free(sim.queue.pkts);
+	free(sim.heap);
+	free(sim.flows);
+destroy_algo:
+	pcc_sim_algo_destroy(sim.algo);
+	return result;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCC_SIM_CORE_H_
+#define PCC_SIM_CORE_H_
+
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#define MAX_FILE_NAME 255	       /* Max file name */
+#define PCC_SIM_MAX_ALGO_NAME_LEN 32   /* Maximal length of an algorithm name */
+#define PCC_SIM_MAX_PARAMS_STR_LEN 256 /* Maximal length of the algorithm parameters string */
+#define PCC_SIM_MAX_FLOWS 4096	       /* Maximal number of flows */
+
+/*
+ * Incast model:
+ *	nb_flows senders, each behind its own host link of host_rate, start one arrival_interval apart and send to a
+ *	single receiver through a switch port of link_rate. The switch port is a FIFO of buffer bytes with tail drop,
+ *	and marks ECN on packets enqueued above the ECN threshold.
+ *	The notification point paces CNPs per flow, a drop is reported to the sender by a NACK one base RTT later and
+ *	the dropped bytes are sent again. RTT requests are 64B packets queued with the data, and carry the switch
+ *	telemetry of the port when they leave it.
+ *	Half of the base RTT is spent between the switch and the receiver, and the other half on the way back.
+ */
+struct pcc_sim_config {
+	char algo[PCC_SIM_MAX_ALGO_NAME_LEN];	 /* Reaction point algorithm name */
+	char params[PCC_SIM_MAX_PARAMS_STR_LEN]; /* Algorithm parameters, "id=value,..." */
+	char trace_path[MAX_FILE_NAME];		 /* CSV trace of the samples, empty to disable */
+	uint32_t nb_flows;			 /* Number of incast flows */
+	uint32_t link_rate;			 /* Bottleneck link rate, in Gbps */
+	uint32_t host_rate;			 /* Sender host link rate, in Gbps */
+	uint32_t buffer_size;			 /* Switch port buffer, in KB */
+	uint32_t ecn_threshold;			 /* Switch port ECN marking threshold, in KB, 0 to disable */
+	uint32_t base_rtt;			 /* Base round trip time, in nanoseconds */
+	uint32_t mtu;				 /* Packet size, in bytes */
+	uint32_t arrival_interval;		 /* Time between flow arrivals, in microseconds */
+	uint32_t flow_size;			 /* Flow size, in KB, 0 for flows lasting the whole run */
+	uint32_t duration;			 /* Simulated time, in microseconds */
+	uint32_t tx_burst;			 /* Packets per TX event */
+	uint32_t cnp_interval;			 /* Minimal time between CNPs of a flow, in microseconds */
+	uint32_t sample_interval;		 /* Time between samples of the metrics, in microseconds */
+	uint32_t fairness_threshold;		 /* Jain index a converged incast keeps, in percent */
+};
+
+/*
+ * Register the command line parameters for the PCC simulator
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t register_pcc_sim_params(void);
+
+/*
+ * Run the incast simulation and report convergence time, queue depth, fairness and per event CPU cost
+ *
+ * @conf [in]: simulator configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t pcc_sim_run(const struct pcc_sim_config *conf);
+
+#endif /* PCC_SIM_CORE_H_ */
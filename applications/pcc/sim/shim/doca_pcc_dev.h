@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host shim of the DPA device API types, used by the PCC simulator in place of the DOCA PCC device headers.
+ * Only the subset used by the reaction point algorithms of device/rp is provided.
+ */
+
+#ifndef DOCA_PCC_DEV_H_
+#define DOCA_PCC_DEV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "doca_pcc_dev_utils.h"
+#include "pcc_sim_algo.h"
+
+#define DOCA_PCC_DEV_MAX_NUM_PORTS 4	       /* Maximal number of ports */
+#define DOCA_PCC_DEV_MAX_RATE PCC_SIM_MAX_RATE /* Line rate */
+
+/* Status of the device API calls */
+typedef enum {
+	DOCA_PCC_DEV_STATUS_OK = 0,   /* Success */
+	DOCA_PCC_DEV_STATUS_FAIL = 1, /* Failure */
+} doca_pcc_dev_error_t;
+
+/* CC event */
+typedef struct pcc_sim_event doca_pcc_dev_event_t;
+
+/* Per flow algorithm context */
+typedef struct pcc_sim_ctxt doca_pcc_dev_algo_ctxt_t;
+
+/* Algorithm results */
+typedef struct pcc_sim_result doca_pcc_dev_results_t;
+
+#endif /* DOCA_PCC_DEV_H_ */
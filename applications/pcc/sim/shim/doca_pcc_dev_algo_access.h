@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host shim of the DPA algorithm registration API, used by the PCC simulator in place of the DOCA PCC device headers.
+ * The registered metadata, parameters and counters are recorded by the simulator algorithm adapter.
+ */
+
+#ifndef DOCA_PCC_DEV_ALGO_ACCESS_H_
+#define DOCA_PCC_DEV_ALGO_ACCESS_H_
+
+#include "doca_pcc_dev.h"
+
+/* Algorithm metadata */
+struct doca_pcc_dev_algo_meta_data {
+	uint32_t algo_id;	     /* Algorithm identifier */
+	uint32_t algo_major_version; /* Major version */
+	uint32_t algo_minor_version; /* Minor version */
+	uint32_t algo_desc_size;     /* Size of the description string */
+	uint64_t algo_desc_addr;     /* Address of the description string */
+};
+
+/*
+ * Register the metadata of an algorithm
+ *
+ * @algo_idx [in]: algorithm index
+ * @user_def [in]: algorithm metadata
+ * @param_num [in]: number of parameters of the algorithm
+ * @counter_num [in]: number of counters of the algorithm
+ * @return: DOCA_PCC_DEV_STATUS_OK on success and DOCA_PCC_DEV_STATUS_FAIL otherwise
+ */
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_metadata(uint32_t algo_idx,
+						     const struct doca_pcc_dev_algo_meta_data *user_def,
+						     uint32_t param_num,
+						     uint32_t counter_num);
+
+/*
+ * Register a parameter of an algorithm
+ *
+ * @algo_idx [in]: algorithm index
+ * @param_id [in]: parameter index
+ * @default_value [in]: default value
+ * @max_value [in]: maximal value
+ * @min_value [in]: minimal value
+ * @permissions [in]: parameter permissions
+ * @param_desc_size [in]: size of the description string
+ * @param_desc_addr [in]: address of the description string
+ * @return: DOCA_PCC_DEV_STATUS_OK on success and DOCA_PCC_DEV_STATUS_FAIL otherwise
+ */
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_param(uint32_t algo_idx,
+						  uint32_t param_id,
+						  uint32_t default_value,
+						  uint32_t max_value,
+						  uint32_t min_value,
+						  uint32_t permissions,
+						  uint32_t param_desc_size,
+						  uint64_t param_desc_addr);
+
+/*
+ * Register a counter of an algorithm
+ *
+ * @algo_idx [in]: algorithm index
+ * @counter_id [in]: counter index
+ * @max_value [in]: maximal value
+ * @permissions [in]: counter permissions
+ * @counter_desc_size [in]: size of the description string
+ * @counter_desc_addr [in]: address of the description string
+ * @return: DOCA_PCC_DEV_STATUS_OK on success and DOCA_PCC_DEV_STATUS_FAIL otherwise
+ */
+doca_pcc_dev_error_t doca_pcc_dev_algo_init_counter(uint32_t algo_idx,
+						    uint32_t counter_id,
+						    uint32_t max_value,
+						    uint32_t permissions,
+						    uint32_t counter_desc_size,
+						    uint64_t counter_desc_addr);
+
+#endif /* DOCA_PCC_DEV_ALGO_ACCESS_H_ */
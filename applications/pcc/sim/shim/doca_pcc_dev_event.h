@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host shim of the DPA event extractors, used by the PCC simulator in place of the DOCA PCC device headers
+ */
+
+#ifndef DOCA_PCC_DEV_EVENT_H_
+#define DOCA_PCC_DEV_EVENT_H_
+
+#include "doca_pcc_dev.h"
+
+#define DOCA_PCC_DEV_EVNT_NULL PCC_SIM_EVENT_NULL		       /* No event */
+#define DOCA_PCC_DEV_EVNT_FW PCC_SIM_EVENT_FW			       /* Firmware event */
+#define DOCA_PCC_DEV_EVNT_ROCE_CNP PCC_SIM_EVENT_ROCE_CNP	       /* CNP received */
+#define DOCA_PCC_DEV_EVNT_ROCE_TX PCC_SIM_EVENT_ROCE_TX		       /* Burst of packets sent */
+#define DOCA_PCC_DEV_EVNT_ROCE_ACK PCC_SIM_EVENT_ROCE_ACK	       /* ACK received */
+#define DOCA_PCC_DEV_EVNT_ROCE_NACK PCC_SIM_EVENT_ROCE_NACK	       /* NACK received */
+#define DOCA_PCC_DEV_EVNT_RTT PCC_SIM_EVENT_RTT			       /* RTT response received */
+#define DOCA_PCC_DEV_TX_FLAG_RTT_REQ_SENT PCC_SIM_TX_FLAG_RTT_REQ_SENT /* RTT request sent with the TX burst */
+
+/* General event attributes */
+typedef struct {
+	uint32_t ev_type;  /* Event type */
+	uint32_t flags;	   /* Event flags */
+	uint32_t port_num; /* Port of the flow */
+} doca_pcc_dev_event_general_attr_t;
+
+/*
+ * Get the general attributes of an event
+ *
+ * @event [in]: CC event
+ * @return: event attributes
+ */
+FORCE_INLINE doca_pcc_dev_event_general_attr_t doca_pcc_dev_get_ev_attr(doca_pcc_dev_event_t *event)
+{
+	doca_pcc_dev_event_general_attr_t attr = {
+		.ev_type = event->type,
+		.flags = event->flags,
+		.port_num = event->port_num,
+	};
+
+	return attr;
+}
+
+/*
+ * Get the timestamp of an event
+ *
+ * @event [in]: CC event
+ * @return: event time in nanoseconds
+ */
+FORCE_INLINE uint32_t doca_pcc_dev_get_timestamp(doca_pcc_dev_event_t *event)
+{
+	return event->timestamp;
+}
+
+/*
+ * Get the time at which the RTT request of an RTT event was sent
+ *
+ * @event [in]: RTT event
+ * @return: send time in nanoseconds
+ */
+FORCE_INLINE uint32_t doca_pcc_dev_get_rtt_req_send_timestamp(doca_pcc_dev_event_t *event)
+{
+	return event->rtt_req_send_ts;
+}
+
+/*
+ * Get the time at which the RTT request of an RTT event reached the notification point
+ *
+ * @event [in]: RTT event
+ * @return: arrival time in nanoseconds
+ */
+FORCE_INLINE uint32_t doca_pcc_dev_get_rtt_req_recv_timestamp(doca_pcc_dev_event_t *event)
+{
+	return event->rtt_req_recv_ts;
+}
+
+/*
+ * Get the payload of the RTT response of an RTT event
+ *
+ * @event [in]: RTT event
+ * @return: payload of PCC_SIM_RTT_RAW_DATA_DW double words
+ */
+FORCE_INLINE unsigned char *doca_pcc_dev_get_rtt_raw_data(doca_pcc_dev_event_t *event)
+{
+	return (unsigned char *)event->rtt_raw_data;
+}
+
+#endif /* DOCA_PCC_DEV_EVENT_H_ */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * Host shim of the DPA fixed point helpers, used by the PCC simulator in place of the DOCA PCC device headers.
+ * The reciprocal is computed exactly, where the device may use an approximation.
+ */
+
+#ifndef DOCA_PCC_DEV_UTILS_H_
+#define DOCA_PCC_DEV_UTILS_H_
+
+#include <stdint.h>
+
+#ifndef FORCE_INLINE
+#define FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+#ifndef ALWAYS_INLINE
+#define ALWAYS_INLINE static inline __attribute__((always_inline))
+#endif
+
+/*
+ * Multiply two 32 bit values into a 64 bit value
+ *
+ * @a [in]: first operand
+ * @b [in]: second operand
+ * @return: a * b
+ */
+FORCE_INLINE uint64_t doca_pcc_dev_mult(uint32_t a, uint32_t b)
+{
+	return (uint64_t)a * b;
+}
+
+/*
+ * Multiply two 16 bit fixed point values
+ *
+ * @a [in]: first operand
+ * @b [in]: second operand
+ * @return: a * b in 16 bit fixed point
+ */
+FORCE_INLINE uint32_t doca_pcc_dev_fxp_mult(uint32_t a, uint32_t b)
+{
+	return (uint32_t)(doca_pcc_dev_mult(a, b) >> 16);
+}
+
+/*
+ * Reciprocal of a 16 bit fixed point value
+ *
+ * @a [in]: operand
+ * @return: 1 / a in 16 bit fixed point, saturated to UINT32_MAX
+ */
+FORCE_INLINE uint32_t doca_pcc_dev_fxp_recip(uint32_t a)
+{
+	if (a <= 1)
+		return UINT32_MAX;
+	return (uint32_t)((1ULL << 32) / a);
+}
+
+#endif /* DOCA_PCC_DEV_UTILS_H_ */
@@ -49,6 +49,7 @@
 // application
 #include <psp_gw_config.h>
 #include <psp_gw_flows.h>
+#include <psp_gw_mock_peer.h>
 #include <psp_gw_svc_impl.h>
 #include <psp_gw_params.h>
 #include <psp_gw_pkt_rss.h>
@@ -94,6 +95,9 @@ int main(int argc, char **argv)
 	app_config.pf_repr_indices = "[0]";
 	app_config.core_mask = "0x3";
 	app_config.max_tunnels = 256;
+	app_config.crypto_id_grace_ms = 100;
+	app_config.max_pending_pkts_per_peer = 64;
+	app_config.tunnel_request_timeout_ms = 1000;
 	app_config.net_config.vc_enabled = false;
 	app_config.net_config.crypt_offset = UINT32_MAX;
 	app_config.net_config.default_psp_proto_ver = UINT32_MAX;
@@ -152,6 +156,12 @@ int main(int argc, char **argv)
 		goto dpdk_destroy;
 	}
 
+	if (!app_config.mock_peer_addr.empty()) {
+		// Every tunnel request goes to the in-process mock peer
+		for (auto &peer : app_config.net_config.peers)
+			peer.svc_addr = app_config.mock_peer_addr;
+	}
+
 	if (app_config.net_config.crypt_offset == UINT32_MAX) {
 		// If not specified by argp, select a default crypt_offset
 		if (app_config.inner == DOCA_FLOW_L3_TYPE_IP4)
@@ -257,6 +267,22 @@ int main(int argc, char **argv)
 
 		PSP_GatewayImpl psp_svc(&app_config, &psp_flows);
 
+		result = psp_svc.init();
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create session tables");
+			exit_status = EXIT_FAILURE;
+			goto dpdk_cleanup;
+		}
+
+		PSP_GatewayMockPeer mock_peer(&app_config);
+		if (!app_config.mock_peer_addr.empty()) {
+			result = mock_peer.start();
+			if (result != DOCA_SUCCESS) {
+				exit_status = EXIT_FAILURE;
+				goto dpdk_cleanup;
+			}
+		}
+
 		struct lcore_params lcore_params = {
 			&force_quit,
 			&app_config,
@@ -324,6 +350,7 @@ workers_cleanup:
 			DOCA_LOG_INFO("Stopping L-Core %d", lcore_id);
 			rte_eal_wait_lcore(lcore_id);
 		}
+		mock_peer.stop();
 	}
 
 dpdk_cleanup:
@@ -58,7 +58,8 @@ static constexpr uint32_t DEFAULT_CRYPT_OFFSET_VC_ENABLED_IPV6 = 12;
 
 static constexpr uint16_t PSP_PERF_KEY_GEN_PRINT = 1 << 0;
 static constexpr uint16_t PSP_PERF_INSERTION_PRINT = 1 << 1;
-static constexpr uint16_t PSP_PERF_ALL = PSP_PERF_KEY_GEN_PRINT | PSP_PERF_INSERTION_PRINT;
+static constexpr uint16_t PSP_PERF_MISS_PRINT = 1 << 2;
+static constexpr uint16_t PSP_PERF_ALL = PSP_PERF_KEY_GEN_PRINT | PSP_PERF_INSERTION_PRINT | PSP_PERF_MISS_PRINT;
 
 static const uint32_t PSP_MAX_PEERS = 1 << 20;	  /* Maximum number of peers supported by the PSP Gateway */
 static const uint32_t PSP_MAX_SESSIONS = 1 << 20; /* Maximum number of sessions supported by the PSP Gateway for each
@@ -66,17 +67,28 @@ static const uint32_t PSP_MAX_SESSIONS = 1 << 20; /* Maximum number of sessions
 
 static const std::string PSP_PERF_KEY_GEN_PRINT_STR = "key-gen";
 static const std::string PSP_PERF_INSERTION_PRINT_STR = "insertion";
+static const std::string PSP_PERF_MISS_PRINT_STR = "miss";
 static const std::string PSP_PERF_ALL_STR = "all";
 
 static const std::map<std::string, uint16_t> PSP_PERF_MAP = {
 	{PSP_PERF_KEY_GEN_PRINT_STR, PSP_PERF_KEY_GEN_PRINT},
 	{PSP_PERF_INSERTION_PRINT_STR, PSP_PERF_INSERTION_PRINT},
+	{PSP_PERF_MISS_PRINT_STR, PSP_PERF_MISS_PRINT},
 	{PSP_PERF_ALL_STR, PSP_PERF_ALL},
 };
 
 static constexpr uint32_t IPV6_ADDR_LEN = 16;
 typedef uint8_t ipv6_addr_t[IPV6_ADDR_LEN];
-using session_key = std::pair<std::string, std::string> /* src_ip, dst_ip */;
+
+/**
+ * @brief Binary key of a session: the (src vip, dst vip) pair.
+ *        IPv4 addresses are stored in their IPv4-mapped IPv6 form.
+ */
+struct session_key {
+	ipv6_addr_t src_vip;
+	ipv6_addr_t dst_vip;
+};
+static_assert(sizeof(session_key) == 2 * IPV6_ADDR_LEN, "session_key must not contain padding");
 
 struct ip_pair {
 	doca_flow_ip_addr src_vip; /* The source IP address of the traffic flow */
@@ -141,7 +153,14 @@ struct psp_gw_app_config {
 	bool nexthop_enable;	     /* Whether to override the dmac in the tunnel request with a nexthop MAC addr */
 	rte_ether_addr nexthop_dmac; /* The dst MAC to apply on encap, if enabled */
 
-	uint32_t max_tunnels; /* The maximum number of outgoing tunnel connections supported on this host */
+	uint32_t max_tunnels;	     /* The maximum number of outgoing tunnel connections supported on this host */
+	uint32_t crypto_id_grace_ms; /* Time a released crypto_id is quarantined before it is reused */
+
+	uint32_t max_pending_pkts_per_peer; /* Max miss packets parked per peer while its tunnels are negotiated */
+	uint32_t tunnel_request_timeout_ms; /* Deadline of an on-demand tunnel request; parked packets are dropped */
+
+	std::string mock_peer_addr;  /* Serve an in-process mock peer here and send all tunnel requests to it */
+	uint32_t mock_peer_delay_ms; /* Time the mock peer waits before answering a tunnel request */
 
 	struct psp_gw_net_config net_config; /* List of remote peers supporting PSP connections */
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <rte_cycles.h>
+
+#include "psp_gw_crypto_ids.h"
+
+void PSP_CryptoIdAllocator::init(uint32_t first_id, uint32_t nb_ids, uint32_t grace_period_ms)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	this->first_id = first_id;
+	this->nb_ids = nb_ids;
+	next_fresh_id = first_id;
+	grace_cycles = rte_get_tsc_hz() / 1000 * grace_period_ms;
+	free_ids.clear();
+	free_ids.reserve(nb_ids);
+	retired_ids.clear();
+}
+
+void PSP_CryptoIdAllocator::reclaim(void)
+{
+	if (retired_ids.empty())
+		return;
+
+	uint64_t now = rte_get_tsc_cycles();
+	while (!retired_ids.empty() && now - retired_ids.front().second >= grace_cycles) {
+		free_ids.push_back(retired_ids.front().first);
+		retired_ids.pop_front();
+	}
+}
+
+uint32_t PSP_CryptoIdAllocator::alloc_locked(void)
+{
+	uint32_t id;
+
+	if (!free_ids.empty()) {
+		id = free_ids.back();
+		free_ids.pop_back();
+	} else if (next_fresh_id - first_id < nb_ids) {
+		id = next_fresh_id++;
+	} else {
+		return UINT32_MAX;
+	}
+
+	nb_in_use++;
+	nb_allocs++;
+	return id;
+}
+
+uint32_t PSP_CryptoIdAllocator::alloc(void)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	reclaim();
+	return alloc_locked();
+}
+
+doca_error_t PSP_CryptoIdAllocator::alloc_bulk(uint32_t nb_requested, uint32_t *ids)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	reclaim();
+	uint32_t nb_available = free_ids.size() + (nb_ids - (next_fresh_id - first_id));
+	if (nb_available < nb_requested)
+		return DOCA_ERROR_NO_MEMORY;
+
+	for (uint32_t i = 0; i < nb_requested; i++)
+		ids[i] = alloc_locked();
+	return DOCA_SUCCESS;
+}
+
+void PSP_CryptoIdAllocator::release(uint32_t id)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	retired_ids.emplace_back(id, rte_get_tsc_cycles());
+	nb_in_use--;
+	nb_frees++;
+}
+
+void PSP_CryptoIdAllocator::release_unused(uint32_t id)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	free_ids.push_back(id);
+	nb_in_use--;
+	nb_frees++;
+}
+
+psp_crypto_id_stats PSP_CryptoIdAllocator::stats(void)
+{
+	std::lock_guard<std::mutex> guard(lock);
+
+	reclaim();
+
+	psp_crypto_id_stats stats = {};
+	stats.capacity = nb_ids;
+	stats.in_use = nb_in_use;
+	stats.retired = retired_ids.size();
+	stats.available = nb_ids - nb_in_use - stats.retired;
+	stats.high_water = next_fresh_id - first_id;
+	stats.nb_allocs = nb_allocs;
+	stats.nb_frees = nb_frees;
+	return stats;
+}
+
+PSP_CryptoIdBatch::~PSP_CryptoIdBatch()
+{
+	for (uint32_t id : ids)
+		allocator.release_unused(id);
+}
+
+doca_error_t PSP_CryptoIdBatch::alloc(uint32_t nb_ids)
+{
+	size_t nb_held = ids.size();
+
+	ids.resize(nb_held + nb_ids);
+	doca_error_t result = allocator.alloc_bulk(nb_ids, ids.data() + nb_held);
+	if (result != DOCA_SUCCESS)
+		ids.resize(nb_held);
+	return result;
+}
+
+uint32_t PSP_CryptoIdBatch::take(void)
+{
+	if (ids.empty())
+		return UINT32_MAX;
+
+	uint32_t id = ids.back();
+	ids.pop_back();
+	return id;
+}
+
+void PSP_CryptoIdBatch::put_back(uint32_t id)
+{
+	ids.push_back(id);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef _PSP_GW_CRYPTO_IDS_H_
+#define _PSP_GW_CRYPTO_IDS_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <doca_error.h>
+
+/**
+ * @brief Occupancy of the crypto_id space
+ */
+struct psp_crypto_id_stats {
+	uint32_t capacity;   /* Number of crypto_ids managed by the allocator */
+	uint32_t in_use;     /* Allocated and not yet released */
+	uint32_t retired;    /* Released, waiting for the grace period to expire */
+	uint32_t available;  /* Ready to be allocated */
+	uint32_t high_water; /* Number of distinct crypto_ids ever handed out */
+	uint64_t nb_allocs;  /* Total allocations */
+	uint64_t nb_frees;   /* Total releases */
+};
+
+/**
+ * @brief Allocates the crypto_ids (PSP shared-resource indices) which hold
+ *        the egress encryption keys.
+ *
+ * Released IDs are not reused until a grace period has elapsed, so packets
+ * already scheduled against the old SA can still be processed. Recycled IDs
+ * are preferred over never-used ones, keeping the ID space compact under
+ * churn. All methods are thread-safe.
+ */
+class PSP_CryptoIdAllocator {
+public:
+	/**
+	 * @brief Configures the range of IDs to manage
+	 *
+	 * @first_id [in]: the lowest crypto_id to hand out
+	 * @nb_ids [in]: the number of crypto_ids in the range
+	 * @grace_period_ms [in]: how long a released ID is quarantined
+	 */
+	void init(uint32_t first_id, uint32_t nb_ids, uint32_t grace_period_ms);
+
+	/**
+	 * @brief Allocates a single crypto_id
+	 *
+	 * @return: the crypto_id, or UINT32_MAX if none is available
+	 */
+	uint32_t alloc(void);
+
+	/**
+	 * @brief Allocates several crypto_ids at once; either all or none
+	 *        are allocated.
+	 *
+	 * @nb_requested [in]: the number of crypto_ids to allocate
+	 * @ids [out]: the allocated crypto_ids
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR_NO_MEMORY otherwise
+	 */
+	doca_error_t alloc_bulk(uint32_t nb_requested, uint32_t *ids);
+
+	/**
+	 * @brief Releases a crypto_id which was programmed into the hardware;
+	 *        it becomes available once the grace period expires.
+	 *
+	 * @id [in]: the crypto_id to release
+	 */
+	void release(uint32_t id);
+
+	/**
+	 * @brief Returns a crypto_id which was never programmed; it becomes
+	 *        available immediately.
+	 *
+	 * @id [in]: the crypto_id to return
+	 */
+	void release_unused(uint32_t id);
+
+	/**
+	 * @brief Returns the current occupancy of the crypto_id space
+	 *
+	 * @return: the allocator statistics
+	 */
+	psp_crypto_id_stats stats(void);
+
+private:
+	/**
+	 * @brief Moves the retired IDs whose grace period expired to the free
+	 *        list. Must be called with the lock held.
+	 */
+	void reclaim(void);
+
+	/**
+	 * @brief Allocates a single crypto_id. Must be called with the lock held.
+	 *
+	 * @return: the crypto_id, or UINT32_MAX if none is available
+	 */
+	uint32_t alloc_locked(void);
+
+	std::mutex lock;
+
+	uint32_t first_id{};		/* The lowest crypto_id in the range */
+	uint32_t nb_ids{};		/* The number of crypto_ids in the range */
+	uint32_t next_fresh_id{};	/* The lowest never-allocated crypto_id */
+	uint64_t grace_cycles{};	/* The grace period, in TSC cycles */
+	std::vector<uint32_t> free_ids;	/* Recycled IDs, ready for reuse */
+	std::deque<std::pair<uint32_t, uint64_t>> retired_ids; /* (id, release TSC), oldest first */
+
+	uint32_t nb_in_use{};
+	uint64_t nb_allocs{};
+	uint64_t nb_frees{};
+};
+
+/**
+ * @brief Holds crypto_ids allocated in bulk for a single request; any which
+ *        are not consumed are returned to the allocator on destruction.
+ */
+class PSP_CryptoIdBatch {
+public:
+	/**
+	 * @brief Constructs an empty batch
+	 *
+	 * @allocator [in]: the allocator the IDs are taken from
+	 */
+	explicit PSP_CryptoIdBatch(PSP_CryptoIdAllocator &allocator) : allocator(allocator)
+	{
+	}
+
+	~PSP_CryptoIdBatch();
+
+	PSP_CryptoIdBatch(const PSP_CryptoIdBatch &) = delete;
+
+	PSP_CryptoIdBatch &operator=(const PSP_CryptoIdBatch &) = delete;
+
+	/**
+	 * @brief Allocates the given number of crypto_ids
+	 *
+	 * @nb_ids [in]: the number of crypto_ids to allocate
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR_NO_MEMORY otherwise
+	 */
+	doca_error_t alloc(uint32_t nb_ids);
+
+	/**
+	 * @brief Hands over the next crypto_id of the batch
+	 *
+	 * @return: the crypto_id, or UINT32_MAX if the batch is exhausted
+	 */
+	uint32_t take(void);
+
+	/**
+	 * @brief Returns a crypto_id obtained from take() which ended up unused
+	 *
+	 * @id [in]: the crypto_id
+	 */
+	void put_back(uint32_t id);
+
+private:
+	PSP_CryptoIdAllocator &allocator;
+
+	std::vector<uint32_t> ids; /* The unconsumed crypto_ids */
+};
+
+#endif /* _PSP_GW_CRYPTO_IDS_H_ */
@@ -1130,7 +1130,7 @@ void PSP_GatewayFlows::format_encap_transport_data(const psp_session_t *session,
 	// encap_hdr->psp.s will be set by the egress_sampling pipe
 }
 
-doca_error_t PSP_GatewayFlows::remove_encrypt_entry(psp_session_t *session)
+doca_error_t PSP_GatewayFlows::remove_encrypt_entry(doca_flow_pipe_entry *entry)
 {
 	DOCA_LOG_DBG("\n>> %s", __FUNCTION__);
 	doca_error_t result = DOCA_SUCCESS;
@@ -1138,7 +1138,7 @@ doca_error_t PSP_GatewayFlows::remove_encrypt_entry(psp_session_t *session)
 	uint32_t flags = DOCA_FLOW_NO_WAIT;
 	uint32_t num_of_entries = 1;
 
-	result = doca_flow_pipe_remove_entry(pipe_queue, flags, session->encap_encrypt_entry);
+	result = doca_flow_pipe_remove_entry(pipe_queue, flags, entry);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_INFO("Error removing PSP encap entry: %s", doca_error_get_descr(result));
 	}
@@ -1931,7 +1931,7 @@ void PSP_GatewayFlows::show_static_flow_counts(void)
 	}
 }
 
-void PSP_GatewayFlows::show_session_flow_count(const session_key session_vips_pair, psp_session_t &session)
+void PSP_GatewayFlows::show_session_flow_count(psp_session_t &session)
 {
 	if (session.encap_encrypt_entry) {
 		doca_flow_resource_query encap_encrypt_stats = {};
@@ -1940,20 +1940,22 @@ void PSP_GatewayFlows::show_session_flow_count(const session_key session_vips_pa
 
 		if (encap_result == DOCA_SUCCESS) {
 			if (session.pkt_count_egress != encap_encrypt_stats.counter.total_pkts) {
+				std::string src_vip = ip_to_string(session.src_vip);
+				std::string dst_vip = ip_to_string(session.dst_vip);
 				DOCA_LOG_DBG("Session Egress (%s -> %s) entry: %p",
-					     session_vips_pair.first.c_str(),
-					     session_vips_pair.second.c_str(),
+					     src_vip.c_str(),
+					     dst_vip.c_str(),
 					     session.encap_encrypt_entry);
 				DOCA_LOG_INFO("Session Egress (%s -> %s): %ld hits",
-					      session_vips_pair.first.c_str(),
-					      session_vips_pair.second.c_str(),
+					      src_vip.c_str(),
+					      dst_vip.c_str(),
 					      encap_encrypt_stats.counter.total_pkts);
 				session.pkt_count_egress = encap_encrypt_stats.counter.total_pkts;
 			}
 		} else {
 			DOCA_LOG_INFO("Session Egress (%s -> %s): query failed: %s",
-				      session_vips_pair.first.c_str(),
-				      session_vips_pair.second.c_str(),
+				      ip_to_string(session.src_vip).c_str(),
+				      ip_to_string(session.dst_vip).c_str(),
 				      doca_error_get_descr(encap_result));
 		}
 	}
@@ -1966,15 +1968,15 @@ void PSP_GatewayFlows::show_session_flow_count(const session_key session_vips_pa
 			if (session.pkt_count_ingress != acl_stats.counter.total_pkts) {
 				DOCA_LOG_DBG("Session ACL entry: %p", session.acl_entry);
 				DOCA_LOG_INFO("Session Ingress (%s <- %s): %ld hits",
-					      session_vips_pair.first.c_str(),
-					      session_vips_pair.second.c_str(),
+					      ip_to_string(session.src_vip).c_str(),
+					      ip_to_string(session.dst_vip).c_str(),
 					      acl_stats.counter.total_pkts);
 				session.pkt_count_ingress = acl_stats.counter.total_pkts;
 			}
 		} else {
 			DOCA_LOG_INFO("Session Ingress (%s <- %s): query failed: %s",
-				      session_vips_pair.first.c_str(),
-				      session_vips_pair.second.c_str(),
+				      ip_to_string(session.src_vip).c_str(),
+				      ip_to_string(session.dst_vip).c_str(),
 				      doca_error_get_descr(result));
 		}
 	}
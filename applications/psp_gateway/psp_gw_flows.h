@@ -74,10 +74,12 @@ struct psp_session_t {
 	uint32_t psp_proto_ver; /* PSP protocol version used by this session */
 	uint64_t vc;		/* Virtualization cookie, if enabled */
 
-	doca_flow_pipe_entry *encap_encrypt_entry; /* DOCA Flow encap & encrypt entry */
-	doca_flow_pipe_entry *acl_entry;	   /* DOC AFlow ACL entry */
-	uint64_t pkt_count_egress;		   /* Count of encap_encrypt_entry */
-	uint64_t pkt_count_ingress;		   /* Count of acl_entry */
+	doca_flow_pipe_entry *encap_encrypt_entry;   /* DOCA Flow encap & encrypt entry */
+	doca_flow_pipe_entry *acl_entry;	     /* DOC AFlow ACL entry */
+	uint64_t pkt_count_egress;		     /* Count of encap_encrypt_entry */
+	uint64_t pkt_count_ingress;		     /* Count of acl_entry */
+	doca_flow_pipe_entry *retired_encrypt_entry; /* Entry being re-keyed, removed once its successor is in */
+	uint32_t retired_crypto_id;		     /* The crypto_id of retired_encrypt_entry */
 };
 
 /**
@@ -141,10 +143,10 @@ public:
 	/**
 	 * @brief Removes the indicated flow entry.
 	 *
-	 * @session [in]: The session whose associated flows should be removed
+	 * @entry [in]: The encap & encrypt entry to remove
 	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
 	 */
-	doca_error_t remove_encrypt_entry(psp_session_t *session);
+	doca_error_t remove_encrypt_entry(doca_flow_pipe_entry *entry);
 
 	/**
 	 * @brief Shows flow counters for pipes which have a fixed number of entries,
@@ -156,10 +158,9 @@ public:
 	 * @brief Shows flow counters for the given tunnel, if they have changed
 	 *        since the last invocation.
 	 *
-	 * @session_vips_pair [in]: the pair of VIPs which identify the session
 	 * @session [in/out]: the object which holds the flow entries
 	 */
-	void show_session_flow_count(const session_key session_vips_pair, psp_session_t &session);
+	void show_session_flow_count(psp_session_t &session);
 
 private:
 	/**
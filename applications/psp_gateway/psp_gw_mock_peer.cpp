@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server_builder.h>
+
+#include <doca_log.h>
+
+#include "psp_gw_mock_peer.h"
+
+DOCA_LOG_REGISTER(PSP_GW_MOCK_PEER);
+
+// Physical addresses reported by the mock, from the documentation ranges
+static const char *const MOCK_PEER_MAC = "02:00:5e:00:53:01";
+static const char *const MOCK_PEER_IPV4 = "192.0.2.1";
+static const char *const MOCK_PEER_IPV6 = "2001:db8::1";
+
+PSP_GatewayMockPeer::PSP_GatewayMockPeer(const psp_gw_app_config *config) : config(config)
+{
+}
+
+doca_error_t PSP_GatewayMockPeer::start(void)
+{
+	::grpc::ServerBuilder builder;
+	builder.AddListeningPort(config->mock_peer_addr, ::grpc::InsecureServerCredentials());
+	builder.RegisterService(this);
+	server = builder.BuildAndStart();
+	if (!server) {
+		DOCA_LOG_ERR("Failed to start the mock peer on %s", config->mock_peer_addr.c_str());
+		return DOCA_ERROR_INITIALIZATION;
+	}
+
+	DOCA_LOG_WARN("Mock peer listening on %s, answering after %u ms",
+		      config->mock_peer_addr.c_str(),
+		      config->mock_peer_delay_ms);
+	return DOCA_SUCCESS;
+}
+
+void PSP_GatewayMockPeer::stop(void)
+{
+	if (!server)
+		return;
+
+	server->Shutdown();
+	server.reset();
+	DOCA_LOG_INFO("Mock peer answered %lu requests for %lu tunnels", nb_requests.load(), nb_tunnels.load());
+}
+
+::grpc::Status PSP_GatewayMockPeer::RequestMultipleTunnelParams(::grpc::ServerContext *context,
+								 const ::psp_gateway::MultiTunnelRequest *request,
+								 ::psp_gateway::MultiTunnelResponse *response)
+{
+	(void)context;
+
+	if (request->psp_versions_accepted_size() == 0 ||
+	    !SUPPORTED_PSP_VERSIONS.count(request->psp_versions_accepted(0)))
+		return ::grpc::Status(::grpc::INVALID_ARGUMENT, "Unsupported PSP version");
+	uint32_t psp_ver = request->psp_versions_accepted(0);
+	uint32_t key_len_bytes = (psp_ver == 0 || psp_ver == 2) ? 16 : 32;
+
+	if (config->mock_peer_delay_ms)
+		std::this_thread::sleep_for(std::chrono::milliseconds(config->mock_peer_delay_ms));
+
+	response->set_request_id(request->request_id());
+	for (const auto &single_request : request->tunnels()) {
+		::psp_gateway::TunnelParameters *params = response->add_tunnels_params();
+		std::string key(key_len_bytes, '\0');
+
+		// The sync server runs the handlers on a pool of threads
+		static thread_local std::mt19937_64 key_gen(std::random_device{}());
+		for (uint32_t i = 0; i < key_len_bytes; i += sizeof(uint64_t)) {
+			uint64_t rand = key_gen();
+			key.replace(i, sizeof(rand), (const char *)&rand, sizeof(rand));
+		}
+
+		params->set_mac_addr(MOCK_PEER_MAC);
+		params->set_ip_addr(config->outer == DOCA_FLOW_L3_TYPE_IP4 ? MOCK_PEER_IPV4 : MOCK_PEER_IPV6);
+		params->set_psp_version(psp_ver);
+		params->set_spi(next_spi++);
+		params->set_encryption_key(key);
+		params->set_virt_cookie(0x778899aabbccddee);
+		// Echo the encap type of the reverse parameters, which the requester checks
+		if (single_request.has_reverse_params())
+			params->set_encap_type(single_request.reverse_params().encap_type());
+		else
+			params->set_encap_type(config->outer == DOCA_FLOW_L3_TYPE_IP4 ? 4 : 6);
+	}
+
+	nb_requests++;
+	nb_tunnels += request->tunnels_size();
+	return ::grpc::Status::OK;
+}
+
+::grpc::Status PSP_GatewayMockPeer::RequestKeyRotation(::grpc::ServerContext *context,
+							const ::psp_gateway::KeyRotationRequest *request,
+							::psp_gateway::KeyRotationResponse *response)
+{
+	(void)context;
+
+	response->set_request_id(request->request_id());
+	return ::grpc::Status::OK;
+}
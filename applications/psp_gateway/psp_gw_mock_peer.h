@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef _PSP_GW_MOCK_PEER_H_
+#define _PSP_GW_MOCK_PEER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <doca_error.h>
+
+#include <psp_gateway.pb.h>
+#include <psp_gateway.grpc.pb.h>
+#include <grpcpp/server.h>
+
+#include "psp_gw_config.h"
+
+/**
+ * @brief In-process stand-in for a remote PSP_Gateway service.
+ *
+ * Answers every tunnel request with well-formed parameters (a fixed
+ * documentation-range MAC/IP, increasing SPIs, pseudo-random keys) after
+ * an optional delay, without opening ACLs or creating any flows. Served
+ * on localhost, it lets the miss path (parking, per-peer coalescing,
+ * request deadlines) be exercised on a single host.
+ */
+class PSP_GatewayMockPeer : public psp_gateway::PSP_Gateway::Service {
+public:
+	/**
+	 * @brief Constructs the object. This operation cannot fail.
+	 *
+	 * @config [in]: the application configuration
+	 */
+	PSP_GatewayMockPeer(const psp_gw_app_config *config);
+
+	/**
+	 * @brief Starts serving on config->mock_peer_addr
+	 *
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t start(void);
+
+	/**
+	 * @brief Stops serving and logs the number of requests answered
+	 */
+	void stop(void);
+
+	/**
+	 * @brief Answers each requested tunnel with generated parameters,
+	 *        after waiting config->mock_peer_delay_ms.
+	 *
+	 * @context [in]: grpc context
+	 * @request [in]: request parameters
+	 * @response [out]: requested outputs
+	 * @return: Indicates success/failure of the request
+	 */
+	::grpc::Status RequestMultipleTunnelParams(::grpc::ServerContext *context,
+						   const ::psp_gateway::MultiTunnelRequest *request,
+						   ::psp_gateway::MultiTunnelResponse *response) override;
+
+	/**
+	 * @brief Acknowledges the key rotation; the mock holds no keys.
+	 *
+	 * @context [in]: grpc context
+	 * @request [in]: request parameters
+	 * @response [out]: requested outputs
+	 * @return: Indicates success/failure of the request
+	 */
+	::grpc::Status RequestKeyRotation(::grpc::ServerContext *context,
+					  const ::psp_gateway::KeyRotationRequest *request,
+					  ::psp_gateway::KeyRotationResponse *response) override;
+
+private:
+	const psp_gw_app_config *config{};
+
+	std::unique_ptr<::grpc::Server> server;
+
+	// SPI of the next generated tunnel
+	std::atomic<uint32_t> next_spi{1};
+
+	// Requests and tunnels answered, logged on stop()
+	std::atomic<uint64_t> nb_requests{};
+	std::atomic<uint64_t> nb_tunnels{};
+};
+
+#endif /* _PSP_GW_MOCK_PEER_H_ */
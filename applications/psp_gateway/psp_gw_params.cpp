@@ -340,6 +340,119 @@ static doca_error_t handle_max_tunnels_param(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/**
+ * @brief Configures how long a released crypto_id is quarantined before
+ * it may be assigned to a new tunnel.
+ *
+ * @param [in]: A pointer to the parameter
+ * @config [in/out]: A void pointer to the application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_crypto_id_grace_param(void *param, void *config)
+{
+	auto *app_config = (struct psp_gw_app_config *)config;
+	int *int_param = (int *)param;
+	if (*int_param < 0) {
+		DOCA_LOG_ERR("The crypto-id-grace-period must be non-negative, instead received: %d", *int_param);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	app_config->crypto_id_grace_ms = *int_param;
+	DOCA_LOG_INFO("Configured crypto-id-grace-period = %d ms", app_config->crypto_id_grace_ms);
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Configures the max number of miss packets parked per peer while
+ * a tunnel request to that peer is outstanding.
+ *
+ * @param [in]: A pointer to the parameter
+ * @config [in/out]: A void pointer to the application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_max_pending_pkts_param(void *param, void *config)
+{
+	auto *app_config = (struct psp_gw_app_config *)config;
+	int *int_param = (int *)param;
+	if (*int_param < 0) {
+		DOCA_LOG_ERR("The max-pending-pkts value must be non-negative, instead received: %d", *int_param);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	app_config->max_pending_pkts_per_peer = *int_param;
+	DOCA_LOG_INFO("Configured max-pending-pkts = %d", app_config->max_pending_pkts_per_peer);
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Configures the deadline of on-demand tunnel requests.
+ *
+ * @param [in]: A pointer to the parameter
+ * @config [in/out]: A void pointer to the application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_tunnel_request_timeout_param(void *param, void *config)
+{
+	auto *app_config = (struct psp_gw_app_config *)config;
+	int *int_param = (int *)param;
+	if (*int_param < 1) {
+		DOCA_LOG_ERR("The tunnel-request-timeout must be greater than zero, instead received: %d",
+			     *int_param);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	app_config->tunnel_request_timeout_ms = *int_param;
+	DOCA_LOG_INFO("Configured tunnel-request-timeout = %d ms", app_config->tunnel_request_timeout_ms);
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Configures the address of the in-process mock peer.
+ *
+ * @param [in]: A pointer to the parameter
+ * @config [in/out]: A void pointer to the application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_mock_peer_param(void *param, void *config)
+{
+	auto *app_config = (struct psp_gw_app_config *)config;
+	std::string addr = (char *)param;
+	if (addr.find(':') == std::string::npos) {
+		DOCA_LOG_ERR("The mock-peer address must include a port, instead received: %s", addr.c_str());
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	app_config->mock_peer_addr = addr;
+	DOCA_LOG_INFO("Configured mock-peer = %s", app_config->mock_peer_addr.c_str());
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Configures the time the mock peer waits before answering.
+ *
+ * @param [in]: A pointer to the parameter
+ * @config [in/out]: A void pointer to the application config struct
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t handle_mock_peer_delay_param(void *param, void *config)
+{
+	auto *app_config = (struct psp_gw_app_config *)config;
+	int *int_param = (int *)param;
+	if (*int_param < 0) {
+		DOCA_LOG_ERR("The mock-peer-delay must be non-negative, instead received: %d", *int_param);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	app_config->mock_peer_delay_ms = *int_param;
+	DOCA_LOG_INFO("Configured mock-peer-delay = %d ms", app_config->mock_peer_delay_ms);
+
+	return DOCA_SUCCESS;
+}
+
 /**
  * @brief Configures the PSP crypt-offset.
  *
@@ -498,7 +611,7 @@ static void get_supported_perf_types(std::string &supported_types)
 /**
  * @brief Indicates what performance printing should be enabled.
  *
- * @param [in]: A pointer to a string of performance type: key-gen, insertion
+ * @param [in]: A pointer to a string of performance type: key-gen, insertion, miss
  * @config [in/out]: A void pointer to the application config struct
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
@@ -1301,6 +1414,56 @@ static doca_error_t psp_gw_register_params(void)
 	if (result != DOCA_SUCCESS)
 		return result;
 
+	result = psp_gw_register_single_param(nullptr,
+					      "crypto-id-grace-period",
+					      "Milliseconds before the crypto ID of a replaced tunnel may be reused",
+					      handle_crypto_id_grace_param,
+					      DOCA_ARGP_TYPE_INT,
+					      false,
+					      false);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = psp_gw_register_single_param(nullptr,
+					      "max-pending-pkts",
+					      "Max miss packets parked per peer while its tunnels are negotiated",
+					      handle_max_pending_pkts_param,
+					      DOCA_ARGP_TYPE_INT,
+					      false,
+					      false);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = psp_gw_register_single_param(nullptr,
+					      "tunnel-request-timeout",
+					      "Deadline in milliseconds of an on-demand tunnel request",
+					      handle_tunnel_request_timeout_param,
+					      DOCA_ARGP_TYPE_INT,
+					      false,
+					      false);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = psp_gw_register_single_param(nullptr,
+					      "mock-peer",
+					      "Serve a mock peer on this ip:port and send all tunnel requests to it (testing)",
+					      handle_mock_peer_param,
+					      DOCA_ARGP_TYPE_STRING,
+					      false,
+					      false);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	result = psp_gw_register_single_param(nullptr,
+					      "mock-peer-delay",
+					      "Milliseconds the mock peer waits before answering a tunnel request",
+					      handle_mock_peer_delay_param,
+					      DOCA_ARGP_TYPE_INT,
+					      false,
+					      false);
+	if (result != DOCA_SUCCESS)
+		return result;
+
 	result = psp_gw_register_single_param("o",
 					      "crypt-offset",
 					      "Specify the PSP crypt offset",
@@ -1353,7 +1516,7 @@ static doca_error_t psp_gw_register_params(void)
 
 	result = psp_gw_register_single_param(nullptr,
 					      "perf-print",
-					      "Enable printing performance metrics (key-gen, insertion, all)",
+					      "Enable printing performance metrics (key-gen, insertion, miss, all)",
 					      handle_perf_print_param,
 					      DOCA_ARGP_TYPE_STRING,
 					      false,
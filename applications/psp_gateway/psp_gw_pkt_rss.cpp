@@ -154,6 +154,9 @@ int lcore_pkt_proc_func(void *lcore_args)
 		uint16_t port_id = params->pf_dev->port_id;
 		uint64_t t_start = rte_rdtsc();
 
+		// Release or drop any packets parked waiting for a tunnel
+		params->psp_svc->poll_tunnel_requests();
+
 		uint16_t nb_rx_packets = rte_eth_rx_burst(port_id, queue_id, rx_packets, MAX_RX_BURST_SIZE);
 
 		if (!nb_rx_packets)
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+
+#include <rte_hash_crc.h>
+#include <rte_lcore.h>
+
+#include <doca_log.h>
+
+#include "psp_gw_session_table.h"
+#include "psp_gw_utils.h"
+
+DOCA_LOG_REGISTER(PSP_SESSION_TABLE);
+
+/**
+ * @brief Creates an rte_hash keyed by session_key
+ *
+ * @name [in]: unique name of the table
+ * @entries [in]: the number of keys the table must be able to hold
+ * @return: the table, or nullptr on failure
+ */
+static struct rte_hash *create_session_key_table(const std::string &name, uint32_t entries)
+{
+	struct rte_hash_parameters table_params = {0};
+
+	table_params.name = name.c_str();
+	table_params.entries = entries;
+	table_params.key_len = sizeof(session_key);
+	table_params.hash_func = rte_hash_crc;
+	table_params.hash_func_init_val = 0;
+	table_params.socket_id = rte_socket_id();
+	/* Guarantee that all 'entries' keys fit, regardless of cuckoo collisions */
+	table_params.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+	return rte_hash_create(&table_params);
+}
+
+PSP_SessionTable::~PSP_SessionTable()
+{
+	if (table)
+		rte_hash_free(table);
+}
+
+doca_error_t PSP_SessionTable::init(const std::string &name, uint32_t capacity)
+{
+	table = create_session_key_table(name, capacity);
+	if (table == nullptr) {
+		DOCA_LOG_ERR("Failed to create session table %s with %u entries", name.c_str(), capacity);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	slots.resize(capacity);
+	return DOCA_SUCCESS;
+}
+
+psp_session_t *PSP_SessionTable::find(const session_key &key) const
+{
+	int32_t pos = rte_hash_lookup(table, &key);
+	if (pos < 0)
+		return nullptr;
+	return slots[pos].get();
+}
+
+psp_session_t *PSP_SessionTable::find_or_create(const session_key &key)
+{
+	int32_t pos = rte_hash_add_key(table, &key); // returns the existing position if the key is present
+	if (pos < 0)
+		return nullptr;
+	if ((uint32_t)pos >= slots.size()) {
+		// rte_hash positions stay below 'capacity' unless the table was created with per-lcore key caches
+		DOCA_LOG_ERR("Session table returned position %d beyond its capacity %zu", pos, slots.size());
+		rte_hash_del_key(table, &key);
+		return nullptr;
+	}
+	if (!slots[pos])
+		slots[pos] = std::make_unique<psp_session_t>();
+	return slots[pos].get();
+}
+
+void PSP_SessionTable::erase(const session_key &key)
+{
+	int32_t pos = rte_hash_del_key(table, &key);
+	if (pos >= 0)
+		slots[pos].reset();
+}
+
+uint32_t PSP_SessionTable::size(void) const
+{
+	int32_t count = rte_hash_count(table);
+	return count < 0 ? 0 : count;
+}
+
+PSP_VipPeerIndex::~PSP_VipPeerIndex()
+{
+	if (table)
+		rte_hash_free(table);
+}
+
+doca_error_t PSP_VipPeerIndex::init(const std::string &name, std::vector<psp_gw_peer> &peers)
+{
+	uint32_t nb_vip_pairs = 0;
+	for (const auto &peer : peers)
+		nb_vip_pairs += peer.vip_pairs.size();
+
+	table = create_session_key_table(name, std::max(nb_vip_pairs, 8u));
+	if (table == nullptr) {
+		DOCA_LOG_ERR("Failed to create vip-peer index %s with %u entries", name.c_str(), nb_vip_pairs);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (auto &peer : peers) {
+		for (const auto &vip_pair : peer.vip_pairs) {
+			session_key key = make_session_key(vip_pair.src_vip, vip_pair.dst_vip);
+			int ret = rte_hash_add_key_data(table, &key, &peer);
+			if (ret < 0) {
+				DOCA_LOG_ERR("Failed to index vip pair (%s -> %s) of peer %s",
+					     ip_to_string(vip_pair.src_vip).c_str(),
+					     ip_to_string(vip_pair.dst_vip).c_str(),
+					     peer.svc_addr.c_str());
+				return DOCA_ERROR_DRIVER;
+			}
+		}
+	}
+
+	DOCA_LOG_DBG("Indexed %u vip pairs across %zu peers", nb_vip_pairs, peers.size());
+	return DOCA_SUCCESS;
+}
+
+psp_gw_peer *PSP_VipPeerIndex::lookup(const session_key &key) const
+{
+	void *peer = nullptr;
+	if (rte_hash_lookup_data(table, &key, &peer) < 0)
+		return nullptr;
+	return (psp_gw_peer *)peer;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef _PSP_GW_SESSION_TABLE_H_
+#define _PSP_GW_SESSION_TABLE_H_
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+
+#include <doca_error.h>
+
+#include "psp_gw_config.h"
+#include "psp_gw_flows.h"
+
+/**
+ * @brief Hashes a session key for use in std::unordered_map
+ */
+struct session_key_hash {
+	size_t operator()(const session_key &key) const
+	{
+		return rte_hash_crc(&key, sizeof(key), 0);
+	}
+};
+
+/**
+ * @brief Compares session keys for use in std::unordered_map
+ */
+struct session_key_equal {
+	bool operator()(const session_key &lhs, const session_key &rhs) const
+	{
+		return memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+	}
+};
+
+/**
+ * @brief Hash table of sessions, keyed by the binary (src vip, dst vip) pair.
+ *
+ * Lookups hash the 32-byte key directly (rte_hash, CRC32) rather than
+ * comparing formatted address strings. Sessions are heap allocated and
+ * never move, so pointers handed to the flow code remain valid until
+ * the session is erased.
+ */
+class PSP_SessionTable {
+public:
+	PSP_SessionTable() = default;
+
+	~PSP_SessionTable();
+
+	PSP_SessionTable(const PSP_SessionTable &) = delete;
+
+	PSP_SessionTable &operator=(const PSP_SessionTable &) = delete;
+
+	/**
+	 * @brief Allocates the hash table
+	 *
+	 * @name [in]: unique name of the underlying rte_hash
+	 * @capacity [in]: maximum number of sessions
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t init(const std::string &name, uint32_t capacity);
+
+	/**
+	 * @brief Finds an existing session
+	 *
+	 * @key [in]: the session key
+	 * @return: the session, or nullptr if none exists
+	 */
+	psp_session_t *find(const session_key &key) const;
+
+	/**
+	 * @brief Finds an existing session, or creates a zero-initialized one
+	 *
+	 * @key [in]: the session key
+	 * @return: the session, or nullptr if the table is full or the key cannot be stored
+	 */
+	psp_session_t *find_or_create(const session_key &key);
+
+	/**
+	 * @brief Removes a session, if it exists
+	 *
+	 * @key [in]: the session key
+	 */
+	void erase(const session_key &key);
+
+	/**
+	 * @brief Returns the number of sessions in the table
+	 */
+	uint32_t size(void) const;
+
+	/**
+	 * @brief Invokes fn(session) for every session in the table
+	 *
+	 * @fn [in]: the function to invoke
+	 */
+	template <typename Fn>
+	void for_each(Fn &&fn)
+	{
+		const void *key;
+		void *data;
+		uint32_t next = 0;
+		int32_t pos;
+		while ((pos = rte_hash_iterate(table, &key, &data, &next)) >= 0)
+			fn(*slots[pos]);
+	}
+
+private:
+	struct rte_hash *table{};
+
+	std::vector<std::unique_ptr<psp_session_t>> slots; /* indexed by rte_hash key position */
+};
+
+/**
+ * @brief Maps each configured (local vip, remote vip) pair to the peer
+ *        which owns it.
+ */
+class PSP_VipPeerIndex {
+public:
+	PSP_VipPeerIndex() = default;
+
+	~PSP_VipPeerIndex();
+
+	PSP_VipPeerIndex(const PSP_VipPeerIndex &) = delete;
+
+	PSP_VipPeerIndex &operator=(const PSP_VipPeerIndex &) = delete;
+
+	/**
+	 * @brief Builds the index. The peers must not be moved or
+	 *        modified while the index is in use.
+	 *
+	 * @name [in]: unique name of the underlying rte_hash
+	 * @peers [in]: the configured peers
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t init(const std::string &name, std::vector<psp_gw_peer> &peers);
+
+	/**
+	 * @brief Finds the peer which owns the given vip pair
+	 *
+	 * @key [in]: the (local vip, remote vip) key
+	 * @return: the peer, or nullptr if the pair is not configured
+	 */
+	psp_gw_peer *lookup(const session_key &key) const;
+
+private:
+	struct rte_hash *table{};
+};
+
+#endif /* _PSP_GW_SESSION_TABLE_H_ */
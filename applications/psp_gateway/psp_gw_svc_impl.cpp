@@ -25,6 +25,8 @@
 
 #include <arpa/inet.h>
 
+#include <chrono>
+
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 
@@ -47,12 +49,22 @@ PSP_GatewayImpl::PSP_GatewayImpl(psp_gw_app_config *config, PSP_GatewayFlows *ps
 {
 }
 
+doca_error_t PSP_GatewayImpl::init(void)
+{
+	doca_error_t result = sessions.init("psp_sessions", PSP_MAX_SESSIONS);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	// crypto_id 0 is not used; the PSP shared resources are sized max_tunnels + 1
+	crypto_ids.init(1, config->max_tunnels, config->crypto_id_grace_ms);
+
+	return vip_peer_index.init("psp_vip_peers", config->net_config.peers);
+}
+
 doca_error_t PSP_GatewayImpl::handle_miss_packet(struct rte_mbuf *packet)
 {
-	std::string dst_vip;
-	std::string src_vip;
-	struct doca_flow_ip_addr dst_vip_addr;
-	struct doca_flow_ip_addr src_vip_addr;
+	struct doca_flow_ip_addr dst_vip_addr = {};
+	struct doca_flow_ip_addr src_vip_addr = {};
 	if (config->create_tunnels_at_startup)
 		return DOCA_SUCCESS; // no action; tunnels to be created by the main loop
 
@@ -64,8 +76,6 @@ doca_error_t PSP_GatewayImpl::handle_miss_packet(struct rte_mbuf *packet)
 	if (config->inner == DOCA_FLOW_L3_TYPE_IP4) {
 		const auto *ipv4_hdr =
 			rte_pktmbuf_mtod_offset(packet, struct rte_ipv4_hdr *, sizeof(struct rte_ether_hdr));
-		dst_vip = ipv4_to_string(ipv4_hdr->dst_addr);
-		src_vip = ipv4_to_string(ipv4_hdr->src_addr);
 		dst_vip_addr.type = DOCA_FLOW_L3_TYPE_IP4;
 		src_vip_addr.type = DOCA_FLOW_L3_TYPE_IP4;
 		dst_vip_addr.ipv4_addr = ipv4_hdr->dst_addr;
@@ -73,8 +83,6 @@ doca_error_t PSP_GatewayImpl::handle_miss_packet(struct rte_mbuf *packet)
 	} else {
 		const auto *ipv6_hdr =
 			rte_pktmbuf_mtod_offset(packet, struct rte_ipv6_hdr *, sizeof(struct rte_ether_hdr));
-		dst_vip = ipv6_to_string((uint32_t *)ipv6_hdr->dst_addr);
-		src_vip = ipv6_to_string((uint32_t *)ipv6_hdr->src_addr);
 		dst_vip_addr.type = DOCA_FLOW_L3_TYPE_IP6;
 		src_vip_addr.type = DOCA_FLOW_L3_TYPE_IP6;
 		memcpy(dst_vip_addr.ipv6_addr, ipv6_hdr->dst_addr, IPV6_ADDR_LEN);
@@ -82,54 +90,247 @@ doca_error_t PSP_GatewayImpl::handle_miss_packet(struct rte_mbuf *packet)
 	}
 
 	// Create the new tunnel instance, if one does not already exist
-	if (sessions.count({src_vip, dst_vip}) == 0) {
-		// Determine the peer which owns the virtual destination
-		struct ip_pair vip_pair = {src_vip_addr, dst_vip_addr};
-		auto *peer = lookup_vip_pair(vip_pair);
-		if (!peer) {
-			DOCA_LOG_WARN("Virtual Destination IP Addr not found: %s", dst_vip.c_str());
-			return DOCA_ERROR_NOT_FOUND;
+	uint64_t lookup_start_time = rte_get_tsc_cycles();
+	session_key key = make_session_key(src_vip_addr, dst_vip_addr);
+	bool session_exists = sessions.find(key) != nullptr;
+	psp_gw_peer *peer = session_exists ? nullptr : lookup_vip_pair(key);
+	uint64_t lookup_end_time = rte_get_tsc_cycles();
+
+	if (config->print_perf_flags & PSP_PERF_MISS_PRINT) {
+		double lookup_time_ns = 1e9 * (lookup_end_time - lookup_start_time) / (double)rte_get_tsc_hz();
+		DOCA_LOG_INFO("Miss path lookup took %f ns with %u sessions", lookup_time_ns, sessions.size());
+	}
+
+	if (session_exists) {
+		// The tunnel already exists; we can now resubmit the packet
+		// and it will be encrypted and sent to the right port.
+		if (!reinject_packet(packet, pf->port_id)) {
+			DOCA_LOG_ERR("Failed to resubmit packet from vnet addr %s to %s on port %d",
+				     ip_to_string(src_vip_addr).c_str(),
+				     ip_to_string(dst_vip_addr).c_str(),
+				     pf->port_id);
+			return DOCA_ERROR_FULL;
 		}
+		return DOCA_SUCCESS;
+	}
 
-		doca_error_t result = request_tunnel_to_host(peer, &vip_pair, true, false, true);
-		if (result != DOCA_SUCCESS) {
-			return result;
-		}
+	// Determine the peer which owns the virtual destination
+	if (!peer) {
+		DOCA_LOG_WARN("Virtual Destination IP Addr not found: %s", ip_to_string(dst_vip_addr).c_str());
+		return DOCA_ERROR_NOT_FOUND;
 	}
 
-	// A new tunnel was created; we can now resubmit the packet
-	// and it will be encrypted and sent to the right port.
-	if (!reinject_packet(packet, pf->port_id)) {
-		DOCA_LOG_ERR("Failed to resubmit packet from vnet addr %s to %s on port %d",
-			     src_vip.c_str(),
-			     dst_vip.c_str(),
-			     pf->port_id);
-		return DOCA_ERROR_FULL;
+	// Park the packet until the tunnel has been negotiated; the lcore
+	// keeps forwarding while the request is in flight.
+	struct ip_pair vip_pair = {src_vip_addr, dst_vip_addr};
+	std::vector<struct rte_mbuf *> dropped;
+	doca_error_t result;
+	{
+		std::lock_guard<std::mutex> lock(pending_mutex);
+		result = park_miss_packet(peer, vip_pair, key, packet, dropped);
 	}
+	rte_pktmbuf_free_bulk(dropped.data(), dropped.size());
+	return result;
+}
+
+doca_error_t PSP_GatewayImpl::park_miss_packet(psp_gw_peer *peer,
+					       const ip_pair &vip_pair,
+					       const session_key &key,
+					       struct rte_mbuf *packet,
+					       std::vector<struct rte_mbuf *> &dropped)
+{
+	pending_peer &state = pending_peers[peer];
+	auto pending_iter = pending_tunnels.find(key);
+	if (pending_iter == pending_tunnels.end()) {
+		// First miss to this destination; it joins the peer's next request
+		pending_iter = pending_tunnels.emplace(key, pending_tunnel{peer, vip_pair, {}}).first;
+		state.queued_keys.push_back(key);
+	}
+
+	doca_error_t result = DOCA_SUCCESS;
+	if (state.nb_parked_pkts < config->max_pending_pkts_per_peer) {
+		// The RSS loop frees each burst after handling it; hold a reference
+		// so the packet survives until the tunnel request completes.
+		rte_mbuf_refcnt_update(packet, 1);
+		pending_iter->second.packets.push_back(packet);
+		state.nb_parked_pkts++;
+	} else {
+		DOCA_LOG_DBG("Pending queue for peer %s is full; dropping packet to %s",
+			     peer->svc_addr.c_str(),
+			     ip_to_string(vip_pair.dst_vip).c_str());
+		result = DOCA_ERROR_FULL;
+	}
+
+	// Otherwise issued by poll_tunnel_requests() when the current request completes
+	if (!state.in_flight && !state.queued_keys.empty()) {
+		doca_error_t rpc_result = start_tunnel_rpc(peer, state, dropped);
+		if (rpc_result != DOCA_SUCCESS)
+			return rpc_result;
+	}
+
+	return result;
+}
+
+doca_error_t PSP_GatewayImpl::start_tunnel_rpc(psp_gw_peer *peer,
+					       pending_peer &state,
+					       std::vector<struct rte_mbuf *> &dropped)
+{
+	auto rpc = std::make_unique<tunnel_rpc>();
+	rpc->peer = peer;
+	rpc->keys.swap(state.queued_keys);
+	for (const session_key &key : rpc->keys)
+		rpc->vip_pairs.push_back(pending_tunnels.at(key).vip_pair);
+
+	doca_error_t result = build_tunnel_request(peer, rpc->vip_pairs, true, rpc->request);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to build tunnel request for peer %s: %s",
+			     peer->svc_addr.c_str(),
+			     doca_error_get_descr(result));
+		take_pending_packets(rpc->keys, state, dropped);
+		return result;
+	}
+
+	rpc->context.set_deadline(std::chrono::system_clock::now() +
+				  std::chrono::milliseconds(config->tunnel_request_timeout_ms));
+	auto *stub = get_stub(peer->svc_addr);
+	rpc->reader = stub->AsyncRequestMultipleTunnelParams(&rpc->context, rpc->request, &tunnel_cq);
+	rpc->reader->Finish(&rpc->response, &rpc->status, rpc.get());
+
+	DOCA_LOG_DBG("Requested %d tunnels from peer %s, request %ld",
+		     rpc->request.tunnels_size(),
+		     peer->svc_addr.c_str(),
+		     rpc->request.request_id());
+
+	state.in_flight = rpc.release();
+	nb_tunnel_rpcs_in_flight++;
 	return DOCA_SUCCESS;
 }
 
+void PSP_GatewayImpl::take_pending_packets(const std::vector<session_key> &keys,
+					   pending_peer &state,
+					   std::vector<struct rte_mbuf *> &packets)
+{
+	for (const session_key &key : keys) {
+		auto pending_iter = pending_tunnels.find(key);
+		if (pending_iter == pending_tunnels.end())
+			continue;
+		auto &parked = pending_iter->second.packets;
+		packets.insert(packets.end(), parked.begin(), parked.end());
+		state.nb_parked_pkts -= parked.size();
+		pending_tunnels.erase(pending_iter);
+	}
+}
+
+void PSP_GatewayImpl::poll_tunnel_requests(void)
+{
+	void *tag;
+	bool ok;
+
+	if (nb_tunnel_rpcs_in_flight.load(std::memory_order_relaxed) == 0)
+		return;
+
+	while (tunnel_cq.AsyncNext(&tag, &ok, gpr_time_0(GPR_CLOCK_MONOTONIC)) == ::grpc::CompletionQueue::GOT_EVENT) {
+		std::unique_ptr<tunnel_rpc> rpc(static_cast<tunnel_rpc *>(tag));
+		psp_gw_peer *peer = rpc->peer;
+		nb_tunnel_rpcs_in_flight--;
+
+		if (!ok)
+			rpc->status = ::grpc::Status(::grpc::CANCELLED, "Completion queue reported failure");
+
+		doca_error_t result = process_tunnel_response(peer->svc_addr,
+							      rpc->vip_pairs,
+							      rpc->request,
+							      rpc->response,
+							      rpc->status,
+							      true,
+							      false);
+
+		std::vector<struct rte_mbuf *> packets;
+		std::vector<struct rte_mbuf *> dropped;
+		{
+			std::lock_guard<std::mutex> lock(pending_mutex);
+			pending_peer &state = pending_peers[peer];
+			state.in_flight = nullptr;
+			take_pending_packets(rpc->keys, state, packets);
+			if (!state.queued_keys.empty())
+				start_tunnel_rpc(peer, state, dropped);
+		}
+
+		if (result == DOCA_SUCCESS) {
+			// The parked packets hold the reference taken when parking,
+			// which the Tx queue consumes on success.
+			for (struct rte_mbuf *packet : packets) {
+				if (!reinject_packet(packet, pf->port_id)) {
+					DOCA_LOG_ERR("Failed to resubmit parked packet to peer %s on port %d",
+						     peer->svc_addr.c_str(),
+						     pf->port_id);
+					rte_pktmbuf_free(packet);
+				}
+			}
+		} else {
+			DOCA_LOG_WARN("Dropping %zu packets parked for peer %s",
+				      packets.size(),
+				      peer->svc_addr.c_str());
+			dropped.insert(dropped.end(), packets.begin(), packets.end());
+		}
+		rte_pktmbuf_free_bulk(dropped.data(), dropped.size());
+	}
+}
+
+PSP_GatewayImpl::~PSP_GatewayImpl()
+{
+	void *tag;
+	bool ok;
+
+	for (auto &peer_state : pending_peers) {
+		if (peer_state.second.in_flight)
+			peer_state.second.in_flight->context.TryCancel();
+	}
+
+	tunnel_cq.Shutdown();
+	while (tunnel_cq.Next(&tag, &ok))
+		delete static_cast<tunnel_rpc *>(tag);
+
+	for (auto &pending : pending_tunnels)
+		rte_pktmbuf_free_bulk(pending.second.packets.data(), pending.second.packets.size());
+}
+
 doca_error_t PSP_GatewayImpl::request_tunnel_to_host(struct psp_gw_peer *peer,
-						     struct ip_pair *vip_pair,
 						     bool supply_reverse_params,
-						     bool suppress_failure_msg,
-						     bool has_vip_pair)
+						     bool suppress_failure_msg)
+{
+	std::vector<ip_pair> vip_pairs = peer->vip_pairs;
+	::psp_gateway::MultiTunnelRequest request;
+
+	doca_error_t result = build_tunnel_request(peer, vip_pairs, supply_reverse_params, request);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	::grpc::ClientContext context;
+	::psp_gateway::MultiTunnelResponse response;
+	::grpc::Status status = get_stub(peer->svc_addr)->RequestMultipleTunnelParams(&context, request, &response);
+
+	return process_tunnel_response(peer->svc_addr,
+				       vip_pairs,
+				       request,
+				       response,
+				       status,
+				       supply_reverse_params,
+				       suppress_failure_msg);
+}
+
+doca_error_t PSP_GatewayImpl::build_tunnel_request(struct psp_gw_peer *peer,
+						   std::vector<ip_pair> &vip_pairs,
+						   bool supply_reverse_params,
+						   ::psp_gateway::MultiTunnelRequest &request)
 {
 	doca_error_t result;
 	uint32_t key_len_bits = psp_version_to_key_length_bits(config->net_config.default_psp_proto_ver);
 	uint32_t key_len_words = key_len_bits / 32;
-	uint32_t nb_pairs = has_vip_pair ? 1 : peer->vip_pairs.size();
+	uint32_t nb_pairs = vip_pairs.size();
 	std::vector<uint32_t> keys(nb_pairs * key_len_words);
 	std::vector<uint32_t> spis(nb_pairs);
 
-	const std::string &peer_svc_pip = peer->svc_addr;
-	int spi_key_idx = 0;
-	int vip_pair_id = -1;
-
-	auto *stub = get_stub(peer_svc_pip);
-
-	::grpc::ClientContext context;
-	::psp_gateway::MultiTunnelRequest request;
 	request.set_request_id(++next_request_id);
 	request.add_psp_versions_accepted(config->net_config.default_psp_proto_ver);
 
@@ -137,24 +338,16 @@ doca_error_t PSP_GatewayImpl::request_tunnel_to_host(struct psp_gw_peer *peer,
 		result = generate_keys_spis(key_len_bits, nb_pairs, keys.data(), spis.data());
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to generate SPI/Key's for peer %s: %s",
-				     peer_svc_pip.c_str(),
+				     peer->svc_addr.c_str(),
 				     doca_error_get_descr(result));
 			return result;
 		}
 	}
 
-	for (size_t vip_pair_idx = 0; vip_pair_idx < peer->vip_pairs.size(); vip_pair_idx++) {
-		doca_flow_ip_addr *peer_virt_ip = &peer->vip_pairs[vip_pair_idx].dst_vip;
-		doca_flow_ip_addr *local_virt_ip = &peer->vip_pairs[vip_pair_idx].src_vip;
+	for (uint32_t spi_key_idx = 0; spi_key_idx < nb_pairs; spi_key_idx++) {
+		doca_flow_ip_addr *peer_virt_ip = &vip_pairs[spi_key_idx].dst_vip;
+		doca_flow_ip_addr *local_virt_ip = &vip_pairs[spi_key_idx].src_vip;
 
-		if (has_vip_pair) {
-			if (!is_ip_equal(peer_virt_ip, &vip_pair->dst_vip) ||
-			    !is_ip_equal(local_virt_ip, &vip_pair->src_vip))
-				continue;
-			else
-				vip_pair_id = vip_pair_idx;
-		} else
-			spi_key_idx = vip_pair_idx;
 		std::string local_vip;
 		std::string peer_vip;
 		::psp_gateway::SingleTunnelRequest *single_request = request.add_tunnels();
@@ -179,7 +372,15 @@ doca_error_t PSP_GatewayImpl::request_tunnel_to_host(struct psp_gw_peer *peer,
 				  key_len_bits / 8);
 
 			if (!config->disable_ingress_acl) {
-				auto &session = sessions[{local_vip, peer_vip}];
+				session_key key = make_session_key(*local_virt_ip, *peer_virt_ip);
+				auto *session_ptr = sessions.find_or_create(key);
+				if (!session_ptr) {
+					DOCA_LOG_ERR("Session table full; cannot open ACL (%s <- %s)",
+						     local_vip.c_str(),
+						     peer_vip.c_str());
+					return DOCA_ERROR_FULL;
+				}
+				auto &session = *session_ptr;
 				session.spi_ingress = single_request->reverse_params().spi();
 				copy_ip_addr(*local_virt_ip, session.src_vip);
 				copy_ip_addr(*peer_virt_ip, session.dst_vip);
@@ -203,23 +404,36 @@ doca_error_t PSP_GatewayImpl::request_tunnel_to_host(struct psp_gw_peer *peer,
 		}
 	}
 
-	if (has_vip_pair && vip_pair_id == -1) {
-		DOCA_LOG_ERR("Virtual IPs not found");
-		return DOCA_ERROR_NOT_FOUND;
-	}
+	return DOCA_SUCCESS;
+}
 
-	::psp_gateway::MultiTunnelResponse response;
-	::grpc::Status status = stub->RequestMultipleTunnelParams(&context, request, &response);
+doca_error_t PSP_GatewayImpl::process_tunnel_response(const std::string &peer_svc_addr,
+						      std::vector<ip_pair> &vip_pairs,
+						      const ::psp_gateway::MultiTunnelRequest &request,
+						      const ::psp_gateway::MultiTunnelResponse &response,
+						      const ::grpc::Status &status,
+						      bool supply_reverse_params,
+						      bool suppress_failure_msg)
+{
+	doca_error_t result;
 
 	if (!status.ok() || response.tunnels_params_size() != request.tunnels_size()) {
 		if (!suppress_failure_msg) {
 			DOCA_LOG_ERR("Request for new SPI/Key's to peer %s failed: %s",
-				     peer_svc_pip.c_str(),
+				     peer_svc_addr.c_str(),
 				     status.error_message().c_str());
 		}
 		return DOCA_ERROR_IO_FAILED;
 	}
 
+	PSP_CryptoIdBatch batch_crypto_ids(crypto_ids);
+	if (batch_crypto_ids.alloc(response.tunnels_params_size()) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Exhausted available crypto_ids; cannot complete %d new tunnels to peer %s",
+			     response.tunnels_params_size(),
+			     peer_svc_addr.c_str());
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
 	std::vector<psp_session_and_key_t> new_session_keys;
 	for (int i = 0; i < response.tunnels_params_size(); i++) {
 		if (supply_reverse_params) {
@@ -227,29 +441,33 @@ doca_error_t PSP_GatewayImpl::request_tunnel_to_host(struct psp_gw_peer *peer,
 			    request.tunnels(i).reverse_params().encap_type()) {
 				if (!suppress_failure_msg)
 					DOCA_LOG_ERR("Encap type is different between request and response");
+				// The sessions prepared so far may hold retired entries of a re-key
+				rollback_sessions(new_session_keys, 0);
 				return DOCA_ERROR_INVALID_VALUE;
 			}
 		}
-		if (!has_vip_pair)
-			vip_pair_id = i;
-		result = prepare_session(peer_svc_pip,
-					 peer->vip_pairs[vip_pair_id],
+		uint32_t crypto_id = batch_crypto_ids.take();
+		result = prepare_session(peer_svc_addr,
+					 vip_pairs[i],
 					 response.tunnels_params(i),
+					 crypto_id,
 					 new_session_keys);
 		if (result != DOCA_SUCCESS) {
+			batch_crypto_ids.put_back(crypto_id);
+			rollback_sessions(new_session_keys, 0);
 			DOCA_LOG_ERR("Failed to prepare session for peer %s, request %ld: (%s -> %s): %s",
-				     peer_svc_pip.c_str(),
+				     peer_svc_addr.c_str(),
 				     request.request_id(),
-				     ip_to_string(peer->vip_pairs[i].src_vip).c_str(),
-				     ip_to_string(peer->vip_pairs[i].dst_vip).c_str(),
+				     ip_to_string(vip_pairs[i].src_vip).c_str(),
+				     ip_to_string(vip_pairs[i].dst_vip).c_str(),
 				     doca_error_get_descr(result));
 			return result;
 		}
 	}
-	result = add_encrypt_entries(new_session_keys, peer_svc_pip);
+	result = add_encrypt_entries(new_session_keys, peer_svc_addr);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to add encrypt entries for peer %s: %s",
-			     peer_svc_pip.c_str(),
+			     peer_svc_addr.c_str(),
 			     doca_error_get_descr(result));
 		return result;
 	}
@@ -264,14 +482,33 @@ doca_error_t PSP_GatewayImpl::add_encrypt_entries(std::vector<psp_session_and_ke
 
 	uint64_t start_time = rte_get_tsc_cycles();
 	for (int i = 0; i < (int)new_sessions_keys.size(); i++) {
-		doca_error_t result =
-			psp_flows->add_encrypt_entry(new_sessions_keys[i].first, new_sessions_keys[i].second);
+		psp_session_t *session = new_sessions_keys[i].first;
+		doca_error_t result = psp_flows->add_encrypt_entry(session, new_sessions_keys[i].second);
 		if (result != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to add encrypt entry for %s: %s",
 				     peer_svc_addr.c_str(),
 				     doca_error_get_descr(result));
+			rollback_sessions(new_sessions_keys, i);
 			return result;
 		}
+
+		if (!session->retired_encrypt_entry)
+			continue;
+
+		// Make before break: the new SA is installed, remove the previous one.
+		// Its crypto_id is only recycled after the grace period, so packets
+		// already scheduled against it are still encrypted with the old key.
+		result = psp_flows->remove_encrypt_entry(session->retired_encrypt_entry);
+		if (result != DOCA_SUCCESS) {
+			// The old entry may still reference its crypto_id; never recycle it
+			DOCA_LOG_ERR("Failed to remove previous encrypt entry (%s -> %s): %s",
+				     ip_to_string(session->src_vip).c_str(),
+				     ip_to_string(session->dst_vip).c_str(),
+				     doca_error_get_descr(result));
+		} else {
+			crypto_ids.release(session->retired_crypto_id);
+		}
+		session->retired_encrypt_entry = nullptr;
 	}
 	uint64_t end_time = rte_get_tsc_cycles();
 	double total_time = (end_time - start_time) / (double)rte_get_tsc_hz();
@@ -285,9 +522,25 @@ doca_error_t PSP_GatewayImpl::add_encrypt_entries(std::vector<psp_session_and_ke
 	return DOCA_SUCCESS;
 }
 
+void PSP_GatewayImpl::rollback_sessions(std::vector<psp_session_and_key_t> &sessions_keys, size_t first)
+{
+	for (size_t i = first; i < sessions_keys.size(); i++) {
+		psp_session_t *session = sessions_keys[i].first;
+
+		// The new key may already be programmed at the crypto_id
+		crypto_ids.release(session->crypto_id);
+		session->crypto_id = session->retired_crypto_id;
+		session->encap_encrypt_entry = session->retired_encrypt_entry;
+		session->retired_encrypt_entry = nullptr;
+		session->retired_crypto_id = 0;
+	}
+	sessions_keys.resize(first);
+}
+
 doca_error_t PSP_GatewayImpl::prepare_session(std::string peer_svc_addr,
 					      struct ip_pair &vip_pair,
 					      const psp_gateway::TunnelParameters &params,
+					      uint32_t crypto_id,
 					      std::vector<psp_session_and_key_t> &sessions_keys_prepared)
 {
 	std::string peer_vip, local_vip;
@@ -309,33 +562,47 @@ doca_error_t PSP_GatewayImpl::prepare_session(std::string peer_svc_addr,
 		return DOCA_ERROR_IO_FAILED;
 	}
 
-	uint32_t crypto_id = next_crypto_id();
-	if (crypto_id == UINT32_MAX) {
-		DOCA_LOG_ERR("Exhausted available crypto_ids; cannot complete new tunnel");
-		return DOCA_ERROR_NO_MEMORY;
+	rte_ether_addr dst_mac;
+	if (rte_ether_unformat_addr(params.mac_addr().c_str(), &dst_mac)) {
+		DOCA_LOG_ERR("Failed to convert mac addr: %s", params.mac_addr().c_str());
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	struct doca_flow_ip_addr dst_pip = {};
+	doca_flow_l3_type enforce_l3_type = params.encap_type() == 4 ? DOCA_FLOW_L3_TYPE_IP4 : DOCA_FLOW_L3_TYPE_IP6;
+	if (parse_ip_addr(params.ip_addr(), enforce_l3_type, &dst_pip) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse dst_pip %s", params.ip_addr().c_str());
+		return DOCA_ERROR_INVALID_VALUE;
 	}
-	session_key session_pair = {local_vip, peer_vip};
-	auto &session = sessions[session_pair];
+
+	session_key session_pair = make_session_key(vip_pair.src_vip, vip_pair.dst_vip);
+	auto *session_ptr = sessions.find_or_create(session_pair);
+	if (!session_ptr) {
+		DOCA_LOG_ERR("Session table full; cannot create session (%s -> %s)",
+			     local_vip.c_str(),
+			     peer_vip.c_str());
+		return DOCA_ERROR_FULL;
+	}
+	auto &session = *session_ptr;
+
+	if (session.encap_encrypt_entry) {
+		// Re-keying an existing tunnel: the previous SA keeps carrying the
+		// traffic until add_encrypt_entries() has installed the new one.
+		session.retired_encrypt_entry = session.encap_encrypt_entry;
+		session.retired_crypto_id = session.crypto_id;
+		session.encap_encrypt_entry = nullptr;
+	}
+
 	session.dst_vip = vip_pair.dst_vip; // allready set if other direction was supplied
 	session.src_vip = vip_pair.src_vip; // allready set if other direction was supplied
 	session.spi_egress = params.spi();
 	session.crypto_id = crypto_id;
 	session.psp_proto_ver = params.psp_version();
 	session.vc = params.virt_cookie();
+	session.dst_mac = dst_mac;
+	session.dst_pip = dst_pip;
 	void *enc_key = (void *)params.encryption_key().c_str();
 
-	if (rte_ether_unformat_addr(params.mac_addr().c_str(), &session.dst_mac)) {
-		DOCA_LOG_ERR("Failed to convert mac addr: %s", params.mac_addr().c_str());
-		sessions.erase(session_pair);
-		return DOCA_ERROR_INVALID_VALUE;
-	}
-
-	doca_flow_l3_type enforce_l3_type = params.encap_type() == 4 ? DOCA_FLOW_L3_TYPE_IP4 : DOCA_FLOW_L3_TYPE_IP6;
-	if (parse_ip_addr(params.ip_addr(), enforce_l3_type, &session.dst_pip) != DOCA_SUCCESS) {
-		DOCA_LOG_ERR("Failed to parse dst_pip %s", params.ip_addr().c_str());
-		sessions.erase(session_pair);
-		return DOCA_ERROR_INVALID_VALUE;
-	}
 	sessions_keys_prepared.push_back({&session, enc_key});
 
 	return DOCA_SUCCESS;
@@ -386,6 +653,20 @@ int PSP_GatewayImpl::select_psp_version(const ::psp_gateway::MultiTunnelRequest
 
 	response->set_request_id(request->request_id());
 
+	// Reserve the crypto_ids of all return flows up front
+	uint32_t nb_reverse_tunnels = 0;
+	for (const auto &single_request : request->tunnels()) {
+		if (single_request.has_reverse_params())
+			nb_reverse_tunnels++;
+	}
+	PSP_CryptoIdBatch batch_crypto_ids(crypto_ids);
+	if (batch_crypto_ids.alloc(nb_reverse_tunnels) != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Exhausted available crypto_ids; cannot complete %u new tunnels from peer %s",
+			     nb_reverse_tunnels,
+			     peer.c_str());
+		return ::grpc::Status(::grpc::RESOURCE_EXHAUSTED, "Exhausted available crypto_ids");
+	}
+
 	std::vector<psp_session_and_key_t> reversed_sessions_keys;
 
 	for (int tun_idx = 0; tun_idx < request->tunnels_size(); tun_idx++) {
@@ -399,10 +680,14 @@ int PSP_GatewayImpl::select_psp_version(const ::psp_gateway::MultiTunnelRequest
 
 		doca_flow_l3_type enforce_l3_type = single_request.inner_type() == 4 ? DOCA_FLOW_L3_TYPE_IP4 :
 										       DOCA_FLOW_L3_TYPE_IP6;
+		// Every error exit rolls back the return flows prepared by the previous tunnels, which may hold the
+		// retired entries of a re-key
 		if (parse_ip_addr(local_vip_str, enforce_l3_type, &local_vip) != DOCA_SUCCESS) {
+			rollback_sessions(reversed_sessions_keys, 0);
 			return ::grpc::Status(grpc::INVALID_ARGUMENT, "Failed to parse virt_dst_ip: " + local_vip_str);
 		}
 		if (parse_ip_addr(peer_vip_str, enforce_l3_type, &peer_vip) != DOCA_SUCCESS) {
+			rollback_sessions(reversed_sessions_keys, 0);
 			return ::grpc::Status(grpc::INVALID_ARGUMENT, "Failed to parse virt_src_ip: " + peer_vip_str);
 		}
 
@@ -415,7 +700,15 @@ int PSP_GatewayImpl::select_psp_version(const ::psp_gateway::MultiTunnelRequest
 		debug_key("Generated", params->encryption_key().c_str(), key_len_bits / 8);
 
 		if (!config->disable_ingress_acl) {
-			auto &session = sessions[{local_vip_str, peer_vip_str}];
+			auto *session_ptr = sessions.find_or_create(make_session_key(local_vip, peer_vip));
+			if (!session_ptr) {
+				DOCA_LOG_ERR("Session table full; cannot open ACL (%s <- %s)",
+					     local_vip_str.c_str(),
+					     peer_vip_str.c_str());
+				rollback_sessions(reversed_sessions_keys, 0);
+				return ::grpc::Status(grpc::RESOURCE_EXHAUSTED, "Session table full");
+			}
+			auto &session = *session_ptr;
 			session.spi_ingress = params->spi();
 			copy_ip_addr(local_vip, session.src_vip);
 			copy_ip_addr(peer_vip, session.dst_vip);
@@ -428,6 +721,7 @@ int PSP_GatewayImpl::select_psp_version(const ::psp_gateway::MultiTunnelRequest
 					     peer_vip_str.c_str(),
 					     session.spi_ingress,
 					     doca_error_get_descr(result));
+				rollback_sessions(reversed_sessions_keys, 0);
 				return ::grpc::Status(grpc::INTERNAL, "Failed to create ingress ACL session flow");
 			}
 
@@ -443,14 +737,19 @@ int PSP_GatewayImpl::select_psp_version(const ::psp_gateway::MultiTunnelRequest
 			    (single_request.reverse_params().encap_type() == 6 &&
 			     config->outer == DOCA_FLOW_L3_TYPE_IP4)) {
 				DOCA_LOG_ERR("Invalid encap type");
+				rollback_sessions(reversed_sessions_keys, 0);
 				return ::grpc::Status(::grpc::INVALID_ARGUMENT, "Received invalid encap type");
 			}
 			struct ip_pair vip_pair = {local_vip, peer_vip};
+			uint32_t crypto_id = batch_crypto_ids.take();
 			result = prepare_session(peer,
 						 vip_pair,
 						 single_request.reverse_params(),
+						 crypto_id,
 						 reversed_sessions_keys);
 			if (result != DOCA_SUCCESS) {
+				batch_crypto_ids.put_back(crypto_id);
+				rollback_sessions(reversed_sessions_keys, 0);
 				return ::grpc::Status(::grpc::UNKNOWN,
 						      "Failed to prepare session for peer " +
 							      std::to_string(request->request_id()));
@@ -570,7 +869,7 @@ size_t PSP_GatewayImpl::try_connect(std::vector<psp_gw_peer> &peers)
 {
 	size_t num_connected = 0;
 	for (auto peer_iter = peers.begin(); peer_iter != peers.end(); /* increment below */) {
-		doca_error_t result = request_tunnel_to_host(&*peer_iter, nullptr, false, true, false);
+		doca_error_t result = request_tunnel_to_host(&*peer_iter, false, true);
 		if (result == DOCA_SUCCESS) {
 			++num_connected;
 			peer_iter = peers.erase(peer_iter);
@@ -581,27 +880,33 @@ size_t PSP_GatewayImpl::try_connect(std::vector<psp_gw_peer> &peers)
 	return num_connected;
 }
 
-psp_gw_peer *PSP_GatewayImpl::lookup_vip_pair(ip_pair &vip_pair)
+psp_gw_peer *PSP_GatewayImpl::lookup_vip_pair(const session_key &vip_pair_key)
 {
-	return ::lookup_vip_pair(&config->net_config.peers, vip_pair);
+	return vip_peer_index.lookup(vip_pair_key);
 }
 
 doca_error_t PSP_GatewayImpl::show_flow_counts(void)
 {
-	for (auto &session : sessions) {
-		psp_flows->show_session_flow_count(session.first, session.second);
+	sessions.for_each([this](psp_session_t &session) {
+		psp_flows->show_session_flow_count(session);
+	});
+
+	psp_crypto_id_stats id_stats = crypto_ids.stats();
+	if (id_stats.nb_allocs != last_crypto_id_stats.nb_allocs ||
+	    id_stats.nb_frees != last_crypto_id_stats.nb_frees || id_stats.retired != last_crypto_id_stats.retired) {
+		DOCA_LOG_INFO("Crypto IDs: %u in use, %u retired, %u available of %u (high water %u, %lu allocs, %lu frees)",
+			      id_stats.in_use,
+			      id_stats.retired,
+			      id_stats.available,
+			      id_stats.capacity,
+			      id_stats.high_water,
+			      id_stats.nb_allocs,
+			      id_stats.nb_frees);
+		last_crypto_id_stats = id_stats;
 	}
 	return DOCA_SUCCESS;
 }
 
-uint32_t PSP_GatewayImpl::next_crypto_id(void)
-{
-	if (next_crypto_id_ > config->max_tunnels) {
-		return UINT32_MAX;
-	}
-	return next_crypto_id_++;
-}
-
 ::psp_gateway::PSP_Gateway::Stub *PSP_GatewayImpl::get_stub(const std::string &peer_ip)
 {
 	auto stubs_iter = stubs.find(peer_ip);
@@ -26,18 +26,25 @@
 #ifndef _PSP_GW_SVC_H
 #define _PSP_GW_SVC_H
 
+#include <atomic>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 
 #include <doca_flow.h>
 
 #include <psp_gateway.pb.h>
 #include <psp_gateway.grpc.pb.h>
+#include <grpcpp/completion_queue.h>
 #include "psp_gw_config.h"
+#include "psp_gw_crypto_ids.h"
 #include "psp_gw_flows.h"
+#include "psp_gw_session_table.h"
 
 struct psp_pf_dev;
 struct doca_flow_crypto_psp_spi_key_bulk;
+struct rte_mbuf;
 
 using psp_session_and_key_t = std::pair<psp_session_t *, void *>;
 
@@ -67,6 +74,21 @@ public:
 	 */
 	PSP_GatewayImpl(psp_gw_app_config *config, PSP_GatewayFlows *psp_flows);
 
+	/**
+	 * @brief Cancels any outstanding tunnel requests and frees the packets
+	 *        which were parked waiting for them. The packet-processing
+	 *        lcores must be stopped before the object is destroyed.
+	 */
+	~PSP_GatewayImpl();
+
+	/**
+	 * @brief Allocates the session table and indexes the configured
+	 *        peers by their vip pairs.
+	 *
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t init(void);
+
 	/**
 	 * @brief Requests that the recipient allocate multiple SPIs and encryption keys
 	 * so that the initiator can begin sending encrypted traffic.
@@ -96,11 +118,25 @@ public:
 	 * @brief Handles any "miss" packets received by RSS which indicate
 	 *        a new tunnel connection is needed.
 	 *
+	 * If the tunnel does not exist yet, the packet is parked (an mbuf
+	 * reference is taken) and a tunnel request to the owning peer is
+	 * issued asynchronously; the packet is reinjected or dropped by
+	 * poll_tunnel_requests() once the request completes.
+	 *
 	 * @packet [in]: The packet received from RSS
 	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
 	 */
 	doca_error_t handle_miss_packet(struct rte_mbuf *packet);
 
+	/**
+	 * @brief Reaps completed (or expired) asynchronous tunnel requests
+	 *        without blocking. Installs the new tunnels, releases or drops
+	 *        the packets parked for them, and issues the next request for
+	 *        any peer which accumulated more misses in the meantime.
+	 *        Called from the packet-processing lcores.
+	 */
+	void poll_tunnel_requests(void);
+
 	/**
 	 * @brief Displays the counters of all tunnel sessions that have
 	 *        changed since the previous invocation.
@@ -133,27 +169,139 @@ private:
 	}
 
 	/**
-	 * @brief Sends a request to the given peer
+	 * @brief An asynchronous tunnel request to a single peer, covering
+	 * every vip pair which missed while the previous request was in flight.
+	 * The object is the completion-queue tag of its own RPC.
+	 */
+	struct tunnel_rpc {
+		psp_gw_peer *peer;			     /* The peer to which the request was sent */
+		std::vector<session_key> keys;		     /* The pending tunnels covered by the request */
+		std::vector<ip_pair> vip_pairs;		     /* The vip pairs, in request order */
+		::grpc::ClientContext context;		     /* Carries the request deadline */
+		::psp_gateway::MultiTunnelRequest request;   /* The request sent to the peer */
+		::psp_gateway::MultiTunnelResponse response; /* Filled in on completion */
+		::grpc::Status status;			     /* Filled in on completion */
+		std::unique_ptr<::grpc::ClientAsyncResponseReader<::psp_gateway::MultiTunnelResponse>> reader;
+	};
+
+	/**
+	 * @brief The packets parked for a single (src vip, dst vip) pair
+	 */
+	struct pending_tunnel {
+		psp_gw_peer *peer;			/* The peer which owns the destination */
+		ip_pair vip_pair;			/* The tunnel to be created */
+		std::vector<struct rte_mbuf *> packets;	/* Parked packets, in arrival order */
+	};
+
+	/**
+	 * @brief The tunnel negotiation state of a single peer
+	 */
+	struct pending_peer {
+		std::vector<session_key> queued_keys; /* Pending tunnels not yet requested */
+		tunnel_rpc *in_flight{};	      /* The outstanding request, if any */
+		uint32_t nb_parked_pkts{};	      /* Packets parked across all pending tunnels */
+	};
+
+	/**
+	 * @brief Sends a synchronous request to the given peer for all of its
+	 * configured vip pairs.
 	 * The request includes the parameters required for
 	 * traffic in the reverse direction (remote to local).
 	 * An ACL is also provided for return traffic, if the
 	 * local/remote virtual addresses are provided.
 	 *
 	 * @peer [in]: The peer to which we will create a tunnel
-	 * @vip_pair [in]: The source and destination IP addresses of the traffic flow
 	 * @supply_reverse_params [in]: Whether to include tunnel parameters for traffic
 	 * returning to the sender of the request.
 	 * @suppress_failure_msg [in]: Indicates we are okay with a failure to connect, such
 	 * as during application startup.
-	 * @has_remote [in]: true if remote_virt_ip was send to the function -
-	 * when true, generate one pair of SPI and key and insert one rule
 	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
 	 */
 	doca_error_t request_tunnel_to_host(struct psp_gw_peer *peer,
-					    ip_pair *vip_pair,
 					    bool supply_reverse_params,
-					    bool suppress_failure_msg,
-					    bool has_remote);
+					    bool suppress_failure_msg);
+
+	/**
+	 * @brief Populates a tunnel request for the given vip pairs.
+	 * When reverse parameters are supplied, the SPI/key pairs are generated
+	 * and the ingress ACLs for the return traffic are opened.
+	 *
+	 * @peer [in]: The peer to which we will create a tunnel
+	 * @vip_pairs [in]: The source and destination IP addresses of each traffic flow
+	 * @supply_reverse_params [in]: Whether to include tunnel parameters for traffic
+	 * returning to the sender of the request.
+	 * @request [out]: The request to populate
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t build_tunnel_request(struct psp_gw_peer *peer,
+					  std::vector<ip_pair> &vip_pairs,
+					  bool supply_reverse_params,
+					  ::psp_gateway::MultiTunnelRequest &request);
+
+	/**
+	 * @brief Validates the peer's response and creates the encryption
+	 * sessions and flows for each of the requested vip pairs.
+	 *
+	 * @peer_svc_addr [in]: The peer to which we will create a tunnel
+	 * @vip_pairs [in]: The vip pairs, in request order
+	 * @request [in]: The request which was sent
+	 * @response [in]: The response which was received
+	 * @status [in]: The status of the RPC
+	 * @supply_reverse_params [in]: Whether the request included reverse parameters
+	 * @suppress_failure_msg [in]: Indicates we are okay with a failure to connect
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t process_tunnel_response(const std::string &peer_svc_addr,
+					     std::vector<ip_pair> &vip_pairs,
+					     const ::psp_gateway::MultiTunnelRequest &request,
+					     const ::psp_gateway::MultiTunnelResponse &response,
+					     const ::grpc::Status &status,
+					     bool supply_reverse_params,
+					     bool suppress_failure_msg);
+
+	/**
+	 * @brief Parks a miss packet until its tunnel is created, and issues a
+	 * request to the peer if none is in flight. Must be called with
+	 * pending_mutex held.
+	 *
+	 * @peer [in]: The peer which owns the destination
+	 * @vip_pair [in]: The tunnel to be created
+	 * @key [in]: The session key of vip_pair
+	 * @packet [in]: The packet to park
+	 * @dropped [out]: Packets to free once the lock is released
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t park_miss_packet(psp_gw_peer *peer,
+				      const ip_pair &vip_pair,
+				      const session_key &key,
+				      struct rte_mbuf *packet,
+				      std::vector<struct rte_mbuf *> &dropped);
+
+	/**
+	 * @brief Coalesces all of the peer's queued tunnels into a single
+	 * asynchronous RequestMultipleTunnelParams call. Must be called with
+	 * pending_mutex held.
+	 *
+	 * @peer [in]: The peer to which the request is sent
+	 * @state [in/out]: The peer's negotiation state
+	 * @dropped [out]: Packets to free if the request could not be issued
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	doca_error_t start_tunnel_rpc(psp_gw_peer *peer,
+				      pending_peer &state,
+				      std::vector<struct rte_mbuf *> &dropped);
+
+	/**
+	 * @brief Removes the given pending tunnels and collects their parked
+	 * packets. Must be called with pending_mutex held.
+	 *
+	 * @keys [in]: The pending tunnels to remove
+	 * @state [in/out]: The negotiation state of the owning peer
+	 * @packets [out]: The parked packets
+	 */
+	void take_pending_packets(const std::vector<session_key> &keys,
+				  pending_peer &state,
+				  std::vector<struct rte_mbuf *> &packets);
 
 	/**
 	 * @brief Returns a gRPC client for a given peer
@@ -167,10 +315,10 @@ private:
 	 * @brief Checks whether a peer has been configured to receive
 	 * traffic to the given vip_pair
 	 *
-	 * @vip_pair [in]: The source and destination IP addresses of the traffic flow
+	 * @vip_pair_key [in]: The source and destination IP addresses of the traffic flow
 	 * @return: the remote gateway host, if one exists
 	 */
-	psp_gw_peer *lookup_vip_pair(ip_pair &vip_pair);
+	psp_gw_peer *lookup_vip_pair(const session_key &vip_pair_key);
 
 	/**
 	 * @brief Checks the list of supported versions in the request
@@ -214,7 +362,10 @@ private:
 	doca_error_t generate_keys_spis(uint32_t key_len_bits, uint32_t nr_keys_spis, uint32_t *keys, uint32_t *spis);
 
 	/**
-	 * @brief Adds encryption entries to pipeline according to sessions
+	 * @brief Adds encryption entries to pipeline according to sessions.
+	 * A re-keyed session's previous entry is removed, and its crypto_id
+	 * quarantined, only once the new entry is installed. On failure the
+	 * remaining sessions are rolled back.
 	 *
 	 * @new_sessions_keys [in]: The new sessions to create entries for
 	 * @peer_svc_addr [in]: The peer to which we will create a tunnel
@@ -222,18 +373,31 @@ private:
 	 */
 	doca_error_t add_encrypt_entries(std::vector<psp_session_and_key_t> &new_sessions_keys,
 					 std::string peer_svc_addr);
+	/**
+	 * @brief Gives up on prepared sessions whose encrypt entries were not
+	 * installed: releases their new crypto_ids and puts back the entry
+	 * of any session which was being re-keyed.
+	 *
+	 * @sessions_keys [in/out]: The prepared sessions; truncated to 'first'
+	 * @first [in]: The index of the first session to roll back
+	 */
+	void rollback_sessions(std::vector<psp_session_and_key_t> &sessions_keys, size_t first);
+
 	/**
 	 * @brief Prepares the session for the given peer virtual IP
 	 *
 	 * @peer_svc_addr [in]: The peer to which we will create a tunnel
 	 * @vip_pair [in]: The source and destination IP addresses of the traffic flow
 	 * @params [in]: The parameters for the tunnel
+	 * @crypto_id [in]: The crypto_id at which to store the encryption key; the
+	 * caller keeps ownership of it if the session could not be prepared
 	 * @sessions_keys_prepared [out]: The session will be added to this vector
 	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
 	 */
 	doca_error_t prepare_session(std::string peer_svc_addr,
 				     ip_pair &vip_pair,
 				     const psp_gateway::TunnelParameters &params,
+				     uint32_t crypto_id,
 				     std::vector<psp_session_and_key_t> &sessions_keys_prepared);
 
 	/**
@@ -245,14 +409,6 @@ private:
 	 */
 	void debug_key(const char *msg_prefix, const void *key, size_t key_size_bytes) const;
 
-	/**
-	 * @brief Determines the next available crypto_id at which to store the
-	 * next PSP encryption key
-	 *
-	 * @return: The crypto_id to use for the PSP shared resource
-	 */
-	uint32_t next_crypto_id(void);
-
 	// Application state data:
 
 	psp_gw_app_config *config{};
@@ -271,10 +427,31 @@ private:
 	std::map<std::string, std::unique_ptr<::psp_gateway::PSP_Gateway::Stub>> stubs;
 
 	// map tuple of (src vip, dst vip) to an active session object
-	std::map<session_key, psp_session_t> sessions;
+	PSP_SessionTable sessions;
+
+	// map tuple of (local vip, remote vip) to the configured peer which owns it
+	PSP_VipPeerIndex vip_peer_index;
 
 	// Used to assign a unique shared-resource ID to each encryption flow.
-	uint32_t next_crypto_id_ = 1;
+	PSP_CryptoIdAllocator crypto_ids;
+
+	// Crypto ID occupancy at the previous show_flow_counts() invocation
+	psp_crypto_id_stats last_crypto_id_stats{};
+
+	// Protects the pending tunnel state below, which is shared by the lcores
+	std::mutex pending_mutex;
+
+	// map tuple of (src vip, dst vip) to the packets parked waiting for that tunnel
+	std::unordered_map<session_key, pending_tunnel, session_key_hash, session_key_equal> pending_tunnels;
+
+	// map each peer to its queued and in-flight tunnel requests
+	std::unordered_map<psp_gw_peer *, pending_peer> pending_peers;
+
+	// Completion queue of the asynchronous tunnel requests
+	::grpc::CompletionQueue tunnel_cq;
+
+	// Number of tunnel requests awaiting completion; lets the lcores skip polling
+	std::atomic<uint32_t> nb_tunnel_rpcs_in_flight{0};
 };
 
 #endif // _PSP_GW_SVC_H
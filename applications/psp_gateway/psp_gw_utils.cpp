@@ -130,3 +130,29 @@ psp_gw_peer *lookup_vip_pair(std::vector<psp_gw_peer> *peers, ip_pair &vip_pair)
 	}
 	return nullptr;
 }
+
+/**
+ * @brief Stores an IP address in IPv6 form; IPv4 addresses are IPv4-mapped (::ffff:a.b.c.d)
+ *
+ * @ip_addr [in]: the address to store
+ * @out [out]: the 16-byte IPv6 form of the address
+ */
+static void ip_addr_to_ipv6_bytes(const struct doca_flow_ip_addr &ip_addr, ipv6_addr_t out)
+{
+	memset(out, 0, IPV6_ADDR_LEN);
+	if (ip_addr.type == DOCA_FLOW_L3_TYPE_IP4) {
+		out[10] = 0xff;
+		out[11] = 0xff;
+		memcpy(&out[12], &ip_addr.ipv4_addr, sizeof(ip_addr.ipv4_addr));
+	} else if (ip_addr.type == DOCA_FLOW_L3_TYPE_IP6) {
+		memcpy(out, ip_addr.ipv6_addr, IPV6_ADDR_LEN);
+	}
+}
+
+session_key make_session_key(const struct doca_flow_ip_addr &src_vip, const struct doca_flow_ip_addr &dst_vip)
+{
+	session_key key;
+	ip_addr_to_ipv6_bytes(src_vip, key.src_vip);
+	ip_addr_to_ipv6_bytes(dst_vip, key.dst_vip);
+	return key;
+}
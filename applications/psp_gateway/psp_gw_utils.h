@@ -110,4 +110,13 @@ void copy_ip_addr(const struct doca_flow_ip_addr &src, struct doca_flow_ip_addr
  */
 psp_gw_peer *lookup_vip_pair(std::vector<psp_gw_peer> *peers, ip_pair &vip_pair);
 
+/**
+ * @brief Builds the binary session key of a (src vip, dst vip) pair
+ *
+ * @src_vip [in]: the source (local) virtual IP address
+ * @dst_vip [in]: the destination (remote) virtual IP address
+ * @return: the session key
+ */
+session_key make_session_key(const struct doca_flow_ip_addr &src_vip, const struct doca_flow_ip_addr &dst_vip);
+
 #endif /* _PSP_GW_UTILS_H_ */
@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <rte_cycles.h>
+#include <rte_pause.h>
+#include <rte_random.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <dpdk_utils.h>
+
+#include <psp_gw_config.h>
+#include <psp_gw_crypto_ids.h>
+#include <psp_gw_session_table.h>
+#include <psp_gw_utils.h>
+
+DOCA_LOG_REGISTER(PSP_SESSION_BENCH);
+
+static constexpr uint32_t BENCH_DEFAULT_LOOKUPS = 1 << 20;  /* Default number of lookups per pass */
+static constexpr uint32_t BENCH_PEERS = 256;		    /* Number of peers owning the vip pairs */
+static constexpr uint32_t BENCH_LOCAL_VIPS = 64;	    /* Number of local vips the sessions originate from */
+static const uint32_t BENCH_SESSIONS[] = {100000, 1000000}; /* Number of established sessions of each step */
+static constexpr uint32_t BENCH_CHURN_SESSIONS = 1000000;   /* Number of sessions re-keyed by each churn round */
+static constexpr uint32_t BENCH_CHURN_BATCH = 64;	    /* Sessions re-keyed per tunnel request */
+static constexpr uint32_t BENCH_CHURN_HEADROOM = 1 << 16;   /* crypto_ids beyond one per session */
+static constexpr uint32_t BENCH_DEFAULT_GRACE_MS = 100;	    /* Default crypto_id grace period, as the application */
+
+/**
+ * @brief Kind of the vip pairs looked up by a pass
+ */
+enum bench_pair_kind {
+	BENCH_PAIR_ESTABLISHED = 0, /* A session exists; the packet is re-injected */
+	BENCH_PAIR_NEGOTIATE = 1,   /* No session, the pair belongs to a peer; a tunnel is requested */
+	BENCH_PAIR_UNKNOWN = 2,	    /* No session and no peer; the packet is dropped */
+	BENCH_PAIR_KINDS = 3,
+};
+
+static const char *const bench_pair_kind_names[BENCH_PAIR_KINDS] = {"established", "negotiate", "unknown"};
+
+/**
+ * @brief Benchmark configuration
+ */
+struct bench_config {
+	uint32_t lookups;      /* Number of lookups per pass */
+	uint32_t churn_rounds; /* Number of re-key rounds of the churn bench, 0 runs the lookup bench */
+	uint32_t grace_ms;     /* crypto_id grace period of the churn bench */
+};
+
+/**
+ * @brief ARGP Callback - Handle number of lookups parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t lookups_callback(void *param, void *config)
+{
+	auto *conf = (struct bench_config *)config;
+	int lookups = *(int *)param;
+
+	if (lookups <= 0) {
+		DOCA_LOG_ERR("Number of lookups must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->lookups = lookups;
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief ARGP Callback - Handle number of churn rounds parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t churn_rounds_callback(void *param, void *config)
+{
+	auto *conf = (struct bench_config *)config;
+	int churn_rounds = *(int *)param;
+
+	if (churn_rounds < 0) {
+		DOCA_LOG_ERR("Number of churn rounds must not be negative");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->churn_rounds = churn_rounds;
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief ARGP Callback - Handle crypto_id grace period parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t grace_period_callback(void *param, void *config)
+{
+	auto *conf = (struct bench_config *)config;
+	int grace_ms = *(int *)param;
+
+	if (grace_ms < 0) {
+		DOCA_LOG_ERR("Grace period must not be negative");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->grace_ms = grace_ms;
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *lookups_param, *churn_rounds_param, *grace_period_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&lookups_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(lookups_param, "l");
+	doca_argp_param_set_long_name(lookups_param, "lookups");
+	doca_argp_param_set_description(lookups_param, "Number of lookups per pass");
+	doca_argp_param_set_callback(lookups_param, lookups_callback);
+	doca_argp_param_set_type(lookups_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(lookups_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&churn_rounds_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(churn_rounds_param, "r");
+	doca_argp_param_set_long_name(churn_rounds_param, "churn-rounds");
+	doca_argp_param_set_description(churn_rounds_param,
+					"Re-key 1M sessions that many times instead of running the lookup bench");
+	doca_argp_param_set_callback(churn_rounds_param, churn_rounds_callback);
+	doca_argp_param_set_type(churn_rounds_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(churn_rounds_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&grace_period_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(grace_period_param, "g");
+	doca_argp_param_set_long_name(grace_period_param, "grace-period");
+	doca_argp_param_set_description(grace_period_param, "Milliseconds a replaced crypto_id is quarantined");
+	doca_argp_param_set_callback(grace_period_param, grace_period_callback);
+	doca_argp_param_set_type(grace_period_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(grace_period_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Builds the vip pair with the given index and kind. The local vips
+ *        are shared by many pairs, the remote vips are unique per kind.
+ *
+ * @kind [in]: kind of the pair
+ * @idx [in]: index of the pair
+ * @return: the vip pair
+ */
+static ip_pair bench_vip_pair(enum bench_pair_kind kind, uint32_t idx)
+{
+	static const uint32_t remote_vip_base[BENCH_PAIR_KINDS] = {
+		RTE_IPV4(20, 0, 0, 0),
+		RTE_IPV4(40, 0, 0, 0),
+		RTE_IPV4(60, 0, 0, 0),
+	};
+	ip_pair pair = {};
+
+	pair.src_vip.type = DOCA_FLOW_L3_TYPE_IP4;
+	pair.src_vip.ipv4_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 1) + idx % BENCH_LOCAL_VIPS);
+	pair.dst_vip.type = DOCA_FLOW_L3_TYPE_IP4;
+	pair.dst_vip.ipv4_addr = rte_cpu_to_be_32(remote_vip_base[kind] + idx);
+	return pair;
+}
+
+/**
+ * @brief Times the miss path lookups of PSP_GatewayImpl::handle_miss_packet()
+ *        on keys of one kind, drawn at random among nb_pairs pairs
+ *
+ * @sessions [in]: the session table
+ * @vip_peer_index [in]: the vip pair to peer index
+ * @kind [in]: kind of the pairs to look up
+ * @nb_pairs [in]: number of pairs of that kind
+ * @keys [out]: buffer of the lookup keys, its size is the number of lookups
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pass(const PSP_SessionTable &sessions,
+			       const PSP_VipPeerIndex &vip_peer_index,
+			       enum bench_pair_kind kind,
+			       uint32_t nb_pairs,
+			       std::vector<session_key> &keys)
+{
+	uint32_t lookups = keys.size();
+	uint32_t nb_sessions = 0, nb_peers = 0;
+
+	for (auto &key : keys) {
+		ip_pair pair = bench_vip_pair(kind, rte_rand_max(nb_pairs));
+		key = make_session_key(pair.src_vip, pair.dst_vip);
+	}
+
+	uint64_t start = rte_get_tsc_cycles();
+	for (const auto &key : keys) {
+		bool session_exists = sessions.find(key) != nullptr;
+		psp_gw_peer *peer = session_exists ? nullptr : vip_peer_index.lookup(key);
+		nb_sessions += session_exists;
+		nb_peers += peer != nullptr;
+	}
+	uint64_t cycles = rte_get_tsc_cycles() - start;
+
+	DOCA_LOG_INFO("%10u %12s %10.1f %10.2f",
+		      sessions.size(),
+		      bench_pair_kind_names[kind],
+		      (double)cycles * 1e9 / rte_get_tsc_hz() / lookups,
+		      (double)lookups * rte_get_tsc_hz() / cycles / 1e6);
+
+	uint32_t expected_sessions = kind == BENCH_PAIR_ESTABLISHED ? lookups : 0;
+	uint32_t expected_peers = kind == BENCH_PAIR_NEGOTIATE ? lookups : 0;
+	if (nb_sessions != expected_sessions || nb_peers != expected_peers) {
+		DOCA_LOG_ERR("%u lookups found %u sessions and %u peers, expected %u and %u",
+			     lookups,
+			     nb_sessions,
+			     nb_peers,
+			     expected_sessions,
+			     expected_peers);
+		return DOCA_ERROR_UNEXPECTED;
+	}
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Runs one step: nb_sessions established sessions, as many pairs
+ *        still to negotiate, and lookups of each kind of pair
+ *
+ * @nb_sessions [in]: number of established sessions
+ * @keys [in]: buffer of the lookup keys
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_step(uint32_t nb_sessions, std::vector<session_key> &keys)
+{
+	PSP_SessionTable sessions;
+	PSP_VipPeerIndex vip_peer_index;
+	std::vector<psp_gw_peer> peers(BENCH_PEERS);
+	std::string suffix = "_" + std::to_string(nb_sessions);
+	doca_error_t result;
+
+	/* Every peer owns both established pairs and pairs still to negotiate */
+	for (uint32_t i = 0; i < nb_sessions; i++) {
+		peers[i % BENCH_PEERS].vip_pairs.push_back(bench_vip_pair(BENCH_PAIR_ESTABLISHED, i));
+		peers[i % BENCH_PEERS].vip_pairs.push_back(bench_vip_pair(BENCH_PAIR_NEGOTIATE, i));
+	}
+
+	result = sessions.init("bench_sessions" + suffix, nb_sessions);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = vip_peer_index.init("bench_vip_peers" + suffix, peers);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	for (uint32_t i = 0; i < nb_sessions; i++) {
+		ip_pair pair = bench_vip_pair(BENCH_PAIR_ESTABLISHED, i);
+		psp_session_t *session = sessions.find_or_create(make_session_key(pair.src_vip, pair.dst_vip));
+		if (session == nullptr) {
+			DOCA_LOG_ERR("Failed to create session %u of %u", i, nb_sessions);
+			return DOCA_ERROR_FULL;
+		}
+		session->src_vip = pair.src_vip;
+		session->dst_vip = pair.dst_vip;
+	}
+
+	for (int kind = BENCH_PAIR_ESTABLISHED; kind < BENCH_PAIR_KINDS; kind++) {
+		result = bench_pass(sessions, vip_peer_index, (enum bench_pair_kind)kind, nb_sessions, keys);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Re-keys every session once, a tunnel request worth of sessions at
+ *        a time, in the order of PSP_GatewayImpl: the new crypto_id is taken
+ *        before the old one is quarantined. When the quarantine holds all the
+ *        spare crypto_ids the request waits for the grace period to expire.
+ *
+ * @sessions [in]: the session table
+ * @keys [in]: the keys of the sessions
+ * @crypto_ids [in]: the crypto_id allocator
+ * @nb_stalls [out]: number of requests which waited for crypto_ids
+ */
+static void bench_churn_round(PSP_SessionTable &sessions,
+			      const std::vector<session_key> &keys,
+			      PSP_CryptoIdAllocator &crypto_ids,
+			      uint32_t *nb_stalls)
+{
+	*nb_stalls = 0;
+	for (size_t first = 0; first < keys.size(); first += BENCH_CHURN_BATCH) {
+		uint32_t nb_keys = std::min<size_t>(BENCH_CHURN_BATCH, keys.size() - first);
+		PSP_CryptoIdBatch batch(crypto_ids);
+
+		if (batch.alloc(nb_keys) != DOCA_SUCCESS) {
+			(*nb_stalls)++;
+			while (batch.alloc(nb_keys) != DOCA_SUCCESS)
+				rte_pause();
+		}
+
+		for (uint32_t i = 0; i < nb_keys; i++) {
+			psp_session_t *session = sessions.find(keys[first + i]);
+			uint32_t retired_crypto_id = session->crypto_id;
+
+			session->crypto_id = batch.take();
+			crypto_ids.release(retired_crypto_id);
+		}
+	}
+}
+
+/**
+ * @brief Runs the churn benchmark: 1M sessions are re-keyed over and over
+ *        within a fixed crypto_id space
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_churn(const struct bench_config *conf)
+{
+	PSP_SessionTable sessions;
+	PSP_CryptoIdAllocator crypto_ids;
+	std::vector<session_key> keys(BENCH_CHURN_SESSIONS);
+	doca_error_t result;
+
+	result = sessions.init("bench_churn_sessions", BENCH_CHURN_SESSIONS);
+	if (result != DOCA_SUCCESS)
+		return result;
+	crypto_ids.init(1, BENCH_CHURN_SESSIONS + BENCH_CHURN_HEADROOM, conf->grace_ms);
+
+	for (uint32_t i = 0; i < BENCH_CHURN_SESSIONS; i++) {
+		ip_pair pair = bench_vip_pair(BENCH_PAIR_ESTABLISHED, i);
+		keys[i] = make_session_key(pair.src_vip, pair.dst_vip);
+		psp_session_t *session = sessions.find_or_create(keys[i]);
+		if (session == nullptr) {
+			DOCA_LOG_ERR("Failed to create session %u of %u", i, BENCH_CHURN_SESSIONS);
+			return DOCA_ERROR_FULL;
+		}
+		session->crypto_id = crypto_ids.alloc();
+	}
+
+	DOCA_LOG_INFO("%u sessions re-keyed %u times, %u spare crypto_ids, %u ms grace period",
+		      BENCH_CHURN_SESSIONS,
+		      conf->churn_rounds,
+		      BENCH_CHURN_HEADROOM,
+		      conf->grace_ms);
+	DOCA_LOG_INFO("%6s %10s %10s %8s %10s %10s %10s", "Round", "ns", "K/s", "Stalls", "In use", "Retired", "High");
+	for (uint32_t round = 1; round <= conf->churn_rounds; round++) {
+		uint32_t nb_stalls;
+
+		uint64_t start = rte_get_tsc_cycles();
+		bench_churn_round(sessions, keys, crypto_ids, &nb_stalls);
+		uint64_t cycles = rte_get_tsc_cycles() - start;
+
+		psp_crypto_id_stats stats = crypto_ids.stats();
+		DOCA_LOG_INFO("%6u %10.1f %10.1f %8u %10u %10u %10u",
+			      round,
+			      (double)cycles * 1e9 / rte_get_tsc_hz() / BENCH_CHURN_SESSIONS,
+			      (double)BENCH_CHURN_SESSIONS * rte_get_tsc_hz() / cycles / 1e3,
+			      nb_stalls,
+			      stats.in_use,
+			      stats.retired,
+			      stats.high_water);
+		if (stats.in_use != BENCH_CHURN_SESSIONS) {
+			DOCA_LOG_ERR("%u crypto_ids in use by %u sessions", stats.in_use, BENCH_CHURN_SESSIONS);
+			return DOCA_ERROR_UNEXPECTED;
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief Runs the benchmark over all the session counts
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf)
+{
+	std::vector<session_key> keys(conf->lookups);
+	doca_error_t result;
+
+	if (conf->churn_rounds)
+		return bench_churn(conf);
+
+	DOCA_LOG_INFO("%u random lookups per pass, as done by the miss path", conf->lookups);
+	DOCA_LOG_INFO("%10s %12s %10s %10s", "Sessions", "Pairs", "ns", "M/s");
+	for (uint32_t nb_sessions : BENCH_SESSIONS) {
+		result = bench_step(nb_sessions, keys);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	return DOCA_SUCCESS;
+}
+
+/**
+ * @brief PSP Gateway session table benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	conf.lookups = BENCH_DEFAULT_LOOKUPS;
+	conf.grace_ms = BENCH_DEFAULT_GRACE_MS;
+
+	/* Parse cmdline/json arguments, the hash tables memory comes from the EAL */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	doca_argp_set_dpdk_program(dpdk_init);
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	result = bench_main(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	dpdk_fini();
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,6 +27,8 @@
 
 #include <stdint.h>
 
+#define APP_VNF_MAX_BURST_SIZE (64) /* Maximum number of packets handed to the application in a single burst */
+
 /* Holder for the packed info */
 struct simple_fwd_pkt_info;
 
@@ -34,7 +36,10 @@ struct simple_fwd_pkt_info;
 struct app_vnf {
 	int (*vnf_init)(void *p); /* A function pointer for initializing all application resources */
 	int (*vnf_process_pkt)(struct simple_fwd_pkt_info *pinfo); /* A function pointer for processing the packets */
+	int (*vnf_process_burst)(struct simple_fwd_pkt_info **pinfos,
+				 uint16_t nb_pkts); /* A function pointer for processing a burst of packets */
 	void (*vnf_flow_age)(uint32_t port_id, uint16_t queue);	   /* A function pointer for the aging handling */
+	void (*vnf_flush)(uint32_t port_id, uint16_t queue); /* A function pointer for completing a burst offloads */
 	int (*vnf_dump_stats)(uint32_t port_id);		   /* A function pointer for dumping the stats */
 	int (*vnf_destroy)(void); /* A function pointer for destroying all allocated application resources */
 };
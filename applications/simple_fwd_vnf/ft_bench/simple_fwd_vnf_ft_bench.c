@@ -0,0 +1,978 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_udp.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <dpdk_utils.h>
+
+#include "simple_fwd.h"
+#include "simple_fwd_ft.h"
+#include "simple_fwd_pkt.h"
+
+DOCA_LOG_REGISTER(SIMPLE_FWD_FT_BENCH);
+
+#define BENCH_DEFAULT_NB_FLOWS (1 << 20)	/* Default number of flows inserted to the flow table */
+#define BENCH_MAX_NB_FLOWS (1 << 24)		/* Maximal number of flows, each flow has its own IPv4 source address */
+#define BENCH_DEFAULT_ITERATIONS 4		/* Default number of lookup passes over the flows */
+#define BENCH_DEFAULT_BURST_SIZE 32		/* Default number of packets per burst */
+#define BENCH_MAX_BURST_SIZE 64			/* Maximal number of packets per burst */
+#define BENCH_PKT_STRIDE RTE_CACHE_LINE_SIZE	/* Every packet has its own cache line, as the mbufs data does */
+#define BENCH_SRC_IP_BASE RTE_IPV4(10, 0, 0, 0)	/* First IPv4 source address of the flows */
+#define BENCH_DST_IP RTE_IPV4(192, 168, 0, 1)	/* IPv4 destination address of the flows */
+#define BENCH_SRC_PORT 5000			/* UDP source port of the flows */
+#define BENCH_DST_PORT 6000			/* UDP destination port of the flows */
+#define BENCH_RSS_MULT 2654435761U		/* Multiplier spreading the flow index into an RSS hash */
+#define BENCH_MAX_PATH_LEN 1024			/* Maximal length of the pcap file path */
+#define BENCH_MAX_PKT_LEN 2048			/* Packets are truncated to the data room of a default mbuf */
+#define BENCH_MAX_MIXES 32			/* Maximal number of distinct protocol mixes reported */
+#define BENCH_MAX_MIX_NAME_LEN 32		/* Maximal length of a protocol mix name */
+
+#define PCAP_MAGIC_US 0xa1b2c3d4 /* pcap file with microsecond timestamps */
+#define PCAP_MAGIC_NS 0xa1b23c4d /* pcap file with nanosecond timestamps */
+#define PCAP_LINKTYPE_ETHERNET 1 /* Ethernet link type */
+
+/* pcap file header */
+struct pcap_file_hdr {
+	uint32_t magic;		/* File format and byte order magic */
+	uint16_t version_major;	/* Major version */
+	uint16_t version_minor;	/* Minor version */
+	int32_t thiszone;	/* Time zone correction */
+	uint32_t sigfigs;	/* Timestamps accuracy */
+	uint32_t snaplen;	/* Maximal captured length */
+	uint32_t linktype;	/* Link-layer header type */
+};
+
+/* pcap record header */
+struct pcap_rec_hdr {
+	uint32_t ts_sec;  /* Timestamp seconds */
+	uint32_t ts_frac; /* Timestamp microseconds or nanoseconds */
+	uint32_t caplen;  /* Captured length */
+	uint32_t len;	  /* Original length */
+};
+
+/* Benchmark configuration */
+struct bench_config {
+	uint32_t nb_flows;		    /* Number of flows inserted to the flow table */
+	uint32_t iterations;		    /* Number of lookup passes over the flows */
+	uint16_t burst_size;		    /* Number of packets per burst */
+	char pcap_path[BENCH_MAX_PATH_LEN]; /* pcap file of the packets to benchmark, synthetic flows if empty */
+};
+
+/* Packets of the benchmarked flows, one per flow */
+struct bench_flows {
+	uint8_t *pkts;	   /* Packets headers, BENCH_PKT_STRIDE bytes apart */
+	uint32_t *order;   /* Flow indexes in a random order, used by the lookup passes */
+	uint32_t nb_flows; /* Number of flows */
+};
+
+/* Packets loaded from a pcap file */
+struct bench_pcap_pkts {
+	uint8_t *arena;	   /* Memory holding the packets data, every packet starts on its own cache line */
+	uint8_t **data;	   /* Packets data in file order */
+	uint16_t *len;	   /* Packets length */
+	uint32_t nb_pkts;  /* Number of packets */
+	uint32_t nb_drops; /* Number of packets the application parser rejects */
+};
+
+/* pcap packets sharing the same protocol stack */
+struct bench_mix {
+	char name[BENCH_MAX_MIX_NAME_LEN]; /* Protocol stack description */
+	uint32_t *idx;			   /* Indexes of the packets of the mix, in file order */
+	uint32_t nb_pkts;		   /* Number of packets of the mix */
+};
+
+/* Timing of a protocol mix */
+struct bench_mix_result {
+	uint64_t parse_cycles;	/* TSC cycles spent parsing the packets, over all the iterations */
+	uint64_t insert_cycles; /* TSC cycles spent looking up and adding the flows on the first pass */
+	uint64_t lookup_cycles; /* TSC cycles spent in bulk lookups, over all the iterations */
+	uint64_t nb_flows;	/* Number of flows added on the first pass */
+	uint64_t nb_found;	/* Number of packets found by the bulk lookups */
+};
+
+/* Timing of a benchmark pass */
+struct bench_result {
+	uint64_t cycles;   /* TSC cycles spent in the flow table calls */
+	uint64_t nb_pkts;  /* Number of packets handled */
+	uint64_t nb_found; /* Number of packets for which an entry was found or added */
+};
+
+/*
+ * ARGP Callback - Handle number of flows parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t nb_flows_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int nb_flows = *(int *)param;
+
+	if (nb_flows <= 0 || nb_flows > BENCH_MAX_NB_FLOWS) {
+		DOCA_LOG_ERR("Number of flows must be between 1 and %d", BENCH_MAX_NB_FLOWS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->nb_flows = nb_flows;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle iterations parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t iterations_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int iterations = *(int *)param;
+
+	if (iterations <= 0) {
+		DOCA_LOG_ERR("Number of iterations must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->iterations = iterations;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle burst size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t burst_size_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int burst_size = *(int *)param;
+
+	if (burst_size <= 0 || burst_size > BENCH_MAX_BURST_SIZE) {
+		DOCA_LOG_ERR("Burst size must be between 1 and %d", BENCH_MAX_BURST_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->burst_size = burst_size;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle pcap file parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t pcap_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	const char *path = (const char *)param;
+
+	if (strnlen(path, BENCH_MAX_PATH_LEN) == BENCH_MAX_PATH_LEN) {
+		DOCA_LOG_ERR("pcap file path is too long, max %d", BENCH_MAX_PATH_LEN - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->pcap_path, path);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *nb_flows_param, *iterations_param, *burst_size_param, *pcap_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&nb_flows_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(nb_flows_param, "n");
+	doca_argp_param_set_long_name(nb_flows_param, "nb-flows");
+	doca_argp_param_set_description(nb_flows_param, "Number of flows inserted to the flow table");
+	doca_argp_param_set_callback(nb_flows_param, nb_flows_callback);
+	doca_argp_param_set_type(nb_flows_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(nb_flows_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(iterations_param, "i");
+	doca_argp_param_set_long_name(iterations_param, "iterations");
+	doca_argp_param_set_description(iterations_param, "Number of lookup passes over the flows");
+	doca_argp_param_set_callback(iterations_param, iterations_callback);
+	doca_argp_param_set_type(iterations_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(iterations_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(burst_size_param, "b");
+	doca_argp_param_set_long_name(burst_size_param, "burst-size");
+	doca_argp_param_set_description(burst_size_param, "Number of packets per burst");
+	doca_argp_param_set_callback(burst_size_param, burst_size_callback);
+	doca_argp_param_set_type(burst_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(burst_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&pcap_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(pcap_param, "f");
+	doca_argp_param_set_long_name(pcap_param, "pcap");
+	doca_argp_param_set_arguments(pcap_param, "<path>");
+	doca_argp_param_set_description(pcap_param,
+					"pcap file of Ethernet packets to parse and look up, grouped by protocol mix");
+	doca_argp_param_set_callback(pcap_param, pcap_callback);
+	doca_argp_param_set_type(pcap_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(pcap_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Aging callback of the flow table, the benchmarked entries have no HW part to release
+ *
+ * @ctx [in]: user context of the removed entry
+ */
+static void bench_aging_cb(struct simple_fwd_ft_user_ctx *ctx)
+{
+	(void)ctx;
+}
+
+/*
+ * Build one Ethernet/IPv4/UDP packet per flow, and a random lookup order of the flows
+ *
+ * @nb_flows [in]: number of flows
+ * @flows [out]: the flows packets
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_flows_build(uint32_t nb_flows, struct bench_flows *flows)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ipv4;
+	struct rte_udp_hdr *udp;
+	uint64_t rnd = 0x9e3779b97f4a7c15ULL;
+	uint32_t i, j, tmp;
+
+	flows->pkts = aligned_alloc(RTE_CACHE_LINE_SIZE, (size_t)nb_flows * BENCH_PKT_STRIDE);
+	flows->order = calloc(nb_flows, sizeof(*flows->order));
+	if (flows->pkts == NULL || flows->order == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u flows", nb_flows);
+		free(flows->order);
+		free(flows->pkts);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(flows->pkts, 0, (size_t)nb_flows * BENCH_PKT_STRIDE);
+	flows->nb_flows = nb_flows;
+
+	for (i = 0; i < nb_flows; i++) {
+		eth = (struct rte_ether_hdr *)(flows->pkts + (size_t)i * BENCH_PKT_STRIDE);
+		ipv4 = (struct rte_ipv4_hdr *)(eth + 1);
+		udp = (struct rte_udp_hdr *)(ipv4 + 1);
+
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+		ipv4->version_ihl = RTE_IPV4_VHL_DEF;
+		ipv4->total_length = rte_cpu_to_be_16(sizeof(*ipv4) + sizeof(*udp));
+		ipv4->time_to_live = 64;
+		ipv4->next_proto_id = IPPROTO_UDP;
+		ipv4->src_addr = rte_cpu_to_be_32(BENCH_SRC_IP_BASE + i);
+		ipv4->dst_addr = rte_cpu_to_be_32(BENCH_DST_IP);
+		udp->src_port = RTE_BE16(BENCH_SRC_PORT);
+		udp->dst_port = RTE_BE16(BENCH_DST_PORT);
+		udp->dgram_len = RTE_BE16(sizeof(*udp));
+		flows->order[i] = i;
+	}
+
+	/* Fisher-Yates shuffle with a xorshift generator, so that every run looks the flows up in the same order */
+	for (i = nb_flows - 1; i > 0; i--) {
+		rnd ^= rnd << 13;
+		rnd ^= rnd >> 7;
+		rnd ^= rnd << 17;
+		j = rnd % (i + 1);
+		tmp = flows->order[i];
+		flows->order[i] = flows->order[j];
+		flows->order[j] = tmp;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse a burst of the flows packets, the same way the application parses its received packets
+ *
+ * @flows [in]: the flows packets
+ * @idx [in]: indexes of the flows of the burst
+ * @nb_pkts [in]: number of packets in the burst
+ * @miss [in]: true to alter the RSS hash of the packets, so that their keys are not in the flow table
+ * @pinfos [out]: packets info of the burst
+ */
+static void bench_burst_parse(const struct bench_flows *flows,
+			      const uint32_t *idx,
+			      uint16_t nb_pkts,
+			      bool miss,
+			      struct simple_fwd_pkt_info *pinfos)
+{
+	uint8_t *data;
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		data = flows->pkts + (size_t)idx[i] * BENCH_PKT_STRIDE;
+		memset(&pinfos[i], 0, sizeof(pinfos[i]));
+		pinfos[i].orig_data = data;
+		pinfos[i].rss_hash = idx[i] * BENCH_RSS_MULT;
+		if (miss)
+			pinfos[i].rss_hash = ~pinfos[i].rss_hash;
+		simple_fwd_parse_packet(data,
+					sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) +
+						sizeof(struct rte_udp_hdr),
+					&pinfos[i]);
+	}
+}
+
+/*
+ * Insert all the flows to the flow table, in their creation order
+ *
+ * @ft [in]: the flow table
+ * @flows [in]: the flows packets
+ * @conf [in]: benchmark configuration
+ * @result [out]: timing of the pass
+ */
+static void bench_insert(struct simple_fwd_ft *ft,
+			 const struct bench_flows *flows,
+			 const struct bench_config *conf,
+			 struct bench_result *result)
+{
+	struct simple_fwd_pkt_info pinfos[BENCH_MAX_BURST_SIZE];
+	uint32_t idx[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_ft_user_ctx *ctx;
+	uint64_t start;
+	uint32_t i;
+	uint16_t j, n;
+
+	memset(result, 0, sizeof(*result));
+	for (i = 0; i < flows->nb_flows; i += n) {
+		n = RTE_MIN(flows->nb_flows - i, (uint32_t)conf->burst_size);
+		for (j = 0; j < n; j++)
+			idx[j] = i + j;
+		bench_burst_parse(flows, idx, n, false, pinfos);
+		start = rte_rdtsc();
+		for (j = 0; j < n; j++)
+			if (simple_fwd_ft_add_new(ft, &pinfos[j], &ctx) == DOCA_SUCCESS)
+				result->nb_found++;
+		result->cycles += rte_rdtsc() - start;
+	}
+	result->nb_pkts = flows->nb_flows;
+}
+
+/*
+ * Look all the flows up in a random order, either one packet at a time or a burst at a time
+ *
+ * @ft [in]: the flow table
+ * @flows [in]: the flows packets
+ * @conf [in]: benchmark configuration
+ * @bulk [in]: true to use simple_fwd_ft_find_bulk() and false to use simple_fwd_ft_find()
+ * @miss [in]: true to look up keys which are not in the flow table
+ * @result [out]: timing of the pass
+ */
+static void bench_lookup(struct simple_fwd_ft *ft,
+			 const struct bench_flows *flows,
+			 const struct bench_config *conf,
+			 bool bulk,
+			 bool miss,
+			 struct bench_result *result)
+{
+	struct simple_fwd_pkt_info pinfos[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_pkt_info *pinfos_ptr[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_ft_user_ctx *ctxs[BENCH_MAX_BURST_SIZE];
+	uint64_t start;
+	uint32_t it, i;
+	uint16_t j, n;
+
+	memset(result, 0, sizeof(*result));
+	for (j = 0; j < BENCH_MAX_BURST_SIZE; j++)
+		pinfos_ptr[j] = &pinfos[j];
+
+	for (it = 0; it < conf->iterations; it++) {
+		for (i = 0; i < flows->nb_flows; i += n) {
+			n = RTE_MIN(flows->nb_flows - i, (uint32_t)conf->burst_size);
+			bench_burst_parse(flows, &flows->order[i], n, miss, pinfos);
+			start = rte_rdtsc();
+			if (bulk) {
+				result->nb_found += simple_fwd_ft_find_bulk(ft, pinfos_ptr, n, ctxs);
+			} else {
+				for (j = 0; j < n; j++)
+					if (simple_fwd_ft_find(ft, &pinfos[j], &ctxs[j]) == DOCA_SUCCESS)
+						result->nb_found++;
+			}
+			result->cycles += rte_rdtsc() - start;
+		}
+	}
+	result->nb_pkts = (uint64_t)flows->nb_flows * conf->iterations;
+}
+
+/*
+ * Log the timing of a benchmark pass
+ *
+ * @name [in]: name of the pass
+ * @result [in]: timing of the pass
+ */
+static void bench_result_log(const char *name, const struct bench_result *result)
+{
+	double cycles = (double)result->cycles / result->nb_pkts;
+	double mpps = (double)result->nb_pkts * rte_get_tsc_hz() / result->cycles / 1e6;
+
+	DOCA_LOG_INFO("%-20s %12lu %12lu %12.1f %10.2f", name, result->nb_pkts, result->nb_found, cycles, mpps);
+}
+
+/*
+ * Get the number of bytes allocated from the DPDK heap of the current socket
+ *
+ * @return: number of allocated bytes
+ */
+static size_t bench_heap_allocated(void)
+{
+	struct rte_malloc_socket_stats stats;
+
+	if (rte_malloc_get_socket_stats(rte_socket_id(), &stats) != 0)
+		return 0;
+	return stats.heap_allocsz_bytes;
+}
+
+/*
+ * Run the benchmark
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf)
+{
+	struct bench_flows flows = {0};
+	struct bench_result result;
+	struct simple_fwd_ft *ft;
+	size_t heap_before, heap_after;
+	doca_error_t ret;
+
+	ret = bench_flows_build(conf->nb_flows, &flows);
+	if (ret != DOCA_SUCCESS)
+		return ret;
+
+	/* The flow table memory is all taken from the DPDK heap when it is created */
+	heap_before = bench_heap_allocated();
+	ft = simple_fwd_ft_create(conf->nb_flows, sizeof(struct simple_fwd_pipe_entry), &bench_aging_cb, NULL, false);
+	if (ft == NULL) {
+		DOCA_LOG_ERR("Failed to create a flow table of %u flows", conf->nb_flows);
+		ret = DOCA_ERROR_NO_MEMORY;
+		goto free_flows;
+	}
+	heap_after = bench_heap_allocated();
+
+	DOCA_LOG_INFO("Flow table of %u flows, bursts of %u packets, %u lookup iterations",
+		      conf->nb_flows,
+		      conf->burst_size,
+		      conf->iterations);
+	DOCA_LOG_INFO("Memory: %zu bytes, %.1f bytes per flow",
+		      heap_after - heap_before,
+		      (double)(heap_after - heap_before) / conf->nb_flows);
+	DOCA_LOG_INFO("%-20s %12s %12s %12s %10s", "Pass", "Packets", "Found/added", "Cycles/pkt", "Mpps");
+
+	bench_insert(ft, &flows, conf, &result);
+	bench_result_log("insert", &result);
+	if (result.nb_found != result.nb_pkts)
+		DOCA_LOG_WARN("%lu flows did not fit in their buckets", result.nb_pkts - result.nb_found);
+
+	bench_lookup(ft, &flows, conf, false, false, &result);
+	bench_result_log("lookup hit", &result);
+	bench_lookup(ft, &flows, conf, true, false, &result);
+	bench_result_log("bulk lookup hit", &result);
+	bench_lookup(ft, &flows, conf, true, true, &result);
+	bench_result_log("bulk lookup miss", &result);
+
+	simple_fwd_ft_destroy(ft);
+free_flows:
+	free(flows.order);
+	free(flows.pkts);
+	return ret;
+}
+
+/*
+ * Read the packets of a pcap file, truncated to BENCH_MAX_PKT_LEN bytes
+ *
+ * @path [in]: pcap file path
+ * @pkts [out]: the loaded packets
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pcap_load(const char *path, struct bench_pcap_pkts *pkts)
+{
+	struct pcap_file_hdr file_hdr;
+	struct pcap_rec_hdr rec_hdr;
+	uint32_t caplen, len, i;
+	size_t arena_len = 0;
+	size_t offset = 0;
+	doca_error_t result;
+	bool swapped;
+	FILE *file;
+
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		DOCA_LOG_ERR("Failed to open pcap file %s", path);
+		return DOCA_ERROR_NOT_FOUND;
+	}
+
+	if (fread(&file_hdr, sizeof(file_hdr), 1, file) != 1) {
+		DOCA_LOG_ERR("Failed to read the pcap file header");
+		result = DOCA_ERROR_IO_FAILED;
+		goto close_file;
+	}
+	if (file_hdr.magic == PCAP_MAGIC_US || file_hdr.magic == PCAP_MAGIC_NS) {
+		swapped = false;
+	} else if (file_hdr.magic == rte_bswap32(PCAP_MAGIC_US) || file_hdr.magic == rte_bswap32(PCAP_MAGIC_NS)) {
+		swapped = true;
+		file_hdr.linktype = rte_bswap32(file_hdr.linktype);
+	} else {
+		DOCA_LOG_ERR("%s is not a pcap file, pcapng files are not supported", path);
+		result = DOCA_ERROR_NOT_SUPPORTED;
+		goto close_file;
+	}
+	if (file_hdr.linktype != PCAP_LINKTYPE_ETHERNET) {
+		DOCA_LOG_ERR("Unsupported pcap link type %u, only Ethernet is supported", file_hdr.linktype);
+		result = DOCA_ERROR_NOT_SUPPORTED;
+		goto close_file;
+	}
+
+	/* First pass sizes the arena, the second one fills it */
+	while (fread(&rec_hdr, sizeof(rec_hdr), 1, file) == 1) {
+		caplen = swapped ? rte_bswap32(rec_hdr.caplen) : rec_hdr.caplen;
+		if (fseek(file, caplen, SEEK_CUR) != 0)
+			break;
+		arena_len += RTE_ALIGN_CEIL(RTE_MIN(caplen, (uint32_t)BENCH_MAX_PKT_LEN), RTE_CACHE_LINE_SIZE);
+		pkts->nb_pkts++;
+	}
+	if (pkts->nb_pkts == 0) {
+		DOCA_LOG_ERR("No packets in pcap file %s", path);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto close_file;
+	}
+
+	pkts->arena = aligned_alloc(RTE_CACHE_LINE_SIZE, RTE_MAX(arena_len, (size_t)RTE_CACHE_LINE_SIZE));
+	pkts->data = calloc(pkts->nb_pkts, sizeof(*pkts->data));
+	pkts->len = calloc(pkts->nb_pkts, sizeof(*pkts->len));
+	if (pkts->arena == NULL || pkts->data == NULL || pkts->len == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u packets", pkts->nb_pkts);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_pkts;
+	}
+
+	fseek(file, sizeof(file_hdr), SEEK_SET);
+	for (i = 0; i < pkts->nb_pkts; i++) {
+		if (fread(&rec_hdr, sizeof(rec_hdr), 1, file) != 1) {
+			DOCA_LOG_ERR("Failed to read pcap record %u", i);
+			result = DOCA_ERROR_IO_FAILED;
+			goto free_pkts;
+		}
+		caplen = swapped ? rte_bswap32(rec_hdr.caplen) : rec_hdr.caplen;
+		len = RTE_MIN(caplen, (uint32_t)BENCH_MAX_PKT_LEN);
+		pkts->data[i] = pkts->arena + offset;
+		pkts->len[i] = len;
+		if (fread(pkts->data[i], 1, len, file) != len || fseek(file, caplen - len, SEEK_CUR) != 0) {
+			DOCA_LOG_ERR("Failed to read pcap record %u", i);
+			result = DOCA_ERROR_IO_FAILED;
+			goto free_pkts;
+		}
+		offset += RTE_ALIGN_CEIL(len, RTE_CACHE_LINE_SIZE);
+	}
+	fclose(file);
+	return DOCA_SUCCESS;
+
+free_pkts:
+	free(pkts->len);
+	free(pkts->data);
+	free(pkts->arena);
+	memset(pkts, 0, sizeof(*pkts));
+close_file:
+	fclose(file);
+	return result;
+}
+
+/*
+ * Get the name of a layer 3 protocol as classified by the application parser
+ *
+ * @l3_type [in]: layer 3 type of the parsing result
+ * @return: protocol name
+ */
+static const char *bench_l3_name(uint8_t l3_type)
+{
+	switch (l3_type) {
+	case IPV4:
+		return "ipv4";
+	case IPV6:
+		return "ipv6";
+	default:
+		return "l2";
+	}
+}
+
+/*
+ * Get the name of a tunnel type as classified by the application parser
+ *
+ * @tun_type [in]: tunnel type of the parsing result
+ * @return: tunnel name
+ */
+static const char *bench_tun_name(enum doca_flow_tun_type tun_type)
+{
+	switch (tun_type) {
+	case DOCA_FLOW_TUN_GRE:
+		return "gre";
+	case DOCA_FLOW_TUN_VXLAN:
+		return "vxlan";
+	case DOCA_FLOW_TUN_GTPU:
+		return "gtpu";
+	default:
+		return "tunnel";
+	}
+}
+
+/*
+ * Group the pcap packets by the protocol stack the application parser finds in them.
+ * The first mix holds all the parsed packets, in file order.
+ *
+ * @pkts [in/out]: the pcap packets, the number of packets the parser rejects is set
+ * @mixes [out]: the protocol mixes, BENCH_MAX_MIXES entries
+ * @nb_mixes [out]: number of protocol mixes
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_mixes_build(struct bench_pcap_pkts *pkts, struct bench_mix *mixes, uint32_t *nb_mixes)
+{
+	struct simple_fwd_pkt_info pinfo;
+	char name[BENCH_MAX_MIX_NAME_LEN];
+	uint32_t i, m;
+
+	*nb_mixes = 0;
+	for (m = 0; m < BENCH_MAX_MIXES; m++) {
+		mixes[m].idx = calloc(pkts->nb_pkts, sizeof(*mixes[m].idx));
+		if (mixes[m].idx == NULL) {
+			DOCA_LOG_ERR("Failed to allocate memory for %u packets", pkts->nb_pkts);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+	}
+	snprintf(mixes[0].name, sizeof(mixes[0].name), "all");
+	*nb_mixes = 1;
+
+	for (i = 0; i < pkts->nb_pkts; i++) {
+		memset(&pinfo, 0, sizeof(pinfo));
+		if (simple_fwd_parse_packet(pkts->data[i], pkts->len[i], &pinfo) != 0) {
+			pkts->nb_drops++;
+			continue;
+		}
+		if (pinfo.tun_type == DOCA_FLOW_TUN_NONE)
+			snprintf(name, sizeof(name), "%s", bench_l3_name(pinfo.outer.l3_type));
+		else
+			snprintf(name,
+				 sizeof(name),
+				 "%s/%s/%s",
+				 bench_l3_name(pinfo.outer.l3_type),
+				 bench_tun_name(pinfo.tun_type),
+				 bench_l3_name(pinfo.inner.l3_type));
+
+		for (m = 1; m < *nb_mixes; m++)
+			if (strcmp(mixes[m].name, name) == 0)
+				break;
+		if (m == *nb_mixes && m < BENCH_MAX_MIXES) {
+			snprintf(mixes[m].name, sizeof(mixes[m].name), "%s", name);
+			(*nb_mixes)++;
+		}
+		if (m < *nb_mixes)
+			mixes[m].idx[mixes[m].nb_pkts++] = i;
+		mixes[0].idx[mixes[0].nb_pkts++] = i;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse a burst of pcap packets, the same way the application parses its received packets.
+ * The RSS hash is left zeroed, as a pcap file does not carry the one the NIC would have computed.
+ *
+ * @pkts [in]: the pcap packets
+ * @idx [in]: indexes of the packets of the burst
+ * @nb_pkts [in]: number of packets in the burst
+ * @pinfos [out]: packets info of the burst
+ */
+static void bench_pcap_burst_parse(const struct bench_pcap_pkts *pkts,
+				   const uint32_t *idx,
+				   uint16_t nb_pkts,
+				   struct simple_fwd_pkt_info *pinfos)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		memset(&pinfos[i], 0, sizeof(pinfos[i]));
+		pinfos[i].orig_data = pkts->data[idx[i]];
+		simple_fwd_parse_packet(pkts->data[idx[i]], pkts->len[idx[i]], &pinfos[i]);
+	}
+}
+
+/*
+ * Time the parsing, the flows insertion and the bulk lookups of the packets of a protocol mix, on a flow table of its
+ * own. The first pass handles the packets the way the application does: a bulk lookup of the burst, then an addition
+ * of the flows that are not found.
+ *
+ * @pkts [in]: the pcap packets
+ * @mix [in]: the protocol mix
+ * @conf [in]: benchmark configuration
+ * @result [out]: timing of the mix
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_mix_run(const struct bench_pcap_pkts *pkts,
+				  const struct bench_mix *mix,
+				  const struct bench_config *conf,
+				  struct bench_mix_result *result)
+{
+	struct simple_fwd_pkt_info pinfos[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_pkt_info *pinfos_ptr[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_ft_user_ctx *ctxs[BENCH_MAX_BURST_SIZE];
+	struct simple_fwd_ft *ft;
+	uint64_t start;
+	uint32_t it, i;
+	uint16_t j, n;
+
+	memset(result, 0, sizeof(*result));
+	for (j = 0; j < BENCH_MAX_BURST_SIZE; j++)
+		pinfos_ptr[j] = &pinfos[j];
+
+	for (it = 0; it < conf->iterations; it++) {
+		for (i = 0; i < mix->nb_pkts; i += n) {
+			n = RTE_MIN(mix->nb_pkts - i, (uint32_t)conf->burst_size);
+			start = rte_rdtsc();
+			bench_pcap_burst_parse(pkts, &mix->idx[i], n, pinfos);
+			result->parse_cycles += rte_rdtsc() - start;
+		}
+	}
+
+	/* A mix has at most as many flows as packets */
+	ft = simple_fwd_ft_create(mix->nb_pkts, sizeof(struct simple_fwd_pipe_entry), &bench_aging_cb, NULL, false);
+	if (ft == NULL) {
+		DOCA_LOG_ERR("Failed to create a flow table of %u flows", mix->nb_pkts);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (i = 0; i < mix->nb_pkts; i += n) {
+		n = RTE_MIN(mix->nb_pkts - i, (uint32_t)conf->burst_size);
+		bench_pcap_burst_parse(pkts, &mix->idx[i], n, pinfos);
+		start = rte_rdtsc();
+		simple_fwd_ft_find_bulk(ft, pinfos_ptr, n, ctxs);
+		for (j = 0; j < n; j++) {
+			/* Earlier packets of the burst may have added the flow already */
+			if (ctxs[j] == NULL && simple_fwd_ft_find(ft, &pinfos[j], &ctxs[j]) != DOCA_SUCCESS &&
+			    simple_fwd_ft_add_new(ft, &pinfos[j], &ctxs[j]) == DOCA_SUCCESS)
+				result->nb_flows++;
+		}
+		result->insert_cycles += rte_rdtsc() - start;
+	}
+
+	for (it = 0; it < conf->iterations; it++) {
+		for (i = 0; i < mix->nb_pkts; i += n) {
+			n = RTE_MIN(mix->nb_pkts - i, (uint32_t)conf->burst_size);
+			bench_pcap_burst_parse(pkts, &mix->idx[i], n, pinfos);
+			start = rte_rdtsc();
+			result->nb_found += simple_fwd_ft_find_bulk(ft, pinfos_ptr, n, ctxs);
+			result->lookup_cycles += rte_rdtsc() - start;
+		}
+	}
+
+	simple_fwd_ft_destroy(ft);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the benchmark over the packets of a pcap file, per protocol mix
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_pcap_main(const struct bench_config *conf)
+{
+	struct bench_mix mixes[BENCH_MAX_MIXES] = {0};
+	struct bench_pcap_pkts pkts = {0};
+	struct bench_mix_result result;
+	uint64_t nb_lookups;
+	uint32_t nb_mixes = 0, m;
+	double mpps;
+	doca_error_t ret;
+
+	ret = bench_pcap_load(conf->pcap_path, &pkts);
+	if (ret != DOCA_SUCCESS)
+		return ret;
+	ret = bench_mixes_build(&pkts, mixes, &nb_mixes);
+	if (ret != DOCA_SUCCESS)
+		goto free_mixes;
+
+	DOCA_LOG_INFO("%u packets from %s, bursts of %u packets, %u iterations",
+		      pkts.nb_pkts,
+		      conf->pcap_path,
+		      conf->burst_size,
+		      conf->iterations);
+	if (pkts.nb_drops)
+		DOCA_LOG_WARN("%u packets are rejected by the parser and left out", pkts.nb_drops);
+	DOCA_LOG_INFO("%-20s %10s %10s %12s %12s %12s %10s",
+		      "Mix",
+		      "Packets",
+		      "Flows",
+		      "Parse cyc",
+		      "Insert cyc",
+		      "Lookup cyc",
+		      "Mpps");
+
+	for (m = 0; m < nb_mixes; m++) {
+		if (mixes[m].nb_pkts == 0)
+			continue;
+		ret = bench_mix_run(&pkts, &mixes[m], conf, &result);
+		if (ret != DOCA_SUCCESS)
+			goto free_mixes;
+		nb_lookups = (uint64_t)mixes[m].nb_pkts * conf->iterations;
+		if (result.nb_found != nb_lookups)
+			DOCA_LOG_WARN("%s: %lu lookups missed, their flows did not fit in the table or have no key",
+				      mixes[m].name,
+				      nb_lookups - result.nb_found);
+		/* Cycles per packet of each stage, and the rate of parsing and looking up, as the receive path does */
+		mpps = (double)nb_lookups * rte_get_tsc_hz() / (result.parse_cycles + result.lookup_cycles) / 1e6;
+		DOCA_LOG_INFO("%-20s %10u %10lu %12.1f %12.1f %12.1f %10.2f",
+			      mixes[m].name,
+			      mixes[m].nb_pkts,
+			      result.nb_flows,
+			      (double)result.parse_cycles / nb_lookups,
+			      (double)result.insert_cycles / mixes[m].nb_pkts,
+			      (double)result.lookup_cycles / nb_lookups,
+			      mpps);
+	}
+
+free_mixes:
+	for (m = 0; m < BENCH_MAX_MIXES; m++)
+		free(mixes[m].idx);
+	free(pkts.len);
+	free(pkts.data);
+	free(pkts.arena);
+	return ret;
+}
+
+/*
+ * Flow table benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.nb_flows = BENCH_DEFAULT_NB_FLOWS;
+	conf.iterations = BENCH_DEFAULT_ITERATIONS;
+	conf.burst_size = BENCH_DEFAULT_BURST_SIZE;
+
+	/* Parse cmdline/json arguments, the flow table memory comes from the EAL */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	doca_argp_set_dpdk_program(dpdk_init);
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	if (conf.pcap_path[0] != '\0')
+		result = bench_pcap_main(&conf);
+	else
+		result = bench_main(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	dpdk_fini();
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_udp.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <dpdk_utils.h>
+
+#include "app_vnf.h"
+#include "simple_fwd.h"
+#include "simple_fwd_ft.h"
+#include "simple_fwd_vnf_core.h"
+
+DOCA_LOG_REGISTER(SIMPLE_FWD_FWD_BENCH);
+
+#define BENCH_NB_PORTS 2			/* The forwarding pipeline works on a pair of ports */
+#define BENCH_DEFAULT_DURATION 10		/* Default duration of the run in seconds */
+#define BENCH_DEFAULT_NB_FLOWS 1024		/* Default number of flows of the injected packets */
+#define BENCH_DEFAULT_NB_PKTS 512		/* Default number of packets injected per queue of net_ring ports */
+#define BENCH_MAX_FLOWS (1 << 20)		/* Maximal number of flows of the injected packets */
+#define BENCH_INJECT_BURST 32			/* Number of packets injected per TX burst */
+#define BENCH_PKT_LEN 64			/* Length of the injected packets, without the FCS */
+#define BENCH_SRC_IP_BASE RTE_IPV4(10, 0, 0, 0)	/* First IPv4 source address of the flows */
+#define BENCH_DST_IP RTE_IPV4(192, 168, 0, 1)	/* IPv4 destination address of the flows */
+#define BENCH_SRC_PORT 5000			/* UDP source port of the flows */
+#define BENCH_DST_PORT 6000			/* UDP destination port of the flows */
+#define BENCH_RING_DRIVER "net_ring"		/* Driver of the ports the packets are injected to */
+
+/* Benchmark configuration */
+struct bench_config {
+	uint32_t duration; /* Duration of the run in seconds */
+	uint32_t nb_flows; /* Number of flows of the injected packets */
+	uint32_t nb_pkts;  /* Number of packets injected per queue of net_ring ports */
+	bool no_lookup;	   /* Forward without parsing the packets and looking their flows up */
+};
+
+static struct simple_fwd_ft *bench_ft; /* Flow table of the SW only flows */
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t duration_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int duration = *(int *)param;
+
+	if (duration <= 0) {
+		DOCA_LOG_ERR("Duration must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->duration = duration;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of flows parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t nb_flows_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int nb_flows = *(int *)param;
+
+	if (nb_flows <= 0 || nb_flows > BENCH_MAX_FLOWS) {
+		DOCA_LOG_ERR("Number of flows must be between 1 and %d", BENCH_MAX_FLOWS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->nb_flows = nb_flows;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of packets parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t nb_pkts_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int nb_pkts = *(int *)param;
+
+	if (nb_pkts <= 0) {
+		DOCA_LOG_ERR("Number of packets must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->nb_pkts = nb_pkts;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle no lookup parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t no_lookup_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+
+	conf->no_lookup = *(bool *)param;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *duration_param, *nb_flows_param, *nb_pkts_param, *no_lookup_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&duration_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(duration_param, "d");
+	doca_argp_param_set_long_name(duration_param, "duration");
+	doca_argp_param_set_arguments(duration_param, "<sec>");
+	doca_argp_param_set_description(duration_param, "Duration of the run in seconds");
+	doca_argp_param_set_callback(duration_param, duration_callback);
+	doca_argp_param_set_type(duration_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(duration_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&nb_flows_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(nb_flows_param, "n");
+	doca_argp_param_set_long_name(nb_flows_param, "nb-flows");
+	doca_argp_param_set_description(nb_flows_param, "Number of flows of the packets injected to net_ring ports");
+	doca_argp_param_set_callback(nb_flows_param, nb_flows_callback);
+	doca_argp_param_set_type(nb_flows_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(nb_flows_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&nb_pkts_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(nb_pkts_param, "p");
+	doca_argp_param_set_long_name(nb_pkts_param, "nb-pkts");
+	doca_argp_param_set_description(nb_pkts_param, "Number of packets injected per queue of net_ring ports");
+	doca_argp_param_set_callback(nb_pkts_param, nb_pkts_callback);
+	doca_argp_param_set_type(nb_pkts_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(nb_pkts_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&no_lookup_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(no_lookup_param, "x");
+	doca_argp_param_set_long_name(no_lookup_param, "no-lookup");
+	doca_argp_param_set_description(no_lookup_param,
+					"Forward without parsing the packets and looking their flows up");
+	doca_argp_param_set_callback(no_lookup_param, no_lookup_callback);
+	doca_argp_param_set_type(no_lookup_param, DOCA_ARGP_TYPE_BOOLEAN);
+	result = doca_argp_register_param(no_lookup_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Signal handler, ends the run
+ *
+ * @signum [in]: The signal received to handle
+ */
+static void signal_handler(int signum)
+{
+	if (signum == SIGINT || signum == SIGTERM || signum == SIGALRM)
+		simple_fwd_process_pkts_stop();
+}
+
+/*
+ * Aging callback of the flow table, the SW only flows have no HW part to release
+ *
+ * @ctx [in]: user context of the removed entry
+ */
+static void bench_aging_cb(struct simple_fwd_ft_user_ctx *ctx)
+{
+	(void)ctx;
+}
+
+/*
+ * Handle a burst of parsed packets the way the application does for flows that are not offloaded: look the whole
+ * burst up, and add the flows that are not found
+ *
+ * @pinfos [in]: array of packets info as represented in the application
+ * @nb_pkts [in]: number of packets in the array, up to APP_VNF_MAX_BURST_SIZE
+ * @return: 0 on success and negative value otherwise
+ */
+static int bench_process_burst(struct simple_fwd_pkt_info **pinfos, uint16_t nb_pkts)
+{
+	struct simple_fwd_ft_user_ctx *ctxs[APP_VNF_MAX_BURST_SIZE];
+	struct simple_fwd_pipe_entry *entry;
+	uint16_t i;
+
+	if (nb_pkts > APP_VNF_MAX_BURST_SIZE)
+		return -1;
+	simple_fwd_ft_find_bulk(bench_ft, pinfos, nb_pkts, ctxs);
+	for (i = 0; i < nb_pkts; i++) {
+		if (ctxs[i] == NULL && simple_fwd_ft_find(bench_ft, pinfos[i], &ctxs[i]) != DOCA_SUCCESS &&
+		    simple_fwd_ft_add_new(bench_ft, pinfos[i], &ctxs[i]) != DOCA_SUCCESS)
+			continue;
+		entry = (struct simple_fwd_pipe_entry *)&ctxs[i]->data[0];
+		entry->total_pkts++;
+	}
+	return 0;
+}
+
+/*
+ * Handle a single parsed packet
+ *
+ * @pinfo [in]: packet info as represented in the application
+ * @return: 0 on success and negative value otherwise
+ */
+static int bench_process_pkt(struct simple_fwd_pkt_info *pinfo)
+{
+	return bench_process_burst(&pinfo, 1);
+}
+
+/*
+ * Complete the offloads of a burst, the benchmark has none
+ *
+ * @port_id [in]: port identifier
+ * @queue [in]: queue index
+ */
+static void bench_flush(uint32_t port_id, uint16_t queue)
+{
+	(void)port_id;
+	(void)queue;
+}
+
+/*
+ * Dump the application stats, the pipeline dumps the packets rate by itself
+ *
+ * @port_id [in]: port identifier
+ * @return: 0
+ */
+static int bench_dump_stats(uint32_t port_id)
+{
+	(void)port_id;
+	return 0;
+}
+
+/*
+ * Destroy the benchmark flow table
+ *
+ * @return: 0
+ */
+static int bench_destroy(void)
+{
+	simple_fwd_ft_destroy(bench_ft);
+	bench_ft = NULL;
+	return 0;
+}
+
+/* Application hooks of the pipeline, flows are tracked in SW only, without DOCA Flow */
+static struct app_vnf bench_vnf = {
+	.vnf_process_pkt = &bench_process_pkt,
+	.vnf_process_burst = &bench_process_burst,
+	.vnf_flush = &bench_flush,
+	.vnf_dump_stats = &bench_dump_stats,
+	.vnf_destroy = &bench_destroy,
+};
+
+/*
+ * Build an Ethernet/IPv4/UDP packet of a flow
+ *
+ * @m [in]: mbuf to build the packet in
+ * @flow [in]: index of the flow
+ */
+static void bench_pkt_build(struct rte_mbuf *m, uint32_t flow)
+{
+	struct rte_ether_hdr *eth = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+	struct rte_ipv4_hdr *ipv4 = (struct rte_ipv4_hdr *)(eth + 1);
+	struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(ipv4 + 1);
+
+	memset(eth, 0, BENCH_PKT_LEN);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+	ipv4->version_ihl = RTE_IPV4_VHL_DEF;
+	ipv4->total_length = rte_cpu_to_be_16(BENCH_PKT_LEN - sizeof(*eth));
+	ipv4->time_to_live = 64;
+	ipv4->next_proto_id = IPPROTO_UDP;
+	ipv4->src_addr = rte_cpu_to_be_32(BENCH_SRC_IP_BASE + flow);
+	ipv4->dst_addr = rte_cpu_to_be_32(BENCH_DST_IP);
+	udp->src_port = RTE_BE16(BENCH_SRC_PORT);
+	udp->dst_port = RTE_BE16(BENCH_DST_PORT);
+	udp->dgram_len = rte_cpu_to_be_16(BENCH_PKT_LEN - sizeof(*eth) - sizeof(*ipv4));
+	m->data_len = BENCH_PKT_LEN;
+	m->pkt_len = BENCH_PKT_LEN;
+	m->hash.rss = flow;
+}
+
+/*
+ * Inject packets to every queue of the first net_ring port.
+ * A net_ring port receives what it sends on the same queue, so the pipeline, which sends the packets received on one
+ * port to the other, keeps them looping between the two ports for the whole run.
+ *
+ * @conf [in]: benchmark configuration
+ * @dpdk_config [in]: DPDK configuration, holding the mbufs pool
+ * @return: number of injected packets
+ */
+static uint64_t bench_inject(const struct bench_config *conf, struct application_dpdk_config *dpdk_config)
+{
+	struct rte_mbuf *pkts[BENCH_INJECT_BURST];
+	struct rte_eth_dev_info dev_info;
+	uint32_t flow = 0, nb, nb_queued;
+	uint64_t nb_injected = 0;
+	uint16_t queue, i, nb_tx;
+
+	if (rte_eth_dev_info_get(0, &dev_info) != 0 || strcmp(dev_info.driver_name, BENCH_RING_DRIVER) != 0)
+		return 0;
+
+	for (queue = 0; queue < dpdk_config->port_config.nb_queues; queue++) {
+		for (nb_queued = 0; nb_queued < conf->nb_pkts; nb_queued += nb_tx) {
+			nb = RTE_MIN(conf->nb_pkts - nb_queued, (uint32_t)BENCH_INJECT_BURST);
+			if (rte_pktmbuf_alloc_bulk(dpdk_config->mbuf_pool, pkts, nb) != 0) {
+				DOCA_LOG_WARN("Out of mbufs after injecting %lu packets", nb_injected);
+				return nb_injected;
+			}
+			for (i = 0; i < nb; i++) {
+				bench_pkt_build(pkts[i], flow);
+				flow = (flow + 1) % conf->nb_flows;
+			}
+			nb_tx = rte_eth_tx_burst(0, queue, pkts, nb);
+			nb_injected += nb_tx;
+			if (nb_tx < nb) {
+				rte_pktmbuf_free_bulk(&pkts[nb_tx], nb - nb_tx);
+				break;
+			}
+		}
+	}
+	return nb_injected;
+}
+
+/*
+ * Run the forwarding pipeline for the configured duration, and report its packets rate
+ *
+ * @conf [in]: benchmark configuration
+ * @dpdk_config [in]: DPDK configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf, struct application_dpdk_config *dpdk_config)
+{
+	struct simple_fwd_config app_cfg = {
+		.dpdk_cfg = dpdk_config,
+		.hw_offload = !conf->no_lookup,
+		.stats_timer = rte_get_timer_hz(),
+	};
+	struct simple_fwd_process_pkts_params process_pkts_params = {
+		.cfg = &app_cfg,
+		.vnf = &bench_vnf,
+	};
+	struct rte_eth_stats stats;
+	uint64_t nb_injected, start, cycles;
+	uint64_t rx_pkts = 0, tx_pkts = 0, missed = 0;
+	uint16_t port_id;
+
+	bench_ft =
+		simple_fwd_ft_create(conf->nb_flows, sizeof(struct simple_fwd_pipe_entry), &bench_aging_cb, NULL, false);
+	if (bench_ft == NULL) {
+		DOCA_LOG_ERR("Failed to create the flow table");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	nb_injected = bench_inject(conf, dpdk_config);
+	for (port_id = 0; port_id < BENCH_NB_PORTS; port_id++)
+		rte_eth_stats_reset(port_id);
+	DOCA_LOG_INFO("Forwarding on %u queues for %u seconds, %lu packets injected, flow lookup %s",
+		      dpdk_config->port_config.nb_queues,
+		      conf->duration,
+		      nb_injected,
+		      conf->no_lookup ? "off" : "on");
+
+	signal(SIGINT, signal_handler);
+	signal(SIGTERM, signal_handler);
+	signal(SIGALRM, signal_handler);
+	alarm(conf->duration);
+
+	simple_fwd_map_queue(dpdk_config->port_config.nb_queues);
+	start = rte_rdtsc();
+	rte_eal_mp_remote_launch(simple_fwd_process_pkts, &process_pkts_params, CALL_MAIN);
+	rte_eal_mp_wait_lcore();
+	cycles = rte_rdtsc() - start;
+
+	for (port_id = 0; port_id < BENCH_NB_PORTS; port_id++) {
+		if (rte_eth_stats_get(port_id, &stats) != 0)
+			continue;
+		rx_pkts += stats.ipackets;
+		tx_pkts += stats.opackets;
+		missed += stats.imissed + stats.oerrors;
+	}
+	DOCA_LOG_INFO("Received %lu, sent %lu, missed or TX errors %lu packets, %.3f Mpps",
+		      rx_pkts,
+		      tx_pkts,
+		      missed,
+		      (double)rx_pkts * rte_get_timer_hz() / cycles / 1e6);
+
+	simple_fwd_destroy(&bench_vnf);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Forwarding pipeline benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	struct application_dpdk_config dpdk_config = {
+		.port_config.nb_ports = BENCH_NB_PORTS,
+	};
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.duration = BENCH_DEFAULT_DURATION;
+	conf.nb_flows = BENCH_DEFAULT_NB_FLOWS;
+	conf.nb_pkts = BENCH_DEFAULT_NB_PKTS;
+
+	/* Parse cmdline/json arguments */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	doca_argp_set_dpdk_program(dpdk_init);
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	/* A queue per lcore on each of the two ports, the main lcore forwards too */
+	result = dpdk_queues_and_ports_init(&dpdk_config);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to initialize the ports: %s", doca_error_get_descr(result));
+		goto dpdk_destroy;
+	}
+
+	result = bench_main(&conf, &dpdk_config);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	dpdk_queues_and_ports_fini(&dpdk_config);
+dpdk_destroy:
+	dpdk_fini();
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,6 +28,8 @@
 #include <string.h>
 #include <arpa/inet.h>
 
+#include <rte_cycles.h>
+#include <rte_malloc.h>
 #include <rte_random.h>
 
 #include <doca_flow.h>
@@ -71,6 +73,8 @@ DOCA_LOG_REGISTER(SIMPLE_FWD);
 #define GET_FT_ENTRY(ctx) container_of(ctx, struct simple_fwd_ft_entry, user_ctx)
 
 #define PULL_TIME_OUT 10000 /* Maximum timeout for pulling */
+#define SW_FLOW_AGE_SEC (30) /* Idle time in seconds after which a flow tracked in SW only is aged */
+#define STATUS_POOL_CACHE (64) /* Per lcore cache size of the entries status pool */
 #define NB_ACTION_ARRAY (1) /* Used as the size of muti-actions array for DOCA Flow API */
 #define NB_ACTION_DESC (1)  /* Used as the size of muti-action descs array for DOCA Flow API */
 
@@ -79,10 +83,60 @@ static struct simple_fwd_app *simple_fwd_ins; /* Instance holding all allocated
 /* user context struct that will be used in entries process callback */
 struct entries_status {
 	bool failure;	  /* will be set to true if some entry status will not be success */
+	bool pooled;	  /* will be set to true if allocated from the entries status pool of the offloaded flows */
+	uint16_t port_id; /* port identifier the entry was added on */
 	int nb_processed; /* will hold the number of entries that was already processed */
 	void *ft_entry;	  /* pointer to struct simple_fwd_ft_entry */
 };
 
+/*
+ * Release an entries status object to where it was allocated from
+ *
+ * @entry_status [in]: the entries status to release
+ */
+static void simple_fwd_status_free(struct entries_status *entry_status)
+{
+	if (entry_status->pooled)
+		rte_mempool_put(simple_fwd_ins->status_pool, entry_status);
+	else
+		free(entry_status);
+}
+
+/*
+ * Complete the asynchronous offload of a new flow, once its HW entry insertion was processed
+ *
+ * @entry_status [in]: the entries status the flow was submitted with
+ * @pipe_queue [in]: queue identifier
+ * @success [in]: whether or not the insertion succeeded
+ */
+static void simple_fwd_offload_complete(struct entries_status *entry_status, uint16_t pipe_queue, bool success)
+{
+	struct simple_fwd_offload_queue *offload_queue;
+	struct simple_fwd_ft_user_ctx *ctx = (struct simple_fwd_ft_user_ctx *)entry_status->ft_entry;
+	struct simple_fwd_pipe_entry *entry = (struct simple_fwd_pipe_entry *)&ctx->data[0];
+	struct simple_fwd_ft_entry *ft_entry = GET_FT_ENTRY(ctx);
+
+	offload_queue = &simple_fwd_ins->offload_queues[entry_status->port_id][pipe_queue];
+	offload_queue->nb_pending--;
+	if (success) {
+		offload_queue->nb_inserted++;
+		entry->is_hw = true;
+		if (ft_entry->removed) {
+			/* The flow was removed while pending, when its aging callback had no HW entry to remove yet */
+			doca_flow_pipe_remove_entry(entry->pipe_queue, DOCA_FLOW_NO_WAIT, entry->hw_entry);
+			entry->hw_entry = NULL;
+		}
+		simple_fwd_ft_hw_done(simple_fwd_ins->ft, ft_entry);
+		return;
+	}
+	/* The flow keeps going through the SW path until it is seen again as a new flow */
+	offload_queue->nb_failed++;
+	entry->hw_entry = NULL;
+	simple_fwd_ft_destroy_entry(simple_fwd_ins->ft, ft_entry);
+	simple_fwd_ft_hw_done(simple_fwd_ins->ft, ft_entry);
+	simple_fwd_status_free(entry_status);
+}
+
 /*
  * Entry processing callback
  *
@@ -99,8 +153,6 @@ static void simple_fwd_check_for_valid_entry(struct doca_flow_pipe_entry *entry,
 					     void *user_ctx)
 {
 	(void)entry;
-	(void)op;
-	(void)pipe_queue;
 
 	struct simple_fwd_ft_entry *ft_entry;
 	struct entries_status *entry_status = (struct entries_status *)user_ctx;
@@ -112,12 +164,14 @@ static void simple_fwd_check_for_valid_entry(struct doca_flow_pipe_entry *entry,
 	if (op == DOCA_FLOW_ENTRY_OP_AGED) {
 		ft_entry = GET_FT_ENTRY((void *)(entry_status->ft_entry));
 		simple_fwd_ft_destroy_entry(simple_fwd_ins->ft, ft_entry);
-	} else if (op == DOCA_FLOW_ENTRY_OP_ADD)
+	} else if (op == DOCA_FLOW_ENTRY_OP_ADD) {
 		entry_status->nb_processed++;
-	else if (op == DOCA_FLOW_ENTRY_OP_DEL) {
+		if (entry_status->pooled)
+			simple_fwd_offload_complete(entry_status, pipe_queue, status == DOCA_FLOW_ENTRY_STATUS_SUCCESS);
+	} else if (op == DOCA_FLOW_ENTRY_OP_DEL) {
 		entry_status->nb_processed--;
 		if (entry_status->nb_processed == 0)
-			free(entry_status);
+			simple_fwd_status_free(entry_status);
 	}
 }
 
@@ -330,7 +384,9 @@ static int simple_fwd_destroy_ins(void)
 	for (idx = 0; idx < SIMPLE_FWD_PORTS; idx++) {
 		if (simple_fwd_ins->ports[idx])
 			doca_flow_port_stop(simple_fwd_ins->ports[idx]);
+		rte_free(simple_fwd_ins->offload_queues[idx]);
 	}
+	rte_mempool_free(simple_fwd_ins->status_pool);
 	free(simple_fwd_ins);
 	simple_fwd_ins = NULL;
 	return 0;
@@ -374,6 +430,32 @@ static int simple_fwd_create_ins(struct simple_fwd_port_cfg *port_cfg)
 		DOCA_LOG_ERR("Failed to allocate FT");
 		goto fail_init;
 	}
+	/* Entries status objects live as long as their HW entries, which may outlive the flow table entries */
+	simple_fwd_ins->status_pool = rte_mempool_create("simple_fwd_entries_status",
+							 rte_align32pow2(SIMPLE_FWD_MAX_FLOWS) * 2,
+							 sizeof(struct entries_status),
+							 STATUS_POOL_CACHE,
+							 0,
+							 NULL,
+							 NULL,
+							 NULL,
+							 NULL,
+							 rte_socket_id(),
+							 0);
+	if (simple_fwd_ins->status_pool == NULL) {
+		DOCA_LOG_ERR("Failed to allocate entries status pool");
+		goto fail_init;
+	}
+	for (index = 0; index < SIMPLE_FWD_PORTS; index++) {
+		simple_fwd_ins->offload_queues[index] =
+			rte_zmalloc("simple_fwd_offload_queues",
+				    sizeof(struct simple_fwd_offload_queue) * port_cfg->nb_queues,
+				    RTE_CACHE_LINE_SIZE);
+		if (simple_fwd_ins->offload_queues[index] == NULL) {
+			DOCA_LOG_ERR("Failed to allocate offload queues");
+			goto fail_init;
+		}
+	}
 	simple_fwd_ins->nb_queues = port_cfg->nb_queues;
 	for (index = 0; index < SIMPLE_FWD_PORTS; index++)
 		simple_fwd_ins->hairpin_peer[index] = index ^ 1;
@@ -1341,7 +1423,9 @@ static struct doca_flow_pipe *simple_fwd_select_pipe(struct simple_fwd_pkt_info
 }
 
 /*
- * Adds new entry, with respect to the packet info, to the flow table
+ * Submits a new entry, with respect to the packet info, to the HW.
+ * The entry is only pushed to the HW by the next simple_fwd_offload_flush() of the pipe queue, and is completed
+ * asynchronously by the entries process callback.
  *
  * @pinfo [in]: the packet info as represented in the application
  * @user_ctx [in]: user context
@@ -1358,26 +1442,33 @@ static struct doca_flow_pipe_entry *simple_fwd_pipe_add_entry(struct simple_fwd_
 	struct doca_flow_pipe *pipe;
 	struct doca_flow_pipe_entry *entry;
 	struct entries_status *status;
-	int num_of_entries = 1;
+	struct simple_fwd_offload_queue *offload_queue;
 	doca_error_t result;
 
-	status = (struct entries_status *)calloc(1, sizeof(struct entries_status));
-
-	memset(&match, 0, sizeof(match));
-	memset(&actions, 0, sizeof(actions));
+	if (pinfo->pipe_queue >= simple_fwd_ins->nb_queues)
+		return NULL;
 
 	pipe = simple_fwd_select_pipe(pinfo);
 	if (pipe == NULL) {
 		DOCA_LOG_WARN("Failed to select pipe on this packet");
-		free(status);
 		return NULL;
 	}
 
+	if (rte_mempool_get(simple_fwd_ins->status_pool, (void **)&status) != 0) {
+		DOCA_LOG_DBG("No free entries status for a new flow");
+		return NULL;
+	}
+	memset(status, 0, sizeof(*status));
+	status->pooled = true;
+	status->port_id = pinfo->orig_port_id;
+	status->ft_entry = user_ctx;
+
+	memset(&match, 0, sizeof(match));
+	memset(&actions, 0, sizeof(actions));
+
 	actions.meta.pkt_meta = DOCA_HTOBE32(1);
 	actions.action_idx = 0;
 
-	status->ft_entry = user_ctx;
-
 	if (pinfo->tun_type != DOCA_FLOW_TUN_VXLAN) {
 		simple_fwd_build_entry_actions(&actions);
 	}
@@ -1390,32 +1481,34 @@ static struct doca_flow_pipe_entry *simple_fwd_pipe_add_entry(struct simple_fwd_
 					  &actions,
 					  &monitor,
 					  NULL,
-					  DOCA_FLOW_NO_WAIT,
+					  DOCA_FLOW_WAIT_FOR_BATCH,
 					  status,
 					  &entry);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed adding entry to pipe");
-		free(status);
+		simple_fwd_status_free(status);
 		return NULL;
 	}
 
-	result = doca_flow_entries_process(simple_fwd_ins->ports[pinfo->orig_port_id],
-					   pinfo->pipe_queue,
-					   PULL_TIME_OUT,
-					   num_of_entries);
-
-	if (result != DOCA_SUCCESS)
-		goto error;
-
-	if (status->nb_processed != num_of_entries || status->failure)
-		goto error;
+	offload_queue = &simple_fwd_ins->offload_queues[pinfo->orig_port_id][pinfo->pipe_queue];
+	offload_queue->nb_pending++;
+	offload_queue->nb_submitted++;
 
 	*age_sec = monitor.aging_sec;
 	return entry;
+}
 
-error:
-	doca_flow_pipe_remove_entry(pinfo->pipe_queue, DOCA_FLOW_NO_WAIT, entry);
-	return NULL;
+/*
+ * Checks whether or not the flow of the packet can be offloaded to the HW pipes, which match IPv4 headers only
+ *
+ * @pinfo [in]: the packet info as represented in the application
+ * @return: true if the flow can be offloaded and false otherwise
+ */
+static bool simple_fwd_hw_supported(struct simple_fwd_pkt_info *pinfo)
+{
+	if (pinfo->outer.l3_type != IPV4)
+		return false;
+	return pinfo->tun_type == DOCA_FLOW_TUN_NONE || pinfo->inner.l3_type == IPV4;
 }
 
 /*
@@ -1440,14 +1533,25 @@ static int simple_fwd_handle_new_flow(struct simple_fwd_pkt_info *pinfo, struct
 	ft_entry = GET_FT_ENTRY(*ctx);
 	entry = (struct simple_fwd_pipe_entry *)&(*ctx)->data[0];
 	entry->pipe_queue = pinfo->pipe_queue;
+	if (!simple_fwd_hw_supported(pinfo)) {
+		/* No HW pipe matches this flow, it is tracked in the flow table and stays on the SW path */
+		simple_fwd_ft_update_age_sec(ft_entry, SW_FLOW_AGE_SEC);
+		simple_fwd_ft_update_expiration(ft_entry);
+		/* There is no HW aging for it, so it is aged by the timer wheel even without an aging thread */
+		simple_fwd_ft_age_entry(simple_fwd_ins->ft, ft_entry);
+		return 0;
+	}
+	/* The insertion completion accesses the entry, so it must not be aged or released before */
+	simple_fwd_ft_set_hw_pending(ft_entry);
 	entry->hw_entry = simple_fwd_pipe_add_entry(pinfo, (void *)(*ctx), &age_sec);
 	if (entry->hw_entry == NULL) {
+		simple_fwd_ft_hw_done(simple_fwd_ins->ft, ft_entry);
 		simple_fwd_ft_destroy_entry(simple_fwd_ins->ft, ft_entry);
 		return -1;
 	}
+	/* entry->is_hw is set once the insertion completes, the flow stays on the SW path until then */
 	simple_fwd_ft_update_age_sec(ft_entry, age_sec);
 	simple_fwd_ft_update_expiration(ft_entry);
-	entry->is_hw = true;
 
 	return 0;
 }
@@ -1460,7 +1564,7 @@ static int simple_fwd_handle_new_flow(struct simple_fwd_pkt_info *pinfo, struct
  */
 static bool simple_fwd_need_new_ft(struct simple_fwd_pkt_info *pinfo)
 {
-	if (pinfo->outer.l3_type != IPV4) {
+	if (pinfo->outer.l3_type != IPV4 && pinfo->outer.l3_type != IPV6) {
 		DOCA_LOG_WARN("The outer L3 type %u is not supported", pinfo->outer.l3_type);
 		return false;
 	}
@@ -1495,6 +1599,38 @@ static int simple_fwd_handle_packet(struct simple_fwd_pkt_info *pinfo)
 	return 0;
 }
 
+/*
+ * Handles a burst of parsed packets, all the flow table lookups of the burst are done at once
+ *
+ * @pinfos [in]: array of packets info as represented in the application
+ * @nb_pkts [in]: number of packets in the array, up to APP_VNF_MAX_BURST_SIZE
+ * @return: 0 on success and negative value otherwise
+ */
+static int simple_fwd_handle_burst(struct simple_fwd_pkt_info **pinfos, uint16_t nb_pkts)
+{
+	struct simple_fwd_pkt_info *supported[APP_VNF_MAX_BURST_SIZE];
+	struct simple_fwd_ft_user_ctx *ctxs[APP_VNF_MAX_BURST_SIZE];
+	struct simple_fwd_pipe_entry *entry;
+	uint16_t i, nb_supported = 0;
+
+	if (nb_pkts > APP_VNF_MAX_BURST_SIZE)
+		return -1;
+	for (i = 0; i < nb_pkts; i++) {
+		if (simple_fwd_need_new_ft(pinfos[i]))
+			supported[nb_supported++] = pinfos[i];
+	}
+	simple_fwd_ft_find_bulk(simple_fwd_ins->ft, supported, nb_supported, ctxs);
+	for (i = 0; i < nb_supported; i++) {
+		/* Look again before adding, an earlier packet of the burst may have created the flow */
+		if (ctxs[i] == NULL && simple_fwd_ft_find(simple_fwd_ins->ft, supported[i], &ctxs[i]) != DOCA_SUCCESS &&
+		    simple_fwd_handle_new_flow(supported[i], &ctxs[i]))
+			continue;
+		entry = (struct simple_fwd_pipe_entry *)&ctxs[i]->data[0];
+		entry->total_pkts++;
+	}
+	return 0;
+}
+
 /*
  * Handles aged flows
  *
@@ -1510,6 +1646,65 @@ static void simple_fwd_handle_aging(uint32_t port_id, uint16_t queue)
 	doca_flow_aging_handle(simple_fwd_ins->ports[port_id], queue, MAX_HANDLING_TIME_MS, 0);
 }
 
+/*
+ * Pushes the new flows entries submitted during the last burst to the HW, and completes the ones already inserted.
+ * Without an aging thread, it also drives the aging of the flows tracked in SW only.
+ *
+ * @port_id [in]: port identifier of the port to flush
+ * @queue [in]: queue index of the queue to flush
+ */
+static void simple_fwd_offload_flush(uint32_t port_id, uint16_t queue)
+{
+	struct simple_fwd_offload_queue *offload_queue;
+	doca_error_t result;
+
+	if (port_id >= SIMPLE_FWD_PORTS || queue >= simple_fwd_ins->nb_queues)
+		return;
+	/* Without an aging thread, the flows tracked in SW only are aged by the lcores completing their bursts */
+	simple_fwd_ft_aging_poll(simple_fwd_ins->ft);
+	offload_queue = &simple_fwd_ins->offload_queues[port_id][queue];
+	if (offload_queue->nb_pending == 0)
+		return;
+	result = doca_flow_entries_process(simple_fwd_ins->ports[port_id], queue, 0, offload_queue->nb_pending);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_DBG("Failed to process entries: %s", doca_error_get_descr(result));
+}
+
+/*
+ * Dump the HW offload stats of all ports, summed over all pipe queues
+ */
+static void simple_fwd_dump_offload_stats(void)
+{
+	static uint64_t last_inserted, last_tsc;
+	struct simple_fwd_offload_queue *offload_queue;
+	uint64_t submitted = 0, inserted = 0, failed = 0, pending = 0;
+	uint64_t cur_tsc = rte_rdtsc();
+	double rate = 0;
+	uint16_t port_id, queue;
+
+	for (port_id = 0; port_id < SIMPLE_FWD_PORTS; port_id++) {
+		for (queue = 0; queue < simple_fwd_ins->nb_queues; queue++) {
+			offload_queue = &simple_fwd_ins->offload_queues[port_id][queue];
+			submitted += offload_queue->nb_submitted;
+			inserted += offload_queue->nb_inserted;
+			failed += offload_queue->nb_failed;
+			pending += offload_queue->nb_pending;
+		}
+	}
+	if (last_tsc != 0 && cur_tsc > last_tsc)
+		rate = (double)(inserted - last_inserted) * rte_get_timer_hz() / (cur_tsc - last_tsc);
+	last_inserted = inserted;
+	last_tsc = cur_tsc;
+
+	fprintf(stdout, "HW offload: submitted %lu, inserted %lu, failed %lu, pending %lu, rate %.0f flows/sec\n",
+		submitted,
+		inserted,
+		failed,
+		pending,
+		rate);
+	fflush(stdout);
+}
+
 /*
  * Dump stats of the given port identifier
  *
@@ -1518,16 +1713,24 @@ static void simple_fwd_handle_aging(uint32_t port_id, uint16_t queue)
  */
 static int simple_fwd_dump_stats(uint32_t port_id)
 {
-	return simple_fwd_dump_port_stats(port_id, simple_fwd_ins->ports[port_id]);
+	int result;
+
+	result = simple_fwd_dump_port_stats(port_id, simple_fwd_ins->ports[port_id]);
+	if (result != 0)
+		return result;
+	simple_fwd_dump_offload_stats();
+	return 0;
 }
 
 /* Stores all functions pointers used by the application */
 static struct app_vnf simple_fwd_vnf = {
-	.vnf_init = &simple_fwd_init,		      /* Simple Forward initialization resources function pointer */
-	.vnf_process_pkt = &simple_fwd_handle_packet, /* Simple Forward packet processing function pointer */
-	.vnf_flow_age = &simple_fwd_handle_aging,     /* Simple Forward aging handling function pointer */
-	.vnf_dump_stats = &simple_fwd_dump_stats,     /* Simple Forward dumping stats function pointer */
-	.vnf_destroy = &simple_fwd_destroy,	      /* Simple Forward destroy allocated resources function pointer */
+	.vnf_init = &simple_fwd_init,		       /* Simple Forward initialization resources function pointer */
+	.vnf_process_pkt = &simple_fwd_handle_packet,  /* Simple Forward packet processing function pointer */
+	.vnf_process_burst = &simple_fwd_handle_burst, /* Simple Forward burst processing function pointer */
+	.vnf_flow_age = &simple_fwd_handle_aging,      /* Simple Forward aging handling function pointer */
+	.vnf_flush = &simple_fwd_offload_flush,	       /* Simple Forward burst offloads completion function pointer */
+	.vnf_dump_stats = &simple_fwd_dump_stats,      /* Simple Forward dumping stats function pointer */
+	.vnf_destroy = &simple_fwd_destroy,	       /* Simple Forward destroy allocated resources function pointer */
 };
 
 /*
@@ -29,6 +29,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <rte_mempool.h>
+
 #include <doca_flow.h>
 
 #include "simple_fwd_pkt.h"
@@ -37,6 +39,14 @@
 #define SIMPLE_FWD_PORTS (2)	    /* Number of ports used by the application */
 #define SIMPLE_FWD_MAX_FLOWS (8096) /* Maximum number of flows used/added by the application at a given time */
 
+/* Per port and pipe queue state of the asynchronous HW offload of new flows */
+struct simple_fwd_offload_queue {
+	uint32_t nb_pending;   /* Number of entries submitted and not completed yet */
+	uint64_t nb_submitted; /* Total number of entries submitted for insertion */
+	uint64_t nb_inserted;  /* Total number of entries inserted successfully */
+	uint64_t nb_failed;    /* Total number of entries failed to be inserted */
+} __rte_cache_aligned;
+
 /* Application resources, such as flow table, pipes and hairpin peers */
 struct simple_fwd_app {
 	struct simple_fwd_ft *ft;			       /* Flow table, used for stprng flows */
@@ -49,7 +59,9 @@ struct simple_fwd_app {
 	struct doca_flow_pipe *pipe_hairpin[SIMPLE_FWD_PORTS]; /* hairpin pipe for non-VxLAN/GRE/GTP traffic */
 	struct doca_flow_pipe *pipe_rss[SIMPLE_FWD_PORTS];     /* RSS pipe, matches every packet and forwards to SW */
 	struct doca_flow_pipe *vxlan_encap_pipe[SIMPLE_FWD_PORTS]; /* vxlan encap pipe on the egress domain */
-	uint16_t nb_queues;					   /* flow age query item buffer */
+	struct simple_fwd_offload_queue *offload_queues[SIMPLE_FWD_PORTS]; /* Offload state of each pipe queue */
+	struct rte_mempool *status_pool; /* Preallocated entries status objects of the offloaded flows */
+	uint16_t nb_queues;		 /* flow age query item buffer */
 	struct doca_flow_aged_query *query_array[0];		   /* buffer for flow aged query items */
 };
 
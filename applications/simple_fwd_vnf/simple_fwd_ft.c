@@ -27,6 +27,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <rte_errno.h>
+#include <rte_hash_crc.h>
+#include <rte_malloc.h>
+#include <rte_mempool.h>
+#include <rte_prefetch.h>
+#include <rte_ring.h>
+
 #include <doca_flow.h>
 #include <doca_log.h>
 
@@ -35,11 +42,23 @@
 
 DOCA_LOG_REGISTER(SIMPLE_FWD_FT);
 
-/* Bucket is a struct encomassing the list and the synchronization mechanism used for accessing the flows list */
+#define SIMPLE_FWD_FT_BUCKET_ENTRIES (6)  /* Number of entries referenced by a single cache line bucket */
+#define SIMPLE_FWD_FT_BULK_MAX (64)	  /* Maximum number of packets handled by a single bulk lookup */
+#define SIMPLE_FWD_FT_POOL_CACHE (256)	  /* Per lcore cache size of the entries pool */
+#define SIMPLE_FWD_FT_ALT_MULT (0x5bd1e995) /* Multiplier used to spread the signature for the alternative bucket */
+#define SIMPLE_FWD_FT_WHEEL_SLOTS (64)	    /* Number of slots of the aging timer wheel */
+#define SIMPLE_FWD_FT_WHEEL_TICK_SEC (1)    /* Duration of a single aging timer wheel slot in seconds */
+#define SIMPLE_FWD_FT_AGING_BATCH (64)	    /* Number of entries handled together by the aging thread */
+
+/*
+ * Bucket holds the signatures of its entries inline, so that a lookup touches a single cache line until a
+ * signature matches. A zero signature marks a free slot.
+ */
 struct simple_fwd_ft_bucket {
-	struct simple_fwd_ft_entry_head head; /* The head of the list of the flows */
-	rte_spinlock_t lock;		      /* Lock, a synchronization mechanism */
-};
+	rte_spinlock_t lock;						   /* Lock, serializes the bucket writers */
+	uint16_t sig[SIMPLE_FWD_FT_BUCKET_ENTRIES];			   /* Signatures of the entries in the bucket */
+	struct simple_fwd_ft_entry *entries[SIMPLE_FWD_FT_BUCKET_ENTRIES]; /* Entries of the bucket */
+} __rte_cache_aligned;
 
 /* Stats for the flow table */
 struct simple_fwd_ft_stats {
@@ -51,11 +70,22 @@ struct simple_fwd_ft_stats {
 /* Flow table configuration */
 struct simple_fwd_ft_cfg {
 	uint32_t size;		 /* Number of maximum flows in a given time while the application is running */
-	uint32_t mask;		 /* Masking; */
+	uint32_t nb_buckets;	 /* Number of buckets in the flow table */
+	uint32_t mask;		 /* Masking of the buckets index */
 	uint32_t user_data_size; /* User data size needed for allocation */
 	uint32_t entry_size;	 /* Size needed for storing a single entry flow */
 };
 
+/*
+ * Aging timer wheel, every slot holds the entries due in one tick.
+ * The wheel is only accessed by the aging thread, or without one by the lcore holding the wheel lock, other threads
+ * hand new entries over to it through a ring.
+ */
+struct simple_fwd_ft_wheel {
+	struct simple_fwd_ft_entry *slots[SIMPLE_FWD_FT_WHEEL_SLOTS]; /* Lists of the entries due in each tick */
+	uint64_t cur_tick;					      /* Current tick of the wheel */
+};
+
 /* Flow table as represented in the application */
 struct simple_fwd_ft {
 	struct simple_fwd_ft_cfg cfg;	  /* Flow table configurations */
@@ -67,7 +97,12 @@ struct simple_fwd_ft {
 	void (*simple_fwd_aging_cb)(struct simple_fwd_ft_user_ctx *ctx); /* Callback holder; callback for handling aged
 									    flows */
 	void (*simple_fwd_aging_hw_cb)(void);	/* HW callback holder; callback for handling aged flows*/
-	struct simple_fwd_ft_bucket buckets[0]; /* Pointer for the Bucket in the flow table; list of entries */
+	struct rte_mempool *entries_pool;	/* Preallocated entries, with a free list cached per lcore */
+	struct simple_fwd_ft_bucket *buckets;	/* Buckets of the flow table */
+	struct rte_ring *wheel_ring;		/* New entries handed over to the aging timer wheel */
+	struct simple_fwd_ft_wheel wheel;	/* Aging timer wheel, owned by the aging thread */
+	rte_spinlock_t wheel_lock;		/* Serializes the lcores driving the wheel without an aging thread */
+	volatile uint64_t next_tick_tsc;	/* TSC of the next wheel tick when there is no aging thread */
 };
 
 void simple_fwd_ft_update_age_sec(struct simple_fwd_ft_entry *e, uint32_t age_sec)
@@ -81,6 +116,22 @@ void simple_fwd_ft_update_expiration(struct simple_fwd_ft_entry *e)
 		e->expiration = rte_rdtsc() + rte_get_timer_hz() * e->age_sec;
 }
 
+void simple_fwd_ft_set_hw_pending(struct simple_fwd_ft_entry *e)
+{
+	e->hw_pending = true;
+}
+
+void simple_fwd_ft_hw_done(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *e)
+{
+	bool release = e->removed && !e->on_wheel;
+
+	/* An entry on the aging timer wheel is released by the wheel once it sees it is no longer pending */
+	rte_smp_wmb();
+	e->hw_pending = false;
+	if (release)
+		rte_mempool_put(ft->entries_pool, e);
+}
+
 /*
  * Update a counter of a given entry
  *
@@ -93,6 +144,9 @@ static bool simple_fwd_ft_update_counter(struct simple_fwd_ft_entry *e)
 	struct doca_flow_resource_query query_stats = {0};
 	bool update = 0;
 
+	/* SW only flows have no HW counter, they age by their expiration time only */
+	if (!entry->is_hw)
+		return false;
 	if (doca_flow_resource_query_entry(entry->hw_entry, &query_stats) == DOCA_SUCCESS) {
 		update = !!(query_stats.counter.total_pkts - e->last_counter);
 		e->last_counter = query_stats.counter.total_pkts;
@@ -101,56 +155,197 @@ static bool simple_fwd_ft_update_counter(struct simple_fwd_ft_entry *e)
 }
 
 /*
- * Destroy flow entry in the flow table
+ * Hash a flow table key
+ *
+ * @key [in]: the key to hash
+ * @return: hash value of the key
+ */
+static inline uint32_t simple_fwd_ft_key_hash(const struct simple_fwd_ft_key *key)
+{
+	return rte_hash_crc(key, sizeof(*key), 0);
+}
+
+/*
+ * Extract the bucket signature out of a key hash
+ *
+ * @hash [in]: hash value of the key
+ * @return: non zero signature of the key
+ */
+static inline uint16_t simple_fwd_ft_hash_sig(uint32_t hash)
+{
+	uint16_t sig = hash >> 16;
+
+	return sig ? sig : 1;
+}
+
+/*
+ * Get the alternative bucket of a key, this is symmetric so it also gives back the primary bucket
+ *
+ * @ft [in]: the flow table
+ * @idx [in]: bucket index of the key
+ * @sig [in]: signature of the key
+ * @return: the other bucket index the key may be stored in
+ */
+static inline uint32_t simple_fwd_ft_alt_bucket(struct simple_fwd_ft *ft, uint32_t idx, uint16_t sig)
+{
+	return (idx ^ ((uint32_t)sig * SIMPLE_FWD_FT_ALT_MULT)) & ft->cfg.mask;
+}
+
+/*
+ * Unlink flow entry from the flow table, the bucket lock should be held by the caller.
+ * The memory of an entry handed over to the aging timer wheel is owned by the wheel, and is only released once the
+ * wheel reaches the entry.
  *
  * @ft [in]: the flow table to remove the entry from
  * @ft_entry [in]: entry flow to remove, as represented in the application
  */
-static void _ft_destroy_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *ft_entry)
+static void _ft_unlink_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *ft_entry)
 {
-	LIST_REMOVE(ft_entry, next);
+	struct simple_fwd_ft_bucket *bucket = &ft->buckets[ft_entry->buckets_index];
+
+	bucket->sig[ft_entry->slot_index] = 0;
+	rte_smp_wmb();
+	bucket->entries[ft_entry->slot_index] = NULL;
+	ft_entry->removed = true;
 	ft->simple_fwd_aging_cb(&ft_entry->user_ctx);
-	free(ft_entry);
 	ft->stats.rm++;
 }
 
 void simple_fwd_ft_destroy_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *ft_entry)
 {
-	int idx = ft_entry->buckets_index;
+	uint32_t idx = ft_entry->buckets_index;
+	bool unlinked = false;
 
 	rte_spinlock_lock(&ft->buckets[idx].lock);
-	_ft_destroy_entry(ft, ft_entry);
+	if (!ft_entry->removed) {
+		_ft_unlink_entry(ft, ft_entry);
+		unlinked = true;
+	}
 	rte_spinlock_unlock(&ft->buckets[idx].lock);
+	/* A pending entry is released once its HW insertion completes */
+	if (unlinked && !ft_entry->on_wheel && !ft_entry->hw_pending)
+		rte_mempool_put(ft->entries_pool, ft_entry);
+}
+
+/*
+ * Schedule an entry on the aging timer wheel, only the owner of the wheel may call it.
+ * Entries due beyond the wheel horizon are scheduled on its last slot, and rescheduled from there.
+ *
+ * @ft [in]: the flow table
+ * @e [in]: the entry to schedule
+ * @ticks [in]: number of ticks from the current one in which the entry is due
+ */
+static void simple_fwd_ft_wheel_schedule(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *e, uint64_t ticks)
+{
+	uint32_t slot;
+
+	ticks = RTE_MAX(RTE_MIN(ticks, (uint64_t)SIMPLE_FWD_FT_WHEEL_SLOTS - 1), 1UL);
+	slot = (ft->wheel.cur_tick + ticks) % SIMPLE_FWD_FT_WHEEL_SLOTS;
+	e->wheel_next = ft->wheel.slots[slot];
+	ft->wheel.slots[slot] = e;
+}
+
+/*
+ * Get the number of aging ticks until an entry expires
+ *
+ * @e [in]: the entry
+ * @now [in]: current TSC
+ * @return: number of ticks until expiration, 0 if the entry is already expired
+ */
+static uint64_t simple_fwd_ft_ticks_to_expire(struct simple_fwd_ft_entry *e, uint64_t now)
+{
+	if (e->expiration <= now)
+		return 0;
+	return (e->expiration - now) / rte_get_timer_hz() + 1;
 }
 
 /*
- * Start aging handling for a given flow table
+ * Handle the entries due in the current tick of the aging timer wheel.
+ * Only these entries are visited: entries that were refreshed since scheduled are rescheduled to their current
+ * expiration, and the HW counters of the expired ones are queried together before removing the idle flows.
  *
- * @ft [in]: the flow table to start the aging handling for
- * @i [in]: the index of the bucket
- * @return: true on success, false when aging handler still not finished all flows in the table
+ * @ft [in]: the flow table to handle the aging for
  */
-static bool simple_fwd_ft_aging_ft_entry(struct simple_fwd_ft *ft, unsigned int i)
+static void simple_fwd_ft_aging_tick(struct simple_fwd_ft *ft)
 {
-	struct simple_fwd_ft_entry *node, *ptr;
-	bool still_aging = false;
-	uint64_t t = rte_rdtsc();
-
-	if (rte_spinlock_trylock(&ft->buckets[i].lock)) {
-		node = LIST_FIRST(&ft->buckets[i].head);
-		while (node) {
-			ptr = LIST_NEXT(node, next);
-			if (node->age_sec && node->expiration < t && !simple_fwd_ft_update_counter(node)) {
+	struct simple_fwd_ft_entry *node, *next, *due[SIMPLE_FWD_FT_AGING_BATCH];
+	uint32_t slot = ft->wheel.cur_tick % SIMPLE_FWD_FT_WHEEL_SLOTS;
+	uint32_t nb_due, nb_visited = 0, nb_aged = 0;
+	uint64_t now = rte_rdtsc();
+	uint64_t ticks;
+	bool unlinked;
+	uint32_t i, idx;
+
+	node = ft->wheel.slots[slot];
+	ft->wheel.slots[slot] = NULL;
+	while (node != NULL) {
+		/* Collect a batch of expired entries, rescheduling the others */
+		nb_due = 0;
+		while (node != NULL && nb_due < SIMPLE_FWD_FT_AGING_BATCH) {
+			next = node->wheel_next;
+			if (next != NULL)
+				rte_prefetch0(next);
+			nb_visited++;
+			if (node->hw_pending) {
+				/* The HW insertion completion may still access the entry, check it again next tick */
+				simple_fwd_ft_wheel_schedule(ft, node, 1);
+			} else if (node->removed) {
+				rte_mempool_put(ft->entries_pool, node);
+			} else if (node->age_sec == 0) {
+				simple_fwd_ft_wheel_schedule(ft, node, SIMPLE_FWD_FT_WHEEL_SLOTS - 1);
+			} else {
+				ticks = simple_fwd_ft_ticks_to_expire(node, now);
+				if (ticks)
+					simple_fwd_ft_wheel_schedule(ft, node, ticks);
+				else
+					due[nb_due++] = node;
+			}
+			node = next;
+		}
+
+		/* Query the HW counters of the batch, removing the flows that did not match any packet */
+		for (i = 0; i < nb_due; i++) {
+			if (i + 1 < nb_due)
+				rte_prefetch0(due[i + 1]);
+			idx = due[i]->buckets_index;
+			unlinked = false;
+			rte_spinlock_lock(&ft->buckets[idx].lock);
+			if (!due[i]->removed && !simple_fwd_ft_update_counter(due[i])) {
 				DOCA_LOG_DBG("Aging removing flow");
-				_ft_destroy_entry(ft, node);
-				still_aging = true;
-				break;
+				_ft_unlink_entry(ft, due[i]);
+				unlinked = true;
+			}
+			rte_spinlock_unlock(&ft->buckets[idx].lock);
+			if (unlinked || due[i]->removed) {
+				rte_mempool_put(ft->entries_pool, due[i]);
+				nb_aged++;
+				continue;
 			}
-			node = ptr;
+			simple_fwd_ft_update_expiration(due[i]);
+			simple_fwd_ft_wheel_schedule(ft, due[i], due[i]->age_sec);
 		}
-		rte_spinlock_unlock(&ft->buckets[i].lock);
 	}
-	return still_aging;
+	ft->wheel.cur_tick++;
+	if (nb_visited)
+		DOCA_LOG_DBG("Aging tick: visited %u entries, aged %u", nb_visited, nb_aged);
+}
+
+/*
+ * Take ownership of the entries handed over to the aging timer wheel since the previous tick, they are checked in the
+ * next one
+ *
+ * @ft [in]: the flow table
+ */
+static void simple_fwd_ft_wheel_collect(struct simple_fwd_ft *ft)
+{
+	struct simple_fwd_ft_entry *new_entries[SIMPLE_FWD_FT_AGING_BATCH];
+	unsigned int i, nb_new;
+
+	do {
+		nb_new = rte_ring_dequeue_burst(ft->wheel_ring, (void **)new_entries, SIMPLE_FWD_FT_AGING_BATCH, NULL);
+		for (i = 0; i < nb_new; i++)
+			simple_fwd_ft_wheel_schedule(ft, new_entries[i], 1);
+	} while (nb_new == SIMPLE_FWD_FT_AGING_BATCH);
 }
 
 /*
@@ -162,24 +357,15 @@ static bool simple_fwd_ft_aging_ft_entry(struct simple_fwd_ft *ft, unsigned int
 static void *simple_fwd_ft_aging_main(void *void_ptr)
 {
 	struct simple_fwd_ft *ft = (struct simple_fwd_ft *)void_ptr;
-	bool next = false;
-	unsigned int i;
 
 	if (!ft) {
 		DOCA_LOG_ERR("No ft, abort aging");
 		return NULL;
 	}
 	while (!ft->stop_aging_thread) {
-		if ((int)(ft->stats.add - ft->stats.rm) == 0)
-			continue;
-		DOCA_LOG_DBG("Total entries: %d", (int)(ft->stats.add - ft->stats.rm));
-		DOCA_LOG_DBG("Total adds   : %d", (int)(ft->stats.add));
-		for (i = 0; i < ft->cfg.size; i++) {
-			do {
-				next = simple_fwd_ft_aging_ft_entry(ft, i);
-			} while (next);
-		}
-		sleep(1);
+		simple_fwd_ft_wheel_collect(ft);
+		simple_fwd_ft_aging_tick(ft);
+		sleep(SIMPLE_FWD_FT_WHEEL_TICK_SEC);
 	}
 	return NULL;
 }
@@ -204,29 +390,59 @@ static int simple_fwd_ft_aging_thread_start(struct simple_fwd_ft *ft, pthread_t
 	return 0;
 }
 
+void simple_fwd_ft_aging_poll(struct simple_fwd_ft *ft)
+{
+	uint64_t now;
+
+	if (ft->has_age_thread)
+		return;
+	now = rte_rdtsc();
+	if (now < ft->next_tick_tsc || !rte_spinlock_trylock(&ft->wheel_lock))
+		return;
+	/* Another lcore may have handled the tick since checked */
+	if (now >= ft->next_tick_tsc) {
+		ft->next_tick_tsc = now + rte_get_timer_hz() * SIMPLE_FWD_FT_WHEEL_TICK_SEC;
+		simple_fwd_ft_wheel_collect(ft);
+		simple_fwd_ft_aging_tick(ft);
+	}
+	rte_spinlock_unlock(&ft->wheel_lock);
+}
+
 /*
  * Build table key according to parsed packet.
  *
  * @pinfo [in]: the packet's info
  * @key [out]: the generated key
+ * @ipv6 [out]: the full IPv6 addresses of the key, filled for IPv6 keys only
  * @return: 0 on success and negative value otherwise
  */
-static int simple_fwd_ft_key_fill(struct simple_fwd_pkt_info *pinfo, struct simple_fwd_ft_key *key)
+static int simple_fwd_ft_key_fill(struct simple_fwd_pkt_info *pinfo,
+				  struct simple_fwd_ft_key *key,
+				  struct simple_fwd_ft_key_ipv6 *ipv6)
 {
 	bool inner = false;
 
 	if (pinfo->tun_type != DOCA_FLOW_TUN_NONE)
 		inner = true;
 
-	/* support ipv6 */
-	if (pinfo->outer.l3_type != IPV4)
-		return -1;
-
+	key->l3_type = inner ? pinfo->inner.l3_type : pinfo->outer.l3_type;
 	key->rss_hash = pinfo->rss_hash;
 	/* 5-tuple of inner if there is tunnel or outer if none */
 	key->protocol = inner ? pinfo->inner.l4_type : pinfo->outer.l4_type;
-	key->ipv4_1 = simple_fwd_ft_key_get_ipv4_src(inner, pinfo);
-	key->ipv4_2 = simple_fwd_ft_key_get_ipv4_dst(inner, pinfo);
+	switch (key->l3_type) {
+	case IPV4:
+		key->ipv4_1 = simple_fwd_ft_key_get_ipv4_src(inner, pinfo);
+		key->ipv4_2 = simple_fwd_ft_key_get_ipv4_dst(inner, pinfo);
+		break;
+	case IPV6:
+		memcpy(ipv6->ipv6_1, simple_fwd_ft_key_get_ipv6_src(inner, pinfo), sizeof(ipv6->ipv6_1));
+		memcpy(ipv6->ipv6_2, simple_fwd_ft_key_get_ipv6_dst(inner, pinfo), sizeof(ipv6->ipv6_2));
+		key->ipv6_hash_1 = rte_hash_crc(ipv6->ipv6_1, sizeof(ipv6->ipv6_1), 0);
+		key->ipv6_hash_2 = rte_hash_crc(ipv6->ipv6_2, sizeof(ipv6->ipv6_2), 0);
+		break;
+	default:
+		return -1;
+	}
 	key->port_1 = simple_fwd_ft_key_get_src_port(inner, pinfo);
 	key->port_2 = simple_fwd_ft_key_get_dst_port(inner, pinfo);
 	key->port_id = pinfo->orig_port_id;
@@ -250,17 +466,23 @@ static int simple_fwd_ft_key_fill(struct simple_fwd_pkt_info *pinfo, struct simp
 }
 
 /*
- * Compare keys
+ * Compare the key of an entry to a given key
  *
- * @key1 [in]: first key for comparison
- * @key2 [in]: first key for comparison
+ * @e [in]: the entry to compare its key
+ * @key [in]: the key for comparison
+ * @ipv6 [in]: the full IPv6 addresses of the key for comparison
  * @return: true if keys are equal, false otherwise
  */
-static bool simple_fwd_ft_key_equal(struct simple_fwd_ft_key *key1, struct simple_fwd_ft_key *key2)
+static bool simple_fwd_ft_key_equal(struct simple_fwd_ft_entry *e,
+				    struct simple_fwd_ft_key *key,
+				    struct simple_fwd_ft_key_ipv6 *ipv6)
 {
-	return (memcmp(key1, key2, sizeof(struct simple_fwd_ft_key)) == 0);
+	if (memcmp(&e->key, key, sizeof(struct simple_fwd_ft_key)) != 0)
+		return false;
+	return key->l3_type != IPV6 || memcmp(&e->ipv6, ipv6, sizeof(struct simple_fwd_ft_key_ipv6)) == 0;
 }
 
+
 struct simple_fwd_ft *simple_fwd_ft_create(int nb_flows,
 					   uint32_t user_data_size,
 					   void (*simple_fwd_aging_cb)(struct simple_fwd_ft_user_ctx *ctx),
@@ -269,7 +491,8 @@ struct simple_fwd_ft *simple_fwd_ft_create(int nb_flows,
 {
 	struct simple_fwd_ft *ft;
 	uint32_t nb_flows_aligned;
-	uint32_t alloc_size;
+	uint32_t nb_buckets;
+	uint32_t cache_size;
 	uint32_t i;
 
 	if (nb_flows <= 0)
@@ -279,12 +502,13 @@ struct simple_fwd_ft *simple_fwd_ft_create(int nb_flows,
 		nb_flows_aligned = rte_align32pow2(nb_flows);
 	else
 		nb_flows_aligned = nb_flows;
-	/* double the flows to avoid collisions */
-	nb_flows_aligned <<= 1;
-	alloc_size = sizeof(struct simple_fwd_ft) + sizeof(struct simple_fwd_ft_bucket) * nb_flows_aligned;
-	DOCA_LOG_TRC("Malloc size =%d", alloc_size);
+	/*
+	 * Half as many buckets as flows gives three slots per flow, so the buckets are a third full on average when the
+	 * table is full. Entries are never displaced, a key whose two buckets are both full fails to insert.
+	 */
+	nb_buckets = RTE_MAX(nb_flows_aligned / 2, 1U);
 
-	ft = calloc(1, alloc_size);
+	ft = calloc(1, sizeof(struct simple_fwd_ft));
 	if (ft == NULL) {
 		DOCA_LOG_ERR("No memory");
 		return NULL;
@@ -292,47 +516,127 @@ struct simple_fwd_ft *simple_fwd_ft_create(int nb_flows,
 	ft->cfg.entry_size = sizeof(struct simple_fwd_ft_entry) + user_data_size;
 	ft->cfg.user_data_size = user_data_size;
 	ft->cfg.size = nb_flows_aligned;
-	ft->cfg.mask = nb_flows_aligned - 1;
+	ft->cfg.nb_buckets = nb_buckets;
+	ft->cfg.mask = nb_buckets - 1;
 	ft->simple_fwd_aging_cb = simple_fwd_aging_cb;
 	ft->simple_fwd_aging_hw_cb = simple_fwd_aging_hw_cb;
 
-	DOCA_LOG_TRC("FT created: flows=%d, user_data_size=%d", nb_flows_aligned, user_data_size);
-	for (i = 0; i < ft->cfg.size; i++)
+	ft->buckets = rte_zmalloc("simple_fwd_ft_buckets",
+				  sizeof(struct simple_fwd_ft_bucket) * nb_buckets,
+				  RTE_CACHE_LINE_SIZE);
+	if (ft->buckets == NULL) {
+		DOCA_LOG_ERR("Failed to allocate flow table buckets");
+		goto free_ft;
+	}
+
+	cache_size = RTE_MIN((uint32_t)SIMPLE_FWD_FT_POOL_CACHE, nb_flows_aligned / 4);
+	ft->entries_pool = rte_mempool_create("simple_fwd_ft_entries",
+					      nb_flows_aligned,
+					      ft->cfg.entry_size,
+					      cache_size,
+					      0,
+					      NULL,
+					      NULL,
+					      NULL,
+					      NULL,
+					      rte_socket_id(),
+					      0);
+	if (ft->entries_pool == NULL) {
+		DOCA_LOG_ERR("Failed to allocate flow table entries pool: %s", rte_strerror(rte_errno));
+		goto free_buckets;
+	}
+	ft->stats.memuse = sizeof(struct simple_fwd_ft_bucket) * nb_buckets +
+			   (uint64_t)(ft->entries_pool->header_size + ft->entries_pool->elt_size +
+				      ft->entries_pool->trailer_size) *
+				   nb_flows_aligned;
+
+	DOCA_LOG_TRC("FT created: flows=%u, buckets=%u, user_data_size=%u, memory=%lu",
+		     nb_flows_aligned,
+		     nb_buckets,
+		     user_data_size,
+		     ft->stats.memuse);
+	for (i = 0; i < nb_buckets; i++)
 		rte_spinlock_init(&ft->buckets[i].lock);
-	if (age_thread && simple_fwd_ft_aging_thread_start(ft, &ft->age_thread) < 0) {
-		free(ft);
-		return NULL;
+	/* Every entry is handed over at most once, so the ring never overflows */
+	ft->wheel_ring = rte_ring_create("simple_fwd_ft_wheel",
+					 nb_flows_aligned,
+					 rte_socket_id(),
+					 RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (ft->wheel_ring == NULL) {
+		DOCA_LOG_ERR("Failed to allocate aging ring: %s", rte_strerror(rte_errno));
+		goto free_pool;
 	}
+	rte_spinlock_init(&ft->wheel_lock);
+	if (age_thread && simple_fwd_ft_aging_thread_start(ft, &ft->age_thread) < 0)
+		goto free_ring;
 	ft->has_age_thread = age_thread;
 	return ft;
+
+free_ring:
+	rte_ring_free(ft->wheel_ring);
+free_pool:
+	rte_mempool_free(ft->entries_pool);
+free_buckets:
+	rte_free(ft->buckets);
+free_ft:
+	free(ft);
+	return NULL;
 }
 
 /*
- * find if there is an existing entry matching the given packet generated key
+ * Find the entry matching a key inside a given bucket
  *
- * @ft [in]: flow table to search in
+ * @bucket [in]: bucket to search in
+ * @sig [in]: signature of the key
  * @key [in]: the packet generated key used for search in the flow table
+ * @ipv6 [in]: the full IPv6 addresses of the key
  * @return: pointer to the flow entry if found, NULL otherwise
  */
-static struct simple_fwd_ft_entry *_simple_fwd_ft_find(struct simple_fwd_ft *ft, struct simple_fwd_ft_key *key)
+static inline struct simple_fwd_ft_entry *simple_fwd_ft_bucket_find(struct simple_fwd_ft_bucket *bucket,
+								   uint16_t sig,
+								   struct simple_fwd_ft_key *key,
+								   struct simple_fwd_ft_key_ipv6 *ipv6)
 {
-	uint32_t idx;
-	struct simple_fwd_ft_entry_head *first;
 	struct simple_fwd_ft_entry *node;
+	int slot;
 
-	idx = key->rss_hash & ft->cfg.mask;
-	DOCA_LOG_TRC("Looking for index %d", idx);
-	first = &ft->buckets[idx].head;
-	LIST_FOREACH(node, first, next)
-	{
-		if (simple_fwd_ft_key_equal(&node->key, key)) {
-			simple_fwd_ft_update_expiration(node);
+	for (slot = 0; slot < SIMPLE_FWD_FT_BUCKET_ENTRIES; slot++) {
+		if (bucket->sig[slot] != sig)
+			continue;
+		node = bucket->entries[slot];
+		if (node != NULL && simple_fwd_ft_key_equal(node, key, ipv6))
 			return node;
-		}
 	}
 	return NULL;
 }
 
+/*
+ * find if there is an existing entry matching the given packet generated key
+ *
+ * @ft [in]: flow table to search in
+ * @key [in]: the packet generated key used for search in the flow table
+ * @ipv6 [in]: the full IPv6 addresses of the key
+ * @hash [in]: hash value of the key
+ * @return: pointer to the flow entry if found, NULL otherwise
+ */
+static struct simple_fwd_ft_entry *_simple_fwd_ft_find(struct simple_fwd_ft *ft,
+						       struct simple_fwd_ft_key *key,
+						       struct simple_fwd_ft_key_ipv6 *ipv6,
+						       uint32_t hash)
+{
+	uint16_t sig = simple_fwd_ft_hash_sig(hash);
+	uint32_t idx = hash & ft->cfg.mask;
+	struct simple_fwd_ft_entry *node;
+
+	DOCA_LOG_TRC("Looking for index %u", idx);
+	node = simple_fwd_ft_bucket_find(&ft->buckets[idx], sig, key, ipv6);
+	if (node == NULL)
+		node = simple_fwd_ft_bucket_find(&ft->buckets[simple_fwd_ft_alt_bucket(ft, idx, sig)], sig, key, ipv6);
+	if (node != NULL)
+		simple_fwd_ft_update_expiration(node);
+	return node;
+}
+
 doca_error_t simple_fwd_ft_find(struct simple_fwd_ft *ft,
 				struct simple_fwd_pkt_info *pinfo,
 				struct simple_fwd_ft_user_ctx **ctx)
@@ -340,14 +644,15 @@ doca_error_t simple_fwd_ft_find(struct simple_fwd_ft *ft,
 	doca_error_t result = DOCA_SUCCESS;
 	struct simple_fwd_ft_entry *fe;
 	struct simple_fwd_ft_key key = {0};
+	struct simple_fwd_ft_key_ipv6 ipv6;
 
-	if (simple_fwd_ft_key_fill(pinfo, &key)) {
+	if (simple_fwd_ft_key_fill(pinfo, &key, &ipv6)) {
 		result = DOCA_ERROR_UNEXPECTED;
 		DOCA_LOG_DBG("Failed to build key for entry in the flow table %s", doca_error_get_descr(result));
 		return result;
 	}
 
-	fe = _simple_fwd_ft_find(ft, &key);
+	fe = _simple_fwd_ft_find(ft, &key, &ipv6, simple_fwd_ft_key_hash(&key));
 	if (fe == NULL) {
 		result = DOCA_ERROR_NOT_FOUND;
 		DOCA_LOG_DBG("Entry not found in flow table %s", doca_error_get_descr(result));
@@ -358,53 +663,162 @@ doca_error_t simple_fwd_ft_find(struct simple_fwd_ft *ft,
 	return DOCA_SUCCESS;
 }
 
+uint16_t simple_fwd_ft_find_bulk(struct simple_fwd_ft *ft,
+				 struct simple_fwd_pkt_info **pinfos,
+				 uint16_t nb_pkts,
+				 struct simple_fwd_ft_user_ctx **ctxs)
+{
+	struct simple_fwd_ft_key keys[SIMPLE_FWD_FT_BULK_MAX];
+	struct simple_fwd_ft_key_ipv6 ipv6s[SIMPLE_FWD_FT_BULK_MAX];
+	uint32_t hashes[SIMPLE_FWD_FT_BULK_MAX];
+	bool valid[SIMPLE_FWD_FT_BULK_MAX];
+	struct simple_fwd_ft_bucket *bucket;
+	struct simple_fwd_ft_entry *node;
+	uint16_t i, done = 0, nb_found = 0;
+	uint16_t sig;
+	int slot;
+
+	while (done < nb_pkts) {
+		uint16_t nb = RTE_MIN(nb_pkts - done, SIMPLE_FWD_FT_BULK_MAX);
+
+		/* Stage 1: build and hash all the keys, prefetch their primary buckets */
+		for (i = 0; i < nb; i++) {
+			memset(&keys[i], 0, sizeof(keys[i]));
+			valid[i] = simple_fwd_ft_key_fill(pinfos[done + i], &keys[i], &ipv6s[i]) == 0;
+			if (!valid[i])
+				continue;
+			hashes[i] = simple_fwd_ft_key_hash(&keys[i]);
+			rte_prefetch0(&ft->buckets[hashes[i] & ft->cfg.mask]);
+		}
+
+		/* Stage 2: match the signatures and prefetch the candidate entries */
+		for (i = 0; i < nb; i++) {
+			if (!valid[i])
+				continue;
+			sig = simple_fwd_ft_hash_sig(hashes[i]);
+			bucket = &ft->buckets[hashes[i] & ft->cfg.mask];
+			for (slot = 0; slot < SIMPLE_FWD_FT_BUCKET_ENTRIES; slot++) {
+				if (bucket->sig[slot] == sig && bucket->entries[slot] != NULL)
+					rte_prefetch0(bucket->entries[slot]);
+			}
+		}
+
+		/* Stage 3: compare the full keys, falling back to the alternative bucket on a miss */
+		for (i = 0; i < nb; i++) {
+			ctxs[done + i] = NULL;
+			if (!valid[i])
+				continue;
+			node = _simple_fwd_ft_find(ft, &keys[i], &ipv6s[i], hashes[i]);
+			if (node == NULL)
+				continue;
+			ctxs[done + i] = &node->user_ctx;
+			nb_found++;
+		}
+		done += nb;
+	}
+	return nb_found;
+}
+
+/*
+ * Insert an entry into a free slot of a given bucket
+ *
+ * @ft [in]: the flow table
+ * @idx [in]: index of the bucket to insert into
+ * @sig [in]: signature of the entry key
+ * @new_e [in]: the entry to insert
+ * @return: true if a free slot was found, false otherwise
+ */
+static bool simple_fwd_ft_bucket_insert(struct simple_fwd_ft *ft,
+					uint32_t idx,
+					uint16_t sig,
+					struct simple_fwd_ft_entry *new_e)
+{
+	struct simple_fwd_ft_bucket *bucket = &ft->buckets[idx];
+	bool inserted = false;
+	int slot;
+
+	rte_spinlock_lock(&bucket->lock);
+	for (slot = 0; slot < SIMPLE_FWD_FT_BUCKET_ENTRIES; slot++) {
+		if (bucket->sig[slot] != 0)
+			continue;
+		new_e->buckets_index = idx;
+		new_e->slot_index = slot;
+		bucket->entries[slot] = new_e;
+		rte_smp_wmb();
+		bucket->sig[slot] = sig;
+		inserted = true;
+		break;
+	}
+	rte_spinlock_unlock(&bucket->lock);
+	return inserted;
+}
+
 doca_error_t simple_fwd_ft_add_new(struct simple_fwd_ft *ft,
 				   struct simple_fwd_pkt_info *pinfo,
 				   struct simple_fwd_ft_user_ctx **ctx)
 {
 	doca_error_t result = DOCA_SUCCESS;
-	int idx;
+	uint32_t hash, idx;
+	uint16_t sig;
 	struct simple_fwd_ft_key key = {0};
+	struct simple_fwd_ft_key_ipv6 ipv6;
 	struct simple_fwd_ft_entry *new_e;
-	struct simple_fwd_ft_entry_head *first;
 
 	if (!ft)
 		return false;
 
-	if (simple_fwd_ft_key_fill(pinfo, &key)) {
+	if (simple_fwd_ft_key_fill(pinfo, &key, &ipv6)) {
 		result = DOCA_ERROR_UNEXPECTED;
 		DOCA_LOG_DBG("Failed to build key: %s", doca_error_get_descr(result));
 		return result;
 	}
 
-	new_e = calloc(1, ft->cfg.entry_size);
-	if (new_e == NULL) {
+	if (rte_mempool_get(ft->entries_pool, (void **)&new_e) != 0) {
 		result = DOCA_ERROR_NO_MEMORY;
 		DOCA_LOG_WARN("OOM: %s", doca_error_get_descr(result));
 		return result;
 	}
+	memset(new_e, 0, ft->cfg.entry_size);
+	memcpy(&new_e->key, &key, sizeof(struct simple_fwd_ft_key));
+	/* With an aging thread every entry is aged, it is owned by the wheel before anyone may remove it */
+	new_e->on_wheel = ft->has_age_thread;
+	if (key.l3_type == IPV6)
+		memcpy(&new_e->ipv6, &ipv6, sizeof(struct simple_fwd_ft_key_ipv6));
+
+	hash = simple_fwd_ft_key_hash(&key);
+	sig = simple_fwd_ft_hash_sig(hash);
+	idx = hash & ft->cfg.mask;
+	if (!simple_fwd_ft_bucket_insert(ft, idx, sig, new_e) &&
+	    !simple_fwd_ft_bucket_insert(ft, simple_fwd_ft_alt_bucket(ft, idx, sig), sig, new_e)) {
+		rte_mempool_put(ft->entries_pool, new_e);
+		result = DOCA_ERROR_FULL;
+		DOCA_LOG_DBG("No free slot for the new flow: %s", doca_error_get_descr(result));
+		return result;
+	}
 
 	simple_fwd_ft_update_expiration(new_e);
 	new_e->user_ctx.fid = ft->fid_ctr++;
 	*ctx = &new_e->user_ctx;
 
 	DOCA_LOG_TRC("Defined new flow %llu", (unsigned int long long)new_e->user_ctx.fid);
-	memcpy(&new_e->key, &key, sizeof(struct simple_fwd_ft_key));
-	idx = pinfo->rss_hash & ft->cfg.mask;
-	new_e->buckets_index = idx;
-	first = &ft->buckets[idx].head;
-
-	rte_spinlock_lock(&ft->buckets[idx].lock);
-	LIST_INSERT_HEAD(first, new_e, next);
-	rte_spinlock_unlock(&ft->buckets[idx].lock);
+	if (new_e->on_wheel)
+		rte_ring_enqueue(ft->wheel_ring, new_e);
 	ft->stats.add++;
 	return result;
 }
 
+void simple_fwd_ft_age_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *e)
+{
+	if (e->on_wheel)
+		return;
+	e->on_wheel = true;
+	rte_ring_enqueue(ft->wheel_ring, e);
+}
+
 doca_error_t simple_fwd_ft_destroy(struct simple_fwd_ft *ft)
 {
 	uint32_t i;
-	struct simple_fwd_ft_entry *node, *ptr;
+	int slot;
 
 	if (ft == NULL)
 		return DOCA_ERROR_INVALID_VALUE;
@@ -412,14 +826,15 @@ doca_error_t simple_fwd_ft_destroy(struct simple_fwd_ft *ft)
 		ft->stop_aging_thread = true;
 		pthread_join(ft->age_thread, NULL);
 	}
-	for (i = 0; i < ft->cfg.size; i++) {
-		node = LIST_FIRST(&ft->buckets[i].head);
-		while (node != NULL) {
-			ptr = LIST_NEXT(node, next);
-			_ft_destroy_entry(ft, node);
-			node = ptr;
+	for (i = 0; i < ft->cfg.nb_buckets; i++) {
+		for (slot = 0; slot < SIMPLE_FWD_FT_BUCKET_ENTRIES; slot++) {
+			if (ft->buckets[i].entries[slot] != NULL)
+				_ft_unlink_entry(ft, ft->buckets[i].entries[slot]);
 		}
 	}
+	rte_ring_free(ft->wheel_ring);
+	rte_mempool_free(ft->entries_pool);
+	rte_free(ft->buckets);
 	free(ft);
 	return DOCA_SUCCESS;
 }
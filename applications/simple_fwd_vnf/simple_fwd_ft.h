@@ -45,18 +45,21 @@ struct simple_fwd_ft_user_ctx {
 
 /* Simple FWD flow entry representation in flow table */
 struct simple_fwd_ft_entry {
-	LIST_ENTRY(simple_fwd_ft_entry) next;	/* Entry pointers in the list */
 	struct simple_fwd_ft_key key;		/* Generated key of the entry */
+	struct simple_fwd_ft_key_ipv6 ipv6;	/* Full IPv6 addresses of the key, valid for IPv6 keys only */
 	uint64_t expiration;			/* Expiration time */
 	uint32_t age_sec;			/* Age time in seconds */
 	uint64_t last_counter;			/* Last HW counter of matched packets */
 	uint64_t sw_ctr;			/* SW counter of matched packets */
 	uint8_t hw_off;				/* Whether or not the entry was HW offloaded */
-	uint16_t buckets_index;			/* The index of the entry in the buckets */
+	uint8_t slot_index;			/* The index of the entry inside its bucket */
+	uint32_t buckets_index;			/* The index of the bucket holding the entry */
+	volatile bool removed;			/* Whether or not the entry was removed from the buckets */
+	volatile bool hw_pending;		/* Whether or not the HW insertion of the entry is in flight */
+	bool on_wheel;				/* Whether or not the entry is owned by the aging timer wheel */
+	struct simple_fwd_ft_entry *wheel_next; /* Next entry due in the same aging tick */
 	struct simple_fwd_ft_user_ctx user_ctx; /* A context that can be stored and used */
 };
-LIST_HEAD(simple_fwd_ft_entry_head, simple_fwd_ft_entry); /* Head of the list of the flows as represented in the
-							     application */
 
 /* Extracting the source IPv4 address for key generating */
 #define simple_fwd_ft_key_get_ipv4_src(inner, pinfo) \
@@ -66,6 +69,14 @@ LIST_HEAD(simple_fwd_ft_entry_head, simple_fwd_ft_entry); /* Head of the list of
 #define simple_fwd_ft_key_get_ipv4_dst(inner, pinfo) \
 	(inner ? simple_fwd_pinfo_inner_ipv4_dst(pinfo) : simple_fwd_pinfo_outer_ipv4_dst(pinfo))
 
+/* Extracting the source IPv6 address for key generating */
+#define simple_fwd_ft_key_get_ipv6_src(inner, pinfo) \
+	(inner ? simple_fwd_pinfo_inner_ipv6_src(pinfo) : simple_fwd_pinfo_outer_ipv6_src(pinfo))
+
+/* Extracting the destination IPv6 address for key generating */
+#define simple_fwd_ft_key_get_ipv6_dst(inner, pinfo) \
+	(inner ? simple_fwd_pinfo_inner_ipv6_dst(pinfo) : simple_fwd_pinfo_outer_ipv6_dst(pinfo))
+
 /* Extracting the source port for key generating */
 #define simple_fwd_ft_key_get_src_port(inner, pinfo) \
 	(inner ? simple_fwd_pinfo_inner_src_port(pinfo) : simple_fwd_pinfo_outer_src_port(pinfo))
@@ -122,6 +133,22 @@ doca_error_t simple_fwd_ft_find(struct simple_fwd_ft *ft,
 				struct simple_fwd_pkt_info *pinfo,
 				struct simple_fwd_ft_user_ctx **ctx);
 
+/*
+ * Find the existing entries matching a burst of packets' info.
+ * All the keys are hashed first and their buckets prefetched, so that the bucket and entry memory accesses of the
+ * whole burst overlap instead of being serialized per packet.
+ *
+ * @ft [in]: flow table to search in
+ * @pinfos [in]: array of packets info for generating the keys for the search
+ * @nb_pkts [in]: number of packets info in the array
+ * @ctxs [out]: array of simple fwd user contexts, set to NULL for packets that have no entry
+ * @return: number of packets for which an entry was found
+ */
+uint16_t simple_fwd_ft_find_bulk(struct simple_fwd_ft *ft,
+				 struct simple_fwd_pkt_info **pinfos,
+				 uint16_t nb_pkts,
+				 struct simple_fwd_ft_user_ctx **ctxs);
+
 /*
  * Remove entry from flow table if found
  *
@@ -138,6 +165,24 @@ void simple_fwd_ft_destroy_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_
  */
 void simple_fwd_ft_update_age_sec(struct simple_fwd_ft_entry *e, uint32_t age_sec);
 
+/*
+ * Hand an entry over to the aging timer wheel, so it is removed once idle for its age time.
+ * With an aging thread every entry is already handed over by simple_fwd_ft_add_new(), otherwise only the entries
+ * handed over here are aged, by simple_fwd_ft_aging_poll(). Must be called before the entry may be removed.
+ *
+ * @ft [in]: flow table of the entry
+ * @e [in]: pointer to the entry
+ */
+void simple_fwd_ft_age_entry(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *e);
+
+/*
+ * Drive the aging timer wheel from a polling lcore when the flow table has no aging thread.
+ * Handles at most one tick per second, on whichever lcore calls it first once due, and is a no-op with an aging thread.
+ *
+ * @ft [in]: flow table to age
+ */
+void simple_fwd_ft_aging_poll(struct simple_fwd_ft *ft);
+
 /*
  * Updates the expiration time of a given entry in the flow table
  *
@@ -145,4 +190,22 @@ void simple_fwd_ft_update_age_sec(struct simple_fwd_ft_entry *e, uint32_t age_se
  */
 void simple_fwd_ft_update_expiration(struct simple_fwd_ft_entry *e);
 
+/*
+ * Mark an entry as having its HW insertion in flight.
+ * Aging skips the entry, and removing it only unlinks it from the flow table, its memory is kept until
+ * simple_fwd_ft_hw_done() is called, so the insertion completion may still access it.
+ *
+ * @e [in]: pointer to the entry
+ */
+void simple_fwd_ft_set_hw_pending(struct simple_fwd_ft_entry *e);
+
+/*
+ * Complete the HW insertion of an entry marked by simple_fwd_ft_set_hw_pending().
+ * If the entry was removed meanwhile its memory is released, so it must not be accessed after this call.
+ *
+ * @ft [in]: flow table of the entry
+ * @e [in]: pointer to the entry
+ */
+void simple_fwd_ft_hw_done(struct simple_fwd_ft *ft, struct simple_fwd_ft_entry *e);
+
 #endif /* SIMPLE_FWD_FT_H_ */
@@ -40,6 +40,8 @@ DOCA_LOG_REGISTER(SIMPLE_FWD_PKT);
 
 #define GTP_ESPN_FLAGS_ON(p) (p & 0x7) /* A macro for setting GTP ESPN flags on */
 #define GTP_EXT_FLAGS_ON(p) (p & 0x4)  /* A macro for setting GTP EXT flags on */
+#define IPV6_MAX_EXT_HDRS (8)	       /* Maximum number of IPv6 extension headers skipped to reach layer 4 */
+#define IPV6_FRAG_OFFSET_MASK (0xfff8) /* Fragment offset bits of the IPv6 fragment header */
 
 uint8_t *simple_fwd_pinfo_outer_mac_dst(struct simple_fwd_pkt_info *pinfo)
 {
@@ -71,6 +73,26 @@ doca_be32_t simple_fwd_pinfo_inner_ipv4_src(struct simple_fwd_pkt_info *pinfo)
 	return ((struct rte_ipv4_hdr *)pinfo->inner.l3)->src_addr;
 }
 
+uint8_t *simple_fwd_pinfo_outer_ipv6_src(struct simple_fwd_pkt_info *pinfo)
+{
+	return ((struct rte_ipv6_hdr *)pinfo->outer.l3)->src_addr;
+}
+
+uint8_t *simple_fwd_pinfo_outer_ipv6_dst(struct simple_fwd_pkt_info *pinfo)
+{
+	return ((struct rte_ipv6_hdr *)pinfo->outer.l3)->dst_addr;
+}
+
+uint8_t *simple_fwd_pinfo_inner_ipv6_src(struct simple_fwd_pkt_info *pinfo)
+{
+	return ((struct rte_ipv6_hdr *)pinfo->inner.l3)->src_addr;
+}
+
+uint8_t *simple_fwd_pinfo_inner_ipv6_dst(struct simple_fwd_pkt_info *pinfo)
+{
+	return ((struct rte_ipv6_hdr *)pinfo->inner.l3)->dst_addr;
+}
+
 /*
  * Extracts the source port address from the packet's info based on layer 4 type
  *
@@ -131,6 +153,100 @@ doca_be16_t simple_fwd_pinfo_outer_dst_port(struct simple_fwd_pkt_info *pinfo)
 	return simple_fwd_pinfo_dst_port(&pinfo->outer);
 }
 
+/*
+ * Parse the IPv4 header of the packet
+ *
+ * @data [in]: packet raw data
+ * @len [in]: length of the packet raw data in bytes
+ * @l3_off [in]: offset of the IPv4 header in the packet raw data
+ * @fmt [out]: the parsed packet as should be represented in the application fo further processing
+ * @next_proto [out]: the protocol of layer 4
+ * @return: offset of layer 4 on success, negative value otherwise
+ */
+static int simple_fwd_parse_ipv4(uint8_t *data,
+				 int len,
+				 int l3_off,
+				 struct simple_fwd_pkt_format *fmt,
+				 uint8_t *next_proto)
+{
+	struct rte_ipv4_hdr *iphdr = (struct rte_ipv4_hdr *)(data + l3_off);
+
+	if (l3_off + (int)sizeof(*iphdr) > len)
+		return -1;
+	if ((iphdr->version_ihl >> 4) != 4)
+		return -1;
+	if (iphdr->src_addr == 0 || iphdr->dst_addr == 0)
+		return -1;
+	fmt->l3 = (data + l3_off);
+	fmt->l3_type = IPV4;
+	*next_proto = iphdr->next_proto_id;
+	return l3_off + rte_ipv4_hdr_len(iphdr);
+}
+
+/*
+ * Parse the IPv6 header of the packet, skipping the extension headers preceding layer 4
+ *
+ * @data [in]: packet raw data
+ * @len [in]: length of the packet raw data in bytes
+ * @l3_off [in]: offset of the IPv6 header in the packet raw data
+ * @fmt [out]: the parsed packet as should be represented in the application fo further processing
+ * @next_proto [out]: the protocol of layer 4
+ * @return: offset of layer 4 on success, negative value otherwise
+ */
+static int simple_fwd_parse_ipv6(uint8_t *data,
+				 int len,
+				 int l3_off,
+				 struct simple_fwd_pkt_format *fmt,
+				 uint8_t *next_proto)
+{
+	struct rte_ipv6_hdr *ip6hdr = (struct rte_ipv6_hdr *)(data + l3_off);
+	int l4_off = l3_off + sizeof(*ip6hdr);
+	uint8_t *ext_hdr;
+	uint8_t proto;
+	int i;
+
+	if (l4_off > len)
+		return -1;
+	if ((rte_be_to_cpu_32(ip6hdr->vtc_flow) >> 28) != 6)
+		return -1;
+	fmt->l3 = (data + l3_off);
+	fmt->l3_type = IPV6;
+	proto = ip6hdr->proto;
+	for (i = 0; i < IPV6_MAX_EXT_HDRS; i++) {
+		ext_hdr = data + l4_off;
+		switch (proto) {
+		case IPPROTO_HOPOPTS:
+		case IPPROTO_ROUTING:
+		case IPPROTO_DSTOPTS:
+			if (l4_off + 8 > len)
+				return -1;
+			proto = ext_hdr[0];
+			l4_off += (ext_hdr[1] + 1) * 8;
+			break;
+		case IPPROTO_FRAGMENT:
+			if (l4_off + 8 > len)
+				return -1;
+			/* Only the first fragment carries the layer 4 header */
+			if (rte_be_to_cpu_16(*(uint16_t *)(ext_hdr + 2)) & IPV6_FRAG_OFFSET_MASK)
+				return -1;
+			proto = ext_hdr[0];
+			l4_off += 8;
+			break;
+		case IPPROTO_AH:
+			if (l4_off + 8 > len)
+				return -1;
+			proto = ext_hdr[0];
+			l4_off += (ext_hdr[1] + 2) * 4;
+			break;
+		default:
+			*next_proto = proto;
+			return l4_off;
+		}
+	}
+	DOCA_LOG_DBG("Too many IPv6 extension headers");
+	return -1;
+}
+
 /*
  * Parse the packet and set the packet format as represented in the application
  *
@@ -143,7 +259,8 @@ doca_be16_t simple_fwd_pinfo_outer_dst_port(struct simple_fwd_pkt_info *pinfo)
 static int simple_fwd_parse_pkt_format(uint8_t *data, int len, bool l2, struct simple_fwd_pkt_format *fmt)
 {
 	struct rte_ether_hdr *eth = NULL;
-	struct rte_ipv4_hdr *iphdr;
+	uint8_t next_proto;
+	uint8_t ip_version;
 	int l3_off = 0;
 	int l4_off = 0;
 	int l7_off = 0;
@@ -155,29 +272,34 @@ static int simple_fwd_parse_pkt_format(uint8_t *data, int len, bool l2, struct s
 		switch (rte_be_to_cpu_16(eth->ether_type)) {
 		case RTE_ETHER_TYPE_IPV4:
 			l3_off = sizeof(struct rte_ether_hdr);
+			ip_version = 4;
 			break;
 		case RTE_ETHER_TYPE_IPV6:
 			l3_off = sizeof(struct rte_ether_hdr);
-			fmt->l3_type = IPV6;
-			return -1;
+			ip_version = 6;
+			break;
 		case RTE_ETHER_TYPE_ARP:
 			return -1;
 		default:
 			DOCA_LOG_WARN("Unsupported L2 type 0x%x", eth->ether_type);
 			return -1;
 		}
+	} else {
+		if (len < 1)
+			return -1;
+		ip_version = data[0] >> 4;
 	}
 
-	iphdr = (struct rte_ipv4_hdr *)(data + l3_off);
-	if ((iphdr->version_ihl >> 4) != 4)
+	if (ip_version == 4)
+		l4_off = simple_fwd_parse_ipv4(data, len, l3_off, fmt, &next_proto);
+	else if (ip_version == 6)
+		l4_off = simple_fwd_parse_ipv6(data, len, l3_off, fmt, &next_proto);
+	else
 		return -1;
-	if (iphdr->src_addr == 0 || iphdr->dst_addr == 0)
+	if (l4_off < 0)
 		return -1;
-	fmt->l3 = (data + l3_off);
-	fmt->l3_type = IPV4;
-	l4_off = l3_off + rte_ipv4_hdr_len(iphdr);
 	fmt->l4 = data + l4_off;
-	switch (iphdr->next_proto_id) {
+	switch (next_proto) {
 	case DOCA_FLOW_PROTO_TCP: {
 		struct rte_tcp_hdr *tcphdr = (struct rte_tcp_hdr *)(data + l4_off);
 
@@ -204,8 +326,11 @@ static int simple_fwd_parse_pkt_format(uint8_t *data, int len, bool l2, struct s
 	case IPPROTO_ICMP:
 		fmt->l4_type = IPPROTO_ICMP;
 		break;
+	case IPPROTO_ICMPV6:
+		fmt->l4_type = IPPROTO_ICMPV6;
+		break;
 	default:
-		DOCA_LOG_INFO("Unsupported L4 %d", iphdr->next_proto_id);
+		DOCA_LOG_INFO("Unsupported L4 %d", next_proto);
 		return -1;
 	}
 	return 0;
@@ -219,9 +344,6 @@ static int simple_fwd_parse_pkt_format(uint8_t *data, int len, bool l2, struct s
  */
 static int simple_fwd_parse_is_tun(struct simple_fwd_pkt_info *pinfo)
 {
-	if (pinfo->outer.l3_type != IPV4)
-		return 0;
-
 	if (pinfo->outer.l4_type == DOCA_FLOW_PROTO_GRE) {
 		int optional_off = 0;
 		struct rte_gre_hdr *gre_hdr = (struct rte_gre_hdr *)pinfo->outer.l4;
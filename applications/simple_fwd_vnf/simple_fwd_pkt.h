@@ -100,8 +100,14 @@ struct simple_fwd_pkt_info {
  * computed from packet's parsing result, based on the 5-tuple and the tunneling type.
  */
 struct simple_fwd_ft_key {
-	doca_be32_t ipv4_1; /* First Ipv4 address */
-	doca_be32_t ipv4_2; /* Second Ipv4 address */
+	union {
+		doca_be32_t ipv4_1;   /* First Ipv4 address */
+		uint32_t ipv6_hash_1; /* Hash of the first IPv6 address */
+	};
+	union {
+		doca_be32_t ipv4_2;   /* Second Ipv4 address */
+		uint32_t ipv6_hash_2; /* Hash of the second IPv6 address */
+	};
 	doca_be16_t port_1; /* First port address */
 	doca_be16_t port_2; /* Second port address */
 	union {
@@ -112,10 +118,21 @@ struct simple_fwd_ft_key {
 	uint8_t protocol;  /* Protocol type */
 	uint8_t tun_type;  /* Supported tunneling type (GRE, GTP or VXLAN) */
 	uint16_t port_id;  /* Port identifier on which the packet was received */
-	uint8_t pad[4];	   /* Padding bytes in the packet */
+	uint8_t l3_type;   /* Layer 3 type of the addresses, IPV4 or IPV6 */
+	uint8_t pad[3];	   /* Padding bytes in the packet */
 	uint32_t rss_hash; /* RSS hash value */
 };
 
+/*
+ * Full IPv6 addresses of a packet's key.
+ * The key itself only holds the addresses hashes, so it stays as compact as an IPv4 key, and IPv6 keys with equal
+ * hashes are told apart by comparing these.
+ */
+struct simple_fwd_ft_key_ipv6 {
+	uint8_t ipv6_1[16]; /* First IPv6 address */
+	uint8_t ipv6_2[16]; /* Second IPv6 address */
+};
+
 /*
  * Parses the packet and extract the relevant headers, outer/inner in addition to the tunnels.
  *
@@ -182,6 +199,38 @@ doca_be32_t simple_fwd_pinfo_inner_ipv4_src(struct simple_fwd_pkt_info *pinfo);
  */
 doca_be32_t simple_fwd_pinfo_inner_ipv4_dst(struct simple_fwd_pkt_info *pinfo);
 
+/*
+ * Extracts the outer source IPv6 address from the packet's info
+ *
+ * @pinfo [in]: the packet's info
+ * @return: pointer to the outer source IPv6 address, in network order
+ */
+uint8_t *simple_fwd_pinfo_outer_ipv6_src(struct simple_fwd_pkt_info *pinfo);
+
+/*
+ * Extracts the outer destination IPv6 address from the packet's info
+ *
+ * @pinfo [in]: the packet's info
+ * @return: pointer to the outer destination IPv6 address, in network order
+ */
+uint8_t *simple_fwd_pinfo_outer_ipv6_dst(struct simple_fwd_pkt_info *pinfo);
+
+/*
+ * Extracts the inner source IPv6 address from the packet's info
+ *
+ * @pinfo [in]: the packet's info
+ * @return: pointer to the inner source IPv6 address, in network order
+ */
+uint8_t *simple_fwd_pinfo_inner_ipv6_src(struct simple_fwd_pkt_info *pinfo);
+
+/*
+ * Extracts the inner destination IPv6 address from the packet's info
+ *
+ * @pinfo [in]: the packet's info
+ * @return: pointer to the inner destination IPv6 address, in network order
+ */
+uint8_t *simple_fwd_pinfo_inner_ipv6_dst(struct simple_fwd_pkt_info *pinfo);
+
 /*
  * Extracts the inner source port address from the packet's info
  *
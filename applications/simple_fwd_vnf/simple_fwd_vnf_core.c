@@ -47,6 +47,7 @@
 #include <rte_mbuf.h>
 #include <rte_net.h>
 #include <rte_flow.h>
+#include <rte_prefetch.h>
 
 #include <doca_argp.h>
 #include <doca_flow.h>
@@ -64,16 +65,21 @@ DOCA_LOG_REGISTER(SIMPLE_FWD_VNF : Core);
 #define VNF_PKT_L2(M) rte_pktmbuf_mtod(M, uint8_t *) /* A marco that points to the start of the data in the mbuf */
 #define VNF_PKT_LEN(M) rte_pktmbuf_pkt_len(M)	     /* A marco that returns the length of the packet */
 #define VNF_RX_BURST_SIZE (32)			     /* Burst size of packets to read, RX burst read size */
+#define VNF_TX_BURST_SIZE (32)			     /* Number of packets buffered per port before sending */
+#define VNF_PREFETCH_OFFSET (4)			     /* Number of packets prefetched ahead of the parsed one */
 
 /* Flag for forcing lcores to stop processing packets, and gracefully terminate the application */
 static volatile bool force_quit;
 
 /* Parameters used by each core */
 struct vnf_per_core_params {
-	int ports[NUM_OF_PORTS];  /* Ports identifiers */
-	int queues[NUM_OF_PORTS]; /* Queue mapped for the core running */
-	bool used;		  /* Whether the core is used or not */
-};
+	int ports[NUM_OF_PORTS];			       /* Ports identifiers */
+	int queues[NUM_OF_PORTS];			       /* Queue mapped for the core running */
+	bool used;					       /* Whether the core is used or not */
+	struct rte_eth_dev_tx_buffer *tx_buffer[NUM_OF_PORTS]; /* TX buffer of each egress port */
+	uint64_t rx_pkts;				       /* Number of received packets */
+	uint64_t tx_dropped;				       /* Number of packets dropped on a full TX ring */
+} __rte_cache_aligned;
 
 /* per core parameters */
 static struct vnf_per_core_params core_params_arr[RTE_MAX_LCORE];
@@ -92,30 +98,140 @@ static void vnf_adjust_mbuf(struct rte_mbuf *m, struct simple_fwd_pkt_info *pinf
 }
 
 /*
- * Process received packets, mainly retrieving packet's key, then checking if there is an entry found
- * matching the generated key, in the entries table.
- * If no entry found, the function will create and add new one.
- * In addition, this function handles aging as well
+ * Parse a received packet into the packet info representation of the application
  *
  * @mbuf [in]: DPDK structure represent the packet received
  * @queue_id [in]: Queue ID
- * @vnf [in]: Holder for all functions pointers used by the application
+ * @pinfo [out]: packet info representation in the application
+ * @return: 0 on success and negative value if the packet should not be processed
  */
-static void simple_fwd_process_offload(struct rte_mbuf *mbuf, uint16_t queue_id, struct app_vnf *vnf)
+static int simple_fwd_parse_mbuf(struct rte_mbuf *mbuf, uint16_t queue_id, struct simple_fwd_pkt_info *pinfo)
 {
-	struct simple_fwd_pkt_info pinfo;
+	memset(pinfo, 0, sizeof(struct simple_fwd_pkt_info));
+	if (simple_fwd_parse_packet(VNF_PKT_L2(mbuf), VNF_PKT_LEN(mbuf), pinfo))
+		return -1;
+	pinfo->orig_data = mbuf;
+	pinfo->orig_port_id = mbuf->port;
+	pinfo->pipe_queue = queue_id;
+	pinfo->rss_hash = mbuf->hash.rss;
+	if (pinfo->outer.l3_type != IPV4 && pinfo->outer.l3_type != IPV6)
+		return -1;
+	return 0;
+}
 
-	memset(&pinfo, 0, sizeof(struct simple_fwd_pkt_info));
-	if (simple_fwd_parse_packet(VNF_PKT_L2(mbuf), VNF_PKT_LEN(mbuf), &pinfo))
-		return;
-	pinfo.orig_data = mbuf;
-	pinfo.orig_port_id = mbuf->port;
-	pinfo.pipe_queue = queue_id;
-	pinfo.rss_hash = mbuf->hash.rss;
-	if (pinfo.outer.l3_type != IPV4)
+/*
+ * Process a burst of received packets: parse and classify the whole burst, while prefetching the headers of the
+ * packets ahead, then hand the parsed burst to the application at once.
+ * The application retrieves the packets' keys, checks if there are entries found matching the generated keys in
+ * the entries table, and creates and adds new ones for the packets with no entry.
+ *
+ * @mbufs [in]: DPDK structures represent the packets received
+ * @nb_pkts [in]: number of packets received
+ * @queue_id [in]: Queue ID
+ * @vnf [in]: Holder for all functions pointers used by the application
+ */
+static void simple_fwd_process_offload(struct rte_mbuf **mbufs,
+				       uint16_t nb_pkts,
+				       uint16_t queue_id,
+				       struct app_vnf *vnf)
+{
+	struct simple_fwd_pkt_info pinfos[VNF_RX_BURST_SIZE];
+	struct simple_fwd_pkt_info *parsed[VNF_RX_BURST_SIZE];
+	uint16_t j, nb_parsed = 0;
+
+	for (j = 0; j < nb_pkts && j < VNF_PREFETCH_OFFSET; j++)
+		rte_prefetch0(VNF_PKT_L2(mbufs[j]));
+	for (j = 0; j < nb_pkts; j++) {
+		if (j + VNF_PREFETCH_OFFSET < nb_pkts)
+			rte_prefetch0(VNF_PKT_L2(mbufs[j + VNF_PREFETCH_OFFSET]));
+		if (simple_fwd_parse_mbuf(mbufs[j], queue_id, &pinfos[nb_parsed]))
+			continue;
+		parsed[nb_parsed] = &pinfos[nb_parsed];
+		nb_parsed++;
+	}
+	if (nb_parsed == 0)
 		return;
-	vnf->vnf_process_pkt(&pinfo);
-	vnf_adjust_mbuf(mbuf, &pinfo);
+	vnf->vnf_process_burst(parsed, nb_parsed);
+	for (j = 0; j < nb_parsed; j++)
+		vnf_adjust_mbuf(pinfos[j].orig_data, &pinfos[j]);
+}
+
+/*
+ * Allocate and initialize the TX buffers of the core, one per egress port.
+ * Packets that cannot be sent when a buffer is flushed on a full TX ring are freed and counted as dropped.
+ *
+ * @params [in]: the core parameters to allocate the TX buffers for
+ * @return: 0 on success and negative value otherwise
+ */
+static int simple_fwd_tx_buffers_init(struct vnf_per_core_params *params)
+{
+	uint32_t port_id;
+	int ret;
+
+	for (port_id = 0; port_id < NUM_OF_PORTS; port_id++) {
+		params->tx_buffer[port_id] = rte_zmalloc_socket("simple_fwd_tx_buffer",
+								RTE_ETH_TX_BUFFER_SIZE(VNF_TX_BURST_SIZE),
+								0,
+								rte_eth_dev_socket_id(port_id));
+		if (params->tx_buffer[port_id] == NULL) {
+			DOCA_LOG_ERR("Failed to allocate TX buffer for port %u", port_id);
+			return -ENOMEM;
+		}
+		ret = rte_eth_tx_buffer_init(params->tx_buffer[port_id], VNF_TX_BURST_SIZE);
+		if (ret == 0)
+			ret = rte_eth_tx_buffer_set_err_callback(params->tx_buffer[port_id],
+								 rte_eth_tx_buffer_count_callback,
+								 &params->tx_dropped);
+		if (ret != 0) {
+			DOCA_LOG_ERR("Failed to initialize TX buffer for port %u", port_id);
+			return ret;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Free the TX buffers of the core, after sending the packets left in them
+ *
+ * @params [in]: the core parameters to free the TX buffers for
+ */
+static void simple_fwd_tx_buffers_destroy(struct vnf_per_core_params *params)
+{
+	uint32_t port_id;
+
+	for (port_id = 0; port_id < NUM_OF_PORTS; port_id++) {
+		if (params->tx_buffer[port_id] == NULL)
+			continue;
+		rte_eth_tx_buffer_flush(port_id, params->queues[port_id], params->tx_buffer[port_id]);
+		rte_free(params->tx_buffer[port_id]);
+		params->tx_buffer[port_id] = NULL;
+	}
+}
+
+/*
+ * Dump the packets rate of all the cores, since the previous dump
+ *
+ * @cur_tsc [in]: current TSC
+ */
+static void simple_fwd_dump_core_stats(uint64_t cur_tsc)
+{
+	static uint64_t last_rx_pkts, last_tsc;
+	uint64_t rx_pkts = 0, tx_dropped = 0;
+	double mpps = 0;
+	int i;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		if (!core_params_arr[i].used)
+			continue;
+		rx_pkts += core_params_arr[i].rx_pkts;
+		tx_dropped += core_params_arr[i].tx_dropped;
+	}
+	if (last_tsc != 0 && cur_tsc > last_tsc)
+		mpps = (double)(rx_pkts - last_rx_pkts) * rte_get_timer_hz() / (cur_tsc - last_tsc) / 1e6;
+	last_rx_pkts = rx_pkts;
+	last_tsc = cur_tsc;
+	fprintf(stdout, "Cores: received %lu, TX full drops %lu, rate %.3f Mpps\n", rx_pkts, tx_dropped, mpps);
+	fflush(stdout);
 }
 
 int simple_fwd_process_pkts(void *process_pkts_params)
@@ -133,6 +249,11 @@ int simple_fwd_process_pkts(void *process_pkts_params)
 		DOCA_LOG_DBG("Core %u nothing need to do", core_id);
 		return 0;
 	}
+	result = simple_fwd_tx_buffers_init(params);
+	if (result != 0) {
+		simple_fwd_tx_buffers_destroy(params);
+		return result;
+	}
 	DOCA_LOG_TRC("Core %u process queue %u start", core_id, params->queues[0]);
 	last_tsc = rte_rdtsc();
 	while (!force_quit) {
@@ -141,26 +262,37 @@ int simple_fwd_process_pkts(void *process_pkts_params)
 			if (cur_tsc > last_tsc + app_config->stats_timer) {
 				result = vnf->vnf_dump_stats(0);
 				if (result != 0)
-					return result;
+					break;
+				simple_fwd_dump_core_stats(cur_tsc);
 				last_tsc = cur_tsc;
 			}
 		}
 		for (port_id = 0; port_id < NUM_OF_PORTS; port_id++) {
 			queue_id = params->queues[port_id];
 			nb_rx = rte_eth_rx_burst(port_id, queue_id, mbufs, VNF_RX_BURST_SIZE);
-			for (j = 0; j < nb_rx; j++) {
-				if (app_config->hw_offload)
-					simple_fwd_process_offload(mbufs[j], queue_id, vnf);
-				if (app_config->rx_only)
-					rte_pktmbuf_free(mbufs[j]);
-				else
-					rte_eth_tx_burst(port_id ^ 1, queue_id, &mbufs[j], 1);
+			params->rx_pkts += nb_rx;
+			if (app_config->hw_offload && nb_rx > 0)
+				simple_fwd_process_offload(mbufs, nb_rx, queue_id, vnf);
+			if (app_config->rx_only)
+				rte_pktmbuf_free_bulk(mbufs, nb_rx);
+			else {
+				for (j = 0; j < nb_rx; j++)
+					rte_eth_tx_buffer(port_id ^ 1,
+							  params->queues[port_id ^ 1],
+							  params->tx_buffer[port_id ^ 1],
+							  mbufs[j]);
 			}
+			if (app_config->hw_offload)
+				vnf->vnf_flush(port_id, queue_id);
 			if (app_config->age_thread)
 				vnf->vnf_flow_age(port_id, queue_id);
 		}
+		/* A single doorbell per port for all the packets received in this iteration */
+		for (port_id = 0; port_id < NUM_OF_PORTS; port_id++)
+			rte_eth_tx_buffer_flush(port_id, params->queues[port_id], params->tx_buffer[port_id]);
 	}
-	return 0;
+	simple_fwd_tx_buffers_destroy(params);
+	return result;
 }
 
 void simple_fwd_process_pkts_stop(void)
@@ -53,6 +53,7 @@
 #include <storage_common/definitions.hpp>
 #include <storage_common/file_utils.hpp>
 #include <storage_common/io_message.hpp>
+#include <storage_common/latency_histogram.hpp>
 #include <storage_common/os_utils.hpp>
 #include <storage_common/doca_utils.hpp>
 
@@ -74,6 +75,7 @@ struct zero_copy_app_configuration {
 	std::string device_id = {};
 	std::string representor_id = {};
 	std::string command_channel_name = {};
+	std::string latency_report_file = {};
 	std::chrono::seconds control_timeout = {};
 	storage::ip_address storage_server_address = {};
 };
@@ -83,6 +85,7 @@ struct thread_stats {
 	uint64_t pe_hit_count = 0;
 	uint64_t pe_miss_count = 0;
 	uint64_t operation_count = 0;
+	storage::latency_summary latency = {};
 };
 
 class zero_copy_app_worker {
@@ -92,8 +95,11 @@ public:
 		uint64_t pe_hit_count;
 		uint64_t pe_miss_count;
 		uint64_t completed_transaction_count;
+		storage::latency_histogram *latency;
+		std::chrono::steady_clock::time_point *request_start_times; /* indexed by io message correlation id */
 		uint32_t in_flight_transaction_count;
 		uint32_t core_idx;
+		uint32_t request_start_times_size;
 		uint8_t batch_count;
 		uint8_t batch_size;
 		std::atomic_bool run_flag;
@@ -112,6 +118,20 @@ public:
 		 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
 		 */
 		doca_error_t submit_comch_recv_task(doca_comch_consumer_task_post_recv *task);
+
+		/*
+		 * Note the arrival time of a host request
+		 *
+		 * @io_message [in]: Request
+		 */
+		void on_host_request(char const *io_message) noexcept;
+
+		/*
+		 * Record the time taken (host request to storage response) to service a request
+		 *
+		 * @io_message [in]: Response from storage
+		 */
+		void on_storage_response(char const *io_message) noexcept;
 	};
 	static_assert(sizeof(zero_copy_app_worker::hot_data) == storage::cache_line_size,
 		      "Expected thread_context::hot_data to occupy one cache line");
@@ -140,8 +160,18 @@ public:
 	void start_thread_proc();
 	[[nodiscard]] hot_data const &get_hot_data() const noexcept;
 
+	/*
+	 * Get the histogram of the time (in micro seconds) from receiving each host request to receiving the storage
+	 * response for it
+	 *
+	 * @return: Latency histogram
+	 */
+	[[nodiscard]] storage::latency_histogram const &get_latency() const noexcept;
+
 private:
 	hot_data m_hot_data;
+	storage::latency_histogram m_latency;
+	std::vector<std::chrono::steady_clock::time_point> m_request_start_times;
 	uint8_t *m_io_message_region;
 	doca_mmap *m_io_message_mmap;
 	doca_buf_inventory *m_io_message_inv;
@@ -206,6 +236,7 @@ public:
 	void wait_for_and_process_stop_storage(void);
 	void wait_for_and_process_shutdown(void);
 	void display_stats(void) const;
+	void write_latency_report(void) const;
 
 private:
 	zero_copy_app_configuration const m_cfg;
@@ -219,6 +250,7 @@ private:
 	std::vector<uint32_t> m_remote_consumer_ids;
 	zero_copy_app_worker *m_workers;
 	std::vector<thread_stats> m_stats;
+	storage::latency_summary m_latency;
 	uint64_t m_storage_capacity;
 	uint32_t m_storage_block_size;
 	uint32_t m_message_id_counter;
@@ -291,6 +323,7 @@ int main(int argc, char **argv)
 		app.wait_for_and_process_stop_storage();
 		app.wait_for_and_process_shutdown();
 		app.display_stats();
+		app.write_latency_report();
 	} catch (std::exception const &ex) {
 		fprintf(stderr, "EXCEPTION: %s\n", ex.what());
 		fflush(stdout);
@@ -330,6 +363,7 @@ void print_config(zero_copy_app_configuration const &cfg) noexcept
 	printf("\tstorage_server : %s:%u\n",
 	       cfg.storage_server_address.get_address().c_str(),
 	       cfg.storage_server_address.get_port());
+	printf("\tlatency_report : \"%s\"\n", cfg.latency_report_file.c_str());
 	printf("}\n");
 }
 
@@ -448,6 +482,18 @@ zero_copy_app_configuration parse_cli_args(int argc, char **argv)
 						       std::chrono::seconds{*static_cast<int *>(value)};
 					       return DOCA_SUCCESS;
 				       });
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"latency-report",
+		"Write the host request to storage response latency percentiles to this file. A \".json\" file name produces JSON, anything else produces CSV",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<zero_copy_app_configuration *>(cfg)->latency_report_file =
+				static_cast<char const *>(value);
+			return DOCA_SUCCESS;
+		});
 	ret = doca_argp_start(argc, argv);
 	if (ret != DOCA_SUCCESS) {
 		throw storage::runtime_error{ret, "Failed to parse CLI args"};
@@ -466,8 +512,11 @@ zero_copy_app_worker::hot_data::hot_data()
 	  pe_hit_count{0},
 	  pe_miss_count{0},
 	  completed_transaction_count{0},
+	  latency{nullptr},
+	  request_start_times{nullptr},
 	  in_flight_transaction_count{0},
 	  core_idx{0},
+	  request_start_times_size{0},
 	  batch_count{0},
 	  batch_size{1},
 	  run_flag{false},
@@ -480,8 +529,11 @@ zero_copy_app_worker::hot_data::hot_data(hot_data &&other) noexcept
 	  pe_hit_count{other.pe_hit_count},
 	  pe_miss_count{other.pe_miss_count},
 	  completed_transaction_count{other.completed_transaction_count},
+	  latency{other.latency},
+	  request_start_times{other.request_start_times},
 	  in_flight_transaction_count{other.in_flight_transaction_count},
 	  core_idx{other.core_idx},
+	  request_start_times_size{other.request_start_times_size},
 	  batch_count{other.batch_count},
 	  batch_size{other.batch_size},
 	  run_flag{other.run_flag.load()},
@@ -499,8 +551,11 @@ zero_copy_app_worker::hot_data &zero_copy_app_worker::hot_data::operator=(hot_da
 	pe_hit_count = other.pe_hit_count;
 	pe_miss_count = other.pe_miss_count;
 	completed_transaction_count = other.completed_transaction_count;
+	latency = other.latency;
+	request_start_times = other.request_start_times;
 	in_flight_transaction_count = other.in_flight_transaction_count;
 	core_idx = other.core_idx;
+	request_start_times_size = other.request_start_times_size;
 	batch_count = other.batch_count;
 	batch_size = other.batch_size;
 	run_flag = other.run_flag.load();
@@ -522,6 +577,24 @@ doca_error_t zero_copy_app_worker::hot_data::submit_comch_recv_task(doca_comch_c
 	return doca_task_submit_ex(doca_comch_consumer_task_post_recv_as_task(task), submit_flag);
 }
 
+void zero_copy_app_worker::hot_data::on_host_request(char const *io_message) noexcept
+{
+	auto const cid = storage::io_message_view::get_correlation_id(io_message);
+	if (cid < request_start_times_size)
+		request_start_times[cid] = std::chrono::steady_clock::now();
+}
+
+void zero_copy_app_worker::hot_data::on_storage_response(char const *io_message) noexcept
+{
+	auto const cid = storage::io_message_view::get_correlation_id(io_message);
+	if (cid >= request_start_times_size)
+		return;
+
+	auto const usecs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+										 request_start_times[cid]);
+	latency->record(static_cast<uint32_t>(usecs.count()));
+}
+
 zero_copy_app_worker::~zero_copy_app_worker()
 {
 	if (m_thread.joinable()) {
@@ -537,6 +610,8 @@ zero_copy_app_worker::zero_copy_app_worker(doca_dev *dev,
 					   uint32_t task_count,
 					   uint32_t batch_size)
 	: m_hot_data{},
+	  m_latency{},
+	  m_request_start_times{},
 	  m_io_message_region{nullptr},
 	  m_io_message_mmap{nullptr},
 	  m_io_message_inv{nullptr},
@@ -561,6 +636,8 @@ zero_copy_app_worker::zero_copy_app_worker(doca_dev *dev,
 
 zero_copy_app_worker::zero_copy_app_worker(zero_copy_app_worker &&other) noexcept
 	: m_hot_data{std::move(other.m_hot_data)},
+	  m_latency{std::move(other.m_latency)},
+	  m_request_start_times{std::move(other.m_request_start_times)},
 	  m_io_message_region{other.m_io_message_region},
 	  m_io_message_mmap{other.m_io_message_mmap},
 	  m_io_message_inv{other.m_io_message_inv},
@@ -582,6 +659,7 @@ zero_copy_app_worker::zero_copy_app_worker(zero_copy_app_worker &&other) noexcep
 	other.m_producer = nullptr;
 	other.m_rdma_ctrl_ctx = {};
 	other.m_rdma_data_ctx = {};
+	m_hot_data.latency = std::addressof(m_latency);
 }
 
 zero_copy_app_worker &zero_copy_app_worker::operator=(zero_copy_app_worker &&other) noexcept
@@ -590,6 +668,9 @@ zero_copy_app_worker &zero_copy_app_worker::operator=(zero_copy_app_worker &&oth
 		return *this;
 
 	m_hot_data = std::move(other.m_hot_data);
+	m_latency = std::move(other.m_latency);
+	m_request_start_times = std::move(other.m_request_start_times);
+	m_hot_data.latency = std::addressof(m_latency);
 	m_io_message_region = other.m_io_message_region;
 	m_io_message_mmap = other.m_io_message_mmap;
 	m_io_message_inv = other.m_io_message_inv;
@@ -900,6 +981,11 @@ zero_copy_app_worker::hot_data const &zero_copy_app_worker::get_hot_data(void) c
 	return m_hot_data;
 }
 
+storage::latency_histogram const &zero_copy_app_worker::get_latency() const noexcept
+{
+	return m_latency;
+}
+
 void zero_copy_app_worker::init(doca_dev *dev,
 				doca_comch_connection *comch_conn,
 				uint32_t task_count,
@@ -909,6 +995,10 @@ void zero_copy_app_worker::init(doca_dev *dev,
 	auto const page_size = storage::get_system_page_size();
 
 	m_hot_data.batch_size = batch_size;
+	m_hot_data.latency = std::addressof(m_latency);
+	m_request_start_times.resize(task_count);
+	m_hot_data.request_start_times = m_request_start_times.data();
+	m_hot_data.request_start_times_size = task_count;
 	auto const raw_io_messages_size = (task_count + batch_size) * storage::size_of_io_message * 2;
 
 	DOCA_LOG_DBG("Allocate comch buffers memory (%zu bytes, aligned to %u byte pages)",
@@ -1088,10 +1178,10 @@ void zero_copy_app_worker::doca_comch_consumer_task_post_recv_cb(doca_comch_cons
 								 doca_data task_user_data,
 								 doca_data ctx_user_data) noexcept
 {
-	static_cast<void>(task);
 	doca_error_t ret;
 
 	auto *const hot_data = static_cast<zero_copy_app_worker::hot_data *>(ctx_user_data.ptr);
+	hot_data->on_host_request(storage::get_buffer_bytes(doca_comch_consumer_task_post_recv_get_buf(task)));
 
 	/*
 	 * Submit send of the data to the storage backend. Note: both tasks share the same doca buf so the data message
@@ -1197,6 +1287,7 @@ void zero_copy_app_worker::doca_rdma_task_receive_cb(doca_rdma_task_receive *tas
 	auto *const hot_data = static_cast<zero_copy_app_worker::hot_data *>(ctx_user_data.ptr);
 
 	auto *const io_message = storage::get_buffer_bytes(doca_rdma_task_receive_get_dst_buf(task));
+	hot_data->on_storage_response(io_message);
 
 	storage::io_message_view::set_type(storage::io_message_type::result, io_message);
 	storage::io_message_view::set_result(DOCA_SUCCESS, io_message);
@@ -1277,6 +1368,7 @@ zero_copy_app::zero_copy_app(zero_copy_app_configuration const &cfg)
 	  m_remote_consumer_ids{},
 	  m_workers{nullptr},
 	  m_stats{},
+	  m_latency{},
 	  m_storage_capacity{},
 	  m_storage_block_size{},
 	  m_message_id_counter{},
@@ -1503,7 +1595,31 @@ void zero_copy_app::display_stats(void) const
 		printf("| Core: %u\n", stats.core_idx);
 		printf("| Operation count: %lu\n", stats.operation_count);
 		printf("| PE hit rate: %2.03lf%% (%lu:%lu)\n", pe_hit_rate_pct, stats.pe_hit_count, stats.pe_miss_count);
-	}
+		printf("| Latency: p50: %uus, p99: %uus, p99.99: %uus, max: %uus\n",
+		       stats.latency.percentiles[0],
+		       stats.latency.percentiles[2],
+		       stats.latency.percentiles[4],
+		       stats.latency.max);
+	}
+
+	printf("+================================================+\n");
+	printf("| Host request to storage response latency (all cores):\n");
+	printf("| \tMin: %uus\n", m_latency.min);
+	printf("| \tMax: %uus\n", m_latency.max);
+	printf("| \tMean: %uus\n", m_latency.mean);
+	for (size_t ii = 0; ii != storage::latency_report_percentiles.size(); ++ii) {
+		printf("| \tp%g: %uus\n", storage::latency_report_percentiles[ii], m_latency.percentiles[ii]);
+	}
+	printf("+================================================+\n");
+}
+
+void zero_copy_app::write_latency_report(void) const
+{
+	if (m_cfg.latency_report_file.empty())
+		return;
+
+	storage::write_latency_report(m_cfg.latency_report_file, "comch_to_rdma_zero_copy", m_latency, {});
+	DOCA_LOG_INFO("Latency report written to: %s", m_cfg.latency_report_file.c_str());
 }
 
 void zero_copy_app::new_comch_consumer_callback(void *user_data, uint32_t id) noexcept
@@ -1783,6 +1899,7 @@ storage::control::message zero_copy_app::process_stop_storage(storage::control::
 
 	if (storage_response.message_type == storage::control::message_type::stop_storage_response) {
 		/* Stop all processing */
+		storage::latency_histogram latency{};
 		m_stats.reserve(m_core_count);
 		for (uint32_t ii = 0; ii != m_core_count; ++ii) {
 			m_workers[ii].stop_processing();
@@ -1792,9 +1909,12 @@ storage::control::message zero_copy_app::process_stop_storage(storage::control::
 				hot_data.pe_hit_count,
 				hot_data.pe_miss_count,
 				hot_data.completed_transaction_count,
+				m_workers[ii].get_latency().summarise(),
 			});
+			latency.merge(m_workers[ii].get_latency());
 			m_workers[ii].destroy_comch_objects();
 		}
+		m_latency = latency.summarise();
 		return storage::control::message{
 			storage::control::message_type::stop_storage_response,
 			client_request.message_id,
@@ -24,14 +24,27 @@
  */
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <lz4frame.h>
 
 #include <doca_argp.h>
@@ -61,6 +74,8 @@ auto constexpr app_name = "doca_storage_gga_offload_sbc_generator";
 auto constexpr padding_byte = uint8_t{0};
 auto constexpr num_ec_tasks = uint32_t{1};
 auto constexpr num_ec_buffers = uint32_t{2} * num_ec_tasks;
+auto constexpr default_window_block_count = uint32_t{1024};
+auto constexpr windows_per_thread = uint32_t{2};
 
 struct gga_offload_sbc_gen_configuration {
 	std::string device_id;
@@ -70,6 +85,9 @@ struct gga_offload_sbc_gen_configuration {
 	std::string data_p_file_name;
 	std::string ec_matrix_type;
 	uint32_t block_size;
+	uint32_t thread_count;
+	uint32_t window_block_count;
+	bool streaming;
 };
 
 struct gga_offload_sbc_gen_result {
@@ -116,6 +134,16 @@ public:
 
 	gga_offload_sbc_gen_result generate_binary_content(std::vector<uint8_t> input_data);
 
+	/*
+	 * Calculate the parity of a compressed block using doca_ec
+	 *
+	 * @compressed_block [in]: block_size bytes of compressed block content
+	 * @parity [out]: block_size / 2 bytes of parity
+	 *
+	 * @throws std::runtime_error: If the doca_ec task fails
+	 */
+	void calculate_parity(uint8_t const *compressed_block, uint8_t *parity);
+
 private:
 	lz4_context m_lz4_ctx;
 	doca_dev *m_dev;
@@ -134,6 +162,131 @@ private:
 	bool m_error_flag;
 };
 
+/*
+ * Software implementation of the doca_ec 2 data block + 1 redundancy block encoding, used when no doca_ec capable
+ * device is available. Uses GF(2^8) (polynomial 0x11d) and the same ISA-L style generator matrix constructions as the
+ * named doca_ec matrix types.
+ */
+class software_ec_encoder {
+public:
+	explicit software_ec_encoder(std::string const &ec_matrix_type);
+
+	/*
+	 * Calculate parity = c1 * data_1 + c2 * data_2
+	 *
+	 * @data_1 [in]: First data block
+	 * @data_2 [in]: Second data block
+	 * @parity [out]: Parity block
+	 * @byte_count [in]: Size of each block
+	 */
+	void encode(uint8_t const *data_1, uint8_t const *data_2, uint8_t *parity, uint32_t byte_count) const noexcept;
+
+private:
+	std::array<std::array<uint8_t, 256>, 2> m_mul_tables;
+	bool m_xor_only;
+};
+
+/*
+ * Throughput counters of each stage of the streaming generator
+ */
+struct sbc_gen_stage_stats {
+	std::atomic<uint64_t> read_ns{0};
+	std::atomic<uint64_t> compress_ns{0};
+	std::atomic<uint64_t> parity_ns{0};
+	std::atomic<uint64_t> write_ns{0};
+};
+
+/*
+ * A window of consecutive blocks flowing through the streaming generator
+ */
+struct sbc_gen_window {
+	uint64_t sequence_number = 0;
+	uint32_t block_count = 0;
+	std::vector<uint8_t> input;
+	std::vector<uint8_t> compressed;
+	std::vector<uint8_t> parity;
+};
+
+/*
+ * Generate the sbc files without holding the whole input in memory. Windows of the input are read in order, compressed
+ * (and, without a doca_ec device, given parity) by a pool of worker threads, then put back into order by a bounded
+ * reorder buffer before being written out.
+ */
+class streaming_sbc_generator {
+public:
+	~streaming_sbc_generator();
+
+	streaming_sbc_generator() = delete;
+
+	/*
+	 * @cfg [in]: Configuration
+	 * @ec_app [in]: doca_ec parity generator, or nullptr to calculate parity in software
+	 */
+	streaming_sbc_generator(gga_offload_sbc_gen_configuration const &cfg, gga_offload_sbc_gen_app *ec_app);
+
+	streaming_sbc_generator(streaming_sbc_generator const &) = delete;
+
+	streaming_sbc_generator(streaming_sbc_generator &&) noexcept = delete;
+
+	streaming_sbc_generator &operator=(streaming_sbc_generator const &) = delete;
+
+	streaming_sbc_generator &operator=(streaming_sbc_generator &&) noexcept = delete;
+
+	/*
+	 * Generate all output files
+	 *
+	 * @return: Number of blocks generated
+	 *
+	 * @throws std::runtime_error: If any stage fails
+	 */
+	uint32_t run();
+
+	/*
+	 * Print the throughput of each stage, must be called after run
+	 */
+	void print_stats() const noexcept;
+
+private:
+	gga_offload_sbc_gen_configuration const &m_cfg;
+	gga_offload_sbc_gen_app *m_ec_app;
+	std::unique_ptr<software_ec_encoder> m_sw_ec;
+	int m_input_fd;
+	uint64_t m_input_size;
+	uint32_t m_block_count;
+	uint64_t m_window_count;
+	std::chrono::steady_clock::duration m_run_time;
+	sbc_gen_stage_stats m_stats;
+	std::mutex m_mtx;
+	std::condition_variable m_cv;
+	std::vector<std::unique_ptr<sbc_gen_window>> m_free_windows;
+	std::deque<std::unique_ptr<sbc_gen_window>> m_pending_windows;
+	std::map<uint64_t, std::unique_ptr<sbc_gen_window>> m_completed_windows;
+	std::exception_ptr m_error;
+	bool m_read_done;
+
+	/*
+	 * Read each window of the input in order
+	 */
+	void reader_proc() noexcept;
+
+	/*
+	 * Compress (and generate software parity) for windows until the input is exhausted
+	 */
+	void worker_proc() noexcept;
+
+	/*
+	 * Record the first error to occur and wake all threads so that they stop
+	 */
+	void set_error(std::exception_ptr error) noexcept;
+
+	/*
+	 * Fill a window from the input file, padding any partial final block
+	 *
+	 * @window [in/out]: Window to fill
+	 */
+	void read_window(sbc_gen_window &window);
+};
+
 /*
  * Print the parsed configuration
  *
@@ -159,6 +312,23 @@ gga_offload_sbc_gen_configuration parse_cli_args(int argc, char **argv);
  * @block_size [in]: Block size
  */
 void pad_input_to_multiple_of_block_size(std::vector<uint8_t> &input, uint32_t block_size);
+
+/*
+ * Compress a block into the internal storage format: header, LZ4 block data, zero padding
+ *
+ * @lz4_ctx [in]: Compression context to use
+ * @in_bytes [in]: block_size bytes of uncompressed data
+ * @out_bytes [out]: Output buffer, the first block_size bytes hold the result
+ * @out_bytes_size [in]: Size of the output buffer, must be at least 2 * block_size
+ * @block_size [in]: Block size
+ *
+ * @throws storage::runtime_error: If the block could not be compressed to fit within a block
+ */
+void compress_block(lz4_context &lz4_ctx,
+		    uint8_t const *in_bytes,
+		    uint8_t *out_bytes,
+		    uint32_t out_bytes_size,
+		    uint32_t block_size);
 } /* namespace */
 
 /*
@@ -178,6 +348,33 @@ int main(int argc, char **argv)
 		auto const cfg = parse_cli_args(argc, argv);
 		print_config(cfg);
 
+		if (cfg.streaming) {
+			std::unique_ptr<gga_offload_sbc_gen_app> ec_app;
+			if (!cfg.device_id.empty()) {
+				try {
+					ec_app = std::make_unique<gga_offload_sbc_gen_app>(cfg.device_id,
+											   cfg.ec_matrix_type,
+											   cfg.block_size);
+				} catch (std::exception const &ex) {
+					DOCA_LOG_WARN("doca_ec unavailable (%s), calculating parity in software",
+						      ex.what());
+				}
+			}
+
+			streaming_sbc_generator generator{cfg, ec_app.get()};
+			printf("Processing data...\n");
+			auto const block_count = generator.run();
+
+			printf("Output info:\n");
+			printf("\tBlock size: %u\n", cfg.block_size);
+			printf("\tOut block count: %u\n", block_count);
+			printf("\tData 1(%s) created successfully\n", cfg.data_1_file_name.c_str());
+			printf("\tData 2(%s) created successfully\n", cfg.data_2_file_name.c_str());
+			printf("\tData p(%s) created successfully\n", cfg.data_p_file_name.c_str());
+			generator.print_stats();
+			return rc;
+		}
+
 		gga_offload_sbc_gen_app app{cfg.device_id, cfg.ec_matrix_type, cfg.block_size};
 
 		auto input_data = storage::load_file_bytes(cfg.original_data_file_name);
@@ -225,6 +422,11 @@ void print_config(gga_offload_sbc_gen_configuration const &cfg) noexcept
 	printf("\tdata_1_file : \"%s\",\n", cfg.data_1_file_name.c_str());
 	printf("\tdata_2_file : \"%s\",\n", cfg.data_2_file_name.c_str());
 	printf("\tdata_p_file : \"%s\",\n", cfg.data_p_file_name.c_str());
+	printf("\tstreaming : %s,\n", cfg.streaming ? "true" : "false");
+	if (cfg.streaming) {
+		printf("\tthread_count : %u,\n", cfg.thread_count);
+		printf("\twindow_block_count : %u,\n", cfg.window_block_count);
+	}
 	printf("}\n");
 }
 
@@ -234,6 +436,9 @@ gga_offload_sbc_gen_configuration parse_cli_args(int argc, char **argv)
 	gga_offload_sbc_gen_configuration config{};
 	config.block_size = 4096;
 	config.ec_matrix_type = "vandermonde";
+	config.thread_count = std::max(1u, std::thread::hardware_concurrency());
+	config.window_block_count = default_window_block_count;
+	config.streaming = false;
 
 	ret = doca_argp_init(app_name, &config);
 	if (ret != DOCA_SUCCESS) {
@@ -243,8 +448,8 @@ gga_offload_sbc_gen_configuration parse_cli_args(int argc, char **argv)
 	storage::register_cli_argument(DOCA_ARGP_TYPE_STRING,
 				       "d",
 				       "device",
-				       "Device identifier",
-				       storage::required_value,
+				       "Device identifier. Optional in streaming mode, parity is calculated in software without it",
+				       storage::optional_value,
 				       storage::single_value,
 				       [](void *value, void *cfg) noexcept {
 					       static_cast<gga_offload_sbc_gen_configuration *>(cfg)->device_id =
@@ -319,6 +524,40 @@ gga_offload_sbc_gen_configuration parse_cli_args(int argc, char **argv)
 					       return DOCA_SUCCESS;
 				       });
 
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_BOOLEAN,
+		nullptr,
+		"streaming",
+		"Read the input in windows and process it with a pool of threads instead of loading it all into memory",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<gga_offload_sbc_gen_configuration *>(cfg)->streaming = *static_cast<bool *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(DOCA_ARGP_TYPE_INT,
+				       nullptr,
+				       "thread-count",
+				       "Streaming mode: Number of compression threads. Default: number of CPUs",
+				       storage::optional_value,
+				       storage::single_value,
+				       [](void *value, void *cfg) noexcept {
+					       static_cast<gga_offload_sbc_gen_configuration *>(cfg)->thread_count =
+						       *static_cast<int *>(value);
+					       return DOCA_SUCCESS;
+				       });
+	storage::register_cli_argument(DOCA_ARGP_TYPE_INT,
+				       nullptr,
+				       "window-block-count",
+				       "Streaming mode: Number of blocks read and processed as a unit. Default: 1024",
+				       storage::optional_value,
+				       storage::single_value,
+				       [](void *value, void *cfg) noexcept {
+					       auto *config = static_cast<gga_offload_sbc_gen_configuration *>(cfg);
+					       config->window_block_count = *static_cast<int *>(value);
+					       return DOCA_SUCCESS;
+				       });
+
 	ret = doca_argp_start(argc, argv);
 	if (ret != DOCA_SUCCESS) {
 		throw storage::runtime_error{ret, "Failed to parse CLI args: "s + doca_error_get_name(ret)};
@@ -326,10 +565,20 @@ gga_offload_sbc_gen_configuration parse_cli_args(int argc, char **argv)
 
 	static_cast<void>(doca_argp_destroy());
 
-	if (config.block_size % 64 != 0) {
+	if (config.block_size == 0 || config.block_size % 64 != 0) {
 		// doca_ec requires buffers to be a multiple of 64 bytes of data
 		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE, "Block size must be a multiple of 64"};
 	}
+
+	if (!config.streaming && config.device_id.empty()) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "A device is required when not in streaming mode"};
+	}
+
+	if (config.thread_count == 0 || config.window_block_count == 0) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "thread-count and window-block-count must not be zero"};
+	}
 	return config;
 }
 
@@ -638,13 +887,83 @@ uint32_t get_out_byte_count(doca_ec_task_create *task)
 	return buf_len;
 }
 
-gga_offload_sbc_gen_result gga_offload_sbc_gen_app::generate_binary_content(std::vector<uint8_t> input_data)
+void compress_block(lz4_context &lz4_ctx,
+		    uint8_t const *in_bytes,
+		    uint8_t *out_bytes,
+		    uint32_t out_bytes_size,
+		    uint32_t block_size)
 {
-	doca_error_t ret;
 	auto const metadata_header_size = sizeof(storage::compressed_block_header);
 	auto const metadata_trailer_size = sizeof(storage::compressed_block_trailer);
 	auto const metadata_overhead_size = metadata_header_size + metadata_trailer_size;
 
+	// Compress the data
+	auto const compresed_size = lz4_ctx.compress(in_bytes,
+						     block_size,
+						     out_bytes + metadata_header_size,
+						     out_bytes_size - metadata_overhead_size);
+
+	if (compresed_size + metadata_overhead_size > block_size) {
+		throw storage::runtime_error{
+			DOCA_ERROR_INVALID_VALUE,
+			"Data was not compressible enough to be held in internal storage format. Max compressed size of a block is : " +
+				std::to_string(block_size - metadata_overhead_size) +
+				". Block compressed to a size of: " + std::to_string(compresed_size)};
+	}
+
+	storage::compressed_block_header const hdr{
+		htobe32(block_size),
+		htobe32(compresed_size),
+	};
+	std::copy(reinterpret_cast<char const *>(&hdr), reinterpret_cast<char const *>(&hdr) + sizeof(hdr), out_bytes);
+
+	// apply padding
+	::memset(out_bytes + metadata_header_size + compresed_size,
+		 0,
+		 out_bytes_size - (metadata_header_size + compresed_size + metadata_trailer_size));
+}
+
+void gga_offload_sbc_gen_app::calculate_parity(uint8_t const *compressed_block, uint8_t *parity)
+{
+	doca_error_t ret;
+
+	if (compressed_block != m_compressed_bytes_buffer.data()) {
+		std::copy(compressed_block, compressed_block + m_block_size, m_compressed_bytes_buffer.data());
+	}
+
+	// generate EC blocks
+	static_cast<void>(doca_buf_set_data(m_input_buf, m_compressed_bytes_buffer.data(), m_block_size));
+	static_cast<void>(doca_buf_reset_data_len(m_output_buf));
+
+	ret = doca_task_submit(doca_ec_task_create_as_task(m_ec_task));
+	if (ret != DOCA_SUCCESS) {
+		throw std::runtime_error{"Failed to submit doca_ec task: "s + doca_error_get_name(ret)};
+	}
+
+	for (;;) {
+		size_t in_flight_count = 0;
+		static_cast<void>(doca_ctx_get_num_inflight_tasks(doca_ec_as_ctx(m_ec), &in_flight_count));
+		if (in_flight_count) {
+			static_cast<void>(doca_pe_progress(m_pe));
+		} else {
+			if (m_error_flag)
+				throw std::runtime_error{"Failed to execute doca_ec task"};
+			else
+				break;
+		}
+	}
+
+	if (get_out_byte_count(m_ec_task) != (m_block_size / 2)) {
+		throw std::runtime_error{"doca_ec task return invalid result"};
+	}
+
+	std::copy(std::begin(m_gga_output_buffer_bytes),
+		  std::begin(m_gga_output_buffer_bytes) + (m_block_size / 2),
+		  parity);
+}
+
+gga_offload_sbc_gen_result gga_offload_sbc_gen_app::generate_binary_content(std::vector<uint8_t> input_data)
+{
 	auto const total_block_count = input_data.size() / m_block_size;
 
 	gga_offload_sbc_gen_result out_data;
@@ -653,39 +972,14 @@ gga_offload_sbc_gen_result gga_offload_sbc_gen_app::generate_binary_content(std:
 	out_data.data_2_content.reserve(input_data.size() / 2);
 	out_data.data_p_content.reserve(input_data.size() / 2);
 
-	for (uint32_t ii = 0; ii != total_block_count; ++ii) {
-		// Compress the data
-		auto const compresed_size =
-			m_lz4_ctx.compress(input_data.data() + (ii * m_block_size),
-					   m_block_size,
-					   m_compressed_bytes_buffer.data() + metadata_header_size,
-					   m_compressed_bytes_buffer.size() - metadata_overhead_size);
-
-		if (compresed_size + metadata_overhead_size > m_block_size) {
-			throw storage::runtime_error{
-				DOCA_ERROR_INVALID_VALUE,
-				"Data was not compressible enough to be held in internal storage format. Max compressed size of a block is : " +
-					std::to_string(m_block_size - metadata_overhead_size) +
-					". Block compressed to a size of: " + std::to_string(compresed_size)};
-		}
+	std::vector<uint8_t> parity(m_block_size / 2);
 
-		storage::compressed_block_header const hdr{
-			htobe32(m_block_size),
-			htobe32(compresed_size),
-		};
-		std::copy(reinterpret_cast<char const *>(&hdr),
-			  reinterpret_cast<char const *>(&hdr) + sizeof(hdr),
-			  m_compressed_bytes_buffer.data());
-
-		// apply padding
-		{
-			::memset(m_compressed_bytes_buffer.data() + metadata_header_size + compresed_size,
-				 0,
-				 m_compressed_bytes_buffer.size() -
-					 (metadata_header_size + compresed_size + metadata_trailer_size));
-		}
-
-		// auto half_way_iter = std::begin(m_gga_input_buffer_bytes) + (m_gga_input_buffer_bytes.size() / 2);
+	for (uint32_t ii = 0; ii != total_block_count; ++ii) {
+		compress_block(m_lz4_ctx,
+			       input_data.data() + (ii * m_block_size),
+			       m_compressed_bytes_buffer.data(),
+			       m_compressed_bytes_buffer.size(),
+			       m_block_size);
 
 		// TMP: write the full compressed data to both data files, and duplicate data in the party file to
 		// simplify address translation in the DPU
@@ -699,47 +993,415 @@ gga_offload_sbc_gen_result gga_offload_sbc_gen_app::generate_binary_content(std:
 			  m_compressed_bytes_buffer.data() + m_block_size,
 			  std::back_inserter(out_data.data_2_content));
 
-		// generate EC blocks
-		static_cast<void>(doca_buf_set_data(m_input_buf, m_compressed_bytes_buffer.data(), m_block_size));
-		static_cast<void>(doca_buf_reset_data_len(m_output_buf));
+		calculate_parity(m_compressed_bytes_buffer.data(), parity.data());
 
-		ret = doca_task_submit(doca_ec_task_create_as_task(m_ec_task));
-		if (ret != DOCA_SUCCESS) {
-			throw std::runtime_error{"Failed to submit doca_ec task: "s + doca_error_get_name(ret)};
+		std::copy(std::begin(parity), std::end(parity), std::back_inserter(out_data.data_p_content));
+		std::copy(std::begin(parity), std::end(parity), std::back_inserter(out_data.data_p_content));
+	}
+
+	DOCA_LOG_TRC("Out data: { block_count: %u, d1_size: %zu, d2_size: %zu, p_size: %zu}",
+		     out_data.block_count,
+		     out_data.data_1_content.size(),
+		     out_data.data_2_content.size(),
+		     out_data.data_p_content.size());
+
+	return out_data;
+}
+
+uint8_t gf_mul(uint8_t a, uint8_t b) noexcept
+{
+	uint8_t product = 0;
+	while (b != 0) {
+		if (b & 1)
+			product ^= a;
+		a = (a & 0x80) ? static_cast<uint8_t>((a << 1) ^ 0x1d) : static_cast<uint8_t>(a << 1);
+		b >>= 1;
+	}
+	return product;
+}
+
+uint8_t gf_inv(uint8_t a) noexcept
+{
+	/* a^254 == a^-1 in GF(2^8) */
+	uint8_t result = 1;
+	for (uint32_t ii = 0; ii != 254; ++ii)
+		result = gf_mul(result, a);
+	return result;
+}
+
+software_ec_encoder::software_ec_encoder(std::string const &ec_matrix_type) : m_mul_tables{}, m_xor_only{false}
+{
+	std::array<uint8_t, 2> coefficients{};
+	switch (storage::matrix_type_from_string(ec_matrix_type)) {
+	case DOCA_EC_MATRIX_TYPE_VANDERMONDE:
+		/* first redundancy row of a vandermonde generator matrix: 1^0, 1^1 */
+		coefficients = {1, 1};
+		break;
+	case DOCA_EC_MATRIX_TYPE_CAUCHY:
+		/* first redundancy row (i = 2) of a cauchy generator matrix: 1 / (i ^ j) */
+		coefficients = {gf_inv(2 ^ 0), gf_inv(2 ^ 1)};
+		break;
+	default:
+		throw storage::runtime_error{DOCA_ERROR_NOT_SUPPORTED,
+					     "Unsupported matrix type for software parity: " + ec_matrix_type};
+	}
+
+	m_xor_only = coefficients[0] == 1 && coefficients[1] == 1;
+	for (uint32_t ii = 0; ii != coefficients.size(); ++ii) {
+		for (uint32_t value = 0; value != 256; ++value)
+			m_mul_tables[ii][value] = gf_mul(static_cast<uint8_t>(value), coefficients[ii]);
+	}
+}
+
+void software_ec_encoder::encode(uint8_t const *data_1,
+				 uint8_t const *data_2,
+				 uint8_t *parity,
+				 uint32_t byte_count) const noexcept
+{
+	if (m_xor_only) {
+		uint32_t ii = 0;
+		for (; ii + sizeof(uint64_t) <= byte_count; ii += sizeof(uint64_t)) {
+			uint64_t a;
+			uint64_t b;
+			::memcpy(&a, data_1 + ii, sizeof(a));
+			::memcpy(&b, data_2 + ii, sizeof(b));
+			a ^= b;
+			::memcpy(parity + ii, &a, sizeof(a));
 		}
+		for (; ii != byte_count; ++ii)
+			parity[ii] = data_1[ii] ^ data_2[ii];
+		return;
+	}
 
-		for (;;) {
-			size_t in_flight_count = 0;
-			static_cast<void>(doca_ctx_get_num_inflight_tasks(doca_ec_as_ctx(m_ec), &in_flight_count));
-			if (in_flight_count) {
-				static_cast<void>(doca_pe_progress(m_pe));
-			} else {
-				if (m_error_flag)
-					throw std::runtime_error{"Failed to execute doca_ec task"};
-				else
+	auto const &mul_1 = m_mul_tables[0];
+	auto const &mul_2 = m_mul_tables[1];
+	for (uint32_t ii = 0; ii != byte_count; ++ii)
+		parity[ii] = mul_1[data_1[ii]] ^ mul_2[data_2[ii]];
+}
+
+double to_mb_per_second(uint64_t byte_count, uint64_t nanoseconds) noexcept
+{
+	if (nanoseconds == 0)
+		return 0.;
+
+	return (static_cast<double>(byte_count) / (1024. * 1024.)) / (static_cast<double>(nanoseconds) / 1e9);
+}
+
+uint64_t nanoseconds_since(std::chrono::steady_clock::time_point start) noexcept
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+streaming_sbc_generator::~streaming_sbc_generator()
+{
+	if (m_input_fd != -1) {
+		close(m_input_fd);
+		m_input_fd = -1;
+	}
+}
+
+streaming_sbc_generator::streaming_sbc_generator(gga_offload_sbc_gen_configuration const &cfg,
+						 gga_offload_sbc_gen_app *ec_app)
+	: m_cfg{cfg},
+	  m_ec_app{ec_app},
+	  m_sw_ec{},
+	  m_input_fd{-1},
+	  m_input_size{0},
+	  m_block_count{0},
+	  m_window_count{0},
+	  m_run_time{},
+	  m_stats{},
+	  m_mtx{},
+	  m_cv{},
+	  m_free_windows{},
+	  m_pending_windows{},
+	  m_completed_windows{},
+	  m_error{},
+	  m_read_done{false}
+{
+	if (m_ec_app == nullptr) {
+		m_sw_ec = std::make_unique<software_ec_encoder>(m_cfg.ec_matrix_type);
+	}
+
+	m_input_fd = open(m_cfg.original_data_file_name.c_str(), O_RDONLY);
+	if (m_input_fd == -1) {
+		throw storage::runtime_error{DOCA_ERROR_NOT_FOUND,
+					     "Unable to open input file: " + m_cfg.original_data_file_name};
+	}
+
+	struct stat st {};
+	if (fstat(m_input_fd, &st) != 0) {
+		throw storage::runtime_error{DOCA_ERROR_IO_FAILED,
+					     "Unable to query size of input file: " + m_cfg.original_data_file_name};
+	}
+
+	/* The input is read once, front to back */
+	static_cast<void>(posix_fadvise(m_input_fd, 0, 0, POSIX_FADV_SEQUENTIAL));
+
+	m_input_size = st.st_size;
+	auto const block_count = (m_input_size + m_cfg.block_size - 1) / m_cfg.block_size;
+	if (block_count > std::numeric_limits<uint32_t>::max()) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "Input file requires more blocks than can be described: " +
+						     std::to_string(block_count)};
+	}
+
+	m_block_count = static_cast<uint32_t>(block_count);
+	m_window_count = (block_count + m_cfg.window_block_count - 1) / m_cfg.window_block_count;
+
+	/* The window pool bounds both the memory used and the depth of the reorder buffer */
+	auto const window_bytes = size_t{m_cfg.window_block_count} * m_cfg.block_size;
+	auto const window_pool_size = std::min(uint64_t{m_cfg.thread_count * windows_per_thread}, m_window_count);
+	m_free_windows.reserve(window_pool_size);
+	for (uint64_t ii = 0; ii != window_pool_size; ++ii) {
+		auto window = std::make_unique<sbc_gen_window>();
+		window->input.resize(window_bytes);
+		window->compressed.resize(window_bytes);
+		window->parity.resize(window_bytes);
+		m_free_windows.push_back(std::move(window));
+	}
+}
+
+uint32_t streaming_sbc_generator::run()
+{
+	auto const start_time = std::chrono::steady_clock::now();
+
+	storage::binary_content_writer data_1_writer{m_cfg.data_1_file_name, m_cfg.block_size, m_block_count};
+	storage::binary_content_writer data_2_writer{m_cfg.data_2_file_name, m_cfg.block_size, m_block_count};
+	storage::binary_content_writer data_p_writer{m_cfg.data_p_file_name, m_cfg.block_size, m_block_count};
+
+	std::vector<std::thread> threads;
+	threads.reserve(m_cfg.thread_count + 1);
+	threads.emplace_back([this]() {
+		reader_proc();
+	});
+	for (uint32_t ii = 0; ii != m_cfg.thread_count; ++ii) {
+		threads.emplace_back([this]() {
+			worker_proc();
+		});
+	}
+
+	try {
+		auto const half_block_size = m_cfg.block_size / 2;
+		for (uint64_t seq = 0; seq != m_window_count; ++seq) {
+			std::unique_ptr<sbc_gen_window> window;
+			{
+				std::unique_lock<std::mutex> lock{m_mtx};
+				m_cv.wait(lock, [this, seq]() {
+					return m_error || m_completed_windows.count(seq) != 0;
+				});
+				if (m_error)
 					break;
+
+				auto iter = m_completed_windows.find(seq);
+				window = std::move(iter->second);
+				m_completed_windows.erase(iter);
+			}
+
+			if (m_ec_app != nullptr) {
+				auto const parity_start = std::chrono::steady_clock::now();
+				for (uint32_t ii = 0; ii != window->block_count; ++ii) {
+					auto const offset = size_t{ii} * m_cfg.block_size;
+					auto *parity = window->parity.data() + offset;
+					m_ec_app->calculate_parity(window->compressed.data() + offset, parity);
+					std::copy(parity, parity + half_block_size, parity + half_block_size);
+				}
+				m_stats.parity_ns += nanoseconds_since(parity_start);
+			}
+
+			// TMP: write the full compressed data to both data files, see generate_binary_content
+			auto const write_start = std::chrono::steady_clock::now();
+			auto const byte_count = size_t{window->block_count} * m_cfg.block_size;
+			data_1_writer.write(window->compressed.data(), byte_count);
+			data_2_writer.write(window->compressed.data(), byte_count);
+			data_p_writer.write(window->parity.data(), byte_count);
+			m_stats.write_ns += nanoseconds_since(write_start);
+
+			{
+				std::lock_guard<std::mutex> lock{m_mtx};
+				m_free_windows.push_back(std::move(window));
+			}
+			m_cv.notify_all();
+		}
+	} catch (...) {
+		set_error(std::current_exception());
+	}
+
+	for (auto &thread : threads)
+		thread.join();
+
+	if (m_error)
+		std::rethrow_exception(m_error);
+
+	auto const write_start = std::chrono::steady_clock::now();
+	data_1_writer.finish();
+	data_2_writer.finish();
+	data_p_writer.finish();
+	m_stats.write_ns += nanoseconds_since(write_start);
+
+	m_run_time = std::chrono::steady_clock::now() - start_time;
+	return m_block_count;
+}
+
+void streaming_sbc_generator::print_stats() const noexcept
+{
+	auto const run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(m_run_time).count();
+	auto const compress_ns = m_stats.compress_ns.load();
+	auto const parity_ns = m_stats.parity_ns.load();
+
+	printf("Stage throughput (MB/s of input, while busy):\n");
+	printf("\tread      : %.02lf\n", to_mb_per_second(m_input_size, m_stats.read_ns));
+	printf("\tcompress  : %.02lf per thread, %.02lf across %u threads\n",
+	       to_mb_per_second(m_input_size, compress_ns),
+	       to_mb_per_second(m_input_size, compress_ns / m_cfg.thread_count),
+	       m_cfg.thread_count);
+	if (m_ec_app != nullptr) {
+		printf("\tparity    : %.02lf (doca_ec)\n", to_mb_per_second(m_input_size, parity_ns));
+	} else {
+		printf("\tparity    : %.02lf per thread, %.02lf across %u threads (software)\n",
+		       to_mb_per_second(m_input_size, parity_ns),
+		       to_mb_per_second(m_input_size, parity_ns / m_cfg.thread_count),
+		       m_cfg.thread_count);
+	}
+	printf("\twrite     : %.02lf\n", to_mb_per_second(m_input_size, m_stats.write_ns));
+	printf("\toverall   : %.02lf\n", to_mb_per_second(m_input_size, run_ns));
+}
+
+void streaming_sbc_generator::reader_proc() noexcept
+{
+	try {
+		for (uint64_t seq = 0; seq != m_window_count; ++seq) {
+			std::unique_ptr<sbc_gen_window> window;
+			{
+				std::unique_lock<std::mutex> lock{m_mtx};
+				m_cv.wait(lock, [this]() {
+					return m_error || !m_free_windows.empty();
+				});
+				if (m_error)
+					return;
+
+				window = std::move(m_free_windows.back());
+				m_free_windows.pop_back();
+			}
+
+			auto const read_start = std::chrono::steady_clock::now();
+			window->sequence_number = seq;
+			read_window(*window);
+			m_stats.read_ns += nanoseconds_since(read_start);
+
+			{
+				std::lock_guard<std::mutex> lock{m_mtx};
+				m_pending_windows.push_back(std::move(window));
 			}
+			m_cv.notify_all();
 		}
+	} catch (...) {
+		set_error(std::current_exception());
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{m_mtx};
+		m_read_done = true;
+	}
+	m_cv.notify_all();
+}
+
+void streaming_sbc_generator::worker_proc() noexcept
+{
+	try {
+		lz4_context lz4_ctx{};
+		std::vector<uint8_t> compress_buffer(size_t{m_cfg.block_size} * 2, padding_byte);
+		auto const half_block_size = m_cfg.block_size / 2;
 
-		if (get_out_byte_count(m_ec_task) != (m_block_size / 2)) {
-			throw std::runtime_error{"doca_ec task return invalid result"};
+		for (;;) {
+			std::unique_ptr<sbc_gen_window> window;
+			{
+				std::unique_lock<std::mutex> lock{m_mtx};
+				m_cv.wait(lock, [this]() {
+					return m_error || m_read_done || !m_pending_windows.empty();
+				});
+				if (m_error || m_pending_windows.empty())
+					return;
+
+				window = std::move(m_pending_windows.front());
+				m_pending_windows.pop_front();
+			}
+
+			auto const compress_start = std::chrono::steady_clock::now();
+			for (uint32_t ii = 0; ii != window->block_count; ++ii) {
+				auto const offset = size_t{ii} * m_cfg.block_size;
+				compress_block(lz4_ctx,
+					       window->input.data() + offset,
+					       compress_buffer.data(),
+					       compress_buffer.size(),
+					       m_cfg.block_size);
+				std::copy(compress_buffer.data(),
+					  compress_buffer.data() + m_cfg.block_size,
+					  window->compressed.data() + offset);
+			}
+			m_stats.compress_ns += nanoseconds_since(compress_start);
+
+			if (m_sw_ec) {
+				auto const parity_start = std::chrono::steady_clock::now();
+				for (uint32_t ii = 0; ii != window->block_count; ++ii) {
+					auto const offset = size_t{ii} * m_cfg.block_size;
+					auto const *block = window->compressed.data() + offset;
+					auto *parity = window->parity.data() + offset;
+					m_sw_ec->encode(block, block + half_block_size, parity, half_block_size);
+					// duplicate the parity, see generate_binary_content
+					std::copy(parity, parity + half_block_size, parity + half_block_size);
+				}
+				m_stats.parity_ns += nanoseconds_since(parity_start);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock{m_mtx};
+				auto const seq = window->sequence_number;
+				m_completed_windows.emplace(seq, std::move(window));
+			}
+			m_cv.notify_all();
 		}
+	} catch (...) {
+		set_error(std::current_exception());
+	}
+}
 
-		std::copy(std::begin(m_gga_output_buffer_bytes),
-			  std::begin(m_gga_output_buffer_bytes) + (m_block_size / 2),
-			  std::back_inserter(out_data.data_p_content));
-		std::copy(std::begin(m_gga_output_buffer_bytes),
-			  std::begin(m_gga_output_buffer_bytes) + (m_block_size / 2),
-			  std::back_inserter(out_data.data_p_content));
+void streaming_sbc_generator::set_error(std::exception_ptr error) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mtx};
+		if (!m_error)
+			m_error = std::move(error);
 	}
+	m_cv.notify_all();
+}
 
-	DOCA_LOG_TRC("Out data: { block_count: %u, d1_size: %zu, d2_size: %zu, p_size: %zu}",
-		     out_data.block_count,
-		     out_data.data_1_content.size(),
-		     out_data.data_2_content.size(),
-		     out_data.data_p_content.size());
+void streaming_sbc_generator::read_window(sbc_gen_window &window)
+{
+	auto const first_block = window.sequence_number * m_cfg.window_block_count;
+	window.block_count =
+		static_cast<uint32_t>(std::min(uint64_t{m_cfg.window_block_count}, m_block_count - first_block));
+
+	auto const window_size = size_t{window.block_count} * m_cfg.block_size;
+	auto const read_size = std::min(uint64_t{window_size}, m_input_size - (first_block * m_cfg.block_size));
+
+	size_t read_count = 0;
+	while (read_count != read_size) {
+		auto const ret = ::read(m_input_fd, window.input.data() + read_count, read_size - read_count);
+		if (ret < 0 && errno == EINTR)
+			continue;
+
+		if (ret <= 0) {
+			throw storage::runtime_error{DOCA_ERROR_IO_FAILED,
+						     "Failed to read input file: " + m_cfg.original_data_file_name};
+		}
 
-	return out_data;
+		read_count += ret;
+	}
+
+	// pad the final block
+	std::fill(window.input.data() + read_size, window.input.data() + window_size, padding_byte);
 }
 
 } // namespace
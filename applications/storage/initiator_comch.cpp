@@ -53,6 +53,8 @@
 #include <storage_common/definitions.hpp>
 #include <storage_common/file_utils.hpp>
 #include <storage_common/io_message.hpp>
+#include <storage_common/io_workload.hpp>
+#include <storage_common/latency_histogram.hpp>
 #include <storage_common/os_utils.hpp>
 #include <storage_common/doca_utils.hpp>
 
@@ -68,12 +70,17 @@ auto constexpr run_type_read_throughout_test = "read_throughput_test";
 auto constexpr run_type_write_throughout_test = "write_throughput_test";
 auto constexpr run_type_read_write_data_validity_test = "read_write_data_validity_test";
 auto constexpr run_type_read_only_data_validity_test = "read_only_data_validity_test";
+auto constexpr run_type_mixed_workload_test = "mixed_workload_test";
 
 auto constexpr default_control_timeout_seconds = std::chrono::seconds{5};
 auto constexpr default_task_count = 64;
 auto constexpr default_command_channel_name = "doca_storage_comch";
 auto constexpr default_run_limit_operation_count = 1'000'000;
 auto constexpr default_batch_size = 4;
+auto constexpr stats_poll_period = std::chrono::milliseconds{200};
+auto constexpr default_read_percent = 70;
+auto constexpr default_access_pattern = "uniform";
+auto constexpr run_duration_check_poll_count = 1024;
 
 static_assert(sizeof(void *) == 8, "Expected a pointer to occupy 8 bytes");
 static_assert(sizeof(std::chrono::steady_clock::time_point) == 8,
@@ -88,10 +95,17 @@ struct initiator_comch_app_configuration {
 	std::string command_channel_name = {};
 	std::string storage_plain_content_file = {};
 	std::string run_type = {};
+	std::string latency_report_file = {};
 	std::chrono::seconds control_timeout = {};
+	std::chrono::milliseconds latency_interval = {};
+	std::chrono::seconds run_duration = {};
+	storage::io_workload_configuration workload = {};
 	uint32_t task_count = 0;
 	uint32_t run_limit_operation_count = 0;
 	uint32_t batch_size = 0;
+	uint32_t queue_depth = 0;
+	uint32_t target_iops = 0;
+	uint32_t workload_seed = 0;
 };
 
 /*
@@ -103,9 +117,8 @@ struct initiator_comch_app_stats {
 	uint64_t pe_hit_count = 0;
 	uint64_t pe_miss_count = 0;
 	uint64_t operation_count = 0;
-	uint32_t latency_min = 0;
-	uint32_t latency_max = 0;
-	uint32_t latency_mean = 0;
+	storage::latency_summary latency = {};
+	std::vector<storage::latency_interval> latency_intervals = {};
 };
 
 /*
@@ -124,6 +137,22 @@ struct transaction_context {
 
 static_assert(sizeof(transaction_context) == 24, "Expected transaction_context to occupy 24 bytes");
 
+/*
+ * Per thread state of the mixed workload test
+ */
+struct workload_state {
+	storage::io_workload_generator generator;
+	/* open loop: transactions that are not in flight */
+	std::vector<transaction_context *> idle_transactions;
+	/* open loop: time between the intended start of each request */
+	std::chrono::steady_clock::duration issue_interval;
+	/* zero to run until the operation count is reached */
+	std::chrono::seconds run_duration;
+	/* closed loop: number of transactions kept in flight */
+	uint32_t queue_depth;
+	bool open_loop;
+};
+
 /*
  * Data required for a thread worker
  */
@@ -149,9 +178,8 @@ public:
 		uint64_t completed_transaction_count;
 		uint64_t remaining_tx_ops;
 		uint64_t remaining_rx_ops;
-		uint64_t latency_accumulator;
-		uint32_t latency_min;
-		uint32_t latency_max;
+		storage::latency_histogram *latency;
+		workload_state *workload;
 		uint8_t batch_count;
 		uint8_t batch_size;
 		std::atomic_bool run_flag;
@@ -274,9 +302,24 @@ public:
 	 * @core_id [in]: Core to run on
 	 */
 	void prepare_thread_proc(initiator_comch_worker::thread_proc_fn_t fn,
-				 uint32_t run_limit_op_count,
+				 uint64_t run_limit_op_count,
 				 uint32_t core_id);
 
+	/*
+	 * Prepare the state used by workload_thread_proc
+	 *
+	 * @cfg [in]: Workload parameters
+	 * @queue_depth [in]: Closed loop: Number of transactions to keep in flight
+	 * @target_iops [in]: Open loop: Rate at which to start transactions, zero to run closed loop
+	 * @run_duration [in]: Time to run for, zero to run until the operation count is reached
+	 * @seed [in]: Seed for the workload random number generator
+	 */
+	void prepare_workload(storage::io_workload_configuration const &cfg,
+			      uint32_t queue_depth,
+			      uint32_t target_iops,
+			      std::chrono::seconds run_duration,
+			      uint64_t seed);
+
 	/*
 	 * Prepare tasks required for the data path
 	 *
@@ -316,6 +359,13 @@ public:
 	 */
 	[[nodiscard]] hot_data const &get_hot_data(void) const noexcept;
 
+	/*
+	 * Get a reference to the workers latency histogram
+	 *
+	 * @return: A reference to the histogram of the latency (in micro seconds) of every completed transaction
+	 */
+	[[nodiscard]] storage::latency_histogram const &get_latency(void) const noexcept;
+
 	/*
 	 * Get a reference to the workers hot data
 	 *
@@ -325,6 +375,8 @@ public:
 
 private:
 	hot_data m_hot_data;
+	storage::latency_histogram m_latency;
+	std::unique_ptr<workload_state> m_workload;
 	uint8_t *m_io_message_region;
 	doca_mmap *m_io_message_mmap;
 	doca_buf_inventory *m_io_message_inv;
@@ -479,6 +531,13 @@ public:
 	 */
 	void display_stats(void) const;
 
+	/*
+	 * Write the latency report file (if one was requested)
+	 *
+	 * @throws std::runtime_error: If the report file cannot be written
+	 */
+	void write_latency_report(void) const;
+
 	/*
 	 * Shutdown storage resources
 	 */
@@ -529,6 +588,13 @@ private:
 	storage::control::message wait_for_control_response(storage::control::message_type type,
 							    storage::control::message_id msg_id,
 							    std::chrono::seconds timeout);
+
+	/*
+	 * Merge the latency histograms of all workers
+	 *
+	 * @merged [out]: Histogram to merge into (any previous content is discarded)
+	 */
+	void merge_worker_latency(storage::latency_histogram &merged) const noexcept;
 };
 
 /*
@@ -574,6 +640,7 @@ int main(int argc, char **argv)
 		app.stop_storage();
 		if (run_success) {
 			app.display_stats();
+			app.write_latency_report();
 		} else {
 			exit_value = EXIT_FAILURE;
 			fprintf(stderr, "+================================================+\n");
@@ -623,6 +690,19 @@ void print_config(initiator_comch_app_configuration const &cfg) noexcept
 	printf("\tbatch_size : %u,\n", cfg.batch_size);
 	printf("\trun_limit_operation_count : %u,\n", cfg.run_limit_operation_count);
 	printf("\tcontrol_timeout : %u,\n", static_cast<uint32_t>(cfg.control_timeout.count()));
+	printf("\tlatency_interval_ms : %u,\n", static_cast<uint32_t>(cfg.latency_interval.count()));
+	printf("\tlatency_report : \"%s\",\n", cfg.latency_report_file.c_str());
+	if (cfg.run_type == run_type_mixed_workload_test) {
+		printf("\tread_percent : %u,\n", cfg.workload.read_percent);
+		printf("\taccess_pattern : \"%s\",\n", storage::to_string(cfg.workload.distribution));
+		printf("\tzipf_theta : %.03lf,\n", cfg.workload.zipf_theta);
+		printf("\thot_set_percent : %u,\n", cfg.workload.hot_set_percent);
+		printf("\thot_access_percent : %u,\n", cfg.workload.hot_access_percent);
+		printf("\tqueue_depth : %u,\n", cfg.queue_depth);
+		printf("\ttarget_iops : %u,\n", cfg.target_iops);
+		printf("\trun_duration : %u,\n", static_cast<uint32_t>(cfg.run_duration.count()));
+		printf("\tworkload_seed : %u,\n", cfg.workload_seed);
+	}
 	printf("}\n");
 }
 
@@ -643,6 +723,36 @@ void validate_initiator_comch_app_configuration(initiator_comch_app_configuratio
 		errors.emplace_back("Invalid initiator_comch_app_configuration: control-timeout must not be zero");
 	}
 
+	if (cfg.run_type == run_type_mixed_workload_test) {
+		if (cfg.workload.read_percent > 100) {
+			errors.emplace_back("Invalid initiator_comch_app_configuration: read-percent must be 0-100");
+		}
+
+		if (cfg.workload.hot_set_percent == 0 || cfg.workload.hot_set_percent > 100 ||
+		    cfg.workload.hot_access_percent > 100) {
+			errors.emplace_back(
+				"Invalid initiator_comch_app_configuration: hot-set-percent must be 1-100 and hot-access-percent must be 0-100");
+		}
+
+		if (!(cfg.workload.zipf_theta > 0. && cfg.workload.zipf_theta < 1.)) {
+			errors.emplace_back("Invalid initiator_comch_app_configuration: zipf-theta must be in the range (0, 1)");
+		}
+
+		if (cfg.queue_depth > cfg.task_count) {
+			errors.emplace_back("Invalid initiator_comch_app_configuration: queue-depth must not exceed task-count");
+		}
+
+		if (cfg.run_duration.count() < 0) {
+			errors.emplace_back(
+				"Invalid initiator_comch_app_configuration: run-duration-seconds must not be negative");
+		}
+	}
+
+	if (cfg.latency_interval.count() < 0) {
+		errors.emplace_back(
+			"Invalid initiator_comch_app_configuration: latency-interval-ms must not be negative");
+	}
+
 	if (cfg.run_type == run_type_read_write_data_validity_test && cfg.core_set.size() != 1) {
 		errors.push_back("Invalid initiator_comch_app_configuration: "s +
 				 run_type_read_write_data_validity_test + " Only supports one thread");
@@ -679,6 +789,8 @@ initiator_comch_app_configuration parse_cli_args(int argc, char **argv)
 	config.control_timeout = default_control_timeout_seconds;
 	config.run_limit_operation_count = default_run_limit_operation_count;
 	config.batch_size = default_batch_size;
+	config.workload.read_percent = default_read_percent;
+	config.workload.distribution = storage::parse_block_distribution(default_access_pattern);
 
 	doca_error_t ret;
 
@@ -726,7 +838,7 @@ initiator_comch_app_configuration parse_cli_args(int argc, char **argv)
 		DOCA_ARGP_TYPE_STRING,
 		nullptr,
 		"execution-strategy",
-		"Define what to run. One of: read_throughput_test | write_throughput_test | read_write_data_validity_test | read_only_data_validity_test",
+		"Define what to run. One of: read_throughput_test | write_throughput_test | read_write_data_validity_test | read_only_data_validity_test | mixed_workload_test",
 		storage::required_value,
 		storage::single_value,
 		[](void *value, void *cfg) noexcept {
@@ -793,6 +905,144 @@ initiator_comch_app_configuration parse_cli_args(int argc, char **argv)
 						       *static_cast<int *>(value);
 					       return DOCA_SUCCESS;
 				       });
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"latency-interval-ms",
+		"Print (and report) a latency summary every N milliseconds while the test runs. Default: 0 (disabled)",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->latency_interval =
+				std::chrono::milliseconds{*static_cast<int *>(value)};
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"latency-report",
+		"Write the latency percentiles (and time series) to this file. A \".json\" file name produces JSON, anything else produces CSV",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->latency_report_file =
+				static_cast<char const *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"read-percent",
+		"mixed_workload_test: Share (0-100) of operations that are reads, the remainder are writes. Default: 70",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->workload.read_percent =
+				*static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"access-pattern",
+		"mixed_workload_test: How blocks are chosen. One of: sequential | uniform | zipfian | hot_set. Default: uniform",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			try {
+				static_cast<initiator_comch_app_configuration *>(cfg)->workload.distribution =
+					storage::parse_block_distribution(static_cast<char const *>(value));
+				return DOCA_SUCCESS;
+			} catch (storage::runtime_error const &) {
+				return DOCA_ERROR_INVALID_VALUE;
+			}
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"zipf-theta",
+		"mixed_workload_test: Skew of the zipfian access pattern, in the range (0, 1). Default: 0.99",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			char *end = nullptr;
+			auto const theta = std::strtod(static_cast<char const *>(value), &end);
+			if (end == static_cast<char const *>(value) || *end != '\0')
+				return DOCA_ERROR_INVALID_VALUE;
+
+			static_cast<initiator_comch_app_configuration *>(cfg)->workload.zipf_theta = theta;
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"hot-set-percent",
+		"mixed_workload_test: Share (1-100) of the blocks that form the hot_set access pattern hot set. Default: 10",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->workload.hot_set_percent =
+				*static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"hot-access-percent",
+		"mixed_workload_test: Share (0-100) of the hot_set access pattern accesses that target the hot set. Default: 90",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->workload.hot_access_percent =
+				*static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"queue-depth",
+		"mixed_workload_test: Number of requests (per thread) to keep in flight. Default: task-count",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->queue_depth = *static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"target-iops",
+		"mixed_workload_test: Run open loop, starting requests at this rate (per thread) instead of keeping queue-depth requests in flight. Default: 0 (closed loop)",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->target_iops = *static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"run-duration-seconds",
+		"mixed_workload_test: Run for this long instead of for run-limit-operation-count operations. Default: 0 (use the operation count)",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->run_duration =
+				std::chrono::seconds{*static_cast<int *>(value)};
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"workload-seed",
+		"mixed_workload_test: Seed of the (per thread) workload random number generators. Default: 0",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<initiator_comch_app_configuration *>(cfg)->workload_seed =
+				*static_cast<int *>(value);
+			return DOCA_SUCCESS;
+		});
 	ret = doca_argp_start(argc, argv);
 	if (ret != DOCA_SUCCESS) {
 		throw storage::runtime_error{ret, "Failed to parse CLI args"};
@@ -873,6 +1123,82 @@ void throughput_thread_proc(initiator_comch_worker::hot_data &hot_data) noexcept
 	}
 }
 
+void workload_thread_proc(initiator_comch_worker::hot_data &hot_data) noexcept
+{
+	/* wait to start */
+	while (hot_data.run_flag == false) {
+		std::this_thread::yield();
+		if (hot_data.error_flag)
+			return;
+	}
+
+	auto &workload = *hot_data.workload;
+	auto const start_time = std::chrono::steady_clock::now();
+	auto const stop_time = workload.run_duration.count() == 0 ? std::chrono::steady_clock::time_point::max() :
+								    start_time + workload.run_duration;
+	bool timed_out = false;
+
+	if (workload.open_loop) {
+		/*
+		 * Requests are due at fixed intervals regardless of how quickly earlier requests complete. Latency is
+		 * measured from when a request was due, not from when a free transaction allowed it to be sent, so any
+		 * queueing delay caused by a slow response is included (no coordinated omission).
+		 */
+		auto next_due_time = start_time;
+		while (hot_data.run_flag) {
+			doca_pe_progress(hot_data.pe) ? ++(hot_data.pe_hit_count) : ++(hot_data.pe_miss_count);
+
+			auto const now = std::chrono::steady_clock::now();
+			if (now >= stop_time) {
+				timed_out = true;
+				break;
+			}
+
+			while (next_due_time <= now && hot_data.remaining_tx_ops != 0 &&
+			       !workload.idle_transactions.empty()) {
+				auto *const transaction = workload.idle_transactions.back();
+				workload.idle_transactions.pop_back();
+				hot_data.start_transaction(*transaction, next_due_time);
+				next_due_time += workload.issue_interval;
+			}
+		}
+	} else {
+		auto const initial_task_count =
+			std::min(static_cast<uint64_t>(workload.queue_depth), hot_data.remaining_tx_ops);
+		for (uint32_t ii = 0; ii != initial_task_count; ++ii)
+			hot_data.start_transaction(hot_data.transactions[ii], std::chrono::steady_clock::now());
+
+		uint32_t poll_count = 0;
+		while (hot_data.run_flag) {
+			doca_pe_progress(hot_data.pe) ? ++(hot_data.pe_hit_count) : ++(hot_data.pe_miss_count);
+			if (++poll_count == run_duration_check_poll_count) {
+				poll_count = 0;
+				if (std::chrono::steady_clock::now() >= stop_time) {
+					timed_out = true;
+					break;
+				}
+			}
+		}
+	}
+
+	/* exit if anything went wrong */
+	if (hot_data.error_flag) {
+		return;
+	}
+
+	/* stop issuing and wait for any completions that are out-standing (run duration elapsed or user abort) */
+	hot_data.remaining_rx_ops = hot_data.remaining_rx_ops - hot_data.remaining_tx_ops;
+	hot_data.remaining_tx_ops = 0;
+	while (hot_data.remaining_rx_ops != 0) {
+		doca_pe_progress(hot_data.pe) ? ++(hot_data.pe_hit_count) : ++(hot_data.pe_miss_count);
+	}
+
+	if (timed_out) {
+		hot_data.end_time = std::chrono::steady_clock::now();
+		hot_data.run_flag = false;
+	}
+}
+
 void write_storage_memory(initiator_comch_worker::hot_data &hot_data, uint8_t const *expected_memory_content) noexcept
 {
 	auto const io_region_size = hot_data.io_region_end - hot_data.io_region_begin;
@@ -999,9 +1325,8 @@ initiator_comch_worker::hot_data::hot_data()
 	  completed_transaction_count{0},
 	  remaining_tx_ops{0},
 	  remaining_rx_ops{0},
-	  latency_accumulator{0},
-	  latency_min{std::numeric_limits<uint32_t>::max()},
-	  latency_max{0},
+	  latency{nullptr},
+	  workload{nullptr},
 	  batch_count{0},
 	  batch_size{1},
 	  run_flag{false},
@@ -1024,9 +1349,8 @@ initiator_comch_worker::hot_data::hot_data(hot_data &&other) noexcept
 	  completed_transaction_count{other.completed_transaction_count},
 	  remaining_tx_ops{other.remaining_tx_ops},
 	  remaining_rx_ops{other.remaining_rx_ops},
-	  latency_accumulator{other.latency_accumulator},
-	  latency_min{other.latency_min},
-	  latency_max{other.latency_max},
+	  latency{other.latency},
+	  workload{other.workload},
 	  batch_count{other.batch_count},
 	  batch_size{other.batch_size},
 	  run_flag{other.run_flag.load()},
@@ -1056,9 +1380,8 @@ initiator_comch_worker::hot_data &initiator_comch_worker::hot_data::operator=(ho
 	completed_transaction_count = other.completed_transaction_count;
 	remaining_tx_ops = other.remaining_tx_ops;
 	remaining_rx_ops = other.remaining_rx_ops;
-	latency_accumulator = other.latency_accumulator;
-	latency_min = other.latency_min;
-	latency_max = other.latency_max;
+	latency = other.latency;
+	workload = other.workload;
 	batch_count = other.batch_count;
 	batch_size = other.batch_size;
 	run_flag = other.run_flag.load();
@@ -1092,14 +1415,23 @@ void initiator_comch_worker::hot_data::start_transaction(transaction_context &tr
 	transaction.start_time = now;
 	doca_error_t ret;
 
-	// Set the io target to the next block until all the storage memory has been accessed, then go back to the start
 	char *io_request;
 	static_cast<void>(doca_buf_get_data(doca_comch_producer_task_send_get_buf(transaction.request),
 					    reinterpret_cast<void **>(&io_request)));
-	storage::io_message_view::set_io_address(reinterpret_cast<uint64_t>(io_addr), io_request);
-	io_addr += io_block_size;
-	if (io_addr == io_region_end) {
-		io_addr = io_region_begin;
+	if (workload != nullptr) {
+		auto const op = workload->generator.next();
+		storage::io_message_view::set_type(op.type, io_request);
+		storage::io_message_view::set_io_address(
+			reinterpret_cast<uint64_t>(io_region_begin + (uint64_t{op.block_idx} * io_block_size)),
+			io_request);
+	} else {
+		// Set the io target to the next block until all the storage memory has been accessed, then go back to
+		// the start
+		storage::io_message_view::set_io_address(reinterpret_cast<uint64_t>(io_addr), io_request);
+		io_addr += io_block_size;
+		if (io_addr == io_region_end) {
+			io_addr = io_region_begin;
+		}
 	}
 
 	do {
@@ -1120,14 +1452,15 @@ void initiator_comch_worker::hot_data::on_transaction_complete(transaction_conte
 	auto const now = std::chrono::steady_clock::now();
 	auto const usecs = static_cast<uint32_t>(
 		std::chrono::duration_cast<std::chrono::microseconds>(now - transaction.start_time).count());
-	latency_accumulator += usecs;
-	latency_min = std::min(latency_min, usecs);
-	latency_max = std::max(latency_max, usecs);
+	latency->record(usecs);
 
 	++completed_transaction_count;
 	--remaining_rx_ops;
 	if (remaining_tx_ops) {
-		start_transaction(transaction, now);
+		if (workload != nullptr && workload->open_loop)
+			workload->idle_transactions.push_back(std::addressof(transaction));
+		else
+			start_transaction(transaction, now);
 	} else if (remaining_rx_ops == 0) {
 		run_flag = false;
 		end_time = std::chrono::steady_clock::now();
@@ -1141,6 +1474,8 @@ initiator_comch_worker::~initiator_comch_worker()
 
 initiator_comch_worker::initiator_comch_worker()
 	: m_hot_data{},
+	  m_latency{},
+	  m_workload{},
 	  m_io_message_region{nullptr},
 	  m_io_message_mmap{nullptr},
 	  m_io_message_inv{nullptr},
@@ -1151,10 +1486,13 @@ initiator_comch_worker::initiator_comch_worker()
 	  m_io_requests{},
 	  m_thread{}
 {
+	m_hot_data.latency = std::addressof(m_latency);
 }
 
 initiator_comch_worker::initiator_comch_worker(initiator_comch_worker &&other) noexcept
 	: m_hot_data{std::move(other.m_hot_data)},
+	  m_latency{std::move(other.m_latency)},
+	  m_workload{std::move(other.m_workload)},
 	  m_io_message_region{other.m_io_message_region},
 	  m_io_message_mmap{other.m_io_message_mmap},
 	  m_io_message_inv{other.m_io_message_inv},
@@ -1170,6 +1508,7 @@ initiator_comch_worker::initiator_comch_worker(initiator_comch_worker &&other) n
 	other.m_io_message_inv = nullptr;
 	other.m_consumer = nullptr;
 	other.m_producer = nullptr;
+	m_hot_data.latency = std::addressof(m_latency);
 }
 
 initiator_comch_worker &initiator_comch_worker::operator=(initiator_comch_worker &&other) noexcept
@@ -1178,6 +1517,9 @@ initiator_comch_worker &initiator_comch_worker::operator=(initiator_comch_worker
 		return *this;
 
 	m_hot_data = std::move(other.m_hot_data);
+	m_latency = std::move(other.m_latency);
+	m_workload = std::move(other.m_workload);
+	m_hot_data.latency = std::addressof(m_latency);
 	m_io_message_region = other.m_io_message_region;
 	m_io_message_mmap = other.m_io_message_mmap;
 	m_io_message_inv = other.m_io_message_inv;
@@ -1283,8 +1625,7 @@ void initiator_comch_worker::init(doca_dev *dev,
 }
 
 void initiator_comch_worker::prepare_thread_proc(initiator_comch_worker::thread_proc_fn_t fn,
-
-						 uint32_t run_limit_op_count,
+						 uint64_t run_limit_op_count,
 						 uint32_t cpu_idx)
 {
 	m_hot_data.run_flag = false;
@@ -1299,6 +1640,35 @@ void initiator_comch_worker::prepare_thread_proc(initiator_comch_worker::thread_
 	storage::set_thread_affinity(m_thread, cpu_idx);
 }
 
+void initiator_comch_worker::prepare_workload(storage::io_workload_configuration const &cfg,
+					      uint32_t queue_depth,
+					      uint32_t target_iops,
+					      std::chrono::seconds run_duration,
+					      uint64_t seed)
+{
+	auto const region_size = static_cast<size_t>(m_hot_data.io_region_end - m_hot_data.io_region_begin);
+	auto const block_count = static_cast<uint32_t>(region_size / m_hot_data.io_block_size);
+
+	m_workload = std::make_unique<workload_state>(workload_state{
+		storage::io_workload_generator{cfg, block_count, seed},
+		{},
+		std::chrono::steady_clock::duration{},
+		run_duration,
+		std::min(queue_depth == 0 ? m_hot_data.transactions_size : queue_depth, m_hot_data.transactions_size),
+		target_iops != 0,
+	});
+
+	if (m_workload->open_loop) {
+		m_workload->issue_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>{1. / target_iops});
+		m_workload->idle_transactions.reserve(m_hot_data.transactions_size);
+		for (uint32_t ii = 0; ii != m_hot_data.transactions_size; ++ii)
+			m_workload->idle_transactions.push_back(std::addressof(m_hot_data.transactions[ii]));
+	}
+
+	m_hot_data.workload = m_workload.get();
+}
+
 void initiator_comch_worker::prepare_tasks(storage::io_message_type op_type, uint32_t remote_consumer_id)
 {
 	doca_error_t ret;
@@ -1414,6 +1784,11 @@ initiator_comch_worker::hot_data const &initiator_comch_worker::get_hot_data(voi
 	return m_hot_data;
 }
 
+storage::latency_histogram const &initiator_comch_worker::get_latency(void) const noexcept
+{
+	return m_latency;
+}
+
 void initiator_comch_worker::destroy_data_path_objects(void)
 {
 	doca_error_t ret;
@@ -1850,6 +2225,17 @@ void initiator_comch_app::prepare_threads(void)
 			tctx.prepare_thread_proc(read_write_data_validity_thread_proc,
 						 m_cfg.run_limit_operation_count,
 						 m_cfg.core_set[ii]);
+		} else if (m_cfg.run_type == run_type_mixed_workload_test) {
+			/* the type of each request is chosen by the workload as it is started */
+			initial_op_type = storage::io_message_type::read;
+			tctx.prepare_workload(m_cfg.workload,
+					      m_cfg.queue_depth,
+					      m_cfg.target_iops,
+					      m_cfg.run_duration,
+					      uint64_t{m_cfg.workload_seed} + ii);
+			auto const op_limit = m_cfg.run_duration.count() != 0 ? std::numeric_limits<uint64_t>::max() :
+										m_cfg.run_limit_operation_count;
+			tctx.prepare_thread_proc(workload_thread_proc, op_limit, m_cfg.core_set[ii]);
 		} else {
 			throw storage::runtime_error{DOCA_ERROR_NOT_SUPPORTED, "Unhandled run mode: " + m_cfg.run_type};
 		}
@@ -1880,9 +2266,16 @@ bool initiator_comch_app::run(void)
 		tctx.start_thread_proc();
 	}
 
+	storage::latency_histogram latency{};
+	storage::latency_time_series latency_series{m_stats.start_time};
+	auto const sample_latency = m_cfg.latency_interval.count() != 0;
+	auto const poll_period = sample_latency ? std::min(m_cfg.latency_interval, stats_poll_period) :
+						  stats_poll_period;
+	auto next_latency_sample_time = m_stats.start_time + m_cfg.latency_interval;
+
 	// Run to completion or user abort
 	for (;;) {
-		std::this_thread::sleep_for(std::chrono::milliseconds{200});
+		std::this_thread::sleep_for(poll_period);
 		auto const running_workers = std::accumulate(m_workers,
 							     m_workers + m_cfg.core_set.size(),
 							     uint32_t{0},
@@ -1890,16 +2283,30 @@ bool initiator_comch_app::run(void)
 								     return total + tctx.is_thread_proc_running();
 							     });
 
+		auto const now = std::chrono::steady_clock::now();
+		if (sample_latency && (now >= next_latency_sample_time || running_workers == 0)) {
+			merge_worker_latency(latency);
+			auto const &interval = latency_series.sample(latency, now);
+			DOCA_LOG_INFO("Latency [%.03lfs]: ops: %lu, p50: %uus, p99: %uus, p99.99: %uus, max: %uus",
+				      interval.start_seconds,
+				      interval.summary.count,
+				      interval.summary.percentiles[0],
+				      interval.summary.percentiles[2],
+				      interval.summary.percentiles[4],
+				      interval.summary.max);
+			next_latency_sample_time += m_cfg.latency_interval;
+		}
+
 		if (running_workers == 0)
 			break;
 	}
 
 	// Tally stats
-	uint64_t latency_acc = 0;
+	merge_worker_latency(latency);
+	m_stats.latency = latency.summarise();
+	m_stats.latency_intervals = latency_series.get_intervals();
 	m_stats.end_time = m_stats.start_time;
 	m_stats.operation_count = 0;
-	m_stats.latency_max = 0;
-	m_stats.latency_min = std::numeric_limits<uint32_t>::max();
 	bool any_error = false;
 	for (uint32_t ii = 0; ii != m_cfg.core_set.size(); ++ii) {
 		auto const &hot_data = m_workers[ii].get_hot_data();
@@ -1908,18 +2315,8 @@ bool initiator_comch_app::run(void)
 
 		m_stats.end_time = std::max(m_stats.end_time, hot_data.end_time);
 		m_stats.operation_count += hot_data.completed_transaction_count;
-		m_stats.latency_min = std::min(m_stats.latency_min, hot_data.latency_min);
-		m_stats.latency_max = std::max(m_stats.latency_max, hot_data.latency_max);
 		m_stats.pe_hit_count += hot_data.pe_hit_count;
 		m_stats.pe_miss_count += hot_data.pe_miss_count;
-
-		latency_acc += hot_data.latency_accumulator;
-	}
-
-	if (m_stats.operation_count != 0) {
-		m_stats.latency_mean = latency_acc / m_stats.operation_count;
-	} else {
-		m_stats.latency_mean = 0;
 	}
 
 	return any_error == false;
@@ -1967,12 +2364,27 @@ void initiator_comch_app::display_stats(void) const
 	printf("| IO rate: %.03lf MIOP/s\n", miops);
 	printf("| PE hit rate: %2.03lf%% (%lu:%lu)\n", pe_hit_rate_pct, m_stats.pe_hit_count, m_stats.pe_miss_count);
 	printf("| Latency:\n");
-	printf("| \tMin: %uus\n", m_stats.latency_min);
-	printf("| \tMax: %uus\n", m_stats.latency_max);
-	printf("| \tMean: %uus\n", m_stats.latency_mean);
+	printf("| \tMin: %uus\n", m_stats.latency.min);
+	printf("| \tMax: %uus\n", m_stats.latency.max);
+	printf("| \tMean: %uus\n", m_stats.latency.mean);
+	for (size_t ii = 0; ii != storage::latency_report_percentiles.size(); ++ii) {
+		printf("| \tp%g: %uus\n", storage::latency_report_percentiles[ii], m_stats.latency.percentiles[ii]);
+	}
 	printf("+================================================+\n");
 }
 
+void initiator_comch_app::write_latency_report(void) const
+{
+	if (m_cfg.latency_report_file.empty())
+		return;
+
+	storage::write_latency_report(m_cfg.latency_report_file,
+				      "initiator_comch",
+				      m_stats.latency,
+				      m_stats.latency_intervals);
+	DOCA_LOG_INFO("Latency report written to: %s", m_cfg.latency_report_file.c_str());
+}
+
 void initiator_comch_app::shutdown(void)
 {
 	DOCA_LOG_INFO("Shutdown storage...");
@@ -2087,4 +2499,12 @@ storage::control::message initiator_comch_app::wait_for_control_response(storage
 					     " id: " + std::to_string(msg_id.value)};
 }
 
+void initiator_comch_app::merge_worker_latency(storage::latency_histogram &merged) const noexcept
+{
+	merged.reset();
+	for (uint32_t ii = 0; ii != m_cfg.core_set.size(); ++ii) {
+		merged.merge(m_workers[ii].get_latency());
+	}
+}
+
 } /* namespace */
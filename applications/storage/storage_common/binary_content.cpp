@@ -140,14 +140,6 @@ storage::binary_content load_binary_content_from_file(std::string const &file_na
 
 void write_binary_content_to_file(std::string const &file_name, storage::binary_content const &sbc)
 {
-	auto fh = file_handle{[&file_name]() {
-		auto *f = fopen(file_name.c_str(), "wb");
-		if (f == nullptr) {
-			throw storage::runtime_error{DOCA_ERROR_NOT_FOUND, "Unable to open sbc file: " + file_name};
-		}
-		return f;
-	}()};
-
 	auto const sbc_size = size_t{sbc.block_count} * sbc.block_size;
 	if (sbc_size > max_sbc_content_size) {
 		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
@@ -155,25 +147,76 @@ void write_binary_content_to_file(std::string const &file_name, storage::binary_
 						     std::to_string(max_sbc_content_size)};
 	}
 
-	uint32_t const block_size = htobe32(sbc.block_size);
-	uint32_t const block_count = htobe32(sbc.block_count);
+	binary_content_writer writer{file_name, sbc.block_size, sbc.block_count};
+	writer.write(sbc.content.data(), sbc.content.size());
+	writer.finish();
+}
+
+binary_content_writer::~binary_content_writer()
+{
+	if (m_f != nullptr) {
+		fclose(m_f);
+		m_f = nullptr;
+	}
+}
+
+binary_content_writer::binary_content_writer(std::string const &file_name, uint32_t block_size, uint32_t block_count)
+	: m_file_name{file_name},
+	  m_f{nullptr},
+	  m_expected_byte_count{uint64_t{block_size} * block_count},
+	  m_written_byte_count{0}
+{
+	m_f = fopen(file_name.c_str(), "wb");
+	if (m_f == nullptr) {
+		throw storage::runtime_error{DOCA_ERROR_NOT_FOUND, "Unable to open sbc file: " + file_name};
+	}
+
+	uint32_t const be_block_size = htobe32(block_size);
+	uint32_t const be_block_count = htobe32(block_count);
 
 	uint64_t const magic = htobe64(sbc_magic_value);
-	if (fwrite(&magic, 1, sizeof(magic), fh) != sizeof(magic)) {
+	if (fwrite(&magic, 1, sizeof(magic), m_f) != sizeof(magic)) {
 		throw storage::runtime_error{DOCA_ERROR_IO_FAILED, "Failed to write magic to sbc file"};
 	}
 
-	if (fwrite(&block_size, 1, sizeof(block_size), fh) != sizeof(block_size)) {
+	if (fwrite(&be_block_size, 1, sizeof(be_block_size), m_f) != sizeof(be_block_size)) {
 		throw storage::runtime_error{DOCA_ERROR_IO_FAILED, "Failed to write block size to sbc file"};
 	}
 
-	if (fwrite(&block_count, 1, sizeof(block_count), fh) != sizeof(block_count)) {
+	if (fwrite(&be_block_count, 1, sizeof(be_block_count), m_f) != sizeof(be_block_count)) {
 		throw storage::runtime_error{DOCA_ERROR_IO_FAILED, "Failed to write block count to sbc file"};
 	}
+}
 
-	if (fwrite(sbc.content.data(), 1, sbc.content.size(), fh) != sbc.content.size()) {
+void binary_content_writer::write(uint8_t const *bytes, size_t byte_count)
+{
+	if (m_written_byte_count + byte_count > m_expected_byte_count) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "Attempted to write more content than declared to sbc file: " + m_file_name};
+	}
+
+	if (fwrite(bytes, 1, byte_count, m_f) != byte_count) {
 		throw storage::runtime_error{DOCA_ERROR_IO_FAILED, "Failed to write content to sbc file"};
 	}
+
+	m_written_byte_count += byte_count;
+}
+
+void binary_content_writer::finish()
+{
+	if (m_written_byte_count != m_expected_byte_count) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "Content written to sbc file: " + m_file_name + " (" +
+						     std::to_string(m_written_byte_count) +
+						     " bytes) does not match the declared size of " +
+						     std::to_string(m_expected_byte_count) + " bytes"};
+	}
+
+	auto *const f = m_f;
+	m_f = nullptr;
+	if (fclose(f) != 0) {
+		throw storage::runtime_error{DOCA_ERROR_IO_FAILED, "Failed to close sbc file: " + m_file_name};
+	}
 }
 
 } // namespace storage
\ No newline at end of file
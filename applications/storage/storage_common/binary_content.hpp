@@ -27,6 +27,7 @@
 #define APPLICATIONS_STORAGE_STORAGE_COMMON_BINARY_CONTENT_HPP_
 
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <vector>
 
@@ -61,6 +62,58 @@ storage::binary_content load_binary_content_from_file(std::string const &file_na
  */
 void write_binary_content_to_file(std::string const &file_name, storage::binary_content const &sbc);
 
+/*
+ * Incrementally write a .sbc file to disk, allowing content that is larger than the available memory to be produced
+ * a piece at a time
+ */
+class binary_content_writer {
+public:
+	~binary_content_writer();
+
+	binary_content_writer() = delete;
+
+	/*
+	 * Create the file and write the .sbc header
+	 *
+	 * @file_name [in]: Name of file to write into
+	 * @block_size [in]: Size of each block
+	 * @block_count [in]: Number of blocks that will be written
+	 * @throws storage::runtime_error - an error occurred
+	 */
+	binary_content_writer(std::string const &file_name, uint32_t block_size, uint32_t block_count);
+
+	binary_content_writer(binary_content_writer const &) = delete;
+
+	binary_content_writer(binary_content_writer &&) noexcept = delete;
+
+	binary_content_writer &operator=(binary_content_writer const &) = delete;
+
+	binary_content_writer &operator=(binary_content_writer &&) noexcept = delete;
+
+	/*
+	 * Append content to the file
+	 *
+	 * @bytes [in]: Content to write
+	 * @byte_count [in]: Number of bytes to write
+	 * @throws storage::runtime_error - an error occurred
+	 */
+	void write(uint8_t const *bytes, size_t byte_count);
+
+	/*
+	 * Flush and close the file
+	 *
+	 * @throws storage::runtime_error - an error occurred or the content written did not match the size declared in
+	 * the header
+	 */
+	void finish();
+
+private:
+	std::string m_file_name;
+	FILE *m_f;
+	uint64_t m_expected_byte_count;
+	uint64_t m_written_byte_count;
+};
+
 } // namespace storage
 
 #endif /* APPLICATIONS_STORAGE_STORAGE_COMMON_BINARY_CONTENT_HPP_ */
@@ -60,4 +60,20 @@ std::vector<uint8_t> load_file_bytes(std::string const &file_name)
 	return load_file_bytes<std::vector<uint8_t>>(file_name);
 }
 
+void write_file_bytes(std::string const &file_name, std::vector<uint8_t> const &content)
+{
+	std::fstream file{file_name, std::ios::binary | std::ios::in | std::ios::out};
+	if (!file) {
+		/* in | out does not create the file */
+		file.open(file_name, std::ios::binary | std::ios::out);
+	}
+	if (!file) {
+		throw std::runtime_error{"Unable to open file: \"" + file_name + "\""};
+	}
+
+	if (!file.write(reinterpret_cast<char const *>(content.data()), content.size()) || !file.flush()) {
+		throw std::runtime_error{"Failed to write content of file: \"" + file_name + "\""};
+	}
+}
+
 } // namespace storage
\ No newline at end of file
@@ -41,6 +41,16 @@ namespace storage {
  */
 std::vector<uint8_t> load_file_bytes(std::string const &file_name);
 
+/*
+ * Write bytes to the start of a file, without truncating it
+ *
+ * @throws std::runtime_error: If the file cannot be opened or written
+ *
+ * @file_name [in]: Path of the file (created if it does not exist)
+ * @content [in]: Bytes to write
+ */
+void write_file_bytes(std::string const &file_name, std::vector<uint8_t> const &content);
+
 } // namespace storage
 
 #endif /* APPLICATIONS_STORAGE_STORAGE_COMMON_FILE_UTILS_HPP_ */
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef APPLICATIONS_STORAGE_STORAGE_COMMON_IO_URING_FILE_HPP_
+#define APPLICATIONS_STORAGE_STORAGE_COMMON_IO_URING_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <doca_error.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace storage {
+
+/*
+ * File or block device holding the storage blocks, accessed through io_uring queues
+ */
+class io_uring_file {
+public:
+	/*
+	 * Close the file
+	 */
+	~io_uring_file();
+
+	/*
+	 * Deleted default constructor
+	 */
+	io_uring_file() = delete;
+
+	/*
+	 * Open (and create when needed) a file or block device. A regular file smaller than the storage size is
+	 * extended to it
+	 *
+	 * @throws storage::runtime_error: If the file cannot be opened or cannot hold the storage size
+	 *
+	 * @file_name [in]: Path of the file or block device
+	 * @storage_size [in]: Number of bytes the file must be able to hold
+	 * @direct_io [in]: Bypass the page cache (O_DIRECT)
+	 */
+	io_uring_file(std::string const &file_name, uint64_t storage_size, bool direct_io);
+
+	/*
+	 * Deleted copy constructor
+	 */
+	io_uring_file(io_uring_file const &) = delete;
+
+	/*
+	 * Deleted move constructor
+	 */
+	io_uring_file(io_uring_file &&) noexcept = delete;
+
+	/*
+	 * Deleted copy assignment operator
+	 */
+	io_uring_file &operator=(io_uring_file const &) = delete;
+
+	/*
+	 * Deleted move assignment operator
+	 */
+	io_uring_file &operator=(io_uring_file &&) noexcept = delete;
+
+	/*
+	 * Get the file descriptor
+	 *
+	 * @return: File descriptor
+	 */
+	[[nodiscard]] int get_fd(void) const noexcept;
+
+private:
+	int m_fd;
+};
+
+/*
+ * Completion of a request submitted to an io_uring_queue
+ */
+struct io_uring_completion {
+	void *user_data; /* User data of the request */
+	int32_t result;	 /* Number of bytes transferred or a negative errno value */
+};
+
+/*
+ * Single threaded io_uring submission / completion queue pair bound to one io_uring_file and one registered buffer
+ * region. Requests beyond the queue depth are held back and submitted as earlier requests complete
+ */
+class io_uring_queue {
+public:
+	/*
+	 * Destroy the ring
+	 */
+	~io_uring_queue();
+
+	/*
+	 * Deleted default constructor
+	 */
+	io_uring_queue() = delete;
+
+	/*
+	 * Create a ring and register the file and buffer region with it
+	 *
+	 * @throws storage::runtime_error: If the ring cannot be created
+	 *
+	 * @file [in]: File to perform I/O on
+	 * @depth [in]: Maximum number of requests in flight in the kernel
+	 * @max_requests [in]: Maximum number of requests (in flight and held back) at any time
+	 * @sqpoll [in]: Use a kernel thread to poll the submission queue
+	 * @buffers [in]: Region all request buffers are taken from
+	 * @buffers_size [in]: Size of the region in bytes
+	 */
+	io_uring_queue(io_uring_file const &file,
+		       uint32_t depth,
+		       uint32_t max_requests,
+		       bool sqpoll,
+		       void *buffers,
+		       size_t buffers_size);
+
+	/*
+	 * Deleted copy constructor
+	 */
+	io_uring_queue(io_uring_queue const &) = delete;
+
+	/*
+	 * Deleted move constructor
+	 */
+	io_uring_queue(io_uring_queue &&) noexcept = delete;
+
+	/*
+	 * Deleted copy assignment operator
+	 */
+	io_uring_queue &operator=(io_uring_queue const &) = delete;
+
+	/*
+	 * Deleted move assignment operator
+	 */
+	io_uring_queue &operator=(io_uring_queue &&) noexcept = delete;
+
+	/*
+	 * Queue a read from the file, it is handed to the kernel by the next call to submit
+	 *
+	 * @addr [in]: Destination address, inside the registered buffer region
+	 * @size [in]: Number of bytes to read
+	 * @offset [in]: Offset in the file
+	 * @user_data [in]: User data reported with the completion
+	 * @return: DOCA_SUCCESS or DOCA_ERROR_FULL if max_requests are already queued
+	 */
+	doca_error_t read(void *addr, uint32_t size, uint64_t offset, void *user_data) noexcept;
+
+	/*
+	 * Queue a write to the file, it is handed to the kernel by the next call to submit
+	 *
+	 * @addr [in]: Source address, inside the registered buffer region
+	 * @size [in]: Number of bytes to write
+	 * @offset [in]: Offset in the file
+	 * @user_data [in]: User data reported with the completion
+	 * @return: DOCA_SUCCESS or DOCA_ERROR_FULL if max_requests are already queued
+	 */
+	doca_error_t write(void const *addr, uint32_t size, uint64_t offset, void *user_data) noexcept;
+
+	/*
+	 * Hand all queued requests to the kernel
+	 *
+	 * @return: DOCA_SUCCESS or DOCA_ERROR_IO_FAILED if the kernel rejected the submission
+	 */
+	doca_error_t submit(void) noexcept;
+
+	/*
+	 * Reap completed requests without blocking, held back requests take the place of the reaped ones
+	 *
+	 * @completions [out]: Array to store the completions in
+	 * @max_completions [in]: Capacity of the completions array
+	 * @return: Number of completions stored
+	 */
+	uint32_t reap(io_uring_completion *completions, uint32_t max_completions) noexcept;
+
+	/*
+	 * Get the number of requests that were queued and not yet reaped
+	 *
+	 * @return: Number of outstanding requests
+	 */
+	[[nodiscard]] uint32_t get_outstanding_count(void) const noexcept;
+
+private:
+	/*
+	 * Request held back until the queue depth allows it
+	 */
+	struct request {
+		void *user_data;
+		uint64_t addr;
+		uint64_t offset;
+		uint32_t size;
+		uint8_t opcode;
+	};
+
+	int m_ring_fd;
+	bool m_sqpoll;
+	uint32_t m_depth;
+	uint32_t m_in_flight;
+	uint32_t m_to_submit;
+	void *m_sq_ring;
+	size_t m_sq_ring_size;
+	void *m_cq_ring;
+	size_t m_cq_ring_size;
+	io_uring_sqe *m_sqes;
+	size_t m_sqes_size;
+	uint32_t *m_sq_tail;
+	uint32_t *m_sq_flags;
+	uint32_t *m_sq_array;
+	uint32_t m_sq_mask;
+	uint32_t *m_cq_head;
+	uint32_t *m_cq_tail;
+	io_uring_cqe *m_cqes;
+	uint32_t m_cq_mask;
+	std::vector<request> m_backlog;
+	uint32_t m_backlog_head;
+	uint32_t m_backlog_count;
+
+	/*
+	 * Queue a request, directly into the submission queue when the depth allows it
+	 *
+	 * @req [in]: Request to queue
+	 * @return: DOCA_SUCCESS or DOCA_ERROR_FULL if max_requests are already queued
+	 */
+	doca_error_t enqueue(request const &req) noexcept;
+
+	/*
+	 * Write a request into the next submission queue entry
+	 *
+	 * @req [in]: Request to write
+	 */
+	void push_sqe(request const &req) noexcept;
+
+	/*
+	 * Release all resources held by this object
+	 */
+	void cleanup(void) noexcept;
+};
+
+} /* namespace storage */
+
+#endif /* APPLICATIONS_STORAGE_STORAGE_COMMON_IO_URING_FILE_HPP_ */
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <storage_common/io_workload.hpp>
+
+#include <algorithm>
+
+#include <storage_common/definitions.hpp>
+
+namespace storage {
+
+namespace {
+
+/*
+ * Calculate the generalised harmonic number sum(1 / i^theta) for i in [1, n]
+ *
+ * @n [in]: Number of terms
+ * @theta [in]: Exponent
+ * @return: Sum
+ */
+double zeta(uint32_t n, double theta) noexcept
+{
+	double sum = 0.;
+	for (uint32_t ii = 1; ii <= n; ++ii)
+		sum += 1. / std::pow(static_cast<double>(ii), theta);
+
+	return sum;
+}
+
+} // namespace
+
+block_distribution parse_block_distribution(std::string const &name)
+{
+	if (name == "sequential")
+		return block_distribution::sequential;
+	if (name == "uniform")
+		return block_distribution::uniform;
+	if (name == "zipfian")
+		return block_distribution::zipfian;
+	if (name == "hot_set")
+		return block_distribution::hot_set;
+
+	throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE, "Unknown block distribution: \"" + name + "\""};
+}
+
+char const *to_string(block_distribution distribution) noexcept
+{
+	switch (distribution) {
+	case block_distribution::sequential:
+		return "sequential";
+	case block_distribution::uniform:
+		return "uniform";
+	case block_distribution::zipfian:
+		return "zipfian";
+	case block_distribution::hot_set:
+		return "hot_set";
+	default:
+		return "unknown";
+	}
+}
+
+io_workload_generator::io_workload_generator(io_workload_configuration const &cfg, uint32_t block_count, uint64_t seed)
+	: m_rng_state{seed},
+	  m_read_threshold{(uint64_t{std::min(cfg.read_percent, 100U)} << 32) / 100},
+	  m_zipf_theta{cfg.zipf_theta},
+	  m_zipf_alpha{0.},
+	  m_zipf_eta{0.},
+	  m_zipf_zetan{0.},
+	  m_zipf_second_threshold{0.},
+	  m_block_count{block_count},
+	  m_next_sequential_block{0},
+	  m_hot_block_count{0},
+	  m_hot_access_threshold{cfg.hot_access_percent},
+	  m_distribution{cfg.distribution}
+{
+	if (m_block_count == 0) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE, "A workload requires at least one block"};
+	}
+
+	if (m_distribution == block_distribution::zipfian) {
+		if (!(m_zipf_theta > 0. && m_zipf_theta < 1.)) {
+			throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+						     "zipfian theta must be in the range (0, 1), got: " +
+							     std::to_string(m_zipf_theta)};
+		}
+
+		m_zipf_zetan = zeta(m_block_count, m_zipf_theta);
+		m_zipf_alpha = 1. / (1. - m_zipf_theta);
+		m_zipf_eta = (1. - std::pow(2. / m_block_count, 1. - m_zipf_theta)) /
+			     (1. - (zeta(2, m_zipf_theta) / m_zipf_zetan));
+		m_zipf_second_threshold = 1. + std::pow(0.5, m_zipf_theta);
+	} else if (m_distribution == block_distribution::hot_set) {
+		if (cfg.hot_set_percent == 0 || cfg.hot_set_percent > 100 || cfg.hot_access_percent > 100) {
+			throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+						     "hot_set requires a hot set of 1-100% and a hot access share of 0-100%"};
+		}
+
+		m_hot_block_count = std::max(
+			1U,
+			static_cast<uint32_t>((uint64_t{m_block_count} * cfg.hot_set_percent) / 100));
+		if (m_hot_block_count == m_block_count) {
+			/* Everything is hot, which is just a uniform distribution */
+			m_distribution = block_distribution::uniform;
+		}
+	}
+}
+
+} // namespace storage
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef APPLICATIONS_STORAGE_STORAGE_COMMON_IO_WORKLOAD_HPP_
+#define APPLICATIONS_STORAGE_STORAGE_COMMON_IO_WORKLOAD_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include <storage_common/io_message.hpp>
+
+namespace storage {
+
+/*
+ * How the blocks targeted by a workload are chosen
+ */
+enum class block_distribution : uint8_t {
+	sequential = 0, /* Each block in turn, wrapping at the end */
+	uniform,	/* Every block is equally likely */
+	zipfian,	/* Block N is accessed with a probability proportional to 1 / (N + 1)^theta */
+	hot_set,	/* A fixed share of the accesses go to a fixed share of the blocks */
+};
+
+/*
+ * Parse a block distribution name
+ *
+ * @throws storage::runtime_error: If the name is not a known distribution
+ *
+ * @name [in]: One of: sequential | uniform | zipfian | hot_set
+ * @return: Parsed distribution
+ */
+block_distribution parse_block_distribution(std::string const &name);
+
+/*
+ * Get the name of a block distribution
+ *
+ * @distribution [in]: Distribution
+ * @return: Name of the distribution
+ */
+char const *to_string(block_distribution distribution) noexcept;
+
+/*
+ * Parameters of a workload
+ */
+struct io_workload_configuration {
+	block_distribution distribution = block_distribution::uniform;
+	uint32_t read_percent = 100;	   /* share of operations that are reads, the remainder are writes */
+	uint32_t hot_set_percent = 10;	   /* hot_set: share of the blocks that are hot */
+	uint32_t hot_access_percent = 90;  /* hot_set: share of the accesses that target a hot block */
+	double zipf_theta = 0.99;	   /* zipfian: skew, in the range (0, 1) */
+};
+
+/*
+ * A single operation of a workload
+ */
+struct io_operation {
+	io_message_type type;
+	uint32_t block_idx;
+};
+
+/*
+ * Generates the sequence of operations of a workload over a range of blocks. Each generator holds its own random
+ * state so one generator per thread gives independent, repeatable (for a given seed) sequences without any sharing.
+ */
+class io_workload_generator {
+public:
+	/*
+	 * Destructor
+	 */
+	~io_workload_generator() = default;
+
+	/*
+	 * Deleted default constructor
+	 */
+	io_workload_generator() = delete;
+
+	/*
+	 * Constructor
+	 *
+	 * @throws storage::runtime_error: If the configuration is invalid
+	 *
+	 * @cfg [in]: Workload parameters
+	 * @block_count [in]: Number of blocks the workload accesses
+	 * @seed [in]: Seed for the random number generator
+	 */
+	io_workload_generator(io_workload_configuration const &cfg, uint32_t block_count, uint64_t seed);
+
+	/*
+	 * Copy constructor
+	 */
+	io_workload_generator(io_workload_generator const &) = default;
+
+	/*
+	 * Move constructor
+	 */
+	io_workload_generator(io_workload_generator &&) noexcept = default;
+
+	/*
+	 * Copy assignment operator
+	 *
+	 * @return: reference to assigned object
+	 */
+	io_workload_generator &operator=(io_workload_generator const &) = default;
+
+	/*
+	 * Move assignment operator
+	 *
+	 * @return: reference to moved assigned object
+	 */
+	io_workload_generator &operator=(io_workload_generator &&) noexcept = default;
+
+	/*
+	 * Generate the next operation
+	 *
+	 * @return: Operation type and target block
+	 */
+	inline io_operation next() noexcept
+	{
+		auto const type = (next_random() >> 32) < m_read_threshold ? io_message_type::read :
+									     io_message_type::write;
+		return io_operation{type, next_block()};
+	}
+
+private:
+	uint64_t m_rng_state;
+	uint64_t m_read_threshold;
+	double m_zipf_theta;
+	double m_zipf_alpha;
+	double m_zipf_eta;
+	double m_zipf_zetan;
+	double m_zipf_second_threshold;
+	uint32_t m_block_count;
+	uint32_t m_next_sequential_block;
+	uint32_t m_hot_block_count;
+	uint32_t m_hot_access_threshold;
+	block_distribution m_distribution;
+
+	/*
+	 * splitmix64 random number generator
+	 *
+	 * @return: 64 random bits
+	 */
+	inline uint64_t next_random() noexcept
+	{
+		uint64_t z = (m_rng_state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	/*
+	 * Get a random value in the range [0, range)
+	 *
+	 * @range [in]: Size of the range
+	 * @return: Random value
+	 */
+	inline uint32_t next_random_below(uint32_t range) noexcept
+	{
+		return static_cast<uint32_t>(((next_random() >> 32) * range) >> 32);
+	}
+
+	/*
+	 * Get a random value in the range [0, 1)
+	 *
+	 * @return: Random value
+	 */
+	inline double next_random_unit() noexcept
+	{
+		return static_cast<double>(next_random() >> 11) * 0x1.0p-53;
+	}
+
+	/*
+	 * Choose the next block according to the configured distribution
+	 *
+	 * @return: Block index
+	 */
+	inline uint32_t next_block() noexcept
+	{
+		switch (m_distribution) {
+		case block_distribution::sequential: {
+			auto const block = m_next_sequential_block;
+			if (++m_next_sequential_block == m_block_count)
+				m_next_sequential_block = 0;
+			return block;
+		}
+		case block_distribution::zipfian:
+			return next_zipfian_block();
+		case block_distribution::hot_set:
+			if (next_random_below(100) < m_hot_access_threshold)
+				return next_random_below(m_hot_block_count);
+			return m_hot_block_count + next_random_below(m_block_count - m_hot_block_count);
+		case block_distribution::uniform:
+		default:
+			return next_random_below(m_block_count);
+		}
+	}
+
+	/*
+	 * Choose a zipfian distributed block (Gray et al, "Quickly generating billion-record synthetic databases")
+	 *
+	 * @return: Block index
+	 */
+	inline uint32_t next_zipfian_block() noexcept
+	{
+		auto const u = next_random_unit();
+		auto const uz = u * m_zipf_zetan;
+		if (uz < 1.)
+			return 0;
+		if (uz < m_zipf_second_threshold)
+			return 1;
+
+		auto const block = static_cast<uint32_t>(m_block_count * std::pow((m_zipf_eta * u) - m_zipf_eta + 1.,
+										   m_zipf_alpha));
+		return block < m_block_count ? block : m_block_count - 1;
+	}
+};
+
+} // namespace storage
+
+#endif /* APPLICATIONS_STORAGE_STORAGE_COMMON_IO_WORKLOAD_HPP_ */
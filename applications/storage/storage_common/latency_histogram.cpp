@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <storage_common/latency_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace storage {
+
+namespace {
+
+/*
+ * Get the label of a reported percentile
+ *
+ * @percentile [in]: Percentile
+ * @return: Label, eg: "p99.9"
+ */
+std::string percentile_label(double percentile)
+{
+	std::ostringstream ss;
+	ss << 'p' << percentile;
+	return ss.str();
+}
+
+/*
+ * Write a summary as CSV columns
+ *
+ * @out [in]: Stream to write to
+ * @summary [in]: Summary to write
+ */
+void write_csv_summary(std::ostream &out, latency_summary const &summary)
+{
+	out << summary.count << ',' << summary.min << ',' << summary.mean << ',' << summary.max;
+	for (auto const value : summary.percentiles)
+		out << ',' << value;
+	out << '\n';
+}
+
+/*
+ * Write a summary as JSON object members
+ *
+ * @out [in]: Stream to write to
+ * @summary [in]: Summary to write
+ */
+void write_json_summary(std::ostream &out, latency_summary const &summary)
+{
+	out << "\"count\": " << summary.count << ", \"min\": " << summary.min << ", \"mean\": " << summary.mean
+	    << ", \"max\": " << summary.max;
+	for (size_t ii = 0; ii != latency_report_percentiles.size(); ++ii) {
+		out << ", \"" << percentile_label(latency_report_percentiles[ii]) << "\": " << summary.percentiles[ii];
+	}
+}
+
+} // namespace
+
+latency_histogram::latency_histogram()
+	: m_counts{std::make_unique<std::atomic_uint64_t[]>(bucket_count)},
+	  m_sum{0},
+	  m_min{std::numeric_limits<uint32_t>::max()},
+	  m_max{0}
+{
+}
+
+latency_histogram::latency_histogram(latency_histogram &&other) noexcept
+	: m_counts{std::move(other.m_counts)},
+	  m_sum{other.m_sum.load(std::memory_order_relaxed)},
+	  m_min{other.m_min.load(std::memory_order_relaxed)},
+	  m_max{other.m_max.load(std::memory_order_relaxed)}
+{
+}
+
+latency_histogram &latency_histogram::operator=(latency_histogram &&other) noexcept
+{
+	if (std::addressof(other) == this)
+		return *this;
+
+	m_counts = std::move(other.m_counts);
+	m_sum.store(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_min.store(other.m_min.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_max.store(other.m_max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+	return *this;
+}
+
+void latency_histogram::reset() noexcept
+{
+	for (uint32_t ii = 0; ii != bucket_count; ++ii)
+		m_counts[ii].store(0, std::memory_order_relaxed);
+
+	m_sum.store(0, std::memory_order_relaxed);
+	m_min.store(std::numeric_limits<uint32_t>::max(), std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+void latency_histogram::merge(latency_histogram const &other) noexcept
+{
+	for (uint32_t ii = 0; ii != bucket_count; ++ii)
+		increment(m_counts[ii], other.m_counts[ii].load(std::memory_order_relaxed));
+
+	increment(m_sum, other.m_sum.load(std::memory_order_relaxed));
+	m_min.store(std::min(m_min.load(std::memory_order_relaxed), other.m_min.load(std::memory_order_relaxed)),
+		    std::memory_order_relaxed);
+	m_max.store(std::max(m_max.load(std::memory_order_relaxed), other.m_max.load(std::memory_order_relaxed)),
+		    std::memory_order_relaxed);
+}
+
+void latency_histogram::subtract(latency_histogram const &other) noexcept
+{
+	uint32_t min = std::numeric_limits<uint32_t>::max();
+	uint32_t max = 0;
+
+	for (uint32_t ii = 0; ii != bucket_count; ++ii) {
+		auto const count = m_counts[ii].load(std::memory_order_relaxed) -
+				   other.m_counts[ii].load(std::memory_order_relaxed);
+		m_counts[ii].store(count, std::memory_order_relaxed);
+		if (count != 0) {
+			min = std::min(min, ii < sub_bucket_count ? ii : bucket_highest_value(ii - 1) + 1);
+			max = bucket_highest_value(ii);
+		}
+	}
+
+	m_sum.store(m_sum.load(std::memory_order_relaxed) - other.m_sum.load(std::memory_order_relaxed),
+		    std::memory_order_relaxed);
+	m_min.store(min, std::memory_order_relaxed);
+	m_max.store(max, std::memory_order_relaxed);
+}
+
+uint64_t latency_histogram::get_count() const noexcept
+{
+	uint64_t count = 0;
+	for (uint32_t ii = 0; ii != bucket_count; ++ii)
+		count += m_counts[ii].load(std::memory_order_relaxed);
+
+	return count;
+}
+
+uint32_t latency_histogram::get_percentile(double percentile) const noexcept
+{
+	auto const count = get_count();
+	if (count == 0)
+		return 0;
+
+	auto const clamped_percentile = std::min(std::max(percentile, 0.), 100.);
+	auto const target = std::max(uint64_t{1},
+				     static_cast<uint64_t>(std::ceil((clamped_percentile / 100.) * count)));
+	auto const min = m_min.load(std::memory_order_relaxed);
+	auto const max = m_max.load(std::memory_order_relaxed);
+
+	uint64_t accumulated = 0;
+	for (uint32_t ii = 0; ii != bucket_count; ++ii) {
+		accumulated += m_counts[ii].load(std::memory_order_relaxed);
+		if (accumulated >= target)
+			return std::max(min, std::min(max, bucket_highest_value(ii)));
+	}
+
+	return max;
+}
+
+latency_summary latency_histogram::summarise() const noexcept
+{
+	latency_summary summary{};
+
+	summary.count = get_count();
+	if (summary.count == 0)
+		return summary;
+
+	summary.min = m_min.load(std::memory_order_relaxed);
+	summary.max = m_max.load(std::memory_order_relaxed);
+	summary.mean = static_cast<uint32_t>(m_sum.load(std::memory_order_relaxed) / summary.count);
+	for (size_t ii = 0; ii != latency_report_percentiles.size(); ++ii)
+		summary.percentiles[ii] = get_percentile(latency_report_percentiles[ii]);
+
+	return summary;
+}
+
+uint32_t latency_histogram::bucket_highest_value(uint32_t index) noexcept
+{
+	if (index < sub_bucket_count)
+		return index;
+
+	uint32_t const shift = (index / sub_bucket_half_count) - 1;
+	uint64_t const sub_bucket = index - (shift * sub_bucket_half_count);
+	return static_cast<uint32_t>(
+		std::min(((sub_bucket + 1) << shift) - 1, uint64_t{std::numeric_limits<uint32_t>::max()}));
+}
+
+latency_time_series::latency_time_series(std::chrono::steady_clock::time_point start_time)
+	: m_start_time{start_time},
+	  m_interval_start_time{start_time},
+	  m_previous{},
+	  m_delta{},
+	  m_intervals{}
+{
+}
+
+latency_interval const &latency_time_series::sample(latency_histogram const &cumulative,
+						     std::chrono::steady_clock::time_point now)
+{
+	m_delta.reset();
+	m_delta.merge(cumulative);
+	m_delta.subtract(m_previous);
+
+	m_previous.reset();
+	m_previous.merge(cumulative);
+
+	m_intervals.push_back(latency_interval{
+		std::chrono::duration<double>{m_interval_start_time - m_start_time}.count(),
+		m_delta.summarise(),
+	});
+	m_interval_start_time = now;
+
+	return m_intervals.back();
+}
+
+std::vector<latency_interval> const &latency_time_series::get_intervals() const noexcept
+{
+	return m_intervals;
+}
+
+void write_latency_report(std::string const &file_name,
+			  std::string const &hop,
+			  latency_summary const &total,
+			  std::vector<latency_interval> const &intervals)
+{
+	std::ofstream file{file_name, std::ios::out | std::ios::trunc};
+	if (!file) {
+		throw std::runtime_error{"Unable to open file: \"" + file_name + "\""};
+	}
+
+	file.setf(std::ios::fixed);
+	file.precision(3);
+
+	auto const ext_pos = file_name.rfind('.');
+	if (ext_pos != std::string::npos && file_name.compare(ext_pos, std::string::npos, ".json") == 0) {
+		file << "{\n\t\"hop\": \"" << hop << "\",\n\t\"unit\": \"us\",\n\t\"total\": {";
+		write_json_summary(file, total);
+		file << "},\n\t\"intervals\": [";
+		for (size_t ii = 0; ii != intervals.size(); ++ii) {
+			file << (ii == 0 ? "\n" : ",\n") << "\t\t{\"start_seconds\": " << intervals[ii].start_seconds
+			     << ", ";
+			write_json_summary(file, intervals[ii].summary);
+			file << "}";
+		}
+		file << (intervals.empty() ? "]\n}\n" : "\n\t]\n}\n");
+	} else {
+		file << "hop,interval_start_seconds,count,min_us,mean_us,max_us";
+		for (auto const percentile : latency_report_percentiles)
+			file << ',' << percentile_label(percentile) << "_us";
+		file << '\n';
+
+		for (auto const &interval : intervals) {
+			file << hop << ',' << interval.start_seconds << ',';
+			write_csv_summary(file, interval.summary);
+		}
+		file << hop << ",total,";
+		write_csv_summary(file, total);
+	}
+
+	if (!file.flush()) {
+		throw std::runtime_error{"Failed to write content of file: \"" + file_name + "\""};
+	}
+}
+
+} // namespace storage
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef APPLICATIONS_STORAGE_STORAGE_COMMON_LATENCY_HISTOGRAM_HPP_
+#define APPLICATIONS_STORAGE_STORAGE_COMMON_LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace storage {
+
+/*
+ * Percentiles reported for every latency summary
+ */
+std::array<double, 5> constexpr latency_report_percentiles = {50., 90., 99., 99.9, 99.99};
+
+/*
+ * Summary of a set of latency samples (all values in micro seconds)
+ */
+struct latency_summary {
+	uint64_t count = 0;
+	uint32_t min = 0;
+	uint32_t max = 0;
+	uint32_t mean = 0;
+	std::array<uint32_t, latency_report_percentiles.size()> percentiles = {};
+};
+
+/*
+ * Latency summary of one interval of a time series
+ */
+struct latency_interval {
+	double start_seconds = 0.; /* offset of the start of the interval from the start of the series */
+	latency_summary summary = {};
+};
+
+/*
+ * Log bucketed (HDR style) latency histogram.
+ *
+ * Values below sub_bucket_count are counted exactly, larger values share a bucket with their neighbours so that each
+ * bucket covers at most 1/sub_bucket_half_count of its value (~1.6% precision), over the full uint32_t range in a
+ * fixed amount of memory.
+ *
+ * A histogram has a single writer (the thread that calls record). Counters are atomics updated with relaxed plain
+ * load / store pairs, so recording costs the same as a non atomic increment while still allowing another thread to
+ * take a (slightly stale) snapshot at any time, for example to produce a time series while a test is running.
+ */
+class latency_histogram {
+public:
+	static uint32_t constexpr sub_bucket_bits = 7;
+	static uint32_t constexpr sub_bucket_count = 1U << sub_bucket_bits;
+	static uint32_t constexpr sub_bucket_half_count = sub_bucket_count / 2;
+	static uint32_t constexpr bucket_count = (32 - sub_bucket_bits + 2) * sub_bucket_half_count;
+
+	/*
+	 * Destructor
+	 */
+	~latency_histogram() = default;
+
+	/*
+	 * Default constructor
+	 *
+	 * @throws std::bad_alloc: If memory for the buckets cannot be allocated
+	 */
+	latency_histogram();
+
+	/*
+	 * Deleted copy constructor
+	 */
+	latency_histogram(latency_histogram const &) = delete;
+
+	/*
+	 * Move constructor
+	 * @other [in]: Object to move from
+	 */
+	latency_histogram(latency_histogram &&other) noexcept;
+
+	/*
+	 * Deleted copy assignment operator
+	 */
+	latency_histogram &operator=(latency_histogram const &) = delete;
+
+	/*
+	 * Move assignment operator
+	 * @other [in]: Object to move from
+	 * @return: reference to moved assigned object
+	 */
+	latency_histogram &operator=(latency_histogram &&other) noexcept;
+
+	/*
+	 * Record a sample. Must only be called by the thread that owns the histogram
+	 *
+	 * @value [in]: Sample value
+	 */
+	inline void record(uint32_t value) noexcept
+	{
+		increment(m_counts[bucket_index(value)], 1);
+		increment(m_sum, value);
+		if (value < m_min.load(std::memory_order_relaxed))
+			m_min.store(value, std::memory_order_relaxed);
+		if (value > m_max.load(std::memory_order_relaxed))
+			m_max.store(value, std::memory_order_relaxed);
+	}
+
+	/*
+	 * Discard all samples
+	 */
+	void reset() noexcept;
+
+	/*
+	 * Add all samples of another histogram to this histogram
+	 *
+	 * @other [in]: Histogram to add
+	 */
+	void merge(latency_histogram const &other) noexcept;
+
+	/*
+	 * Remove the samples of an earlier snapshot of this histogram (ie: other must hold a subset of the samples of
+	 * this histogram). Min and max are re-calculated from the remaining buckets.
+	 *
+	 * @other [in]: Snapshot to remove
+	 */
+	void subtract(latency_histogram const &other) noexcept;
+
+	/*
+	 * Get the number of recorded samples
+	 *
+	 * @return: Number of recorded samples
+	 */
+	[[nodiscard]] uint64_t get_count() const noexcept;
+
+	/*
+	 * Get the value below which the given percentage of samples fall
+	 *
+	 * @percentile [in]: Percentile (0 - 100) to query
+	 * @return: Highest value equivalent to the bucket holding the percentile or 0 if there are no samples
+	 */
+	[[nodiscard]] uint32_t get_percentile(double percentile) const noexcept;
+
+	/*
+	 * Summarise the histogram
+	 *
+	 * @return: Count, min, max, mean and the latency_report_percentiles of the recorded samples
+	 */
+	[[nodiscard]] latency_summary summarise() const noexcept;
+
+	/*
+	 * Get the index of the bucket that counts a value
+	 *
+	 * @value [in]: Value
+	 * @return: Bucket index
+	 */
+	static inline uint32_t bucket_index(uint32_t value) noexcept
+	{
+		if (value < sub_bucket_count)
+			return value;
+
+		uint32_t const shift = (31 - __builtin_clz(value)) - (sub_bucket_bits - 1);
+		return (shift * sub_bucket_half_count) + (value >> shift);
+	}
+
+	/*
+	 * Get the highest value that is counted by a bucket
+	 *
+	 * @index [in]: Bucket index
+	 * @return: Highest value of the bucket
+	 */
+	static uint32_t bucket_highest_value(uint32_t index) noexcept;
+
+private:
+	std::unique_ptr<std::atomic_uint64_t[]> m_counts;
+	std::atomic_uint64_t m_sum;
+	std::atomic_uint32_t m_min;
+	std::atomic_uint32_t m_max;
+
+	/*
+	 * Single writer increment of an atomic counter
+	 *
+	 * @counter [in/out]: Counter to increment
+	 * @value [in]: Value to add
+	 */
+	static inline void increment(std::atomic_uint64_t &counter, uint64_t value) noexcept
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+};
+
+/*
+ * Series of per interval latency summaries built from snapshots of a cumulative histogram
+ */
+class latency_time_series {
+public:
+	/*
+	 * Destructor
+	 */
+	~latency_time_series() = default;
+
+	/*
+	 * Constructor
+	 *
+	 * @start_time [in]: Start of the first interval
+	 */
+	explicit latency_time_series(std::chrono::steady_clock::time_point start_time);
+
+	/*
+	 * Deleted copy constructor
+	 */
+	latency_time_series(latency_time_series const &) = delete;
+
+	/*
+	 * Move constructor
+	 * @other [in]: Object to move from
+	 */
+	latency_time_series(latency_time_series &&other) noexcept = default;
+
+	/*
+	 * Deleted copy assignment operator
+	 */
+	latency_time_series &operator=(latency_time_series const &) = delete;
+
+	/*
+	 * Move assignment operator
+	 * @other [in]: Object to move from
+	 * @return: reference to moved assigned object
+	 */
+	latency_time_series &operator=(latency_time_series &&other) noexcept = default;
+
+	/*
+	 * Close the current interval
+	 *
+	 * @cumulative [in]: Histogram holding every sample recorded since the start of the series
+	 * @now [in]: End of the interval
+	 * @return: Summary of the samples recorded during the interval
+	 */
+	latency_interval const &sample(latency_histogram const &cumulative, std::chrono::steady_clock::time_point now);
+
+	/*
+	 * Get the summaries of all closed intervals
+	 *
+	 * @return: Interval summaries in order
+	 */
+	[[nodiscard]] std::vector<latency_interval> const &get_intervals() const noexcept;
+
+private:
+	std::chrono::steady_clock::time_point m_start_time;
+	std::chrono::steady_clock::time_point m_interval_start_time;
+	latency_histogram m_previous;
+	latency_histogram m_delta;
+	std::vector<latency_interval> m_intervals;
+};
+
+/*
+ * Write a latency report file. The format is chosen by the file extension: ".json" produces a JSON document and
+ * anything else produces CSV with one row per interval followed by a row for the totals.
+ *
+ * @throws std::runtime_error: If the file cannot be opened or written
+ *
+ * @file_name [in]: Path of the file to (over)write
+ * @hop [in]: Name of the measured hop, to allow reports from each stage of the pipeline to be combined
+ * @total [in]: Summary of the whole run
+ * @intervals [in]: Per interval summaries (may be empty)
+ */
+void write_latency_report(std::string const &file_name,
+			  std::string const &hop,
+			  latency_summary const &total,
+			  std::vector<latency_interval> const &intervals);
+
+} // namespace storage
+
+#endif /* APPLICATIONS_STORAGE_STORAGE_COMMON_LATENCY_HISTOGRAM_HPP_ */
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <storage_common/io_uring_file.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <linux/io_uring.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <doca_log.h>
+
+#include <storage_common/definitions.hpp>
+#include <storage_common/os_utils.hpp>
+
+DOCA_LOG_REGISTER(IO_URING_FILE);
+
+namespace storage {
+namespace {
+
+/* Time the SQPOLL kernel thread keeps polling an idle submission queue before going to sleep */
+auto constexpr sqpoll_idle_ms = 1000;
+
+int io_uring_setup(uint32_t entries, io_uring_params *params) noexcept
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(int ring_fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) noexcept
+{
+	return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(int ring_fd, uint32_t opcode, void const *arg, uint32_t nr_args) noexcept
+{
+	return static_cast<int>(syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+void *map_ring(int ring_fd, size_t size, uint64_t offset)
+{
+	auto *const addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+	if (addr == MAP_FAILED) {
+		throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+					     "Failed to map io_uring ring. Error: " + storage::strerror_r(errno)};
+	}
+
+	return addr;
+}
+
+template <typename T>
+T *ring_field(void *ring, uint32_t offset) noexcept
+{
+	return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+} /* namespace */
+
+io_uring_file::~io_uring_file()
+{
+	if (::close(m_fd) != 0)
+		DOCA_LOG_ERR("Failed to close storage file. Error: %s", storage::strerror_r(errno).c_str());
+}
+
+io_uring_file::io_uring_file(std::string const &file_name, uint64_t storage_size, bool direct_io) : m_fd{-1}
+{
+	m_fd = ::open(file_name.c_str(), O_RDWR | O_CREAT | (direct_io ? O_DIRECT : 0), 0644);
+	if (m_fd < 0) {
+		throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+					     "Failed to open storage file: \"" + file_name +
+						     "\". Error: " + storage::strerror_r(errno)};
+	}
+
+	try {
+		struct stat st {};
+		if (fstat(m_fd, &st) != 0) {
+			throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+						     "Failed to stat storage file: \"" + file_name +
+							     "\". Error: " + storage::strerror_r(errno)};
+		}
+
+		if (S_ISBLK(st.st_mode)) {
+			uint64_t device_size = 0;
+			if (ioctl(m_fd, BLKGETSIZE64, &device_size) != 0) {
+				throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+							     "Failed to get size of block device: \"" + file_name +
+								     "\". Error: " + storage::strerror_r(errno)};
+			}
+
+			if (device_size < storage_size) {
+				throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+							     "Block device: \"" + file_name + "\" holds " +
+								     std::to_string(device_size) + " bytes, " +
+								     std::to_string(storage_size) + " are required"};
+			}
+		} else if (static_cast<uint64_t>(st.st_size) < storage_size) {
+			if (ftruncate(m_fd, static_cast<off_t>(storage_size)) != 0) {
+				throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+							     "Failed to extend storage file: \"" + file_name +
+								     "\". Error: " + storage::strerror_r(errno)};
+			}
+		}
+	} catch (storage::runtime_error const &) {
+		static_cast<void>(::close(m_fd));
+		throw;
+	}
+}
+
+int io_uring_file::get_fd(void) const noexcept
+{
+	return m_fd;
+}
+
+io_uring_queue::~io_uring_queue()
+{
+	cleanup();
+}
+
+io_uring_queue::io_uring_queue(io_uring_file const &file,
+			       uint32_t depth,
+			       uint32_t max_requests,
+			       bool sqpoll,
+			       void *buffers,
+			       size_t buffers_size)
+	: m_ring_fd{-1},
+	  m_sqpoll{sqpoll},
+	  m_depth{depth},
+	  m_in_flight{0},
+	  m_to_submit{0},
+	  m_sq_ring{nullptr},
+	  m_sq_ring_size{0},
+	  m_cq_ring{nullptr},
+	  m_cq_ring_size{0},
+	  m_sqes{nullptr},
+	  m_sqes_size{0},
+	  m_sq_tail{nullptr},
+	  m_sq_flags{nullptr},
+	  m_sq_array{nullptr},
+	  m_sq_mask{0},
+	  m_cq_head{nullptr},
+	  m_cq_tail{nullptr},
+	  m_cqes{nullptr},
+	  m_cq_mask{0},
+	  m_backlog(max_requests),
+	  m_backlog_head{0},
+	  m_backlog_count{0}
+{
+	if (depth == 0 || max_requests < depth) {
+		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
+					     "io_uring depth must be non zero and not exceed the max number of requests"};
+	}
+
+	io_uring_params params{};
+	if (sqpoll) {
+		params.flags |= IORING_SETUP_SQPOLL;
+		params.sq_thread_idle = sqpoll_idle_ms;
+	}
+
+	m_ring_fd = io_uring_setup(depth, &params);
+	if (m_ring_fd < 0) {
+		throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+					     "Failed to create io_uring. Error: " + storage::strerror_r(errno)};
+	}
+
+	try {
+		m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP) {
+			m_sq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+			m_sq_ring = map_ring(m_ring_fd, m_sq_ring_size, IORING_OFF_SQ_RING);
+			m_cq_ring = m_sq_ring;
+			m_cq_ring_size = 0;
+		} else {
+			m_sq_ring = map_ring(m_ring_fd, m_sq_ring_size, IORING_OFF_SQ_RING);
+			m_cq_ring = map_ring(m_ring_fd, m_cq_ring_size, IORING_OFF_CQ_RING);
+		}
+
+		m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		m_sqes = static_cast<io_uring_sqe *>(map_ring(m_ring_fd, m_sqes_size, IORING_OFF_SQES));
+
+		m_sq_tail = ring_field<uint32_t>(m_sq_ring, params.sq_off.tail);
+		m_sq_flags = ring_field<uint32_t>(m_sq_ring, params.sq_off.flags);
+		m_sq_array = ring_field<uint32_t>(m_sq_ring, params.sq_off.array);
+		m_sq_mask = *ring_field<uint32_t>(m_sq_ring, params.sq_off.ring_mask);
+		m_cq_head = ring_field<uint32_t>(m_cq_ring, params.cq_off.head);
+		m_cq_tail = ring_field<uint32_t>(m_cq_ring, params.cq_off.tail);
+		m_cqes = ring_field<io_uring_cqe>(m_cq_ring, params.cq_off.cqes);
+		m_cq_mask = *ring_field<uint32_t>(m_cq_ring, params.cq_off.ring_mask);
+
+		int const fd = file.get_fd();
+		if (io_uring_register(m_ring_fd, IORING_REGISTER_FILES, &fd, 1) != 0) {
+			throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+						     "Failed to register storage file with io_uring. Error: " +
+							     storage::strerror_r(errno)};
+		}
+
+		iovec const buffers_iov{buffers, buffers_size};
+		if (io_uring_register(m_ring_fd, IORING_REGISTER_BUFFERS, &buffers_iov, 1) != 0) {
+			throw storage::runtime_error{DOCA_ERROR_OPERATING_SYSTEM,
+						     "Failed to register buffers with io_uring. Error: " +
+							     storage::strerror_r(errno)};
+		}
+	} catch (storage::runtime_error const &) {
+		cleanup();
+		throw;
+	}
+}
+
+doca_error_t io_uring_queue::read(void *addr, uint32_t size, uint64_t offset, void *user_data) noexcept
+{
+	return enqueue(request{user_data, reinterpret_cast<uint64_t>(addr), offset, size, IORING_OP_READ_FIXED});
+}
+
+doca_error_t io_uring_queue::write(void const *addr, uint32_t size, uint64_t offset, void *user_data) noexcept
+{
+	return enqueue(request{user_data, reinterpret_cast<uint64_t>(addr), offset, size, IORING_OP_WRITE_FIXED});
+}
+
+doca_error_t io_uring_queue::submit(void) noexcept
+{
+	if (m_to_submit == 0)
+		return DOCA_SUCCESS;
+
+	if (m_sqpoll) {
+		/* The kernel thread picks up new entries by itself, unless it went to sleep */
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (__atomic_load_n(m_sq_flags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP)
+			static_cast<void>(io_uring_enter(m_ring_fd, 0, 0, IORING_ENTER_SQ_WAKEUP));
+		m_to_submit = 0;
+		return DOCA_SUCCESS;
+	}
+
+	auto const ret = io_uring_enter(m_ring_fd, m_to_submit, 0, 0);
+	if (ret >= 0) {
+		m_to_submit -= static_cast<uint32_t>(ret);
+		return DOCA_SUCCESS;
+	}
+
+	if (errno == EAGAIN || errno == EBUSY || errno == EINTR)
+		return DOCA_SUCCESS;
+
+	DOCA_LOG_ERR("Failed to submit io_uring requests. Error: %s", storage::strerror_r(errno).c_str());
+	return DOCA_ERROR_IO_FAILED;
+}
+
+uint32_t io_uring_queue::reap(io_uring_completion *completions, uint32_t max_completions) noexcept
+{
+	uint32_t head = *m_cq_head;
+	uint32_t const tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+	uint32_t count = 0;
+
+	while (head != tail && count != max_completions) {
+		auto const &cqe = m_cqes[head & m_cq_mask];
+		completions[count].user_data = reinterpret_cast<void *>(cqe.user_data);
+		completions[count].result = cqe.res;
+		++count;
+		++head;
+	}
+
+	__atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+	m_in_flight -= count;
+
+	while (m_backlog_count != 0 && m_in_flight != m_depth) {
+		push_sqe(m_backlog[m_backlog_head]);
+		m_backlog_head = (m_backlog_head + 1) % m_backlog.size();
+		--m_backlog_count;
+	}
+
+	return count;
+}
+
+uint32_t io_uring_queue::get_outstanding_count(void) const noexcept
+{
+	return m_in_flight + m_backlog_count;
+}
+
+doca_error_t io_uring_queue::enqueue(request const &req) noexcept
+{
+	if (m_in_flight != m_depth) {
+		push_sqe(req);
+		return DOCA_SUCCESS;
+	}
+
+	if (m_in_flight + m_backlog_count == m_backlog.size())
+		return DOCA_ERROR_FULL;
+
+	m_backlog[(m_backlog_head + m_backlog_count) % m_backlog.size()] = req;
+	++m_backlog_count;
+	return DOCA_SUCCESS;
+}
+
+void io_uring_queue::push_sqe(request const &req) noexcept
+{
+	/* Entries in flight never exceed the depth so the submission queue can't be full */
+	uint32_t const tail = *m_sq_tail;
+	uint32_t const index = tail & m_sq_mask;
+	auto &sqe = m_sqes[index];
+
+	std::memset(&sqe, 0, sizeof(sqe));
+	sqe.opcode = req.opcode;
+	sqe.flags = IOSQE_FIXED_FILE;
+	sqe.fd = 0;
+	sqe.addr = req.addr;
+	sqe.len = req.size;
+	sqe.off = req.offset;
+	sqe.buf_index = 0;
+	sqe.user_data = reinterpret_cast<uint64_t>(req.user_data);
+
+	m_sq_array[index] = index;
+	__atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	++m_to_submit;
+	++m_in_flight;
+}
+
+void io_uring_queue::cleanup(void) noexcept
+{
+	if (m_sqes != nullptr) {
+		static_cast<void>(munmap(m_sqes, m_sqes_size));
+		m_sqes = nullptr;
+	}
+
+	if (m_cq_ring != nullptr && m_cq_ring != m_sq_ring)
+		static_cast<void>(munmap(m_cq_ring, m_cq_ring_size));
+	m_cq_ring = nullptr;
+
+	if (m_sq_ring != nullptr) {
+		static_cast<void>(munmap(m_sq_ring, m_sq_ring_size));
+		m_sq_ring = nullptr;
+	}
+
+	if (m_ring_fd >= 0) {
+		static_cast<void>(::close(m_ring_fd));
+		m_ring_fd = -1;
+	}
+}
+
+} /* namespace storage */
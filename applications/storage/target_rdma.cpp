@@ -23,6 +23,7 @@
  *
  */
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdio>
@@ -52,6 +53,8 @@
 #include <storage_common/doca_utils.hpp>
 #include <storage_common/file_utils.hpp>
 #include <storage_common/io_message.hpp>
+#include <storage_common/io_uring_file.hpp>
+#include <storage_common/latency_histogram.hpp>
 #include <storage_common/os_utils.hpp>
 
 DOCA_LOG_REGISTER(TARGET_RDMA);
@@ -65,6 +68,13 @@ auto constexpr app_name = "doca_storage_target_rdma";
 auto constexpr default_storage_block_size = 4096;
 auto constexpr default_storage_block_count = 128;
 
+auto constexpr storage_backend_ram = "ram";
+auto constexpr storage_backend_io_uring = "io_uring";
+
+/* O_DIRECT requires file offsets, sizes and buffers aligned to the logical block size of the device */
+auto constexpr direct_io_alignment = 512;
+auto constexpr max_storage_io_completions_per_poll = 32;
+
 static_assert(sizeof(void *) == 8, "Expected a pointer to occupy 8 bytes");
 
 auto constexpr rdma_permissions = DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ |
@@ -77,9 +87,15 @@ struct target_rdma_app_configuration {
 	std::vector<uint32_t> core_set = {};
 	std::string device_id = {};
 	std::string storage_content_file_name = {};
+	std::string storage_backend = {};
+	std::string storage_file_name = {};
+	std::string latency_report_file = {};
 	uint32_t block_count = {};
 	uint32_t block_size = {};
+	uint32_t io_depth = {};
 	uint16_t listen_port = {};
+	bool buffered_io = {};
+	bool sqpoll = {};
 	std::vector<uint8_t> content = {};
 };
 
@@ -91,6 +107,7 @@ struct target_rdma_worker_stats {
 	uint64_t pe_hit_count = 0;
 	uint64_t pe_miss_count = 0;
 	uint64_t operation_count = 0;
+	storage::latency_summary latency = {};
 };
 
 /*
@@ -101,8 +118,27 @@ struct alignas(storage::cache_line_size / 2) transfer_context {
 	doca_rdma_task_read *read_task = nullptr;
 	doca_buf *host_buf = nullptr;
 	doca_buf *storage_buf = nullptr;
+	char *staging_addr = nullptr; /* io_uring backend only: block sized bounce buffer */
+	std::chrono::steady_clock::time_point start_time = {}; /* arrival time of the current request */
+	storage::latency_histogram *latency = nullptr;	       /* histogram of the owning worker */
 };
 
+static_assert(sizeof(transfer_context) == storage::cache_line_size,
+	      "Expected transfer_context to occupy one cache line");
+
+/*
+ * Record the time taken to service the current request of a transfer
+ *
+ * @transfer_ctx [in]: Transfer context whose request is being responded to
+ * @now [in]: Current time
+ */
+inline void record_service_latency(transfer_context const &transfer_ctx,
+				   std::chrono::steady_clock::time_point now) noexcept
+{
+	transfer_ctx.latency->record(static_cast<uint32_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(now - transfer_ctx.start_time).count()));
+}
+
 /*
  * Data required for a thread worker
  */
@@ -122,6 +158,7 @@ public:
 		uint64_t completed_transaction_count;
 		uint32_t in_flight_transaction_count;
 		uint32_t core_idx;
+		storage::io_uring_queue *io_queue; /* Storage file queue, nullptr when serving from memory */
 		std::atomic_bool run_flag;
 		bool error_flag;
 
@@ -153,8 +190,8 @@ public:
 		 */
 		hot_data &operator=(hot_data &&other) noexcept;
 	};
-	static_assert(sizeof(target_rdma_worker::hot_data) == storage::cache_line_size,
-		      "Expected target_rdma_worker::hot_data to occupy one cache line");
+	static_assert(sizeof(target_rdma_worker::hot_data) == (2 * storage::cache_line_size),
+		      "Expected target_rdma_worker::hot_data to occupy two cache lines");
 
 	/*
 	 * Destructor
@@ -223,6 +260,24 @@ public:
 	 */
 	void stop_processing(void) noexcept;
 
+	/*
+	 * Serve I/O requests from a file through a worker owned io_uring instead of from the local memory region
+	 *
+	 * @file [in]: Storage file
+	 * @staging_region [in]: Worker bounce buffers region, of task_count * staging_block_size bytes, inside the
+	 * local mmap
+	 * @staging_block_size [in]: Size of each bounce buffer
+	 * @io_depth [in]: Maximum number of file requests in flight
+	 * @sqpoll [in]: Let a kernel thread poll the io_uring submission queue
+	 * @storage_size [in]: Size of the storage in bytes
+	 */
+	void attach_storage_file(storage::io_uring_file const &file,
+				 char *staging_region,
+				 uint32_t staging_block_size,
+				 uint32_t io_depth,
+				 bool sqpoll,
+				 uint64_t storage_size);
+
 	/*
 	 * Create all tasks and submit initial tasks
 	 */
@@ -247,8 +302,16 @@ public:
 	 */
 	[[nodiscard]] hot_data const &get_hot_data() const noexcept;
 
+	/*
+	 * Get the histogram of the time (in micro seconds) from receiving each request to sending its response
+	 *
+	 * @return: Service latency histogram
+	 */
+	[[nodiscard]] storage::latency_histogram const &get_latency() const noexcept;
+
 private:
 	hot_data m_hot_data;
+	storage::latency_histogram m_latency;
 	uint8_t *m_io_message_region;
 	doca_mmap *m_io_message_mmap;
 	doca_buf_inventory *m_buf_inv;
@@ -262,6 +325,10 @@ private:
 	transfer_context *m_transfer_contexts;
 	std::vector<doca_task *> m_ctrl_tasks;
 	std::vector<doca_task *> m_data_tasks;
+	std::unique_ptr<storage::io_uring_queue> m_io_queue;
+	char *m_staging_region;
+	uint32_t m_staging_block_size;
+	uint64_t m_storage_size;
 	std::thread m_thread;
 
 	/*
@@ -338,6 +405,20 @@ private:
 	 */
 	static void on_transfer_error(doca_task *task, doca_data task_user_data, doca_data ctx_user_data) noexcept;
 
+	/*
+	 * Storage file read / write completion handler
+	 *
+	 * @hot_data [in]: Worker hot data
+	 * @transfer_ctx [in]: Transfer context of the request
+	 * @result [in]: Number of bytes transferred or a negative errno value
+	 */
+	static void on_storage_io_complete(hot_data &hot_data, transfer_context &transfer_ctx, int32_t result) noexcept;
+
+	/*
+	 * Submit queued storage file requests and handle the completed ones
+	 */
+	void progress_storage_io(void) noexcept;
+
 	/*
 	 * Thread process function to be exeuted on the hot path
 	 */
@@ -367,6 +448,7 @@ public:
 	void wait_for_and_process_stop_storage(void);
 	void wait_for_and_process_shutdown(void);
 	void display_stats(void) const;
+	void write_latency_report(void) const;
 
 private:
 	target_rdma_app_configuration const m_cfg;
@@ -375,10 +457,12 @@ private:
 	std::vector<storage::control::message> m_ctrl_messages;
 	uint8_t *m_local_io_region;
 	uint64_t m_local_io_region_size;
+	std::unique_ptr<storage::io_uring_file> m_storage_file;
 	doca_mmap *m_local_io_mmap;
 	doca_mmap *m_remote_io_mmap;
 	target_rdma_worker *m_workers;
 	std::vector<target_rdma_worker_stats> m_stats;
+	storage::latency_summary m_latency;
 	uint32_t m_storage_block_count;
 	uint32_t m_storage_block_size;
 	uint32_t m_task_count;
@@ -505,6 +589,7 @@ int main(int argc, char **argv)
 		app.wait_for_and_process_stop_storage();
 		app.wait_for_and_process_shutdown();
 		app.display_stats();
+		app.write_latency_report();
 	} catch (std::exception const &ex) {
 		fprintf(stderr, "EXCEPTION: %s\n", ex.what());
 		fflush(stdout);
@@ -539,9 +624,15 @@ void print_config(target_rdma_app_configuration const &cfg) noexcept
 	printf("]\n");
 	printf("\tdevice : \"%s\",\n", cfg.device_id.c_str());
 	printf("\tstorage_content_file_name : \"%s\",\n", cfg.storage_content_file_name.c_str());
+	printf("\tstorage_backend : \"%s\",\n", cfg.storage_backend.c_str());
+	printf("\tstorage_file_name : \"%s\",\n", cfg.storage_file_name.c_str());
+	printf("\tio_depth : %u\n", cfg.io_depth);
+	printf("\tbuffered_io : %s\n", cfg.buffered_io ? "true" : "false");
+	printf("\tsqpoll : %s\n", cfg.sqpoll ? "true" : "false");
 	printf("\tlisten_port : %u\n", cfg.listen_port);
 	printf("\tblock_count : %u\n", cfg.block_count);
 	printf("\tblock_size : %u\n", cfg.block_size);
+	printf("\tlatency_report : \"%s\"\n", cfg.latency_report_file.c_str());
 	printf("}\n");
 }
 
@@ -559,6 +650,21 @@ void validate_target_rdma_app_configuration(target_rdma_app_configuration const
 			"Invalid target_rdma_app_configuration: block-size and block-count must be non zero when binary-content is not provided");
 	}
 
+	if (cfg.storage_backend == storage_backend_io_uring) {
+		if (cfg.storage_file_name.empty()) {
+			errors.emplace_back(
+				"Invalid target_rdma_app_configuration: storage-file must be provided for the io_uring storage backend");
+		}
+
+		if (!cfg.buffered_io && (cfg.block_size % direct_io_alignment) != 0) {
+			errors.emplace_back("Invalid target_rdma_app_configuration: block-size must be a multiple of " +
+					    std::to_string(direct_io_alignment) + " for direct io");
+		}
+	} else if (cfg.storage_backend != storage_backend_ram) {
+		errors.emplace_back("Invalid target_rdma_app_configuration: unknown storage-backend: \"" +
+				    cfg.storage_backend + "\"");
+	}
+
 	if (!errors.empty()) {
 		for (auto const &err : errors) {
 			printf("%s\n", err.c_str());
@@ -582,6 +688,7 @@ target_rdma_app_configuration parse_target_rdma_app_cli_args(int argc, char **ar
 	target_rdma_app_configuration config{};
 	config.block_count = default_storage_block_count;
 	config.block_size = default_storage_block_size;
+	config.storage_backend = storage_backend_ram;
 
 	doca_error_t ret;
 
@@ -664,6 +771,75 @@ target_rdma_app_configuration parse_target_rdma_app_cli_args(int argc, char **ar
 			static_cast<target_rdma_app_configuration *>(cfg)->block_size = *static_cast<uint32_t *>(value);
 			return DOCA_SUCCESS;
 		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"storage-backend",
+		"Where the storage blocks are held. One of: ram | io_uring (file or block device given by storage-file). Default: ram",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<target_rdma_app_configuration *>(cfg)->storage_backend =
+				static_cast<char const *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"storage-file",
+		"Path to the file or block device holding the storage blocks when using the io_uring storage backend",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<target_rdma_app_configuration *>(cfg)->storage_file_name =
+				static_cast<char const *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_INT,
+		nullptr,
+		"io-depth",
+		"Maximum number of storage file requests in flight per core. Default: the number of tasks per core",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<target_rdma_app_configuration *>(cfg)->io_depth = *static_cast<uint32_t *>(value);
+			return DOCA_SUCCESS;
+		});
+	storage::register_cli_argument(DOCA_ARGP_TYPE_BOOLEAN,
+				       nullptr,
+				       "buffered-io",
+				       "Access the storage file through the page cache instead of using direct io",
+				       storage::optional_value,
+				       storage::single_value,
+				       [](void *value, void *cfg) noexcept {
+					       static_cast<target_rdma_app_configuration *>(cfg)->buffered_io =
+						       *static_cast<bool *>(value);
+					       return DOCA_SUCCESS;
+				       });
+	storage::register_cli_argument(DOCA_ARGP_TYPE_BOOLEAN,
+				       nullptr,
+				       "sqpoll",
+				       "Use a kernel thread per core to poll the storage file io_uring submissions",
+				       storage::optional_value,
+				       storage::single_value,
+				       [](void *value, void *cfg) noexcept {
+					       static_cast<target_rdma_app_configuration *>(cfg)->sqpoll =
+						       *static_cast<bool *>(value);
+					       return DOCA_SUCCESS;
+				       });
+	storage::register_cli_argument(
+		DOCA_ARGP_TYPE_STRING,
+		nullptr,
+		"latency-report",
+		"Write the request service latency percentiles to this file. A \".json\" file name produces JSON, anything else produces CSV",
+		storage::optional_value,
+		storage::single_value,
+		[](void *value, void *cfg) noexcept {
+			static_cast<target_rdma_app_configuration *>(cfg)->latency_report_file =
+				static_cast<char const *>(value);
+			return DOCA_SUCCESS;
+		});
 	ret = doca_argp_start(argc, argv);
 	if (ret != DOCA_SUCCESS) {
 		throw storage::runtime_error{ret, "Failed to parse CLI args"};
@@ -706,6 +882,7 @@ target_rdma_worker::hot_data::hot_data()
 	  completed_transaction_count{0},
 	  in_flight_transaction_count{0},
 	  core_idx{0},
+	  io_queue{nullptr},
 	  run_flag{false},
 	  error_flag{false}
 {
@@ -720,10 +897,12 @@ target_rdma_worker::hot_data::hot_data(hot_data &&other) noexcept
 	  completed_transaction_count{other.completed_transaction_count},
 	  in_flight_transaction_count{other.in_flight_transaction_count},
 	  core_idx{other.core_idx},
+	  io_queue{other.io_queue},
 	  run_flag{other.run_flag.load()},
 	  error_flag{other.error_flag}
 {
 	other.pe = nullptr;
+	other.io_queue = nullptr;
 }
 
 target_rdma_worker::hot_data &target_rdma_worker::hot_data::operator=(hot_data &&other) noexcept
@@ -739,10 +918,12 @@ target_rdma_worker::hot_data &target_rdma_worker::hot_data::operator=(hot_data &
 	completed_transaction_count = other.completed_transaction_count;
 	in_flight_transaction_count = other.in_flight_transaction_count;
 	core_idx = other.core_idx;
+	io_queue = other.io_queue;
 	run_flag = other.run_flag.load();
 	error_flag = other.error_flag;
 
 	other.pe = nullptr;
+	other.io_queue = nullptr;
 
 	return *this;
 }
@@ -760,6 +941,7 @@ target_rdma_worker::~target_rdma_worker()
 
 target_rdma_worker::target_rdma_worker(doca_dev *dev, uint32_t task_count, doca_mmap *remote_mmap, doca_mmap *local_mmap)
 	: m_hot_data{},
+	  m_latency{},
 	  m_io_message_region{nullptr},
 	  m_io_message_mmap{nullptr},
 	  m_buf_inv{nullptr},
@@ -773,6 +955,10 @@ target_rdma_worker::target_rdma_worker(doca_dev *dev, uint32_t task_count, doca_
 	  m_transfer_contexts{nullptr},
 	  m_ctrl_tasks{},
 	  m_data_tasks{},
+	  m_io_queue{},
+	  m_staging_region{nullptr},
+	  m_staging_block_size{0},
+	  m_storage_size{0},
 	  m_thread{}
 {
 	try {
@@ -785,6 +971,7 @@ target_rdma_worker::target_rdma_worker(doca_dev *dev, uint32_t task_count, doca_
 
 target_rdma_worker::target_rdma_worker(target_rdma_worker &&other) noexcept
 	: m_hot_data{std::move(other.m_hot_data)},
+	  m_latency{std::move(other.m_latency)},
 	  m_io_message_region{other.m_io_message_region},
 	  m_io_message_mmap{other.m_io_message_mmap},
 	  m_buf_inv{other.m_buf_inv},
@@ -798,6 +985,10 @@ target_rdma_worker::target_rdma_worker(target_rdma_worker &&other) noexcept
 	  m_transfer_contexts{other.m_transfer_contexts},
 	  m_ctrl_tasks{std::move(other.m_ctrl_tasks)},
 	  m_data_tasks{std::move(other.m_data_tasks)},
+	  m_io_queue{std::move(other.m_io_queue)},
+	  m_staging_region{other.m_staging_region},
+	  m_staging_block_size{other.m_staging_block_size},
+	  m_storage_size{other.m_storage_size},
 	  m_thread{std::move(other.m_thread)}
 {
 	other.m_io_message_region = nullptr;
@@ -814,6 +1005,7 @@ target_rdma_worker &target_rdma_worker::operator=(target_rdma_worker &&other) no
 		return *this;
 
 	m_hot_data = std::move(other.m_hot_data);
+	m_latency = std::move(other.m_latency);
 	m_io_message_region = other.m_io_message_region;
 	m_io_message_mmap = other.m_io_message_mmap;
 	m_buf_inv = other.m_buf_inv;
@@ -827,6 +1019,10 @@ target_rdma_worker &target_rdma_worker::operator=(target_rdma_worker &&other) no
 	m_transfer_contexts = other.m_transfer_contexts;
 	m_ctrl_tasks = std::move(other.m_ctrl_tasks);
 	m_data_tasks = std::move(other.m_data_tasks);
+	m_io_queue = std::move(other.m_io_queue);
+	m_staging_region = other.m_staging_region;
+	m_staging_block_size = other.m_staging_block_size;
+	m_storage_size = other.m_storage_size;
 	m_thread = std::move(other.m_thread);
 
 	other.m_io_message_region = nullptr;
@@ -909,6 +1105,25 @@ void target_rdma_worker::stop_processing(void) noexcept
 	}
 }
 
+void target_rdma_worker::attach_storage_file(storage::io_uring_file const &file,
+					     char *staging_region,
+					     uint32_t staging_block_size,
+					     uint32_t io_depth,
+					     bool sqpoll,
+					     uint64_t storage_size)
+{
+	m_io_queue = std::make_unique<storage::io_uring_queue>(file,
+							       std::min(io_depth, m_task_count),
+							       m_task_count,
+							       sqpoll,
+							       staging_region,
+							       size_t{m_task_count} * staging_block_size);
+	m_staging_region = staging_region;
+	m_staging_block_size = staging_block_size;
+	m_storage_size = storage_size;
+	m_hot_data.io_queue = m_io_queue.get();
+}
+
 void target_rdma_worker::prepare_and_submit_tasks(void)
 {
 	doca_error_t ret;
@@ -922,12 +1137,14 @@ void target_rdma_worker::prepare_and_submit_tasks(void)
 						 reinterpret_cast<void **>(&m_hot_data.remote_memory_start_addr),
 						 &remote_memory_size));
 
-	if (remote_memory_size < local_memory_size) {
+	/* With a storage file the local memory only holds bounce buffers, the remote memory mirrors the file */
+	auto const storage_size = m_hot_data.io_queue != nullptr ? m_storage_size : local_memory_size;
+	if (remote_memory_size < storage_size) {
 		throw storage::runtime_error{DOCA_ERROR_INVALID_VALUE,
 					     "Unable to start storage, remote memory region is to small(" +
 						     std::to_string(remote_memory_size) +
 						     " bytes) This storage instance requires it to be at least: " +
-						     std::to_string(local_memory_size) + " bytes"};
+						     std::to_string(storage_size) + " bytes"};
 	}
 	if (local_memory_size != remote_memory_size) {}
 
@@ -942,6 +1159,10 @@ void target_rdma_worker::prepare_and_submit_tasks(void)
 	for (uint32_t ii = 0; ii != m_task_count; ++ii) {
 		doca_buf *message_buf;
 
+		m_transfer_contexts[ii].latency = std::addressof(m_latency);
+		if (m_hot_data.io_queue != nullptr)
+			m_transfer_contexts[ii].staging_addr = m_staging_region + (size_t{ii} * m_staging_block_size);
+
 		ret = doca_buf_inventory_buf_get_by_addr(m_buf_inv,
 							 m_io_message_mmap,
 							 message_buffer_addr,
@@ -1054,6 +1275,11 @@ target_rdma_worker::hot_data const &target_rdma_worker::get_hot_data(void) const
 	return m_hot_data;
 }
 
+storage::latency_histogram const &target_rdma_worker::get_latency() const noexcept
+{
+	return m_latency;
+}
+
 void target_rdma_worker::init(doca_dev *dev)
 {
 	doca_error_t ret;
@@ -1276,6 +1502,7 @@ void target_rdma_worker::doca_rdma_task_receive_cb(doca_rdma_task_receive *task,
 	auto const message_type = storage::io_message_view::get_type(io_message);
 
 	auto *const transfer_ctx = static_cast<transfer_context *>(task_user_data.ptr);
+	transfer_ctx->start_time = std::chrono::steady_clock::now();
 
 	switch (message_type) {
 	case storage::io_message_type::read: {
@@ -1287,6 +1514,23 @@ void target_rdma_worker::doca_rdma_task_receive_cb(doca_rdma_task_receive *task,
 		char *const local_addr = hot_data->local_memory_start_addr + offset;
 		uint32_t const transfer_size = storage::io_message_view::get_io_size(io_message);
 
+		if (hot_data->io_queue != nullptr) {
+			/* Fetch the data from the file first, on_storage_io_complete transfers it to the host */
+			ret = hot_data->io_queue->read(transfer_ctx->staging_addr, transfer_size, offset, transfer_ctx);
+			if (ret != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to queue storage file read: %s", doca_error_get_name(ret));
+				break;
+			}
+
+			++(hot_data->in_flight_transaction_count);
+			DOCA_LOG_TRC(
+				"Start read of %u bytes from storage file offset: %zu (in_flight_transaction_count: %u)",
+				transfer_size,
+				offset,
+				hot_data->in_flight_transaction_count);
+			break;
+		}
+
 		ret = doca_buf_set_data(transfer_ctx->host_buf, remote_addr, 0);
 		if (ret != DOCA_SUCCESS) {
 			DOCA_LOG_ERR("Failed to set transfer host memory range: %s", doca_error_get_name(ret));
@@ -1322,7 +1566,9 @@ void target_rdma_worker::doca_rdma_task_receive_cb(doca_rdma_task_receive *task,
 
 		char *const remote_addr = hot_data->remote_memory_start_addr + offset +
 					  storage::io_message_view::get_remote_offset(io_message);
-		char *const local_addr = hot_data->local_memory_start_addr + offset;
+		/* With a storage file the data is staged, on_transfer_complete then writes it to the file */
+		char *const local_addr = hot_data->io_queue != nullptr ? transfer_ctx->staging_addr :
+									 hot_data->local_memory_start_addr + offset;
 		uint32_t const transfer_size = storage::io_message_view::get_io_size(io_message);
 
 		ret = doca_buf_set_data(transfer_ctx->host_buf, remote_addr, transfer_size);
@@ -1404,13 +1650,39 @@ void target_rdma_worker::on_transfer_complete(doca_task *task,
 	auto *const response_task = static_cast<doca_rdma_task_send *>(task_user_data.ptr);
 	auto *const io_message =
 		storage::get_buffer_bytes(const_cast<doca_buf *>(doca_rdma_task_send_get_src_buf(response_task)));
+	auto *const request_task = static_cast<doca_rdma_task_receive *>(
+		doca_task_get_user_data(doca_rdma_task_send_as_task(response_task)).ptr);
+	auto *const transfer_ctx = static_cast<transfer_context *>(
+		doca_task_get_user_data(doca_rdma_task_receive_as_task(request_task)).ptr);
+	doca_error_t result = DOCA_SUCCESS;
+	doca_error_t ret;
+
+	if (hot_data->io_queue != nullptr &&
+	    storage::io_message_view::get_type(io_message) == storage::io_message_type::write) {
+		/* The host data is staged, respond once it is written to the file */
+		size_t const offset = reinterpret_cast<char *>(storage::io_message_view::get_io_address(io_message)) -
+				      hot_data->remote_memory_start_addr;
+
+		ret = hot_data->io_queue->write(transfer_ctx->staging_addr,
+						storage::io_message_view::get_io_size(io_message),
+						offset,
+						transfer_ctx);
+		if (ret == DOCA_SUCCESS)
+			return;
+
+		/* Only this request failed, report it to the initiator and keep serving the others */
+		DOCA_LOG_ERR("Failed to queue storage file write: %s", doca_error_get_name(ret));
+		result = DOCA_ERROR_IO_FAILED;
+	}
 
 	++(hot_data->completed_transaction_count);
+	if (result == DOCA_SUCCESS)
+		record_service_latency(*transfer_ctx, std::chrono::steady_clock::now());
 
 	storage::io_message_view::set_type(storage::io_message_type::result, io_message);
-	storage::io_message_view::set_result(DOCA_SUCCESS, io_message);
+	storage::io_message_view::set_result(result, io_message);
 
-	auto const ret = doca_task_submit(doca_rdma_task_send_as_task(response_task));
+	ret = doca_task_submit(doca_rdma_task_send_as_task(response_task));
 	if (ret != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed submit response task: %s", doca_error_get_name(ret));
 	}
@@ -1437,6 +1709,77 @@ void target_rdma_worker::on_transfer_error(doca_task *task, doca_data task_user_
 	}
 }
 
+void target_rdma_worker::on_storage_io_complete(hot_data &hot_data,
+						transfer_context &transfer_ctx,
+						int32_t result) noexcept
+{
+	auto *const response_task = static_cast<doca_rdma_task_send *>(
+		doca_task_get_user_data(doca_rdma_task_write_as_task(transfer_ctx.write_task)).ptr);
+	auto *const io_message =
+		storage::get_buffer_bytes(const_cast<doca_buf *>(doca_rdma_task_send_get_src_buf(response_task)));
+	auto const message_type = storage::io_message_view::get_type(io_message);
+	uint32_t const transfer_size = storage::io_message_view::get_io_size(io_message);
+	doca_error_t ret = DOCA_ERROR_IO_FAILED;
+
+	if (result != static_cast<int32_t>(transfer_size)) {
+		DOCA_LOG_ERR("Storage file %s of %u bytes failed: %d",
+			     message_type == storage::io_message_type::read ? "read" : "write",
+			     transfer_size,
+			     result);
+	} else if (message_type == storage::io_message_type::read) {
+		char *const io_addr = reinterpret_cast<char *>(storage::io_message_view::get_io_address(io_message));
+		char *const remote_addr = io_addr + storage::io_message_view::get_remote_offset(io_message);
+
+		ret = doca_buf_set_data(transfer_ctx.host_buf, remote_addr, 0);
+		if (ret == DOCA_SUCCESS)
+			ret = doca_buf_set_data(transfer_ctx.storage_buf, transfer_ctx.staging_addr, transfer_size);
+		if (ret == DOCA_SUCCESS) {
+			doca_rdma_task_write_set_dst_buf(transfer_ctx.write_task, transfer_ctx.host_buf);
+			doca_rdma_task_write_set_src_buf(transfer_ctx.write_task, transfer_ctx.storage_buf);
+			ret = doca_task_submit(doca_rdma_task_write_as_task(transfer_ctx.write_task));
+		}
+		if (ret == DOCA_SUCCESS)
+			return;
+
+		DOCA_LOG_ERR("Failed to submit doca_rdma_task_write: %s", doca_error_get_name(ret));
+		ret = DOCA_ERROR_IO_FAILED;
+	} else {
+		ret = DOCA_SUCCESS;
+	}
+
+	/* A failed file I/O only fails its own request, the initiator gets the error in the response */
+	++(hot_data.completed_transaction_count);
+	if (ret == DOCA_SUCCESS)
+		record_service_latency(transfer_ctx, std::chrono::steady_clock::now());
+
+	storage::io_message_view::set_type(storage::io_message_type::result, io_message);
+	storage::io_message_view::set_result(ret, io_message);
+
+	ret = doca_task_submit(doca_rdma_task_send_as_task(response_task));
+	if (ret != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed submit response task: %s", doca_error_get_name(ret));
+	}
+}
+
+void target_rdma_worker::progress_storage_io(void) noexcept
+{
+	storage::io_uring_completion completions[max_storage_io_completions_per_poll];
+
+	auto const ret = m_hot_data.io_queue->submit();
+	if (ret != DOCA_SUCCESS) {
+		m_hot_data.error_flag = true;
+		m_hot_data.run_flag = false;
+		return;
+	}
+
+	auto const completion_count = m_hot_data.io_queue->reap(completions, max_storage_io_completions_per_poll);
+	for (uint32_t ii = 0; ii != completion_count; ++ii) {
+		on_storage_io_complete(m_hot_data,
+				       *static_cast<transfer_context *>(completions[ii].user_data),
+				       completions[ii].result);
+	}
+}
+
 void target_rdma_worker::thread_proc()
 {
 	while (m_hot_data.run_flag == false) {
@@ -1449,10 +1792,14 @@ void target_rdma_worker::thread_proc()
 
 	while (m_hot_data.run_flag) {
 		doca_pe_progress(m_hot_data.pe) ? ++(m_hot_data.pe_hit_count) : ++(m_hot_data.pe_miss_count);
+		if (m_hot_data.io_queue != nullptr)
+			progress_storage_io();
 	}
 
 	while (m_hot_data.error_flag == false && m_hot_data.in_flight_transaction_count != 0) {
 		doca_pe_progress(m_hot_data.pe) ? ++(m_hot_data.pe_hit_count) : ++(m_hot_data.pe_miss_count);
+		if (m_hot_data.io_queue != nullptr)
+			progress_storage_io();
 	}
 
 	DOCA_LOG_INFO("Core: %u complete", m_hot_data.core_idx);
@@ -1470,10 +1817,12 @@ target_rdma_app::target_rdma_app(target_rdma_app_configuration const &cfg)
 	  m_ctrl_messages{},
 	  m_local_io_region{nullptr},
 	  m_local_io_region_size{0},
+	  m_storage_file{},
 	  m_local_io_mmap{nullptr},
 	  m_remote_io_mmap{nullptr},
 	  m_workers{},
 	  m_stats{},
+	  m_latency{},
 	  m_storage_block_count{},
 	  m_storage_block_size{},
 	  m_task_count{0},
@@ -1713,7 +2062,31 @@ void target_rdma_app::display_stats(void) const
 		printf("| Core: %u\n", stats.core_idx);
 		printf("| Operation count: %lu\n", stats.operation_count);
 		printf("| PE hit rate: %2.03lf%% (%lu:%lu)\n", pe_hit_rate_pct, stats.pe_hit_count, stats.pe_miss_count);
+		printf("| Service latency: p50: %uus, p99: %uus, p99.99: %uus, max: %uus\n",
+		       stats.latency.percentiles[0],
+		       stats.latency.percentiles[2],
+		       stats.latency.percentiles[4],
+		       stats.latency.max);
+	}
+
+	printf("+================================================+\n");
+	printf("| Service latency (all cores):\n");
+	printf("| \tMin: %uus\n", m_latency.min);
+	printf("| \tMax: %uus\n", m_latency.max);
+	printf("| \tMean: %uus\n", m_latency.mean);
+	for (size_t ii = 0; ii != storage::latency_report_percentiles.size(); ++ii) {
+		printf("| \tp%g: %uus\n", storage::latency_report_percentiles[ii], m_latency.percentiles[ii]);
 	}
+	printf("+================================================+\n");
+}
+
+void target_rdma_app::write_latency_report(void) const
+{
+	if (m_cfg.latency_report_file.empty())
+		return;
+
+	storage::write_latency_report(m_cfg.latency_report_file, "target_rdma", m_latency, {});
+	DOCA_LOG_INFO("Latency report written to: %s", m_cfg.latency_report_file.c_str());
 }
 
 void target_rdma_app::init(void)
@@ -1723,12 +2096,24 @@ void target_rdma_app::init(void)
 	m_storage_block_count = m_cfg.block_count;
 	m_storage_block_size = m_cfg.block_size;
 
-	auto const page_size = storage::get_system_page_size();
-	m_local_io_region_size = uint64_t{m_storage_block_count} * m_storage_block_size;
-	m_local_io_region = static_cast<uint8_t *>(storage::aligned_alloc(page_size, m_local_io_region_size));
+	auto const storage_size = uint64_t{m_storage_block_count} * m_storage_block_size;
+	if (m_cfg.storage_backend == storage_backend_io_uring) {
+		/* The local memory region only holds bounce buffers, allocated once the task count is known */
+		if (!m_cfg.content.empty()) {
+			storage::write_file_bytes(m_cfg.storage_file_name, m_cfg.content);
+		}
+
+		m_storage_file = std::make_unique<storage::io_uring_file>(m_cfg.storage_file_name,
+									  storage_size,
+									  !m_cfg.buffered_io);
+	} else {
+		auto const page_size = storage::get_system_page_size();
+		m_local_io_region_size = storage_size;
+		m_local_io_region = static_cast<uint8_t *>(storage::aligned_alloc(page_size, m_local_io_region_size));
 
-	if (!m_cfg.content.empty()) {
-		std::copy(std::begin(m_cfg.content), std::end(m_cfg.content), m_local_io_region);
+		if (!m_cfg.content.empty()) {
+			std::copy(std::begin(m_cfg.content), std::end(m_cfg.content), m_local_io_region);
+		}
 	}
 
 	m_control_channel = storage::control::make_tcp_server_control_channel(m_cfg.listen_port);
@@ -1796,6 +2181,16 @@ storage::control::message target_rdma_app::process_init_storage(storage::control
 	m_core_count = details->core_count;
 	m_task_count = details->task_count;
 
+	if (m_storage_file) {
+		auto const page_size = storage::get_system_page_size();
+		m_local_io_region_size = uint64_t{m_core_count} * m_task_count * m_storage_block_size;
+		m_local_io_region = static_cast<uint8_t *>(
+			storage::aligned_alloc(page_size, storage::aligned_size(page_size, m_local_io_region_size)));
+		if (m_local_io_region == nullptr) {
+			throw storage::runtime_error{DOCA_ERROR_NO_MEMORY, "Failed to allocate storage bounce buffers"};
+		}
+	}
+
 	m_local_io_mmap = storage::make_mmap(m_dev,
 					     reinterpret_cast<char *>(m_local_io_region),
 					     m_local_io_region_size,
@@ -1869,6 +2264,7 @@ storage::control::message target_rdma_app::process_stop_storage(storage::control
 
 storage::control::message target_rdma_app::process_shutdown(storage::control::message const &client_request)
 {
+	storage::latency_histogram latency{};
 	m_stats.reserve(m_core_count);
 	for (uint32_t ii = 0; ii != m_core_count; ++ii) {
 		auto const &hot_data = m_workers[ii].get_hot_data();
@@ -1877,8 +2273,11 @@ storage::control::message target_rdma_app::process_shutdown(storage::control::me
 			hot_data.pe_hit_count,
 			hot_data.pe_miss_count,
 			hot_data.completed_transaction_count,
+			m_workers[ii].get_latency().summarise(),
 		});
+		latency.merge(m_workers[ii].get_latency());
 	}
+	m_latency = latency.summarise();
 
 	destroy_workers();
 
@@ -1903,6 +2302,21 @@ void target_rdma_app::prepare_workers()
 									     m_task_count,
 									     m_remote_io_mmap,
 									     m_local_io_mmap);
+
+	if (!m_storage_file)
+		return;
+
+	auto const staging_region_size = size_t{m_task_count} * m_storage_block_size;
+	for (uint32_t ii = 0; ii != m_core_count; ++ii) {
+		auto *const staging_region = reinterpret_cast<char *>(m_local_io_region) + (ii * staging_region_size);
+
+		m_workers[ii].attach_storage_file(*m_storage_file,
+						  staging_region,
+						  m_storage_block_size,
+						  m_cfg.io_depth == 0 ? m_task_count : m_cfg.io_depth,
+						  m_cfg.sqpoll,
+						  uint64_t{m_storage_block_count} * m_storage_block_size);
+	}
 }
 
 void target_rdma_app::destroy_workers(void) noexcept
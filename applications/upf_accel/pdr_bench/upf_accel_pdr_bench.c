@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include <dpdk_utils.h>
+
+#include "upf_accel.h"
+#include "upf_accel_pdr_classifier.h"
+
+DOCA_LOG_REGISTER(UPF_ACCEL::PDR_BENCH);
+
+#define BENCH_MIN_PDRS 16			   /* Number of PDRs of the first step */
+#define BENCH_PDRS_STEP 4			   /* Factor between the number of PDRs of two steps */
+#define BENCH_DEFAULT_LOOKUPS (1 << 20)		   /* Default number of lookups per pass */
+#define BENCH_TEIDS_PER_PDR 16			   /* Width of the local TEID range of every UL PDR */
+#define BENCH_PREFIX_PDR_INTERVAL 4		   /* Every that many DL PDR matches a /24 UE prefix instead of a /32 */
+#define BENCH_UE_IP_BASE RTE_IPV4(10, 0, 0, 0)	   /* UE IP of the first PDR with a /32 UE IP */
+#define BENCH_UE_PREFIX_BASE RTE_IPV4(20, 0, 0, 0) /* UE prefix of the first PDR with a /24 UE prefix */
+#define BENCH_TEID_IP RTE_IPV4(192, 168, 0, 1)	   /* Local TEID IP of the UL PDRs */
+#define BENCH_EXTERN_IP RTE_IPV4(8, 8, 8, 8)	   /* IP of the remote side of the flows */
+#define BENCH_UE_PORT 1500			   /* UE port of the flows, within the SDF port range of the PDRs */
+#define BENCH_EXTERN_PORT 443			   /* Port of the remote side of the flows */
+#define BENCH_IP_FMT "%u.%u.%u.%u"		   /* Format of an IPv4 address in the SMF JSON */
+#define BENCH_IP_ARGS(ip) ((ip) >> 24) & 0xff, ((ip) >> 16) & 0xff, ((ip) >> 8) & 0xff, (ip) & 0xff
+
+/* Benchmark configuration */
+struct bench_config {
+	uint32_t max_pdrs; /* Number of PDRs of the last step */
+	uint32_t lookups;  /* Number of lookups per pass */
+};
+
+/* Lookups of a pass, and the PDR index each one is expected to match */
+struct bench_lookups {
+	struct upf_accel_match_8t *matches; /* Headers to look up */
+	uint32_t *expected;		    /* Expected PDR index of each header, UINT32_MAX for a miss */
+	uint32_t num;			    /* Number of lookups */
+};
+
+/* Timing of a lookup pass */
+struct bench_result {
+	uint64_t cycles;     /* TSC cycles spent in the lookups */
+	uint64_t nb_lookups; /* Number of lookups */
+	uint64_t nb_wrong;   /* Number of lookups that did not return the expected PDR */
+};
+
+/*
+ * ARGP Callback - Handle maximal number of PDRs parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t max_pdrs_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int max_pdrs = *(int *)param;
+
+	if (max_pdrs < BENCH_MIN_PDRS || (uint64_t)max_pdrs > UPF_ACCEL_MAX_NUM_PDR) {
+		DOCA_LOG_ERR("Number of PDRs must be between %d and %lu", BENCH_MIN_PDRS, UPF_ACCEL_MAX_NUM_PDR);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->max_pdrs = max_pdrs;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of lookups parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t lookups_callback(void *param, void *config)
+{
+	struct bench_config *conf = (struct bench_config *)config;
+	int lookups = *(int *)param;
+
+	if (lookups <= 0) {
+		DOCA_LOG_ERR("Number of lookups must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->lookups = lookups;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the command line parameters of the benchmark
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t register_bench_params(void)
+{
+	struct doca_argp_param *max_pdrs_param, *lookups_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&max_pdrs_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(max_pdrs_param, "n");
+	doca_argp_param_set_long_name(max_pdrs_param, "max-pdrs");
+	doca_argp_param_set_description(max_pdrs_param,
+					"Number of PDRs of the last step, the steps grow 4 times from 16 PDRs");
+	doca_argp_param_set_callback(max_pdrs_param, max_pdrs_callback);
+	doca_argp_param_set_type(max_pdrs_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(max_pdrs_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_param_create(&lookups_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(lookups_param, "l");
+	doca_argp_param_set_long_name(lookups_param, "lookups");
+	doca_argp_param_set_description(lookups_param, "Number of lookups per pass");
+	doca_argp_param_set_callback(lookups_param, lookups_callback);
+	doca_argp_param_set_type(lookups_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(lookups_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Check if a PDR index belongs to an UL PDR, UL and DL PDRs alternate in the synthetic SMF config
+ *
+ * @pdr_idx [in]: PDR index
+ * @return: true for an UL PDR and false for a DL PDR
+ */
+static inline bool bench_pdr_is_ul(uint32_t pdr_idx)
+{
+	return (pdr_idx % 2) == 0;
+}
+
+/*
+ * Get the UE IP or prefix of a PDR in the synthetic SMF config
+ *
+ * @pdr_idx [in]: PDR index
+ * @netmask [out]: UE IP prefix length
+ * @return: UE IP
+ */
+static uint32_t bench_pdr_ue_ip(uint32_t pdr_idx, uint8_t *netmask)
+{
+	uint32_t n = pdr_idx / 2;
+
+	if (!bench_pdr_is_ul(pdr_idx) && (n % BENCH_PREFIX_PDR_INTERVAL) == 0) {
+		*netmask = 24;
+		return BENCH_UE_PREFIX_BASE + (n << 8);
+	}
+	*netmask = 32;
+	return BENCH_UE_IP_BASE + n;
+}
+
+/*
+ * Write a synthetic SMF config: UL PDRs with disjoint local TEID ranges alternate with DL PDRs, which match either a
+ * /32 UE IP or a /24 UE prefix. All the PDRs share a single FAR, URR and QER.
+ *
+ * @file [in]: file to write the config to
+ * @num_pdrs [in]: number of PDRs
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_smf_write(FILE *file, uint32_t num_pdrs)
+{
+	uint32_t i, ue_ip;
+	uint8_t netmask;
+
+	fprintf(file, "{\n\t\"createPdr\": [\n");
+	for (i = 0; i < num_pdrs; i++) {
+		ue_ip = bench_pdr_ue_ip(i, &netmask);
+		fprintf(file,
+			"\t\t{\"pdrId\": %u, \"farId\": 1, \"urrIds\": [1], \"qerIds\": [1], \"pdi\": {"
+			"\"sourceInterface\": {\"type\": \"%u\"}, ",
+			i,
+			bench_pdr_is_ul(i) ? UPF_ACCEL_PDR_PDI_SI_UL : UPF_ACCEL_PDR_PDI_SI_DL);
+		if (bench_pdr_is_ul(i))
+			fprintf(file,
+				"\"localFT\": {\"teid_start\": %u, \"teid_end\": %u, \"ip\": {\"v4\": \"" BENCH_IP_FMT
+				"\"}}, ",
+				i / 2 * BENCH_TEIDS_PER_PDR,
+				i / 2 * BENCH_TEIDS_PER_PDR + BENCH_TEIDS_PER_PDR - 1,
+				BENCH_IP_ARGS(BENCH_TEID_IP));
+		fprintf(file,
+			"\"userEquipment\": {\"ip\": {\"v4\": \"" BENCH_IP_FMT "/%u\"}}, "
+			"\"sdf\": [{\"description\": \"permit out %s from any 1024-65535 to assigned\"}]}}%s\n",
+			BENCH_IP_ARGS(ue_ip),
+			netmask,
+			(i % 3) ? "ip" : "udp",
+			i + 1 < num_pdrs ? "," : "");
+	}
+	fprintf(file,
+		"\t],\n"
+		"\t\"createFar\": [{\"farId\": 1}],\n"
+		"\t\"createUrr\": [{\"urrId\": 1, \"volumeQuota\": {\"totalVolume\": 1000000000}}],\n"
+		"\t\"createQer\": [{\"qerId\": 1, \"qfi\": \"1\", \"maxBitRate\": {\"dlMBR\": \"1000000000\", "
+		"\"ulMBR\": \"1000000000\"}}]\n"
+		"}\n");
+
+	if (fflush(file) != 0 || ferror(file)) {
+		DOCA_LOG_ERR("Failed to write the SMF config");
+		return DOCA_ERROR_IO_FAILED;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Build the lookups of a pass, spread uniformly over the PDRs of one direction.
+ * One lookup out of 8 is a miss: its TEID or UE IP is past those of all the PDRs.
+ *
+ * @num_pdrs [in]: number of PDRs
+ * @ul [in]: true for UL lookups, false for DL lookups
+ * @lookups [in/out]: the lookups, with their arrays allocated
+ */
+static void bench_lookups_build(uint32_t num_pdrs, bool ul, struct bench_lookups *lookups)
+{
+	struct upf_accel_match_8t *match;
+	uint64_t rnd = 0x9e3779b97f4a7c15ULL;
+	uint32_t i, n, pdr_idx;
+	uint8_t netmask;
+
+	memset(lookups->matches, 0, sizeof(*lookups->matches) * lookups->num);
+	for (i = 0; i < lookups->num; i++) {
+		rnd ^= rnd << 13;
+		rnd ^= rnd >> 7;
+		rnd ^= rnd << 17;
+
+		/* Half of the PDRs, rounded up for UL, are of each direction */
+		n = ul ? (num_pdrs + 1) / 2 : num_pdrs / 2;
+		pdr_idx = (rnd % n) * 2 + (ul ? 0 : 1);
+		match = &lookups->matches[i];
+		match->inner.ue_ip = bench_pdr_ue_ip(pdr_idx, &netmask);
+		if (netmask != 32)
+			match->inner.ue_ip += (rnd >> 32) & 0xff;
+		match->inner.extern_ip = BENCH_EXTERN_IP;
+		match->inner.ue_port = BENCH_UE_PORT;
+		match->inner.extern_port = BENCH_EXTERN_PORT;
+		match->inner.ip_proto = IPPROTO_UDP;
+		match->outer.te_ip = BENCH_TEID_IP;
+		match->outer.te_id = pdr_idx / 2 * BENCH_TEIDS_PER_PDR + ((rnd >> 40) % BENCH_TEIDS_PER_PDR);
+		lookups->expected[i] = pdr_idx;
+
+		if ((i % 8) == 7) {
+			match->outer.te_id = n * BENCH_TEIDS_PER_PDR;
+			match->inner.ue_ip = ul ? BENCH_UE_IP_BASE + n : BENCH_UE_PREFIX_BASE + (n << 8);
+			lookups->expected[i] = UINT32_MAX;
+		}
+	}
+}
+
+/*
+ * Run a lookup pass
+ *
+ * @cfg [in]: UPF Acceleration configuration holding the PDRs and their classifier
+ * @ul [in]: true to look UL PDRs up from the RAN side, false to look DL PDRs up from the WAN side
+ * @lookups [in]: the lookups of the pass
+ * @result [out]: timing of the pass
+ */
+static void bench_lookup(const struct upf_accel_config *cfg,
+			 bool ul,
+			 const struct bench_lookups *lookups,
+			 struct bench_result *result)
+{
+	const struct upf_accel_pdr *pdr;
+	uint64_t start, end;
+	uint32_t i, found;
+
+	memset(result, 0, sizeof(*result));
+	start = rte_rdtsc();
+	for (i = 0; i < lookups->num; i++) {
+		if (ul)
+			pdr = upf_accel_pdr_classifier_ran_lookup(cfg->pdr_cls, &lookups->matches[i]);
+		else
+			pdr = upf_accel_pdr_classifier_wan_lookup(cfg->pdr_cls, &lookups->matches[i].inner);
+		found = pdr ? (uint32_t)(pdr - cfg->pdrs->arr_pdrs) : UINT32_MAX;
+		if (unlikely(found != lookups->expected[i]))
+			result->nb_wrong++;
+	}
+	end = rte_rdtsc();
+	result->cycles = end - start;
+	result->nb_lookups = lookups->num;
+}
+
+/*
+ * Run the benchmark step of a number of PDRs: write the SMF config, parse it, which builds the classifier, and time
+ * the UL and DL lookups
+ *
+ * @num_pdrs [in]: number of PDRs
+ * @lookups [in]: lookups arrays, of the configured number of lookups
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_step(uint32_t num_pdrs, struct bench_lookups *lookups)
+{
+	char path[] = "/tmp/upf_accel_pdr_bench_XXXXXX";
+	struct upf_accel_config cfg = {0};
+	struct bench_result ul_result, dl_result;
+	uint64_t start, parse_cycles;
+	uint32_t log_level;
+	doca_error_t result;
+	FILE *file;
+	int fd;
+
+	fd = mkstemp(path);
+	if (fd < 0) {
+		DOCA_LOG_ERR("Failed to create a temporary SMF config file");
+		return DOCA_ERROR_IO_FAILED;
+	}
+	file = fdopen(fd, "w");
+	if (file == NULL) {
+		DOCA_LOG_ERR("Failed to open the temporary SMF config file");
+		close(fd);
+		result = DOCA_ERROR_IO_FAILED;
+		goto unlink_file;
+	}
+	result = bench_smf_write(file, num_pdrs);
+	fclose(file);
+	if (result != DOCA_SUCCESS)
+		goto unlink_file;
+
+	/* The parser logs every PDR it parses */
+	log_level = doca_log_level_get_global_lower_limit();
+	doca_log_level_set_global_lower_limit(DOCA_LOG_LEVEL_WARNING);
+	cfg.smf_config_file_path = path;
+	start = rte_rdtsc();
+	result = upf_accel_smf_parse(&cfg);
+	parse_cycles = rte_rdtsc() - start;
+	doca_log_level_set_global_lower_limit(log_level);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse the SMF config of %u PDRs: %s", num_pdrs, doca_error_get_descr(result));
+		goto unlink_file;
+	}
+
+	bench_lookups_build(num_pdrs, true, lookups);
+	bench_lookup(&cfg, true, lookups, &ul_result);
+	bench_lookups_build(num_pdrs, false, lookups);
+	bench_lookup(&cfg, false, lookups, &dl_result);
+
+	DOCA_LOG_INFO("%10u %12.2f %10.1f %10.2f %10.1f %10.2f",
+		      num_pdrs,
+		      (double)parse_cycles * 1e3 / rte_get_tsc_hz(),
+		      (double)ul_result.cycles * 1e9 / rte_get_tsc_hz() / ul_result.nb_lookups,
+		      (double)ul_result.nb_lookups * rte_get_tsc_hz() / ul_result.cycles / 1e6,
+		      (double)dl_result.cycles * 1e9 / rte_get_tsc_hz() / dl_result.nb_lookups,
+		      (double)dl_result.nb_lookups * rte_get_tsc_hz() / dl_result.cycles / 1e6);
+	if (ul_result.nb_wrong || dl_result.nb_wrong) {
+		DOCA_LOG_ERR("%lu UL and %lu DL lookups did not return the expected PDR",
+			     ul_result.nb_wrong,
+			     dl_result.nb_wrong);
+		result = DOCA_ERROR_UNEXPECTED;
+	}
+
+	upf_accel_smf_cleanup(&cfg);
+unlink_file:
+	unlink(path);
+	return result;
+}
+
+/*
+ * Run the benchmark, the number of PDRs grows by BENCH_PDRS_STEP at every step
+ *
+ * @conf [in]: benchmark configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t bench_main(const struct bench_config *conf)
+{
+	struct bench_lookups lookups = {0};
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t num_pdrs;
+
+	lookups.num = conf->lookups;
+	lookups.matches = calloc(lookups.num, sizeof(*lookups.matches));
+	lookups.expected = calloc(lookups.num, sizeof(*lookups.expected));
+	if (lookups.matches == NULL || lookups.expected == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for %u lookups", lookups.num);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_lookups;
+	}
+
+	DOCA_LOG_INFO("%u lookups per pass, 1 out of 8 misses", lookups.num);
+	DOCA_LOG_INFO("%10s %12s %10s %10s %10s %10s", "PDRs", "Parse ms", "UL ns", "UL M/s", "DL ns", "DL M/s");
+	for (num_pdrs = BENCH_MIN_PDRS; result == DOCA_SUCCESS; num_pdrs *= BENCH_PDRS_STEP) {
+		num_pdrs = RTE_MIN(num_pdrs, conf->max_pdrs);
+		result = bench_step(num_pdrs, &lookups);
+		if (num_pdrs == conf->max_pdrs)
+			break;
+	}
+
+free_lookups:
+	free(lookups.expected);
+	free(lookups.matches);
+	return result;
+}
+
+/*
+ * PDR classifier benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int main(int argc, char **argv)
+{
+	struct bench_config conf = {0};
+	struct doca_log_backend *sdk_log;
+	doca_error_t result;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	/* Set default configuration values */
+	conf.max_pdrs = UPF_ACCEL_MAX_NUM_PDR;
+	conf.lookups = BENCH_DEFAULT_LOOKUPS;
+
+	/* Parse cmdline/json arguments, the parsed PDRs memory comes from the EAL */
+	result = doca_argp_init(NULL, &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		return EXIT_FAILURE;
+	}
+	doca_argp_set_dpdk_program(dpdk_init);
+	result = register_bench_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register application params: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse application input: %s", doca_error_get_descr(result));
+		doca_argp_destroy();
+		return EXIT_FAILURE;
+	}
+
+	result = bench_main(&conf);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Benchmark failed: %s", doca_error_get_descr(result));
+
+	dpdk_fini();
+	doca_argp_destroy();
+	return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
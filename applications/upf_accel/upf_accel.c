@@ -48,47 +48,16 @@ volatile bool force_quit;
 /*
  * Calculate quota counter index according to a port id and zero based index
  *
+ * Each port holds one quota counter per PDR.
+ *
+ * @num_pdrs [in]: number of PDRs
  * @port_id [in]: port id
  * @idx [in]: relative (zero based) index
  * @return: absolute (port wise) quota counter index
  */
-static inline uint32_t port_id_and_idx_to_quota_counter(enum upf_accel_port port_id, uint32_t idx)
+static inline uint32_t port_id_and_idx_to_quota_counter(size_t num_pdrs, enum upf_accel_port port_id, uint32_t idx)
 {
-	return port_id * UPF_ACCEL_NUM_QUOTA_COUNTERS_PER_PORT + idx;
-}
-
-/*
- * Get the offset of a meter.
- *
- * Meters are organized as follows:
- *
- *         --       --
- *         |        | Meter[0]
- *         |        | Meter[1]
- *         | PDR[0]- ...
- *         |        |
- *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS - 1]
- * Port[0]-         --
- *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS]
- *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS +1]
- *         | PDR[1] - ...
- *         |        |
- *         |        |
- *         --       -
- *...
- *
- * @port_id [in]: port ID .
- * @pdr_idx [in]: PDR index.
- * @meter_idx [in]: meter index.
- * @return: offset in meter table.
- */
-static inline uint32_t upf_accel_shared_meters_table_offset_get(enum upf_accel_port port_id,
-								uint32_t pdr_idx,
-								uint32_t meter_idx)
-{
-	const uint32_t num_meters_per_port = UPF_ACCEL_MAX_PDR_NUM_RATE_METERS * UPF_ACCEL_MAX_NUM_PDR;
-
-	return (port_id * num_meters_per_port) + UPF_ACCEL_MAX_PDR_NUM_RATE_METERS * pdr_idx + meter_idx;
+	return port_id * num_pdrs + idx;
 }
 
 /*
@@ -143,6 +112,29 @@ static inline struct upf_accel_qer *upf_accel_get_qer_by_qer_id(struct upf_accel
 	return qers->arr_qers;
 }
 
+/*
+ * Returns URR index by a given URR ID.
+ *
+ * @urrs [in]: URRs struct
+ * @urr_id [in]: URR ID
+ * @return: index of the URR in urrs
+ */
+static inline uint32_t upf_accel_get_urr_idx_by_urr_id(const struct upf_accel_urrs *urrs, uint32_t urr_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < urrs->num_urrs; ++i) {
+		if (urrs->arr_urrs[i].id == urr_id) {
+			return i;
+		}
+	}
+
+	DOCA_LOG_ERR("Failed to find urr ID %u", urr_id);
+	assert(0);
+
+	return 0;
+}
+
 /*
  * Shared meters init for a given port
  *
@@ -159,7 +151,7 @@ static doca_error_t upf_accel_shared_meters_dev_init(struct upf_accel_ctx *upf_a
 {
 	struct doca_flow_port *port = upf_accel_ctx->ports[port_id];
 	struct upf_accel_qers *qers = upf_accel_ctx->upf_accel_cfg->qers;
-	uint32_t ids_array[UPF_ACCEL_MAX_NUM_PDR] = {0};
+	uint32_t ids_array[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS] = {0};
 	struct upf_accel_qer *qer;
 	uint64_t ul_cir_cbs;
 	uint64_t dl_cir_cbs;
@@ -178,6 +170,7 @@ static doca_error_t upf_accel_shared_meters_dev_init(struct upf_accel_ctx *upf_a
 		dl_cir_cbs = upf_accel_clamp_rate(1000 * (qer->mbr_dl_mbr / CHAR_BIT));
 
 		meter_idx = upf_accel_shared_meters_table_offset_get(
+			upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs,
 			port_id,
 			upf_accel_get_pdr_index_from_pdrs(upf_accel_ctx->upf_accel_cfg->pdrs, pdr),
 			i);
@@ -337,7 +330,10 @@ static doca_error_t upf_accel_pipe_encap_counter_insert(struct upf_accel_ctx *up
 								}}};
 	struct doca_flow_actions act_none = {.action_idx = UPF_ACCEL_ENCAP_ACTION_NONE};
 	struct doca_flow_monitor mon = {
-		.shared_counter = {.shared_counter_id = port_id_and_idx_to_quota_counter(port_id, pdr_idx)}};
+		.shared_counter = {.shared_counter_id = port_id_and_idx_to_quota_counter(
+					   upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs,
+					   port_id,
+					   pdr_idx)}};
 	struct doca_flow_match match = {.meta.pkt_meta = DOCA_HTOBE32(pdr_id)};
 	struct upf_accel_entry_cfg entry_cfg = {.match = &match,
 						.action = (pdi_si == UPF_ACCEL_PDR_PDI_SI_DL) ? &act_enc : &act_none,
@@ -436,9 +432,16 @@ static doca_error_t pipe_shared_meter_common_insert(struct upf_accel_ctx *upf_ac
 		.entry_idx = pdr->id,
 		.port_id = port_id};
 
-	mon.shared_meter.shared_meter_id = upf_accel_shared_meters_table_offset_get(port_id, pdr_idx, qer_idx);
+	mon.shared_meter.shared_meter_id =
+		upf_accel_shared_meters_table_offset_get(upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs,
+							 port_id,
+							 pdr_idx,
+							 qer_idx);
 
-	if (pipe_pdr_insert(upf_accel_ctx, &entry_cfg, NULL)) {
+	/* The first meter entry of a PDR is updated to drop its traffic once its quota is exceeded */
+	if (pipe_pdr_insert(upf_accel_ctx,
+			    &entry_cfg,
+			    qer_idx ? NULL : &upf_accel_ctx->smf_meter_entries[pdr_idx][port_id])) {
 		DOCA_LOG_ERR("Failed to insert p%d tx meter %u entry: %u", port_id, qer_idx, pdr->id);
 		return -1;
 	}
@@ -529,15 +532,17 @@ static doca_error_t upf_accel_smf_rules_add(struct upf_accel_ctx *upf_accel_ctx)
  * The indexes of the counters are organized as followed:
  * For PDR with ID i:
  *	port 0 counter index is i
- *	port 1 counter index is <num_of_shared_counters_per_port> + i
+ *	port 1 counter index is <num_pdrs> + i
  *
+ * @num_pdrs [in]: number of PDRs
  * @start_idx [in]: first pdr/index to start with
  * @num_ports [in]: number of ports
  * @num_cntrs [in]: number of counters
  * @shared_counter_ids [in/out]: pointer to store the result at
  * @return: DOCA_SUCCESS on success and DOCA_ERROR_NO_MEMORY otherwise
  */
-static doca_error_t alloc_and_populate_quota_counters_ids(uint16_t start_idx,
+static doca_error_t alloc_and_populate_quota_counters_ids(size_t num_pdrs,
+							  uint32_t start_idx,
 							  size_t num_ports,
 							  size_t num_cntrs,
 							  struct app_shared_counter_ids *shared_counter_ids)
@@ -560,7 +565,8 @@ static doca_error_t alloc_and_populate_quota_counters_ids(uint16_t start_idx,
 		}
 
 		for (i = 0; i < num_cntrs; ++i) {
-			shared_counter_ids->ids[port_id][i] = port_id_and_idx_to_quota_counter(port_id, start_idx + i);
+			shared_counter_ids->ids[port_id][i] =
+				port_id_and_idx_to_quota_counter(num_pdrs, port_id, start_idx + i);
 		}
 	}
 
@@ -625,7 +631,8 @@ static doca_error_t upf_accel_init_quota_counters(struct upf_accel_ctx *upf_acce
 	doca_error_t result;
 	uint32_t i;
 
-	result = alloc_and_populate_quota_counters_ids(0,
+	result = alloc_and_populate_quota_counters_ids(upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs,
+						       0,
 						       upf_accel_ctx->num_ports,
 						       upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs,
 						       &shared_counter_ids);
@@ -673,6 +680,7 @@ static void upf_accel_fp_data_cleanup(struct upf_accel_fp_data *fp_data_arr)
 		fp_data = &fp_data_arr[lcore];
 
 		free_quota_counters_ids(&fp_data->quota_cntrs, fp_data->ctx->num_ports);
+		rte_free(fp_data->quota_pdrs);
 		rte_free(fp_data->dyn_tbl_data);
 		rte_hash_free(fp_data->dyn_tbl);
 	}
@@ -692,8 +700,8 @@ static doca_error_t upf_accel_fp_data_init(struct upf_accel_ctx *ctx, struct upf
 	uint16_t num_cores = rte_lcore_count() - 1;
 
 	assert(num_cores > 0);
-	uint16_t quota_cntrs_per_core_num = ctx->upf_accel_cfg->pdrs->num_pdrs / num_cores;
-	uint16_t quota_cntrs_remainder_num = ctx->upf_accel_cfg->pdrs->num_pdrs % num_cores;
+	uint32_t quota_cntrs_per_core_num = ctx->upf_accel_cfg->pdrs->num_pdrs / num_cores;
+	uint32_t quota_cntrs_remainder_num = ctx->upf_accel_cfg->pdrs->num_pdrs % num_cores;
 	uint32_t ht_size = calculate_hash_table_size(num_cores);
 	char mem_name[RTE_MEMZONE_NAMESIZE];
 	struct rte_hash_parameters dyn_tbl_params = {
@@ -705,13 +713,14 @@ static doca_error_t upf_accel_fp_data_init(struct upf_accel_ctx *ctx, struct upf
 		.socket_id = rte_socket_id(),
 		.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
 	};
-	uint16_t curr_quota_base_cntr_idx = 0;
+	uint32_t curr_quota_base_cntr_idx = 0;
 	struct upf_accel_fp_data *fp_data_arr;
 	struct upf_accel_fp_data *fp_data;
 	uint16_t queue_id = 1;
 	unsigned int lcore;
 	size_t num_cntrs;
 	doca_error_t res;
+	size_t i;
 
 	fp_data_arr = rte_calloc("FP data", RTE_MAX_LCORE, sizeof(*fp_data), RTE_CACHE_LINE_SIZE);
 	if (!fp_data_arr) {
@@ -751,7 +760,8 @@ static doca_error_t upf_accel_fp_data_init(struct upf_accel_ctx *ctx, struct upf
 			quota_cntrs_remainder_num--;
 		}
 
-		res = alloc_and_populate_quota_counters_ids(curr_quota_base_cntr_idx,
+		res = alloc_and_populate_quota_counters_ids(ctx->upf_accel_cfg->pdrs->num_pdrs,
+							    curr_quota_base_cntr_idx,
 							    ctx->num_ports,
 							    num_cntrs,
 							    &fp_data->quota_cntrs);
@@ -759,6 +769,22 @@ static doca_error_t upf_accel_fp_data_init(struct upf_accel_ctx *ctx, struct upf
 			DOCA_LOG_ERR("Failed to populate quota counters ids for core %u", lcore);
 			goto cleanup;
 		}
+
+		snprintf(mem_name, sizeof(mem_name), "Quota PDRs %u", lcore);
+		fp_data->quota_pdrs = rte_calloc(mem_name,
+						 RTE_MAX(num_cntrs, 1ul),
+						 sizeof(*fp_data->quota_pdrs),
+						 RTE_CACHE_LINE_SIZE);
+		if (!fp_data->quota_pdrs) {
+			DOCA_LOG_ERR("Failed to allocate quota PDRs for core %u", lcore);
+			res = DOCA_ERROR_NO_MEMORY;
+			goto cleanup;
+		}
+
+		for (i = 0; i < num_cntrs; i++)
+			fp_data->quota_pdrs[i].urr_idx = upf_accel_get_urr_idx_by_urr_id(
+				ctx->upf_accel_cfg->urrs,
+				ctx->upf_accel_cfg->pdrs->arr_pdrs[curr_quota_base_cntr_idx + i].urrids[0]);
 		curr_quota_base_cntr_idx += num_cntrs;
 
 		fp_data->ctx = ctx;
@@ -980,6 +1006,9 @@ static void upf_accel_drop_counter_print(struct upf_accel_ctx *upf_accel_ctx, en
 	case UPF_ACCEL_DROP_FILTER:
 		name = "Filter";
 		break;
+	case UPF_ACCEL_DROP_QUOTA:
+		name = "Quota";
+		break;
 	default:
 		assert(0);
 		name = "Error!";
@@ -1101,24 +1130,24 @@ static int upf_accel_fp_loop_wrapper(void *param)
  * Calculate the maximum number of shared meters needed
  *
  * @num_ports [in]: number of ports
+ * @num_pdrs [in]: number of PDRs
  * @return: number of shared meters
  */
-static inline int upf_accel_calc_num_shared_meters(uint16_t num_ports)
+static inline uint32_t upf_accel_calc_num_shared_meters(uint16_t num_ports, size_t num_pdrs)
 {
-	return upf_accel_shared_meters_table_offset_get(num_ports,
-							UPF_ACCEL_MAX_NUM_PDR,
-							UPF_ACCEL_MAX_PDR_NUM_RATE_METERS);
+	return upf_accel_shared_meters_table_offset_get(num_pdrs, num_ports, 0, 0);
 }
 
 /*
  * Calculate the maximum number of shared counters needed
  *
  * @num_ports [in]: number of ports
+ * @num_pdrs [in]: number of PDRs
  * @return: number of shared counters
  */
-static inline int upf_accel_calc_num_shared_counters(uint16_t num_ports)
+static inline uint32_t upf_accel_calc_num_shared_counters(uint16_t num_ports, size_t num_pdrs)
 {
-	return UPF_ACCEL_NUM_QUOTA_COUNTERS_PER_PORT * num_ports;
+	return port_id_and_idx_to_quota_counter(num_pdrs, num_ports, 0);
 }
 
 /*
@@ -1151,6 +1180,9 @@ static doca_error_t deinit_upf_accel(struct upf_accel_ctx *upf_accel_ctx, struct
 
 	upf_accel_fp_data_cleanup(fp_data_arr);
 	doca_flow_destroy();
+	rte_free(upf_accel_ctx->quota_urrs);
+	rte_free(upf_accel_ctx->smf_meter_entries);
+	rte_free(upf_accel_ctx->smf_entries);
 
 	return result;
 }
@@ -1169,6 +1201,35 @@ static doca_error_t init_upf_accel(struct upf_accel_ctx *upf_accel_ctx, struct u
 	doca_error_t result, tmp_result;
 	enum upf_accel_port port_id;
 
+	upf_accel_ctx->smf_entries = rte_calloc("SMF entries",
+						RTE_MAX(upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs, 1ul),
+						sizeof(*upf_accel_ctx->smf_entries),
+						RTE_CACHE_LINE_SIZE);
+	if (!upf_accel_ctx->smf_entries) {
+		DOCA_LOG_ERR("Failed to allocate SMF entries");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	upf_accel_ctx->smf_meter_entries = rte_calloc("SMF meter entries",
+						      RTE_MAX(upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs, 1ul),
+						      sizeof(*upf_accel_ctx->smf_meter_entries),
+						      RTE_CACHE_LINE_SIZE);
+	if (!upf_accel_ctx->smf_meter_entries) {
+		DOCA_LOG_ERR("Failed to allocate SMF meter entries");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto cleanup_smf_entries;
+	}
+
+	upf_accel_ctx->quota_urrs = rte_calloc("Quota URRs",
+					       RTE_MAX(upf_accel_ctx->upf_accel_cfg->urrs->num_urrs, 1ul),
+					       sizeof(*upf_accel_ctx->quota_urrs),
+					       RTE_CACHE_LINE_SIZE);
+	if (!upf_accel_ctx->quota_urrs) {
+		DOCA_LOG_ERR("Failed to allocate quota URRs");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto cleanup_smf_meter_entries;
+	}
+
 	result = init_doca_flow_cb(upf_accel_ctx->num_queues,
 				   "vnf,hws",
 				   &upf_accel_ctx->resource,
@@ -1178,7 +1239,7 @@ static doca_error_t init_upf_accel(struct upf_accel_ctx *upf_accel_ctx, struct u
 				   NULL);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to init DOCA Flow: %s", doca_error_get_descr(result));
-		return result;
+		goto cleanup_quota_urrs;
 	}
 
 	result = upf_accel_fp_data_init(upf_accel_ctx, fp_data_arr);
@@ -1251,6 +1312,12 @@ cleanup_fp_data:
 	upf_accel_fp_data_cleanup(*fp_data_arr);
 cleanup_doca_flow:
 	doca_flow_destroy();
+cleanup_quota_urrs:
+	rte_free(upf_accel_ctx->quota_urrs);
+cleanup_smf_meter_entries:
+	rte_free(upf_accel_ctx->smf_meter_entries);
+cleanup_smf_entries:
+	rte_free(upf_accel_ctx->smf_entries);
 
 	return result;
 }
@@ -1418,6 +1485,28 @@ static doca_error_t fixed_port_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * Callback to handle quota counters sweep interval param
+ *
+ * @param [in]: input param (interval in milliseconds)
+ * @config [in]: UPF Acceleration configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t quota_interval_callback(void *param, void *config)
+{
+	struct upf_accel_config *cfg = (struct upf_accel_config *)config;
+	const int32_t n = *(const int32_t *)param;
+
+	if (n < 0) {
+		DOCA_LOG_ERR("Bad param: quota-interval-ms must be greater or equal to 0");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	cfg->quota_interval_ms = n;
+
+	return DOCA_SUCCESS;
+}
+
 /*
  * Handle application parameters registration
  *
@@ -1430,6 +1519,7 @@ static doca_error_t upf_accel_register_params(void)
 	struct doca_argp_param *aging_time_sec_param;
 	struct doca_argp_param *pkts_before_accel_param;
 	struct doca_argp_param *fixed_port_param;
+	struct doca_argp_param *quota_interval_param;
 	doca_error_t result;
 
 	/* Create and register UPF Acceleration JSON PDR definitions file path */
@@ -1520,6 +1610,25 @@ static doca_error_t upf_accel_register_params(void)
 		return result;
 	}
 
+	/* Create and register UPF Acceleration quota counters sweep interval */
+	result = doca_argp_param_create(&quota_interval_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(quota_interval_param, "q");
+	doca_argp_param_set_long_name(quota_interval_param, "quota-interval-ms");
+	doca_argp_param_set_description(
+		quota_interval_param,
+		"Interval in milliseconds between quota counters sweeps, 0 disables quota enforcement");
+	doca_argp_param_set_callback(quota_interval_param, quota_interval_callback);
+	doca_argp_param_set_type(quota_interval_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(quota_interval_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	return DOCA_SUCCESS;
 }
 
@@ -1553,6 +1662,7 @@ int main(int argc, char **argv)
 		.sw_aging_time_sec = UPF_ACCEL_SW_AGING_TIME_DEFAULT_SEC,
 		.dpi_threshold = UPF_ACCEL_DEFAULT_DPI_THRESHOLD,
 		.fixed_port = UPF_ACCEL_FIXED_PORT_NONE,
+		.quota_interval_ms = UPF_ACCEL_QUOTA_INTERVAL_DEFAULT_MS,
 	};
 	struct application_dpdk_config dpdk_config = {
 		.port_config.nb_hairpin_q = 1,
@@ -1629,9 +1739,9 @@ int main(int argc, char **argv)
 	upf_accel_ctx.num_queues = dpdk_config.port_config.nb_queues;
 	upf_accel_ctx.resource.nr_counters = UPF_ACCEL_MAX_NUM_CONNECTIONS;
 	upf_accel_ctx.num_shared_resources[DOCA_FLOW_SHARED_RESOURCE_METER] =
-		upf_accel_calc_num_shared_meters(upf_accel_ctx.num_ports);
+		upf_accel_calc_num_shared_meters(upf_accel_ctx.num_ports, upf_accel_cfg.pdrs->num_pdrs);
 	upf_accel_ctx.num_shared_resources[DOCA_FLOW_SHARED_RESOURCE_COUNTER] =
-		upf_accel_calc_num_shared_counters(upf_accel_ctx.num_ports);
+		upf_accel_calc_num_shared_counters(upf_accel_ctx.num_ports, upf_accel_cfg.pdrs->num_pdrs);
 	upf_accel_ctx.get_fwd_port = (upf_accel_ctx.num_ports == 1) ? upf_accel_single_port_get_fwd_port :
 								      upf_accel_get_opposite_port;
 	upf_accel_ctx.upf_accel_cfg = &upf_accel_cfg;
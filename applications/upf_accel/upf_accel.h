@@ -50,11 +50,9 @@ enum upf_accel_port {
 #define UPF_ACCEL_PDR_URRIDS_LEN 16
 #define UPF_ACCEL_PDR_QERIDS_LEN 16
 
-#define UPF_ACCEL_LOG_MAX_NUM_PDR 5
+#define UPF_ACCEL_LOG_MAX_NUM_PDR 16
 #define UPF_ACCEL_MAX_NUM_PDR (1ul << UPF_ACCEL_LOG_MAX_NUM_PDR)
 
-#define UPF_ACCEL_NUM_QUOTA_COUNTERS_PER_PORT UPF_ACCEL_MAX_NUM_PDR
-
 #define UPF_ACCEL_SRC_MAC \
 	{ \
 		0xde, 0xad, 0xbe, 0xef, 0x00, 0x01 \
@@ -80,6 +78,9 @@ enum upf_accel_port {
 
 #define UPF_ACCEL_SW_AGING_TIME_DEFAULT_SEC (15)
 
+/* Interval between two quota counter sweeps of a core, spread evenly across the cores */
+#define UPF_ACCEL_QUOTA_INTERVAL_DEFAULT_MS (100)
+
 /*
  * Number of packets handled in SW before deciding to accelerate, example:
  * If UPF_ACCEL_DEFAULT_DPI_THRESHOLD = 2 then we handle 2 packets in SW,
@@ -97,6 +98,7 @@ extern volatile bool force_quit;
 typedef enum upf_accel_port (*upf_accel_get_forwarding_port)(enum upf_accel_port port_id);
 
 struct upf_accel_fp_data;
+struct upf_accel_pdr_classifier;
 
 enum upf_accel_pdr_pdi_si {
 	/* Only those two types are supported */
@@ -113,6 +115,7 @@ enum upf_accel_pipe_drop_type {
 	UPF_ACCEL_DROP_DBG,
 	UPF_ACCEL_DROP_RATE,
 	UPF_ACCEL_DROP_FILTER,
+	UPF_ACCEL_DROP_QUOTA,
 	UPF_ACCEL_DROP_NUM,
 };
 
@@ -169,7 +172,7 @@ enum upf_accel_flow_status {
 
 struct app_shared_counter_ids {
 	uint32_t *ids[UPF_ACCEL_PORTS_MAX]; /* Array of IDs per port */
-	uint16_t cntr_0;		    /* Index of the first counter */
+	uint32_t cntr_0;		    /* Index of the first counter */
 	size_t cntrs_num;		    /* Number of counters (in each port) */
 };
 
@@ -232,6 +235,11 @@ struct upf_accel_urrs {
 	struct upf_accel_urr arr_urrs[]; /* URRs array */
 };
 
+struct upf_accel_quota_urr {
+	uint64_t used_bytes; /* Volume used by all the URR PDRs, updated atomically by the cores */
+	bool exceeded;	     /* Volume quota exceeded, set atomically by the first core to notice */
+};
+
 struct upf_accel_qer {
 	uint32_t id;	     /* QER ID */
 	uint8_t qfi;	     /* QFI */
@@ -256,17 +264,19 @@ struct upf_accel_vxlans {
 };
 
 struct upf_accel_config {
-	const char *smf_config_file_path;   /* Path to SMF configuration file */
-	struct upf_accel_pdrs *pdrs;	    /* PDRs */
-	struct upf_accel_fars *fars;	    /* FARs */
-	struct upf_accel_urrs *urrs;	    /* URRs */
-	struct upf_accel_qers *qers;	    /* QERs */
-	const char *vxlan_config_file_path; /* Path to SMF configuration file */
-	struct upf_accel_vxlans *vxlans;    /* VXLANs */
-	uint32_t hw_aging_time_sec;	    /* Amount of seconds before deleting an accelerated flow */
-	uint32_t sw_aging_time_sec;	    /* Amount of seconds before deleting an unaccelerated flow */
-	uint32_t dpi_threshold;		    /* Number of packets handled in SW before deciding to accelerate */
-	uint32_t fixed_port;		    /* UL port number in fixed port mode */
+	const char *smf_config_file_path;	  /* Path to SMF configuration file */
+	struct upf_accel_pdrs *pdrs;		  /* PDRs */
+	struct upf_accel_pdr_classifier *pdr_cls; /* PDR classifier built from the PDRs */
+	struct upf_accel_fars *fars;		  /* FARs */
+	struct upf_accel_urrs *urrs;		  /* URRs */
+	struct upf_accel_qers *qers;		  /* QERs */
+	const char *vxlan_config_file_path;	  /* Path to SMF configuration file */
+	struct upf_accel_vxlans *vxlans;	  /* VXLANs */
+	uint32_t hw_aging_time_sec;		  /* Amount of seconds before deleting an accelerated flow */
+	uint32_t sw_aging_time_sec;		  /* Amount of seconds before deleting an unaccelerated flow */
+	uint32_t dpi_threshold;			  /* Number of packets handled in SW before deciding to accelerate */
+	uint32_t fixed_port;			  /* UL port number in fixed port mode */
+	uint32_t quota_interval_ms;		  /* Quota counters sweep interval, 0 to disable quotas */
 };
 
 struct upf_accel_match_tun {
@@ -335,15 +345,17 @@ struct upf_accel_entry_ctx {
 } __rte_aligned(RTE_CACHE_LINE_SIZE);
 
 struct upf_accel_ctx {
-	uint16_t num_ports;						       /* Number of ports */
-	uint16_t num_queues;						       /* Number of device queues */
-	struct flow_resources resource;					       /* Flow resources */
-	uint32_t num_shared_resources[SHARED_RESOURCE_NUM_VALUES];	       /* Number of shared resources */
-	const struct upf_accel_config *upf_accel_cfg;			       /* UPF Acceleration configuration */
-	struct doca_flow_pipe *pipes[UPF_ACCEL_PORTS_MAX][UPF_ACCEL_PIPE_NUM]; /* Pipes */
-	struct doca_flow_port *ports[UPF_ACCEL_PORTS_MAX];		       /* Ports */
-	struct doca_dev *dev_arr[UPF_ACCEL_PORTS_MAX];			       /* Devices array */
-	struct doca_flow_pipe_entry *smf_entries[UPF_ACCEL_MAX_NUM_PDR][UPF_ACCEL_PORTS_MAX]; /* Resulting hw entries */
+	uint16_t num_ports;							/* Number of ports */
+	uint16_t num_queues;							/* Number of device queues */
+	struct flow_resources resource;						/* Flow resources */
+	uint32_t num_shared_resources[SHARED_RESOURCE_NUM_VALUES];		/* Number of shared resources */
+	const struct upf_accel_config *upf_accel_cfg;				/* UPF Acceleration configuration */
+	struct doca_flow_pipe *pipes[UPF_ACCEL_PORTS_MAX][UPF_ACCEL_PIPE_NUM];	/* Pipes */
+	struct doca_flow_port *ports[UPF_ACCEL_PORTS_MAX];			/* Ports */
+	struct doca_dev *dev_arr[UPF_ACCEL_PORTS_MAX];				/* Devices array */
+	struct doca_flow_pipe_entry *(*smf_entries)[UPF_ACCEL_PORTS_MAX];	/* Resulting hw entries, per PDR */
+	struct doca_flow_pipe_entry *(*smf_meter_entries)[UPF_ACCEL_PORTS_MAX];	/* First meter entries, per PDR */
+	struct upf_accel_quota_urr *quota_urrs;					/* Quota state, per URR */
 	struct doca_flow_pipe_entry *drop_entries[UPF_ACCEL_DROP_NUM][UPF_ACCEL_NUM_DOMAINS]; /* Resulting hw Drops
 												 entries */
 	struct upf_accel_entry_ctx static_entry_ctx[UPF_ACCEL_PORTS_MAX]; /* Static entries contexs */
@@ -423,6 +435,42 @@ static inline enum upf_accel_port upf_accel_get_opposite_port(enum upf_accel_por
 	return opposite_port;
 }
 
+/*
+ * Get the offset of a meter.
+ *
+ * Meters are organized as follows:
+ *
+ *         --       --
+ *         |        | Meter[0]
+ *         |        | Meter[1]
+ *         | PDR[0]- ...
+ *         |        |
+ *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS - 1]
+ * Port[0]-         --
+ *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS]
+ *         |        | Meter[UPF_ACCEL_MAX_PDR_NUM_RATE_METERS +1]
+ *         | PDR[1] - ...
+ *         |        |
+ *         |        |
+ *         --       -
+ *...
+ *
+ * @num_pdrs [in]: number of PDRs.
+ * @port_id [in]: port ID .
+ * @pdr_idx [in]: PDR index.
+ * @meter_idx [in]: meter index.
+ * @return: offset in meter table.
+ */
+static inline uint32_t upf_accel_shared_meters_table_offset_get(size_t num_pdrs,
+								enum upf_accel_port port_id,
+								uint32_t pdr_idx,
+								uint32_t meter_idx)
+{
+	const uint32_t num_meters_per_port = UPF_ACCEL_MAX_PDR_NUM_RATE_METERS * num_pdrs;
+
+	return (port_id * num_meters_per_port) + UPF_ACCEL_MAX_PDR_NUM_RATE_METERS * pdr_idx + meter_idx;
+}
+
 /*
  * SMF Config parsing & initialization
  *
@@ -38,12 +38,15 @@
 
 #include "upf_accel.h"
 #include "upf_accel_flow_processing.h"
+#include "upf_accel_pdr_classifier.h"
 
 #define UPF_ACCEL_MAX_PKT_BURST 32
 /* Maximum DOCA Flow entries to age in an aging function call */
 #define UPF_ACCEL_MAX_NUM_AGING (UPF_ACCEL_MAX_PKT_BURST * 2)
 /* Maximum timeout for DOCA Flow handling and processing functions. 0 for no limit */
 #define UPF_ACCEL_DOCA_FLOW_MAX_TIMEOUT_US (0)
+/* Maximum quota counters to query in a single DOCA Flow query call */
+#define UPF_ACCEL_MAX_NUM_QUOTA_QUERY 64
 
 struct upf_accel_fp_burst_ctx {
 	struct rte_mbuf *rx_pkts[UPF_ACCEL_MAX_PKT_BURST];	     /* Rx packet burst */
@@ -205,6 +208,11 @@ static void upf_accel_static_entry_cb(struct upf_accel_static_entry_ctx *static_
 			entries_status->failure = true; /* set failure to true if processing failed */
 		entries_status->nb_processed++;
 		break;
+	case DOCA_FLOW_ENTRY_OP_UPD:
+		/* Static entries are only updated by the datapath cores on quota enforcement */
+		if (status != DOCA_FLOW_ENTRY_STATUS_SUCCESS)
+			DOCA_LOG_ERR("Failed to process static entry update");
+		break;
 	default:
 		DOCA_LOG_ERR("UPF accel static entry cb - bad op %u", op);
 		return;
@@ -418,29 +426,6 @@ static inline bool upf_accel_flow_is_alive(enum upf_accel_flow_status flow_statu
 	return flow_status != UPF_ACCEL_FLOW_STATUS_NONE;
 }
 
-/*
- * Returns a mask with `mask` number of set MSBs
- *
- * @mask [in]: number of MSbits to set.
- * @return: netmask
- */
-static inline uint32_t ipv4_netmask_get(uint8_t mask)
-{
-	return ~((1ul << (32 - mask)) - 1);
-}
-
-/*
- * Check if masked IPV4 address is matching
- *
- * @masked [in]: struct of a masked IPV4 address.
- * @ipv4 [in]: ipv4 address to match
- * @return: true if the address matches, otherwise false.
- */
-static inline bool ipv4_masked_is_matching(const struct upf_accel_ip_addr *masked, uint32_t ipv4)
-{
-	return masked->v4 == (ipv4 & ipv4_netmask_get(masked->netmask));
-}
-
 /*
  * Parse 5 tuple data from a raw packet, without ethernet header.
  *
@@ -570,80 +555,6 @@ static doca_error_t upf_accel_wan_match(uint8_t *data,
 				  &match->ip_proto);
 }
 
-/*
- * Check if a given tunnel header matches the PDR properties.
- *
- * @pdr [in]: the PDR describing the match criteria
- * @match [in]: header to check
- * @return: true if the header matches, otherwise false.
- */
-static bool upf_accel_pdr_tunnel_is_matching(const struct upf_accel_pdr *pdr, const struct upf_accel_match_tun *match)
-{
-	if (match->te_id < pdr->pdi_local_teid_start || match->te_id > pdr->pdi_local_teid_end)
-		return false;
-
-	if ((match->qfi || pdr->pdi_qfi) && pdr->pdi_qfi != match->qfi)
-		return false;
-
-	return ipv4_masked_is_matching(&pdr->pdi_local_teid_ip, match->te_ip);
-}
-
-/*
- * Check if a given 5 tuple header matches the PDR properties.
- *
- * @pdr [in]: the PDR describing the match criteria
- * @match [in]: header to check
- * @return: true if the header matches, otherwise false.
- */
-static bool upf_accel_pdr_tuple_is_matching(const struct upf_accel_pdr *pdr, const struct upf_accel_match_5t *match)
-{
-	if (pdr->pdi_sdf_proto && match->ip_proto != pdr->pdi_sdf_proto)
-		return false;
-
-	if (match->ue_port < pdr->pdi_sdf_from_port_range.from || match->ue_port > pdr->pdi_sdf_from_port_range.to)
-		return false;
-
-	if (match->extern_port < pdr->pdi_sdf_to_port_range.from || match->extern_port > pdr->pdi_sdf_to_port_range.to)
-		return false;
-
-	if (pdr->pdi_sdf_from_ip.v4 && !ipv4_masked_is_matching(&pdr->pdi_sdf_from_ip, match->ue_ip))
-		return false;
-
-	if (pdr->pdi_sdf_to_ip.v4 && !ipv4_masked_is_matching(&pdr->pdi_sdf_to_ip, match->extern_ip))
-		return false;
-
-	return ipv4_masked_is_matching(&pdr->pdi_ueip, match->ue_ip);
-}
-
-/*
- * Lookup a PDR that matches a given 8 tuple, from RAN side
- *
- * @pdrs [in]: list of PDRs
- * @match [in]: header to check
- * @return: pointer to a matching PDR, or NULL if non found
- */
-static const struct upf_accel_pdr *upf_accel_ran_pdr_lookup(const struct upf_accel_pdrs *pdrs,
-							    const struct upf_accel_match_8t *match)
-{
-	const struct upf_accel_pdr *pdr;
-	size_t i;
-
-	for (i = 0; i < pdrs->num_pdrs; i++) {
-		pdr = &pdrs->arr_pdrs[i];
-		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_UL)
-			continue;
-
-		if (!upf_accel_pdr_tunnel_is_matching(pdr, &match->outer))
-			continue;
-		if (!upf_accel_pdr_tuple_is_matching(pdr, &match->inner))
-			continue;
-
-		return pdr;
-	}
-
-	return NULL;
-}
-
 /*
  * Decap GTPU header of a packet inplace
  *
@@ -664,33 +575,6 @@ static void upf_accel_decap(struct rte_mbuf *pkt, struct tun_parser_ctx *parse_c
 	SET_MAC_ADDR(eth->dst_addr.addr_bytes, dst_mac[0], dst_mac[1], dst_mac[2], dst_mac[3], dst_mac[4], dst_mac[5]);
 }
 
-/*
- * Lookup a PDR that matches a given 5 tuple, from WAN side
- *
- * @pdrs [in]: list of PDRs
- * @match [in]: header to check
- * @return: pointer to a matching PDR, or NULL if non found
- */
-static const struct upf_accel_pdr *upf_accel_wan_pdr_lookup(const struct upf_accel_pdrs *pdrs,
-							    const struct upf_accel_match_5t *match)
-{
-	const struct upf_accel_pdr *pdr;
-	size_t i;
-
-	for (i = 0; i < pdrs->num_pdrs; i++) {
-		pdr = &pdrs->arr_pdrs[i];
-		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_DL)
-			continue;
-
-		if (!upf_accel_pdr_tuple_is_matching(pdr, match))
-			continue;
-
-		return pdr;
-	}
-
-	return NULL;
-}
-
 /*
  * Accelerating 8T flow to the applicable DOCA flow pipe.
  *
@@ -917,8 +801,8 @@ static doca_error_t upf_accel_fp_pdr_lookup(struct upf_accel_fp_data *fp_data,
 	const struct upf_accel_pdr *pdr;
 
 	pdr = pkt_type == PARSER_PKT_TYPE_TUNNELED ?
-		      upf_accel_ran_pdr_lookup(fp_data->ctx->upf_accel_cfg->pdrs, match) :
-		      upf_accel_wan_pdr_lookup(fp_data->ctx->upf_accel_cfg->pdrs, &match->inner);
+		      upf_accel_pdr_classifier_ran_lookup(fp_data->ctx->upf_accel_cfg->pdr_cls, match) :
+		      upf_accel_pdr_classifier_wan_lookup(fp_data->ctx->upf_accel_cfg->pdr_cls, &match->inner);
 	if (!pdr) {
 		DOCA_LOG_DBG("Failed to lookup PDR for packet type %u", pkt_type);
 		return DOCA_ERROR_NOT_FOUND;
@@ -1363,29 +1247,45 @@ static void upf_accel_fp_run(struct upf_accel_fp_data *fp_data)
 }
 
 /*
- * Check and handles (if exceeds) a quota for pdr
+ * Steer the traffic of a PDR to the quota drop pipe on all ports
  *
- * @ctx [in]: UPF Acceleration context
- * @pdr_id [in]: pdr ID
- * @query [in]: quota counter query
+ * The first meter entry of the PDR is updated to forward to the quota drop pipe, so both accelerated flows and
+ * packets sent from SW are dropped in the TX pipeline. The entry keeps its shared meter. The update is completed by
+ * the entries processing of the datapath loop.
+ *
+ * @fp_data [in]: flow processing data
+ * @pdr_idx [in]: index of the PDR in the PDRs array
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t handle_exceeds_quota_for_pdr(struct upf_accel_ctx *ctx,
-						 uint16_t pdr_id,
-						 struct doca_flow_resource_query *query)
+static doca_error_t upf_accel_quota_pdr_enforce(struct upf_accel_fp_data *fp_data, uint32_t pdr_idx)
 {
-	struct upf_accel_pdr *pdr = &ctx->upf_accel_cfg->pdrs->arr_pdrs[pdr_id];
-	struct upf_accel_urr *urr;
-	uint32_t i;
+	struct upf_accel_ctx *ctx = fp_data->ctx;
+	const size_t num_pdrs = ctx->upf_accel_cfg->pdrs->num_pdrs;
+	struct doca_flow_fwd fwd = {.type = DOCA_FLOW_FWD_PIPE};
+	struct doca_flow_monitor mon = {
+		.meter_type = DOCA_FLOW_RESOURCE_TYPE_SHARED,
+	};
+	enum upf_accel_port port_id;
+	doca_error_t result;
 
-	for (i = 0; i < pdr->urrids_num; ++i) {
-		urr = &ctx->upf_accel_cfg->urrs->arr_urrs[pdr->urrids[i]];
-		if (query->counter.total_bytes >= urr->volume_quota_total_volume) {
-			/*
-			 * Quota exceeded.
-			 * This code part should be implemented once a definition
-			 * of how to react is complete.
-			 */
+	for (port_id = 0; port_id < ctx->num_ports; port_id++) {
+		fwd.next_pipe = ctx->pipes[port_id][UPF_ACCEL_PIPE_TX_DROPS_START + UPF_ACCEL_DROP_QUOTA];
+		/* Same monitor as the entry was added with, the first meter of the PDR */
+		mon.shared_meter.shared_meter_id = upf_accel_shared_meters_table_offset_get(num_pdrs, port_id, pdr_idx, 0);
+
+		result = doca_flow_pipe_update_entry(fp_data->queue_id,
+						     ctx->pipes[port_id][UPF_ACCEL_PIPE_TX_SHARED_METERS_START],
+						     NULL,
+						     &mon,
+						     &fwd,
+						     DOCA_FLOW_NO_WAIT,
+						     ctx->smf_meter_entries[pdr_idx][port_id]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to update port %u meter entry of pdr index %u: %s",
+				     port_id,
+				     pdr_idx,
+				     doca_error_get_descr(result));
+			return result;
 		}
 	}
 
@@ -1393,45 +1293,124 @@ static doca_error_t handle_exceeds_quota_for_pdr(struct upf_accel_ctx *ctx,
 }
 
 /*
- * Iterates through all quota counters and handles if exceeds
+ * Account a quota counter query and enforce the quota of the PDR if its URR is exceeded
+ *
+ * The counter delta since the previous sweep is added to the URR, which may be shared by PDRs handled by other
+ * cores. Every core enforces the quota on its own PDRs once it sees the URR exceeded.
+ *
+ * @fp_data [in]: flow processing data
+ * @port_id [in]: port the counter was queried on
+ * @cntr_idx [in]: index of the counter among the core quota counters
+ * @query [in]: quota counter query
+ */
+static void upf_accel_quota_pdr_account(struct upf_accel_fp_data *fp_data,
+					enum upf_accel_port port_id,
+					uint32_t cntr_idx,
+					const struct doca_flow_resource_query *query)
+{
+	struct upf_accel_quota_pdr *quota_pdr = &fp_data->quota_pdrs[cntr_idx];
+	const uint32_t pdr_idx = fp_data->quota_cntrs.cntr_0 + cntr_idx;
+	struct upf_accel_quota_urr *quota_urr = &fp_data->ctx->quota_urrs[quota_pdr->urr_idx];
+	const struct upf_accel_urr *urr = &fp_data->ctx->upf_accel_cfg->urrs->arr_urrs[quota_pdr->urr_idx];
+	const uint64_t delta = query->counter.total_bytes - quota_pdr->last_bytes[port_id];
+	uint64_t used_bytes;
+
+	quota_pdr->last_bytes[port_id] = query->counter.total_bytes;
+	if (quota_pdr->enforced)
+		return;
+
+	used_bytes = delta ? __atomic_add_fetch(&quota_urr->used_bytes, delta, __ATOMIC_RELAXED) :
+			     __atomic_load_n(&quota_urr->used_bytes, __ATOMIC_RELAXED);
+	if (used_bytes < urr->volume_quota_total_volume)
+		return;
+
+	if (!__atomic_exchange_n(&quota_urr->exceeded, true, __ATOMIC_RELAXED))
+		DOCA_LOG_WARN("URR %u volume quota exceeded: used %lu of %lu bytes",
+			      urr->id,
+			      used_bytes,
+			      urr->volume_quota_total_volume);
+
+	if (upf_accel_quota_pdr_enforce(fp_data, pdr_idx) != DOCA_SUCCESS)
+		return;
+
+	quota_pdr->enforced = true;
+	DOCA_LOG_INFO("PDR %u traffic is dropped, URR %u volume quota exceeded",
+		      fp_data->ctx->upf_accel_cfg->pdrs->arr_pdrs[pdr_idx].id,
+		      urr->id);
+}
+
+/*
+ * Initialize the quota counters sweep of a core
+ *
+ * The first sweep of each core is delayed by its share of the interval, so the cores don't query their counters
+ * at the same time.
+ *
+ * @fp_data [in]: flow processing data
+ */
+static void upf_accel_quota_init(struct upf_accel_fp_data *fp_data)
+{
+	struct upf_accel_quota_sweep *sweep = &fp_data->quota_sweep;
+	const uint16_t num_cores = rte_lcore_count() - 1;
+
+	sweep->interval_tsc = fp_data->ctx->upf_accel_cfg->quota_interval_ms * rte_get_tsc_hz() / 1000;
+	sweep->next_tsc = rte_rdtsc() + sweep->interval_tsc * (fp_data->queue_id - 1) / num_cores;
+	sweep->in_progress = false;
+}
+
+/*
+ * Advance the quota counters sweep of a core
+ *
+ * Once the sweep interval expires, the quota counters of the core are queried, at most
+ * UPF_ACCEL_MAX_NUM_QUOTA_QUERY counters per call, so a single datapath loop iteration never pays for a full
+ * sweep.
  *
  * @fp_data [in]: flow processing data
  * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
  */
-static doca_error_t handle_exceeds_quotas(struct upf_accel_fp_data *fp_data)
+static doca_error_t upf_accel_quota_poll(struct upf_accel_fp_data *fp_data)
 {
+	struct doca_flow_resource_query query_results_array[UPF_ACCEL_MAX_NUM_QUOTA_QUERY];
 	struct app_shared_counter_ids *shared_counter_ids = &fp_data->quota_cntrs;
-	struct doca_flow_resource_query query_results_array[UPF_ACCEL_MAX_NUM_PDR];
-	size_t cntrs_num = shared_counter_ids->cntrs_num;
-	enum upf_accel_port port_id;
+	struct upf_accel_quota_sweep *sweep = &fp_data->quota_sweep;
+	uint32_t cntrs_num = shared_counter_ids->cntrs_num;
 	doca_error_t result;
-	uint16_t pdr_id;
+	uint32_t query_num;
+	uint64_t now;
 	uint32_t i;
 
-	if (!cntrs_num)
+	if (!sweep->interval_tsc || !cntrs_num)
 		return DOCA_SUCCESS;
 
-	for (port_id = 0; port_id < fp_data->ctx->num_ports; ++port_id) {
-		result = doca_flow_shared_resources_query(DOCA_FLOW_SHARED_RESOURCE_COUNTER,
-							  shared_counter_ids->ids[port_id],
-							  query_results_array,
-							  cntrs_num);
-		if (result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to query entries: %s", doca_error_get_descr(result));
-			return result;
-		}
+	if (!sweep->in_progress) {
+		now = rte_rdtsc();
+		if (now < sweep->next_tsc)
+			return DOCA_SUCCESS;
 
-		for (i = 0; i < cntrs_num; ++i) {
-			pdr_id = shared_counter_ids->cntr_0 + i;
+		sweep->next_tsc = now + sweep->interval_tsc;
+		sweep->port_id = 0;
+		sweep->cursor = 0;
+		sweep->in_progress = true;
+	}
 
-			result = handle_exceeds_quota_for_pdr(fp_data->ctx, pdr_id, &query_results_array[i]);
-			if (result != DOCA_SUCCESS) {
-				DOCA_LOG_ERR("Failed to handle quota for pdr %d: %s",
-					     pdr_id,
-					     doca_error_get_descr(result));
-				return result;
-			}
-		}
+	query_num = RTE_MIN(cntrs_num - sweep->cursor, (uint32_t)UPF_ACCEL_MAX_NUM_QUOTA_QUERY);
+	result = doca_flow_shared_resources_query(DOCA_FLOW_SHARED_RESOURCE_COUNTER,
+						  &shared_counter_ids->ids[sweep->port_id][sweep->cursor],
+						  query_results_array,
+						  query_num);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to query quota counters: %s", doca_error_get_descr(result));
+		sweep->in_progress = false;
+		return result;
+	}
+
+	for (i = 0; i < query_num; ++i)
+		upf_accel_quota_pdr_account(fp_data, sweep->port_id, sweep->cursor + i, &query_results_array[i]);
+
+	sweep->cursor += query_num;
+	if (sweep->cursor == cntrs_num) {
+		sweep->cursor = 0;
+		if (++sweep->port_id == fp_data->ctx->num_ports)
+			sweep->in_progress = false;
 	}
 
 	return DOCA_SUCCESS;
@@ -1442,6 +1421,7 @@ void upf_accel_fp_loop(struct upf_accel_fp_data *fp_data)
 	doca_error_t result;
 
 	upf_accel_aging_init(fp_data);
+	upf_accel_quota_init(fp_data);
 
 	while (!force_quit) {
 		upf_accel_fp_run(fp_data);
@@ -1449,10 +1429,8 @@ void upf_accel_fp_loop(struct upf_accel_fp_data *fp_data)
 		upf_accel_sw_aging_ll_scan(fp_data, PARSER_PKT_TYPE_TUNNELED);
 		upf_accel_sw_aging_ll_scan(fp_data, PARSER_PKT_TYPE_PLAIN);
 
-		result = handle_exceeds_quotas(fp_data);
-		if (result != DOCA_SUCCESS) {
-			DOCA_LOG_ERR("Failed to handle expired quotas: %s", doca_error_get_descr(result));
-			return;
-		}
+		result = upf_accel_quota_poll(fp_data);
+		if (result != DOCA_SUCCESS)
+			DOCA_LOG_ERR("Failed to poll quotas: %s", doca_error_get_descr(result));
 	}
 }
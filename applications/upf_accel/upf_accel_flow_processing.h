@@ -53,6 +53,20 @@ struct upf_accel_fp_accel_counters {
 	uint64_t aging_errors; /* Number of failed aging cases */
 };
 
+struct upf_accel_quota_pdr {
+	uint64_t last_bytes[UPF_ACCEL_PORTS_MAX]; /* Quota counter value seen by the previous sweep, per port */
+	uint32_t urr_idx;			  /* Index of the PDR URR in the URRs array */
+	bool enforced;				  /* PDR traffic is dropped due to an exceeded quota */
+};
+
+struct upf_accel_quota_sweep {
+	uint64_t interval_tsc;	     /* Interval between two sweep starts, 0 when quotas are disabled */
+	uint64_t next_tsc;	     /* Timestamp of the next sweep start */
+	enum upf_accel_port port_id; /* Port being swept */
+	uint32_t cursor;	     /* Next quota counter to query on the swept port */
+	bool in_progress;	     /* A sweep is in progress */
+};
+
 struct upf_accel_fp_data {
 	struct upf_accel_ctx *ctx;						  /* UPF Acceleration context */
 	uint16_t queue_id;							  /* Queue id */
@@ -60,6 +74,8 @@ struct upf_accel_fp_data {
 	struct upf_accel_entry_ctx *dyn_tbl_data;				  /* Dynamic connection table data */
 	struct upf_accel_fp_sw_counters sw_counters;				  /* SW DP counters */
 	struct app_shared_counter_ids quota_cntrs;				  /* Quota counters to handle */
+	struct upf_accel_quota_pdr *quota_pdrs;					  /* Quota state of the handled PDRs */
+	struct upf_accel_quota_sweep quota_sweep;				  /* Quota counters sweep state */
 	struct upf_accel_fp_accel_counters accel_counters[PARSER_PKT_TYPE_NUM];	  /* Port acceleration counters */
 	struct upf_accel_fp_accel_counters unaccel_counters[PARSER_PKT_TYPE_NUM]; /* Port not accelerated counters */
 	struct upf_accel_fp_accel_counters accel_failed_counters[PARSER_PKT_TYPE_NUM]; /* Port acceleration failed
@@ -35,6 +35,7 @@
 #include <doca_log.h>
 
 #include "upf_accel.h"
+#include "upf_accel_pdr_classifier.h"
 
 DOCA_LOG_REGISTER(UPF_ACCEL::JSON_PARSER);
 
@@ -1099,9 +1100,15 @@ doca_error_t upf_accel_smf_parse(struct upf_accel_config *cfg)
 	if (err != DOCA_SUCCESS)
 		goto err_urr;
 
+	err = upf_accel_pdr_classifier_create(cfg->pdrs, &cfg->pdr_cls);
+	if (err != DOCA_SUCCESS)
+		goto err_qer;
+
 	json_object_put(root);
 	return DOCA_SUCCESS;
 
+err_qer:
+	upf_accel_qer_cleanup(cfg);
 err_urr:
 	upf_accel_urr_cleanup(cfg);
 err_far:
@@ -1120,6 +1127,7 @@ err_json:
  */
 void upf_accel_smf_cleanup(struct upf_accel_config *cfg)
 {
+	upf_accel_pdr_classifier_destroy(cfg->pdr_cls);
 	upf_accel_qer_cleanup(cfg);
 	upf_accel_urr_cleanup(cfg);
 	upf_accel_far_cleanup(cfg);
@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <rte_malloc.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "upf_accel_pdr_classifier.h"
+
+DOCA_LOG_REGISTER(UPF_ACCEL::PDR_CLASSIFIER);
+
+struct upf_accel_pdr_cands {
+	uint32_t off; /* Offset of the first candidate in the candidates array */
+	uint32_t num; /* Number of candidates */
+};
+
+struct upf_accel_teid_seg {
+	uint32_t teid_start;		  /* First TEID of the segment, the segment ends where the next one starts */
+	struct upf_accel_pdr_cands cands; /* UL PDRs whose TEID range covers the segment */
+};
+
+struct upf_accel_ueip_entry {
+	uint32_t ueip;			  /* Masked UE IP */
+	struct upf_accel_pdr_cands cands; /* DL PDRs with this UE IP prefix */
+};
+
+struct upf_accel_ueip_table {
+	uint8_t netmask;		      /* Prefix length of all the table entries */
+	uint32_t num_entries;		      /* Number of entries */
+	struct upf_accel_ueip_entry *entries; /* Entries sorted by UE IP */
+};
+
+struct upf_accel_ueip_pdr {
+	uint8_t netmask;  /* UE IP prefix length */
+	uint32_t ueip;	  /* UE IP */
+	uint32_t pdr_idx; /* PDR index */
+};
+
+struct upf_accel_pdr_classifier {
+	const struct upf_accel_pdrs *pdrs;	   /* PDRs the classifier was built from */
+	uint32_t num_teid_segs;			   /* Number of TEID segments */
+	struct upf_accel_teid_seg *teid_segs;	   /* TEID segments sorted by start TEID */
+	uint32_t *teid_cands;			   /* UL PDR indexes of all the TEID segments */
+	uint32_t num_ueip_tables;		   /* Number of UE IP prefix length tables */
+	struct upf_accel_ueip_table *ueip_tables;  /* UE IP tables, one per prefix length */
+	struct upf_accel_ueip_entry *ueip_entries; /* Entries of all the UE IP tables */
+	uint32_t *ueip_cands;			   /* DL PDR indexes of all the UE IP entries */
+};
+
+/*
+ * Returns a mask with `mask` number of set MSBs
+ *
+ * @mask [in]: number of MSbits to set.
+ * @return: netmask
+ */
+static inline uint32_t ipv4_netmask_get(uint8_t mask)
+{
+	return ~((1ul << (32 - mask)) - 1);
+}
+
+/*
+ * Check if masked IPV4 address is matching
+ *
+ * @masked [in]: struct of a masked IPV4 address.
+ * @ipv4 [in]: ipv4 address to match
+ * @return: true if the address matches, otherwise false.
+ */
+static inline bool ipv4_masked_is_matching(const struct upf_accel_ip_addr *masked, uint32_t ipv4)
+{
+	return masked->v4 == (ipv4 & ipv4_netmask_get(masked->netmask));
+}
+
+/*
+ * Check if a given tunnel header matches the PDR properties.
+ *
+ * @pdr [in]: the PDR describing the match criteria
+ * @match [in]: header to check
+ * @return: true if the header matches, otherwise false.
+ */
+static bool upf_accel_pdr_tunnel_is_matching(const struct upf_accel_pdr *pdr, const struct upf_accel_match_tun *match)
+{
+	if (match->te_id < pdr->pdi_local_teid_start || match->te_id > pdr->pdi_local_teid_end)
+		return false;
+
+	if ((match->qfi || pdr->pdi_qfi) && pdr->pdi_qfi != match->qfi)
+		return false;
+
+	return ipv4_masked_is_matching(&pdr->pdi_local_teid_ip, match->te_ip);
+}
+
+/*
+ * Check if a given 5 tuple header matches the PDR properties.
+ *
+ * @pdr [in]: the PDR describing the match criteria
+ * @match [in]: header to check
+ * @return: true if the header matches, otherwise false.
+ */
+static bool upf_accel_pdr_tuple_is_matching(const struct upf_accel_pdr *pdr, const struct upf_accel_match_5t *match)
+{
+	if (pdr->pdi_sdf_proto && match->ip_proto != pdr->pdi_sdf_proto)
+		return false;
+
+	if (match->ue_port < pdr->pdi_sdf_from_port_range.from || match->ue_port > pdr->pdi_sdf_from_port_range.to)
+		return false;
+
+	if (match->extern_port < pdr->pdi_sdf_to_port_range.from || match->extern_port > pdr->pdi_sdf_to_port_range.to)
+		return false;
+
+	if (pdr->pdi_sdf_from_ip.v4 && !ipv4_masked_is_matching(&pdr->pdi_sdf_from_ip, match->ue_ip))
+		return false;
+
+	if (pdr->pdi_sdf_to_ip.v4 && !ipv4_masked_is_matching(&pdr->pdi_sdf_to_ip, match->extern_ip))
+		return false;
+
+	return ipv4_masked_is_matching(&pdr->pdi_ueip, match->ue_ip);
+}
+
+/*
+ * qsort comparator of TEIDs
+ *
+ * @a [in]: first TEID
+ * @b [in]: second TEID
+ * @return: negative, zero or positive if a is lower, equal or greater than b
+ */
+static int upf_accel_teid_cmp(const void *a, const void *b)
+{
+	const uint32_t teid_a = *(const uint32_t *)a;
+	const uint32_t teid_b = *(const uint32_t *)b;
+
+	return (teid_a > teid_b) - (teid_a < teid_b);
+}
+
+/*
+ * qsort comparator of UE IP PDRs, orders by prefix length, UE IP and then PDR index
+ *
+ * @a [in]: first UE IP PDR
+ * @b [in]: second UE IP PDR
+ * @return: negative, zero or positive if a is lower, equal or greater than b
+ */
+static int upf_accel_ueip_pdr_cmp(const void *a, const void *b)
+{
+	const struct upf_accel_ueip_pdr *pdr_a = a;
+	const struct upf_accel_ueip_pdr *pdr_b = b;
+
+	if (pdr_a->netmask != pdr_b->netmask)
+		return pdr_b->netmask - pdr_a->netmask;
+	if (pdr_a->ueip != pdr_b->ueip)
+		return (pdr_a->ueip > pdr_b->ueip) - (pdr_a->ueip < pdr_b->ueip);
+	return (pdr_a->pdr_idx > pdr_b->pdr_idx) - (pdr_a->pdr_idx < pdr_b->pdr_idx);
+}
+
+/*
+ * Find the TEID segment a TEID belongs to
+ *
+ * The first segment always starts at TEID 0 so every TEID belongs to exactly one segment.
+ *
+ * @classifier [in]: PDR classifier
+ * @teid [in]: TEID to look for
+ * @return: index of the last segment that starts at or below the TEID
+ */
+static uint32_t upf_accel_teid_seg_find(const struct upf_accel_pdr_classifier *classifier, uint32_t teid)
+{
+	uint32_t lo = 0;
+	uint32_t hi = classifier->num_teid_segs;
+	uint32_t mid;
+
+	while (hi - lo > 1) {
+		mid = lo + (hi - lo) / 2;
+		if (classifier->teid_segs[mid].teid_start <= teid)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * Find the entry of a masked UE IP in a UE IP table
+ *
+ * @table [in]: UE IP table
+ * @ueip [in]: masked UE IP
+ * @return: pointer to the entry, or NULL if non found
+ */
+static const struct upf_accel_ueip_entry *upf_accel_ueip_entry_find(const struct upf_accel_ueip_table *table,
+								    uint32_t ueip)
+{
+	uint32_t lo = 0;
+	uint32_t hi = table->num_entries;
+	uint32_t mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (table->entries[mid].ueip < ueip)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo == table->num_entries || table->entries[lo].ueip != ueip)
+		return NULL;
+
+	return &table->entries[lo];
+}
+
+/*
+ * Build the TEID interval index of the UL PDRs
+ *
+ * The TEID space is split into elementary segments at every range start and past every range end, so each
+ * segment is covered by a fixed set of UL PDRs.
+ *
+ * @classifier [in/out]: PDR classifier
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t upf_accel_pdr_classifier_teid_build(struct upf_accel_pdr_classifier *classifier)
+{
+	const struct upf_accel_pdrs *pdrs = classifier->pdrs;
+	struct upf_accel_pdr_cands *cands;
+	const struct upf_accel_pdr *pdr;
+	uint32_t *bounds = NULL;
+	uint32_t num_bounds = 0;
+	uint64_t num_cands = 0;
+	uint32_t first, last;
+	doca_error_t err;
+	uint32_t seg;
+	uint32_t off;
+	uint32_t i;
+
+	bounds = rte_malloc("UPF PDR TEID bounds", sizeof(*bounds) * (2 * pdrs->num_pdrs + 1), 0);
+	if (!bounds) {
+		DOCA_LOG_ERR("Failed to allocate TEID bounds memory");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	bounds[num_bounds++] = 0;
+	for (i = 0; i < pdrs->num_pdrs; i++) {
+		pdr = &pdrs->arr_pdrs[i];
+		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_UL || pdr->pdi_local_teid_start > pdr->pdi_local_teid_end)
+			continue;
+
+		bounds[num_bounds++] = pdr->pdi_local_teid_start;
+		if (pdr->pdi_local_teid_end != UINT32_MAX)
+			bounds[num_bounds++] = pdr->pdi_local_teid_end + 1;
+	}
+
+	qsort(bounds, num_bounds, sizeof(*bounds), upf_accel_teid_cmp);
+
+	classifier->teid_segs = rte_zmalloc("UPF PDR TEID segments",
+					    sizeof(*classifier->teid_segs) * num_bounds,
+					    RTE_CACHE_LINE_SIZE);
+	if (!classifier->teid_segs) {
+		DOCA_LOG_ERR("Failed to allocate TEID segments memory");
+		err = DOCA_ERROR_NO_MEMORY;
+		goto out;
+	}
+
+	for (i = 0; i < num_bounds; i++) {
+		if (i && bounds[i] == bounds[i - 1])
+			continue;
+		classifier->teid_segs[classifier->num_teid_segs++].teid_start = bounds[i];
+	}
+
+	/* Count the candidates of each segment */
+	for (i = 0; i < pdrs->num_pdrs; i++) {
+		pdr = &pdrs->arr_pdrs[i];
+		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_UL || pdr->pdi_local_teid_start > pdr->pdi_local_teid_end)
+			continue;
+
+		first = upf_accel_teid_seg_find(classifier, pdr->pdi_local_teid_start);
+		last = upf_accel_teid_seg_find(classifier, pdr->pdi_local_teid_end);
+		for (seg = first; seg <= last; seg++)
+			classifier->teid_segs[seg].cands.num++;
+		num_cands += last - first + 1;
+	}
+
+	if (num_cands > UINT32_MAX) {
+		DOCA_LOG_ERR("Too many overlapping UL PDR TEID ranges");
+		err = DOCA_ERROR_TOO_BIG;
+		goto out;
+	}
+
+	classifier->teid_cands = rte_malloc("UPF PDR TEID candidates",
+					    sizeof(*classifier->teid_cands) * RTE_MAX(num_cands, 1ul),
+					    RTE_CACHE_LINE_SIZE);
+	if (!classifier->teid_cands) {
+		DOCA_LOG_ERR("Failed to allocate TEID candidates memory");
+		err = DOCA_ERROR_NO_MEMORY;
+		goto out;
+	}
+
+	for (seg = 0, off = 0; seg < classifier->num_teid_segs; seg++) {
+		classifier->teid_segs[seg].cands.off = off;
+		off += classifier->teid_segs[seg].cands.num;
+		classifier->teid_segs[seg].cands.num = 0;
+	}
+
+	/* Fill in PDR order so the candidates of each segment are sorted by priority */
+	for (i = 0; i < pdrs->num_pdrs; i++) {
+		pdr = &pdrs->arr_pdrs[i];
+		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_UL || pdr->pdi_local_teid_start > pdr->pdi_local_teid_end)
+			continue;
+
+		first = upf_accel_teid_seg_find(classifier, pdr->pdi_local_teid_start);
+		last = upf_accel_teid_seg_find(classifier, pdr->pdi_local_teid_end);
+		for (seg = first; seg <= last; seg++) {
+			cands = &classifier->teid_segs[seg].cands;
+			classifier->teid_cands[cands->off + cands->num++] = i;
+		}
+	}
+
+	err = DOCA_SUCCESS;
+out:
+	rte_free(bounds);
+	return err;
+}
+
+/*
+ * Build the UE IP index of the DL PDRs
+ *
+ * DL PDRs are grouped into one sorted table per UE IP prefix length. A lookup probes every table with the UE IP
+ * masked to the table prefix length.
+ *
+ * @classifier [in/out]: PDR classifier
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t upf_accel_pdr_classifier_ueip_build(struct upf_accel_pdr_classifier *classifier)
+{
+	const struct upf_accel_pdrs *pdrs = classifier->pdrs;
+	struct upf_accel_ueip_table *table = NULL;
+	struct upf_accel_ueip_entry *entry = NULL;
+	struct upf_accel_ueip_pdr *ueip_pdrs;
+	const struct upf_accel_pdr *pdr;
+	uint32_t num_ueip_pdrs = 0;
+	uint32_t num_entries = 0;
+	uint32_t num_tables = 0;
+	doca_error_t err;
+	uint32_t i;
+
+	ueip_pdrs = rte_malloc("UPF PDR UE IPs", sizeof(*ueip_pdrs) * RTE_MAX(pdrs->num_pdrs, 1ul), 0);
+	if (!ueip_pdrs) {
+		DOCA_LOG_ERR("Failed to allocate UE IP PDRs memory");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	for (i = 0; i < pdrs->num_pdrs; i++) {
+		pdr = &pdrs->arr_pdrs[i];
+		if (pdr->pdi_si != UPF_ACCEL_PDR_PDI_SI_DL)
+			continue;
+
+		/* A UE IP with bits set past its prefix never matches a masked address */
+		if (pdr->pdi_ueip.v4 & ~ipv4_netmask_get(pdr->pdi_ueip.netmask))
+			continue;
+
+		ueip_pdrs[num_ueip_pdrs].netmask = pdr->pdi_ueip.netmask;
+		ueip_pdrs[num_ueip_pdrs].ueip = pdr->pdi_ueip.v4;
+		ueip_pdrs[num_ueip_pdrs].pdr_idx = i;
+		num_ueip_pdrs++;
+	}
+
+	qsort(ueip_pdrs, num_ueip_pdrs, sizeof(*ueip_pdrs), upf_accel_ueip_pdr_cmp);
+
+	for (i = 0; i < num_ueip_pdrs; i++) {
+		if (!i || ueip_pdrs[i].netmask != ueip_pdrs[i - 1].netmask)
+			num_tables++;
+		if (!i || ueip_pdrs[i].netmask != ueip_pdrs[i - 1].netmask ||
+		    ueip_pdrs[i].ueip != ueip_pdrs[i - 1].ueip)
+			num_entries++;
+	}
+
+	classifier->ueip_tables = rte_zmalloc("UPF PDR UE IP tables",
+					      sizeof(*classifier->ueip_tables) * RTE_MAX(num_tables, 1u),
+					      RTE_CACHE_LINE_SIZE);
+	classifier->ueip_entries = rte_zmalloc("UPF PDR UE IP entries",
+					       sizeof(*classifier->ueip_entries) * RTE_MAX(num_entries, 1u),
+					       RTE_CACHE_LINE_SIZE);
+	classifier->ueip_cands = rte_malloc("UPF PDR UE IP candidates",
+					    sizeof(*classifier->ueip_cands) * RTE_MAX(num_ueip_pdrs, 1u),
+					    RTE_CACHE_LINE_SIZE);
+	if (!classifier->ueip_tables || !classifier->ueip_entries || !classifier->ueip_cands) {
+		DOCA_LOG_ERR("Failed to allocate UE IP index memory");
+		err = DOCA_ERROR_NO_MEMORY;
+		goto out;
+	}
+
+	/* Sorting by PDR index last keeps the candidates of each entry sorted by priority */
+	for (i = 0; i < num_ueip_pdrs; i++) {
+		if (!i || ueip_pdrs[i].netmask != ueip_pdrs[i - 1].netmask) {
+			table = &classifier->ueip_tables[classifier->num_ueip_tables++];
+			table->netmask = ueip_pdrs[i].netmask;
+			table->entries = entry ? entry + 1 : classifier->ueip_entries;
+			entry = NULL;
+		}
+
+		if (!entry || entry->ueip != ueip_pdrs[i].ueip) {
+			entry = &table->entries[table->num_entries++];
+			entry->ueip = ueip_pdrs[i].ueip;
+			entry->cands.off = i;
+		}
+
+		entry->cands.num++;
+		classifier->ueip_cands[i] = ueip_pdrs[i].pdr_idx;
+	}
+
+	err = DOCA_SUCCESS;
+out:
+	rte_free(ueip_pdrs);
+	return err;
+}
+
+doca_error_t upf_accel_pdr_classifier_create(const struct upf_accel_pdrs *pdrs,
+					     struct upf_accel_pdr_classifier **classifier)
+{
+	struct upf_accel_pdr_classifier *cls;
+	doca_error_t err;
+
+	cls = rte_zmalloc("UPF PDR classifier", sizeof(*cls), RTE_CACHE_LINE_SIZE);
+	if (!cls) {
+		DOCA_LOG_ERR("Failed to allocate PDR classifier memory");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	cls->pdrs = pdrs;
+
+	err = upf_accel_pdr_classifier_teid_build(cls);
+	if (err != DOCA_SUCCESS)
+		goto err_cls;
+
+	err = upf_accel_pdr_classifier_ueip_build(cls);
+	if (err != DOCA_SUCCESS)
+		goto err_cls;
+
+	DOCA_LOG_INFO("PDR classifier built for %zu PDRs: %u UL TEID segments, %u DL UE IP prefix lengths",
+		      pdrs->num_pdrs,
+		      cls->num_teid_segs,
+		      cls->num_ueip_tables);
+
+	*classifier = cls;
+	return DOCA_SUCCESS;
+
+err_cls:
+	upf_accel_pdr_classifier_destroy(cls);
+	return err;
+}
+
+void upf_accel_pdr_classifier_destroy(struct upf_accel_pdr_classifier *classifier)
+{
+	if (!classifier)
+		return;
+
+	rte_free(classifier->ueip_cands);
+	rte_free(classifier->ueip_entries);
+	rte_free(classifier->ueip_tables);
+	rte_free(classifier->teid_cands);
+	rte_free(classifier->teid_segs);
+	rte_free(classifier);
+}
+
+const struct upf_accel_pdr *upf_accel_pdr_classifier_ran_lookup(const struct upf_accel_pdr_classifier *classifier,
+								const struct upf_accel_match_8t *match)
+{
+	const struct upf_accel_teid_seg *seg;
+	const struct upf_accel_pdr *pdr;
+	uint32_t i;
+
+	seg = &classifier->teid_segs[upf_accel_teid_seg_find(classifier, match->outer.te_id)];
+
+	for (i = 0; i < seg->cands.num; i++) {
+		pdr = &classifier->pdrs->arr_pdrs[classifier->teid_cands[seg->cands.off + i]];
+
+		if (!upf_accel_pdr_tunnel_is_matching(pdr, &match->outer))
+			continue;
+		if (!upf_accel_pdr_tuple_is_matching(pdr, &match->inner))
+			continue;
+
+		return pdr;
+	}
+
+	return NULL;
+}
+
+const struct upf_accel_pdr *upf_accel_pdr_classifier_wan_lookup(const struct upf_accel_pdr_classifier *classifier,
+								const struct upf_accel_match_5t *match)
+{
+	const struct upf_accel_ueip_table *table;
+	const struct upf_accel_ueip_entry *entry;
+	uint32_t best_idx = UINT32_MAX;
+	uint32_t pdr_idx;
+	uint32_t t, i;
+
+	/* The same PDR can't appear in two tables, keep the lowest matching index across all of them */
+	for (t = 0; t < classifier->num_ueip_tables; t++) {
+		table = &classifier->ueip_tables[t];
+		entry = upf_accel_ueip_entry_find(table, match->ue_ip & ipv4_netmask_get(table->netmask));
+		if (!entry)
+			continue;
+
+		for (i = 0; i < entry->cands.num; i++) {
+			pdr_idx = classifier->ueip_cands[entry->cands.off + i];
+			if (pdr_idx >= best_idx)
+				break;
+
+			if (!upf_accel_pdr_tuple_is_matching(&classifier->pdrs->arr_pdrs[pdr_idx], match))
+				continue;
+
+			best_idx = pdr_idx;
+			break;
+		}
+	}
+
+	return best_idx == UINT32_MAX ? NULL : &classifier->pdrs->arr_pdrs[best_idx];
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef UPF_ACCEL_PDR_CLASSIFIER_H_
+#define UPF_ACCEL_PDR_CLASSIFIER_H_
+
+#include "upf_accel.h"
+
+/*
+ * Build the PDR classifier out of the parsed PDRs
+ *
+ * UL PDRs are indexed by their local TEID range, DL PDRs by their UE IP prefix. Each index bucket holds the
+ * candidate PDRs ordered by their position in the PDR list, so lookups keep the first-match priority.
+ *
+ * @pdrs [in]: parsed PDRs, must outlive the classifier
+ * @classifier [out]: the created classifier
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t upf_accel_pdr_classifier_create(const struct upf_accel_pdrs *pdrs,
+					     struct upf_accel_pdr_classifier **classifier);
+
+/*
+ * Destroy a PDR classifier
+ *
+ * @classifier [in]: classifier to destroy, may be NULL
+ */
+void upf_accel_pdr_classifier_destroy(struct upf_accel_pdr_classifier *classifier);
+
+/*
+ * Lookup the first UL PDR that matches a given 8 tuple, from RAN side
+ *
+ * @classifier [in]: PDR classifier
+ * @match [in]: header to check
+ * @return: pointer to a matching PDR, or NULL if non found
+ */
+const struct upf_accel_pdr *upf_accel_pdr_classifier_ran_lookup(const struct upf_accel_pdr_classifier *classifier,
+								const struct upf_accel_match_8t *match);
+
+/*
+ * Lookup the first DL PDR that matches a given 5 tuple, from WAN side
+ *
+ * @classifier [in]: PDR classifier
+ * @match [in]: header to check
+ * @return: pointer to a matching PDR, or NULL if non found
+ */
+const struct upf_accel_pdr *upf_accel_pdr_classifier_wan_lookup(const struct upf_accel_pdr_classifier *classifier,
+								const struct upf_accel_match_5t *match);
+
+#endif /* UPF_ACCEL_PDR_CLASSIFIER_H_ */
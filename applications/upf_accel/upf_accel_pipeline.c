@@ -399,7 +399,7 @@ static doca_error_t upf_accel_pipe_encap_counter_create(struct upf_accel_ctx *up
 
 	pipe_cfg->name = pipe_name;
 	pipe_cfg->is_root = false;
-	pipe_cfg->num_entries = UPF_ACCEL_MAX_NUM_PDR;
+	pipe_cfg->num_entries = upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs;
 	pipe_cfg->match = &match;
 	pipe_cfg->match_mask = &match_mask;
 	pipe_cfg->mon = &mon;
@@ -849,7 +849,7 @@ static doca_error_t upf_accel_pipe_shared_meter_create(struct upf_accel_ctx *upf
 
 	pipe_cfg->name = pipe_name;
 	pipe_cfg->is_root = false;
-	pipe_cfg->num_entries = UPF_ACCEL_MAX_NUM_PDR;
+	pipe_cfg->num_entries = upf_accel_ctx->upf_accel_cfg->pdrs->num_pdrs;
 	pipe_cfg->match = &match;
 	pipe_cfg->match_mask = &match_mask;
 	pipe_cfg->mon = &mon;
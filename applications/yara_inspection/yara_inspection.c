@@ -54,12 +54,16 @@ int main(int argc, char **argv)
 {
 	doca_error_t result;
 	struct doca_log_backend *sdk_log;
-	struct yara_config yara_conf;
+	struct yara_config yara_conf = {0};
+	struct yara_process_cache process_cache = {0};
 	struct yara_resources resources;
 	struct doca_apsh_process **processes;
 	struct doca_apsh_yara **yara_matches;
 	doca_telemetry_exporter_type_index_t yara_index;
-	int num_processes, i, yara_matches_size;
+	int num_processes, i, j, yara_matches_size, nb_scanned;
+	int exit_status = EXIT_SUCCESS;
+	uint64_t iteration = 0;
+	bool full_scan, changed;
 	enum doca_apsh_yara_rule yara_rules_arr[] = {DOCA_APSH_YARA_RULE_MIMIKATZ, DOCA_APSH_YARA_RULE_HELLO_WORLD};
 	uint32_t yara_rules_arr_size = 2;
 	struct doca_telemetry_exporter_schema *telemetry_schema;
@@ -83,6 +87,12 @@ int main(int argc, char **argv)
 	if (result != DOCA_SUCCESS)
 		return EXIT_FAILURE;
 
+	/* Set default configuration values, a negative time interval marks it as not set */
+	yara_conf.time_interval = -1;
+	yara_conf.passes = 1;
+	yara_conf.region_size = DEFAULT_REGION_SIZE_KB;
+	yara_conf.full_scan_interval = DEFAULT_FULL_SCAN_INTERVAL;
+
 	/* Parse cmdline/json arguments */
 	result = doca_argp_init(NULL, &yara_conf);
 	if (result != DOCA_SUCCESS) {
@@ -102,6 +112,13 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
+	/* Offline mode, scan memory dumps without a DPU */
+	if (yara_conf.rules_path[0] != '\0') {
+		result = yara_offline_run(&yara_conf);
+		doca_argp_destroy();
+		return result == DOCA_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	/* Init the yara inspection app */
 	result = yara_inspection_init(&yara_conf, &resources);
 	if (result != DOCA_SUCCESS) {
@@ -114,21 +131,43 @@ int main(int argc, char **argv)
 	telemetry_enabled = (telemetry_start(&telemetry_schema, &telemetry_source, &yara_index) == DOCA_SUCCESS);
 
 	do {
+		/* Processes whose memory layout did not change are only scanned in full scan iterations */
+		yara_process_cache_next_epoch(&process_cache);
+		full_scan = (iteration++ % yara_conf.full_scan_interval) == 0;
+		nb_scanned = 0;
+
 		result = doca_apsh_processes_get(resources.sys, &processes, &num_processes);
-		if (result != DOCA_SUCCESS)
-			return result;
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to read the host processes: %s", doca_error_get_descr(result));
+			exit_status = EXIT_FAILURE;
+			break;
+		}
 		for (i = 0; i < num_processes; i++) {
+			/* The layout is only hashed when the skip is enabled, every iteration is a full scan otherwise */
+			if (yara_conf.full_scan_interval == 1 ||
+			    yara_process_cache_check(&process_cache, processes[i], &changed) != DOCA_SUCCESS)
+				changed = true;
+			if (!changed && !full_scan)
+				continue;
+			nb_scanned++;
+
 			result = doca_apsh_yara_get(processes[i],
 						    yara_rules_arr,
 						    yara_rules_arr_size,
 						    DOCA_APSH_YARA_SCAN_HEAP,
 						    &yara_matches,
 						    &yara_matches_size);
+			if (result != DOCA_SUCCESS) {
+				pid = doca_apsh_process_info_get(processes[i], DOCA_APSH_PROCESS_PID);
+				DOCA_LOG_ERR("Failed to scan process id %u: %s", pid, doca_error_get_descr(result));
+				yara_process_cache_forget(&process_cache, pid);
+				continue;
+			}
 
 			if (yara_matches_size != 0) {
-				for (i = 0; i < yara_matches_size; i++) {
-					pid = doca_apsh_yara_info_get(yara_matches[i], DOCA_APSH_YARA_PID);
-					str = doca_apsh_yara_info_get(yara_matches[i], DOCA_APSH_YARA_RULE);
+				for (j = 0; j < yara_matches_size; j++) {
+					pid = doca_apsh_yara_info_get(yara_matches[j], DOCA_APSH_YARA_PID);
+					str = doca_apsh_yara_info_get(yara_matches[j], DOCA_APSH_YARA_RULE);
 					DOCA_LOG_INFO("Got match for Yara rule %s in process id %d", str, pid);
 
 					if (!telemetry_enabled)
@@ -139,15 +178,15 @@ int main(int argc, char **argv)
 						DOCA_LOG_ERR("Failed to get timestamp, error code: %d", result);
 					yara_match_event.timestamp = timestamp;
 					yara_match_event.pid =
-						doca_apsh_yara_info_get(yara_matches[i], DOCA_APSH_YARA_PID);
+						doca_apsh_yara_info_get(yara_matches[j], DOCA_APSH_YARA_PID);
 					yara_match_event.vad =
-						doca_apsh_yara_info_get(yara_matches[i],
+						doca_apsh_yara_info_get(yara_matches[j],
 									DOCA_APSH_YARA_MATCH_WINDOW_ADDR);
-					str = doca_apsh_yara_info_get(yara_matches[i], DOCA_APSH_YARA_COMM);
+					str = doca_apsh_yara_info_get(yara_matches[j], DOCA_APSH_YARA_COMM);
 					if (strlcpy(yara_match_event.process_name, str, MAX_PROCESS_NAME_LEN) >=
 					    MAX_PROCESS_NAME_LEN)
 						yara_match_event.process_name[MAX_PROCESS_NAME_LEN - 2] = '+';
-					str = doca_apsh_yara_info_get(yara_matches[i], DOCA_APSH_YARA_RULE);
+					str = doca_apsh_yara_info_get(yara_matches[j], DOCA_APSH_YARA_RULE);
 					if (strlcpy(yara_match_event.yara_rule_name, str, MAX_PATH_LEN) >= MAX_PATH_LEN)
 						yara_match_event.yara_rule_name[MAX_PATH_LEN - 2] = '+';
 
@@ -164,7 +203,10 @@ int main(int argc, char **argv)
 			}
 		}
 		if (running) {
-			DOCA_LOG_INFO("No match for any Yara rule");
+			DOCA_LOG_INFO("No match for any Yara rule, scanned %d of %d processes%s",
+				      nb_scanned,
+				      num_processes,
+				      full_scan ? " (full scan)" : "");
 			sleep(yara_conf.time_interval);
 		}
 		doca_apsh_processes_free(processes);
@@ -174,9 +216,11 @@ int main(int argc, char **argv)
 	if (telemetry_enabled)
 		telemetry_destroy(telemetry_schema, telemetry_source);
 
+	yara_process_cache_destroy(&process_cache);
+
 	yara_inspection_cleanup(&resources);
 
 	doca_argp_destroy();
 
-	return DOCA_SUCCESS;
+	return exit_status;
 }
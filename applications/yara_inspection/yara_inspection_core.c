@@ -33,12 +33,17 @@
 #include <utils.h>
 
 #include "yara_inspection_core.h"
+#include "yara_inspection_dump.h"
+#include "yara_inspection_rules.h"
 
 DOCA_LOG_REGISTER(YARA_APP::Core);
 
 /* This value is guaranteed to be 253 on Linux, and 16 bytes on Windows */
 #define MAX_HOSTNAME_LEN 253
 
+#define MAX_REGION_SIZE_KB (1024 * 1024)	/* Maximal dump region size, 1GB */
+#define LAYOUT_HASH_PRIME 0x9E3779B185EBCA87ULL	/* Process layout hash multiplier */
+
 /*
  * ARGP Callback - Handle mem_regions.json path parameter
  *
@@ -144,11 +149,156 @@ static doca_error_t time_callback(void *param, void *config)
 	return DOCA_SUCCESS;
 }
 
+/*
+ * ARGP Callback - Handle rule file path parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t rules_callback(void *param, void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+	size_t size = sizeof(conf->rules_path);
+
+	if (strnlen(param, size) >= size) {
+		DOCA_LOG_ERR("Rule file path argument too long, must be <=%zu long", size - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->rules_path, param);
+
+	if (access(conf->rules_path, R_OK) == -1) {
+		DOCA_LOG_ERR("Rule file not found %s", conf->rules_path);
+		return DOCA_ERROR_NOT_FOUND;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle memory dump path parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t dump_callback(void *param, void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+	size_t size = sizeof(conf->dump_path);
+
+	if (strnlen(param, size) >= size) {
+		DOCA_LOG_ERR("Memory dump path argument too long, must be <=%zu long", size - 1);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->dump_path, param);
+
+	if (access(conf->dump_path, R_OK) == -1) {
+		DOCA_LOG_ERR("Memory dump not found %s", conf->dump_path);
+		return DOCA_ERROR_NOT_FOUND;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle number of passes parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t passes_callback(void *param, void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+	int passes = *(int *)param;
+
+	if (passes <= 0) {
+		DOCA_LOG_ERR("Number of passes must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->passes = passes;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle dump region size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t region_size_callback(void *param, void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+	int region_size = *(int *)param;
+
+	if (region_size <= 0 || region_size > MAX_REGION_SIZE_KB) {
+		DOCA_LOG_ERR("Region size must be between 1 and %d KB", MAX_REGION_SIZE_KB);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->region_size = region_size;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle full scan interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t full_scan_callback(void *param, void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+	int full_scan_interval = *(int *)param;
+
+	if (full_scan_interval <= 0) {
+		DOCA_LOG_ERR("Full scan interval must be positive");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->full_scan_interval = full_scan_interval;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP validation Callback - check that the parameters of the selected mode were given
+ *
+ * @config [in]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t args_validation_callback(void *config)
+{
+	struct yara_config *conf = (struct yara_config *)config;
+
+	/* Offline mode, scan memory dumps with the rule file */
+	if (conf->rules_path[0] != '\0') {
+		if (conf->dump_path[0] == '\0') {
+			DOCA_LOG_ERR("Rule file requires a memory dump to scan");
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		if (conf->time_interval < 0)
+			conf->time_interval = 0;
+		return DOCA_SUCCESS;
+	}
+
+	/* Live mode, APSH scans the host processes with its built-in rules */
+	if (conf->dump_path[0] != '\0') {
+		DOCA_LOG_ERR("Memory dump scan requires a rule file");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (conf->system_mem_region_path[0] == '\0' || conf->system_vuid[0] == '\0' || conf->dma_dev_name[0] == '\0' ||
+	    conf->system_os_symbol_map_path[0] == '\0' || conf->time_interval < 0) {
+		DOCA_LOG_ERR("Memory regions map, VUID, DMA device, OS symbol map and time interval are mandatory");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
 doca_error_t register_yara_params(void)
 {
 	doca_error_t result;
 	struct doca_argp_param *memr_param, *vuid_param, *dma_param, *os_syms_param;
-	struct doca_argp_param *time_param;
+	struct doca_argp_param *time_param, *rules_param, *dump_param, *passes_param, *region_size_param;
+	struct doca_argp_param *full_scan_param;
 
 	/* Create and register system memory map param */
 	result = doca_argp_param_create(&memr_param);
@@ -159,10 +309,9 @@ doca_error_t register_yara_params(void)
 	doca_argp_param_set_short_name(memr_param, "m");
 	doca_argp_param_set_long_name(memr_param, "memr");
 	doca_argp_param_set_arguments(memr_param, "<path>");
-	doca_argp_param_set_description(memr_param, "System memory regions map");
+	doca_argp_param_set_description(memr_param, "System memory regions map, live mode");
 	doca_argp_param_set_callback(memr_param, memr_callback);
 	doca_argp_param_set_type(memr_param, DOCA_ARGP_TYPE_STRING);
-	doca_argp_param_set_mandatory(memr_param);
 	result = doca_argp_register_param(memr_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
@@ -177,10 +326,9 @@ doca_error_t register_yara_params(void)
 	}
 	doca_argp_param_set_short_name(vuid_param, "f");
 	doca_argp_param_set_long_name(vuid_param, "vuid");
-	doca_argp_param_set_description(vuid_param, "VUID of the System device");
+	doca_argp_param_set_description(vuid_param, "VUID of the System device, live mode");
 	doca_argp_param_set_callback(vuid_param, vuid_callback);
 	doca_argp_param_set_type(vuid_param, DOCA_ARGP_TYPE_STRING);
-	doca_argp_param_set_mandatory(vuid_param);
 	result = doca_argp_register_param(vuid_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
@@ -195,10 +343,9 @@ doca_error_t register_yara_params(void)
 	}
 	doca_argp_param_set_short_name(dma_param, "d");
 	doca_argp_param_set_long_name(dma_param, "dma");
-	doca_argp_param_set_description(dma_param, "DMA device name");
+	doca_argp_param_set_description(dma_param, "DMA device name, live mode");
 	doca_argp_param_set_callback(dma_param, dma_callback);
 	doca_argp_param_set_type(dma_param, DOCA_ARGP_TYPE_STRING);
-	doca_argp_param_set_mandatory(dma_param);
 	result = doca_argp_register_param(dma_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
@@ -214,10 +361,9 @@ doca_error_t register_yara_params(void)
 	doca_argp_param_set_short_name(os_syms_param, "o");
 	doca_argp_param_set_long_name(os_syms_param, "osym");
 	doca_argp_param_set_arguments(os_syms_param, "<path>");
-	doca_argp_param_set_description(os_syms_param, "System OS symbol map path");
+	doca_argp_param_set_description(os_syms_param, "System OS symbol map path, live mode");
 	doca_argp_param_set_callback(os_syms_param, os_syms_callback);
 	doca_argp_param_set_type(os_syms_param, DOCA_ARGP_TYPE_STRING);
-	doca_argp_param_set_mandatory(os_syms_param);
 	result = doca_argp_register_param(os_syms_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
@@ -233,16 +379,118 @@ doca_error_t register_yara_params(void)
 	doca_argp_param_set_short_name(time_param, "t");
 	doca_argp_param_set_long_name(time_param, "time");
 	doca_argp_param_set_arguments(time_param, "<seconds>");
-	doca_argp_param_set_description(time_param, "Scan time interval in seconds");
+	doca_argp_param_set_description(
+		time_param,
+		"Scan time interval in seconds, between two passes in offline mode");
 	doca_argp_param_set_callback(time_param, time_callback);
 	doca_argp_param_set_type(time_param, DOCA_ARGP_TYPE_INT);
-	doca_argp_param_set_mandatory(time_param);
 	result = doca_argp_register_param(time_param);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
 		return result;
 	}
 
+	/* Create and register rule file param */
+	result = doca_argp_param_create(&rules_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(rules_param, "r");
+	doca_argp_param_set_long_name(rules_param, "rules");
+	doca_argp_param_set_arguments(rules_param, "<path>");
+	doca_argp_param_set_description(rules_param, "Rule file to scan memory dumps with, enables offline mode");
+	doca_argp_param_set_callback(rules_param, rules_callback);
+	doca_argp_param_set_type(rules_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(rules_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register memory dump param */
+	result = doca_argp_param_create(&dump_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(dump_param, "dump");
+	doca_argp_param_set_arguments(dump_param, "<path>");
+	doca_argp_param_set_description(
+		dump_param,
+		"Memory dump file, or directory of dump files, to scan in offline mode");
+	doca_argp_param_set_callback(dump_param, dump_callback);
+	doca_argp_param_set_type(dump_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(dump_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register number of passes param */
+	result = doca_argp_param_create(&passes_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(passes_param, "passes");
+	doca_argp_param_set_arguments(passes_param, "<num>");
+	doca_argp_param_set_description(
+		passes_param,
+		"Number of scan passes over the memory dumps in offline mode, default 1");
+	doca_argp_param_set_callback(passes_param, passes_callback);
+	doca_argp_param_set_type(passes_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(passes_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register region size param */
+	result = doca_argp_param_create(&region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(region_size_param, "region-size");
+	doca_argp_param_set_arguments(region_size_param, "<KB>");
+	doca_argp_param_set_description(
+		region_size_param,
+		"Memory dump region size in KB, only changed regions are rescanned in the next passes");
+	doca_argp_param_set_callback(region_size_param, region_size_callback);
+	doca_argp_param_set_type(region_size_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(region_size_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Create and register full scan interval param */
+	result = doca_argp_param_create(&full_scan_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_long_name(full_scan_param, "full-scan");
+	doca_argp_param_set_arguments(full_scan_param, "<iterations>");
+	doca_argp_param_set_description(
+		full_scan_param,
+		"Scan all processes every that many iterations (default 1). In the others, a process is skipped when "
+		"its memory layout is unchanged, even if the content of its memory changed");
+	doca_argp_param_set_callback(full_scan_param, full_scan_callback);
+	doca_argp_param_set_type(full_scan_param, DOCA_ARGP_TYPE_INT);
+	result = doca_argp_register_param(full_scan_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_argp_register_validation_callback(args_validation_callback);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register program validation callback: %s", doca_error_get_descr(result));
+		return result;
+	}
+
 	result = doca_argp_register_version_callback(sdk_version_callback);
 	if (result != DOCA_SUCCESS) {
 		DOCA_LOG_ERR("Failed to register version callback: %s", doca_error_get_descr(result));
@@ -562,3 +810,170 @@ void telemetry_destroy(struct doca_telemetry_exporter_schema *telemetry_schema,
 	doca_telemetry_exporter_source_destroy(telemetry_source);
 	doca_telemetry_exporter_schema_destroy(telemetry_schema);
 }
+
+doca_error_t yara_offline_run(struct yara_config *conf)
+{
+	struct yara_rule_set *rules;
+	struct yara_dump_scanner *scanner;
+	struct yara_dump_stats stats;
+	doca_error_t result;
+	int pass;
+
+	result = yara_rules_load(conf->rules_path, &rules);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to load rule file %s: %s", conf->rules_path, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = yara_dump_scanner_create(rules, conf->dump_path, conf->region_size * 1024, &scanner);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create dump scanner: %s", doca_error_get_descr(result));
+		yara_rules_destroy(rules);
+		return result;
+	}
+
+	for (pass = 0; pass < conf->passes; pass++) {
+		if (pass != 0)
+			sleep(conf->time_interval);
+
+		result = yara_dump_scanner_run(scanner, &stats);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to scan memory dumps: %s", doca_error_get_descr(result));
+			break;
+		}
+
+		/* Bytes per nanosecond are GB/s */
+		DOCA_LOG_INFO("Pass %d: %u rules, %u strings, %u states: %u matches in %u dumps of %lu bytes",
+			      pass,
+			      yara_rules_get_nb_rules(rules),
+			      yara_rules_get_nb_strings(rules),
+			      yara_rules_get_nb_states(rules),
+			      stats.nb_matches,
+			      stats.nb_files,
+			      stats.total_bytes);
+		DOCA_LOG_INFO("Pass %d: scanned %lu bytes at %.3f GB/s, pass throughput %.3f GB/s",
+			      pass,
+			      stats.scanned_bytes,
+			      stats.scan_ns != 0 ? (double)stats.scanned_bytes / stats.scan_ns : 0.0,
+			      stats.total_ns != 0 ? (double)stats.total_bytes / stats.total_ns : 0.0);
+	}
+
+	yara_dump_scanner_destroy(scanner);
+	yara_rules_destroy(rules);
+	return result;
+}
+
+void yara_process_cache_next_epoch(struct yara_process_cache *cache)
+{
+	uint32_t i, nb_kept = 0;
+
+	for (i = 0; i < cache->nb_entries; i++) {
+		if (cache->entries[i].epoch == cache->epoch)
+			cache->entries[nb_kept++] = cache->entries[i];
+	}
+	cache->nb_entries = nb_kept;
+	cache->epoch++;
+}
+
+/*
+ * Find a process in the process cache
+ *
+ * @cache [in]: Process cache
+ * @pid [in]: Process id
+ * @return: the process entry, NULL if the process is not in the cache
+ */
+static struct yara_process_entry *process_cache_find(struct yara_process_cache *cache,
+						     DOCA_APSH_PROCESS_PID_TYPE pid)
+{
+	uint32_t i;
+
+	for (i = 0; i < cache->nb_entries; i++) {
+		if (cache->entries[i].pid == pid)
+			return &cache->entries[i];
+	}
+	return NULL;
+}
+
+/*
+ * Hash the memory layout of a process
+ *
+ * @process [in]: Process
+ * @hash [out]: Hash of the start and end address of every VAD of the process
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t process_layout_hash(struct doca_apsh_process *process, uint64_t *hash)
+{
+	struct doca_apsh_vad **vads;
+	uint64_t start, end, value;
+	int num_vads, i;
+	doca_error_t result;
+
+	result = doca_apsh_vads_get(process, &vads, &num_vads);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	value = num_vads;
+	for (i = 0; i < num_vads; i++) {
+		start = doca_apsh_vad_info_get(vads[i], DOCA_APSH_VMA_VM_START);
+		end = doca_apsh_vad_info_get(vads[i], DOCA_APSH_VMA_VM_END);
+		value = (value ^ start) * LAYOUT_HASH_PRIME;
+		value = (value ^ end) * LAYOUT_HASH_PRIME;
+	}
+	doca_apsh_vads_free(vads);
+
+	*hash = value ^ (value >> 32);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t yara_process_cache_check(struct yara_process_cache *cache,
+				      struct doca_apsh_process *process,
+				      bool *changed)
+{
+	DOCA_APSH_PROCESS_PID_TYPE pid = doca_apsh_process_info_get(process, DOCA_APSH_PROCESS_PID);
+	struct yara_process_entry *entry, *entries;
+	uint64_t hash;
+	doca_error_t result;
+
+	result = process_layout_hash(process, &hash);
+	if (result != DOCA_SUCCESS) {
+		yara_process_cache_forget(cache, pid);
+		return result;
+	}
+
+	entry = process_cache_find(cache, pid);
+	if (entry == NULL) {
+		if (cache->nb_entries == cache->capacity) {
+			entries = realloc(cache->entries, MAX(2 * cache->capacity, 64) * sizeof(*entries));
+			if (entries == NULL) {
+				DOCA_LOG_ERR("Failed to allocate process cache entries");
+				return DOCA_ERROR_NO_MEMORY;
+			}
+			cache->entries = entries;
+			cache->capacity = MAX(2 * cache->capacity, 64);
+		}
+		entry = &cache->entries[cache->nb_entries++];
+		entry->pid = pid;
+		*changed = true;
+	} else
+		*changed = (entry->layout_hash != hash);
+
+	entry->layout_hash = hash;
+	entry->epoch = cache->epoch;
+	return DOCA_SUCCESS;
+}
+
+void yara_process_cache_forget(struct yara_process_cache *cache, DOCA_APSH_PROCESS_PID_TYPE pid)
+{
+	struct yara_process_entry *entry = process_cache_find(cache, pid);
+
+	if (entry != NULL)
+		*entry = cache->entries[--cache->nb_entries];
+}
+
+void yara_process_cache_destroy(struct yara_process_cache *cache)
+{
+	free(cache->entries);
+	cache->entries = NULL;
+	cache->nb_entries = 0;
+	cache->capacity = 0;
+}
@@ -26,6 +26,9 @@
 #ifndef YARA_INSPECTION_CORE_H_
 #define YARA_INSPECTION_CORE_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include <doca_apsh.h>
 #include <doca_apsh_attr.h>
 #include <doca_dev.h>
@@ -44,6 +47,8 @@ extern "C" {
  */
 #define MAX_PATH_LEN 260
 #define MAX_PROCESS_NAME_LEN 1000
+#define DEFAULT_REGION_SIZE_KB 64     /* Default size of a dump region in offline mode */
+#define DEFAULT_FULL_SCAN_INTERVAL 1  /* Default number of iterations between two scans of all processes */
 
 struct yara_config {
 	DOCA_APSH_PROCESS_PID_TYPE pid;			     /* Pid of process to validate integrity of */
@@ -55,6 +60,26 @@ struct yara_config {
 	char dma_dev_name[DOCA_DEVINFO_IBDEV_NAME_SIZE + 1]; /* DMA device name */
 	char system_os_symbol_map_path[MAX_PATH_LEN];	     /* Path to APSH's os_symbols.json file */
 	int time_interval;				     /* Seconds to sleep between two integrity checks */
+	char rules_path[MAX_PATH_LEN];			     /* Path to a rule file, enables offline mode */
+	char dump_path[MAX_PATH_LEN];			     /* Memory dump file or directory, offline mode */
+	int passes;					     /* Number of scan passes over the dumps, offline mode */
+	int region_size;				     /* Dump region size in KB, offline mode */
+	int full_scan_interval;				     /* Iterations between two scans of all processes */
+};
+
+/* Process scanned in a previous iteration */
+struct yara_process_entry {
+	DOCA_APSH_PROCESS_PID_TYPE pid;	/* Process id */
+	uint64_t layout_hash;		/* Hash of the process memory layout when it was last scanned */
+	uint64_t epoch;			/* Last iteration in which the process was listed */
+};
+
+/* Processes scanned in previous iterations, to skip the processes whose memory layout did not change */
+struct yara_process_cache {
+	struct yara_process_entry *entries; /* Known processes */
+	uint32_t nb_entries;		    /* Number of known processes */
+	uint32_t capacity;		    /* Allocated number of entries */
+	uint64_t epoch;			    /* Current iteration */
 };
 
 struct yara_resources {
@@ -122,6 +147,51 @@ doca_error_t telemetry_start(struct doca_telemetry_exporter_schema **telemetry_s
 void telemetry_destroy(struct doca_telemetry_exporter_schema *telemetry_schema,
 		       struct doca_telemetry_exporter_source *telemetry_source);
 
+/*
+ * Run the offline mode: scan the memory dumps with the rule file, and report the scan throughput
+ *
+ * @conf [in]: Configuration values
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t yara_offline_run(struct yara_config *conf);
+
+/*
+ * Start a new iteration of the process cache, processes not listed since the previous iteration are forgotten
+ *
+ * @cache [in]: Process cache
+ */
+void yara_process_cache_next_epoch(struct yara_process_cache *cache);
+
+/*
+ * Check if the memory layout of a process changed since it was last scanned, and record its current layout.
+ * The layout is the list of the process VADs (start and end address of each memory region). APSH scans the
+ * process memory on the DPU, so the region content is not available here and a new or resized region is used as
+ * the sign that the process must be scanned again.
+ *
+ * @cache [in]: Process cache
+ * @process [in]: Process to check
+ * @changed [out]: True if the process is new or its memory layout changed
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t yara_process_cache_check(struct yara_process_cache *cache,
+				      struct doca_apsh_process *process,
+				      bool *changed);
+
+/*
+ * Forget a process, so it is scanned again in the next iteration
+ *
+ * @cache [in]: Process cache
+ * @pid [in]: Process id
+ */
+void yara_process_cache_forget(struct yara_process_cache *cache, DOCA_APSH_PROCESS_PID_TYPE pid);
+
+/*
+ * Free the process cache entries
+ *
+ * @cache [in]: Process cache
+ */
+void yara_process_cache_destroy(struct yara_process_cache *cache);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <doca_log.h>
+
+#include <utils.h>
+
+#include "yara_inspection_dump.h"
+
+DOCA_LOG_REGISTER(YARA_APP::Dump);
+
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL /* Region hash multiplier */
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL /* Region hash multiplier */
+
+/* A region of a dump file */
+struct dump_region {
+	bool valid;	      /* Region was scanned in a previous pass */
+	uint64_t hash;	      /* Hash of the region content when it was scanned */
+	uint32_t nb_strings;  /* Number of strings with a match ending in the region */
+	uint32_t *string_ids; /* Strings with a match ending in the region */
+};
+
+/* A memory dump file */
+struct dump_file {
+	char path[PATH_MAX];	     /* File path */
+	uint64_t size;		     /* File size at the last pass */
+	uint64_t nb_regions;	     /* Number of regions */
+	struct dump_region *regions; /* Regions of the file */
+};
+
+struct yara_dump_scanner {
+	const struct yara_rule_set *rules; /* Compiled rule set */
+	struct dump_file *files;	   /* Dump files */
+	uint32_t nb_files;		   /* Number of dump files */
+	uint32_t region_size;		   /* Region size */
+	uint32_t overlap;		   /* Bytes of the previous region scanned with a region */
+	uint8_t *buf;			   /* Read buffer, overlap bytes followed by a region */
+	uint8_t *string_hits;		   /* Per string, non zero if the string matched the current file */
+	uint64_t *string_stamp;		   /* Per string, stamp of the last region the string was collected for */
+	uint64_t stamp;			   /* Stamp of the region being scanned */
+	uint32_t *found_ids;		   /* Strings collected for the region being scanned */
+	uint32_t nb_found;		   /* Number of strings collected */
+};
+
+/*
+ * Get the current time in nanoseconds
+ *
+ * @return: monotonic time in nanoseconds
+ */
+static uint64_t get_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 * 1000 * 1000 + ts.tv_nsec;
+}
+
+/*
+ * Rotate a 64 bit value left
+ *
+ * @value [in]: value to rotate
+ * @bits [in]: number of bits to rotate by
+ * @return: rotated value
+ */
+static inline uint64_t rotl64(uint64_t value, uint32_t bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+/*
+ * Hash a region, in four independent 64 bit lanes so it runs much faster than the automaton.
+ * The hash only detects changes between passes, it is not meant to resist forged collisions.
+ *
+ * @data [in]: region data
+ * @len [in]: region length
+ * @return: region hash
+ */
+static uint64_t region_hash(const uint8_t *data, size_t len)
+{
+	uint64_t lanes[4] = {HASH_PRIME_1, HASH_PRIME_2, ~HASH_PRIME_1, ~HASH_PRIME_2};
+	uint64_t word, hash;
+	size_t i, lane;
+
+	for (i = 0; i + 32 <= len; i += 32) {
+		for (lane = 0; lane < 4; lane++) {
+			memcpy(&word, data + i + 8 * lane, sizeof(word));
+			lanes[lane] = rotl64(lanes[lane] + word * HASH_PRIME_2, 31) * HASH_PRIME_1;
+		}
+	}
+
+	hash = len * HASH_PRIME_1;
+	hash += rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+	for (; i < len; i++)
+		hash = (hash ^ data[i]) * HASH_PRIME_1;
+
+	hash ^= hash >> 33;
+	hash *= HASH_PRIME_2;
+	hash ^= hash >> 29;
+	return hash;
+}
+
+/*
+ * Automaton match callback, collects every string once per region
+ *
+ * @user_data [in]: dump scanner
+ * @string_id [in]: matched string
+ */
+static void collect_string(void *user_data, uint32_t string_id)
+{
+	struct yara_dump_scanner *scanner = (struct yara_dump_scanner *)user_data;
+
+	if (scanner->string_stamp[string_id] == scanner->stamp)
+		return;
+	scanner->string_stamp[string_id] = scanner->stamp;
+	scanner->found_ids[scanner->nb_found++] = string_id;
+}
+
+/*
+ * Add a dump file to the scanner
+ *
+ * @scanner [in]: dump scanner
+ * @path [in]: file path
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t add_dump_file(struct yara_dump_scanner *scanner, const char *path)
+{
+	struct dump_file *files;
+
+	if (strnlen(path, PATH_MAX) == PATH_MAX) {
+		DOCA_LOG_ERR("Dump file path too long: %s", path);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	files = realloc(scanner->files, (scanner->nb_files + 1) * sizeof(*files));
+	if (files == NULL) {
+		DOCA_LOG_ERR("Failed to allocate dump files");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	scanner->files = files;
+	memset(&files[scanner->nb_files], 0, sizeof(*files));
+	strlcpy(files[scanner->nb_files].path, path, PATH_MAX);
+	scanner->nb_files++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Add the dump files of a path, a single file or the regular files of a directory in name order
+ *
+ * @scanner [in]: dump scanner
+ * @dump_path [in]: dump file or directory
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t add_dump_files(struct yara_dump_scanner *scanner, const char *dump_path)
+{
+	char path[PATH_MAX];
+	struct dirent **entries;
+	struct stat st;
+	doca_error_t result = DOCA_SUCCESS;
+	int nb_entries, i;
+
+	if (stat(dump_path, &st) != 0) {
+		DOCA_LOG_ERR("Failed to access %s: %s", dump_path, strerror(errno));
+		return DOCA_ERROR_IO_FAILED;
+	}
+	if (!S_ISDIR(st.st_mode))
+		return add_dump_file(scanner, dump_path);
+
+	nb_entries = scandir(dump_path, &entries, NULL, alphasort);
+	if (nb_entries < 0) {
+		DOCA_LOG_ERR("Failed to list %s: %s", dump_path, strerror(errno));
+		return DOCA_ERROR_IO_FAILED;
+	}
+	for (i = 0; i < nb_entries; i++) {
+		if (result == DOCA_SUCCESS &&
+		    (size_t)snprintf(path, sizeof(path), "%s/%s", dump_path, entries[i]->d_name) < sizeof(path) &&
+		    stat(path, &st) == 0 && S_ISREG(st.st_mode))
+			result = add_dump_file(scanner, path);
+		free(entries[i]);
+	}
+	free(entries);
+
+	if (result == DOCA_SUCCESS && scanner->nb_files == 0) {
+		DOCA_LOG_ERR("No dump files found in %s", dump_path);
+		result = DOCA_ERROR_NOT_FOUND;
+	}
+	return result;
+}
+
+doca_error_t yara_dump_scanner_create(const struct yara_rule_set *rules,
+				      const char *dump_path,
+				      uint32_t region_size,
+				      struct yara_dump_scanner **scanner)
+{
+	struct yara_dump_scanner *new_scanner;
+	uint32_t nb_strings = yara_rules_get_nb_strings(rules);
+	doca_error_t result;
+
+	/* A match may only span the end of the previous region, the dirty tracking relies on it */
+	if (region_size < yara_rules_get_max_pattern_len(rules)) {
+		DOCA_LOG_ERR("Region size of %u bytes is shorter than the longest rule string of %u bytes",
+			     region_size,
+			     yara_rules_get_max_pattern_len(rules));
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	new_scanner = calloc(1, sizeof(*new_scanner));
+	if (new_scanner == NULL) {
+		DOCA_LOG_ERR("Failed to allocate dump scanner");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	new_scanner->rules = rules;
+	new_scanner->region_size = region_size;
+	new_scanner->overlap = yara_rules_get_max_pattern_len(rules) - 1;
+
+	new_scanner->buf = malloc((size_t)new_scanner->overlap + region_size);
+	new_scanner->string_hits = calloc(nb_strings, sizeof(*new_scanner->string_hits));
+	new_scanner->string_stamp = calloc(nb_strings, sizeof(*new_scanner->string_stamp));
+	new_scanner->found_ids = malloc(nb_strings * sizeof(*new_scanner->found_ids));
+	if (new_scanner->buf == NULL || new_scanner->string_hits == NULL || new_scanner->string_stamp == NULL ||
+	    new_scanner->found_ids == NULL) {
+		DOCA_LOG_ERR("Failed to allocate dump scanner buffers");
+		yara_dump_scanner_destroy(new_scanner);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = add_dump_files(new_scanner, dump_path);
+	if (result != DOCA_SUCCESS) {
+		yara_dump_scanner_destroy(new_scanner);
+		return result;
+	}
+
+	*scanner = new_scanner;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Release the regions of a dump file
+ *
+ * @file [in]: dump file
+ */
+static void free_dump_regions(struct dump_file *file)
+{
+	uint64_t r;
+
+	for (r = 0; r < file->nb_regions; r++)
+		free(file->regions[r].string_ids);
+	free(file->regions);
+	file->regions = NULL;
+	file->nb_regions = 0;
+}
+
+/*
+ * Read a region of a dump file
+ *
+ * @fd [in]: file descriptor
+ * @buffer [out]: buffer to read the region into
+ * @len [in]: region length
+ * @offset [in]: region offset in the file
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t read_region(int fd, uint8_t *buffer, uint32_t len, uint64_t offset)
+{
+	ssize_t nb_read;
+	uint32_t done = 0;
+
+	while (done < len) {
+		nb_read = pread(fd, buffer + done, len - done, offset + done);
+		if (nb_read < 0 && errno == EINTR)
+			continue;
+		if (nb_read <= 0)
+			return DOCA_ERROR_IO_FAILED;
+		done += nb_read;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Scan a dump file, reusing the results of the regions that did not change since the previous pass
+ *
+ * @scanner [in]: dump scanner
+ * @file [in]: dump file
+ * @stats [in/out]: pass statistics
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t scan_dump_file(struct yara_dump_scanner *scanner,
+				   struct dump_file *file,
+				   struct yara_dump_stats *stats)
+{
+	uint8_t *region_data = scanner->buf + scanner->overlap;
+	struct dump_region *region;
+	bool changed, prev_changed = false;
+	uint32_t len, tail_len = 0, keep, i;
+	uint64_t r, offset, hash, start;
+	struct stat st;
+	int fd;
+	doca_error_t result = DOCA_SUCCESS;
+
+	fd = open(file->path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		DOCA_LOG_ERR("Failed to open dump file %s: %s", file->path, strerror(errno));
+		if (fd >= 0)
+			close(fd);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* A file whose size changed is scanned from scratch */
+	if ((uint64_t)st.st_size != file->size || file->regions == NULL) {
+		free_dump_regions(file);
+		file->size = st.st_size;
+		file->nb_regions = (file->size + scanner->region_size - 1) / scanner->region_size;
+		file->regions = calloc(MAX(file->nb_regions, 1), sizeof(*file->regions));
+		if (file->regions == NULL) {
+			DOCA_LOG_ERR("Failed to allocate regions of dump file %s", file->path);
+			close(fd);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+	}
+
+	for (r = 0; r < file->nb_regions; r++) {
+		region = &file->regions[r];
+		offset = r * scanner->region_size;
+		len = MIN(scanner->region_size, file->size - offset);
+
+		result = read_region(fd, region_data, len, offset);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to read %u bytes at offset %lu of dump file %s", len, offset, file->path);
+			break;
+		}
+
+		hash = region_hash(region_data, len);
+		changed = !region->valid || region->hash != hash;
+		if (changed || prev_changed) {
+			/* Matches ending in the region may start in the tail of the previous one */
+			scanner->stamp++;
+			scanner->nb_found = 0;
+			start = get_time_ns();
+			(void)yara_rules_scan(scanner->rules,
+					      region_data - tail_len,
+					      tail_len + len,
+					      0,
+					      tail_len,
+					      collect_string,
+					      scanner);
+			stats->scan_ns += get_time_ns() - start;
+			stats->scanned_bytes += len;
+
+			free(region->string_ids);
+			region->string_ids = NULL;
+			region->nb_strings = scanner->nb_found;
+			if (scanner->nb_found != 0) {
+				region->string_ids = malloc(scanner->nb_found * sizeof(*region->string_ids));
+				if (region->string_ids == NULL) {
+					DOCA_LOG_ERR("Failed to allocate region matches");
+					region->valid = false;
+					result = DOCA_ERROR_NO_MEMORY;
+					break;
+				}
+				memcpy(region->string_ids,
+				       scanner->found_ids,
+				       scanner->nb_found * sizeof(*region->string_ids));
+			}
+		}
+		region->hash = hash;
+		region->valid = true;
+		prev_changed = changed;
+
+		for (i = 0; i < region->nb_strings; i++)
+			scanner->string_hits[region->string_ids[i]] = 1;
+
+		/* Keep the last bytes for the next region */
+		keep = MIN(scanner->overlap, tail_len + len);
+		memmove(region_data - keep, region_data + len - keep, keep);
+		tail_len = keep;
+	}
+
+	stats->total_bytes += file->size;
+	close(fd);
+	return result;
+}
+
+doca_error_t yara_dump_scanner_run(struct yara_dump_scanner *scanner, struct yara_dump_stats *stats)
+{
+	uint32_t nb_strings = yara_rules_get_nb_strings(scanner->rules);
+	uint32_t nb_rules = yara_rules_get_nb_rules(scanner->rules);
+	uint64_t start = get_time_ns();
+	uint32_t f, rule_id;
+	doca_error_t result;
+
+	memset(stats, 0, sizeof(*stats));
+	for (f = 0; f < scanner->nb_files; f++) {
+		memset(scanner->string_hits, 0, nb_strings * sizeof(*scanner->string_hits));
+		result = scan_dump_file(scanner, &scanner->files[f], stats);
+		if (result != DOCA_SUCCESS) {
+			/* Rescan the whole file on the next pass */
+			free_dump_regions(&scanner->files[f]);
+			return result;
+		}
+		stats->nb_files++;
+
+		for (rule_id = 0; rule_id < nb_rules; rule_id++) {
+			if (!yara_rules_eval(scanner->rules, rule_id, scanner->string_hits))
+				continue;
+			DOCA_LOG_INFO("Got match for Yara rule %s in dump %s",
+				      yara_rules_get_name(scanner->rules, rule_id),
+				      scanner->files[f].path);
+			stats->nb_matches++;
+		}
+	}
+	stats->total_ns = get_time_ns() - start;
+
+	return DOCA_SUCCESS;
+}
+
+void yara_dump_scanner_destroy(struct yara_dump_scanner *scanner)
+{
+	uint32_t f;
+
+	for (f = 0; f < scanner->nb_files; f++)
+		free_dump_regions(&scanner->files[f]);
+	free(scanner->files);
+	free(scanner->found_ids);
+	free(scanner->string_stamp);
+	free(scanner->string_hits);
+	free(scanner->buf);
+	free(scanner);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef YARA_INSPECTION_DUMP_H_
+#define YARA_INSPECTION_DUMP_H_
+
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#include "yara_inspection_rules.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Offline scan of memory dumps:
+ *	Each dump file is split to regions of region_size bytes. A region is rescanned only if its hash changed since
+ *	the previous pass, or if the region before it changed (a match may start in the previous region). The string
+ *	matches of the other regions are reused from the previous pass, so the results of a pass are always complete.
+ */
+
+/* Scanner of a set of memory dump files */
+struct yara_dump_scanner;
+
+/* Statistics of a scan pass */
+struct yara_dump_stats {
+	uint32_t nb_files;	/* Number of dump files scanned */
+	uint32_t nb_matches;	/* Number of (rule, dump file) matches */
+	uint64_t total_bytes;	/* Size of all dump files */
+	uint64_t scanned_bytes;	/* Bytes run through the automaton */
+	uint64_t total_ns;	/* Duration of the pass, including file reads and hashing */
+	uint64_t scan_ns;	/* Time spent in the automaton */
+};
+
+/*
+ * Create a dump scanner
+ *
+ * @rules [in]: compiled rule set
+ * @dump_path [in]: memory dump file, or directory whose regular files are memory dumps
+ * @region_size [in]: region size in bytes, at least the longest pattern of the rule set
+ * @scanner [out]: the created scanner
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t yara_dump_scanner_create(const struct yara_rule_set *rules,
+				      const char *dump_path,
+				      uint32_t region_size,
+				      struct yara_dump_scanner **scanner);
+
+/*
+ * Scan all dump files once, logging the rules that matched each file
+ *
+ * @scanner [in]: dump scanner
+ * @stats [out]: statistics of the pass
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t yara_dump_scanner_run(struct yara_dump_scanner *scanner, struct yara_dump_stats *stats);
+
+/*
+ * Destroy a dump scanner
+ *
+ * @scanner [in]: dump scanner to destroy
+ */
+void yara_dump_scanner_destroy(struct yara_dump_scanner *scanner);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* YARA_INSPECTION_DUMP_H_ */
@@ -0,0 +1,925 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_log.h>
+
+#include <utils.h>
+
+#include "yara_inspection_rules.h"
+
+DOCA_LOG_REGISTER(YARA_APP::Rules);
+
+#define NO_STRING UINT32_MAX /* Rule condition does not reference a single string */
+#define ALPHABET_SIZE 256    /* Automaton transitions per state */
+#define MAX_TOKEN_LEN 64     /* Maximal length of a keyword or identifier token */
+
+struct yara_rule {
+	char name[YARA_MAX_RULE_NAME_LEN]; /* Rule name */
+	uint32_t first_string;		   /* Index of the first string of the rule */
+	uint32_t nb_strings;		   /* Number of strings of the rule */
+	uint32_t threshold;		   /* Number of strings that must match */
+	uint32_t single_string;		   /* String the condition references, NO_STRING for "of them" conditions */
+};
+
+struct yara_rule_set {
+	struct yara_rule *rules;  /* Rules */
+	uint32_t nb_rules;	  /* Number of rules */
+	uint32_t nb_strings;	  /* Number of strings of all rules */
+	uint32_t max_pattern_len; /* Longest pattern length */
+
+	/* Aho-Corasick automaton, missing transitions are resolved at build time so scanning never follows a failure */
+	uint32_t nb_states;   /* Number of states, state 0 is the root */
+	uint32_t *next;	      /* Transition table, ALPHABET_SIZE entries per state */
+	uint8_t *is_match;    /* Per state, non zero if a pattern ends at the state or at one of its suffixes */
+	uint32_t *dict_link;  /* Per state, longest proper suffix state where a pattern ends, 0 if none */
+	uint32_t *out_first;  /* Per state, index in out_ids of the strings ending at the state */
+	uint32_t *out_count;  /* Per state, number of strings ending at the state */
+	uint32_t *out_ids;    /* String ids of all patterns, grouped by end state */
+};
+
+/* A byte pattern of a rule string */
+struct rule_pattern {
+	uint8_t *data;	    /* Pattern bytes */
+	uint32_t len;	    /* Pattern length */
+	uint32_t string_id; /* String the pattern belongs to */
+};
+
+/* Rule file parser */
+struct rule_parser {
+	const char *path;		  /* Rule file path, for error messages */
+	const char *buf;		  /* Rule file content */
+	size_t len;			  /* Rule file length */
+	size_t pos;			  /* Current position */
+	uint32_t line;			  /* Current line, for error messages */
+	struct yara_rule_set *rules;	  /* Rule set under construction */
+	uint32_t rules_cap;		  /* Allocated number of rules */
+	struct rule_pattern *patterns;	  /* Patterns of all strings */
+	uint32_t nb_patterns;		  /* Number of patterns */
+	uint32_t patterns_cap;		  /* Allocated number of patterns */
+	char (*names)[MAX_TOKEN_LEN];	  /* Names of the strings of the current rule */
+	uint32_t names_cap;		  /* Allocated number of names */
+	uint8_t value[YARA_MAX_STRING_LEN]; /* Decoded value of the current string */
+	uint32_t value_len;		  /* Length of the decoded value */
+};
+
+/*
+ * Skip white spaces and comments
+ *
+ * @parser [in]: rule parser
+ */
+static void skip_blanks(struct rule_parser *parser)
+{
+	while (parser->pos < parser->len) {
+		char c = parser->buf[parser->pos];
+
+		if (c == '\n') {
+			parser->line++;
+			parser->pos++;
+		} else if (isspace((unsigned char)c)) {
+			parser->pos++;
+		} else if (c == '/' && parser->pos + 1 < parser->len && parser->buf[parser->pos + 1] == '/') {
+			while (parser->pos < parser->len && parser->buf[parser->pos] != '\n')
+				parser->pos++;
+		} else if (c == '/' && parser->pos + 1 < parser->len && parser->buf[parser->pos + 1] == '*') {
+			parser->pos += 2;
+			while (parser->pos + 1 < parser->len &&
+			       !(parser->buf[parser->pos] == '*' && parser->buf[parser->pos + 1] == '/')) {
+				if (parser->buf[parser->pos] == '\n')
+					parser->line++;
+				parser->pos++;
+			}
+			parser->pos = MIN(parser->pos + 2, parser->len);
+		} else {
+			break;
+		}
+	}
+}
+
+/*
+ * Read a word token: an identifier, a keyword, a number or a $string identifier
+ *
+ * @parser [in]: rule parser
+ * @word [out]: the word, empty if the next token is not a word
+ * @return: true if a word was read
+ */
+static bool read_word(struct rule_parser *parser, char word[MAX_TOKEN_LEN])
+{
+	size_t word_len = 0;
+	char c;
+
+	skip_blanks(parser);
+	while (parser->pos < parser->len) {
+		c = parser->buf[parser->pos];
+		if (!isalnum((unsigned char)c) && c != '_' && !(c == '$' && word_len == 0))
+			break;
+		if (word_len == MAX_TOKEN_LEN - 1)
+			break;
+		word[word_len++] = c;
+		parser->pos++;
+	}
+	word[word_len] = '\0';
+
+	return word_len != 0;
+}
+
+/*
+ * Peek at the next word token without consuming it
+ *
+ * @parser [in]: rule parser
+ * @word [out]: the word, empty if the next token is not a word
+ * @return: true if the next token is a word
+ */
+static bool peek_word(struct rule_parser *parser, char word[MAX_TOKEN_LEN])
+{
+	size_t pos = parser->pos;
+	uint32_t line = parser->line;
+	bool found = read_word(parser, word);
+
+	parser->pos = pos;
+	parser->line = line;
+	return found;
+}
+
+/*
+ * Consume an expected punctuation character
+ *
+ * @parser [in]: rule parser
+ * @punct [in]: expected character
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t expect_punct(struct rule_parser *parser, char punct)
+{
+	skip_blanks(parser);
+	if (parser->pos >= parser->len || parser->buf[parser->pos] != punct) {
+		DOCA_LOG_ERR("Rule file %s:%u: expected '%c'", parser->path, parser->line, punct);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	parser->pos++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Consume an expected keyword
+ *
+ * @parser [in]: rule parser
+ * @keyword [in]: expected keyword
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t expect_word(struct rule_parser *parser, const char *keyword)
+{
+	char word[MAX_TOKEN_LEN];
+
+	if (!read_word(parser, word) || strcmp(word, keyword) != 0) {
+		DOCA_LOG_ERR("Rule file %s:%u: expected '%s'", parser->path, parser->line, keyword);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Get the value of a hex digit
+ *
+ * @c [in]: character
+ * @return: digit value, or -1 if c is not a hex digit
+ */
+static int hex_value(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/*
+ * Append a byte to the value of the current string
+ *
+ * @parser [in]: rule parser
+ * @byte [in]: byte to append
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t append_value(struct rule_parser *parser, uint8_t byte)
+{
+	if (parser->value_len == YARA_MAX_STRING_LEN) {
+		DOCA_LOG_ERR("Rule file %s:%u: string longer than %d bytes",
+			     parser->path,
+			     parser->line,
+			     YARA_MAX_STRING_LEN);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	parser->value[parser->value_len++] = byte;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse a quoted text string into the current value, handling the \\ \" \n \r \t and \xHH escapes
+ *
+ * @parser [in]: rule parser, positioned on the opening quote
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_text_string(struct rule_parser *parser)
+{
+	doca_error_t result;
+	int high, low;
+	char c;
+
+	parser->value_len = 0;
+	parser->pos++;
+	while (parser->pos < parser->len && parser->buf[parser->pos] != '"') {
+		c = parser->buf[parser->pos++];
+		if (c == '\n')
+			break;
+		if (c == '\\' && parser->pos < parser->len) {
+			c = parser->buf[parser->pos++];
+			switch (c) {
+			case 'n':
+				c = '\n';
+				break;
+			case 'r':
+				c = '\r';
+				break;
+			case 't':
+				c = '\t';
+				break;
+			case '\\':
+			case '"':
+				break;
+			case 'x':
+				high = parser->pos < parser->len ? hex_value(parser->buf[parser->pos]) : -1;
+				low = parser->pos + 1 < parser->len ? hex_value(parser->buf[parser->pos + 1]) : -1;
+				if (high < 0 || low < 0) {
+					DOCA_LOG_ERR("Rule file %s:%u: bad \\x escape", parser->path, parser->line);
+					return DOCA_ERROR_INVALID_VALUE;
+				}
+				parser->pos += 2;
+				c = (char)(high << 4 | low);
+				break;
+			default:
+				DOCA_LOG_ERR("Rule file %s:%u: unsupported escape \\%c", parser->path, parser->line, c);
+				return DOCA_ERROR_INVALID_VALUE;
+			}
+		}
+		result = append_value(parser, (uint8_t)c);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	if (parser->pos >= parser->len || parser->buf[parser->pos] != '"') {
+		DOCA_LOG_ERR("Rule file %s:%u: unterminated string", parser->path, parser->line);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	parser->pos++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse a hex string into the current value
+ *
+ * @parser [in]: rule parser, positioned on the opening brace
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_hex_string(struct rule_parser *parser)
+{
+	doca_error_t result;
+	int high, low;
+
+	parser->value_len = 0;
+	parser->pos++;
+	for (;;) {
+		skip_blanks(parser);
+		if (parser->pos >= parser->len) {
+			DOCA_LOG_ERR("Rule file %s:%u: unterminated hex string", parser->path, parser->line);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		if (parser->buf[parser->pos] == '}') {
+			parser->pos++;
+			return DOCA_SUCCESS;
+		}
+
+		high = hex_value(parser->buf[parser->pos]);
+		low = parser->pos + 1 < parser->len ? hex_value(parser->buf[parser->pos + 1]) : -1;
+		if (high < 0 || low < 0) {
+			DOCA_LOG_ERR("Rule file %s:%u: only plain hex bytes are supported in hex strings, no wildcards, jumps or alternatives",
+				     parser->path,
+				     parser->line);
+			return DOCA_ERROR_NOT_SUPPORTED;
+		}
+		parser->pos += 2;
+		result = append_value(parser, (uint8_t)(high << 4 | low));
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+}
+
+/*
+ * Add a pattern of the current string
+ *
+ * @parser [in]: rule parser
+ * @wide [in]: true to add the UTF-16LE form of the value
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t add_pattern(struct rule_parser *parser, bool wide)
+{
+	struct rule_pattern *pattern, *patterns;
+	uint32_t len = wide ? 2 * parser->value_len : parser->value_len;
+	uint32_t i;
+
+	if (parser->value_len == 0 || len > YARA_MAX_STRING_LEN) {
+		DOCA_LOG_ERR("Rule file %s:%u: string length must be between 1 and %d bytes",
+			     parser->path,
+			     parser->line,
+			     YARA_MAX_STRING_LEN);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (parser->nb_patterns == parser->patterns_cap) {
+		parser->patterns_cap = MAX(2 * parser->patterns_cap, 64);
+		patterns = realloc(parser->patterns, parser->patterns_cap * sizeof(*patterns));
+		if (patterns == NULL) {
+			DOCA_LOG_ERR("Failed to allocate rule patterns");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		parser->patterns = patterns;
+	}
+
+	pattern = &parser->patterns[parser->nb_patterns];
+	pattern->data = malloc(len);
+	if (pattern->data == NULL) {
+		DOCA_LOG_ERR("Failed to allocate rule pattern");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	for (i = 0; i < parser->value_len; i++) {
+		if (wide) {
+			pattern->data[2 * i] = parser->value[i];
+			pattern->data[2 * i + 1] = 0;
+		} else {
+			pattern->data[i] = parser->value[i];
+		}
+	}
+	pattern->len = len;
+	pattern->string_id = parser->rules->nb_strings;
+	parser->rules->max_pattern_len = MAX(parser->rules->max_pattern_len, len);
+	parser->nb_patterns++;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse the strings section of a rule
+ *
+ * @parser [in]: rule parser
+ * @rule [in/out]: rule being parsed
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_strings(struct rule_parser *parser, struct yara_rule *rule)
+{
+	char name[MAX_TOKEN_LEN], word[MAX_TOKEN_LEN], (*names)[MAX_TOKEN_LEN];
+	bool ascii, wide, is_text;
+	doca_error_t result;
+
+	while (peek_word(parser, name) && name[0] == '$') {
+		read_word(parser, name);
+		result = expect_punct(parser, '=');
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		skip_blanks(parser);
+		is_text = parser->pos < parser->len && parser->buf[parser->pos] == '"';
+		if (is_text) {
+			result = parse_text_string(parser);
+		} else if (parser->pos < parser->len && parser->buf[parser->pos] == '{') {
+			result = parse_hex_string(parser);
+		} else {
+			DOCA_LOG_ERR("Rule file %s:%u: only text and hex strings are supported, no regular expressions",
+				     parser->path,
+				     parser->line);
+			result = DOCA_ERROR_NOT_SUPPORTED;
+		}
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		ascii = false;
+		wide = false;
+		while (is_text && peek_word(parser, word) && strcmp(word, "condition") != 0 && word[0] != '$') {
+			read_word(parser, word);
+			if (strcmp(word, "ascii") == 0) {
+				ascii = true;
+			} else if (strcmp(word, "wide") == 0) {
+				wide = true;
+			} else {
+				DOCA_LOG_ERR("Rule file %s:%u: unsupported string modifier %s",
+					     parser->path,
+					     parser->line,
+					     word);
+				return DOCA_ERROR_NOT_SUPPORTED;
+			}
+		}
+
+		if (ascii || !wide) {
+			result = add_pattern(parser, false);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+		if (wide) {
+			result = add_pattern(parser, true);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+
+		/* Keep the name to resolve single string conditions */
+		if (rule->nb_strings == parser->names_cap) {
+			parser->names_cap = MAX(2 * parser->names_cap, 16);
+			names = realloc(parser->names, parser->names_cap * sizeof(*names));
+			if (names == NULL) {
+				DOCA_LOG_ERR("Failed to allocate rule string names");
+				return DOCA_ERROR_NO_MEMORY;
+			}
+			parser->names = names;
+		}
+		strlcpy(parser->names[rule->nb_strings], name, MAX_TOKEN_LEN);
+		rule->nb_strings++;
+		parser->rules->nb_strings++;
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parse the condition section of a rule
+ *
+ * @parser [in]: rule parser
+ * @rule [in/out]: rule being parsed
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_condition(struct rule_parser *parser, struct yara_rule *rule)
+{
+	char word[MAX_TOKEN_LEN];
+	doca_error_t result;
+	char *end;
+	uint32_t i;
+
+	if (!read_word(parser, word)) {
+		DOCA_LOG_ERR("Rule file %s:%u: missing condition", parser->path, parser->line);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	rule->single_string = NO_STRING;
+	if (word[0] == '$') {
+		for (i = 0; i < rule->nb_strings; i++) {
+			if (strcmp(parser->names[i], word) == 0) {
+				rule->single_string = rule->first_string + i;
+				return DOCA_SUCCESS;
+			}
+		}
+		DOCA_LOG_ERR("Rule file %s:%u: undefined string %s", parser->path, parser->line, word);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	if (strcmp(word, "any") == 0) {
+		rule->threshold = 1;
+	} else if (strcmp(word, "all") == 0) {
+		rule->threshold = rule->nb_strings;
+	} else {
+		rule->threshold = strtoul(word, &end, 10);
+		if (*end != '\0' || rule->threshold == 0 || rule->threshold > rule->nb_strings) {
+			DOCA_LOG_ERR("Rule file %s:%u: only \"any of them\", \"all of them\", \"<n> of them\" and \"$string\" conditions are supported",
+				     parser->path,
+				     parser->line);
+			return DOCA_ERROR_NOT_SUPPORTED;
+		}
+	}
+
+	result = expect_word(parser, "of");
+	if (result != DOCA_SUCCESS)
+		return result;
+	return expect_word(parser, "them");
+}
+
+/*
+ * Parse a rule
+ *
+ * @parser [in]: rule parser, positioned after the rule keyword
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t parse_rule(struct rule_parser *parser)
+{
+	struct yara_rule_set *rules = parser->rules;
+	struct yara_rule *rule, *new_rules;
+	char word[MAX_TOKEN_LEN];
+	bool has_condition = false;
+	doca_error_t result;
+	uint32_t i;
+
+	if (rules->nb_rules == parser->rules_cap) {
+		parser->rules_cap = MAX(2 * parser->rules_cap, 16);
+		new_rules = realloc(rules->rules, parser->rules_cap * sizeof(*new_rules));
+		if (new_rules == NULL) {
+			DOCA_LOG_ERR("Failed to allocate rules");
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		rules->rules = new_rules;
+	}
+	rule = &rules->rules[rules->nb_rules];
+	memset(rule, 0, sizeof(*rule));
+	rule->first_string = rules->nb_strings;
+
+	if (!read_word(parser, word) || word[0] == '$' || isdigit((unsigned char)word[0])) {
+		DOCA_LOG_ERR("Rule file %s:%u: expected a rule name", parser->path, parser->line);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strlcpy(rule->name, word, sizeof(rule->name));
+	for (i = 0; i < rules->nb_rules; i++) {
+		if (strcmp(rules->rules[i].name, rule->name) == 0) {
+			DOCA_LOG_ERR("Rule file %s:%u: duplicated rule %s", parser->path, parser->line, rule->name);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+	}
+
+	/* Tags are accepted and ignored */
+	skip_blanks(parser);
+	if (parser->pos < parser->len && parser->buf[parser->pos] == ':') {
+		parser->pos++;
+		while (peek_word(parser, word))
+			read_word(parser, word);
+	}
+
+	result = expect_punct(parser, '{');
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	while (read_word(parser, word)) {
+		result = expect_punct(parser, ':');
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		if (strcmp(word, "meta") == 0) {
+			/* Meta values are not used, skip "key = value" entries until the next section */
+			while (peek_word(parser, word) && strcmp(word, "strings") != 0 &&
+			       strcmp(word, "condition") != 0) {
+				read_word(parser, word);
+				result = expect_punct(parser, '=');
+				if (result != DOCA_SUCCESS)
+					return result;
+				skip_blanks(parser);
+				if (parser->pos < parser->len && parser->buf[parser->pos] == '"')
+					result = parse_text_string(parser);
+				else if (!read_word(parser, word))
+					result = DOCA_ERROR_INVALID_VALUE;
+				if (result != DOCA_SUCCESS) {
+					DOCA_LOG_ERR("Rule file %s:%u: bad meta value", parser->path, parser->line);
+					return result;
+				}
+			}
+		} else if (strcmp(word, "strings") == 0) {
+			result = parse_strings(parser, rule);
+		} else if (strcmp(word, "condition") == 0) {
+			result = parse_condition(parser, rule);
+			has_condition = true;
+		} else {
+			DOCA_LOG_ERR("Rule file %s:%u: unknown section %s", parser->path, parser->line, word);
+			result = DOCA_ERROR_INVALID_VALUE;
+		}
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	result = expect_punct(parser, '}');
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	if (!has_condition || rule->nb_strings == 0) {
+		DOCA_LOG_ERR("Rule file %s: rule %s needs strings and a condition", parser->path, rule->name);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	rules->nb_rules++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Grow the automaton by one state
+ *
+ * @rules [in]: rule set
+ * @states_cap [in/out]: allocated number of states
+ * @state [out]: the new state
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ac_add_state(struct yara_rule_set *rules, uint32_t *states_cap, uint32_t *state)
+{
+	uint32_t *next;
+	uint32_t new_cap;
+
+	if (rules->nb_states == *states_cap) {
+		new_cap = MAX(2 * *states_cap, 1024);
+		next = realloc(rules->next, (size_t)new_cap * ALPHABET_SIZE * sizeof(*next));
+		if (next == NULL) {
+			DOCA_LOG_ERR("Failed to allocate automaton of %u states", new_cap);
+			return DOCA_ERROR_NO_MEMORY;
+		}
+		memset(next + (size_t)*states_cap * ALPHABET_SIZE,
+		       0,
+		       (size_t)(new_cap - *states_cap) * ALPHABET_SIZE * sizeof(*next));
+		rules->next = next;
+		*states_cap = new_cap;
+	}
+
+	*state = rules->nb_states++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Build the Aho-Corasick automaton of the patterns.
+ * The patterns are inserted in a trie, then a breadth first pass sets the failure of every state and replaces the
+ * missing transitions by the transitions of the failure state, turning the trie into a DFA.
+ *
+ * @rules [in/out]: rule set
+ * @patterns [in]: patterns of all strings
+ * @nb_patterns [in]: number of patterns
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t ac_build(struct yara_rule_set *rules, const struct rule_pattern *patterns, uint32_t nb_patterns)
+{
+	uint32_t *pattern_state = NULL, *fail = NULL, *queue = NULL, *next_out = NULL;
+	uint32_t states_cap = 0, state, child, fail_child, head = 0, tail = 0, p, i, c;
+	uint32_t *row, *fail_row;
+	doca_error_t result;
+
+	pattern_state = malloc(nb_patterns * sizeof(*pattern_state));
+	if (pattern_state == NULL) {
+		DOCA_LOG_ERR("Failed to allocate automaton build resources");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	/* Trie, transitions to state 0 are missing transitions since the root is nobody's child */
+	result = ac_add_state(rules, &states_cap, &state);
+	if (result != DOCA_SUCCESS)
+		goto free_build;
+	for (p = 0; p < nb_patterns; p++) {
+		state = 0;
+		for (i = 0; i < patterns[p].len; i++) {
+			child = rules->next[(size_t)state * ALPHABET_SIZE + patterns[p].data[i]];
+			if (child == 0) {
+				result = ac_add_state(rules, &states_cap, &child);
+				if (result != DOCA_SUCCESS)
+					goto free_build;
+				rules->next[(size_t)state * ALPHABET_SIZE + patterns[p].data[i]] = child;
+			}
+			state = child;
+		}
+		pattern_state[p] = state;
+	}
+
+	rules->is_match = calloc(rules->nb_states, sizeof(*rules->is_match));
+	rules->dict_link = calloc(rules->nb_states, sizeof(*rules->dict_link));
+	rules->out_first = calloc(rules->nb_states, sizeof(*rules->out_first));
+	rules->out_count = calloc(rules->nb_states, sizeof(*rules->out_count));
+	rules->out_ids = malloc(nb_patterns * sizeof(*rules->out_ids));
+	fail = calloc(rules->nb_states, sizeof(*fail));
+	queue = malloc(rules->nb_states * sizeof(*queue));
+	next_out = calloc(rules->nb_states, sizeof(*next_out));
+	if (rules->is_match == NULL || rules->dict_link == NULL || rules->out_first == NULL ||
+	    rules->out_count == NULL || rules->out_ids == NULL || fail == NULL || queue == NULL || next_out == NULL) {
+		DOCA_LOG_ERR("Failed to allocate automaton of %u states", rules->nb_states);
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_build;
+	}
+
+	/* Group the string ids by end state */
+	for (p = 0; p < nb_patterns; p++)
+		rules->out_count[pattern_state[p]]++;
+	for (state = 1; state < rules->nb_states; state++)
+		rules->out_first[state] = rules->out_first[state - 1] + rules->out_count[state - 1];
+	for (p = 0; p < nb_patterns; p++) {
+		state = pattern_state[p];
+		rules->out_ids[rules->out_first[state] + next_out[state]++] = patterns[p].string_id;
+	}
+
+	/* States are visited by depth, so the failure of a state is complete when the state is visited */
+	for (c = 0; c < ALPHABET_SIZE; c++) {
+		child = rules->next[c];
+		if (child != 0)
+			queue[tail++] = child;
+	}
+	while (head < tail) {
+		state = queue[head++];
+		fail_child = fail[state];
+		rules->dict_link[state] = rules->out_count[fail_child] != 0 ? fail_child : rules->dict_link[fail_child];
+		rules->is_match[state] = rules->out_count[state] != 0 || rules->dict_link[state] != 0;
+
+		row = &rules->next[(size_t)state * ALPHABET_SIZE];
+		fail_row = &rules->next[(size_t)fail[state] * ALPHABET_SIZE];
+		for (c = 0; c < ALPHABET_SIZE; c++) {
+			if (row[c] != 0) {
+				fail[row[c]] = fail_row[c];
+				queue[tail++] = row[c];
+			} else {
+				row[c] = fail_row[c];
+			}
+		}
+	}
+
+free_build:
+	free(next_out);
+	free(queue);
+	free(fail);
+	free(pattern_state);
+	return result;
+}
+
+doca_error_t yara_rules_load(const char *path, struct yara_rule_set **rules)
+{
+	struct rule_parser parser = {.path = path, .line = 1};
+	char word[MAX_TOKEN_LEN];
+	char *buf = NULL;
+	long file_len;
+	FILE *fp;
+	doca_error_t result;
+	uint32_t p;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open rule file %s", path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	if (fseek(fp, 0, SEEK_END) != 0 || (file_len = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to get the size of rule file %s", path);
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	buf = malloc(file_len + 1);
+	if (buf == NULL) {
+		DOCA_LOG_ERR("Failed to allocate rule file buffer");
+		fclose(fp);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	if (fread(buf, 1, file_len, fp) != (size_t)file_len) {
+		DOCA_LOG_ERR("Failed to read rule file %s", path);
+		fclose(fp);
+		free(buf);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	fclose(fp);
+
+	parser.buf = buf;
+	parser.len = file_len;
+	parser.rules = calloc(1, sizeof(*parser.rules));
+	if (parser.rules == NULL) {
+		DOCA_LOG_ERR("Failed to allocate rule set");
+		free(buf);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = DOCA_SUCCESS;
+	while (read_word(&parser, word)) {
+		if (strcmp(word, "rule") != 0) {
+			DOCA_LOG_ERR("Rule file %s:%u: expected 'rule', imports and rule modifiers are not supported",
+				     path,
+				     parser.line);
+			result = DOCA_ERROR_NOT_SUPPORTED;
+			break;
+		}
+		result = parse_rule(&parser);
+		if (result != DOCA_SUCCESS)
+			break;
+	}
+	skip_blanks(&parser);
+	if (result == DOCA_SUCCESS && parser.pos != parser.len) {
+		DOCA_LOG_ERR("Rule file %s:%u: unexpected character '%c'", path, parser.line, buf[parser.pos]);
+		result = DOCA_ERROR_INVALID_VALUE;
+	}
+	if (result == DOCA_SUCCESS && parser.rules->nb_rules == 0) {
+		DOCA_LOG_ERR("Rule file %s has no rules", path);
+		result = DOCA_ERROR_INVALID_VALUE;
+	}
+	if (result == DOCA_SUCCESS)
+		result = ac_build(parser.rules, parser.patterns, parser.nb_patterns);
+
+	if (result == DOCA_SUCCESS) {
+		DOCA_LOG_INFO("Loaded %u rules with %u strings from %s, automaton of %u states (%zu MB)",
+			      parser.rules->nb_rules,
+			      parser.rules->nb_strings,
+			      path,
+			      parser.rules->nb_states,
+			      ((size_t)parser.rules->nb_states * ALPHABET_SIZE * sizeof(uint32_t)) >> 20);
+		*rules = parser.rules;
+	} else {
+		yara_rules_destroy(parser.rules);
+	}
+
+	for (p = 0; p < parser.nb_patterns; p++)
+		free(parser.patterns[p].data);
+	free(parser.patterns);
+	free(parser.names);
+	free(buf);
+	return result;
+}
+
+void yara_rules_destroy(struct yara_rule_set *rules)
+{
+	free(rules->out_ids);
+	free(rules->out_count);
+	free(rules->out_first);
+	free(rules->dict_link);
+	free(rules->is_match);
+	free(rules->next);
+	free(rules->rules);
+	free(rules);
+}
+
+uint32_t yara_rules_get_nb_rules(const struct yara_rule_set *rules)
+{
+	return rules->nb_rules;
+}
+
+uint32_t yara_rules_get_nb_strings(const struct yara_rule_set *rules)
+{
+	return rules->nb_strings;
+}
+
+uint32_t yara_rules_get_max_pattern_len(const struct yara_rule_set *rules)
+{
+	return rules->max_pattern_len;
+}
+
+uint32_t yara_rules_get_nb_states(const struct yara_rule_set *rules)
+{
+	return rules->nb_states;
+}
+
+const char *yara_rules_get_name(const struct yara_rule_set *rules, uint32_t rule_id)
+{
+	return rules->rules[rule_id].name;
+}
+
+bool yara_rules_eval(const struct yara_rule_set *rules, uint32_t rule_id, const uint8_t *string_hits)
+{
+	const struct yara_rule *rule = &rules->rules[rule_id];
+	uint32_t i, nb_hits = 0;
+
+	if (rule->single_string != NO_STRING)
+		return string_hits[rule->single_string] != 0;
+
+	for (i = 0; i < rule->nb_strings; i++) {
+		if (string_hits[rule->first_string + i] != 0 && ++nb_hits == rule->threshold)
+			return true;
+	}
+	return false;
+}
+
+uint32_t yara_rules_scan(const struct yara_rule_set *rules,
+			 const uint8_t *data,
+			 size_t len,
+			 uint32_t state,
+			 size_t report_from,
+			 yara_string_match_cb match_cb,
+			 void *user_data)
+{
+	const uint32_t *next = rules->next;
+	const uint8_t *is_match = rules->is_match;
+	uint32_t match_state, k;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		state = next[(size_t)state * ALPHABET_SIZE + data[i]];
+		if (!is_match[state] || i < report_from)
+			continue;
+
+		/* Report the strings ending at the state and at all its suffix states */
+		for (match_state = state; match_state != 0; match_state = rules->dict_link[match_state]) {
+			for (k = 0; k < rules->out_count[match_state]; k++)
+				match_cb(user_data, rules->out_ids[rules->out_first[match_state] + k]);
+		}
+	}
+
+	return state;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 NVIDIA CORPORATION AND AFFILIATES.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of
+ *       conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of
+ *       conditions and the following disclaimer in the documentation and/or other materials
+ *       provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TOR (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef YARA_INSPECTION_RULES_H_
+#define YARA_INSPECTION_RULES_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YARA_MAX_RULE_NAME_LEN 128 /* Maximal length of a rule name */
+#define YARA_MAX_STRING_LEN 4096   /* Maximal length of a rule string, after wide expansion */
+
+/*
+ * User rule files use a subset of the YARA syntax:
+ *
+ *	rule name {
+ *		meta:
+ *			author = "..."
+ *		strings:
+ *			$text = "text with \x00 escapes" wide ascii
+ *			$hex = { 4D 5A 90 00 }
+ *		condition:
+ *			any of them | all of them | <n> of them | $text
+ *	}
+ *
+ * Only plain text strings (with the ascii and wide modifiers) and hex strings without wildcards or jumps are
+ * supported, so that all strings of all rules compile to a single Aho-Corasick automaton. Scanning costs one table
+ * lookup per byte, whatever the number of rules.
+ */
+
+/* Compiled rule set */
+struct yara_rule_set;
+
+/*
+ * Callback invoked for every string match
+ *
+ * @user_data [in]: user data given to the scan
+ * @string_id [in]: index of the matched string, smaller than yara_rules_get_nb_strings()
+ */
+typedef void (*yara_string_match_cb)(void *user_data, uint32_t string_id);
+
+/*
+ * Parse a rule file and compile its strings into an Aho-Corasick automaton
+ *
+ * @path [in]: rule file path
+ * @rules [out]: the compiled rule set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t yara_rules_load(const char *path, struct yara_rule_set **rules);
+
+/*
+ * Destroy a rule set
+ *
+ * @rules [in]: rule set to destroy
+ */
+void yara_rules_destroy(struct yara_rule_set *rules);
+
+/*
+ * Get the number of rules of a rule set
+ *
+ * @rules [in]: rule set
+ * @return: number of rules
+ */
+uint32_t yara_rules_get_nb_rules(const struct yara_rule_set *rules);
+
+/*
+ * Get the number of strings of all rules of a rule set
+ *
+ * @rules [in]: rule set
+ * @return: number of strings
+ */
+uint32_t yara_rules_get_nb_strings(const struct yara_rule_set *rules);
+
+/*
+ * Get the length of the longest pattern of a rule set, a match never spans more bytes
+ *
+ * @rules [in]: rule set
+ * @return: longest pattern length
+ */
+uint32_t yara_rules_get_max_pattern_len(const struct yara_rule_set *rules);
+
+/*
+ * Get the number of states of the automaton of a rule set
+ *
+ * @rules [in]: rule set
+ * @return: number of states
+ */
+uint32_t yara_rules_get_nb_states(const struct yara_rule_set *rules);
+
+/*
+ * Get the name of a rule
+ *
+ * @rules [in]: rule set
+ * @rule_id [in]: rule index
+ * @return: rule name
+ */
+const char *yara_rules_get_name(const struct yara_rule_set *rules, uint32_t rule_id);
+
+/*
+ * Check if the condition of a rule holds
+ *
+ * @rules [in]: rule set
+ * @rule_id [in]: rule index
+ * @string_hits [in]: per string of the rule set, non zero if the string matched
+ * @return: true if the rule matched
+ */
+bool yara_rules_eval(const struct yara_rule_set *rules, uint32_t rule_id, const uint8_t *string_hits);
+
+/*
+ * Run the automaton over a buffer.
+ * Scanning a stream in pieces is done by passing the state returned for the previous piece.
+ *
+ * @rules [in]: rule set
+ * @data [in]: buffer to scan
+ * @len [in]: buffer length
+ * @state [in]: automaton state to start from, 0 for the start of a stream
+ * @report_from [in]: only matches ending at or after this offset of the buffer are reported
+ * @match_cb [in]: callback invoked for every string match
+ * @user_data [in]: user data passed to match_cb
+ * @return: automaton state at the end of the buffer
+ */
+uint32_t yara_rules_scan(const struct yara_rule_set *rules,
+			 const uint8_t *data,
+			 size_t len,
+			 uint32_t state,
+			 size_t report_from,
+			 yara_string_match_cb match_cb,
+			 void *user_data);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* YARA_INSPECTION_RULES_H_ */